@@ -7,6 +7,8 @@ LOCAL_C_INCLUDES += $(LOCAL_PATH)/box2d/Box2D
 LOCAL_C_INCLUDES += $(LOCAL_PATH)/$(subst \,/,$(shell cd $(LOCAL_PATH) && node -e "require('nan')"))
 LOCAL_EXPORT_C_INCLUDES := $(LOCAL_C_INCLUDES)
 LOCAL_SRC_FILES := node-box2d.cc
+LOCAL_SRC_FILES += node-box2d-cpu.cc
+LOCAL_SRC_FILES += node-box2d-settings.cc
 LOCAL_SRC_FILES += box2d/Box2D/Box2D/Collision/b2BroadPhase.cpp
 LOCAL_SRC_FILES += box2d/Box2D/Box2D/Collision/b2CollideCircle.cpp
 LOCAL_SRC_FILES += box2d/Box2D/Box2D/Collision/b2CollideEdge.cpp
@@ -23,7 +25,6 @@ LOCAL_SRC_FILES += box2d/Box2D/Box2D/Common/b2BlockAllocator.cpp
 LOCAL_SRC_FILES += box2d/Box2D/Box2D/Common/b2Draw.cpp
 LOCAL_SRC_FILES += box2d/Box2D/Box2D/Common/b2FreeList.cpp
 LOCAL_SRC_FILES += box2d/Box2D/Box2D/Common/b2Math.cpp
-LOCAL_SRC_FILES += box2d/Box2D/Box2D/Common/b2Settings.cpp
 LOCAL_SRC_FILES += box2d/Box2D/Box2D/Common/b2StackAllocator.cpp
 LOCAL_SRC_FILES += box2d/Box2D/Box2D/Common/b2Stat.cpp
 LOCAL_SRC_FILES += box2d/Box2D/Box2D/Common/b2Timer.cpp
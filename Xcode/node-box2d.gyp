@@ -106,6 +106,8 @@
             'sources': [
 				'node-box2d.h',
 				'node-box2d.cc',
+				'node-box2d-cpu.cc',
+				'node-box2d-settings.cc',
 				'<(BOX2D_PATH)/Box2D/Collision/b2BroadPhase.cpp',
 				'<(BOX2D_PATH)/Box2D/Collision/b2CollideCircle.cpp',
 				'<(BOX2D_PATH)/Box2D/Collision/b2CollideEdge.cpp',
@@ -121,7 +123,6 @@
 				'<(BOX2D_PATH)/Box2D/Common/b2BlockAllocator.cpp',
 				'<(BOX2D_PATH)/Box2D/Common/b2Draw.cpp',
 				'<(BOX2D_PATH)/Box2D/Common/b2Math.cpp',
-				'<(BOX2D_PATH)/Box2D/Common/b2Settings.cpp',
 				'<(BOX2D_PATH)/Box2D/Common/b2StackAllocator.cpp',
 				'<(BOX2D_PATH)/Box2D/Common/b2Timer.cpp',
 				'<(BOX2D_PATH)/Box2D/Dynamics/b2Body.cpp',
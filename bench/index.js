@@ -0,0 +1,145 @@
+/**
+ * Copyright (c) Flyover Games, LLC.  All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated
+ * documentation files (the "Software"), to deal in the Software
+ * without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to
+ * whom the Software is furnished to do so, subject to the
+ * following conditions:
+ *
+ * The above copyright notice and this permission notice shall
+ * be included in all copies or substantial portions of the
+ * Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY
+ * KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE
+ * WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR
+ * PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ * OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+ * SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+// usage: node bench [--filter name] [--baseline file] [--save-baseline] [--threshold percent] [--out file]
+//
+// prints JSON results; with a baseline file, scenes whose steps/sec or
+// micro-benchmarks whose ops/sec dropped by more than the threshold are
+// listed under "regressions" and the process exits with code 1
+
+var fs = require('fs');
+var path = require('path');
+
+var box2d = require('../node-box2d.js');
+
+var options = {
+  filter: null,
+  baseline: path.join(__dirname, 'baseline.json'),
+  saveBaseline: false,
+  threshold: 10,
+  out: null
+};
+
+var argv = process.argv.slice(2);
+for (var i = 0; i < argv.length; ++i) {
+  switch (argv[i]) {
+    case '--filter': options.filter = argv[++i]; break;
+    case '--baseline': options.baseline = argv[++i]; break;
+    case '--save-baseline': options.saveBaseline = true; break;
+    case '--threshold': options.threshold = parseFloat(argv[++i]); break;
+    case '--out': options.out = argv[++i]; break;
+    default: console.error("unknown option: " + argv[i]); process.exit(2);
+  }
+}
+
+function selected(name) {
+  return !options.filter || name.indexOf(options.filter) !== -1;
+}
+
+function percentile(sorted, p) {
+  if (sorted.length === 0) { return 0; }
+  var index = Math.min(sorted.length - 1, Math.max(0, Math.ceil(p * sorted.length) - 1));
+  return sorted[index];
+}
+
+function runScene(scene) {
+  var instance = scene.setup();
+  var world = instance.world;
+  var times = new Float64Array(scene.steps);
+  var total = 0;
+  for (var step = 0; step < scene.steps; ++step) {
+    if (instance.step) { instance.step(); }
+    var start = process.hrtime();
+    world.Step(1 / 60, 8, 3);
+    var elapsed = process.hrtime(start);
+    var ms = elapsed[0] * 1e3 + elapsed[1] * 1e-6;
+    times[step] = ms;
+    total += ms;
+  }
+  var sorted = Array.prototype.slice.call(times).sort(function(a, b) { return a - b; });
+  return {
+    name: scene.name,
+    steps: scene.steps,
+    bodies: world.GetBodyCount(),
+    stepsPerSec: scene.steps / (total * 1e-3),
+    meanMs: total / scene.steps,
+    p50Ms: percentile(sorted, 0.50),
+    p99Ms: percentile(sorted, 0.99)
+  };
+}
+
+var results = {
+  node: process.version,
+  platform: process.platform + "-" + process.arch,
+  date: new Date().toISOString(),
+  scenes: [],
+  micro: []
+};
+
+require('./scenes.js')(box2d).forEach(function(scene) {
+  if (selected(scene.name)) {
+    results.scenes.push(runScene(scene));
+  }
+});
+
+require('./micro.js')(box2d).forEach(function(micro) {
+  if (selected(micro.name)) {
+    results.micro.push({ name: micro.name, opsPerSec: micro.run() });
+  }
+});
+
+// compare against the stored baseline
+var regressions = [];
+if (!options.saveBaseline && fs.existsSync(options.baseline)) {
+  var baseline = JSON.parse(fs.readFileSync(options.baseline, 'utf8'));
+  var limit = 1 - options.threshold / 100;
+  var compare = function(kind, list, key) {
+    (baseline[kind] || []).forEach(function(base) {
+      list.forEach(function(result) {
+        if (result.name === base.name && result[key] < base[key] * limit) {
+          regressions.push({ name: result.name, metric: key, baseline: base[key], current: result[key], change: (result[key] / base[key] - 1) * 100 });
+        }
+      });
+    });
+  };
+  compare('scenes', results.scenes, 'stepsPerSec');
+  compare('micro', results.micro, 'opsPerSec');
+  results.baseline = options.baseline;
+  results.regressions = regressions;
+}
+
+var json = JSON.stringify(results, null, 2);
+console.log(json);
+if (options.out) {
+  fs.writeFileSync(options.out, json + "\n");
+}
+if (options.saveBaseline) {
+  fs.writeFileSync(options.baseline, json + "\n");
+  console.error("saved baseline: " + options.baseline);
+}
+if (regressions.length > 0) {
+  process.exitCode = 1;
+}
@@ -0,0 +1,131 @@
+/**
+ * Copyright (c) Flyover Games, LLC.  All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated
+ * documentation files (the "Software"), to deal in the Software
+ * without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to
+ * whom the Software is furnished to do so, subject to the
+ * following conditions:
+ *
+ * The above copyright notice and this permission notice shall
+ * be included in all copies or substantial portions of the
+ * Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY
+ * KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE
+ * WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR
+ * PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ * OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+ * SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+// binding overhead micro-benchmarks; each returns operations per second
+
+module.exports = function(box2d) {
+
+  function rate(ops, fn) {
+    var start = process.hrtime();
+    fn(ops);
+    var elapsed = process.hrtime(start);
+    return ops / (elapsed[0] + elapsed[1] * 1e-9);
+  }
+
+  function dynamicBodyDef(x, y) {
+    var bd = new box2d.b2BodyDef();
+    bd.type = box2d.b2BodyType.b2_dynamicBody;
+    bd.position.Set(x, y);
+    return bd;
+  }
+
+  var micro = [];
+
+  micro.push({
+    name: "getter_call",
+    run: function() {
+      var world = new box2d.b2World(new box2d.b2Vec2(0, -10));
+      var body = world.CreateBody(dynamicBodyDef(0, 0));
+      var out = new box2d.b2Vec2();
+      return rate(1000000, function(ops) {
+        for (var i = 0; i < ops; ++i) {
+          body.GetPosition(out);
+        }
+      });
+    }
+  });
+
+  micro.push({
+    name: "create_body",
+    run: function() {
+      var world = new box2d.b2World(new box2d.b2Vec2(0, -10));
+      var shape = new box2d.b2CircleShape(0.5);
+      var fd = new box2d.b2FixtureDef();
+      fd.shape = shape;
+      fd.density = 1;
+      return rate(20000, function(ops) {
+        for (var i = 0; i < ops; ++i) {
+          world.CreateBody(dynamicBodyDef(i % 100, Math.floor(i / 100))).CreateFixture(fd);
+        }
+      });
+    }
+  });
+
+  micro.push({
+    name: "contact_callback",
+    run: function() {
+      // boxes resting on the ground report PreSolve every step
+      var world = new box2d.b2World(new box2d.b2Vec2(0, -10));
+      var ground = world.CreateBody(new box2d.b2BodyDef());
+      var edge = new box2d.b2EdgeShape();
+      edge.Set(new box2d.b2Vec2(-1000, 0), new box2d.b2Vec2(1000, 0));
+      ground.CreateFixture(edge, 0);
+      var shape = new box2d.b2PolygonShape();
+      shape.SetAsBox(0.5, 0.5);
+      for (var i = 0; i < 500; ++i) {
+        var bd = dynamicBodyDef(-500 + 2 * i, 0.5);
+        bd.allowSleep = false;
+        world.CreateBody(bd).CreateFixture(shape, 1);
+      }
+      var calls = 0;
+      var listener = new box2d.b2ContactListener();
+      listener.PreSolve = function(contact, oldManifold) { ++calls; };
+      world.SetContactListener(listener);
+      world.Step(1 / 60, 8, 3);
+      calls = 0;
+      var start = process.hrtime();
+      for (var step = 0; step < 200; ++step) {
+        world.Step(1 / 60, 8, 3);
+      }
+      var elapsed = process.hrtime(start);
+      return calls / (elapsed[0] + elapsed[1] * 1e-9);
+    }
+  });
+
+  micro.push({
+    name: "query_callback",
+    run: function() {
+      var world = new box2d.b2World(new box2d.b2Vec2(0, -10));
+      var shape = new box2d.b2CircleShape(0.5);
+      for (var i = 0; i < 1000; ++i) {
+        world.CreateBody(dynamicBodyDef(i % 32, Math.floor(i / 32))).CreateFixture(shape, 1);
+      }
+      var aabb = new box2d.b2AABB();
+      aabb.lowerBound.Set(-1, -1);
+      aabb.upperBound.Set(40, 40);
+      var calls = 0;
+      var callback = function(fixture) { ++calls; return true; };
+      var start = process.hrtime();
+      for (var q = 0; q < 200; ++q) {
+        world.QueryAABB(callback, aabb);
+      }
+      var elapsed = process.hrtime(start);
+      return calls / (elapsed[0] + elapsed[1] * 1e-9);
+    }
+  });
+
+  return micro;
+};
@@ -0,0 +1,381 @@
+/**
+ * Copyright (c) Flyover Games, LLC.  All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated
+ * documentation files (the "Software"), to deal in the Software
+ * without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to
+ * whom the Software is furnished to do so, subject to the
+ * following conditions:
+ *
+ * The above copyright notice and this permission notice shall
+ * be included in all copies or substantial portions of the
+ * Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY
+ * KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE
+ * WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR
+ * PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ * OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+ * SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+// standalone engine benchmark: runs the bench/ scenes without V8 so the
+// cost of the binding layer can be read off against `npm run bench`
+//
+// usage: node-box2d-bench [filter]
+
+#include <Box2D/Box2D.h>
+
+#include <stdio.h>
+#include <string.h>
+#include <math.h>
+#include <algorithm>
+#include <vector>
+
+namespace node_box2d_bench {
+
+class Scene
+{
+public:
+	b2World m_world;
+public:
+	Scene() : m_world(b2Vec2(0.0f, -10.0f)) {}
+	virtual ~Scene() {}
+	virtual void Step() {}
+public:
+	b2Body* CreateGround(float32 hx)
+	{
+		b2BodyDef bd;
+		b2Body* ground = m_world.CreateBody(&bd);
+		b2EdgeShape shape;
+		shape.Set(b2Vec2(-hx, 0.0f), b2Vec2(hx, 0.0f));
+		ground->CreateFixture(&shape, 0.0f);
+		return ground;
+	}
+	b2Body* CreateBox(float32 x, float32 y, float32 hx, float32 hy, float32 density, bool bullet = false)
+	{
+		b2BodyDef bd;
+		bd.type = b2_dynamicBody;
+		bd.position.Set(x, y);
+		bd.bullet = bullet;
+		b2Body* body = m_world.CreateBody(&bd);
+		b2PolygonShape shape;
+		shape.SetAsBox(hx, hy);
+		b2FixtureDef fd;
+		fd.shape = &shape;
+		fd.density = density;
+		fd.friction = 0.3f;
+		body->CreateFixture(&fd);
+		return body;
+	}
+	b2Body* CreateCircle(float32 x, float32 y, float32 radius, float32 density, bool bullet = false)
+	{
+		b2BodyDef bd;
+		bd.type = b2_dynamicBody;
+		bd.position.Set(x, y);
+		bd.bullet = bullet;
+		b2Body* body = m_world.CreateBody(&bd);
+		b2CircleShape shape;
+		shape.m_radius = radius;
+		b2FixtureDef fd;
+		fd.shape = &shape;
+		fd.density = density;
+		fd.friction = 0.3f;
+		body->CreateFixture(&fd);
+		return body;
+	}
+	void CreateRevolute(b2Body* a, b2Body* b, float32 x, float32 y, float32 lower, float32 upper)
+	{
+		b2RevoluteJointDef jd;
+		jd.Initialize(a, b, b2Vec2(x, y));
+		jd.enableLimit = true;
+		jd.lowerAngle = lower;
+		jd.upperAngle = upper;
+		m_world.CreateJoint(&jd);
+	}
+};
+
+//// scenes, matching bench/scenes.js
+
+class VerticalStack : public Scene
+{
+public:
+	VerticalStack()
+	{
+		CreateGround(40.0f);
+		for (int32 column = 0; column < 10; ++column)
+		{
+			for (int32 row = 0; row < 20; ++row)
+			{
+				CreateBox(-9.0f + 2.0f * column, 0.5f + 1.0f * row, 0.5f, 0.5f, 1.0f);
+			}
+		}
+	}
+};
+
+class Pyramid : public Scene
+{
+public:
+	Pyramid()
+	{
+		CreateGround(40.0f);
+		const int32 count = 20;
+		b2Vec2 x(-7.0f, 0.75f);
+		for (int32 i = 0; i < count; ++i)
+		{
+			b2Vec2 y = x;
+			for (int32 j = i; j < count; ++j)
+			{
+				CreateBox(y.x, y.y, 0.5f, 0.5f, 5.0f);
+				y.x += 1.125f;
+			}
+			x.x += 0.5625f;
+			x.y += 1.0f;
+		}
+	}
+};
+
+class Tumbler : public Scene
+{
+private:
+	int32 m_count;
+public:
+	Tumbler() : m_count(0)
+	{
+		b2BodyDef ground_bd;
+		b2Body* ground = m_world.CreateBody(&ground_bd);
+		b2BodyDef bd;
+		bd.type = b2_dynamicBody;
+		bd.allowSleep = false;
+		bd.position.Set(0.0f, 10.0f);
+		b2Body* body = m_world.CreateBody(&bd);
+		b2PolygonShape shape;
+		shape.SetAsBox(0.5f, 10.0f, b2Vec2(10.0f, 0.0f), 0.0f);
+		body->CreateFixture(&shape, 5.0f);
+		shape.SetAsBox(0.5f, 10.0f, b2Vec2(-10.0f, 0.0f), 0.0f);
+		body->CreateFixture(&shape, 5.0f);
+		shape.SetAsBox(10.0f, 0.5f, b2Vec2(0.0f, 10.0f), 0.0f);
+		body->CreateFixture(&shape, 5.0f);
+		shape.SetAsBox(10.0f, 0.5f, b2Vec2(0.0f, -10.0f), 0.0f);
+		body->CreateFixture(&shape, 5.0f);
+		b2RevoluteJointDef jd;
+		jd.bodyA = ground;
+		jd.bodyB = body;
+		jd.localAnchorA.Set(0.0f, 10.0f);
+		jd.localAnchorB.Set(0.0f, 0.0f);
+		jd.referenceAngle = 0.0f;
+		jd.motorSpeed = 0.05f * b2_pi;
+		jd.maxMotorTorque = 1e8f;
+		jd.enableMotor = true;
+		m_world.CreateJoint(&jd);
+	}
+	virtual void Step()
+	{
+		if (m_count < 800)
+		{
+			CreateBox(0.0f, 10.0f, 0.125f, 0.125f, 1.0f);
+			++m_count;
+		}
+	}
+};
+
+class Bullets : public Scene
+{
+public:
+	Bullets()
+	{
+		CreateGround(60.0f);
+		for (int32 row = 0; row < 10; ++row)
+		{
+			for (int32 column = 0; column < 4; ++column)
+			{
+				CreateBox(20.0f + column, 0.5f + row, 0.5f, 0.5f, 1.0f);
+			}
+		}
+		for (int32 i = 0; i < 200; ++i)
+		{
+			b2Body* bullet = CreateCircle(-40.0f - (i % 10), 1.0f + (i / 10) * 0.5f, 0.1f, 10.0f, true);
+			bullet->SetLinearVelocity(b2Vec2(200.0f, 0.0f));
+		}
+	}
+};
+
+class Ragdolls : public Scene
+{
+public:
+	Ragdolls()
+	{
+		CreateGround(40.0f);
+		for (int32 i = 0; i < 30; ++i)
+		{
+			float32 x = -10.0f + (i % 6) * 4.0f;
+			float32 y = 4.0f + (i / 6) * 5.0f;
+			b2Body* torso = CreateBox(x, y, 0.3f, 0.6f, 1.0f);
+			b2Body* head = CreateCircle(x, y + 0.95f, 0.3f, 1.0f);
+			CreateRevolute(torso, head, x, y + 0.65f, -0.5f, 0.5f);
+			for (int32 side = -1; side <= 1; side += 2)
+			{
+				b2Body* arm = CreateBox(x + side * 0.6f, y + 0.4f, 0.3f, 0.1f, 1.0f);
+				CreateRevolute(torso, arm, x + side * 0.3f, y + 0.4f, -1.5f, 1.5f);
+				b2Body* forearm = CreateBox(x + side * 1.2f, y + 0.4f, 0.3f, 0.1f, 1.0f);
+				CreateRevolute(arm, forearm, x + side * 0.9f, y + 0.4f, -1.5f, 1.5f);
+				b2Body* thigh = CreateBox(x + side * 0.15f, y - 0.9f, 0.1f, 0.3f, 1.0f);
+				CreateRevolute(torso, thigh, x + side * 0.15f, y - 0.6f, -1.0f, 1.0f);
+				b2Body* shin = CreateBox(x + side * 0.15f, y - 1.5f, 0.1f, 0.3f, 1.0f);
+				CreateRevolute(thigh, shin, x + side * 0.15f, y - 1.2f, -1.0f, 0.0f);
+			}
+		}
+	}
+};
+
+class ChainTerrain : public Scene
+{
+public:
+	ChainTerrain()
+	{
+		b2BodyDef bd;
+		b2Body* ground = m_world.CreateBody(&bd);
+		const int32 count = 4000;
+		std::vector<b2Vec2> vertices(count);
+		for (int32 i = 0; i < count; ++i)
+		{
+			float32 x = -200.0f + 400.0f * i / (count - 1);
+			vertices[i].Set(x, 2.0f * sinf(x * 0.2f) + 0.5f * sinf(x * 1.3f));
+		}
+		b2ChainShape chain;
+		chain.CreateChain(&vertices[0], count);
+		ground->CreateFixture(&chain, 0.0f);
+		for (int32 j = 0; j < 300; ++j)
+		{
+			CreateCircle(-150.0f + j, 6.0f + (j % 3), 0.4f, 1.0f);
+		}
+	}
+};
+
+#if B2_ENABLE_PARTICLE
+class DamBreak : public Scene
+{
+public:
+	DamBreak()
+	{
+		b2BodyDef bd;
+		b2Body* ground = m_world.CreateBody(&bd);
+		b2PolygonShape shape;
+		shape.SetAsBox(2.0f, 0.05f, b2Vec2(0.0f, -0.05f), 0.0f);
+		ground->CreateFixture(&shape, 0.0f);
+		shape.SetAsBox(0.05f, 2.0f, b2Vec2(-2.05f, 2.0f), 0.0f);
+		ground->CreateFixture(&shape, 0.0f);
+		shape.SetAsBox(0.05f, 2.0f, b2Vec2(2.05f, 2.0f), 0.0f);
+		ground->CreateFixture(&shape, 0.0f);
+		shape.SetAsBox(2.0f, 0.05f, b2Vec2(0.0f, 4.05f), 0.0f);
+		ground->CreateFixture(&shape, 0.0f);
+		b2ParticleSystemDef psd;
+		psd.radius = 0.025f;
+		psd.dampingStrength = 0.2f;
+		b2ParticleSystem* system = m_world.CreateParticleSystem(&psd);
+		b2PolygonShape water;
+		water.SetAsBox(0.8f, 1.0f, b2Vec2(-1.2f, 1.01f), 0.0f);
+		b2ParticleGroupDef pd;
+		pd.shape = &water;
+		system->CreateParticleGroup(pd);
+	}
+};
+#endif
+
+template <class T> Scene* CreateScene() { return new T(); }
+
+struct SceneEntry
+{
+	const char* name;
+	int32 steps;
+	Scene* (*create)();
+};
+
+static const SceneEntry g_scenes[] =
+{
+	{ "vertical_stack", 600, CreateScene<VerticalStack> },
+	{ "pyramid", 600, CreateScene<Pyramid> },
+	{ "tumbler", 1000, CreateScene<Tumbler> },
+	{ "bullets", 600, CreateScene<Bullets> },
+	{ "ragdolls", 600, CreateScene<Ragdolls> },
+	{ "chain_terrain", 600, CreateScene<ChainTerrain> },
+	#if B2_ENABLE_PARTICLE
+	{ "dam_break", 300, CreateScene<DamBreak> },
+	#endif
+};
+
+static float64 Percentile(const std::vector<float64>& sorted, float64 p)
+{
+	if (sorted.empty()) { return 0.0; }
+	int32 index = static_cast<int32>(ceil(p * sorted.size())) - 1;
+	return sorted[b2Clamp(index, 0, static_cast<int32>(sorted.size()) - 1)];
+}
+
+static void RunScene(const SceneEntry& entry, bool first)
+{
+	Scene* scene = entry.create();
+	std::vector<float64> times(entry.steps);
+	// b2Profile fields summed over all steps
+	float64 step = 0.0, collide = 0.0, solve = 0.0, solveInit = 0.0, solveVelocity = 0.0, solvePosition = 0.0, broadphase = 0.0, solveTOI = 0.0;
+	float64 total = 0.0;
+	b2Timer timer;
+	for (int32 i = 0; i < entry.steps; ++i)
+	{
+		scene->Step();
+		float64 start = timer.GetMilliseconds();
+		#if B2_ENABLE_PARTICLE
+		scene->m_world.Step(1.0f / 60.0f, 8, 3, scene->m_world.CalculateReasonableParticleIterations(1.0f / 60.0f));
+		#else
+		scene->m_world.Step(1.0f / 60.0f, 8, 3);
+		#endif
+		float64 ms = timer.GetMilliseconds() - start;
+		times[i] = ms;
+		total += ms;
+		const b2Profile& profile = scene->m_world.GetProfile();
+		step += profile.step;
+		collide += profile.collide;
+		solve += profile.solve;
+		solveInit += profile.solveInit;
+		solveVelocity += profile.solveVelocity;
+		solvePosition += profile.solvePosition;
+		broadphase += profile.broadphase;
+		solveTOI += profile.solveTOI;
+	}
+	std::sort(times.begin(), times.end());
+	const float64 n = entry.steps;
+	printf("%s\n    {\n", first ? "" : ",");
+	printf("      \"name\": \"%s\",\n", entry.name);
+	printf("      \"steps\": %d,\n", entry.steps);
+	printf("      \"bodies\": %d,\n", scene->m_world.GetBodyCount());
+	printf("      \"stepsPerSec\": %f,\n", n / (total * 1e-3));
+	printf("      \"meanMs\": %f,\n", total / n);
+	printf("      \"p50Ms\": %f,\n", Percentile(times, 0.50));
+	printf("      \"p99Ms\": %f,\n", Percentile(times, 0.99));
+	printf("      \"profile\": { \"step\": %f, \"collide\": %f, \"solve\": %f, \"solveInit\": %f, \"solveVelocity\": %f, \"solvePosition\": %f, \"broadphase\": %f, \"solveTOI\": %f }\n",
+		step / n, collide / n, solve / n, solveInit / n, solveVelocity / n, solvePosition / n, broadphase / n, solveTOI / n);
+	printf("    }");
+	delete scene;
+}
+
+} // namespace node_box2d_bench
+
+int main(int argc, char** argv)
+{
+	using namespace node_box2d_bench;
+	const char* filter = (argc > 1) ? argv[1] : NULL;
+	printf("{\n  \"native\": true,\n  \"scenes\": [");
+	bool first = true;
+	for (size_t i = 0; i < sizeof(g_scenes) / sizeof(g_scenes[0]); ++i)
+	{
+		if (filter && !strstr(g_scenes[i].name, filter)) { continue; }
+		RunScene(g_scenes[i], first);
+		first = false;
+	}
+	printf("\n  ]\n}\n");
+	return 0;
+}
@@ -0,0 +1,271 @@
+/**
+ * Copyright (c) Flyover Games, LLC.  All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated
+ * documentation files (the "Software"), to deal in the Software
+ * without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to
+ * whom the Software is furnished to do so, subject to the
+ * following conditions:
+ *
+ * The above copyright notice and this permission notice shall
+ * be included in all copies or substantial portions of the
+ * Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY
+ * KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE
+ * WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR
+ * PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ * OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+ * SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+// canonical scenes, ported from the Box2D / LiquidFun testbed
+
+module.exports = function(box2d) {
+
+  function createWorld() {
+    return new box2d.b2World(new box2d.b2Vec2(0, -10));
+  }
+
+  function createGround(world, hx) {
+    var bd = new box2d.b2BodyDef();
+    var ground = world.CreateBody(bd);
+    var shape = new box2d.b2EdgeShape();
+    shape.Set(new box2d.b2Vec2(-hx, 0), new box2d.b2Vec2(hx, 0));
+    ground.CreateFixture(shape, 0);
+    return ground;
+  }
+
+  function createBox(world, x, y, hx, hy, density, bullet) {
+    var bd = new box2d.b2BodyDef();
+    bd.type = box2d.b2BodyType.b2_dynamicBody;
+    bd.position.Set(x, y);
+    bd.bullet = !!bullet;
+    var body = world.CreateBody(bd);
+    var shape = new box2d.b2PolygonShape();
+    shape.SetAsBox(hx, hy);
+    var fd = new box2d.b2FixtureDef();
+    fd.shape = shape;
+    fd.density = density;
+    fd.friction = 0.3;
+    body.CreateFixture(fd);
+    return body;
+  }
+
+  function createCircle(world, x, y, radius, density, bullet) {
+    var bd = new box2d.b2BodyDef();
+    bd.type = box2d.b2BodyType.b2_dynamicBody;
+    bd.position.Set(x, y);
+    bd.bullet = !!bullet;
+    var body = world.CreateBody(bd);
+    var shape = new box2d.b2CircleShape(radius);
+    var fd = new box2d.b2FixtureDef();
+    fd.shape = shape;
+    fd.density = density;
+    fd.friction = 0.3;
+    body.CreateFixture(fd);
+    return body;
+  }
+
+  var scenes = [];
+
+  // testbed VerticalStack, widened
+  scenes.push({
+    name: "vertical_stack",
+    steps: 600,
+    setup: function() {
+      var world = createWorld();
+      createGround(world, 40);
+      for (var column = 0; column < 10; ++column) {
+        for (var row = 0; row < 20; ++row) {
+          createBox(world, -9 + 2 * column, 0.5 + 1.0 * row, 0.5, 0.5, 1);
+        }
+      }
+      return { world: world };
+    }
+  });
+
+  // testbed Pyramid
+  scenes.push({
+    name: "pyramid",
+    steps: 600,
+    setup: function() {
+      var world = createWorld();
+      createGround(world, 40);
+      var count = 20;
+      var a = 0.5;
+      var x = new box2d.b2Vec2(-7.0, 0.75);
+      for (var i = 0; i < count; ++i) {
+        var y = x.Clone();
+        for (var j = i; j < count; ++j) {
+          createBox(world, y.x, y.y, a, a, 5);
+          y.x += 1.125;
+        }
+        x.x += 0.5625;
+        x.y += 1.0;
+      }
+      return { world: world };
+    }
+  });
+
+  // testbed Tumbler: a motorized box that fills with 800 small boxes
+  scenes.push({
+    name: "tumbler",
+    steps: 1000,
+    setup: function() {
+      var world = createWorld();
+      var ground = world.CreateBody(new box2d.b2BodyDef());
+      var bd = new box2d.b2BodyDef();
+      bd.type = box2d.b2BodyType.b2_dynamicBody;
+      bd.allowSleep = false;
+      bd.position.Set(0, 10);
+      var body = world.CreateBody(bd);
+      var walls = [
+        [0.5, 10, 10, 0], [0.5, 10, -10, 0], [10, 0.5, 0, 10], [10, 0.5, 0, -10]
+      ];
+      walls.forEach(function(w) {
+        var shape = new box2d.b2PolygonShape();
+        shape.SetAsBox(w[0], w[1], new box2d.b2Vec2(w[2], w[3]), 0);
+        body.CreateFixture(shape, 5);
+      });
+      var jd = new box2d.b2RevoluteJointDef();
+      jd.bodyA = ground;
+      jd.bodyB = body;
+      jd.localAnchorA.Set(0, 10);
+      jd.localAnchorB.Set(0, 0);
+      jd.referenceAngle = 0;
+      jd.motorSpeed = 0.05 * Math.PI;
+      jd.maxMotorTorque = 1e8;
+      jd.enableMotor = true;
+      world.CreateJoint(jd);
+      var count = 0;
+      return {
+        world: world,
+        step: function() {
+          if (count < 800) {
+            createBox(world, 0, 10, 0.125, 0.125, 1);
+            ++count;
+          }
+        }
+      };
+    }
+  });
+
+  // many fast bullets fired into a wall of boxes
+  scenes.push({
+    name: "bullets",
+    steps: 600,
+    setup: function() {
+      var world = createWorld();
+      createGround(world, 60);
+      for (var row = 0; row < 10; ++row) {
+        for (var column = 0; column < 4; ++column) {
+          createBox(world, 20 + column, 0.5 + row, 0.5, 0.5, 1);
+        }
+      }
+      var velocity = new box2d.b2Vec2(200, 0);
+      for (var i = 0; i < 200; ++i) {
+        var bullet = createCircle(world, -40 - (i % 10), 1 + Math.floor(i / 10) * 0.5, 0.1, 10, true);
+        bullet.SetLinearVelocity(velocity);
+      }
+      return { world: world };
+    }
+  });
+
+  // pile of simple ragdolls: torso, head and limbs on limited revolute joints
+  scenes.push({
+    name: "ragdolls",
+    steps: 600,
+    setup: function() {
+      var world = createWorld();
+      createGround(world, 40);
+      function joint(a, b, x, y, lower, upper) {
+        var jd = new box2d.b2RevoluteJointDef();
+        jd.Initialize(a, b, new box2d.b2Vec2(x, y));
+        jd.enableLimit = true;
+        jd.lowerAngle = lower;
+        jd.upperAngle = upper;
+        world.CreateJoint(jd);
+      }
+      for (var i = 0; i < 30; ++i) {
+        var x = -10 + (i % 6) * 4;
+        var y = 4 + Math.floor(i / 6) * 5;
+        var torso = createBox(world, x, y, 0.3, 0.6, 1);
+        var head = createCircle(world, x, y + 0.95, 0.3, 1);
+        joint(torso, head, x, y + 0.65, -0.5, 0.5);
+        [-1, 1].forEach(function(side) {
+          var arm = createBox(world, x + side * 0.6, y + 0.4, 0.3, 0.1, 1);
+          joint(torso, arm, x + side * 0.3, y + 0.4, -1.5, 1.5);
+          var forearm = createBox(world, x + side * 1.2, y + 0.4, 0.3, 0.1, 1);
+          joint(arm, forearm, x + side * 0.9, y + 0.4, -1.5, 1.5);
+          var thigh = createBox(world, x + side * 0.15, y - 0.9, 0.1, 0.3, 1);
+          joint(torso, thigh, x + side * 0.15, y - 0.6, -1.0, 1.0);
+          var shin = createBox(world, x + side * 0.15, y - 1.5, 0.1, 0.3, 1);
+          joint(thigh, shin, x + side * 0.15, y - 1.2, -1.0, 0.0);
+        });
+      }
+      return { world: world };
+    }
+  });
+
+  // long chain terrain built from packed vertices, with rolling circles
+  scenes.push({
+    name: "chain_terrain",
+    steps: 600,
+    setup: function() {
+      var world = createWorld();
+      var ground = world.CreateBody(new box2d.b2BodyDef());
+      var count = 4000;
+      var vertices = new Float32Array(2 * count);
+      for (var i = 0; i < count; ++i) {
+        var x = -200 + 400 * i / (count - 1);
+        vertices[2 * i + 0] = x;
+        vertices[2 * i + 1] = 2 * Math.sin(x * 0.2) + 0.5 * Math.sin(x * 1.3);
+      }
+      var chain = new box2d.b2ChainShape();
+      chain.CreateChain(vertices);
+      ground.CreateFixture(chain, 0);
+      for (var j = 0; j < 300; ++j) {
+        createCircle(world, -150 + j, 6 + (j % 3), 0.4, 1);
+      }
+      return { world: world };
+    }
+  });
+
+  // LiquidFun DamBreak
+  if (box2d.b2ParticleSystemDef) {
+    scenes.push({
+      name: "dam_break",
+      steps: 300,
+      setup: function() {
+        var world = createWorld();
+        var ground = world.CreateBody(new box2d.b2BodyDef());
+        var walls = [
+          [2, 0.05, 0, -0.05], [0.05, 2, -2.05, 2], [0.05, 2, 2.05, 2], [2, 0.05, 0, 4.05]
+        ];
+        walls.forEach(function(w) {
+          var shape = new box2d.b2PolygonShape();
+          shape.SetAsBox(w[0], w[1], new box2d.b2Vec2(w[2], w[3]), 0);
+          ground.CreateFixture(shape, 0);
+        });
+        var psd = new box2d.b2ParticleSystemDef();
+        psd.radius = 0.025;
+        psd.dampingStrength = 0.2;
+        var system = world.CreateParticleSystem(psd);
+        var shape = new box2d.b2PolygonShape();
+        shape.SetAsBox(0.8, 1.0, new box2d.b2Vec2(-1.2, 1.01), 0);
+        var pd = new box2d.b2ParticleGroupDef();
+        pd.shape = shape;
+        system.CreateParticleGroup(pd);
+        return { world: world };
+      }
+    });
+  }
+
+  return scenes;
+};
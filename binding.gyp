@@ -1,10 +1,105 @@
 {
+	'variables': {
+		'variables': {
+			'BOX2D_PATH': "Box2D/Box2D"
+		},
+		'BOX2D_PATH': "<(BOX2D_PATH)",
+		'box2d_simd%': "none", # none, sse2 or avx2
+		'box2d_deterministic%': 0, # 1 for bit-identical stepping across machines
+		'build_bench%': 0, # 1 to also build the node-box2d-bench executable
+		'box2d_sources':
+		[
+			"<(BOX2D_PATH)/Box2D/Collision/b2BroadPhase.cpp",
+			"<(BOX2D_PATH)/Box2D/Collision/b2CollideCircle.cpp",
+			"<(BOX2D_PATH)/Box2D/Collision/b2CollideEdge.cpp",
+			"<(BOX2D_PATH)/Box2D/Collision/b2CollidePolygon.cpp",
+			"<(BOX2D_PATH)/Box2D/Collision/b2Collision.cpp",
+			"<(BOX2D_PATH)/Box2D/Collision/b2Distance.cpp",
+			"<(BOX2D_PATH)/Box2D/Collision/b2DynamicTree.cpp",
+			"<(BOX2D_PATH)/Box2D/Collision/b2TimeOfImpact.cpp",
+			"<(BOX2D_PATH)/Box2D/Collision/Shapes/b2ChainShape.cpp",
+			"<(BOX2D_PATH)/Box2D/Collision/Shapes/b2CircleShape.cpp",
+			"<(BOX2D_PATH)/Box2D/Collision/Shapes/b2EdgeShape.cpp",
+			"<(BOX2D_PATH)/Box2D/Collision/Shapes/b2PolygonShape.cpp",
+			"<(BOX2D_PATH)/Box2D/Common/b2BlockAllocator.cpp",
+			"<(BOX2D_PATH)/Box2D/Common/b2Draw.cpp",
+			"<(BOX2D_PATH)/Box2D/Common/b2FreeList.cpp",
+			"<(BOX2D_PATH)/Box2D/Common/b2Math.cpp",
+			"<(BOX2D_PATH)/Box2D/Common/b2Settings.cpp",
+			"<(BOX2D_PATH)/Box2D/Common/b2StackAllocator.cpp",
+			"<(BOX2D_PATH)/Box2D/Common/b2Stat.cpp",
+			"<(BOX2D_PATH)/Box2D/Common/b2Timer.cpp",
+			"<(BOX2D_PATH)/Box2D/Common/b2TrackedBlock.cpp",
+			"<(BOX2D_PATH)/Box2D/Dynamics/b2Body.cpp",
+			"<(BOX2D_PATH)/Box2D/Dynamics/b2ContactManager.cpp",
+			"<(BOX2D_PATH)/Box2D/Dynamics/b2Fixture.cpp",
+			"<(BOX2D_PATH)/Box2D/Dynamics/b2Island.cpp",
+			"<(BOX2D_PATH)/Box2D/Dynamics/b2World.cpp",
+			"<(BOX2D_PATH)/Box2D/Dynamics/b2WorldCallbacks.cpp",
+			"<(BOX2D_PATH)/Box2D/Dynamics/Contacts/b2ChainAndCircleContact.cpp",
+			"<(BOX2D_PATH)/Box2D/Dynamics/Contacts/b2ChainAndPolygonContact.cpp",
+			"<(BOX2D_PATH)/Box2D/Dynamics/Contacts/b2CircleContact.cpp",
+			"<(BOX2D_PATH)/Box2D/Dynamics/Contacts/b2Contact.cpp",
+			"<(BOX2D_PATH)/Box2D/Dynamics/Contacts/b2ContactSolver.cpp",
+			"<(BOX2D_PATH)/Box2D/Dynamics/Contacts/b2EdgeAndCircleContact.cpp",
+			"<(BOX2D_PATH)/Box2D/Dynamics/Contacts/b2EdgeAndPolygonContact.cpp",
+			"<(BOX2D_PATH)/Box2D/Dynamics/Contacts/b2PolygonAndCircleContact.cpp",
+			"<(BOX2D_PATH)/Box2D/Dynamics/Contacts/b2PolygonContact.cpp",
+			"<(BOX2D_PATH)/Box2D/Dynamics/Joints/b2DistanceJoint.cpp",
+			"<(BOX2D_PATH)/Box2D/Dynamics/Joints/b2FrictionJoint.cpp",
+			"<(BOX2D_PATH)/Box2D/Dynamics/Joints/b2GearJoint.cpp",
+			"<(BOX2D_PATH)/Box2D/Dynamics/Joints/b2Joint.cpp",
+			"<(BOX2D_PATH)/Box2D/Dynamics/Joints/b2MotorJoint.cpp",
+			"<(BOX2D_PATH)/Box2D/Dynamics/Joints/b2MouseJoint.cpp",
+			"<(BOX2D_PATH)/Box2D/Dynamics/Joints/b2PrismaticJoint.cpp",
+			"<(BOX2D_PATH)/Box2D/Dynamics/Joints/b2PulleyJoint.cpp",
+			"<(BOX2D_PATH)/Box2D/Dynamics/Joints/b2RevoluteJoint.cpp",
+			"<(BOX2D_PATH)/Box2D/Dynamics/Joints/b2RopeJoint.cpp",
+			"<(BOX2D_PATH)/Box2D/Dynamics/Joints/b2WeldJoint.cpp",
+			"<(BOX2D_PATH)/Box2D/Dynamics/Joints/b2WheelJoint.cpp",
+			"<(BOX2D_PATH)/Box2D/Particle/b2Particle.cpp",
+			"<(BOX2D_PATH)/Box2D/Particle/b2ParticleAssembly.cpp",
+			"<(BOX2D_PATH)/Box2D/Particle/b2ParticleGroup.cpp",
+			"<(BOX2D_PATH)/Box2D/Particle/b2ParticleSystem.cpp",
+			"<(BOX2D_PATH)/Box2D/Particle/b2VoronoiDiagram.cpp",
+			"<(BOX2D_PATH)/Box2D/Rope/b2Rope.cpp"
+		]
+	},
+	'target_defaults': {
+		# box2d_simd only sets instruction set flags; nothing built with them may run before the cpu check in
+		# node-box2d-cpu.cc, so node-box2d.cc builds its globals on first use, and the engine's globals are
+		# plain constants that optimized builds emit as data
+		'conditions':
+		[
+			[ "box2d_simd=='sse2'", {
+				'defines': [ "NODE_BOX2D_SIMD=1" ],
+				'cflags': [ "-msse2" ],
+				'xcode_settings': { 'OTHER_CFLAGS': [ "-msse2" ] },
+				'msvs_settings': { 'VCCLCompilerTool': { 'EnableEnhancedInstructionSet': "2" } } # /arch:SSE2
+			} ],
+			[ "box2d_simd=='avx2'", {
+				'defines': [ "NODE_BOX2D_SIMD=2" ],
+				'cflags': [ "-mavx2", "-mfma" ],
+				'xcode_settings': { 'OTHER_CFLAGS': [ "-mavx2", "-mfma" ] },
+				'msvs_settings': { 'VCCLCompilerTool': { 'EnableEnhancedInstructionSet': "5" } } # /arch:AVX2
+			} ],
+			[ "box2d_deterministic==1", {
+				'defines': [ "NODE_BOX2D_DETERMINISTIC=1" ],
+				'cflags': [ "-ffp-contract=off", "-fno-fast-math", "-fno-builtin-sinf", "-fno-builtin-cosf", "-fno-builtin-atan2f" ],
+				'xcode_settings': { 'OTHER_CFLAGS': [ "-ffp-contract=off", "-fno-fast-math" ] },
+				'msvs_settings': { 'VCCLCompilerTool': { 'FloatingPointModel': "1" } } # /fp:strict
+			} ]
+		]
+	},
 	'targets': 
 	[
 		{
-			'target_name': "node-box2d",
+			# cpu detection and module registration, built without the simd flags
+			# so that an unsupported cpu gets an error instead of an illegal instruction
+			'target_name': "node-box2d-cpu",
+			'type': "static_library",
 			'variables': {
-				'BOX2D_PATH': "Box2D/Box2D"
+				'win_delay_load_hook': "false"
 			},
 			'include_dirs':
 			[
@@ -13,63 +108,77 @@
 				"<!(node -e \"require('nan')\")"
 			],
 			'sources':
+			[
+				"node-box2d-cpu.cc"
+			],
+			'cflags!': [ "-msse2", "-mavx2", "-mfma" ],
+			'xcode_settings': { 'OTHER_CFLAGS!': [ "-msse2", "-mavx2", "-mfma" ] },
+			'msvs_settings': { 'VCCLCompilerTool': { 'EnableEnhancedInstructionSet': "0" } }
+		},
+		{
+			'target_name': "node-box2d",
+			'dependencies': [ "node-box2d-cpu" ],
+			# the engine keeps its distance and time of impact counters in plain globals;
+			# make them per thread so StepWorlds can run worlds concurrently (see node-box2d.cc)
+			'defines':
+			[
+				"b2_gjkCalls=(*b2_tls_gjkCalls())",
+				"b2_gjkIters=(*b2_tls_gjkIters())",
+				"b2_gjkMaxIters=(*b2_tls_gjkMaxIters())",
+				"b2_toiTime=(*b2_tls_toiTime())",
+				"b2_toiMaxTime=(*b2_tls_toiMaxTime())",
+				"b2_toiCalls=(*b2_tls_toiCalls())",
+				"b2_toiIters=(*b2_tls_toiIters())",
+				"b2_toiMaxIters=(*b2_tls_toiMaxIters())",
+				"b2_toiRootIters=(*b2_tls_toiRootIters())",
+				"b2_toiMaxRootIters=(*b2_tls_toiMaxRootIters())"
+			],
+			'include_dirs':
+			[
+				"<(module_root_dir)",
+				"<(module_root_dir)/<(BOX2D_PATH)",
+				"<!(node -e \"require('nan')\")"
+			],
+			'sources':
 			[
 				"node-box2d.cc",
-				"<(BOX2D_PATH)/Box2D/Collision/b2BroadPhase.cpp",
-				"<(BOX2D_PATH)/Box2D/Collision/b2CollideCircle.cpp",
-				"<(BOX2D_PATH)/Box2D/Collision/b2CollideEdge.cpp",
-				"<(BOX2D_PATH)/Box2D/Collision/b2CollidePolygon.cpp",
-				"<(BOX2D_PATH)/Box2D/Collision/b2Collision.cpp",
-				"<(BOX2D_PATH)/Box2D/Collision/b2Distance.cpp",
-				"<(BOX2D_PATH)/Box2D/Collision/b2DynamicTree.cpp",
-				"<(BOX2D_PATH)/Box2D/Collision/b2TimeOfImpact.cpp",
-				"<(BOX2D_PATH)/Box2D/Collision/Shapes/b2ChainShape.cpp",
-				"<(BOX2D_PATH)/Box2D/Collision/Shapes/b2CircleShape.cpp",
-				"<(BOX2D_PATH)/Box2D/Collision/Shapes/b2EdgeShape.cpp",
-				"<(BOX2D_PATH)/Box2D/Collision/Shapes/b2PolygonShape.cpp",
-				"<(BOX2D_PATH)/Box2D/Common/b2BlockAllocator.cpp",
-				"<(BOX2D_PATH)/Box2D/Common/b2Draw.cpp",
-				"<(BOX2D_PATH)/Box2D/Common/b2FreeList.cpp",
-				"<(BOX2D_PATH)/Box2D/Common/b2Math.cpp",
-				"<(BOX2D_PATH)/Box2D/Common/b2Settings.cpp",
-				"<(BOX2D_PATH)/Box2D/Common/b2StackAllocator.cpp",
-				"<(BOX2D_PATH)/Box2D/Common/b2Stat.cpp",
-				"<(BOX2D_PATH)/Box2D/Common/b2Timer.cpp",
-				"<(BOX2D_PATH)/Box2D/Common/b2TrackedBlock.cpp",
-				"<(BOX2D_PATH)/Box2D/Dynamics/b2Body.cpp",
-				"<(BOX2D_PATH)/Box2D/Dynamics/b2ContactManager.cpp",
-				"<(BOX2D_PATH)/Box2D/Dynamics/b2Fixture.cpp",
-				"<(BOX2D_PATH)/Box2D/Dynamics/b2Island.cpp",
-				"<(BOX2D_PATH)/Box2D/Dynamics/b2World.cpp",
-				"<(BOX2D_PATH)/Box2D/Dynamics/b2WorldCallbacks.cpp",
-				"<(BOX2D_PATH)/Box2D/Dynamics/Contacts/b2ChainAndCircleContact.cpp",
-				"<(BOX2D_PATH)/Box2D/Dynamics/Contacts/b2ChainAndPolygonContact.cpp",
-				"<(BOX2D_PATH)/Box2D/Dynamics/Contacts/b2CircleContact.cpp",
-				"<(BOX2D_PATH)/Box2D/Dynamics/Contacts/b2Contact.cpp",
-				"<(BOX2D_PATH)/Box2D/Dynamics/Contacts/b2ContactSolver.cpp",
-				"<(BOX2D_PATH)/Box2D/Dynamics/Contacts/b2EdgeAndCircleContact.cpp",
-				"<(BOX2D_PATH)/Box2D/Dynamics/Contacts/b2EdgeAndPolygonContact.cpp",
-				"<(BOX2D_PATH)/Box2D/Dynamics/Contacts/b2PolygonAndCircleContact.cpp",
-				"<(BOX2D_PATH)/Box2D/Dynamics/Contacts/b2PolygonContact.cpp",
-				"<(BOX2D_PATH)/Box2D/Dynamics/Joints/b2DistanceJoint.cpp",
-				"<(BOX2D_PATH)/Box2D/Dynamics/Joints/b2FrictionJoint.cpp",
-				"<(BOX2D_PATH)/Box2D/Dynamics/Joints/b2GearJoint.cpp",
-				"<(BOX2D_PATH)/Box2D/Dynamics/Joints/b2Joint.cpp",
-				"<(BOX2D_PATH)/Box2D/Dynamics/Joints/b2MotorJoint.cpp",
-				"<(BOX2D_PATH)/Box2D/Dynamics/Joints/b2MouseJoint.cpp",
-				"<(BOX2D_PATH)/Box2D/Dynamics/Joints/b2PrismaticJoint.cpp",
-				"<(BOX2D_PATH)/Box2D/Dynamics/Joints/b2PulleyJoint.cpp",
-				"<(BOX2D_PATH)/Box2D/Dynamics/Joints/b2RevoluteJoint.cpp",
-				"<(BOX2D_PATH)/Box2D/Dynamics/Joints/b2RopeJoint.cpp",
-				"<(BOX2D_PATH)/Box2D/Dynamics/Joints/b2WeldJoint.cpp",
-				"<(BOX2D_PATH)/Box2D/Dynamics/Joints/b2WheelJoint.cpp",
-				"<(BOX2D_PATH)/Box2D/Particle/b2Particle.cpp",
-				"<(BOX2D_PATH)/Box2D/Particle/b2ParticleAssembly.cpp",
-				"<(BOX2D_PATH)/Box2D/Particle/b2ParticleGroup.cpp",
-				"<(BOX2D_PATH)/Box2D/Particle/b2ParticleSystem.cpp",
-				"<(BOX2D_PATH)/Box2D/Particle/b2VoronoiDiagram.cpp",
-				"<(BOX2D_PATH)/Box2D/Rope/b2Rope.cpp"
+				"node-box2d-settings.cc",
+				"<@(box2d_sources)"
+			],
+			# node-box2d-settings.cc compiles b2Settings.cpp itself, with an atomic allocation count
+			'sources!': [ "<(BOX2D_PATH)/Box2D/Common/b2Settings.cpp" ],
+			'conditions':
+			[
+				[ "box2d_deterministic==1 and OS=='linux'", {
+					# route the engine's sinf/cosf/atan2f to the portable versions in node-box2d.cc
+					'defines': [ "NODE_BOX2D_DETERMINISTIC_WRAP=1" ],
+					'ldflags': [ "-Wl,--wrap=sinf", "-Wl,--wrap=cosf", "-Wl,--wrap=atan2f" ]
+				} ]
 			]
 		}
+	],
+	'conditions':
+	[
+		[ "build_bench==1", {
+			'targets':
+			[
+				{
+					'target_name': "node-box2d-bench",
+					'type': "executable",
+					'variables': {
+						'win_delay_load_hook': "false"
+					},
+					'include_dirs':
+					[
+						"<(module_root_dir)/<(BOX2D_PATH)"
+					],
+					'sources':
+					[
+						"bench/native/bench.cc",
+						"<@(box2d_sources)"
+					]
+				}
+			]
+		} ]
 	]
 }
@@ -0,0 +1,83 @@
+/**
+ * Copyright (c) Flyover Games, LLC.  All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated
+ * documentation files (the "Software"), to deal in the Software
+ * without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to
+ * whom the Software is furnished to do so, subject to the
+ * following conditions:
+ *
+ * The above copyright notice and this permission notice shall
+ * be included in all copies or substantial portions of the
+ * Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY
+ * KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE
+ * WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR
+ * PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ * OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+ * SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include "node-box2d.h"
+
+#if defined(_MSC_VER) && (defined(_M_IX86) || defined(_M_X64))
+#include <intrin.h>
+#endif
+
+// built without the box2d_simd instruction set flags (see binding.gyp), so the cpu check
+// and the module entry point run on any cpu; the engine is only entered once they pass
+
+// set by binding.gyp (box2d_simd): 0 scalar, 1 sse2, 2 avx2 + fma
+#ifndef NODE_BOX2D_SIMD
+#define NODE_BOX2D_SIMD 0
+#endif
+
+namespace node_box2d {
+
+int DetectSimdLevel()
+{
+	#if defined(__GNUC__) && (defined(__i386__) || defined(__x86_64__))
+	__builtin_cpu_init();
+	if (__builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma")) { return 2; }
+	if (__builtin_cpu_supports("sse2")) { return 1; }
+	return 0;
+	#elif defined(_MSC_VER) && (defined(_M_IX86) || defined(_M_X64))
+	int regs[4];
+	__cpuid(regs, 0);
+	int max_leaf = regs[0];
+	__cpuid(regs, 1);
+	bool sse2 = (regs[3] & (1 << 26)) != 0;
+	bool fma = (regs[2] & (1 << 12)) != 0;
+	bool osxsave = (regs[2] & (1 << 27)) != 0;
+	bool avx = (regs[2] & (1 << 28)) != 0;
+	bool avx2 = false;
+	if ((max_leaf >= 7) && fma && osxsave && avx && ((_xgetbv(0) & 6) == 6)) // os saves ymm state
+	{
+		__cpuidex(regs, 7, 0);
+		avx2 = (regs[1] & (1 << 5)) != 0;
+	}
+	return (avx2)?(2):((sse2)?(1):(0));
+	#else
+	return 0;
+	#endif
+}
+
+static NAN_MODULE_INIT(init_checked)
+{
+	// the engine is compiled for one instruction set; refuse to load where it would fault
+	if (NODE_BOX2D_SIMD > DetectSimdLevel())
+	{
+		return Nan::ThrowError("node-box2d was built for an instruction set this CPU lacks; rebuild with --box2d_simd=none");
+	}
+	init(target);
+}
+
+} // namespace node_box2d
+
+NODE_MODULE(node_box2d, node_box2d::init_checked);
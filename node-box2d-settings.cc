@@ -0,0 +1,107 @@
+/**
+ * Copyright (c) Flyover Games, LLC.  All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated
+ * documentation files (the "Software"), to deal in the Software
+ * without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to
+ * whom the Software is furnished to do so, subject to the
+ * following conditions:
+ *
+ * The above copyright notice and this permission notice shall
+ * be included in all copies or substantial portions of the
+ * Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY
+ * KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE
+ * WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR
+ * PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ * OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+ * SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+// stands in for Box2D/Common/b2Settings.cpp: the engine file is compiled here with its allocation
+// entry points renamed out of the way, and replaced below by versions whose allocation count is
+// atomic, as b2World.StepWorlds allocates from several threads at once
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+#include <stdlib.h>
+
+#define b2Alloc b2Alloc_engine
+#define b2Free b2Free_engine
+#define b2SetAllocFreeCallbacks b2SetAllocFreeCallbacks_engine
+#define b2GetNumAllocs b2GetNumAllocs_engine
+#define b2SetNumAllocs b2SetNumAllocs_engine
+#include <Box2D/Common/b2Settings.cpp>
+#undef b2Alloc
+#undef b2Free
+#undef b2SetAllocFreeCallbacks
+#undef b2GetNumAllocs
+#undef b2SetNumAllocs
+
+namespace {
+
+volatile int32 g_num_allocs = 0;
+
+#if defined(_MSC_VER)
+int32 AtomicAdd(volatile int32* value, int32 n) { return _InterlockedExchangeAdd(reinterpret_cast<volatile long*>(value), n) + n; }
+int32 AtomicExchange(volatile int32* value, int32 n) { return _InterlockedExchange(reinterpret_cast<volatile long*>(value), n); }
+#else
+int32 AtomicAdd(volatile int32* value, int32 n) { return __sync_add_and_fetch(value, n); }
+int32 AtomicExchange(volatile int32* value, int32 n) { return __sync_lock_test_and_set(value, n); }
+#endif
+
+void* AllocDefault(int32 size, void* callbackData) { B2_NOT_USED(callbackData); return malloc(size); }
+void FreeDefault(void* mem, void* callbackData) { B2_NOT_USED(callbackData); free(mem); }
+
+// set once at module init, before any world exists
+b2AllocFunction g_alloc_callback = AllocDefault;
+b2FreeFunction g_free_callback = FreeDefault;
+void* g_callback_data = NULL;
+
+} // namespace
+
+void b2SetAllocFreeCallbacks(b2AllocFunction allocCallback, b2FreeFunction freeCallback, void* callbackData)
+{
+	b2Assert(AtomicAdd(&g_num_allocs, 0) == 0);
+	if (allocCallback && freeCallback)
+	{
+		g_alloc_callback = allocCallback;
+		g_free_callback = freeCallback;
+		g_callback_data = callbackData;
+	}
+	else
+	{
+		g_alloc_callback = AllocDefault;
+		g_free_callback = FreeDefault;
+		g_callback_data = NULL;
+	}
+}
+
+void* b2Alloc(int32 size)
+{
+	AtomicAdd(&g_num_allocs, 1);
+	return g_alloc_callback(size, g_callback_data);
+}
+
+void b2Free(void* mem)
+{
+	AtomicAdd(&g_num_allocs, -1);
+	g_free_callback(mem, g_callback_data);
+}
+
+void b2SetNumAllocs(const int32 numAllocs)
+{
+	AtomicExchange(&g_num_allocs, numAllocs);
+}
+
+int32 b2GetNumAllocs()
+{
+	return AtomicAdd(&g_num_allocs, 0);
+}
@@ -28,7 +28,25 @@
 
 #include <Box2D/Box2D.h>
 
-///#include <map>
+#include <stdlib.h>
+#include <string.h>
+#include <algorithm>
+#include <limits>
+#include <list>
+#include <map>
+#include <new>
+#include <set>
+#include <string>
+#include <vector>
+
+#if defined(_WIN32)
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
 
 #if defined(__ANDROID__)
 #include <android/log.h>
@@ -105,488 +123,2061 @@
 #define NANX_float32(value)		static_cast<float32>((value)->NumberValue())
 #define NANX_b2BodyType(value)	static_cast<b2BodyType>((value)->IntegerValue())
 
+#if defined(_MSC_VER)
+#define NODE_BOX2D_THREAD_LOCAL __declspec(thread)
+#else
+#define NODE_BOX2D_THREAD_LOCAL __thread
+#endif
+
+// binding.gyp renames the engine's profiling counters (b2Distance.cpp, b2TimeOfImpact.cpp)
+// to "(*b2_tls_NAME())", so worlds stepped on different threads count into their own copies
+#if defined(b2_gjkCalls)
+#define NODE_BOX2D_ENGINE_COUNTER(TYPE, NAME) TYPE* b2_tls_##NAME() { static NODE_BOX2D_THREAD_LOCAL TYPE value = 0; return &value; }
+NODE_BOX2D_ENGINE_COUNTER(int32, gjkCalls)
+NODE_BOX2D_ENGINE_COUNTER(int32, gjkIters)
+NODE_BOX2D_ENGINE_COUNTER(int32, gjkMaxIters)
+NODE_BOX2D_ENGINE_COUNTER(float32, toiTime)
+NODE_BOX2D_ENGINE_COUNTER(float32, toiMaxTime)
+NODE_BOX2D_ENGINE_COUNTER(int32, toiCalls)
+NODE_BOX2D_ENGINE_COUNTER(int32, toiIters)
+NODE_BOX2D_ENGINE_COUNTER(int32, toiMaxIters)
+NODE_BOX2D_ENGINE_COUNTER(int32, toiRootIters)
+NODE_BOX2D_ENGINE_COUNTER(int32, toiMaxRootIters)
+#undef NODE_BOX2D_ENGINE_COUNTER
+#endif
+
 namespace node_box2d {
 
-//// b2Vec2
+//// memory accounting
 
-class WrapVec2 : public Nan::ObjectWrap
+// liquidfun lets us route b2Alloc/b2Free through our own functions
+#ifndef NODE_BOX2D_TRACK_ALLOC
+#define NODE_BOX2D_TRACK_ALLOC B2_ENABLE_PARTICLE
+#endif
+
+static const size_t g_arena_page_header = 32; // keeps 16 byte alignment
+
+static const size_t g_arena_small_limit = 1024; // 16 byte size classes up to here, powers of two above
+
+// bump allocator for worlds created with the arena option; freed blocks go on a free list per
+// size class and are reused, pages only go back to the system when the arena is released
+class Arena
 {
 private:
-	b2Vec2 m_v2;
-private:
-	WrapVec2() {}
-	WrapVec2(const b2Vec2& v2) { m_v2 = v2; } // struct copy
-	WrapVec2(float32 x, float32 y) : m_v2(x, y) {}
-	~WrapVec2() {}
-public:
-	b2Vec2* Peek() { return &m_v2; }
-	//b2Vec2& GetVec2() { return m_v2; }
-	const b2Vec2& GetVec2() const { return m_v2; }
-	void SetVec2(const b2Vec2& v2) { m_v2 = v2; } // struct copy
-public:
-	static WrapVec2* Unwrap(v8::Local<v8::Value> value) { return (value->IsObject())?(Unwrap(v8::Local<v8::Object>::Cast(value))):(NULL); }
-	static WrapVec2* Unwrap(v8::Local<v8::Object> object) { return Nan::ObjectWrap::Unwrap<WrapVec2>(object); }
-	static b2Vec2* Peek(v8::Local<v8::Value> value) { WrapVec2* wrap = Unwrap(value); return (wrap)?(wrap->Peek()):(NULL); }
-public:
-	static NAN_MODULE_INIT(Init)
+	struct Page
 	{
-		v8::Local<v8::Function> constructor = GetConstructor();
-		target->Set(constructor->GetName(), constructor);
-	}
-	static v8::Local<v8::Object> NewInstance()
+		Page* next;
+		size_t size; // usable bytes
+		size_t used;
+	};
+	struct FreeBlock
 	{
-		Nan::EscapableHandleScope scope;
-		v8::Local<v8::Function> constructor = GetConstructor();
-		v8::Local<v8::Object> instance = constructor->NewInstance();
-		return scope.Escape(instance);
+		FreeBlock* next;
+	};
+	Page* m_pages; // current page first
+	size_t m_page_size;
+	size_t m_reserved;
+	size_t m_used;
+	std::vector<FreeBlock*> m_free; // by size class
+public:
+	explicit Arena(size_t reserve = 0) : m_pages(NULL), m_page_size(0), m_reserved(0), m_used(0)
+	{
+		if (reserve > 0)
+		{
+			// pages are at least 64k; the first one holds the whole size hint
+			m_page_size = b2Max(reserve, static_cast<size_t>(64 * 1024));
+			AddPage(m_page_size, true);
+		}
 	}
-	static v8::Local<v8::Object> NewInstance(const b2Vec2& v2)
+	~Arena() { Release(); }
+	bool IsEnabled() const { return m_page_size > 0; }
+	size_t GetReservedBytes() const { return m_reserved; }
+	size_t GetUsedBytes() const { return m_used; }
+	void* Allocate(size_t size)
 	{
-		Nan::EscapableHandleScope scope;
-		v8::Local<v8::Function> constructor = GetConstructor();
-		v8::Local<v8::Object> instance = constructor->NewInstance();
-		WrapVec2* wrap = Unwrap(instance);
-		wrap->SetVec2(v2);
-		return scope.Escape(instance);
+		size_t class_size = 0;
+		const size_t size_class = GetSizeClass(size, class_size);
+		size = class_size;
+		if ((size_class < m_free.size()) && m_free[size_class])
+		{
+			FreeBlock* block = m_free[size_class];
+			m_free[size_class] = block->next;
+			m_used += size;
+			return block;
+		}
+		if (size > m_page_size / 4)
+		{
+			// big blocks get their own page behind the current one
+			Page* page = AddPage(size, !m_pages);
+			if (!page) { return NULL; }
+			page->used = size;
+			m_used += size;
+			return reinterpret_cast<char*>(page) + g_arena_page_header;
+		}
+		if (!m_pages || (m_pages->used + size > m_pages->size))
+		{
+			if (!AddPage(m_page_size, true)) { return NULL; }
+		}
+		char* mem = reinterpret_cast<char*>(m_pages) + g_arena_page_header + m_pages->used;
+		m_pages->used += size;
+		m_used += size;
+		return mem;
 	}
-private:
-	static v8::Local<v8::Function> GetConstructor()
+	void Free(void* mem, size_t size)
 	{
-		Nan::EscapableHandleScope scope;
-		v8::Local<v8::FunctionTemplate> function_template = GetFunctionTemplate();
-		v8::Local<v8::Function> constructor = function_template->GetFunction();
-		return scope.Escape(constructor);
+		// size as passed to Allocate
+		size_t class_size = 0;
+		const size_t size_class = GetSizeClass(size, class_size);
+		size = class_size;
+		if (size_class >= m_free.size()) { m_free.resize(size_class + 1, NULL); }
+		FreeBlock* block = static_cast<FreeBlock*>(mem);
+		block->next = m_free[size_class];
+		m_free[size_class] = block;
+		m_used -= size;
 	}
-	static v8::Local<v8::FunctionTemplate> GetFunctionTemplate()
+	void Release()
 	{
-		Nan::EscapableHandleScope scope;
-		static Nan::Persistent<v8::FunctionTemplate> g_function_template;
-		if (g_function_template.IsEmpty())
+		while (m_pages)
 		{
-			v8::Local<v8::FunctionTemplate> function_template = Nan::New<v8::FunctionTemplate>(New);
-			function_template->SetClassName(NANX_SYMBOL("b2Vec2"));
-			function_template->InstanceTemplate()->SetInternalFieldCount(1);
-			v8::Local<v8::ObjectTemplate> prototype_template = function_template->PrototypeTemplate();
-			NANX_MEMBER_APPLY(prototype_template, x)
-			NANX_MEMBER_APPLY(prototype_template, y)
-			NANX_METHOD_APPLY(prototype_template, SetZero)
-			NANX_METHOD_APPLY(prototype_template, Set)
-			NANX_METHOD_APPLY(prototype_template, Copy)
-			NANX_METHOD_APPLY(prototype_template, SelfNeg)
-			NANX_METHOD_APPLY(prototype_template, SelfAdd)
-			NANX_METHOD_APPLY(prototype_template, SelfAddXY)
-			NANX_METHOD_APPLY(prototype_template, SelfSub)
-			NANX_METHOD_APPLY(prototype_template, SelfSubXY)
-			NANX_METHOD_APPLY(prototype_template, SelfMul)
-			NANX_METHOD_APPLY(prototype_template, Length)
-			NANX_METHOD_APPLY(prototype_template, LengthSquared)
-			NANX_METHOD_APPLY(prototype_template, Normalize)
-			NANX_METHOD_APPLY(prototype_template, SelfNormalize)
-			NANX_METHOD_APPLY(prototype_template, IsValid)
-			g_function_template.Reset(function_template);
+			Page* next = m_pages->next;
+			free(m_pages);
+			m_pages = next;
 		}
-		v8::Local<v8::FunctionTemplate> function_template = Nan::New<v8::FunctionTemplate>(g_function_template);
-		return scope.Escape(function_template);
+		m_free.clear();
+		m_reserved = 0;
+		m_used = 0;
 	}
 private:
-	static NAN_METHOD(New)
+	static size_t GetSizeClass(size_t size, size_t& class_size)
 	{
-		if (info.IsConstructCall())
+		class_size = (size + 15) & ~static_cast<size_t>(15);
+		if (class_size <= g_arena_small_limit) { return class_size / 16 - 1; }
+		size_t size_class = g_arena_small_limit / 16;
+		size_t bytes = g_arena_small_limit * 2;
+		while (bytes < class_size) { bytes *= 2; ++size_class; }
+		class_size = bytes;
+		return size_class;
+	}
+	Page* AddPage(size_t size, bool front)
+	{
+		Page* page = static_cast<Page*>(malloc(g_arena_page_header + size));
+		if (!page) { return NULL; }
+		page->size = size;
+		page->used = 0;
+		if (front || !m_pages)
 		{
-			float32 x = (info.Length() > 0) ? NANX_float32(info[0]) : 0.0f;
-			float32 y = (info.Length() > 1) ? NANX_float32(info[1]) : 0.0f;
-			WrapVec2* wrap = new WrapVec2(x, y);
-			wrap->Wrap(info.This());
-			info.GetReturnValue().Set(info.This());
+			page->next = m_pages;
+			m_pages = page;
 		}
 		else
 		{
-			v8::Local<v8::Function> constructor = GetConstructor();
-			info.GetReturnValue().Set(constructor->NewInstance());
+			page->next = m_pages->next;
+			m_pages->next = page;
 		}
+		m_reserved += size;
+		return page;
 	}
-	NANX_MEMBER_NUMBER(float32, x)
-	NANX_MEMBER_NUMBER(float32, y)
-	NANX_METHOD(SetZero)
+};
+
+struct AllocStats
+{
+	size_t bytes; // live bytes from b2Alloc
+	size_t peak; // most live bytes seen
+	int32 count; // live allocations
+	int32 chunks; // live b2BlockAllocator chunks
+	size_t reported; // bytes last reported to v8
+	Arena* arena; // if set, allocations come from here and freed blocks are reused through its free lists
+	explicit AllocStats(Arena* from_arena = NULL) : bytes(0), peak(0), count(0), chunks(0), reported(0), arena(from_arena) {}
+};
+
+// tell v8 how much native memory was gained or lost since the last report
+static void ReportExternalMemory(AllocStats* stats)
+{
+	if (stats->bytes > stats->reported)
 	{
-		b2Vec2* that = Peek(info.This());
-		that->SetZero();
-		info.GetReturnValue().Set(info.This());
+		Nan::AdjustExternalMemory(static_cast<int>(stats->bytes - stats->reported));
 	}
-	NANX_METHOD(Set)
+	else if (stats->bytes < stats->reported)
 	{
-		b2Vec2* that = Peek(info.This());
-		that->Set(NANX_float32(info[0]), NANX_float32(info[1]));
-		info.GetReturnValue().Set(info.This());
+		Nan::AdjustExternalMemory(-static_cast<int>(stats->reported - stats->bytes));
 	}
-	NANX_METHOD(Copy)
+	stats->reported = stats->bytes;
+}
+
+// allocations made while no world is current (javascript shapes, module setup);
+// built on first use, as this file may carry simd flags and must not run code before the cpu check
+static AllocStats& AllocUnowned()
+{
+	static AllocStats stats;
+	return stats;
+}
+static NODE_BOX2D_THREAD_LOCAL AllocStats* g_alloc_target = NULL; // worlds may step on worker threads
+
+// charge b2Alloc calls to a world for the lifetime of the scope, then report the change to v8
+class AllocScope
+{
+private:
+	AllocStats* m_stats;
+	AllocStats* m_prev;
+	bool m_active;
+	bool m_report; // false off the main thread
+public:
+	AllocScope(AllocStats* stats, bool report = true) : m_stats(stats), m_prev(g_alloc_target), m_active(true), m_report(report) { g_alloc_target = stats; }
+	~AllocScope() { Leave(); }
+	void Leave()
 	{
-		b2Vec2* that = Peek(info.This());
-		b2Vec2* other = Peek(info[0]);
-		*that = *other;
-		info.GetReturnValue().Set(info.This());
+		if (m_active)
+		{
+			g_alloc_target = m_prev;
+			m_active = false;
+			if (m_stats && m_report) { ReportExternalMemory(m_stats); }
+		}
 	}
-	NANX_METHOD(SelfNeg)
+};
+
+#if NODE_BOX2D_TRACK_ALLOC
+
+// each allocation is prefixed with its owner so frees are charged back correctly
+struct AllocHeader
+{
+	AllocStats* stats;
+	int32 size;
+};
+
+static const int32 g_alloc_header_size = 16; // keeps 16 byte alignment
+
+static void* TrackedAlloc(int32 size, void* callbackData)
+{
+	AllocStats* stats = (g_alloc_target)?(g_alloc_target):(&AllocUnowned());
+	char* mem = static_cast<char*>((stats->arena)?(stats->arena->Allocate(g_alloc_header_size + size)):(malloc(g_alloc_header_size + size)));
+	if (!mem) { return NULL; }
+	AllocHeader* header = reinterpret_cast<AllocHeader*>(mem);
+	header->stats = stats;
+	header->size = size;
+	stats->bytes += size;
+	stats->peak = b2Max(stats->peak, stats->bytes);
+	++stats->count;
+	if (size == b2_chunkSize) { ++stats->chunks; }
+	return mem + g_alloc_header_size;
+}
+
+static void TrackedFree(void* mem, void* callbackData)
+{
+	if (!mem) { return; }
+	char* base = static_cast<char*>(mem) - g_alloc_header_size;
+	AllocHeader* header = reinterpret_cast<AllocHeader*>(base);
+	AllocStats* stats = header->stats;
+	stats->bytes -= header->size;
+	--stats->count;
+	if (header->size == b2_chunkSize) { --stats->chunks; }
+	if (stats->arena)
+	{
+		stats->arena->Free(base, g_alloc_header_size + header->size);
+		return;
+	}
+	free(base);
+}
+
+#endif
+
+// mirrors the size classes of b2BlockAllocator
+static const int32 g_block_sizes[] = { 16, 32, 64, 96, 128, 160, 192, 224, 256, 320, 384, 448, 512, 640 };
+
+// returns the size class index, or -1 for sizes that go straight to b2Alloc
+static int32 BlockSizeClass(int32 size)
+{
+	for (int32 i = 0; i < static_cast<int32>(countof(g_block_sizes)); ++i)
 	{
-		b2Vec2* that = Peek(info.This());
-		*that = that->operator-();
-		info.GetReturnValue().Set(info.This());
+		if (size <= g_block_sizes[i]) { return i; }
 	}
-	NANX_METHOD(SelfAdd)
+	return -1;
+}
+
+//// worker threads
+
+// threads for b2World.StepWorlds, started on first use and parked between calls
+class WorkerPool
+{
+private:
+	struct Worker
 	{
-		b2Vec2* that = Peek(info.This());
-		b2Vec2* v = Peek(info[0]);
-		that->operator+=(*v);
-		info.GetReturnValue().Set(info.This());
+		WorkerPool* pool;
+		int32 index;
+		uint32 generation; // last job seen, taken before the thread starts
+		uv_thread_t thread;
+	};
+	std::vector<Worker*> m_workers;
+	uv_mutex_t m_mutex;
+	uv_cond_t m_wake; // signalled when a job is posted or the pool stops
+	uv_cond_t m_done; // signalled when the last worker finishes a job
+	void (*m_work)(void*);
+	void* m_arg;
+	int32 m_wanted; // workers taking part in the current job
+	int32 m_running; // of those, still working
+	uint32 m_generation; // bumped for every job
+	bool m_stop;
+public:
+	WorkerPool() : m_work(NULL), m_arg(NULL), m_wanted(0), m_running(0), m_generation(0), m_stop(false)
+	{
+		uv_mutex_init(&m_mutex);
+		uv_cond_init(&m_wake);
+		uv_cond_init(&m_done);
+	}
+	~WorkerPool()
+	{
+		uv_mutex_lock(&m_mutex);
+		m_stop = true;
+		uv_cond_broadcast(&m_wake);
+		uv_mutex_unlock(&m_mutex);
+		for (size_t i = 0; i < m_workers.size(); ++i)
+		{
+			uv_thread_join(&m_workers[i]->thread);
+			delete m_workers[i];
+		}
+		uv_cond_destroy(&m_done);
+		uv_cond_destroy(&m_wake);
+		uv_mutex_destroy(&m_mutex);
+	}
+	// runs work(arg) on up to worker_count pool threads and on the calling thread, then waits for all of them
+	void Run(void (*work)(void*), void* arg, int32 worker_count)
+	{
+		while (static_cast<int32>(m_workers.size()) < worker_count)
+		{
+			Worker* worker = new Worker();
+			worker->pool = this;
+			worker->index = static_cast<int32>(m_workers.size());
+			worker->generation = m_generation;
+			if (uv_thread_create(&worker->thread, WorkerThread, worker) != 0) { delete worker; break; }
+			m_workers.push_back(worker);
+		}
+		worker_count = b2Min(worker_count, static_cast<int32>(m_workers.size()));
+		if (worker_count > 0)
+		{
+			uv_mutex_lock(&m_mutex);
+			m_work = work;
+			m_arg = arg;
+			m_wanted = worker_count;
+			m_running = worker_count;
+			++m_generation;
+			uv_cond_broadcast(&m_wake);
+			uv_mutex_unlock(&m_mutex);
+		}
+		work(arg);
+		if (worker_count > 0)
+		{
+			uv_mutex_lock(&m_mutex);
+			while (m_running > 0) { uv_cond_wait(&m_done, &m_mutex); }
+			m_work = NULL;
+			m_arg = NULL;
+			uv_mutex_unlock(&m_mutex);
+		}
+	}
+private:
+	static void WorkerThread(void* arg)
+	{
+		Worker* worker = static_cast<Worker*>(arg);
+		WorkerPool* pool = worker->pool;
+		uint32 generation = worker->generation;
+		uv_mutex_lock(&pool->m_mutex);
+		for (;;)
+		{
+			while (!pool->m_stop && (pool->m_generation == generation)) { uv_cond_wait(&pool->m_wake, &pool->m_mutex); }
+			if (pool->m_stop) { break; }
+			generation = pool->m_generation;
+			if (worker->index >= pool->m_wanted) { continue; }
+			void (*work)(void*) = pool->m_work;
+			void* work_arg = pool->m_arg;
+			uv_mutex_unlock(&pool->m_mutex);
+			work(work_arg);
+			uv_mutex_lock(&pool->m_mutex);
+			if (--pool->m_running == 0) { uv_cond_signal(&pool->m_done); }
+		}
+		uv_mutex_unlock(&pool->m_mutex);
 	}
-	NANX_METHOD(SelfAddXY)
+};
+
+// built on first use, like AllocUnowned
+static WorkerPool& StepPool()
+{
+	static WorkerPool pool;
+	return pool;
+}
+
+// b2Contact fills its dispatch table on first use; do it here rather than racing on the first step
+class ContactRegisters : public b2Contact
+{
+public:
+	static void Initialize()
 	{
-		b2Vec2* that = Peek(info.This());
-		that->operator+=(b2Vec2(NANX_float32(info[0]), NANX_float32(info[1])));
-		info.GetReturnValue().Set(info.This());
+		if (!s_initialized)
+		{
+			InitializeRegisters();
+			s_initialized = true;
+		}
 	}
-	NANX_METHOD(SelfSub)
+};
+
+//// recording
+
+// world mutation log written by b2World.StartRecording and re-run natively by b2World.Replay;
+// values are in native byte order, so a log replays on the build (and platform) that wrote it
+enum RecordOp
+{
+	e_recordEnd = 0,
+	e_recordStep,
+	e_recordCreateBody,
+	e_recordDestroyBody,
+	e_recordClear,
+	e_recordCreateFixture,
+	e_recordDestroyFixture,
+	e_recordCreateJoint,
+	e_recordDestroyJoint,
+	e_recordCreateTileCollision,
+	e_recordUpdateTileCollision,
+	e_recordSetGravity,
+	e_recordSetWorldFlag,
+	e_recordClearForces,
+	e_recordSetBodyTick,
+	e_recordSetTransform,
+	e_recordSetLinearVelocity,
+	e_recordSetAngularVelocity,
+	e_recordApplyForce,
+	e_recordApplyForceToCenter,
+	e_recordApplyTorque,
+	e_recordApplyLinearImpulse,
+	e_recordApplyAngularImpulse,
+	e_recordSetMassData,
+	e_recordResetMassData,
+	e_recordSetBodyFloat,
+	e_recordSetBodyFlag,
+	e_recordSetType,
+	e_recordSetFixtureFloat,
+	e_recordSetSensor,
+	e_recordSetFilterData,
+	e_recordRefilter,
+	e_recordSetTarget,
+	e_recordEnableMotor,
+	e_recordSetMotorSpeed,
+	e_recordEnableLimit,
+	e_recordSetLimits
+};
+
+enum RecordWorldFlag { e_recordAllowSleeping, e_recordWarmStarting, e_recordContinuousPhysics, e_recordSubStepping, e_recordAutoClearForces };
+enum RecordBodyFloat { e_recordLinearDamping, e_recordAngularDamping, e_recordGravityScale };
+enum RecordBodyFlag { e_recordBullet, e_recordSleepingAllowed, e_recordAwake, e_recordActive, e_recordFixedRotation };
+enum RecordFixtureFloat { e_recordDensity, e_recordFriction, e_recordRestitution };
+
+static const uint32 g_record_magic = 0x4c523262; // "b2RL"
+static const uint32 g_record_version = 1;
+static const int32 g_record_max_id = 1 << 24; // bounds replay tables against corrupt logs
+
+static int32 GetJointDefSize(b2JointType type)
+{
+	switch (type)
+	{
+	case e_revoluteJoint: return sizeof(b2RevoluteJointDef);
+	case e_prismaticJoint: return sizeof(b2PrismaticJointDef);
+	case e_distanceJoint: return sizeof(b2DistanceJointDef);
+	case e_pulleyJoint: return sizeof(b2PulleyJointDef);
+	case e_mouseJoint: return sizeof(b2MouseJointDef);
+	case e_gearJoint: return sizeof(b2GearJointDef);
+	case e_wheelJoint: return sizeof(b2WheelJointDef);
+	case e_weldJoint: return sizeof(b2WeldJointDef);
+	case e_frictionJoint: return sizeof(b2FrictionJointDef);
+	case e_ropeJoint: return sizeof(b2RopeJointDef);
+	case e_motorJoint: return sizeof(b2MotorJointDef);
+	default: return 0;
+	}
+}
+
+class Recorder
+{
+private:
+	bool m_recording;
+	std::vector<uint8> m_data;
+	std::map<const b2Fixture*,int32> m_fixture_ids; // fixtures and joints are numbered in creation order
+	std::map<const b2Joint*,int32> m_joint_ids;
+	int32 m_next_fixture_id;
+	int32 m_next_joint_id;
+public:
+	Recorder() : m_recording(false), m_next_fixture_id(0), m_next_joint_id(0) {}
+	bool IsRecording() const { return m_recording; }
+	size_t GetSize() const { return m_data.size(); }
+	void Start(const b2Vec2& gravity)
 	{
-		b2Vec2* that = Peek(info.This());
-		b2Vec2* v = Peek(info[0]);
-		that->operator-=(*v);
-		info.GetReturnValue().Set(info.This());
+		m_recording = true;
+		m_data.clear();
+		m_fixture_ids.clear();
+		m_joint_ids.clear();
+		m_next_fixture_id = 0;
+		m_next_joint_id = 0;
+		Uint(g_record_magic).Uint(g_record_version).Uint(static_cast<uint32>(sizeof(void*)));
+		Int(b2_version.major).Int(b2_version.minor).Int(b2_version.revision);
+		Vec2(gravity);
 	}
-	NANX_METHOD(SelfSubXY)
+	void Stop(std::vector<uint8>& out)
 	{
-		b2Vec2* that = Peek(info.This());
-		that->operator-=(b2Vec2(NANX_float32(info[0]), NANX_float32(info[1])));
-		info.GetReturnValue().Set(info.This());
+		Op(e_recordEnd);
+		m_recording = false;
+		out.swap(m_data);
+		m_data.clear();
+		m_fixture_ids.clear();
+		m_joint_ids.clear();
 	}
-	NANX_METHOD(SelfMul)
+public:
+	Recorder& Op(RecordOp op) { return Uint8(static_cast<uint8>(op)); }
+	Recorder& Uint8(uint8 value) { m_data.push_back(value); return *this; }
+	Recorder& Int(int32 value) { return Bytes(&value, sizeof(value)); }
+	Recorder& Uint(uint32 value) { return Bytes(&value, sizeof(value)); }
+	Recorder& Float(float32 value) { return Bytes(&value, sizeof(value)); }
+	Recorder& Vec2(const b2Vec2& value) { return Float(value.x).Float(value.y); }
+	Recorder& Bool(bool value) { return Uint8((value)?(1):(0)); }
+	Recorder& Bytes(const void* data, size_t size)
 	{
-		b2Vec2* that = Peek(info.This());
-		that->operator*=(NANX_float32(info[0]));
-		info.GetReturnValue().Set(info.This());
+		const uint8* bytes = static_cast<const uint8*>(data);
+		m_data.insert(m_data.end(), bytes, bytes + size);
+		return *this;
 	}
-	NANX_METHOD(Length)
+	Recorder& Filter(const b2Filter& filter)
 	{
-		b2Vec2* that = Peek(info.This());
-		info.GetReturnValue().Set(Nan::New(that->Length()));
+		return Int(filter.categoryBits).Int(filter.maskBits).Int(filter.groupIndex);
 	}
-	NANX_METHOD(LengthSquared)
+	Recorder& BodyDef(const b2BodyDef& bd)
 	{
-		b2Vec2* that = Peek(info.This());
-		info.GetReturnValue().Set(Nan::New(that->LengthSquared()));
+		Int(bd.type).Vec2(bd.position).Float(bd.angle).Vec2(bd.linearVelocity).Float(bd.angularVelocity);
+		Float(bd.linearDamping).Float(bd.angularDamping).Float(bd.gravityScale);
+		return Bool(bd.allowSleep).Bool(bd.awake).Bool(bd.fixedRotation).Bool(bd.bullet).Bool(bd.active);
 	}
-	NANX_METHOD(Normalize)
+	Recorder& Material(const b2FixtureDef& fd)
 	{
-		b2Vec2* that = Peek(info.This());
-		info.GetReturnValue().Set(Nan::New(that->Normalize()));
+		// everything in a fixture def but the shape and user data
+		return Float(fd.friction).Float(fd.restitution).Float(fd.density).Bool(fd.isSensor).Filter(fd.filter);
 	}
-	NANX_METHOD(SelfNormalize)
+	Recorder& Shape(const b2Shape* shape)
 	{
-		b2Vec2* that = Peek(info.This());
-		that->Normalize();
-		info.GetReturnValue().Set(info.This());
+		Int(shape->GetType()).Float(shape->m_radius);
+		switch (shape->GetType())
+		{
+		case b2Shape::e_circle:
+		{
+			const b2CircleShape* circle = static_cast<const b2CircleShape*>(shape);
+			return Vec2(circle->m_p);
+		}
+		case b2Shape::e_edge:
+		{
+			const b2EdgeShape* edge = static_cast<const b2EdgeShape*>(shape);
+			Vec2(edge->m_vertex0).Vec2(edge->m_vertex1).Vec2(edge->m_vertex2).Vec2(edge->m_vertex3);
+			return Bool(edge->m_hasVertex0).Bool(edge->m_hasVertex3);
+		}
+		case b2Shape::e_polygon:
+		{
+			// stored as built, so replay does not rerun the hull
+			const b2PolygonShape* polygon = static_cast<const b2PolygonShape*>(shape);
+			Int(polygon->m_count).Vec2(polygon->m_centroid);
+			Bytes(polygon->m_vertices, polygon->m_count * sizeof(b2Vec2));
+			return Bytes(polygon->m_normals, polygon->m_count * sizeof(b2Vec2));
+		}
+		case b2Shape::e_chain:
+		{
+			const b2ChainShape* chain = static_cast<const b2ChainShape*>(shape);
+			Int(chain->m_count).Bytes(chain->m_vertices, chain->m_count * sizeof(b2Vec2));
+			return Vec2(chain->m_prevVertex).Vec2(chain->m_nextVertex).Bool(chain->m_hasPrevVertex).Bool(chain->m_hasNextVertex);
+		}
+		default:
+			return *this;
+		}
 	}
-	NANX_METHOD(IsValid)
+public:
+	int32 AddFixture(const b2Fixture* fixture) { return (m_fixture_ids[fixture] = m_next_fixture_id++); }
+	int32 GetFixtureId(const b2Fixture* fixture) const
 	{
-		b2Vec2* that = Peek(info.This());
-		info.GetReturnValue().Set(Nan::New(that->IsValid()));
+		std::map<const b2Fixture*,int32>::const_iterator it = m_fixture_ids.find(fixture);
+		return (it != m_fixture_ids.end())?(it->second):(-1);
 	}
+	void RemoveFixture(const b2Fixture* fixture) { m_fixture_ids.erase(fixture); }
+	int32 AddJoint(const b2Joint* joint) { return (m_joint_ids[joint] = m_next_joint_id++); }
+	int32 GetJointId(const b2Joint* joint) const
+	{
+		std::map<const b2Joint*,int32>::const_iterator it = m_joint_ids.find(joint);
+		return (it != m_joint_ids.end())?(it->second):(-1);
+	}
+	void RemoveJoint(const b2Joint* joint) { m_joint_ids.erase(joint); }
 };
 
-//// b2Rot
+// shape storage for one replayed fixture; the chain frees its vertices with it
+struct RecordShapes
+{
+	b2CircleShape circle;
+	b2EdgeShape edge;
+	b2PolygonShape polygon;
+	b2ChainShape chain;
+};
 
-class WrapRot : public Nan::ObjectWrap
+// one of each joint def, so a recorded def can be copied over the right type
+struct RecordJointDefs
+{
+	b2RevoluteJointDef revolute;
+	b2PrismaticJointDef prismatic;
+	b2DistanceJointDef distance;
+	b2PulleyJointDef pulley;
+	b2MouseJointDef mouse;
+	b2GearJointDef gear;
+	b2WheelJointDef wheel;
+	b2WeldJointDef weld;
+	b2FrictionJointDef friction;
+	b2RopeJointDef rope;
+	b2MotorJointDef motor;
+	b2JointDef* Get(b2JointType type)
+	{
+		switch (type)
+		{
+		case e_revoluteJoint: return &revolute;
+		case e_prismaticJoint: return &prismatic;
+		case e_distanceJoint: return &distance;
+		case e_pulleyJoint: return &pulley;
+		case e_mouseJoint: return &mouse;
+		case e_gearJoint: return &gear;
+		case e_wheelJoint: return &wheel;
+		case e_weldJoint: return &weld;
+		case e_frictionJoint: return &friction;
+		case e_ropeJoint: return &rope;
+		case e_motorJoint: return &motor;
+		default: return NULL;
+		}
+	}
+};
+
+class RecordReader
 {
 private:
-	b2Rot m_rot;
-private:
-	WrapRot() {}
-	WrapRot(const b2Rot& rot) { m_rot = rot; } // struct copy
-	WrapRot(float32 angle) : m_rot(angle) {}
-	~WrapRot() {}
-public:
-	b2Rot* Peek() { return &m_rot; }
-	//b2Rot& GetRot() { return m_rot; }
-	const b2Rot& GetRot() const { return m_rot; }
-	void SetRot(const b2Rot& rot) { m_rot = rot; } // struct copy
-public:
-	static WrapRot* Unwrap(v8::Local<v8::Value> value) { return (value->IsObject())?(Unwrap(v8::Local<v8::Object>::Cast(value))):(NULL); }
-	static WrapRot* Unwrap(v8::Local<v8::Object> object) { return Nan::ObjectWrap::Unwrap<WrapRot>(object); }
-	static b2Rot* Peek(v8::Local<v8::Value> value) { WrapRot* wrap = Unwrap(value); return (wrap)?(wrap->Peek()):(NULL); }
-public:
-	static NAN_MODULE_INIT(Init)
-	{
-		v8::Local<v8::Function> constructor = GetConstructor();
-		target->Set(constructor->GetName(), constructor);
+	const uint8* m_next;
+	const uint8* m_end;
+	bool m_ok; // cleared by the first read past the end; later reads return zeros
+public:
+	RecordReader(const uint8* data, size_t size) : m_next(data), m_end(data + size), m_ok(true) {}
+	bool IsOk() const { return m_ok; }
+	void Fail() { m_ok = false; }
+	const uint8* Bytes(size_t size)
+	{
+		if (!m_ok || (static_cast<size_t>(m_end - m_next) < size)) { m_ok = false; return NULL; }
+		const uint8* bytes = m_next;
+		m_next += size;
+		return bytes;
+	}
+	void Read(void* out, size_t size)
+	{
+		const uint8* bytes = Bytes(size);
+		if (bytes) { memcpy(out, bytes, size); } else { memset(out, 0, size); }
+	}
+	uint8 Uint8() { uint8 value; Read(&value, sizeof(value)); return value; }
+	int32 Int() { int32 value; Read(&value, sizeof(value)); return value; }
+	uint32 Uint() { uint32 value; Read(&value, sizeof(value)); return value; }
+	float32 Float() { float32 value; Read(&value, sizeof(value)); return value; }
+	b2Vec2 Vec2() { float32 x = Float(); float32 y = Float(); return b2Vec2(x, y); }
+	bool Bool() { return Uint8() != 0; }
+	void Filter(b2Filter& filter)
+	{
+		filter.categoryBits = static_cast<uint16>(Int());
+		filter.maskBits = static_cast<uint16>(Int());
+		filter.groupIndex = static_cast<int16>(Int());
+	}
+	void BodyDef(b2BodyDef& bd)
+	{
+		bd.type = static_cast<b2BodyType>(Int());
+		bd.position = Vec2();
+		bd.angle = Float();
+		bd.linearVelocity = Vec2();
+		bd.angularVelocity = Float();
+		bd.linearDamping = Float();
+		bd.angularDamping = Float();
+		bd.gravityScale = Float();
+		bd.allowSleep = Bool();
+		bd.awake = Bool();
+		bd.fixedRotation = Bool();
+		bd.bullet = Bool();
+		bd.active = Bool();
+		if ((bd.type != b2_staticBody) && (bd.type != b2_kinematicBody) && (bd.type != b2_dynamicBody)) { Fail(); }
+	}
+	void Material(b2FixtureDef& fd)
+	{
+		fd.friction = Float();
+		fd.restitution = Float();
+		fd.density = Float();
+		fd.isSensor = Bool();
+		Filter(fd.filter);
+	}
+	const b2Shape* Shape(RecordShapes& shapes)
+	{
+		int32 type = Int();
+		float32 radius = Float();
+		switch (type)
+		{
+		case b2Shape::e_circle:
+			shapes.circle.m_radius = radius;
+			shapes.circle.m_p = Vec2();
+			return (m_ok)?(&shapes.circle):(NULL);
+		case b2Shape::e_edge:
+			shapes.edge.m_radius = radius;
+			shapes.edge.m_vertex0 = Vec2();
+			shapes.edge.m_vertex1 = Vec2();
+			shapes.edge.m_vertex2 = Vec2();
+			shapes.edge.m_vertex3 = Vec2();
+			shapes.edge.m_hasVertex0 = Bool();
+			shapes.edge.m_hasVertex3 = Bool();
+			return (m_ok)?(&shapes.edge):(NULL);
+		case b2Shape::e_polygon:
+		{
+			int32 count = Int();
+			if ((count < 3) || (count > b2_maxPolygonVertices)) { Fail(); return NULL; }
+			shapes.polygon.m_radius = radius;
+			shapes.polygon.m_count = count;
+			shapes.polygon.m_centroid = Vec2();
+			Read(shapes.polygon.m_vertices, count * sizeof(b2Vec2));
+			Read(shapes.polygon.m_normals, count * sizeof(b2Vec2));
+			return (m_ok)?(&shapes.polygon):(NULL);
+		}
+		case b2Shape::e_chain:
+		{
+			int32 count = Int();
+			const uint8* vertices = Bytes(b2Max(count, 0) * sizeof(b2Vec2));
+			if (!vertices || (count < 2)) { Fail(); return NULL; }
+			shapes.chain.m_radius = radius;
+			shapes.chain.m_count = count;
+			shapes.chain.m_vertices = static_cast<b2Vec2*>(b2Alloc(count * sizeof(b2Vec2)));
+			memcpy(shapes.chain.m_vertices, vertices, count * sizeof(b2Vec2));
+			shapes.chain.m_prevVertex = Vec2();
+			shapes.chain.m_nextVertex = Vec2();
+			shapes.chain.m_hasPrevVertex = Bool();
+			shapes.chain.m_hasNextVertex = Bool();
+			return (m_ok)?(&shapes.chain):(NULL);
+		}
+		default:
+			Fail();
+			return NULL;
+		}
 	}
-	static v8::Local<v8::Object> NewInstance()
+};
+
+//// scene
+
+// RUBE (b2dJson) scenes are parsed into plain structs without touching v8 or the world,
+// so LoadSceneAsync can parse on the thread pool; only instantiation runs on the main thread
+
+static const int32 g_json_max_depth = 64;
+
+struct JsonValue
+{
+	enum Type { e_null, e_bool, e_number, e_string, e_array, e_object };
+	Type type;
+	bool boolean;
+	double number;
+	std::string string;
+	std::vector<JsonValue> items; // array elements, or object member values
+	std::vector<std::string> keys; // object member names, parallel to items
+	JsonValue() : type(e_null), boolean(false), number(0.0) {}
+	const JsonValue* Find(const char* key) const
 	{
-		Nan::EscapableHandleScope scope;
-		v8::Local<v8::Function> constructor = GetConstructor();
-		v8::Local<v8::Object> instance = constructor->NewInstance();
-		return scope.Escape(instance);
+		if (type != e_object) { return NULL; }
+		for (size_t i = 0; i < keys.size(); ++i)
+		{
+			if (keys[i] == key) { return &items[i]; }
+		}
+		return NULL;
 	}
-	static v8::Local<v8::Object> NewInstance(const b2Rot& rot)
+	size_t GetCount() const { return (type == e_array)?(items.size()):(0); }
+};
+
+class JsonParser
+{
+private:
+	const char* m_next;
+	const char* m_end;
+	int32 m_depth;
+public:
+	JsonParser(const char* data, size_t size) : m_next(data), m_end(data + size), m_depth(0) {}
+	bool Parse(JsonValue& value)
 	{
-		Nan::EscapableHandleScope scope;
-		v8::Local<v8::Function> constructor = GetConstructor();
-		v8::Local<v8::Object> instance = constructor->NewInstance();
-		WrapRot* wrap = Unwrap(instance);
-		wrap->SetRot(rot);
-		return scope.Escape(instance);
+		if (!ParseValue(value)) { return false; }
+		SkipSpace();
+		return m_next == m_end;
 	}
 private:
-	static v8::Local<v8::Function> GetConstructor()
+	void SkipSpace()
 	{
-		Nan::EscapableHandleScope scope;
-		v8::Local<v8::FunctionTemplate> function_template = GetFunctionTemplate();
-		v8::Local<v8::Function> constructor = function_template->GetFunction();
-		return scope.Escape(constructor);
+		while ((m_next < m_end) && ((*m_next == ' ') || (*m_next == '\t') || (*m_next == '\n') || (*m_next == '\r'))) { ++m_next; }
 	}
-	static v8::Local<v8::FunctionTemplate> GetFunctionTemplate()
+	bool Match(const char* word)
 	{
-		Nan::EscapableHandleScope scope;
-		static Nan::Persistent<v8::FunctionTemplate> g_function_template;
-		if (g_function_template.IsEmpty())
+		size_t size = strlen(word);
+		if ((static_cast<size_t>(m_end - m_next) < size) || (memcmp(m_next, word, size) != 0)) { return false; }
+		m_next += size;
+		return true;
+	}
+	bool ParseValue(JsonValue& value)
+	{
+		SkipSpace();
+		if (m_next == m_end) { return false; }
+		switch (*m_next)
 		{
-			v8::Local<v8::FunctionTemplate> function_template = Nan::New<v8::FunctionTemplate>(New);
-			function_template->SetClassName(NANX_SYMBOL("b2Rot"));
-			function_template->InstanceTemplate()->SetInternalFieldCount(1);
-			v8::Local<v8::ObjectTemplate> prototype_template = function_template->PrototypeTemplate();
-			NANX_MEMBER_APPLY(prototype_template, s)
-			NANX_MEMBER_APPLY(prototype_template, c)
-			NANX_METHOD_APPLY(prototype_template, Set)
-			//void SetIdentity()
-			NANX_METHOD_APPLY(prototype_template, GetAngle)
-			//b2Vec2 GetXAxis() const
-			//b2Vec2 GetYAxis() const
-			g_function_template.Reset(function_template);
+		case '{': return ParseObject(value);
+		case '[': return ParseArray(value);
+		case '"': value.type = JsonValue::e_string; return ParseString(value.string);
+		case 't': value.type = JsonValue::e_bool; value.boolean = true; return Match("true");
+		case 'f': value.type = JsonValue::e_bool; value.boolean = false; return Match("false");
+		case 'n': value.type = JsonValue::e_null; return Match("null");
+		default: value.type = JsonValue::e_number; return ParseNumber(value.number);
 		}
-		v8::Local<v8::FunctionTemplate> function_template = Nan::New<v8::FunctionTemplate>(g_function_template);
-		return scope.Escape(function_template);
 	}
-private:
-	static NAN_METHOD(New)
+	static bool IsNumberChar(char c)
 	{
-		if (info.IsConstructCall())
+		return ((c >= '0') && (c <= '9')) || (c == '-') || (c == '+') || (c == '.') || (c == 'e') || (c == 'E');
+	}
+	bool ParseNumber(double& number)
+	{
+		// strtod wants a terminated string; json numbers are short
+		char text[64];
+		size_t size = 0;
+		while ((m_next + size < m_end) && (size < sizeof(text) - 1) && IsNumberChar(m_next[size])) { ++size; }
+		if (size == 0) { return false; }
+		memcpy(text, m_next, size);
+		text[size] = '\0';
+		char* end = NULL;
+		number = strtod(text, &end);
+		if (end != text + size) { return false; }
+		m_next += size;
+		return true;
+	}
+	bool ParseHex4(uint32& code)
+	{
+		if (m_end - m_next < 4) { return false; }
+		code = 0;
+		for (int32 i = 0; i < 4; ++i)
 		{
-			float32 angle = (info.Length() > 0) ? NANX_float32(info[0]) : 0.0f;
-			WrapRot* wrap = new WrapRot(angle);
-			wrap->Wrap(info.This());
-			info.GetReturnValue().Set(info.This());
+			char c = *m_next++;
+			code <<= 4;
+			if ((c >= '0') && (c <= '9')) { code |= c - '0'; }
+			else if ((c >= 'a') && (c <= 'f')) { code |= c - 'a' + 10; }
+			else if ((c >= 'A') && (c <= 'F')) { code |= c - 'A' + 10; }
+			else { return false; }
 		}
+		return true;
+	}
+	static void AppendUtf8(std::string& out, uint32 code)
+	{
+		if (code < 0x80) { out.push_back(static_cast<char>(code)); return; }
+		if (code < 0x800) { out.push_back(static_cast<char>(0xc0 | (code >> 6))); }
 		else
 		{
-			v8::Local<v8::Function> constructor = GetConstructor();
-			info.GetReturnValue().Set(constructor->NewInstance());
+			if (code < 0x10000) { out.push_back(static_cast<char>(0xe0 | (code >> 12))); }
+			else
+			{
+				out.push_back(static_cast<char>(0xf0 | (code >> 18)));
+				out.push_back(static_cast<char>(0x80 | ((code >> 12) & 0x3f)));
+			}
+			out.push_back(static_cast<char>(0x80 | ((code >> 6) & 0x3f)));
 		}
+		out.push_back(static_cast<char>(0x80 | (code & 0x3f)));
 	}
-	NANX_MEMBER_NUMBER(float32, s)
-	NANX_MEMBER_NUMBER(float32, c)
-	NANX_METHOD(Set)
-	{
-		b2Rot* that = Peek(info.This());
-		that->Set(NANX_float32(info[0]));
-		info.GetReturnValue().Set(info.This());
-	}
-	NANX_METHOD(GetAngle)
+	bool ParseString(std::string& out)
 	{
-		b2Rot* that = Peek(info.This());
-		info.GetReturnValue().Set(Nan::New(that->GetAngle()));
+		++m_next; // opening quote
+		while (m_next < m_end)
+		{
+			char c = *m_next++;
+			if (c == '"') { return true; }
+			if (c != '\\') { out.push_back(c); continue; }
+			if (m_next == m_end) { return false; }
+			c = *m_next++;
+			switch (c)
+			{
+			case '"': case '\\': case '/': out.push_back(c); break;
+			case 'b': out.push_back('\b'); break;
+			case 'f': out.push_back('\f'); break;
+			case 'n': out.push_back('\n'); break;
+			case 'r': out.push_back('\r'); break;
+			case 't': out.push_back('\t'); break;
+			case 'u':
+			{
+				uint32 code = 0;
+				if (!ParseHex4(code)) { return false; }
+				if ((code >= 0xd800) && (code < 0xdc00) && Match("\\u"))
+				{
+					uint32 low = 0;
+					if (!ParseHex4(low) || (low < 0xdc00) || (low >= 0xe000)) { return false; }
+					code = 0x10000 + ((code - 0xd800) << 10) + (low - 0xdc00);
+				}
+				AppendUtf8(out, code);
+				break;
+			}
+			default:
+				return false;
+			}
+		}
+		return false;
+	}
+	bool ParseArray(JsonValue& value)
+	{
+		if (++m_depth > g_json_max_depth) { return false; }
+		++m_next; // [
+		value.type = JsonValue::e_array;
+		SkipSpace();
+		if ((m_next < m_end) && (*m_next == ']')) { ++m_next; --m_depth; return true; }
+		while (true)
+		{
+			value.items.push_back(JsonValue());
+			if (!ParseValue(value.items.back())) { return false; }
+			SkipSpace();
+			if (m_next == m_end) { return false; }
+			char c = *m_next++;
+			if (c == ']') { --m_depth; return true; }
+			if (c != ',') { return false; }
+		}
+	}
+	bool ParseObject(JsonValue& value)
+	{
+		if (++m_depth > g_json_max_depth) { return false; }
+		++m_next; // {
+		value.type = JsonValue::e_object;
+		SkipSpace();
+		if ((m_next < m_end) && (*m_next == '}')) { ++m_next; --m_depth; return true; }
+		while (true)
+		{
+			SkipSpace();
+			if ((m_next == m_end) || (*m_next != '"')) { return false; }
+			value.keys.push_back(std::string());
+			if (!ParseString(value.keys.back())) { return false; }
+			SkipSpace();
+			if ((m_next == m_end) || (*m_next++ != ':')) { return false; }
+			value.items.push_back(JsonValue());
+			if (!ParseValue(value.items.back())) { return false; }
+			SkipSpace();
+			if (m_next == m_end) { return false; }
+			char c = *m_next++;
+			if (c == '}') { --m_depth; return true; }
+			if (c != ',') { return false; }
+		}
 	}
 };
 
-//// b2Transform
+struct SceneProperty
+{
+	enum Type { e_int, e_float, e_string, e_bool, e_vec2, e_color };
+	std::string name;
+	Type type;
+	double number; // int, float and bool values
+	std::string string;
+	b2Vec2 vec2;
+	int32 color[4];
+};
 
-class WrapTransform : public Nan::ObjectWrap
+typedef std::vector<SceneProperty> SceneProperties;
+
+struct SceneFixture
 {
-private:
-	b2Transform m_xf;
-	Nan::Persistent<v8::Object> m_wrap_p; // m_xf.p
-	Nan::Persistent<v8::Object> m_wrap_q; // m_xf.q
-private:
-	WrapTransform()
-	{
-		m_wrap_p.Reset(WrapVec2::NewInstance(m_xf.p));
-		m_wrap_q.Reset(WrapRot::NewInstance(m_xf.q));
-	}
-	//WrapTransform(const b2Transform& xf) { m_xf = xf; } // struct copy
-	//WrapTransform(float32 angle) : m_xf(angle) {}
-	~WrapTransform()
-	{
-		m_wrap_p.Reset();
-		m_wrap_q.Reset();
-	}
-public:
-	b2Transform* Peek() { return &m_xf; }
-	//b2Transform& GetTransform() { return m_xf; }
-	//const b2Transform& GetTransform() const { return m_xf; }
-	//void SetTransform(const b2Transform& xf) { m_xf = xf; } // struct copy
-	const b2Transform& GetTransform()
+	std::string name;
+	SceneProperties properties;
+	b2FixtureDef fd; // shape is set when the fixture is created
+	b2Shape::Type shape_type;
+	b2CircleShape circle;
+	b2EdgeShape edge;
+	b2PolygonShape polygon;
+	std::vector<b2Vec2> chain; // b2ChainShape allocates, so it is built on the main thread
+	b2Vec2 chain_prev;
+	b2Vec2 chain_next;
+	bool chain_has_prev;
+	bool chain_has_next;
+};
+
+struct SceneBody
+{
+	std::string name;
+	SceneProperties properties;
+	b2BodyDef bd;
+	bool has_mass_data;
+	b2MassData mass_data;
+	std::vector<SceneFixture> fixtures;
+};
+
+struct SceneJoint
+{
+	std::string name;
+	SceneProperties properties;
+	b2JointType type;
+	int32 bodyA; // scene body indices
+	int32 bodyB;
+	int32 joint1; // scene joint indices, gear joints only
+	int32 joint2;
+	RecordJointDefs defs; // defs.Get(type) is filled in; bodies and joints are set on creation
+};
+
+struct Scene
+{
+	bool has_gravity;
+	b2Vec2 gravity;
+	int32 world_flags[5]; // RecordWorldFlag order; -1 when the scene leaves it alone
+	int32 velocity_iterations;
+	int32 position_iterations;
+	float32 steps_per_second;
+	std::vector<SceneBody> bodies;
+	std::vector<SceneJoint> joints;
+	std::string error;
+};
+
+static float32 SceneFloat(const JsonValue* value, float32 fallback)
+{
+	// b2dJson writes exact floats as 8 hex digits of their bits
+	if (!value) { return fallback; }
+	if (value->type == JsonValue::e_number) { return static_cast<float32>(value->number); }
+	if ((value->type == JsonValue::e_string) && (value->string.size() == 8))
+	{
+		char* end = NULL;
+		uint32 bits = static_cast<uint32>(strtoul(value->string.c_str(), &end, 16));
+		if (end != value->string.c_str() + 8) { return fallback; }
+		float32 f;
+		memcpy(&f, &bits, sizeof(f));
+		return f;
+	}
+	return fallback;
+}
+
+static float32 SceneFloat(const JsonValue& object, const char* key, float32 fallback = 0.0f)
+{
+	return SceneFloat(object.Find(key), fallback);
+}
+
+static int32 SceneInt(const JsonValue& object, const char* key, int32 fallback)
+{
+	const JsonValue* value = object.Find(key);
+	return (value && (value->type == JsonValue::e_number))?(static_cast<int32>(value->number)):(fallback);
+}
+
+static bool SceneBool(const JsonValue& object, const char* key, bool fallback)
+{
+	const JsonValue* value = object.Find(key);
+	return (value && (value->type == JsonValue::e_bool))?(value->boolean):(fallback);
+}
+
+static b2Vec2 SceneVec2(const JsonValue& object, const char* key, const b2Vec2& fallback = b2Vec2_zero)
+{
+	// a zero vector may be written as a plain 0
+	const JsonValue* value = object.Find(key);
+	if (!value) { return fallback; }
+	if (value->type == JsonValue::e_number) { return b2Vec2_zero; }
+	return b2Vec2(SceneFloat(*value, "x"), SceneFloat(*value, "y"));
+}
+
+static std::string SceneString(const JsonValue& object, const char* key)
+{
+	const JsonValue* value = object.Find(key);
+	return (value && (value->type == JsonValue::e_string))?(value->string):(std::string());
+}
+
+static bool SceneVertices(const JsonValue& shape, std::vector<b2Vec2>& out)
+{
+	// { "vertices": { "x": [ ... ], "y": [ ... ] } }
+	const JsonValue* vertices = shape.Find("vertices");
+	const JsonValue* x = (vertices)?(vertices->Find("x")):(NULL);
+	const JsonValue* y = (vertices)?(vertices->Find("y")):(NULL);
+	if (!x || !y || (x->GetCount() != y->GetCount())) { return false; }
+	out.resize(x->GetCount());
+	for (size_t i = 0; i < out.size(); ++i)
 	{
-		SyncPull();
-		return m_xf;
+		out[i].Set(SceneFloat(&x->items[i], 0.0f), SceneFloat(&y->items[i], 0.0f));
 	}
-	void SetTransform(const b2Transform& xf)
-	{
-		m_xf = xf; // struct copy
-		SyncPush();
+	return true;
+}
+
+static void SceneReadProperties(const JsonValue& object, SceneProperties& out)
+{
+	const JsonValue* properties = object.Find("customProperties");
+	for (size_t i = 0; properties && (i < properties->GetCount()); ++i)
+	{
+		const JsonValue& item = properties->items[i];
+		SceneProperty property;
+		property.name = SceneString(item, "name");
+		property.number = 0.0;
+		property.vec2.SetZero();
+		property.color[0] = property.color[1] = property.color[2] = property.color[3] = 0;
+		const JsonValue* value = NULL;
+		if ((value = item.Find("int")) != NULL) { property.type = SceneProperty::e_int; property.number = SceneInt(item, "int", 0); }
+		else if ((value = item.Find("float")) != NULL) { property.type = SceneProperty::e_float; property.number = SceneFloat(value, 0.0f); }
+		else if ((value = item.Find("string")) != NULL) { property.type = SceneProperty::e_string; property.string = SceneString(item, "string"); }
+		else if ((value = item.Find("bool")) != NULL) { property.type = SceneProperty::e_bool; property.number = SceneBool(item, "bool", false)?(1.0):(0.0); }
+		else if ((value = item.Find("vec2")) != NULL) { property.type = SceneProperty::e_vec2; property.vec2 = SceneVec2(item, "vec2"); }
+		else if ((value = item.Find("color")) != NULL)
+		{
+			property.type = SceneProperty::e_color;
+			for (size_t c = 0; (c < 4) && (c < value->GetCount()); ++c)
+			{
+				property.color[c] = static_cast<int32>(value->items[c].number);
+			}
+		}
+		else { continue; }
+		out.push_back(property);
 	}
-	void SetTransform(const b2Vec2& position, float32 angle)
+}
+
+static bool ScenePolygonIsSolid(const std::vector<b2Vec2>& vertices)
+{
+	// b2PolygonShape::Set falls back to a 1x1 box when the hull collapses; refuse those instead
+	const float32 weld_sq = 0.25f * b2_linearSlop * b2_linearSlop;
+	int32 unique_count = 0;
+	float32 area = 0.0f;
+	for (size_t i = 0; i < vertices.size(); ++i)
 	{
-		m_xf.Set(position, angle);
-		SyncPush();
+		bool unique = true;
+		for (size_t j = 0; (j < i) && unique; ++j)
+		{
+			unique = b2DistanceSquared(vertices[i], vertices[j]) > weld_sq;
+		}
+		if (unique) { ++unique_count; }
+		area += b2Cross(vertices[i], vertices[(i + 1) % vertices.size()]);
 	}
-	void SyncPull()
-	{
-		// sync: pull data from javascript objects
-		m_xf.p = WrapVec2::Unwrap(Nan::New<v8::Object>(m_wrap_p))->GetVec2(); // struct copy
-		m_xf.q = WrapRot::Unwrap(Nan::New<v8::Object>(m_wrap_q))->GetRot(); // struct copy
+	return (unique_count >= 3) && (b2Abs(0.5f * area) > b2_epsilon);
+}
+
+static bool SceneReadFixture(const JsonValue& object, SceneFixture& fixture, std::string& error)
+{
+	fixture.name = SceneString(object, "name");
+	SceneReadProperties(object, fixture.properties);
+	fixture.fd.friction = SceneFloat(object, "friction", 0.2f);
+	fixture.fd.restitution = SceneFloat(object, "restitution");
+	fixture.fd.density = SceneFloat(object, "density");
+	fixture.fd.isSensor = SceneBool(object, "sensor", false);
+	fixture.fd.filter.categoryBits = static_cast<uint16>(SceneInt(object, "filter-categoryBits", 0x0001));
+	fixture.fd.filter.maskBits = static_cast<uint16>(SceneInt(object, "filter-maskBits", 0xffff));
+	fixture.fd.filter.groupIndex = static_cast<int16>(SceneInt(object, "filter-groupIndex", 0));
+	const JsonValue* shape = NULL;
+	std::vector<b2Vec2> vertices;
+	if ((shape = object.Find("circle")) != NULL)
+	{
+		fixture.shape_type = b2Shape::e_circle;
+		fixture.circle.m_p = SceneVec2(*shape, "center");
+		fixture.circle.m_radius = SceneFloat(*shape, "radius");
+	}
+	else if ((shape = object.Find("edge")) != NULL)
+	{
+		fixture.shape_type = b2Shape::e_edge;
+		fixture.edge.Set(SceneVec2(*shape, "vertex1"), SceneVec2(*shape, "vertex2"));
+		fixture.edge.m_hasVertex0 = SceneBool(*shape, "hasVertex0", false);
+		fixture.edge.m_hasVertex3 = SceneBool(*shape, "hasVertex3", false);
+		fixture.edge.m_vertex0 = SceneVec2(*shape, "vertex0");
+		fixture.edge.m_vertex3 = SceneVec2(*shape, "vertex3");
+	}
+	else if ((shape = object.Find("polygon")) != NULL)
+	{
+		if (!SceneVertices(*shape, vertices)) { error = "scene polygon has no vertices"; return false; }
+		if (vertices.size() == 2)
+		{
+			// two vertex polygons are edges
+			fixture.shape_type = b2Shape::e_edge;
+			fixture.edge.Set(vertices[0], vertices[1]);
+		}
+		else
+		{
+			if (vertices.size() < 3) { error = "scene polygon has too few vertices"; return false; }
+			if (vertices.size() > static_cast<size_t>(b2_maxPolygonVertices)) { error = "scene polygon has too many vertices"; return false; }
+			if (!ScenePolygonIsSolid(vertices)) { error = "scene polygon is degenerate"; return false; }
+			fixture.shape_type = b2Shape::e_polygon;
+			fixture.polygon.Set(&vertices[0], static_cast<int32>(vertices.size()));
+		}
 	}
-	void SyncPush()
+	else if ((shape = object.Find("chain")) != NULL)
 	{
-		// sync: push data into javascript objects
-		WrapVec2::Unwrap(Nan::New<v8::Object>(m_wrap_p))->SetVec2(m_xf.p);
-		WrapRot::Unwrap(Nan::New<v8::Object>(m_wrap_q))->SetRot(m_xf.q);
+		if (!SceneVertices(*shape, fixture.chain) || (fixture.chain.size() < 2)) { error = "scene chain needs at least 2 vertices"; return false; }
+		fixture.shape_type = b2Shape::e_chain;
+		fixture.chain_has_prev = SceneBool(*shape, "hasPrevVertex", false);
+		fixture.chain_has_next = SceneBool(*shape, "hasNextVertex", false);
+		fixture.chain_prev = SceneVec2(*shape, "prevVertex");
+		fixture.chain_next = SceneVec2(*shape, "nextVertex");
 	}
-public:
-	static WrapTransform* Unwrap(v8::Local<v8::Value> value) { return (value->IsObject())?(Unwrap(v8::Local<v8::Object>::Cast(value))):(NULL); }
-	static WrapTransform* Unwrap(v8::Local<v8::Object> object) { return Nan::ObjectWrap::Unwrap<WrapTransform>(object); }
-	static b2Transform* Peek(v8::Local<v8::Value> value) { WrapTransform* wrap = Unwrap(value); return (wrap)?(wrap->Peek()):(NULL); }
-public:
-	static NAN_MODULE_INIT(Init)
+	else
 	{
-		v8::Local<v8::Function> constructor = GetConstructor();
-		target->Set(constructor->GetName(), constructor);
+		error = "scene fixture has no shape";
+		return false;
 	}
-	static v8::Local<v8::Object> NewInstance()
+	return true;
+}
+
+static bool SceneReadBody(const JsonValue& object, SceneBody& body, std::string& error)
+{
+	body.name = SceneString(object, "name");
+	SceneReadProperties(object, body.properties);
+	int32 type = SceneInt(object, "type", b2_staticBody);
+	if ((type != b2_staticBody) && (type != b2_kinematicBody) && (type != b2_dynamicBody)) { error = "scene body type is invalid"; return false; }
+	body.bd.type = static_cast<b2BodyType>(type);
+	body.bd.position = SceneVec2(object, "position");
+	body.bd.angle = SceneFloat(object, "angle");
+	body.bd.linearVelocity = SceneVec2(object, "linearVelocity");
+	body.bd.angularVelocity = SceneFloat(object, "angularVelocity");
+	body.bd.linearDamping = SceneFloat(object, "linearDamping");
+	body.bd.angularDamping = SceneFloat(object, "angularDamping");
+	body.bd.gravityScale = SceneFloat(object, "gravityScale", 1.0f);
+	body.bd.allowSleep = SceneBool(object, "allowSleep", true);
+	body.bd.awake = SceneBool(object, "awake", false);
+	body.bd.fixedRotation = SceneBool(object, "fixedRotation", false);
+	body.bd.bullet = SceneBool(object, "bullet", false);
+	body.bd.active = SceneBool(object, "active", true);
+	body.has_mass_data = (object.Find("massData-mass") != NULL);
+	body.mass_data.mass = SceneFloat(object, "massData-mass");
+	body.mass_data.center = SceneVec2(object, "massData-center");
+	body.mass_data.I = SceneFloat(object, "massData-I");
+	const JsonValue* fixtures = object.Find("fixture");
+	body.fixtures.resize((fixtures)?(fixtures->GetCount()):(0));
+	for (size_t i = 0; i < body.fixtures.size(); ++i)
+	{
+		if (!SceneReadFixture(fixtures->items[i], body.fixtures[i], error)) { return false; }
+	}
+	return true;
+}
+
+static bool SceneReadJoint(const JsonValue& object, int32 body_count, SceneJoint& joint, std::string& error)
+{
+	static const char* names[] = { "revolute", "prismatic", "distance", "pulley", "mouse", "gear", "wheel", "weld", "friction", "rope", "motor" };
+	static const b2JointType types[] = { e_revoluteJoint, e_prismaticJoint, e_distanceJoint, e_pulleyJoint, e_mouseJoint, e_gearJoint, e_wheelJoint, e_weldJoint, e_frictionJoint, e_ropeJoint, e_motorJoint };
+	std::string type = SceneString(object, "type");
+	joint.type = e_unknownJoint;
+	for (size_t i = 0; i < countof(names); ++i)
+	{
+		if (type == names[i]) { joint.type = types[i]; }
+	}
+	if (joint.type == e_unknownJoint) { error = "scene joint type is unknown"; return false; }
+	joint.name = SceneString(object, "name");
+	SceneReadProperties(object, joint.properties);
+	joint.bodyA = SceneInt(object, "bodyA", -1);
+	joint.bodyB = SceneInt(object, "bodyB", -1);
+	joint.joint1 = SceneInt(object, "joint1", -1);
+	joint.joint2 = SceneInt(object, "joint2", -1);
+	if ((joint.bodyA < 0) || (joint.bodyA >= body_count) || (joint.bodyB < 0) || (joint.bodyB >= body_count) || (joint.bodyA == joint.bodyB))
+	{
+		error = "scene joint bodies are invalid";
+		return false;
+	}
+	b2JointDef* jd = joint.defs.Get(joint.type);
+	jd->collideConnected = SceneBool(object, "collideConnected", false);
+	b2Vec2 anchorA = SceneVec2(object, "anchorA");
+	b2Vec2 anchorB = SceneVec2(object, "anchorB");
+	switch (joint.type)
+	{
+	case e_revoluteJoint:
+	{
+		b2RevoluteJointDef& def = joint.defs.revolute;
+		def.localAnchorA = anchorA;
+		def.localAnchorB = anchorB;
+		def.referenceAngle = SceneFloat(object, "refAngle");
+		def.enableLimit = SceneBool(object, "enableLimit", false);
+		def.lowerAngle = SceneFloat(object, "lowerLimit");
+		def.upperAngle = SceneFloat(object, "upperLimit");
+		def.enableMotor = SceneBool(object, "enableMotor", false);
+		def.motorSpeed = SceneFloat(object, "motorSpeed");
+		def.maxMotorTorque = SceneFloat(object, "maxMotorTorque");
+		break;
+	}
+	case e_prismaticJoint:
+	{
+		b2PrismaticJointDef& def = joint.defs.prismatic;
+		def.localAnchorA = anchorA;
+		def.localAnchorB = anchorB;
+		def.localAxisA = SceneVec2(object, "localAxisA", b2Vec2(1.0f, 0.0f));
+		def.localAxisA.Normalize();
+		def.referenceAngle = SceneFloat(object, "refAngle");
+		def.enableLimit = SceneBool(object, "enableLimit", false);
+		def.lowerTranslation = SceneFloat(object, "lowerLimit");
+		def.upperTranslation = SceneFloat(object, "upperLimit");
+		def.enableMotor = SceneBool(object, "enableMotor", false);
+		def.motorSpeed = SceneFloat(object, "motorSpeed");
+		def.maxMotorForce = SceneFloat(object, "maxMotorForce");
+		break;
+	}
+	case e_distanceJoint:
+	{
+		b2DistanceJointDef& def = joint.defs.distance;
+		def.localAnchorA = anchorA;
+		def.localAnchorB = anchorB;
+		def.length = SceneFloat(object, "length", 1.0f);
+		def.frequencyHz = SceneFloat(object, "frequency");
+		def.dampingRatio = SceneFloat(object, "dampingRatio");
+		break;
+	}
+	case e_pulleyJoint:
+	{
+		b2PulleyJointDef& def = joint.defs.pulley;
+		def.groundAnchorA = SceneVec2(object, "groundAnchorA");
+		def.groundAnchorB = SceneVec2(object, "groundAnchorB");
+		def.localAnchorA = anchorA;
+		def.localAnchorB = anchorB;
+		def.lengthA = SceneFloat(object, "lengthA");
+		def.lengthB = SceneFloat(object, "lengthB");
+		def.ratio = SceneFloat(object, "ratio", 1.0f);
+		if (def.ratio <= b2_epsilon) { error = "scene pulley joint ratio must be positive"; return false; }
+		break;
+	}
+	case e_mouseJoint:
+	{
+		b2MouseJointDef& def = joint.defs.mouse;
+		def.target = SceneVec2(object, "target");
+		def.maxForce = SceneFloat(object, "maxForce");
+		def.frequencyHz = SceneFloat(object, "frequency", 5.0f);
+		def.dampingRatio = SceneFloat(object, "dampingRatio", 0.7f);
+		break;
+	}
+	case e_gearJoint:
+	{
+		b2GearJointDef& def = joint.defs.gear;
+		def.ratio = SceneFloat(object, "ratio", 1.0f);
+		break;
+	}
+	case e_wheelJoint:
+	{
+		b2WheelJointDef& def = joint.defs.wheel;
+		def.localAnchorA = anchorA;
+		def.localAnchorB = anchorB;
+		def.localAxisA = SceneVec2(object, "localAxisA", b2Vec2(1.0f, 0.0f));
+		def.localAxisA.Normalize();
+		def.enableMotor = SceneBool(object, "enableMotor", false);
+		def.motorSpeed = SceneFloat(object, "motorSpeed");
+		def.maxMotorTorque = SceneFloat(object, "maxMotorTorque");
+		def.frequencyHz = SceneFloat(object, "springFrequency", 2.0f);
+		def.dampingRatio = SceneFloat(object, "springDampingRatio", 0.7f);
+		break;
+	}
+	case e_weldJoint:
+	{
+		b2WeldJointDef& def = joint.defs.weld;
+		def.localAnchorA = anchorA;
+		def.localAnchorB = anchorB;
+		def.referenceAngle = SceneFloat(object, "refAngle");
+		def.frequencyHz = SceneFloat(object, "frequency");
+		def.dampingRatio = SceneFloat(object, "dampingRatio");
+		break;
+	}
+	case e_frictionJoint:
+	{
+		b2FrictionJointDef& def = joint.defs.friction;
+		def.localAnchorA = anchorA;
+		def.localAnchorB = anchorB;
+		def.maxForce = SceneFloat(object, "maxForce");
+		def.maxTorque = SceneFloat(object, "maxTorque");
+		break;
+	}
+	case e_ropeJoint:
+	{
+		b2RopeJointDef& def = joint.defs.rope;
+		def.localAnchorA = anchorA;
+		def.localAnchorB = anchorB;
+		def.maxLength = SceneFloat(object, "maxLength");
+		break;
+	}
+	case e_motorJoint:
+	{
+		// b2dJson writes the linear offset as anchorA and the angular offset as refAngle
+		b2MotorJointDef& def = joint.defs.motor;
+		def.linearOffset = SceneVec2(object, "linearOffset", anchorA);
+		def.angularOffset = SceneFloat(object, "refAngle");
+		def.maxForce = SceneFloat(object, "maxForce", 1.0f);
+		def.maxTorque = SceneFloat(object, "maxTorque", 1.0f);
+		def.correctionFactor = SceneFloat(object, "correctionFactor", 0.3f);
+		break;
+	}
+	default:
+		break;
+	}
+	return true;
+}
+
+static bool ParseScene(const char* data, size_t size, Scene& scene)
+{
+	JsonValue root;
+	JsonParser parser(data, size);
+	if (!parser.Parse(root) || (root.type != JsonValue::e_object))
 	{
-		Nan::EscapableHandleScope scope;
-		v8::Local<v8::Function> constructor = GetConstructor();
-		v8::Local<v8::Object> instance = constructor->NewInstance();
-		return scope.Escape(instance);
+		scene.error = "scene json is malformed";
+		return false;
 	}
-	static v8::Local<v8::Object> NewInstance(const b2Transform& xf)
+	scene.has_gravity = (root.Find("gravity") != NULL);
+	scene.gravity = SceneVec2(root, "gravity");
+	static const char* flags[] = { "allowSleep", "warmStarting", "continuousPhysics", "subStepping", "autoClearForces" };
+	for (int32 i = 0; i < 5; ++i)
 	{
-		Nan::EscapableHandleScope scope;
-		v8::Local<v8::Function> constructor = GetConstructor();
-		v8::Local<v8::Object> instance = constructor->NewInstance();
-		WrapTransform* wrap = Unwrap(instance);
-		wrap->SetTransform(xf);
-		return scope.Escape(instance);
+		const JsonValue* flag = root.Find(flags[i]);
+		scene.world_flags[i] = (flag && (flag->type == JsonValue::e_bool))?((flag->boolean)?(1):(0)):(-1);
 	}
-private:
-	static v8::Local<v8::Function> GetConstructor()
+	scene.velocity_iterations = SceneInt(root, "velocityIterations", 8);
+	scene.position_iterations = SceneInt(root, "positionIterations", 3);
+	scene.steps_per_second = SceneFloat(root, "stepsPerSecond", 60.0f);
+	const JsonValue* bodies = root.Find("body");
+	scene.bodies.resize((bodies)?(bodies->GetCount()):(0));
+	for (size_t i = 0; i < scene.bodies.size(); ++i)
 	{
-		Nan::EscapableHandleScope scope;
-		v8::Local<v8::FunctionTemplate> function_template = GetFunctionTemplate();
-		v8::Local<v8::Function> constructor = function_template->GetFunction();
-		return scope.Escape(constructor);
+		if (!SceneReadBody(bodies->items[i], scene.bodies[i], scene.error)) { return false; }
 	}
-	static v8::Local<v8::FunctionTemplate> GetFunctionTemplate()
+	const JsonValue* joints = root.Find("joint");
+	scene.joints.resize((joints)?(joints->GetCount()):(0));
+	for (size_t i = 0; i < scene.joints.size(); ++i)
 	{
-		Nan::EscapableHandleScope scope;
-		static Nan::Persistent<v8::FunctionTemplate> g_function_template;
-		if (g_function_template.IsEmpty())
-		{
-			v8::Local<v8::FunctionTemplate> function_template = Nan::New<v8::FunctionTemplate>(New);
-			function_template->SetClassName(NANX_SYMBOL("b2Transform"));
-			function_template->InstanceTemplate()->SetInternalFieldCount(1);
-			v8::Local<v8::ObjectTemplate> prototype_template = function_template->PrototypeTemplate();
-			NANX_MEMBER_APPLY(prototype_template, p)
-			NANX_MEMBER_APPLY(prototype_template, q)
-			NANX_METHOD_APPLY(prototype_template, SetIdentity)
-			NANX_METHOD_APPLY(prototype_template, Set)
-			g_function_template.Reset(function_template);
-		}
-		v8::Local<v8::FunctionTemplate> function_template = Nan::New<v8::FunctionTemplate>(g_function_template);
-		return scope.Escape(function_template);
+		if (!SceneReadJoint(joints->items[i], static_cast<int32>(scene.bodies.size()), scene.joints[i], scene.error)) { return false; }
 	}
-private:
-	static NAN_METHOD(New)
+	// gear joints are created after the others and must join two revolute or prismatic joints
+	for (size_t i = 0; i < scene.joints.size(); ++i)
 	{
-		if (info.IsConstructCall())
-		{
-			WrapTransform* wrap = new WrapTransform();
-			wrap->Wrap(info.This());
-			info.GetReturnValue().Set(info.This());
-		}
-		else
+		const SceneJoint& joint = scene.joints[i];
+		if (joint.type != e_gearJoint) { continue; }
+		int32 ends[2] = { joint.joint1, joint.joint2 };
+		for (int32 e = 0; e < 2; ++e)
 		{
-			v8::Local<v8::Function> constructor = GetConstructor();
-			info.GetReturnValue().Set(constructor->NewInstance());
+			b2JointType type = ((ends[e] >= 0) && (ends[e] < static_cast<int32>(scene.joints.size())))?(scene.joints[ends[e]].type):(e_unknownJoint);
+			if ((type != e_revoluteJoint) && (type != e_prismaticJoint))
+			{
+				scene.error = "scene gear joint must join revolute or prismatic joints";
+				return false;
+			}
 		}
 	}
-	NANX_MEMBER_OBJECT(p) // m_wrap_p
-	NANX_MEMBER_OBJECT(q) // m_wrap_q
-	NANX_METHOD(SetIdentity)
-	{
-		//b2Transform* that = Peek(info.This());
-		WrapTransform* wrap = Unwrap(info.This());
-		b2Transform* that = &wrap->m_xf;
-		that->SetIdentity();
-		wrap->SyncPush();
-		info.GetReturnValue().Set(info.This());
-	}
-	NANX_METHOD(Set)
-	{
-		//b2Transform* that = Peek(info.This());
-		WrapTransform* wrap = Unwrap(info.This());
-		b2Transform* that = &wrap->m_xf;
-		b2Vec2* position = WrapVec2::Peek(info[0]);
-		float32 angle = NANX_float32(info[1]);
-		that->Set(*position, angle);
-		wrap->SyncPush();
-		info.GetReturnValue().Set(info.This());
-	}
+	return true;
+}
+
+// binary scenes (box2d.CompileScene) are fixed-layout records in 8 byte aligned sections;
+// loading copies records into a Scene with no text parsing or hull building. joint defs are
+// stored as raw structs, so like replay logs a file loads on the build that wrote it
+
+static const uint32 g_scene_file_magic = 0x46533262; // "b2SF"
+static const uint32 g_scene_file_version = 1;
+
+enum SceneFileFlag
+{
+	e_sceneFileAllowSleep = 0x0001,
+	e_sceneFileAwake = 0x0002,
+	e_sceneFileFixedRotation = 0x0004,
+	e_sceneFileBullet = 0x0008,
+	e_sceneFileActive = 0x0010,
+	e_sceneFileMassData = 0x0020,
+	e_sceneFileSensor = 0x0100,
+	e_sceneFileHasPrev = 0x0200, // edge vertex0, chain prev vertex
+	e_sceneFileHasNext = 0x0400 // edge vertex3, chain next vertex
 };
 
-//// b2AABB
+struct SceneFileSection
+{
+	uint32 offset;
+	uint32 count;
+};
 
-class WrapAABB : public Nan::ObjectWrap
+struct SceneFileHeader
+{
+	uint32 magic;
+	uint32 version;
+	uint32 pointer_size;
+	int32 b2_major;
+	int32 b2_minor;
+	int32 b2_revision;
+	int32 has_gravity;
+	float32 gravity[2];
+	int32 world_flags[5];
+	int32 velocity_iterations;
+	int32 position_iterations;
+	float32 steps_per_second;
+	SceneFileSection bodies;
+	SceneFileSection fixtures;
+	SceneFileSection vertices; // b2Vec2 pool
+	SceneFileSection joints;
+	SceneFileSection joint_defs; // byte pool
+	SceneFileSection properties;
+	SceneFileSection strings; // byte pool of nul terminated utf-8
+};
+
+struct SceneFileBody
+{
+	int32 type;
+	float32 position[2];
+	float32 angle;
+	float32 linear_velocity[2];
+	float32 angular_velocity;
+	float32 linear_damping;
+	float32 angular_damping;
+	float32 gravity_scale;
+	uint32 flags;
+	float32 mass;
+	float32 mass_center[2];
+	float32 mass_I;
+	int32 first_fixture;
+	int32 fixture_count;
+	int32 name; // string offset, -1 for none
+	int32 first_property;
+	int32 property_count;
+};
+
+struct SceneFileFixture
+{
+	float32 friction;
+	float32 restitution;
+	float32 density;
+	uint32 category_bits;
+	uint32 mask_bits;
+	int32 group_index;
+	uint32 flags;
+	int32 shape_type;
+	float32 radius;
+	float32 point[2]; // circle center, polygon centroid
+	int32 first_vertex; // polygon: vertices then normals; edge: vertex0 to vertex3; chain: vertices then prev and next
+	int32 vertex_count;
+	int32 name;
+	int32 first_property;
+	int32 property_count;
+};
+
+struct SceneFileJoint
+{
+	int32 type;
+	int32 bodyA;
+	int32 bodyB;
+	int32 joint1;
+	int32 joint2;
+	int32 def_offset;
+	int32 def_size;
+	int32 name;
+	int32 first_property;
+	int32 property_count;
+};
+
+struct SceneFileProperty
+{
+	int32 name;
+	int32 type;
+	double number;
+	int32 string;
+	float32 vec2[2];
+	int32 color[4];
+};
+
+class SceneFileWriter
 {
 private:
-	b2AABB m_aabb;
-	Nan::Persistent<v8::Object> m_wrap_lowerBound; // m_aabb.lowerBound
-	Nan::Persistent<v8::Object> m_wrap_upperBound; // m_aabb.upperBound
+	std::vector<SceneFileBody> m_bodies;
+	std::vector<SceneFileFixture> m_fixtures;
+	std::vector<b2Vec2> m_vertices;
+	std::vector<SceneFileJoint> m_joints;
+	std::vector<uint8> m_joint_defs;
+	std::vector<SceneFileProperty> m_properties;
+	std::vector<char> m_strings;
+public:
+	void Write(const Scene& scene, std::vector<uint8>& out)
+	{
+		SceneFileHeader header;
+		memset(&header, 0, sizeof(header));
+		header.magic = g_scene_file_magic;
+		header.version = g_scene_file_version;
+		header.pointer_size = static_cast<uint32>(sizeof(void*));
+		header.b2_major = b2_version.major;
+		header.b2_minor = b2_version.minor;
+		header.b2_revision = b2_version.revision;
+		header.has_gravity = (scene.has_gravity)?(1):(0);
+		header.gravity[0] = scene.gravity.x;
+		header.gravity[1] = scene.gravity.y;
+		memcpy(header.world_flags, scene.world_flags, sizeof(header.world_flags));
+		header.velocity_iterations = scene.velocity_iterations;
+		header.position_iterations = scene.position_iterations;
+		header.steps_per_second = scene.steps_per_second;
+		for (size_t i = 0; i < scene.bodies.size(); ++i) { AddBody(scene.bodies[i]); }
+		for (size_t i = 0; i < scene.joints.size(); ++i) { AddJoint(scene.joints[i]); }
+		out.assign(sizeof(header), 0);
+		header.bodies = AddSection(out, m_bodies);
+		header.fixtures = AddSection(out, m_fixtures);
+		header.vertices = AddSection(out, m_vertices);
+		header.joints = AddSection(out, m_joints);
+		header.joint_defs = AddSection(out, m_joint_defs);
+		header.properties = AddSection(out, m_properties);
+		header.strings = AddSection(out, m_strings);
+		memcpy(&out[0], &header, sizeof(header));
+	}
+private:
+	template <typename T>
+	static SceneFileSection AddSection(std::vector<uint8>& out, const std::vector<T>& items)
+	{
+		out.resize((out.size() + 7) & ~static_cast<size_t>(7), 0);
+		SceneFileSection section;
+		section.offset = static_cast<uint32>(out.size());
+		section.count = static_cast<uint32>(items.size());
+		if (!items.empty())
+		{
+			const uint8* data = reinterpret_cast<const uint8*>(&items[0]);
+			out.insert(out.end(), data, data + items.size() * sizeof(T));
+		}
+		return section;
+	}
+	int32 AddString(const std::string& string)
+	{
+		if (string.empty()) { return -1; }
+		int32 offset = static_cast<int32>(m_strings.size());
+		m_strings.insert(m_strings.end(), string.begin(), string.end());
+		m_strings.push_back('\0');
+		return offset;
+	}
+	int32 AddVertices(const b2Vec2* vertices, int32 count)
+	{
+		int32 first = static_cast<int32>(m_vertices.size());
+		m_vertices.insert(m_vertices.end(), vertices, vertices + count);
+		return first;
+	}
+	void AddProperties(const SceneProperties& properties, int32& first, int32& count)
+	{
+		first = static_cast<int32>(m_properties.size());
+		count = static_cast<int32>(properties.size());
+		for (size_t i = 0; i < properties.size(); ++i)
+		{
+			const SceneProperty& property = properties[i];
+			SceneFileProperty record;
+			memset(&record, 0, sizeof(record));
+			record.name = AddString(property.name);
+			record.type = property.type;
+			record.number = property.number;
+			record.string = AddString(property.string);
+			record.vec2[0] = property.vec2.x;
+			record.vec2[1] = property.vec2.y;
+			memcpy(record.color, property.color, sizeof(record.color));
+			m_properties.push_back(record);
+		}
+	}
+	void AddBody(const SceneBody& body)
+	{
+		SceneFileBody record;
+		memset(&record, 0, sizeof(record));
+		const b2BodyDef& bd = body.bd;
+		record.type = bd.type;
+		record.position[0] = bd.position.x;
+		record.position[1] = bd.position.y;
+		record.angle = bd.angle;
+		record.linear_velocity[0] = bd.linearVelocity.x;
+		record.linear_velocity[1] = bd.linearVelocity.y;
+		record.angular_velocity = bd.angularVelocity;
+		record.linear_damping = bd.linearDamping;
+		record.angular_damping = bd.angularDamping;
+		record.gravity_scale = bd.gravityScale;
+		record.flags |= (bd.allowSleep)?(e_sceneFileAllowSleep):(0);
+		record.flags |= (bd.awake)?(e_sceneFileAwake):(0);
+		record.flags |= (bd.fixedRotation)?(e_sceneFileFixedRotation):(0);
+		record.flags |= (bd.bullet)?(e_sceneFileBullet):(0);
+		record.flags |= (bd.active)?(e_sceneFileActive):(0);
+		record.flags |= (body.has_mass_data)?(e_sceneFileMassData):(0);
+		record.mass = body.mass_data.mass;
+		record.mass_center[0] = body.mass_data.center.x;
+		record.mass_center[1] = body.mass_data.center.y;
+		record.mass_I = body.mass_data.I;
+		record.first_fixture = static_cast<int32>(m_fixtures.size());
+		record.fixture_count = static_cast<int32>(body.fixtures.size());
+		record.name = AddString(body.name);
+		AddProperties(body.properties, record.first_property, record.property_count);
+		m_bodies.push_back(record);
+		for (size_t i = 0; i < body.fixtures.size(); ++i) { AddFixture(body.fixtures[i]); }
+	}
+	void AddFixture(const SceneFixture& fixture)
+	{
+		SceneFileFixture record;
+		memset(&record, 0, sizeof(record));
+		const b2FixtureDef& fd = fixture.fd;
+		record.friction = fd.friction;
+		record.restitution = fd.restitution;
+		record.density = fd.density;
+		record.category_bits = fd.filter.categoryBits;
+		record.mask_bits = fd.filter.maskBits;
+		record.group_index = fd.filter.groupIndex;
+		record.flags |= (fd.isSensor)?(e_sceneFileSensor):(0);
+		record.shape_type = fixture.shape_type;
+		switch (fixture.shape_type)
+		{
+		case b2Shape::e_circle:
+			record.radius = fixture.circle.m_radius;
+			record.point[0] = fixture.circle.m_p.x;
+			record.point[1] = fixture.circle.m_p.y;
+			break;
+		case b2Shape::e_edge:
+		{
+			const b2EdgeShape& edge = fixture.edge;
+			const b2Vec2 vertices[4] = { edge.m_vertex0, edge.m_vertex1, edge.m_vertex2, edge.m_vertex3 };
+			record.radius = edge.m_radius;
+			record.flags |= (edge.m_hasVertex0)?(e_sceneFileHasPrev):(0);
+			record.flags |= (edge.m_hasVertex3)?(e_sceneFileHasNext):(0);
+			record.first_vertex = AddVertices(vertices, 4);
+			record.vertex_count = 4;
+			break;
+		}
+		case b2Shape::e_polygon:
+		{
+			const b2PolygonShape& polygon = fixture.polygon;
+			record.radius = polygon.m_radius;
+			record.point[0] = polygon.m_centroid.x;
+			record.point[1] = polygon.m_centroid.y;
+			record.first_vertex = AddVertices(polygon.m_vertices, polygon.m_count);
+			AddVertices(polygon.m_normals, polygon.m_count);
+			record.vertex_count = polygon.m_count;
+			break;
+		}
+		case b2Shape::e_chain:
+		{
+			const b2Vec2 ends[2] = { fixture.chain_prev, fixture.chain_next };
+			record.radius = b2_polygonRadius;
+			record.flags |= (fixture.chain_has_prev)?(e_sceneFileHasPrev):(0);
+			record.flags |= (fixture.chain_has_next)?(e_sceneFileHasNext):(0);
+			record.first_vertex = AddVertices(&fixture.chain[0], static_cast<int32>(fixture.chain.size()));
+			AddVertices(ends, 2);
+			record.vertex_count = static_cast<int32>(fixture.chain.size());
+			break;
+		}
+		default:
+			break;
+		}
+		record.name = AddString(fixture.name);
+		AddProperties(fixture.properties, record.first_property, record.property_count);
+		m_fixtures.push_back(record);
+	}
+	void AddJoint(const SceneJoint& joint)
+	{
+		SceneFileJoint record;
+		memset(&record, 0, sizeof(record));
+		record.type = joint.type;
+		record.bodyA = joint.bodyA;
+		record.bodyB = joint.bodyB;
+		record.joint1 = joint.joint1;
+		record.joint2 = joint.joint2;
+		// parsed defs hold no pointers yet; bodies and joints are set on creation
+		RecordJointDefs defs = joint.defs; // struct copy
+		const uint8* def = reinterpret_cast<const uint8*>(defs.Get(joint.type));
+		m_joint_defs.resize((m_joint_defs.size() + 7) & ~static_cast<size_t>(7), 0);
+		record.def_offset = static_cast<int32>(m_joint_defs.size());
+		record.def_size = GetJointDefSize(joint.type);
+		m_joint_defs.insert(m_joint_defs.end(), def, def + record.def_size);
+		record.name = AddString(joint.name);
+		AddProperties(joint.properties, record.first_property, record.property_count);
+		m_joints.push_back(record);
+	}
+};
+
+class SceneFileReader
+{
 private:
-	WrapAABB()
+	const uint8* m_data;
+	size_t m_size;
+	SceneFileHeader m_header;
+	const char* m_strings;
+public:
+	SceneFileReader(const uint8* data, size_t size) : m_data(data), m_size(size), m_strings(NULL) {}
+	bool Read(Scene& scene)
 	{
-		m_wrap_lowerBound.Reset(WrapVec2::NewInstance(m_aabb.lowerBound));
-		m_wrap_upperBound.Reset(WrapVec2::NewInstance(m_aabb.upperBound));
+		if (m_size < sizeof(m_header)) { return Fail(scene, "scene file is truncated"); }
+		memcpy(&m_header, m_data, sizeof(m_header));
+		if (m_header.magic != g_scene_file_magic) { return Fail(scene, "scene file is malformed"); }
+		if ((m_header.version != g_scene_file_version) || (m_header.pointer_size != sizeof(void*)) ||
+			(m_header.b2_major != b2_version.major) || (m_header.b2_minor != b2_version.minor) || (m_header.b2_revision != b2_version.revision))
+		{
+			return Fail(scene, "scene file was written by a different build");
+		}
+		if (!IsSection(m_header.bodies, sizeof(SceneFileBody)) || !IsSection(m_header.fixtures, sizeof(SceneFileFixture)) ||
+			!IsSection(m_header.vertices, sizeof(b2Vec2)) || !IsSection(m_header.joints, sizeof(SceneFileJoint)) ||
+			!IsSection(m_header.joint_defs, 1) || !IsSection(m_header.properties, sizeof(SceneFileProperty)) ||
+			!IsSection(m_header.strings, 1))
+		{
+			return Fail(scene, "scene file is truncated");
+		}
+		// the string pool must end in a terminator so any offset into it is a valid c string
+		m_strings = reinterpret_cast<const char*>(m_data + m_header.strings.offset);
+		if ((m_header.strings.count > 0) && (m_strings[m_header.strings.count - 1] != '\0')) { return Fail(scene, "scene file is malformed"); }
+		scene.has_gravity = (m_header.has_gravity != 0);
+		scene.gravity.Set(m_header.gravity[0], m_header.gravity[1]);
+		memcpy(scene.world_flags, m_header.world_flags, sizeof(scene.world_flags));
+		scene.velocity_iterations = m_header.velocity_iterations;
+		scene.position_iterations = m_header.position_iterations;
+		scene.steps_per_second = m_header.steps_per_second;
+		scene.bodies.resize(m_header.bodies.count);
+		for (uint32 i = 0; i < m_header.bodies.count; ++i)
+		{
+			if (!ReadBody(i, scene.bodies[i])) { return Fail(scene, "scene file is malformed"); }
+		}
+		scene.joints.resize(m_header.joints.count);
+		for (uint32 i = 0; i < m_header.joints.count; ++i)
+		{
+			if (!ReadJoint(i, scene.joints[i])) { return Fail(scene, "scene file is malformed"); }
+		}
+		for (size_t i = 0; i < scene.joints.size(); ++i)
+		{
+			const SceneJoint& joint = scene.joints[i];
+			if ((joint.bodyA < 0) || (joint.bodyA >= static_cast<int32>(scene.bodies.size())) ||
+				(joint.bodyB < 0) || (joint.bodyB >= static_cast<int32>(scene.bodies.size())) || (joint.bodyA == joint.bodyB))
+			{
+				return Fail(scene, "scene file is malformed");
+			}
+			if (joint.type != e_gearJoint) { continue; }
+			int32 ends[2] = { joint.joint1, joint.joint2 };
+			for (int32 e = 0; e < 2; ++e)
+			{
+				b2JointType type = ((ends[e] >= 0) && (ends[e] < static_cast<int32>(scene.joints.size())))?(scene.joints[ends[e]].type):(e_unknownJoint);
+				if ((type != e_revoluteJoint) && (type != e_prismaticJoint)) { return Fail(scene, "scene file is malformed"); }
+			}
+		}
+		return true;
 	}
-	~WrapAABB()
+private:
+	static bool Fail(Scene& scene, const char* error)
 	{
-		m_wrap_lowerBound.Reset();
-		m_wrap_upperBound.Reset();
+		scene.error = error;
+		return false;
 	}
-public:
-	b2AABB* Peek() { return &m_aabb; }
-	const b2AABB& GetAABB()
+	bool IsSection(const SceneFileSection& section, size_t item_size) const
 	{
-		SyncPull();
-		return m_aabb;
+		return (section.offset <= m_size) && (section.count <= (m_size - section.offset) / item_size);
 	}
-	void SetAABB(const b2AABB& mass_data)
+	template <typename T>
+	void Get(const SceneFileSection& section, uint32 index, T& out) const
 	{
-		m_aabb = mass_data; // struct copy
-		SyncPush();
+		memcpy(&out, m_data + section.offset + index * sizeof(T), sizeof(T));
 	}
-	void SyncPull()
+	static bool IsRange(int32 first, int32 count, uint32 size)
 	{
-		// sync: pull data from javascript objects
-		m_aabb.lowerBound = WrapVec2::Unwrap(Nan::New<v8::Object>(m_wrap_lowerBound))->GetVec2(); // struct copy
-		m_aabb.upperBound = WrapVec2::Unwrap(Nan::New<v8::Object>(m_wrap_upperBound))->GetVec2(); // struct copy
+		return (first >= 0) && (count >= 0) && (static_cast<uint32>(first) <= size) && (static_cast<uint32>(count) <= size - static_cast<uint32>(first));
 	}
-	void SyncPush()
+	std::string GetString(int32 offset) const
 	{
-		// sync: push data into javascript objects
-		WrapVec2::Unwrap(Nan::New<v8::Object>(m_wrap_lowerBound))->SetVec2(m_aabb.lowerBound);
-		WrapVec2::Unwrap(Nan::New<v8::Object>(m_wrap_upperBound))->SetVec2(m_aabb.upperBound);
+		return ((offset >= 0) && (static_cast<uint32>(offset) < m_header.strings.count))?(std::string(m_strings + offset)):(std::string());
+	}
+	b2Vec2 GetVertex(int32 index) const
+	{
+		b2Vec2 v;
+		Get(m_header.vertices, static_cast<uint32>(index), v);
+		return v;
+	}
+	bool ReadProperties(int32 first, int32 count, SceneProperties& out) const
+	{
+		if (!IsRange(first, count, m_header.properties.count)) { return false; }
+		out.resize(count);
+		for (int32 i = 0; i < count; ++i)
+		{
+			SceneFileProperty record;
+			Get(m_header.properties, static_cast<uint32>(first + i), record);
+			if ((record.type < SceneProperty::e_int) || (record.type > SceneProperty::e_color)) { return false; }
+			SceneProperty& property = out[i];
+			property.name = GetString(record.name);
+			property.type = static_cast<SceneProperty::Type>(record.type);
+			property.number = record.number;
+			property.string = GetString(record.string);
+			property.vec2.Set(record.vec2[0], record.vec2[1]);
+			memcpy(property.color, record.color, sizeof(property.color));
+		}
+		return true;
+	}
+	bool ReadBody(uint32 index, SceneBody& body) const
+	{
+		SceneFileBody record;
+		Get(m_header.bodies, index, record);
+		if ((record.type != b2_staticBody) && (record.type != b2_kinematicBody) && (record.type != b2_dynamicBody)) { return false; }
+		b2BodyDef& bd = body.bd;
+		bd.type = static_cast<b2BodyType>(record.type);
+		bd.position.Set(record.position[0], record.position[1]);
+		bd.angle = record.angle;
+		bd.linearVelocity.Set(record.linear_velocity[0], record.linear_velocity[1]);
+		bd.angularVelocity = record.angular_velocity;
+		bd.linearDamping = record.linear_damping;
+		bd.angularDamping = record.angular_damping;
+		bd.gravityScale = record.gravity_scale;
+		bd.allowSleep = (record.flags & e_sceneFileAllowSleep) != 0;
+		bd.awake = (record.flags & e_sceneFileAwake) != 0;
+		bd.fixedRotation = (record.flags & e_sceneFileFixedRotation) != 0;
+		bd.bullet = (record.flags & e_sceneFileBullet) != 0;
+		bd.active = (record.flags & e_sceneFileActive) != 0;
+		body.has_mass_data = (record.flags & e_sceneFileMassData) != 0;
+		body.mass_data.mass = record.mass;
+		body.mass_data.center.Set(record.mass_center[0], record.mass_center[1]);
+		body.mass_data.I = record.mass_I;
+		body.name = GetString(record.name);
+		if (!ReadProperties(record.first_property, record.property_count, body.properties)) { return false; }
+		if (!IsRange(record.first_fixture, record.fixture_count, m_header.fixtures.count)) { return false; }
+		body.fixtures.resize(record.fixture_count);
+		for (int32 i = 0; i < record.fixture_count; ++i)
+		{
+			if (!ReadFixture(static_cast<uint32>(record.first_fixture + i), body.fixtures[i])) { return false; }
+		}
+		return true;
+	}
+	bool ReadFixture(uint32 index, SceneFixture& fixture) const
+	{
+		SceneFileFixture record;
+		Get(m_header.fixtures, index, record);
+		b2FixtureDef& fd = fixture.fd;
+		fd.friction = record.friction;
+		fd.restitution = record.restitution;
+		fd.density = record.density;
+		fd.filter.categoryBits = static_cast<uint16>(record.category_bits);
+		fd.filter.maskBits = static_cast<uint16>(record.mask_bits);
+		fd.filter.groupIndex = static_cast<int16>(record.group_index);
+		fd.isSensor = (record.flags & e_sceneFileSensor) != 0;
+		fixture.shape_type = static_cast<b2Shape::Type>(record.shape_type);
+		const int32 count = record.vertex_count;
+		switch (record.shape_type)
+		{
+		case b2Shape::e_circle:
+			fixture.circle.m_radius = record.radius;
+			fixture.circle.m_p.Set(record.point[0], record.point[1]);
+			break;
+		case b2Shape::e_edge:
+			if ((count != 4) || !IsRange(record.first_vertex, 4, m_header.vertices.count)) { return false; }
+			fixture.edge.m_radius = record.radius;
+			fixture.edge.m_vertex0 = GetVertex(record.first_vertex + 0);
+			fixture.edge.m_vertex1 = GetVertex(record.first_vertex + 1);
+			fixture.edge.m_vertex2 = GetVertex(record.first_vertex + 2);
+			fixture.edge.m_vertex3 = GetVertex(record.first_vertex + 3);
+			fixture.edge.m_hasVertex0 = (record.flags & e_sceneFileHasPrev) != 0;
+			fixture.edge.m_hasVertex3 = (record.flags & e_sceneFileHasNext) != 0;
+			break;
+		case b2Shape::e_polygon:
+			// hull and normals were built by the converter
+			if ((count < 3) || (count > b2_maxPolygonVertices) || !IsRange(record.first_vertex, 2 * count, m_header.vertices.count)) { return false; }
+			fixture.polygon.m_radius = record.radius;
+			fixture.polygon.m_centroid.Set(record.point[0], record.point[1]);
+			fixture.polygon.m_count = count;
+			for (int32 i = 0; i < count; ++i)
+			{
+				fixture.polygon.m_vertices[i] = GetVertex(record.first_vertex + i);
+				fixture.polygon.m_normals[i] = GetVertex(record.first_vertex + count + i);
+			}
+			break;
+		case b2Shape::e_chain:
+			if ((count < 2) || (static_cast<uint32>(count) > m_header.vertices.count) || !IsRange(record.first_vertex, count + 2, m_header.vertices.count)) { return false; }
+			fixture.chain.resize(count);
+			memcpy(&fixture.chain[0], m_data + m_header.vertices.offset + record.first_vertex * sizeof(b2Vec2), count * sizeof(b2Vec2));
+			fixture.chain_prev = GetVertex(record.first_vertex + count);
+			fixture.chain_next = GetVertex(record.first_vertex + count + 1);
+			fixture.chain_has_prev = (record.flags & e_sceneFileHasPrev) != 0;
+			fixture.chain_has_next = (record.flags & e_sceneFileHasNext) != 0;
+			break;
+		default:
+			return false;
+		}
+		fixture.name = GetString(record.name);
+		return ReadProperties(record.first_property, record.property_count, fixture.properties);
+	}
+	bool ReadJoint(uint32 index, SceneJoint& joint) const
+	{
+		SceneFileJoint record;
+		Get(m_header.joints, index, record);
+		joint.type = static_cast<b2JointType>(record.type);
+		b2JointDef* jd = joint.defs.Get(joint.type);
+		if (!jd || (record.def_size != GetJointDefSize(joint.type)) || !IsRange(record.def_offset, record.def_size, m_header.joint_defs.count)) { return false; }
+		memcpy(static_cast<void*>(jd), m_data + m_header.joint_defs.offset + record.def_offset, record.def_size);
+		jd->type = joint.type;
+		jd->userData = NULL;
+		jd->bodyA = NULL;
+		jd->bodyB = NULL;
+		if (joint.type == e_gearJoint)
+		{
+			joint.defs.gear.joint1 = NULL;
+			joint.defs.gear.joint2 = NULL;
+		}
+		joint.bodyA = record.bodyA;
+		joint.bodyB = record.bodyB;
+		joint.joint1 = record.joint1;
+		joint.joint2 = record.joint2;
+		joint.name = GetString(record.name);
+		return ReadProperties(record.first_property, record.property_count, joint.properties);
+	}
+};
+
+static bool IsSceneFile(const char* data, size_t size)
+{
+	uint32 magic = 0;
+	if (size >= sizeof(magic)) { memcpy(&magic, data, sizeof(magic)); }
+	return magic == g_scene_file_magic;
+}
+
+static bool ReadScene(const char* data, size_t size, Scene& scene)
+{
+	// binary scene files and RUBE json are told apart by the file magic
+	if (IsSceneFile(data, size))
+	{
+		SceneFileReader reader(reinterpret_cast<const uint8*>(data), size);
+		return reader.Read(scene);
 	}
+	return ParseScene(data, size, scene);
+}
+
+class MappedFile
+{
+private:
+	const char* m_data;
+	size_t m_size;
+	#if defined(_WIN32)
+	HANDLE m_file;
+	HANDLE m_mapping;
+	#endif
 public:
-	static WrapAABB* Unwrap(v8::Local<v8::Value> value) { return (value->IsObject())?(Unwrap(v8::Local<v8::Object>::Cast(value))):(NULL); }
-	static WrapAABB* Unwrap(v8::Local<v8::Object> object) { return Nan::ObjectWrap::Unwrap<WrapAABB>(object); }
-	static b2AABB* Peek(v8::Local<v8::Value> value) { WrapAABB* wrap = Unwrap(value); return (wrap)?(wrap->Peek()):(NULL); }
+	MappedFile() : m_data(NULL), m_size(0)
+	#if defined(_WIN32)
+		, m_file(INVALID_HANDLE_VALUE), m_mapping(NULL)
+	#endif
+	{}
+	~MappedFile() { Close(); }
+	const char* GetData() const { return m_data; }
+	size_t GetSize() const { return m_size; }
+	bool Open(const char* path)
+	{
+		// read only mapping; pages are faulted in as records are read
+		#if defined(_WIN32)
+		m_file = CreateFileA(path, GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+		if (m_file == INVALID_HANDLE_VALUE) { return false; }
+		LARGE_INTEGER size;
+		if (!GetFileSizeEx(m_file, &size)) { return false; }
+		m_size = static_cast<size_t>(size.QuadPart);
+		if (m_size == 0) { return true; }
+		m_mapping = CreateFileMappingA(m_file, NULL, PAGE_READONLY, 0, 0, NULL);
+		if (!m_mapping) { return false; }
+		m_data = static_cast<const char*>(MapViewOfFile(m_mapping, FILE_MAP_READ, 0, 0, 0));
+		return m_data != NULL;
+		#else
+		int fd = open(path, O_RDONLY);
+		if (fd < 0) { return false; }
+		struct stat st;
+		if (fstat(fd, &st) != 0) { close(fd); return false; }
+		m_size = static_cast<size_t>(st.st_size);
+		if (m_size == 0) { close(fd); return true; }
+		void* data = mmap(NULL, m_size, PROT_READ, MAP_PRIVATE, fd, 0);
+		close(fd); // the mapping keeps the file open
+		if (data == MAP_FAILED) { m_size = 0; return false; }
+		m_data = static_cast<const char*>(data);
+		return true;
+		#endif
+	}
+	void Close()
+	{
+		#if defined(_WIN32)
+		if (m_data) { UnmapViewOfFile(m_data); }
+		if (m_mapping) { CloseHandle(m_mapping); }
+		if (m_file != INVALID_HANDLE_VALUE) { CloseHandle(m_file); }
+		m_mapping = NULL;
+		m_file = INVALID_HANDLE_VALUE;
+		#else
+		if (m_data) { munmap(const_cast<char*>(m_data), m_size); }
+		#endif
+		m_data = NULL;
+		m_size = 0;
+	}
+};
+
+//// b2Vec2
+
+class WrapVec2 : public Nan::ObjectWrap
+{
+private:
+	b2Vec2 m_v2;
+private:
+	WrapVec2() {}
+	WrapVec2(const b2Vec2& v2) { m_v2 = v2; } // struct copy
+	WrapVec2(float32 x, float32 y) : m_v2(x, y) {}
+	~WrapVec2() {}
+public:
+	b2Vec2* Peek() { return &m_v2; }
+	//b2Vec2& GetVec2() { return m_v2; }
+	const b2Vec2& GetVec2() const { return m_v2; }
+	void SetVec2(const b2Vec2& v2) { m_v2 = v2; } // struct copy
+public:
+	static WrapVec2* Unwrap(v8::Local<v8::Value> value) { return (value->IsObject())?(Unwrap(v8::Local<v8::Object>::Cast(value))):(NULL); }
+	static WrapVec2* Unwrap(v8::Local<v8::Object> object) { return Nan::ObjectWrap::Unwrap<WrapVec2>(object); }
+	static b2Vec2* Peek(v8::Local<v8::Value> value) { WrapVec2* wrap = Unwrap(value); return (wrap)?(wrap->Peek()):(NULL); }
 public:
 	static NAN_MODULE_INIT(Init)
 	{
@@ -600,13 +2191,13 @@ public:
 		v8::Local<v8::Object> instance = constructor->NewInstance();
 		return scope.Escape(instance);
 	}
-	static v8::Local<v8::Object> NewInstance(const b2AABB& mass_data)
+	static v8::Local<v8::Object> NewInstance(const b2Vec2& v2)
 	{
 		Nan::EscapableHandleScope scope;
 		v8::Local<v8::Function> constructor = GetConstructor();
 		v8::Local<v8::Object> instance = constructor->NewInstance();
-		WrapAABB* wrap = Unwrap(instance);
-		wrap->SetAABB(mass_data);
+		WrapVec2* wrap = Unwrap(instance);
+		wrap->SetVec2(v2);
 		return scope.Escape(instance);
 	}
 private:
@@ -624,15 +2215,25 @@ private:
 		if (g_function_template.IsEmpty())
 		{
 			v8::Local<v8::FunctionTemplate> function_template = Nan::New<v8::FunctionTemplate>(New);
-			function_template->SetClassName(NANX_SYMBOL("b2AABB"));
+			function_template->SetClassName(NANX_SYMBOL("b2Vec2"));
 			function_template->InstanceTemplate()->SetInternalFieldCount(1);
 			v8::Local<v8::ObjectTemplate> prototype_template = function_template->PrototypeTemplate();
-			NANX_MEMBER_APPLY(prototype_template, lowerBound)
-			NANX_MEMBER_APPLY(prototype_template, upperBound)
+			NANX_MEMBER_APPLY(prototype_template, x)
+			NANX_MEMBER_APPLY(prototype_template, y)
+			NANX_METHOD_APPLY(prototype_template, SetZero)
+			NANX_METHOD_APPLY(prototype_template, Set)
+			NANX_METHOD_APPLY(prototype_template, Copy)
+			NANX_METHOD_APPLY(prototype_template, SelfNeg)
+			NANX_METHOD_APPLY(prototype_template, SelfAdd)
+			NANX_METHOD_APPLY(prototype_template, SelfAddXY)
+			NANX_METHOD_APPLY(prototype_template, SelfSub)
+			NANX_METHOD_APPLY(prototype_template, SelfSubXY)
+			NANX_METHOD_APPLY(prototype_template, SelfMul)
+			NANX_METHOD_APPLY(prototype_template, Length)
+			NANX_METHOD_APPLY(prototype_template, LengthSquared)
+			NANX_METHOD_APPLY(prototype_template, Normalize)
+			NANX_METHOD_APPLY(prototype_template, SelfNormalize)
 			NANX_METHOD_APPLY(prototype_template, IsValid)
-			NANX_METHOD_APPLY(prototype_template, GetCenter)
-			NANX_METHOD_APPLY(prototype_template, GetExtents)
-			NANX_METHOD_APPLY(prototype_template, GetPerimeter)
 			g_function_template.Reset(function_template);
 		}
 		v8::Local<v8::FunctionTemplate> function_template = Nan::New<v8::FunctionTemplate>(g_function_template);
@@ -643,7 +2244,9 @@ private:
 	{
 		if (info.IsConstructCall())
 		{
-			WrapAABB* wrap = new WrapAABB();
+			float32 x = (info.Length() > 0) ? NANX_float32(info[0]) : 0.0f;
+			float32 y = (info.Length() > 1) ? NANX_float32(info[1]) : 0.0f;
+			WrapVec2* wrap = new WrapVec2(x, y);
 			wrap->Wrap(info.This());
 			info.GetReturnValue().Set(info.This());
 		}
@@ -653,80 +2256,113 @@ private:
 			info.GetReturnValue().Set(constructor->NewInstance());
 		}
 	}
-	NANX_MEMBER_OBJECT(lowerBound) // m_wrap_lowerBound
-	NANX_MEMBER_OBJECT(upperBound) // m_wrap_upperBound
-	NANX_METHOD(IsValid)
+	NANX_MEMBER_NUMBER(float32, x)
+	NANX_MEMBER_NUMBER(float32, y)
+	NANX_METHOD(SetZero)
 	{
-		b2AABB* that = Peek(info.This());
-		info.GetReturnValue().Set(Nan::New(that->IsValid()));
+		b2Vec2* that = Peek(info.This());
+		that->SetZero();
+		info.GetReturnValue().Set(info.This());
 	}
-	NANX_METHOD(GetCenter)
+	NANX_METHOD(Set)
 	{
-		//b2AABB* that = Peek(info.This());
-		WrapAABB* wrap = Unwrap(info.This());
-		b2AABB* that = &wrap->m_aabb;
-		v8::Local<v8::Object> out = info[0]->IsUndefined() ? WrapVec2::NewInstance() : v8::Local<v8::Object>::Cast(info[0]);
-		WrapVec2::Unwrap(out)->SetVec2(that->GetCenter());
-		info.GetReturnValue().Set(out);
+		b2Vec2* that = Peek(info.This());
+		that->Set(NANX_float32(info[0]), NANX_float32(info[1]));
+		info.GetReturnValue().Set(info.This());
 	}
-	NANX_METHOD(GetExtents)
+	NANX_METHOD(Copy)
 	{
-		//b2AABB* that = Peek(info.This());
-		WrapAABB* wrap = Unwrap(info.This());
-		b2AABB* that = &wrap->m_aabb;
-		v8::Local<v8::Object> out = info[0]->IsUndefined() ? WrapVec2::NewInstance() : v8::Local<v8::Object>::Cast(info[0]);
-		WrapVec2::Unwrap(out)->SetVec2(that->GetExtents());
-		info.GetReturnValue().Set(out);
+		b2Vec2* that = Peek(info.This());
+		b2Vec2* other = Peek(info[0]);
+		*that = *other;
+		info.GetReturnValue().Set(info.This());
 	}
-	NANX_METHOD(GetPerimeter)
+	NANX_METHOD(SelfNeg)
 	{
-		b2AABB* that = Peek(info.This());
-		info.GetReturnValue().Set(Nan::New(that->GetPerimeter()));
+		b2Vec2* that = Peek(info.This());
+		*that = that->operator-();
+		info.GetReturnValue().Set(info.This());
 	}
-};
-
-//// b2MassData
-
-class WrapMassData : public Nan::ObjectWrap
-{
-private:
-	b2MassData m_mass_data;
-	Nan::Persistent<v8::Object> m_wrap_center; // m_mass_data.center
-private:
-	WrapMassData()
+	NANX_METHOD(SelfAdd)
 	{
-		m_wrap_center.Reset(WrapVec2::NewInstance(m_mass_data.center));
+		b2Vec2* that = Peek(info.This());
+		b2Vec2* v = Peek(info[0]);
+		that->operator+=(*v);
+		info.GetReturnValue().Set(info.This());
 	}
-	~WrapMassData()
+	NANX_METHOD(SelfAddXY)
 	{
-		m_wrap_center.Reset();
+		b2Vec2* that = Peek(info.This());
+		that->operator+=(b2Vec2(NANX_float32(info[0]), NANX_float32(info[1])));
+		info.GetReturnValue().Set(info.This());
 	}
-public:
-	b2MassData* Peek() { return &m_mass_data; }
-	const b2MassData& GetMassData()
+	NANX_METHOD(SelfSub)
 	{
-		SyncPull();
-		return m_mass_data;
+		b2Vec2* that = Peek(info.This());
+		b2Vec2* v = Peek(info[0]);
+		that->operator-=(*v);
+		info.GetReturnValue().Set(info.This());
 	}
-	void SetMassData(const b2MassData& mass_data)
+	NANX_METHOD(SelfSubXY)
 	{
-		m_mass_data = mass_data; // struct copy
-		SyncPush();
+		b2Vec2* that = Peek(info.This());
+		that->operator-=(b2Vec2(NANX_float32(info[0]), NANX_float32(info[1])));
+		info.GetReturnValue().Set(info.This());
 	}
-	void SyncPull()
+	NANX_METHOD(SelfMul)
 	{
-		// sync: pull data from javascript objects
-		m_mass_data.center = WrapVec2::Unwrap(Nan::New<v8::Object>(m_wrap_center))->GetVec2(); // struct copy
+		b2Vec2* that = Peek(info.This());
+		that->operator*=(NANX_float32(info[0]));
+		info.GetReturnValue().Set(info.This());
 	}
-	void SyncPush()
+	NANX_METHOD(Length)
 	{
-		// sync: push data into javascript objects
-		WrapVec2::Unwrap(Nan::New<v8::Object>(m_wrap_center))->SetVec2(m_mass_data.center);
+		b2Vec2* that = Peek(info.This());
+		info.GetReturnValue().Set(Nan::New(that->Length()));
+	}
+	NANX_METHOD(LengthSquared)
+	{
+		b2Vec2* that = Peek(info.This());
+		info.GetReturnValue().Set(Nan::New(that->LengthSquared()));
+	}
+	NANX_METHOD(Normalize)
+	{
+		b2Vec2* that = Peek(info.This());
+		info.GetReturnValue().Set(Nan::New(that->Normalize()));
+	}
+	NANX_METHOD(SelfNormalize)
+	{
+		b2Vec2* that = Peek(info.This());
+		that->Normalize();
+		info.GetReturnValue().Set(info.This());
+	}
+	NANX_METHOD(IsValid)
+	{
+		b2Vec2* that = Peek(info.This());
+		info.GetReturnValue().Set(Nan::New(that->IsValid()));
 	}
+};
+
+//// b2Rot
+
+class WrapRot : public Nan::ObjectWrap
+{
+private:
+	b2Rot m_rot;
+private:
+	WrapRot() {}
+	WrapRot(const b2Rot& rot) { m_rot = rot; } // struct copy
+	WrapRot(float32 angle) : m_rot(angle) {}
+	~WrapRot() {}
 public:
-	static WrapMassData* Unwrap(v8::Local<v8::Value> value) { return (value->IsObject())?(Unwrap(v8::Local<v8::Object>::Cast(value))):(NULL); }
-	static WrapMassData* Unwrap(v8::Local<v8::Object> object) { return Nan::ObjectWrap::Unwrap<WrapMassData>(object); }
-	static b2MassData* Peek(v8::Local<v8::Value> value) { WrapMassData* wrap = Unwrap(value); return (wrap)?(wrap->Peek()):(NULL); }
+	b2Rot* Peek() { return &m_rot; }
+	//b2Rot& GetRot() { return m_rot; }
+	const b2Rot& GetRot() const { return m_rot; }
+	void SetRot(const b2Rot& rot) { m_rot = rot; } // struct copy
+public:
+	static WrapRot* Unwrap(v8::Local<v8::Value> value) { return (value->IsObject())?(Unwrap(v8::Local<v8::Object>::Cast(value))):(NULL); }
+	static WrapRot* Unwrap(v8::Local<v8::Object> object) { return Nan::ObjectWrap::Unwrap<WrapRot>(object); }
+	static b2Rot* Peek(v8::Local<v8::Value> value) { WrapRot* wrap = Unwrap(value); return (wrap)?(wrap->Peek()):(NULL); }
 public:
 	static NAN_MODULE_INIT(Init)
 	{
@@ -740,13 +2376,13 @@ public:
 		v8::Local<v8::Object> instance = constructor->NewInstance();
 		return scope.Escape(instance);
 	}
-	static v8::Local<v8::Object> NewInstance(const b2MassData& mass_data)
+	static v8::Local<v8::Object> NewInstance(const b2Rot& rot)
 	{
 		Nan::EscapableHandleScope scope;
 		v8::Local<v8::Function> constructor = GetConstructor();
 		v8::Local<v8::Object> instance = constructor->NewInstance();
-		WrapMassData* wrap = Unwrap(instance);
-		wrap->SetMassData(mass_data);
+		WrapRot* wrap = Unwrap(instance);
+		wrap->SetRot(rot);
 		return scope.Escape(instance);
 	}
 private:
@@ -764,12 +2400,16 @@ private:
 		if (g_function_template.IsEmpty())
 		{
 			v8::Local<v8::FunctionTemplate> function_template = Nan::New<v8::FunctionTemplate>(New);
-			function_template->SetClassName(NANX_SYMBOL("b2MassData"));
+			function_template->SetClassName(NANX_SYMBOL("b2Rot"));
 			function_template->InstanceTemplate()->SetInternalFieldCount(1);
 			v8::Local<v8::ObjectTemplate> prototype_template = function_template->PrototypeTemplate();
-			NANX_MEMBER_APPLY(prototype_template, mass)
-			NANX_MEMBER_APPLY(prototype_template, center)
-			NANX_MEMBER_APPLY(prototype_template, I)
+			NANX_MEMBER_APPLY(prototype_template, s)
+			NANX_MEMBER_APPLY(prototype_template, c)
+			NANX_METHOD_APPLY(prototype_template, Set)
+			//void SetIdentity()
+			NANX_METHOD_APPLY(prototype_template, GetAngle)
+			//b2Vec2 GetXAxis() const
+			//b2Vec2 GetYAxis() const
 			g_function_template.Reset(function_template);
 		}
 		v8::Local<v8::FunctionTemplate> function_template = Nan::New<v8::FunctionTemplate>(g_function_template);
@@ -780,7 +2420,8 @@ private:
 	{
 		if (info.IsConstructCall())
 		{
-			WrapMassData* wrap = new WrapMassData();
+			float32 angle = (info.Length() > 0) ? NANX_float32(info[0]) : 0.0f;
+			WrapRot* wrap = new WrapRot(angle);
 			wrap->Wrap(info.This());
 			info.GetReturnValue().Set(info.This());
 		}
@@ -790,197 +2431,98 @@ private:
 			info.GetReturnValue().Set(constructor->NewInstance());
 		}
 	}
-	NANX_MEMBER_NUMBER(float32, mass)
-	NANX_MEMBER_OBJECT(center) // m_wrap_center
-	NANX_MEMBER_NUMBER(float32, I)
+	NANX_MEMBER_NUMBER(float32, s)
+	NANX_MEMBER_NUMBER(float32, c)
+	NANX_METHOD(Set)
+	{
+		b2Rot* that = Peek(info.This());
+		that->Set(NANX_float32(info[0]));
+		info.GetReturnValue().Set(info.This());
+	}
+	NANX_METHOD(GetAngle)
+	{
+		b2Rot* that = Peek(info.This());
+		info.GetReturnValue().Set(Nan::New(that->GetAngle()));
+	}
 };
 
-//// b2Shape
+//// b2Transform
 
-class WrapShape : public Nan::ObjectWrap
+class WrapTransform : public Nan::ObjectWrap
 {
-protected:
-	WrapShape() {}
-	~WrapShape() {}
-public:
-	b2Shape* Peek() { return &GetShape(); }
-	virtual b2Shape& GetShape() = 0;
-	virtual void SyncPull() {}
-	virtual void SyncPush() {}
-public:
-	const b2Shape& UseShape() { SyncPull(); return GetShape(); }
-///private:
-///	static std::map<b2Shape*,WrapShape*> g_wrap_map;
+private:
+	b2Transform m_xf;
+	Nan::Persistent<v8::Object> m_wrap_p; // m_xf.p
+	Nan::Persistent<v8::Object> m_wrap_q; // m_xf.q
+private:
+	WrapTransform()
+	{
+		m_wrap_p.Reset(WrapVec2::NewInstance(m_xf.p));
+		m_wrap_q.Reset(WrapRot::NewInstance(m_xf.q));
+	}
+	//WrapTransform(const b2Transform& xf) { m_xf = xf; } // struct copy
+	//WrapTransform(float32 angle) : m_xf(angle) {}
+	~WrapTransform()
+	{
+		m_wrap_p.Reset();
+		m_wrap_q.Reset();
+	}
 public:
-	static WrapShape* GetWrap(b2Shape* shape)
+	b2Transform* Peek() { return &m_xf; }
+	//b2Transform& GetTransform() { return m_xf; }
+	//const b2Transform& GetTransform() const { return m_xf; }
+	//void SetTransform(const b2Transform& xf) { m_xf = xf; } // struct copy
+	const b2Transform& GetTransform()
 	{
-		//return static_cast<WrapShape*>(shape->GetUserData());
-///		std::map<b2Shape*,WrapShape*>::iterator it = g_wrap_map.find(shape);
-///		if (it != g_wrap_map.end())
-///		{
-///			return it->second;
-///		}
-		return NULL;
+		SyncPull();
+		return m_xf;
 	}
-
-	static void SetWrap(b2Shape* shape, WrapShape* wrap)
+	void SetTransform(const b2Transform& xf)
 	{
-		//shape->SetUserData(wrap);
-///		std::map<b2Shape*,WrapShape*>::iterator it = g_wrap_map.find(shape);
-///		if (it != g_wrap_map.end())
-///		{
-///			if (wrap)
-///			{
-///				it->second = wrap;
-///			}
-///			else
-///			{
-///				g_wrap_map.erase(it);
-///			}
-///		}
-///		else
-///		{
-///			if (wrap)
-///			{
-///				g_wrap_map[shape] = wrap;
-///			}
-///		}
+		m_xf = xf; // struct copy
+		SyncPush();
+	}
+	void SetTransform(const b2Vec2& position, float32 angle)
+	{
+		m_xf.Set(position, angle);
+		SyncPush();
+	}
+	void SyncPull()
+	{
+		// sync: pull data from javascript objects
+		m_xf.p = WrapVec2::Unwrap(Nan::New<v8::Object>(m_wrap_p))->GetVec2(); // struct copy
+		m_xf.q = WrapRot::Unwrap(Nan::New<v8::Object>(m_wrap_q))->GetRot(); // struct copy
+	}
+	void SyncPush()
+	{
+		// sync: push data into javascript objects
+		WrapVec2::Unwrap(Nan::New<v8::Object>(m_wrap_p))->SetVec2(m_xf.p);
+		WrapRot::Unwrap(Nan::New<v8::Object>(m_wrap_q))->SetRot(m_xf.q);
 	}
 public:
-	static WrapShape* Unwrap(v8::Local<v8::Value> value) { return (value->IsObject())?(Unwrap(v8::Local<v8::Object>::Cast(value))):(NULL); }
-	static WrapShape* Unwrap(v8::Local<v8::Object> object) { return Nan::ObjectWrap::Unwrap<WrapShape>(object); }
-	static b2Shape* Peek(v8::Local<v8::Value> value) { WrapShape* wrap = Unwrap(value); return (wrap)?(wrap->Peek()):(NULL); }
-//public:
-//	static NAN_MODULE_INIT(Init)
-//	{
-//		v8::Local<v8::Function> constructor = GetConstructor();
-//		target->Set(constructor->GetName(), constructor);
-//	}
-//	static v8::Local<v8::Object> NewInstance()
-//	{
-//		Nan::EscapableHandleScope scope;
-//		v8::Local<v8::Function> constructor = GetConstructor();
-//		v8::Local<v8::Object> instance = constructor->NewInstance();
-//		return scope.Escape(instance);
-//	}
-//	static v8::Local<v8::Object> NewInstance(const b2Shape& shape)
-//	{
-//		Nan::EscapableHandleScope scope;
-//		v8::Local<v8::Function> constructor = GetConstructor();
-//		v8::Local<v8::Object> instance = constructor->NewInstance();
-//		WrapShape* wrap = Unwrap(instance);
-//		wrap->SetShape(shape);
-//		return scope.Escape(instance);
-//	}
+	static WrapTransform* Unwrap(v8::Local<v8::Value> value) { return (value->IsObject())?(Unwrap(v8::Local<v8::Object>::Cast(value))):(NULL); }
+	static WrapTransform* Unwrap(v8::Local<v8::Object> object) { return Nan::ObjectWrap::Unwrap<WrapTransform>(object); }
+	static b2Transform* Peek(v8::Local<v8::Value> value) { WrapTransform* wrap = Unwrap(value); return (wrap)?(wrap->Peek()):(NULL); }
 public:
-//	static v8::Local<v8::Function> GetConstructor()
-//	{
-//		Nan::EscapableHandleScope scope;
-//		v8::Local<v8::FunctionTemplate> function_template = GetFunctionTemplate();
-//		v8::Local<v8::Function> constructor = function_template->GetFunction();
-//		return scope.Escape(constructor);
-//	}
-	static v8::Local<v8::FunctionTemplate> GetFunctionTemplate()
-	{
-		Nan::EscapableHandleScope scope;
-		static Nan::Persistent<v8::FunctionTemplate> g_function_template;
-		if (g_function_template.IsEmpty())
-		{
-//			v8::Local<v8::FunctionTemplate> function_template = Nan::New<v8::FunctionTemplate>(New);
-			v8::Local<v8::FunctionTemplate> function_template = Nan::New<v8::FunctionTemplate>();
-			function_template->SetClassName(NANX_SYMBOL("b2Shape"));
-			function_template->InstanceTemplate()->SetInternalFieldCount(1);
-			v8::Local<v8::ObjectTemplate> prototype_template = function_template->PrototypeTemplate();
-			NANX_MEMBER_APPLY(prototype_template, m_type)
-			NANX_MEMBER_APPLY(prototype_template, m_radius)
-			NANX_METHOD_APPLY(prototype_template, GetType)
-			g_function_template.Reset(function_template);
-		}
-		v8::Local<v8::FunctionTemplate> function_template = Nan::New<v8::FunctionTemplate>(g_function_template);
-		return scope.Escape(function_template);
-	}
-private:
-//	static NAN_METHOD(New)
-//	{
-//		if (info.IsConstructCall())
-//		{
-//			WrapShape* wrap = new WrapShape();
-//			wrap->Wrap(info.This());
-//			info.GetReturnValue().Set(info.This());
-//		}
-//		else
-//		{
-//			v8::Local<v8::Function> constructor = GetConstructor();
-//			info.GetReturnValue().Set(constructor->NewInstance());
-//		}
-//	}
-	NANX_MEMBER_INTEGER(b2Shape::Type, m_type)
-	NANX_MEMBER_NUMBER(float32, m_radius)
-	NANX_METHOD(GetType)
-	{
-		//b2Shape* that = Peek(info.This());
-		WrapShape* wrap = Unwrap(info.This());
-		//b2Shape* that = &wrap->m_shape;
-		//wrap->SyncPush();
-		//info.GetReturnValue().Set(info.This());
-		info.GetReturnValue().Set(Nan::New(wrap->GetShape().GetType()));
-	}
-};
-
-//// b2CircleShape
-
-class WrapCircleShape : public WrapShape
-{
-private:
-	b2CircleShape m_circle;
-	Nan::Persistent<v8::Object> m_wrap_m_p; // m_circle.m_p
-private:
-	WrapCircleShape(float32 radius = 0.0f)
-	{
-		m_circle.m_radius = radius;
-		m_wrap_m_p.Reset(WrapVec2::NewInstance(m_circle.m_p));
-	}
-	~WrapCircleShape()
-	{
-		m_wrap_m_p.Reset();
-	}
-public:
-	b2CircleShape* Peek() { return &m_circle; }
-	virtual b2Shape& GetShape() { return m_circle; } // override WrapShape
-	virtual void SyncPull() // override WrapShape
-	{
-		// sync: pull data from javascript objects
-		m_circle.m_p = WrapVec2::Unwrap(Nan::New<v8::Object>(m_wrap_m_p))->GetVec2(); // struct copy
-	}
-	virtual void SyncPush() // override WrapShape
-	{
-		// sync: push data into javascript objects
-		WrapVec2::Unwrap(Nan::New<v8::Object>(m_wrap_m_p))->SetVec2(m_circle.m_p);
-	}
-public:
-	static WrapCircleShape* Unwrap(v8::Local<v8::Value> value) { return (value->IsObject())?(Unwrap(v8::Local<v8::Object>::Cast(value))):(NULL); }
-	static WrapCircleShape* Unwrap(v8::Local<v8::Object> object) { return Nan::ObjectWrap::Unwrap<WrapCircleShape>(object); }
-	static b2CircleShape* Peek(v8::Local<v8::Value> value) { WrapCircleShape* wrap = Unwrap(value); return (wrap)?(wrap->Peek()):(NULL); }
-public:
-	static NAN_MODULE_INIT(Init)
-	{
-		v8::Local<v8::Function> constructor = GetConstructor();
-		target->Set(constructor->GetName(), constructor);
-	}
-	static v8::Local<v8::Object> NewInstance()
+	static NAN_MODULE_INIT(Init)
+	{
+		v8::Local<v8::Function> constructor = GetConstructor();
+		target->Set(constructor->GetName(), constructor);
+	}
+	static v8::Local<v8::Object> NewInstance()
 	{
 		Nan::EscapableHandleScope scope;
 		v8::Local<v8::Function> constructor = GetConstructor();
 		v8::Local<v8::Object> instance = constructor->NewInstance();
 		return scope.Escape(instance);
 	}
-	static v8::Local<v8::Object> NewInstance(float32 radius)
+	static v8::Local<v8::Object> NewInstance(const b2Transform& xf)
 	{
 		Nan::EscapableHandleScope scope;
 		v8::Local<v8::Function> constructor = GetConstructor();
 		v8::Local<v8::Object> instance = constructor->NewInstance();
-		WrapCircleShape* wrap = Unwrap(instance);
-		wrap->m_circle.m_radius = radius;
+		WrapTransform* wrap = Unwrap(instance);
+		wrap->SetTransform(xf);
 		return scope.Escape(instance);
 	}
 private:
@@ -998,12 +2540,13 @@ private:
 		if (g_function_template.IsEmpty())
 		{
 			v8::Local<v8::FunctionTemplate> function_template = Nan::New<v8::FunctionTemplate>(New);
-			function_template->Inherit(WrapShape::GetFunctionTemplate());
-			function_template->SetClassName(NANX_SYMBOL("b2CircleShape"));
+			function_template->SetClassName(NANX_SYMBOL("b2Transform"));
 			function_template->InstanceTemplate()->SetInternalFieldCount(1);
 			v8::Local<v8::ObjectTemplate> prototype_template = function_template->PrototypeTemplate();
-			NANX_MEMBER_APPLY(prototype_template, m_p)
-			NANX_METHOD_APPLY(prototype_template, ComputeMass)
+			NANX_MEMBER_APPLY(prototype_template, p)
+			NANX_MEMBER_APPLY(prototype_template, q)
+			NANX_METHOD_APPLY(prototype_template, SetIdentity)
+			NANX_METHOD_APPLY(prototype_template, Set)
 			g_function_template.Reset(function_template);
 		}
 		v8::Local<v8::FunctionTemplate> function_template = Nan::New<v8::FunctionTemplate>(g_function_template);
@@ -1014,76 +2557,87 @@ private:
 	{
 		if (info.IsConstructCall())
 		{
-			float32 radius = (info.Length() > 0) ? NANX_float32(info[0]) : 0.0f;
-			WrapCircleShape* wrap = new WrapCircleShape(radius);
+			WrapTransform* wrap = new WrapTransform();
 			wrap->Wrap(info.This());
 			info.GetReturnValue().Set(info.This());
 		}
 		else
 		{
 			v8::Local<v8::Function> constructor = GetConstructor();
-			v8::Local<v8::Value> argv[] = { info[0] };
-			info.GetReturnValue().Set(constructor->NewInstance(countof(argv), argv));
+			info.GetReturnValue().Set(constructor->NewInstance());
 		}
 	}
-	NANX_MEMBER_OBJECT(m_p) // m_wrap_m_p
-	NANX_METHOD(ComputeMass)
+	NANX_MEMBER_OBJECT(p) // m_wrap_p
+	NANX_MEMBER_OBJECT(q) // m_wrap_q
+	NANX_METHOD(SetIdentity)
 	{
-		b2CircleShape* circle = Peek(info.This());
-		b2MassData* mass_data = WrapMassData::Peek(info[0]);
-		float32 density = NANX_float32(info[1]);
-		circle->ComputeMass(mass_data, density);
+		//b2Transform* that = Peek(info.This());
+		WrapTransform* wrap = Unwrap(info.This());
+		b2Transform* that = &wrap->m_xf;
+		that->SetIdentity();
+		wrap->SyncPush();
+		info.GetReturnValue().Set(info.This());
+	}
+	NANX_METHOD(Set)
+	{
+		//b2Transform* that = Peek(info.This());
+		WrapTransform* wrap = Unwrap(info.This());
+		b2Transform* that = &wrap->m_xf;
+		b2Vec2* position = WrapVec2::Peek(info[0]);
+		float32 angle = NANX_float32(info[1]);
+		that->Set(*position, angle);
+		wrap->SyncPush();
+		info.GetReturnValue().Set(info.This());
 	}
 };
 
-//// b2EdgeShape
+//// b2AABB
 
-class WrapEdgeShape : public WrapShape
+class WrapAABB : public Nan::ObjectWrap
 {
 private:
-	b2EdgeShape m_edge;
-	Nan::Persistent<v8::Object> m_wrap_m_vertex1; // m_edge.m_vertex1
-	Nan::Persistent<v8::Object> m_wrap_m_vertex2; // m_edge.m_vertex2
-	Nan::Persistent<v8::Object> m_wrap_m_vertex0; // m_edge.m_vertex0
-	Nan::Persistent<v8::Object> m_wrap_m_vertex3; // m_edge.m_vertex3
+	b2AABB m_aabb;
+	Nan::Persistent<v8::Object> m_wrap_lowerBound; // m_aabb.lowerBound
+	Nan::Persistent<v8::Object> m_wrap_upperBound; // m_aabb.upperBound
 private:
-	WrapEdgeShape()
+	WrapAABB()
 	{
-		m_wrap_m_vertex1.Reset(WrapVec2::NewInstance(m_edge.m_vertex1));
-		m_wrap_m_vertex2.Reset(WrapVec2::NewInstance(m_edge.m_vertex2));
-		m_wrap_m_vertex0.Reset(WrapVec2::NewInstance(m_edge.m_vertex0));
-		m_wrap_m_vertex3.Reset(WrapVec2::NewInstance(m_edge.m_vertex3));
+		m_wrap_lowerBound.Reset(WrapVec2::NewInstance(m_aabb.lowerBound));
+		m_wrap_upperBound.Reset(WrapVec2::NewInstance(m_aabb.upperBound));
 	}
-	~WrapEdgeShape()
+	~WrapAABB()
 	{
-		m_wrap_m_vertex1.Reset();
-		m_wrap_m_vertex2.Reset();
-		m_wrap_m_vertex0.Reset();
-		m_wrap_m_vertex3.Reset();
+		m_wrap_lowerBound.Reset();
+		m_wrap_upperBound.Reset();
 	}
 public:
-	b2EdgeShape* Peek() { return &m_edge; }
-	virtual b2Shape& GetShape() { return m_edge; } // override WrapShape
-	virtual void SyncPull() // override WrapShape
+	b2AABB* Peek() { return &m_aabb; }
+	const b2AABB& GetAABB()
+	{
+		SyncPull();
+		return m_aabb;
+	}
+	void SetAABB(const b2AABB& mass_data)
+	{
+		m_aabb = mass_data; // struct copy
+		SyncPush();
+	}
+	void SyncPull()
 	{
 		// sync: pull data from javascript objects
-		m_edge.m_vertex1 = WrapVec2::Unwrap(Nan::New<v8::Object>(m_wrap_m_vertex1))->GetVec2(); // struct copy
-		m_edge.m_vertex2 = WrapVec2::Unwrap(Nan::New<v8::Object>(m_wrap_m_vertex2))->GetVec2(); // struct copy
-		m_edge.m_vertex0 = WrapVec2::Unwrap(Nan::New<v8::Object>(m_wrap_m_vertex0))->GetVec2(); // struct copy
-		m_edge.m_vertex3 = WrapVec2::Unwrap(Nan::New<v8::Object>(m_wrap_m_vertex3))->GetVec2(); // struct copy
+		m_aabb.lowerBound = WrapVec2::Unwrap(Nan::New<v8::Object>(m_wrap_lowerBound))->GetVec2(); // struct copy
+		m_aabb.upperBound = WrapVec2::Unwrap(Nan::New<v8::Object>(m_wrap_upperBound))->GetVec2(); // struct copy
 	}
-	virtual void SyncPush() // override WrapShape
+	void SyncPush()
 	{
 		// sync: push data into javascript objects
-		WrapVec2::Unwrap(Nan::New<v8::Object>(m_wrap_m_vertex1))->SetVec2(m_edge.m_vertex1);
-		WrapVec2::Unwrap(Nan::New<v8::Object>(m_wrap_m_vertex2))->SetVec2(m_edge.m_vertex2);
-		WrapVec2::Unwrap(Nan::New<v8::Object>(m_wrap_m_vertex0))->SetVec2(m_edge.m_vertex0);
-		WrapVec2::Unwrap(Nan::New<v8::Object>(m_wrap_m_vertex3))->SetVec2(m_edge.m_vertex3);
+		WrapVec2::Unwrap(Nan::New<v8::Object>(m_wrap_lowerBound))->SetVec2(m_aabb.lowerBound);
+		WrapVec2::Unwrap(Nan::New<v8::Object>(m_wrap_upperBound))->SetVec2(m_aabb.upperBound);
 	}
 public:
-	static WrapEdgeShape* Unwrap(v8::Local<v8::Value> value) { return (value->IsObject())?(Unwrap(v8::Local<v8::Object>::Cast(value))):(NULL); }
-	static WrapEdgeShape* Unwrap(v8::Local<v8::Object> object) { return Nan::ObjectWrap::Unwrap<WrapEdgeShape>(object); }
-	static b2EdgeShape* Peek(v8::Local<v8::Value> value) { WrapEdgeShape* wrap = Unwrap(value); return (wrap)?(wrap->Peek()):(NULL); }
+	static WrapAABB* Unwrap(v8::Local<v8::Value> value) { return (value->IsObject())?(Unwrap(v8::Local<v8::Object>::Cast(value))):(NULL); }
+	static WrapAABB* Unwrap(v8::Local<v8::Object> object) { return Nan::ObjectWrap::Unwrap<WrapAABB>(object); }
+	static b2AABB* Peek(v8::Local<v8::Value> value) { WrapAABB* wrap = Unwrap(value); return (wrap)?(wrap->Peek()):(NULL); }
 public:
 	static NAN_MODULE_INIT(Init)
 	{
@@ -1097,6 +2651,15 @@ public:
 		v8::Local<v8::Object> instance = constructor->NewInstance();
 		return scope.Escape(instance);
 	}
+	static v8::Local<v8::Object> NewInstance(const b2AABB& mass_data)
+	{
+		Nan::EscapableHandleScope scope;
+		v8::Local<v8::Function> constructor = GetConstructor();
+		v8::Local<v8::Object> instance = constructor->NewInstance();
+		WrapAABB* wrap = Unwrap(instance);
+		wrap->SetAABB(mass_data);
+		return scope.Escape(instance);
+	}
 private:
 	static v8::Local<v8::Function> GetConstructor()
 	{
@@ -1112,15 +2675,15 @@ private:
 		if (g_function_template.IsEmpty())
 		{
 			v8::Local<v8::FunctionTemplate> function_template = Nan::New<v8::FunctionTemplate>(New);
-			function_template->SetClassName(NANX_SYMBOL("b2EdgeShape"));
+			function_template->SetClassName(NANX_SYMBOL("b2AABB"));
 			function_template->InstanceTemplate()->SetInternalFieldCount(1);
 			v8::Local<v8::ObjectTemplate> prototype_template = function_template->PrototypeTemplate();
-			NANX_MEMBER_APPLY(prototype_template, m_vertex1)
-			NANX_MEMBER_APPLY(prototype_template, m_vertex2)
-			NANX_MEMBER_APPLY(prototype_template, m_vertex0)
-			NANX_MEMBER_APPLY(prototype_template, m_vertex3)
-			NANX_METHOD_APPLY(prototype_template, Set)
-			NANX_METHOD_APPLY(prototype_template, ComputeMass)
+			NANX_MEMBER_APPLY(prototype_template, lowerBound)
+			NANX_MEMBER_APPLY(prototype_template, upperBound)
+			NANX_METHOD_APPLY(prototype_template, IsValid)
+			NANX_METHOD_APPLY(prototype_template, GetCenter)
+			NANX_METHOD_APPLY(prototype_template, GetExtents)
+			NANX_METHOD_APPLY(prototype_template, GetPerimeter)
 			g_function_template.Reset(function_template);
 		}
 		v8::Local<v8::FunctionTemplate> function_template = Nan::New<v8::FunctionTemplate>(g_function_template);
@@ -1131,7 +2694,7 @@ private:
 	{
 		if (info.IsConstructCall())
 		{
-			WrapEdgeShape* wrap = new WrapEdgeShape();
+			WrapAABB* wrap = new WrapAABB();
 			wrap->Wrap(info.This());
 			info.GetReturnValue().Set(info.This());
 		}
@@ -1141,54 +2704,80 @@ private:
 			info.GetReturnValue().Set(constructor->NewInstance());
 		}
 	}
-	NANX_MEMBER_OBJECT(m_vertex1) // m_wrap_m_vertex1
-	NANX_MEMBER_OBJECT(m_vertex2) // m_wrap_m_vertex2
-	NANX_MEMBER_OBJECT(m_vertex0) // m_wrap_m_vertex0
-	NANX_MEMBER_OBJECT(m_vertex3) // m_wrap_m_vertex3
-	NANX_METHOD(Set)
+	NANX_MEMBER_OBJECT(lowerBound) // m_wrap_lowerBound
+	NANX_MEMBER_OBJECT(upperBound) // m_wrap_upperBound
+	NANX_METHOD(IsValid)
 	{
-		WrapEdgeShape* wrap = Unwrap(info.This());
-		wrap->m_wrap_m_vertex1.Reset(v8::Local<v8::Object>::Cast(info[0]));
-		wrap->m_wrap_m_vertex2.Reset(v8::Local<v8::Object>::Cast(info[1]));
-		info.GetReturnValue().Set(info.This());
+		b2AABB* that = Peek(info.This());
+		info.GetReturnValue().Set(Nan::New(that->IsValid()));
 	}
-	NANX_METHOD(ComputeMass)
+	NANX_METHOD(GetCenter)
 	{
-		b2EdgeShape* edge = Peek(info.This());
-		b2MassData* mass_data = WrapMassData::Peek(info[0]);
-		float32 density = NANX_float32(info[1]);
-		edge->ComputeMass(mass_data, density);
+		//b2AABB* that = Peek(info.This());
+		WrapAABB* wrap = Unwrap(info.This());
+		b2AABB* that = &wrap->m_aabb;
+		v8::Local<v8::Object> out = info[0]->IsUndefined() ? WrapVec2::NewInstance() : v8::Local<v8::Object>::Cast(info[0]);
+		WrapVec2::Unwrap(out)->SetVec2(that->GetCenter());
+		info.GetReturnValue().Set(out);
 	}
-};
-
-//// b2PolygonShape
-
-class WrapPolygonShape : public WrapShape
-{
-private:
-	b2PolygonShape m_polygon;
-private:
-	WrapPolygonShape()
+	NANX_METHOD(GetExtents)
 	{
+		//b2AABB* that = Peek(info.This());
+		WrapAABB* wrap = Unwrap(info.This());
+		b2AABB* that = &wrap->m_aabb;
+		v8::Local<v8::Object> out = info[0]->IsUndefined() ? WrapVec2::NewInstance() : v8::Local<v8::Object>::Cast(info[0]);
+		WrapVec2::Unwrap(out)->SetVec2(that->GetExtents());
+		info.GetReturnValue().Set(out);
 	}
-	~WrapPolygonShape()
+	NANX_METHOD(GetPerimeter)
+	{
+		b2AABB* that = Peek(info.This());
+		info.GetReturnValue().Set(Nan::New(that->GetPerimeter()));
+	}
+};
+
+//// b2MassData
+
+class WrapMassData : public Nan::ObjectWrap
+{
+private:
+	b2MassData m_mass_data;
+	Nan::Persistent<v8::Object> m_wrap_center; // m_mass_data.center
+private:
+	WrapMassData()
+	{
+		m_wrap_center.Reset(WrapVec2::NewInstance(m_mass_data.center));
+	}
+	~WrapMassData()
 	{
+		m_wrap_center.Reset();
 	}
 public:
-	b2PolygonShape* Peek() { return &m_polygon; }
-	virtual b2Shape& GetShape() { return m_polygon; } // override WrapShape
-	virtual void SyncPull() // override WrapShape
+	b2MassData* Peek() { return &m_mass_data; }
+	const b2MassData& GetMassData()
+	{
+		SyncPull();
+		return m_mass_data;
+	}
+	void SetMassData(const b2MassData& mass_data)
+	{
+		m_mass_data = mass_data; // struct copy
+		SyncPush();
+	}
+	void SyncPull()
 	{
 		// sync: pull data from javascript objects
+		m_mass_data.center = WrapVec2::Unwrap(Nan::New<v8::Object>(m_wrap_center))->GetVec2(); // struct copy
 	}
-	virtual void SyncPush() // override WrapShape
+	void SyncPush()
 	{
 		// sync: push data into javascript objects
+		WrapVec2::Unwrap(Nan::New<v8::Object>(m_wrap_center))->SetVec2(m_mass_data.center);
 	}
 public:
-	static WrapPolygonShape* Unwrap(v8::Local<v8::Value> value) { return (value->IsObject())?(Unwrap(v8::Local<v8::Object>::Cast(value))):(NULL); }
-	static WrapPolygonShape* Unwrap(v8::Local<v8::Object> object) { return Nan::ObjectWrap::Unwrap<WrapPolygonShape>(object); }
-	static b2PolygonShape* Peek(v8::Local<v8::Value> value) { WrapPolygonShape* wrap = Unwrap(value); return (wrap)?(wrap->Peek()):(NULL); }
+	static WrapMassData* Unwrap(v8::Local<v8::Value> value) { return (value->IsObject())?(Unwrap(v8::Local<v8::Object>::Cast(value))):(NULL); }
+	static WrapMassData* Unwrap(v8::Local<v8::Object> object) { return Nan::ObjectWrap::Unwrap<WrapMassData>(object); }
+	static b2MassData* Peek(v8::Local<v8::Value> value) { WrapMassData* wrap = Unwrap(value); return (wrap)?(wrap->Peek()):(NULL); }
 public:
 	static NAN_MODULE_INIT(Init)
 	{
@@ -1202,6 +2791,15 @@ public:
 		v8::Local<v8::Object> instance = constructor->NewInstance();
 		return scope.Escape(instance);
 	}
+	static v8::Local<v8::Object> NewInstance(const b2MassData& mass_data)
+	{
+		Nan::EscapableHandleScope scope;
+		v8::Local<v8::Function> constructor = GetConstructor();
+		v8::Local<v8::Object> instance = constructor->NewInstance();
+		WrapMassData* wrap = Unwrap(instance);
+		wrap->SetMassData(mass_data);
+		return scope.Escape(instance);
+	}
 private:
 	static v8::Local<v8::Function> GetConstructor()
 	{
@@ -1217,12 +2815,12 @@ private:
 		if (g_function_template.IsEmpty())
 		{
 			v8::Local<v8::FunctionTemplate> function_template = Nan::New<v8::FunctionTemplate>(New);
-			function_template->SetClassName(NANX_SYMBOL("b2PolygonShape"));
+			function_template->SetClassName(NANX_SYMBOL("b2MassData"));
 			function_template->InstanceTemplate()->SetInternalFieldCount(1);
 			v8::Local<v8::ObjectTemplate> prototype_template = function_template->PrototypeTemplate();
-			NANX_METHOD_APPLY(prototype_template, Set)
-			NANX_METHOD_APPLY(prototype_template, SetAsBox)
-			NANX_METHOD_APPLY(prototype_template, ComputeMass)
+			NANX_MEMBER_APPLY(prototype_template, mass)
+			NANX_MEMBER_APPLY(prototype_template, center)
+			NANX_MEMBER_APPLY(prototype_template, I)
 			g_function_template.Reset(function_template);
 		}
 		v8::Local<v8::FunctionTemplate> function_template = Nan::New<v8::FunctionTemplate>(g_function_template);
@@ -1233,7 +2831,7 @@ private:
 	{
 		if (info.IsConstructCall())
 		{
-			WrapPolygonShape* wrap = new WrapPolygonShape();
+			WrapMassData* wrap = new WrapMassData();
 			wrap->Wrap(info.This());
 			info.GetReturnValue().Set(info.This());
 		}
@@ -1243,104 +2841,177 @@ private:
 			info.GetReturnValue().Set(constructor->NewInstance());
 		}
 	}
-	NANX_METHOD(Set)
+	NANX_MEMBER_NUMBER(float32, mass)
+	NANX_MEMBER_OBJECT(center) // m_wrap_center
+	NANX_MEMBER_NUMBER(float32, I)
+};
+
+//// b2Shape
+
+class WrapShape : public Nan::ObjectWrap
+{
+protected:
+	WrapShape() {}
+	~WrapShape() {}
+public:
+	b2Shape* Peek() { return &GetShape(); }
+	virtual b2Shape& GetShape() = 0;
+	virtual void SyncPull() {}
+	virtual void SyncPush() {}
+public:
+	const b2Shape& UseShape() { SyncPull(); return GetShape(); }
+///private:
+///	static std::map<b2Shape*,WrapShape*> g_wrap_map;
+public:
+	static WrapShape* GetWrap(b2Shape* shape)
 	{
-		WrapPolygonShape* wrap = Unwrap(info.This());
-		v8::Local<v8::Array> h_points = v8::Local<v8::Array>::Cast(info[0]);
-		int count = (info.Length() > 1)?(NANX_int(info[1])):(h_points->Length());
-		int start = (info.Length() > 2)?(NANX_int(info[2])):(0);
-		b2Vec2* points = new b2Vec2[count];
-		for (int i = 0; i < count; ++i)
-		{
-			points[i] = WrapVec2::Unwrap(h_points->Get(start + i).As<v8::Object>())->GetVec2(); // struct copy
-		}
-		wrap->m_polygon.Set(points, count);
-		delete[] points;
-		info.GetReturnValue().Set(info.This());
+		//return static_cast<WrapShape*>(shape->GetUserData());
+///		std::map<b2Shape*,WrapShape*>::iterator it = g_wrap_map.find(shape);
+///		if (it != g_wrap_map.end())
+///		{
+///			return it->second;
+///		}
+		return NULL;
 	}
-	NANX_METHOD(SetAsBox)
+
+	static void SetWrap(b2Shape* shape, WrapShape* wrap)
 	{
-		WrapPolygonShape* wrap = Unwrap(info.This());
-		float32 hw = NANX_float32(info[0]);
-		float32 hh = NANX_float32(info[1]);
-		if (!info[2]->IsUndefined() && !info[3]->IsUndefined())
-		{
-			WrapVec2* center = WrapVec2::Unwrap(v8::Local<v8::Object>::Cast(info[2]));
-			float32 angle = NANX_float32(info[3]);
-			wrap->m_polygon.SetAsBox(hw, hh, center->GetVec2(), angle);
-		}
-		else
+		//shape->SetUserData(wrap);
+///		std::map<b2Shape*,WrapShape*>::iterator it = g_wrap_map.find(shape);
+///		if (it != g_wrap_map.end())
+///		{
+///			if (wrap)
+///			{
+///				it->second = wrap;
+///			}
+///			else
+///			{
+///				g_wrap_map.erase(it);
+///			}
+///		}
+///		else
+///		{
+///			if (wrap)
+///			{
+///				g_wrap_map[shape] = wrap;
+///			}
+///		}
+	}
+public:
+	static WrapShape* Unwrap(v8::Local<v8::Value> value) { return (value->IsObject())?(Unwrap(v8::Local<v8::Object>::Cast(value))):(NULL); }
+	static WrapShape* Unwrap(v8::Local<v8::Object> object) { return Nan::ObjectWrap::Unwrap<WrapShape>(object); }
+	static b2Shape* Peek(v8::Local<v8::Value> value) { WrapShape* wrap = Unwrap(value); return (wrap)?(wrap->Peek()):(NULL); }
+//public:
+//	static NAN_MODULE_INIT(Init)
+//	{
+//		v8::Local<v8::Function> constructor = GetConstructor();
+//		target->Set(constructor->GetName(), constructor);
+//	}
+//	static v8::Local<v8::Object> NewInstance()
+//	{
+//		Nan::EscapableHandleScope scope;
+//		v8::Local<v8::Function> constructor = GetConstructor();
+//		v8::Local<v8::Object> instance = constructor->NewInstance();
+//		return scope.Escape(instance);
+//	}
+//	static v8::Local<v8::Object> NewInstance(const b2Shape& shape)
+//	{
+//		Nan::EscapableHandleScope scope;
+//		v8::Local<v8::Function> constructor = GetConstructor();
+//		v8::Local<v8::Object> instance = constructor->NewInstance();
+//		WrapShape* wrap = Unwrap(instance);
+//		wrap->SetShape(shape);
+//		return scope.Escape(instance);
+//	}
+public:
+//	static v8::Local<v8::Function> GetConstructor()
+//	{
+//		Nan::EscapableHandleScope scope;
+//		v8::Local<v8::FunctionTemplate> function_template = GetFunctionTemplate();
+//		v8::Local<v8::Function> constructor = function_template->GetFunction();
+//		return scope.Escape(constructor);
+//	}
+	static v8::Local<v8::FunctionTemplate> GetFunctionTemplate()
+	{
+		Nan::EscapableHandleScope scope;
+		static Nan::Persistent<v8::FunctionTemplate> g_function_template;
+		if (g_function_template.IsEmpty())
 		{
-			wrap->m_polygon.SetAsBox(hw, hh);
+//			v8::Local<v8::FunctionTemplate> function_template = Nan::New<v8::FunctionTemplate>(New);
+			v8::Local<v8::FunctionTemplate> function_template = Nan::New<v8::FunctionTemplate>();
+			function_template->SetClassName(NANX_SYMBOL("b2Shape"));
+			function_template->InstanceTemplate()->SetInternalFieldCount(1);
+			v8::Local<v8::ObjectTemplate> prototype_template = function_template->PrototypeTemplate();
+			NANX_MEMBER_APPLY(prototype_template, m_type)
+			NANX_MEMBER_APPLY(prototype_template, m_radius)
+			NANX_METHOD_APPLY(prototype_template, GetType)
+			g_function_template.Reset(function_template);
 		}
-		info.GetReturnValue().Set(info.This());
+		v8::Local<v8::FunctionTemplate> function_template = Nan::New<v8::FunctionTemplate>(g_function_template);
+		return scope.Escape(function_template);
 	}
-	NANX_METHOD(ComputeMass)
+private:
+//	static NAN_METHOD(New)
+//	{
+//		if (info.IsConstructCall())
+//		{
+//			WrapShape* wrap = new WrapShape();
+//			wrap->Wrap(info.This());
+//			info.GetReturnValue().Set(info.This());
+//		}
+//		else
+//		{
+//			v8::Local<v8::Function> constructor = GetConstructor();
+//			info.GetReturnValue().Set(constructor->NewInstance());
+//		}
+//	}
+	NANX_MEMBER_INTEGER(b2Shape::Type, m_type)
+	NANX_MEMBER_NUMBER(float32, m_radius)
+	NANX_METHOD(GetType)
 	{
-		b2PolygonShape* polygon = Peek(info.This());
-		b2MassData* mass_data = WrapMassData::Peek(info[0]);
-		float32 density = NANX_float32(info[1]);
-		polygon->ComputeMass(mass_data, density);
+		//b2Shape* that = Peek(info.This());
+		WrapShape* wrap = Unwrap(info.This());
+		//b2Shape* that = &wrap->m_shape;
+		//wrap->SyncPush();
+		//info.GetReturnValue().Set(info.This());
+		info.GetReturnValue().Set(Nan::New(wrap->GetShape().GetType()));
 	}
 };
 
-//// b2ChainShape
+//// b2CircleShape
 
-class WrapChainShape : public WrapShape
+class WrapCircleShape : public WrapShape
 {
 private:
-	b2ChainShape m_chain;
-	Nan::Persistent<v8::Array> m_wrap_m_vertices; // m_chain.m_vertices
-	Nan::Persistent<v8::Object> m_wrap_m_prevVertex; // m_chain.m_prevVertex
-	Nan::Persistent<v8::Object> m_wrap_m_nextVertex; // m_chain.m_nextVertex
+	b2CircleShape m_circle;
+	Nan::Persistent<v8::Object> m_wrap_m_p; // m_circle.m_p
 private:
-	WrapChainShape()
+	WrapCircleShape(float32 radius = 0.0f)
 	{
-		m_wrap_m_prevVertex.Reset(WrapVec2::NewInstance(m_chain.m_prevVertex));
-		m_wrap_m_nextVertex.Reset(WrapVec2::NewInstance(m_chain.m_nextVertex));
+		m_circle.m_radius = radius;
+		m_wrap_m_p.Reset(WrapVec2::NewInstance(m_circle.m_p));
 	}
-	~WrapChainShape()
+	~WrapCircleShape()
 	{
-		m_wrap_m_vertices.Reset();
-		m_wrap_m_prevVertex.Reset();
-		m_wrap_m_nextVertex.Reset();
+		m_wrap_m_p.Reset();
 	}
 public:
-	b2ChainShape* Peek() { return &m_chain; }
-	virtual b2Shape& GetShape() { return m_chain; } // override WrapShape
+	b2CircleShape* Peek() { return &m_circle; }
+	virtual b2Shape& GetShape() { return m_circle; } // override WrapShape
 	virtual void SyncPull() // override WrapShape
 	{
 		// sync: pull data from javascript objects
-		if (!m_wrap_m_vertices.IsEmpty())
-		{
-			v8::Local<v8::Array> vertices = Nan::New<v8::Array>(m_wrap_m_vertices);
-			for (int32 i = 0; i < m_chain.m_count; ++i)
-			{
-				m_chain.m_vertices[i] = WrapVec2::Unwrap(vertices->Get(i).As<v8::Object>())->GetVec2(); // struct copy
-			}
-		}
-		m_chain.m_prevVertex = WrapVec2::Unwrap(Nan::New<v8::Object>(m_wrap_m_prevVertex))->GetVec2(); // struct copy
-		m_chain.m_nextVertex = WrapVec2::Unwrap(Nan::New<v8::Object>(m_wrap_m_nextVertex))->GetVec2(); // struct copy
+		m_circle.m_p = WrapVec2::Unwrap(Nan::New<v8::Object>(m_wrap_m_p))->GetVec2(); // struct copy
 	}
 	virtual void SyncPush() // override WrapShape
 	{
 		// sync: push data into javascript objects
-		if (m_wrap_m_vertices.IsEmpty())
-		{
-			m_wrap_m_vertices.Reset(Nan::New<v8::Array>(m_chain.m_count));
-		}
-		v8::Local<v8::Array> vertices = Nan::New<v8::Array>(m_wrap_m_vertices);
-		for (int32 i = 0; i < m_chain.m_count; ++i)
-		{
-			vertices->Set(i, WrapVec2::NewInstance(m_chain.m_vertices[i]));
-		}
-		WrapVec2::Unwrap(Nan::New<v8::Object>(m_wrap_m_prevVertex))->SetVec2(m_chain.m_prevVertex);
-		WrapVec2::Unwrap(Nan::New<v8::Object>(m_wrap_m_nextVertex))->SetVec2(m_chain.m_nextVertex);
+		WrapVec2::Unwrap(Nan::New<v8::Object>(m_wrap_m_p))->SetVec2(m_circle.m_p);
 	}
 public:
-	static WrapChainShape* Unwrap(v8::Local<v8::Value> value) { return (value->IsObject())?(Unwrap(v8::Local<v8::Object>::Cast(value))):(NULL); }
-	static WrapChainShape* Unwrap(v8::Local<v8::Object> object) { return Nan::ObjectWrap::Unwrap<WrapChainShape>(object); }
-	static b2ChainShape* Peek(v8::Local<v8::Value> value) { WrapChainShape* wrap = Unwrap(value); return (wrap)?(wrap->Peek()):(NULL); }
+	static WrapCircleShape* Unwrap(v8::Local<v8::Value> value) { return (value->IsObject())?(Unwrap(v8::Local<v8::Object>::Cast(value))):(NULL); }
+	static WrapCircleShape* Unwrap(v8::Local<v8::Object> object) { return Nan::ObjectWrap::Unwrap<WrapCircleShape>(object); }
+	static b2CircleShape* Peek(v8::Local<v8::Value> value) { WrapCircleShape* wrap = Unwrap(value); return (wrap)?(wrap->Peek()):(NULL); }
 public:
 	static NAN_MODULE_INIT(Init)
 	{
@@ -1354,6 +3025,25 @@ public:
 		v8::Local<v8::Object> instance = constructor->NewInstance();
 		return scope.Escape(instance);
 	}
+	static v8::Local<v8::Object> NewInstance(const b2CircleShape& circle)
+	{
+		Nan::EscapableHandleScope scope;
+		v8::Local<v8::Function> constructor = GetConstructor();
+		v8::Local<v8::Object> instance = constructor->NewInstance();
+		WrapCircleShape* wrap = Unwrap(instance);
+		wrap->m_circle = circle; // struct copy
+		wrap->SyncPush();
+		return scope.Escape(instance);
+	}
+	static v8::Local<v8::Object> NewInstance(float32 radius)
+	{
+		Nan::EscapableHandleScope scope;
+		v8::Local<v8::Function> constructor = GetConstructor();
+		v8::Local<v8::Object> instance = constructor->NewInstance();
+		WrapCircleShape* wrap = Unwrap(instance);
+		wrap->m_circle.m_radius = radius;
+		return scope.Escape(instance);
+	}
 private:
 	static v8::Local<v8::Function> GetConstructor()
 	{
@@ -1369,19 +3059,11 @@ private:
 		if (g_function_template.IsEmpty())
 		{
 			v8::Local<v8::FunctionTemplate> function_template = Nan::New<v8::FunctionTemplate>(New);
-			function_template->SetClassName(NANX_SYMBOL("b2ChainShape"));
+			function_template->Inherit(WrapShape::GetFunctionTemplate());
+			function_template->SetClassName(NANX_SYMBOL("b2CircleShape"));
 			function_template->InstanceTemplate()->SetInternalFieldCount(1);
 			v8::Local<v8::ObjectTemplate> prototype_template = function_template->PrototypeTemplate();
-			NANX_MEMBER_APPLY(prototype_template, m_vertices)
-			NANX_MEMBER_APPLY(prototype_template, m_count)
-			NANX_MEMBER_APPLY(prototype_template, m_prevVertex)
-			NANX_MEMBER_APPLY(prototype_template, m_nextVertex)
-			NANX_MEMBER_APPLY(prototype_template, m_hasPrevVertex)
-			NANX_MEMBER_APPLY(prototype_template, m_hasNextVertex)
-			NANX_METHOD_APPLY(prototype_template, CreateLoop)
-			NANX_METHOD_APPLY(prototype_template, CreateChain)
-			NANX_METHOD_APPLY(prototype_template, SetPrevVertex)
-			NANX_METHOD_APPLY(prototype_template, SetNextVertex)
+			NANX_MEMBER_APPLY(prototype_template, m_p)
 			NANX_METHOD_APPLY(prototype_template, ComputeMass)
 			g_function_template.Reset(function_template);
 		}
@@ -1393,90 +3075,76 @@ private:
 	{
 		if (info.IsConstructCall())
 		{
-			WrapChainShape* wrap = new WrapChainShape();
+			float32 radius = (info.Length() > 0) ? NANX_float32(info[0]) : 0.0f;
+			WrapCircleShape* wrap = new WrapCircleShape(radius);
 			wrap->Wrap(info.This());
 			info.GetReturnValue().Set(info.This());
 		}
 		else
 		{
 			v8::Local<v8::Function> constructor = GetConstructor();
-			info.GetReturnValue().Set(constructor->NewInstance());
-		}
-	}
-	NANX_MEMBER_ARRAY(m_vertices) // m_wrap_m_vertices
-	NANX_MEMBER_INTEGER(int32, m_count)
-	NANX_MEMBER_OBJECT(m_prevVertex) // m_wrap_m_prevVertex
-	NANX_MEMBER_OBJECT(m_nextVertex) // m_wrap_m_nextVertex
-	NANX_MEMBER_BOOLEAN(bool, m_hasPrevVertex)
-	NANX_MEMBER_BOOLEAN(bool, m_hasNextVertex)
-	NANX_METHOD(CreateLoop)
-	{
-		WrapChainShape* wrap = Unwrap(info.This());
-		v8::Local<v8::Array> h_vertices = v8::Local<v8::Array>::Cast(info[0]);
-		int count = (info.Length() > 1)?(NANX_int(info[1])):(h_vertices->Length());
-		b2Vec2* vertices = new b2Vec2[count];
-		for (int i = 0; i < count; ++i)
-		{
-			vertices[i] = WrapVec2::Unwrap(h_vertices->Get(i).As<v8::Object>())->GetVec2(); // struct copy
-		}
-		wrap->m_chain.CreateLoop(vertices, count);
-		delete[] vertices;
-		wrap->SyncPush();
-		info.GetReturnValue().Set(info.This());
-	}
-	NANX_METHOD(CreateChain)
-	{
-		WrapChainShape* wrap = Unwrap(info.This());
-		v8::Local<v8::Array> h_vertices = v8::Local<v8::Array>::Cast(info[0]);
-		int count = (info.Length() > 1)?(NANX_int(info[1])):(h_vertices->Length());
-		b2Vec2* vertices = new b2Vec2[count];
-		for (int i = 0; i < count; ++i)
-		{
-			vertices[i] = WrapVec2::Unwrap(h_vertices->Get(i).As<v8::Object>())->GetVec2(); // struct copy
+			v8::Local<v8::Value> argv[] = { info[0] };
+			info.GetReturnValue().Set(constructor->NewInstance(countof(argv), argv));
 		}
-		wrap->m_chain.CreateChain(vertices, count);
-		delete[] vertices;
-		wrap->SyncPush();
-		info.GetReturnValue().Set(info.This());
-	}
-	NANX_METHOD(SetPrevVertex)
-	{
-		b2ChainShape* chain = Peek(info.This());
-		b2Vec2* vertex = WrapVec2::Peek(info[0]);
-		chain->SetPrevVertex(*vertex);
-	}
-	NANX_METHOD(SetNextVertex)
-	{
-		b2ChainShape* chain = Peek(info.This());
-		b2Vec2* vertex = WrapVec2::Peek(info[0]);
-		chain->SetNextVertex(*vertex);
 	}
+	NANX_MEMBER_OBJECT(m_p) // m_wrap_m_p
 	NANX_METHOD(ComputeMass)
 	{
-		b2ChainShape* chain = Peek(info.This());
+		b2CircleShape* circle = Peek(info.This());
 		b2MassData* mass_data = WrapMassData::Peek(info[0]);
 		float32 density = NANX_float32(info[1]);
-		chain->ComputeMass(mass_data, density);
+		circle->ComputeMass(mass_data, density);
 	}
 };
 
-//// b2Filter
+//// b2EdgeShape
 
-class WrapFilter : public Nan::ObjectWrap
+class WrapEdgeShape : public WrapShape
 {
-public:
-	b2Filter m_filter;
 private:
-	WrapFilter() {}
-	~WrapFilter() {}
+	b2EdgeShape m_edge;
+	Nan::Persistent<v8::Object> m_wrap_m_vertex1; // m_edge.m_vertex1
+	Nan::Persistent<v8::Object> m_wrap_m_vertex2; // m_edge.m_vertex2
+	Nan::Persistent<v8::Object> m_wrap_m_vertex0; // m_edge.m_vertex0
+	Nan::Persistent<v8::Object> m_wrap_m_vertex3; // m_edge.m_vertex3
+private:
+	WrapEdgeShape()
+	{
+		m_wrap_m_vertex1.Reset(WrapVec2::NewInstance(m_edge.m_vertex1));
+		m_wrap_m_vertex2.Reset(WrapVec2::NewInstance(m_edge.m_vertex2));
+		m_wrap_m_vertex0.Reset(WrapVec2::NewInstance(m_edge.m_vertex0));
+		m_wrap_m_vertex3.Reset(WrapVec2::NewInstance(m_edge.m_vertex3));
+	}
+	~WrapEdgeShape()
+	{
+		m_wrap_m_vertex1.Reset();
+		m_wrap_m_vertex2.Reset();
+		m_wrap_m_vertex0.Reset();
+		m_wrap_m_vertex3.Reset();
+	}
 public:
-	b2Filter* Peek() { return &m_filter; }
-	const b2Filter& GetFilter() const { return m_filter; }
-	void SetFilter(const b2Filter& filter) { m_filter = filter; } // struct copy
+	b2EdgeShape* Peek() { return &m_edge; }
+	virtual b2Shape& GetShape() { return m_edge; } // override WrapShape
+	virtual void SyncPull() // override WrapShape
+	{
+		// sync: pull data from javascript objects
+		m_edge.m_vertex1 = WrapVec2::Unwrap(Nan::New<v8::Object>(m_wrap_m_vertex1))->GetVec2(); // struct copy
+		m_edge.m_vertex2 = WrapVec2::Unwrap(Nan::New<v8::Object>(m_wrap_m_vertex2))->GetVec2(); // struct copy
+		m_edge.m_vertex0 = WrapVec2::Unwrap(Nan::New<v8::Object>(m_wrap_m_vertex0))->GetVec2(); // struct copy
+		m_edge.m_vertex3 = WrapVec2::Unwrap(Nan::New<v8::Object>(m_wrap_m_vertex3))->GetVec2(); // struct copy
+	}
+	virtual void SyncPush() // override WrapShape
+	{
+		// sync: push data into javascript objects
+		WrapVec2::Unwrap(Nan::New<v8::Object>(m_wrap_m_vertex1))->SetVec2(m_edge.m_vertex1);
+		WrapVec2::Unwrap(Nan::New<v8::Object>(m_wrap_m_vertex2))->SetVec2(m_edge.m_vertex2);
+		WrapVec2::Unwrap(Nan::New<v8::Object>(m_wrap_m_vertex0))->SetVec2(m_edge.m_vertex0);
+		WrapVec2::Unwrap(Nan::New<v8::Object>(m_wrap_m_vertex3))->SetVec2(m_edge.m_vertex3);
+	}
 public:
-	static WrapFilter* Unwrap(v8::Local<v8::Value> value) { return (value->IsObject())?(Unwrap(v8::Local<v8::Object>::Cast(value))):(NULL); }
-	static WrapFilter* Unwrap(v8::Local<v8::Object> object) { return Nan::ObjectWrap::Unwrap<WrapFilter>(object); }
-	static b2Filter* Peek(v8::Local<v8::Value> value) { WrapFilter* wrap = Unwrap(value); return (wrap)?(wrap->Peek()):(NULL); }
+	static WrapEdgeShape* Unwrap(v8::Local<v8::Value> value) { return (value->IsObject())?(Unwrap(v8::Local<v8::Object>::Cast(value))):(NULL); }
+	static WrapEdgeShape* Unwrap(v8::Local<v8::Object> object) { return Nan::ObjectWrap::Unwrap<WrapEdgeShape>(object); }
+	static b2EdgeShape* Peek(v8::Local<v8::Value> value) { WrapEdgeShape* wrap = Unwrap(value); return (wrap)?(wrap->Peek()):(NULL); }
 public:
 	static NAN_MODULE_INIT(Init)
 	{
@@ -1490,13 +3158,14 @@ public:
 		v8::Local<v8::Object> instance = constructor->NewInstance();
 		return scope.Escape(instance);
 	}
-	static v8::Local<v8::Object> NewInstance(const b2Filter& o)
+	static v8::Local<v8::Object> NewInstance(const b2EdgeShape& edge)
 	{
 		Nan::EscapableHandleScope scope;
 		v8::Local<v8::Function> constructor = GetConstructor();
 		v8::Local<v8::Object> instance = constructor->NewInstance();
-		WrapFilter* wrap = Unwrap(instance);
-		wrap->SetFilter(o);
+		WrapEdgeShape* wrap = Unwrap(instance);
+		wrap->m_edge = edge; // struct copy
+		wrap->SyncPush();
 		return scope.Escape(instance);
 	}
 private:
@@ -1514,12 +3183,15 @@ private:
 		if (g_function_template.IsEmpty())
 		{
 			v8::Local<v8::FunctionTemplate> function_template = Nan::New<v8::FunctionTemplate>(New);
-			function_template->SetClassName(NANX_SYMBOL("b2Filter"));
+			function_template->SetClassName(NANX_SYMBOL("b2EdgeShape"));
 			function_template->InstanceTemplate()->SetInternalFieldCount(1);
 			v8::Local<v8::ObjectTemplate> prototype_template = function_template->PrototypeTemplate();
-			NANX_MEMBER_APPLY(prototype_template, categoryBits)
-			NANX_MEMBER_APPLY(prototype_template, maskBits)
-			NANX_MEMBER_APPLY(prototype_template, groupIndex)
+			NANX_MEMBER_APPLY(prototype_template, m_vertex1)
+			NANX_MEMBER_APPLY(prototype_template, m_vertex2)
+			NANX_MEMBER_APPLY(prototype_template, m_vertex0)
+			NANX_MEMBER_APPLY(prototype_template, m_vertex3)
+			NANX_METHOD_APPLY(prototype_template, Set)
+			NANX_METHOD_APPLY(prototype_template, ComputeMass)
 			g_function_template.Reset(function_template);
 		}
 		v8::Local<v8::FunctionTemplate> function_template = Nan::New<v8::FunctionTemplate>(g_function_template);
@@ -1528,81 +3200,117 @@ private:
 private:
 	static NAN_METHOD(New)
 	{
-		WrapFilter* wrap = new WrapFilter();
-		wrap->Wrap(info.This());
+		if (info.IsConstructCall())
+		{
+			WrapEdgeShape* wrap = new WrapEdgeShape();
+			wrap->Wrap(info.This());
+			info.GetReturnValue().Set(info.This());
+		}
+		else
+		{
+			v8::Local<v8::Function> constructor = GetConstructor();
+			info.GetReturnValue().Set(constructor->NewInstance());
+		}
+	}
+	NANX_MEMBER_OBJECT(m_vertex1) // m_wrap_m_vertex1
+	NANX_MEMBER_OBJECT(m_vertex2) // m_wrap_m_vertex2
+	NANX_MEMBER_OBJECT(m_vertex0) // m_wrap_m_vertex0
+	NANX_MEMBER_OBJECT(m_vertex3) // m_wrap_m_vertex3
+	NANX_METHOD(Set)
+	{
+		WrapEdgeShape* wrap = Unwrap(info.This());
+		if (info[0]->IsFloat32Array())
+		{
+			// packed [x1,y1,x2,y2] or [x0,y0,x1,y1,x2,y2,x3,y3] with ghost vertices
+			Nan::TypedArrayContents<float32> h_vertices(info[0]);
+			const b2Vec2* vertices = reinterpret_cast<const b2Vec2*>(*h_vertices);
+			if (h_vertices.length() >= 8)
+			{
+				wrap->m_edge.m_vertex0 = vertices[0];
+				wrap->m_edge.Set(vertices[1], vertices[2]);
+				wrap->m_edge.m_vertex3 = vertices[3];
+				wrap->m_edge.m_hasVertex0 = true;
+				wrap->m_edge.m_hasVertex3 = true;
+			}
+			else if (h_vertices.length() >= 4)
+			{
+				wrap->m_edge.Set(vertices[0], vertices[1]);
+			}
+			else
+			{
+				return Nan::ThrowRangeError("edge needs at least 2 vertices");
+			}
+			wrap->SyncPush();
+		}
+		else
+		{
+			wrap->m_wrap_m_vertex1.Reset(v8::Local<v8::Object>::Cast(info[0]));
+			wrap->m_wrap_m_vertex2.Reset(v8::Local<v8::Object>::Cast(info[1]));
+		}
 		info.GetReturnValue().Set(info.This());
 	}
-	NANX_MEMBER_UINT32(uint16, categoryBits)
-	NANX_MEMBER_UINT32(uint16, maskBits)
-	NANX_MEMBER_INT32(int16, groupIndex)
+	NANX_METHOD(ComputeMass)
+	{
+		b2EdgeShape* edge = Peek(info.This());
+		b2MassData* mass_data = WrapMassData::Peek(info[0]);
+		float32 density = NANX_float32(info[1]);
+		edge->ComputeMass(mass_data, density);
+	}
 };
 
-//// b2FixtureDef
+//// b2PolygonShape
 
-class WrapFixtureDef : public Nan::ObjectWrap
+class WrapPolygonShape : public WrapShape
 {
 private:
-	b2FixtureDef m_fd;
-	Nan::Persistent<v8::Object> m_wrap_shape; // m_fd.shape
-	Nan::Persistent<v8::Value> m_wrap_userData; // m_fd.userData
-	Nan::Persistent<v8::Object> m_wrap_filter; // m_fd.filter
+	b2PolygonShape m_polygon;
 private:
-	WrapFixtureDef()
+	WrapPolygonShape()
 	{
-		m_wrap_filter.Reset(WrapFilter::NewInstance());
+		Nan::AdjustExternalMemory(sizeof(WrapPolygonShape));
 	}
-	~WrapFixtureDef()
+	~WrapPolygonShape()
 	{
-		m_wrap_shape.Reset();
-		m_wrap_userData.Reset();
-		m_wrap_filter.Reset();
+		Nan::AdjustExternalMemory(-static_cast<int>(sizeof(WrapPolygonShape)));
 	}
 public:
-	b2FixtureDef* Peek() { SyncPull(); return &m_fd; } // TODO: is SyncPull necessary?
-	b2FixtureDef& GetFixtureDef() { return m_fd; }
-	const b2FixtureDef& UseFixtureDef() { SyncPull(); return GetFixtureDef(); }
-	v8::Local<v8::Object> GetShapeHandle() { return Nan::New<v8::Object>(m_wrap_shape); }
-	v8::Local<v8::Value> GetUserDataHandle() { return Nan::New<v8::Value>(m_wrap_userData); }
-public:
-	void SyncPull()
+	b2PolygonShape* Peek() { return &m_polygon; }
+	virtual b2Shape& GetShape() { return m_polygon; } // override WrapShape
+	virtual void SyncPull() // override WrapShape
 	{
 		// sync: pull data from javascript objects
-		m_fd.filter = WrapFilter::Unwrap(Nan::New<v8::Object>(m_wrap_filter))->GetFilter(); // struct copy
-		if (!m_wrap_shape.IsEmpty())
-		{
-			WrapShape* wrap_shape = WrapShape::Unwrap(Nan::New<v8::Object>(m_wrap_shape));
-			m_fd.shape = &wrap_shape->UseShape();
-		}
-		else
-		{
-			m_fd.shape = NULL;
-		}
-		//m_fd.userData; // not used
 	}
-	void SyncPush()
+	virtual void SyncPush() // override WrapShape
 	{
 		// sync: push data into javascript objects
-		WrapFilter::Unwrap(Nan::New<v8::Object>(m_wrap_filter))->SetFilter(m_fd.filter);
-		if (m_fd.shape)
-		{
-			// TODO: m_wrap_shape.Reset(WrapShape::GetWrap(m_fd.shape)->handle());
-		}
-		else
-		{
-			// TODO: m_wrap_shape.Reset();
-		}
-		//m_fd.userData; // not used
 	}
 public:
-	static WrapFixtureDef* Unwrap(v8::Local<v8::Value> value) { return (value->IsObject())?(Unwrap(v8::Local<v8::Object>::Cast(value))):(NULL); }
-	static WrapFixtureDef* Unwrap(v8::Local<v8::Object> object) { return Nan::ObjectWrap::Unwrap<WrapFixtureDef>(object); }
-	static b2FixtureDef* Peek(v8::Local<v8::Value> value) { WrapFixtureDef* wrap = Unwrap(value); return (wrap)?(wrap->Peek()):(NULL); }
+	static WrapPolygonShape* Unwrap(v8::Local<v8::Value> value) { return (value->IsObject())?(Unwrap(v8::Local<v8::Object>::Cast(value))):(NULL); }
+	static WrapPolygonShape* Unwrap(v8::Local<v8::Object> object) { return Nan::ObjectWrap::Unwrap<WrapPolygonShape>(object); }
+	static b2PolygonShape* Peek(v8::Local<v8::Value> value) { WrapPolygonShape* wrap = Unwrap(value); return (wrap)?(wrap->Peek()):(NULL); }
 public:
 	static NAN_MODULE_INIT(Init)
 	{
 		v8::Local<v8::Function> constructor = GetConstructor();
 		target->Set(constructor->GetName(), constructor);
 	}
+	static v8::Local<v8::Object> NewInstance()
+	{
+		Nan::EscapableHandleScope scope;
+		v8::Local<v8::Function> constructor = GetConstructor();
+		v8::Local<v8::Object> instance = constructor->NewInstance();
+		return scope.Escape(instance);
+	}
+	static v8::Local<v8::Object> NewInstance(const b2PolygonShape& polygon)
+	{
+		Nan::EscapableHandleScope scope;
+		v8::Local<v8::Function> constructor = GetConstructor();
+		v8::Local<v8::Object> instance = constructor->NewInstance();
+		WrapPolygonShape* wrap = Unwrap(instance);
+		wrap->m_polygon = polygon; // struct copy
+		wrap->SyncPush();
+		return scope.Escape(instance);
+	}
 private:
 	static v8::Local<v8::Function> GetConstructor()
 	{
@@ -1618,16 +3326,12 @@ private:
 		if (g_function_template.IsEmpty())
 		{
 			v8::Local<v8::FunctionTemplate> function_template = Nan::New<v8::FunctionTemplate>(New);
-			function_template->SetClassName(NANX_SYMBOL("b2FixtureDef"));
+			function_template->SetClassName(NANX_SYMBOL("b2PolygonShape"));
 			function_template->InstanceTemplate()->SetInternalFieldCount(1);
 			v8::Local<v8::ObjectTemplate> prototype_template = function_template->PrototypeTemplate();
-			NANX_MEMBER_APPLY(prototype_template, shape)
-			NANX_MEMBER_APPLY(prototype_template, userData)
-			NANX_MEMBER_APPLY(prototype_template, friction)
-			NANX_MEMBER_APPLY(prototype_template, restitution)
-			NANX_MEMBER_APPLY(prototype_template, density)
-			NANX_MEMBER_APPLY(prototype_template, isSensor)
-			NANX_MEMBER_APPLY(prototype_template, filter)
+			NANX_METHOD_APPLY(prototype_template, Set)
+			NANX_METHOD_APPLY(prototype_template, SetAsBox)
+			NANX_METHOD_APPLY(prototype_template, ComputeMass)
 			g_function_template.Reset(function_template);
 		}
 		v8::Local<v8::FunctionTemplate> function_template = Nan::New<v8::FunctionTemplate>(g_function_template);
@@ -1638,7 +3342,7 @@ private:
 	{
 		if (info.IsConstructCall())
 		{
-			WrapFixtureDef* wrap = new WrapFixtureDef();
+			WrapPolygonShape* wrap = new WrapPolygonShape();
 			wrap->Wrap(info.This());
 			info.GetReturnValue().Set(info.This());
 		}
@@ -1648,80 +3352,121 @@ private:
 			info.GetReturnValue().Set(constructor->NewInstance());
 		}
 	}
-	NANX_MEMBER_OBJECT	(shape) // m_wrap_shape
-	NANX_MEMBER_VALUE	(userData) // m_wrap_userData
-	NANX_MEMBER_NUMBER	(float32, friction)
-	NANX_MEMBER_NUMBER	(float32, restitution)
-	NANX_MEMBER_NUMBER	(float32, density)
-	NANX_MEMBER_BOOLEAN	(bool, isSensor)
-	NANX_MEMBER_OBJECT	(filter) // m_wrap_filter
+	NANX_METHOD(Set)
+	{
+		WrapPolygonShape* wrap = Unwrap(info.This());
+		v8::Local<v8::Array> h_points = v8::Local<v8::Array>::Cast(info[0]);
+		int count = (info.Length() > 1)?(NANX_int(info[1])):(h_points->Length());
+		int start = (info.Length() > 2)?(NANX_int(info[2])):(0);
+		b2Vec2* points = new b2Vec2[count];
+		for (int i = 0; i < count; ++i)
+		{
+			points[i] = WrapVec2::Unwrap(h_points->Get(start + i).As<v8::Object>())->GetVec2(); // struct copy
+		}
+		wrap->m_polygon.Set(points, count);
+		delete[] points;
+		info.GetReturnValue().Set(info.This());
+	}
+	NANX_METHOD(SetAsBox)
+	{
+		WrapPolygonShape* wrap = Unwrap(info.This());
+		float32 hw = NANX_float32(info[0]);
+		float32 hh = NANX_float32(info[1]);
+		if (!info[2]->IsUndefined() && !info[3]->IsUndefined())
+		{
+			WrapVec2* center = WrapVec2::Unwrap(v8::Local<v8::Object>::Cast(info[2]));
+			float32 angle = NANX_float32(info[3]);
+			wrap->m_polygon.SetAsBox(hw, hh, center->GetVec2(), angle);
+		}
+		else
+		{
+			wrap->m_polygon.SetAsBox(hw, hh);
+		}
+		info.GetReturnValue().Set(info.This());
+	}
+	NANX_METHOD(ComputeMass)
+	{
+		b2PolygonShape* polygon = Peek(info.This());
+		b2MassData* mass_data = WrapMassData::Peek(info[0]);
+		float32 density = NANX_float32(info[1]);
+		polygon->ComputeMass(mass_data, density);
+	}
 };
 
-//// b2Fixture
+//// b2ChainShape
 
-class WrapFixture : public Nan::ObjectWrap
+class WrapChainShape : public WrapShape
 {
 private:
-	b2Fixture* m_fixture;
-	Nan::Persistent<v8::Object> m_fixture_body;
-	Nan::Persistent<v8::Object> m_fixture_shape;
-	Nan::Persistent<v8::Value> m_fixture_userData;
+	b2ChainShape m_chain;
+	int32 m_external_bytes; // vertex bytes reported to v8
+	Nan::Persistent<v8::Array> m_wrap_m_vertices; // m_chain.m_vertices
+	Nan::Persistent<v8::Object> m_wrap_m_prevVertex; // m_chain.m_prevVertex
+	Nan::Persistent<v8::Object> m_wrap_m_nextVertex; // m_chain.m_nextVertex
 private:
-	WrapFixture() : m_fixture(NULL)
+	WrapChainShape() : m_external_bytes(0)
 	{
+		m_wrap_m_prevVertex.Reset(WrapVec2::NewInstance(m_chain.m_prevVertex));
+		m_wrap_m_nextVertex.Reset(WrapVec2::NewInstance(m_chain.m_nextVertex));
 	}
-	~WrapFixture()
+	~WrapChainShape()
 	{
-		m_fixture_body.Reset();
-		m_fixture_shape.Reset();
-		m_fixture_userData.Reset();
+		m_wrap_m_vertices.Reset();
+		m_wrap_m_prevVertex.Reset();
+		m_wrap_m_nextVertex.Reset();
+		Nan::AdjustExternalMemory(-m_external_bytes);
 	}
 public:
-	b2Fixture* Peek() { return m_fixture; }
-public:
-	void SetupObject(v8::Local<v8::Object> h_body, WrapFixtureDef* wrap_fd, b2Fixture* fixture)
+	b2ChainShape* Peek() { return &m_chain; }
+	virtual b2Shape& GetShape() { return m_chain; } // override WrapShape
+	virtual void SyncPull() // override WrapShape
 	{
-		m_fixture = fixture;
-		// set fixture internal data
-		WrapFixture::SetWrap(m_fixture, this);
-		// set reference to this fixture (prevent GC)
-		Ref();
-		// set reference to body object
-		m_fixture_body.Reset(h_body);
-		// set reference to shape object
-		m_fixture_shape.Reset(wrap_fd->GetShapeHandle());
-		// set reference to user data object
-		m_fixture_userData.Reset(wrap_fd->GetUserDataHandle());
+		// sync: pull data from javascript objects
+		if (!m_wrap_m_vertices.IsEmpty())
+		{
+			v8::Local<v8::Array> vertices = Nan::New<v8::Array>(m_wrap_m_vertices);
+			for (int32 i = 0; i < m_chain.m_count; ++i)
+			{
+				m_chain.m_vertices[i] = WrapVec2::Unwrap(vertices->Get(i).As<v8::Object>())->GetVec2(); // struct copy
+			}
+		}
+		m_chain.m_prevVertex = WrapVec2::Unwrap(Nan::New<v8::Object>(m_wrap_m_prevVertex))->GetVec2(); // struct copy
+		m_chain.m_nextVertex = WrapVec2::Unwrap(Nan::New<v8::Object>(m_wrap_m_nextVertex))->GetVec2(); // struct copy
 	}
-	b2Fixture* ResetObject()
+	virtual void SyncPush() // override WrapShape
 	{
-		// clear reference to body object
-		m_fixture_body.Reset();
-		// clear reference to shape object
-		m_fixture_shape.Reset();
-		// clear reference to user data object
-		m_fixture_userData.Reset();
-		// clear reference to this fixture (allow GC)
-		Unref();
-		// clear fixture internal data
-		WrapFixture::SetWrap(m_fixture, NULL);
-		b2Fixture* fixture = m_fixture;
-		m_fixture = NULL;
-		return fixture;
+		// sync: push data into javascript objects
+		// the vertex array is only mirrored once it has been asked for (see m_vertices getter)
+		if (!m_wrap_m_vertices.IsEmpty())
+		{
+			PushVertices();
+		}
+		WrapVec2::Unwrap(Nan::New<v8::Object>(m_wrap_m_prevVertex))->SetVec2(m_chain.m_prevVertex);
+		WrapVec2::Unwrap(Nan::New<v8::Object>(m_wrap_m_nextVertex))->SetVec2(m_chain.m_nextVertex);
 	}
-public:
-	static WrapFixture* GetWrap(const b2Fixture* fixture)
+	void PushVertices()
 	{
-		return static_cast<WrapFixture*>(fixture->GetUserData());
+		v8::Local<v8::Array> vertices = Nan::New<v8::Array>(m_chain.m_count);
+		for (int32 i = 0; i < m_chain.m_count; ++i)
+		{
+			vertices->Set(i, WrapVec2::NewInstance(m_chain.m_vertices[i]));
+		}
+		m_wrap_m_vertices.Reset(vertices);
 	}
-	static void SetWrap(b2Fixture* fixture, WrapFixture* wrap)
+	void ReportExternalMemory()
 	{
-		fixture->SetUserData(wrap);
+		// the vertices live outside the javascript heap
+		int32 bytes = m_chain.m_count * static_cast<int32>(sizeof(b2Vec2));
+		if (bytes != m_external_bytes)
+		{
+			Nan::AdjustExternalMemory(bytes - m_external_bytes);
+			m_external_bytes = bytes;
+		}
 	}
 public:
-	static WrapFixture* Unwrap(v8::Local<v8::Value> value) { return (value->IsObject())?(Unwrap(v8::Local<v8::Object>::Cast(value))):(NULL); }
-	static WrapFixture* Unwrap(v8::Local<v8::Object> object) { return Nan::ObjectWrap::Unwrap<WrapFixture>(object); }
-	static b2Fixture* Peek(v8::Local<v8::Value> value) { WrapFixture* wrap = Unwrap(value); return (wrap)?(wrap->Peek()):(NULL); }
+	static WrapChainShape* Unwrap(v8::Local<v8::Value> value) { return (value->IsObject())?(Unwrap(v8::Local<v8::Object>::Cast(value))):(NULL); }
+	static WrapChainShape* Unwrap(v8::Local<v8::Object> object) { return Nan::ObjectWrap::Unwrap<WrapChainShape>(object); }
+	static b2ChainShape* Peek(v8::Local<v8::Value> value) { WrapChainShape* wrap = Unwrap(value); return (wrap)?(wrap->Peek()):(NULL); }
 public:
 	static NAN_MODULE_INIT(Init)
 	{
@@ -1735,6 +3480,22 @@ public:
 		v8::Local<v8::Object> instance = constructor->NewInstance();
 		return scope.Escape(instance);
 	}
+	static v8::Local<v8::Object> NewInstance(const b2ChainShape& chain)
+	{
+		Nan::EscapableHandleScope scope;
+		v8::Local<v8::Function> constructor = GetConstructor();
+		v8::Local<v8::Object> instance = constructor->NewInstance();
+		WrapChainShape* wrap = Unwrap(instance);
+		// b2ChainShape owns its vertices; copy them
+		wrap->m_chain.CreateChain(chain.m_vertices, chain.m_count);
+		wrap->m_chain.m_prevVertex = chain.m_prevVertex;
+		wrap->m_chain.m_nextVertex = chain.m_nextVertex;
+		wrap->m_chain.m_hasPrevVertex = chain.m_hasPrevVertex;
+		wrap->m_chain.m_hasNextVertex = chain.m_hasNextVertex;
+		wrap->ReportExternalMemory();
+		wrap->SyncPush();
+		return scope.Escape(instance);
+	}
 private:
 	static v8::Local<v8::Function> GetConstructor()
 	{
@@ -1750,28 +3511,21 @@ private:
 		if (g_function_template.IsEmpty())
 		{
 			v8::Local<v8::FunctionTemplate> function_template = Nan::New<v8::FunctionTemplate>(New);
-			function_template->SetClassName(NANX_SYMBOL("b2Fixture"));
+			function_template->SetClassName(NANX_SYMBOL("b2ChainShape"));
 			function_template->InstanceTemplate()->SetInternalFieldCount(1);
 			v8::Local<v8::ObjectTemplate> prototype_template = function_template->PrototypeTemplate();
-			NANX_METHOD_APPLY(prototype_template, GetType)
-			NANX_METHOD_APPLY(prototype_template, GetShape)
-			NANX_METHOD_APPLY(prototype_template, SetSensor)
-			NANX_METHOD_APPLY(prototype_template, IsSensor)
-			NANX_METHOD_APPLY(prototype_template, SetFilterData)
-			NANX_METHOD_APPLY(prototype_template, GetFilterData)
-			NANX_METHOD_APPLY(prototype_template, Refilter)
-			NANX_METHOD_APPLY(prototype_template, GetBody)
-			NANX_METHOD_APPLY(prototype_template, GetNext)
-			NANX_METHOD_APPLY(prototype_template, GetUserData)
-			NANX_METHOD_APPLY(prototype_template, SetUserData)
-			NANX_METHOD_APPLY(prototype_template, TestPoint)
-			NANX_METHOD_APPLY(prototype_template, GetDensity)
-			NANX_METHOD_APPLY(prototype_template, SetDensity)
-			NANX_METHOD_APPLY(prototype_template, GetFriction)
-			NANX_METHOD_APPLY(prototype_template, SetFriction)
-			NANX_METHOD_APPLY(prototype_template, GetRestitution)
-			NANX_METHOD_APPLY(prototype_template, SetRestitution)
-			NANX_METHOD_APPLY(prototype_template, GetAABB)
+			NANX_MEMBER_APPLY(prototype_template, m_vertices)
+			NANX_MEMBER_APPLY(prototype_template, m_count)
+			NANX_MEMBER_APPLY(prototype_template, m_prevVertex)
+			NANX_MEMBER_APPLY(prototype_template, m_nextVertex)
+			NANX_MEMBER_APPLY(prototype_template, m_hasPrevVertex)
+			NANX_MEMBER_APPLY(prototype_template, m_hasNextVertex)
+			NANX_METHOD_APPLY(prototype_template, CreateLoop)
+			NANX_METHOD_APPLY(prototype_template, CreateChain)
+			NANX_METHOD_APPLY(prototype_template, SetPrevVertex)
+			NANX_METHOD_APPLY(prototype_template, SetNextVertex)
+			NANX_METHOD_APPLY(prototype_template, GetVertices)
+			NANX_METHOD_APPLY(prototype_template, ComputeMass)
 			g_function_template.Reset(function_template);
 		}
 		v8::Local<v8::FunctionTemplate> function_template = Nan::New<v8::FunctionTemplate>(g_function_template);
@@ -1782,7 +3536,7 @@ private:
 	{
 		if (info.IsConstructCall())
 		{
-			WrapFixture* wrap = new WrapFixture();
+			WrapChainShape* wrap = new WrapChainShape();
 			wrap->Wrap(info.This());
 			info.GetReturnValue().Set(info.This());
 		}
@@ -1792,178 +3546,273 @@ private:
 			info.GetReturnValue().Set(constructor->NewInstance());
 		}
 	}
-	NANX_METHOD(GetType)
-	{
-		WrapFixture* wrap = Unwrap(info.This());
-		info.GetReturnValue().Set(Nan::New(wrap->m_fixture->GetType()));
-	}
-	NANX_METHOD(GetShape)
-	{
-		WrapFixture* wrap = Unwrap(info.This());
-		info.GetReturnValue().Set(Nan::New(wrap->m_fixture_shape));
-	}
-	NANX_METHOD(SetSensor)
+	static NAN_GETTER(_get_m_vertices)
 	{
-		WrapFixture* wrap = Unwrap(info.This());
-		wrap->m_fixture->SetSensor(NANX_bool(info[0]));
+		WrapChainShape* wrap = Unwrap(info.This());
+		// build the javascript vertex array on first use
+		if (wrap->m_wrap_m_vertices.IsEmpty())
+		{
+			wrap->PushVertices();
+		}
+		info.GetReturnValue().Set(Nan::New<v8::Array>(wrap->m_wrap_m_vertices));
 	}
-	NANX_METHOD(IsSensor)
+	NANX_MEMBER_ARRAY_SET(m_vertices) // m_wrap_m_vertices
+	NANX_MEMBER_INTEGER(int32, m_count)
+	NANX_MEMBER_OBJECT(m_prevVertex) // m_wrap_m_prevVertex
+	NANX_MEMBER_OBJECT(m_nextVertex) // m_wrap_m_nextVertex
+	NANX_MEMBER_BOOLEAN(bool, m_hasPrevVertex)
+	NANX_MEMBER_BOOLEAN(bool, m_hasNextVertex)
+	NANX_METHOD(CreateLoop)
 	{
-		WrapFixture* wrap = Unwrap(info.This());
-		info.GetReturnValue().Set(Nan::New(wrap->m_fixture->IsSensor()));
+		WrapChainShape* wrap = Unwrap(info.This());
+		// drop the mirrored vertex array; it is rebuilt on demand
+		wrap->m_wrap_m_vertices.Reset();
+		if (info[0]->IsFloat32Array())
+		{
+			// packed x,y pairs; b2Vec2 is two float32s so the data is used in place
+			Nan::TypedArrayContents<float32> h_vertices(info[0]);
+			int length = static_cast<int>(h_vertices.length() / 2);
+			int count = (info.Length() > 1 && !info[1]->IsUndefined())?(b2Min(NANX_int(info[1]), length)):(length);
+			if (count < 3)
+			{
+				return Nan::ThrowRangeError("loop needs at least 3 vertices");
+			}
+			wrap->m_chain.CreateLoop(reinterpret_cast<const b2Vec2*>(*h_vertices), count);
+		}
+		else
+		{
+			v8::Local<v8::Array> h_vertices = v8::Local<v8::Array>::Cast(info[0]);
+			int length = static_cast<int>(h_vertices->Length());
+			int count = (info.Length() > 1)?(b2Min(NANX_int(info[1]), length)):(length);
+			if (count < 3)
+			{
+				return Nan::ThrowRangeError("loop needs at least 3 vertices");
+			}
+			b2Vec2* vertices = new b2Vec2[count];
+			for (int i = 0; i < count; ++i)
+			{
+				vertices[i] = WrapVec2::Unwrap(h_vertices->Get(i).As<v8::Object>())->GetVec2(); // struct copy
+			}
+			wrap->m_chain.CreateLoop(vertices, count);
+			delete[] vertices;
+		}
+		wrap->ReportExternalMemory();
+		wrap->SyncPush();
+		info.GetReturnValue().Set(info.This());
 	}
-	NANX_METHOD(SetFilterData)
+	NANX_METHOD(CreateChain)
 	{
-		WrapFixture* wrap = Unwrap(info.This());
-		WrapFilter* wrap_filter = WrapFilter::Unwrap(v8::Local<v8::Object>::Cast(info[0]));
-		wrap->m_fixture->SetFilterData(wrap_filter->GetFilter());
-	}
-	NANX_METHOD(GetFilterData)
-	{
-		WrapFixture* wrap = Unwrap(info.This());
-		info.GetReturnValue().Set(WrapFilter::NewInstance(wrap->m_fixture->GetFilterData()));
-	}
-	NANX_METHOD(Refilter)
-	{
-		WrapFixture* wrap = Unwrap(info.This());
-		wrap->m_fixture->Refilter();
-	}
-	NANX_METHOD(GetBody)
-	{
-		WrapFixture* wrap = Unwrap(info.This());
-		info.GetReturnValue().Set(Nan::New(wrap->m_fixture_body));
-	}
-	NANX_METHOD(GetNext)
-	{
-		WrapFixture* wrap = Unwrap(info.This());
-		b2Fixture* fixture = wrap->m_fixture->GetNext();
-		if (fixture)
-		{
-			// get fixture internal data
-			WrapFixture* wrap_fixture = WrapFixture::GetWrap(fixture);
-			info.GetReturnValue().Set(wrap_fixture->handle());
+		WrapChainShape* wrap = Unwrap(info.This());
+		// drop the mirrored vertex array; it is rebuilt on demand
+		wrap->m_wrap_m_vertices.Reset();
+		if (info[0]->IsFloat32Array())
+		{
+			// packed x,y pairs; b2Vec2 is two float32s so the data is used in place
+			Nan::TypedArrayContents<float32> h_vertices(info[0]);
+			int length = static_cast<int>(h_vertices.length() / 2);
+			int count = (info.Length() > 1 && !info[1]->IsUndefined())?(b2Min(NANX_int(info[1]), length)):(length);
+			if (count < 2)
+			{
+				return Nan::ThrowRangeError("chain needs at least 2 vertices");
+			}
+			wrap->m_chain.CreateChain(reinterpret_cast<const b2Vec2*>(*h_vertices), count);
 		}
 		else
 		{
-			info.GetReturnValue().SetNull();
-		}
+			v8::Local<v8::Array> h_vertices = v8::Local<v8::Array>::Cast(info[0]);
+			int length = static_cast<int>(h_vertices->Length());
+			int count = (info.Length() > 1)?(b2Min(NANX_int(info[1]), length)):(length);
+			if (count < 2)
+			{
+				return Nan::ThrowRangeError("chain needs at least 2 vertices");
+			}
+			b2Vec2* vertices = new b2Vec2[count];
+			for (int i = 0; i < count; ++i)
+			{
+				vertices[i] = WrapVec2::Unwrap(h_vertices->Get(i).As<v8::Object>())->GetVec2(); // struct copy
+			}
+			wrap->m_chain.CreateChain(vertices, count);
+			delete[] vertices;
+		}
+		// optional ghost vertices
+		b2Vec2* prev_vertex = WrapVec2::Peek(info[2]);
+		if (prev_vertex) { wrap->m_chain.SetPrevVertex(*prev_vertex); }
+		b2Vec2* next_vertex = WrapVec2::Peek(info[3]);
+		if (next_vertex) { wrap->m_chain.SetNextVertex(*next_vertex); }
+		wrap->ReportExternalMemory();
+		wrap->SyncPush();
+		info.GetReturnValue().Set(info.This());
 	}
-	NANX_METHOD(GetUserData)
+	NANX_METHOD(SetPrevVertex)
 	{
-		WrapFixture* wrap = Unwrap(info.This());
-		if (!wrap->m_fixture_userData.IsEmpty())
-		{
-			info.GetReturnValue().Set(Nan::New<v8::Value>(wrap->m_fixture_userData));
-		}
-		else
-		{
-			info.GetReturnValue().SetNull();
-		}
+		b2ChainShape* chain = Peek(info.This());
+		b2Vec2* vertex = WrapVec2::Peek(info[0]);
+		chain->SetPrevVertex(*vertex);
 	}
-	NANX_METHOD(SetUserData)
+	NANX_METHOD(SetNextVertex)
 	{
-		WrapFixture* wrap = Unwrap(info.This());
-		if (!info[0]->IsNull())
-		{
-			wrap->m_fixture_userData.Reset(info[0]);
-		}
-		else
-		{
-			wrap->m_fixture_userData.Reset();
-		}
+		b2ChainShape* chain = Peek(info.This());
+		b2Vec2* vertex = WrapVec2::Peek(info[0]);
+		chain->SetNextVertex(*vertex);
 	}
-	NANX_METHOD(TestPoint)
+	NANX_METHOD(GetVertices)
 	{
-		WrapFixture* wrap = Unwrap(info.This());
-		WrapVec2* p = WrapVec2::Unwrap(v8::Local<v8::Object>::Cast(info[0]));
-		info.GetReturnValue().Set(Nan::New(wrap->m_fixture->TestPoint(p->GetVec2())));
+		// copy packed x,y pairs into a Float32Array, return vertex count
+		b2ChainShape* chain = Peek(info.This());
+		Nan::TypedArrayContents<float32> out(info[0]);
+		int32 count = b2Min(chain->m_count, static_cast<int32>(out.length() / 2));
+		if (count > 0)
+		{
+			memcpy(*out, chain->m_vertices, count * sizeof(b2Vec2));
+		}
+		info.GetReturnValue().Set(Nan::New(count));
 	}
-	//bool RayCast(b2RayCastOutput* output, const b2RayCastInput& input, int32 childIndex) const;
-	//void GetMassData(b2MassData* massData) const;
-	NANX_METHOD(GetDensity)
+	NANX_METHOD(ComputeMass)
 	{
-		WrapFixture* wrap = Unwrap(info.This());
-		info.GetReturnValue().Set(Nan::New(wrap->m_fixture->GetDensity()));
+		b2ChainShape* chain = Peek(info.This());
+		b2MassData* mass_data = WrapMassData::Peek(info[0]);
+		float32 density = NANX_float32(info[1]);
+		chain->ComputeMass(mass_data, density);
 	}
-	NANX_METHOD(SetDensity)
+};
+
+//// b2Filter
+
+class WrapFilter : public Nan::ObjectWrap
+{
+public:
+	b2Filter m_filter;
+private:
+	WrapFilter() {}
+	~WrapFilter() {}
+public:
+	b2Filter* Peek() { return &m_filter; }
+	const b2Filter& GetFilter() const { return m_filter; }
+	void SetFilter(const b2Filter& filter) { m_filter = filter; } // struct copy
+public:
+	static WrapFilter* Unwrap(v8::Local<v8::Value> value) { return (value->IsObject())?(Unwrap(v8::Local<v8::Object>::Cast(value))):(NULL); }
+	static WrapFilter* Unwrap(v8::Local<v8::Object> object) { return Nan::ObjectWrap::Unwrap<WrapFilter>(object); }
+	static b2Filter* Peek(v8::Local<v8::Value> value) { WrapFilter* wrap = Unwrap(value); return (wrap)?(wrap->Peek()):(NULL); }
+public:
+	static NAN_MODULE_INIT(Init)
 	{
-		WrapFixture* wrap = Unwrap(info.This());
-		wrap->m_fixture->SetDensity(NANX_float32(info[0]));
+		v8::Local<v8::Function> constructor = GetConstructor();
+		target->Set(constructor->GetName(), constructor);
 	}
-	NANX_METHOD(GetFriction)
+	static v8::Local<v8::Object> NewInstance()
 	{
-		WrapFixture* wrap = Unwrap(info.This());
-		info.GetReturnValue().Set(Nan::New(wrap->m_fixture->GetFriction()));
+		Nan::EscapableHandleScope scope;
+		v8::Local<v8::Function> constructor = GetConstructor();
+		v8::Local<v8::Object> instance = constructor->NewInstance();
+		return scope.Escape(instance);
 	}
-	NANX_METHOD(SetFriction)
+	static v8::Local<v8::Object> NewInstance(const b2Filter& o)
 	{
-		WrapFixture* wrap = Unwrap(info.This());
-		wrap->m_fixture->SetFriction(NANX_float32(info[0]));
+		Nan::EscapableHandleScope scope;
+		v8::Local<v8::Function> constructor = GetConstructor();
+		v8::Local<v8::Object> instance = constructor->NewInstance();
+		WrapFilter* wrap = Unwrap(instance);
+		wrap->SetFilter(o);
+		return scope.Escape(instance);
 	}
-	NANX_METHOD(GetRestitution)
+private:
+	static v8::Local<v8::Function> GetConstructor()
 	{
-		WrapFixture* wrap = Unwrap(info.This());
-		info.GetReturnValue().Set(Nan::New(wrap->m_fixture->GetRestitution()));
+		Nan::EscapableHandleScope scope;
+		v8::Local<v8::FunctionTemplate> function_template = GetFunctionTemplate();
+		v8::Local<v8::Function> constructor = function_template->GetFunction();
+		return scope.Escape(constructor);
 	}
-	NANX_METHOD(SetRestitution)
+	static v8::Local<v8::FunctionTemplate> GetFunctionTemplate()
 	{
-		WrapFixture* wrap = Unwrap(info.This());
-		wrap->m_fixture->SetRestitution(NANX_float32(info[0]));
+		Nan::EscapableHandleScope scope;
+		static Nan::Persistent<v8::FunctionTemplate> g_function_template;
+		if (g_function_template.IsEmpty())
+		{
+			v8::Local<v8::FunctionTemplate> function_template = Nan::New<v8::FunctionTemplate>(New);
+			function_template->SetClassName(NANX_SYMBOL("b2Filter"));
+			function_template->InstanceTemplate()->SetInternalFieldCount(1);
+			v8::Local<v8::ObjectTemplate> prototype_template = function_template->PrototypeTemplate();
+			NANX_MEMBER_APPLY(prototype_template, categoryBits)
+			NANX_MEMBER_APPLY(prototype_template, maskBits)
+			NANX_MEMBER_APPLY(prototype_template, groupIndex)
+			g_function_template.Reset(function_template);
+		}
+		v8::Local<v8::FunctionTemplate> function_template = Nan::New<v8::FunctionTemplate>(g_function_template);
+		return scope.Escape(function_template);
 	}
-	NANX_METHOD(GetAABB)
+private:
+	static NAN_METHOD(New)
 	{
-		WrapFixture* wrap = Unwrap(info.This());
-		int32 childIndex = NANX_int32(info[0]);
-		info.GetReturnValue().Set(WrapAABB::NewInstance(wrap->m_fixture->GetAABB(childIndex)));
+		WrapFilter* wrap = new WrapFilter();
+		wrap->Wrap(info.This());
+		info.GetReturnValue().Set(info.This());
 	}
-	///	void Dump(int32 bodyIndex);
+	NANX_MEMBER_UINT32(uint16, categoryBits)
+	NANX_MEMBER_UINT32(uint16, maskBits)
+	NANX_MEMBER_INT32(int16, groupIndex)
 };
 
-//// b2BodyDef
+//// b2FixtureDef
 
-class WrapBodyDef : public Nan::ObjectWrap
+class WrapFixtureDef : public Nan::ObjectWrap
 {
 private:
-	b2BodyDef m_bd;
-	Nan::Persistent<v8::Object> m_wrap_position; // m_bd.position
-	Nan::Persistent<v8::Object> m_wrap_linearVelocity; // m_bd.linearVelocity
-	Nan::Persistent<v8::Value> m_wrap_userData; // m_bd.userData
+	b2FixtureDef m_fd;
+	Nan::Persistent<v8::Object> m_wrap_shape; // m_fd.shape
+	Nan::Persistent<v8::Value> m_wrap_userData; // m_fd.userData
+	Nan::Persistent<v8::Object> m_wrap_filter; // m_fd.filter
 private:
-	WrapBodyDef()
+	WrapFixtureDef()
 	{
-		m_wrap_position.Reset(WrapVec2::NewInstance(m_bd.position));
-		m_wrap_linearVelocity.Reset(WrapVec2::NewInstance(m_bd.linearVelocity));
+		m_wrap_filter.Reset(WrapFilter::NewInstance());
 	}
-	~WrapBodyDef()
+	~WrapFixtureDef()
 	{
-		m_wrap_position.Reset();
-		m_wrap_linearVelocity.Reset();
+		m_wrap_shape.Reset();
 		m_wrap_userData.Reset();
+		m_wrap_filter.Reset();
 	}
 public:
-	b2BodyDef* Peek() { SyncPull(); return &m_bd; } // TODO: is SyncPull necessary
-	b2BodyDef& GetBodyDef() { return m_bd; }
-	const b2BodyDef& UseBodyDef() { SyncPull(); return GetBodyDef(); }
+	b2FixtureDef* Peek() { SyncPull(); return &m_fd; } // TODO: is SyncPull necessary?
+	b2FixtureDef& GetFixtureDef() { return m_fd; }
+	const b2FixtureDef& UseFixtureDef() { SyncPull(); return GetFixtureDef(); }
+	v8::Local<v8::Object> GetShapeHandle() { return Nan::New<v8::Object>(m_wrap_shape); }
 	v8::Local<v8::Value> GetUserDataHandle() { return Nan::New<v8::Value>(m_wrap_userData); }
 public:
 	void SyncPull()
 	{
 		// sync: pull data from javascript objects
-		m_bd.position = WrapVec2::Unwrap(Nan::New<v8::Object>(m_wrap_position))->GetVec2(); // struct copy
-		m_bd.linearVelocity = WrapVec2::Unwrap(Nan::New<v8::Object>(m_wrap_linearVelocity))->GetVec2(); // struct copy
-		//m_bd.userData; // not used
+		m_fd.filter = WrapFilter::Unwrap(Nan::New<v8::Object>(m_wrap_filter))->GetFilter(); // struct copy
+		if (!m_wrap_shape.IsEmpty())
+		{
+			WrapShape* wrap_shape = WrapShape::Unwrap(Nan::New<v8::Object>(m_wrap_shape));
+			m_fd.shape = &wrap_shape->UseShape();
+		}
+		else
+		{
+			m_fd.shape = NULL;
+		}
+		//m_fd.userData; // not used
 	}
 	void SyncPush()
 	{
 		// sync: push data into javascript objects
-		WrapVec2::Unwrap(Nan::New<v8::Object>(m_wrap_position))->SetVec2(m_bd.position);
-		WrapVec2::Unwrap(Nan::New<v8::Object>(m_wrap_linearVelocity))->SetVec2(m_bd.linearVelocity);
-		//m_bd.userData; // not used
+		WrapFilter::Unwrap(Nan::New<v8::Object>(m_wrap_filter))->SetFilter(m_fd.filter);
+		if (m_fd.shape)
+		{
+			// TODO: m_wrap_shape.Reset(WrapShape::GetWrap(m_fd.shape)->handle());
+		}
+		else
+		{
+			// TODO: m_wrap_shape.Reset();
+		}
+		//m_fd.userData; // not used
 	}
 public:
-	static WrapBodyDef* Unwrap(v8::Local<v8::Value> value) { return (value->IsObject())?(Unwrap(v8::Local<v8::Object>::Cast(value))):(NULL); }
-	static WrapBodyDef* Unwrap(v8::Local<v8::Object> object) { return Nan::ObjectWrap::Unwrap<WrapBodyDef>(object); }
-	static b2BodyDef* Peek(v8::Local<v8::Value> value) { WrapBodyDef* wrap = Unwrap(value); return (wrap)?(wrap->Peek()):(NULL); }
+	static WrapFixtureDef* Unwrap(v8::Local<v8::Value> value) { return (value->IsObject())?(Unwrap(v8::Local<v8::Object>::Cast(value))):(NULL); }
+	static WrapFixtureDef* Unwrap(v8::Local<v8::Object> object) { return Nan::ObjectWrap::Unwrap<WrapFixtureDef>(object); }
+	static b2FixtureDef* Peek(v8::Local<v8::Value> value) { WrapFixtureDef* wrap = Unwrap(value); return (wrap)?(wrap->Peek()):(NULL); }
 public:
 	static NAN_MODULE_INIT(Init)
 	{
@@ -1985,23 +3834,16 @@ private:
 		if (g_function_template.IsEmpty())
 		{
 			v8::Local<v8::FunctionTemplate> function_template = Nan::New<v8::FunctionTemplate>(New);
-			function_template->SetClassName(NANX_SYMBOL("b2BodyDef"));
+			function_template->SetClassName(NANX_SYMBOL("b2FixtureDef"));
 			function_template->InstanceTemplate()->SetInternalFieldCount(1);
 			v8::Local<v8::ObjectTemplate> prototype_template = function_template->PrototypeTemplate();
-			NANX_MEMBER_APPLY(prototype_template, type)
-			NANX_MEMBER_APPLY(prototype_template, position)
-			NANX_MEMBER_APPLY(prototype_template, angle)
-			NANX_MEMBER_APPLY(prototype_template, linearVelocity)
-			NANX_MEMBER_APPLY(prototype_template, angularVelocity)
-			NANX_MEMBER_APPLY(prototype_template, linearDamping)
-			NANX_MEMBER_APPLY(prototype_template, angularDamping)
-			NANX_MEMBER_APPLY(prototype_template, allowSleep)
-			NANX_MEMBER_APPLY(prototype_template, awake)
-			NANX_MEMBER_APPLY(prototype_template, fixedRotation)
-			NANX_MEMBER_APPLY(prototype_template, bullet)
-			NANX_MEMBER_APPLY(prototype_template, active)
+			NANX_MEMBER_APPLY(prototype_template, shape)
 			NANX_MEMBER_APPLY(prototype_template, userData)
-			NANX_MEMBER_APPLY(prototype_template, gravityScale)
+			NANX_MEMBER_APPLY(prototype_template, friction)
+			NANX_MEMBER_APPLY(prototype_template, restitution)
+			NANX_MEMBER_APPLY(prototype_template, density)
+			NANX_MEMBER_APPLY(prototype_template, isSensor)
+			NANX_MEMBER_APPLY(prototype_template, filter)
 			g_function_template.Reset(function_template);
 		}
 		v8::Local<v8::FunctionTemplate> function_template = Nan::New<v8::FunctionTemplate>(g_function_template);
@@ -2010,83 +3852,115 @@ private:
 private:
 	static NAN_METHOD(New)
 	{
-		WrapBodyDef* wrap = new WrapBodyDef();
-		wrap->Wrap(info.This());
-		info.GetReturnValue().Set(info.This());
-	}
-	NANX_MEMBER_INTEGER	(b2BodyType, type)
-	NANX_MEMBER_OBJECT	(position) // m_wrap_position
-	NANX_MEMBER_NUMBER	(float32, angle)
-	NANX_MEMBER_OBJECT	(linearVelocity) // m_wrap_linearVelocity
-	NANX_MEMBER_NUMBER	(float32, angularVelocity)
-	NANX_MEMBER_NUMBER	(float32, linearDamping)
-	NANX_MEMBER_NUMBER	(float32, angularDamping)
-	NANX_MEMBER_BOOLEAN	(bool, allowSleep)
-	NANX_MEMBER_BOOLEAN	(bool, awake)
-	NANX_MEMBER_BOOLEAN	(bool, fixedRotation)
-	NANX_MEMBER_BOOLEAN	(bool, bullet)
-	NANX_MEMBER_BOOLEAN	(bool, active)
+		if (info.IsConstructCall())
+		{
+			WrapFixtureDef* wrap = new WrapFixtureDef();
+			wrap->Wrap(info.This());
+			info.GetReturnValue().Set(info.This());
+		}
+		else
+		{
+			v8::Local<v8::Function> constructor = GetConstructor();
+			info.GetReturnValue().Set(constructor->NewInstance());
+		}
+	}
+	NANX_MEMBER_OBJECT	(shape) // m_wrap_shape
 	NANX_MEMBER_VALUE	(userData) // m_wrap_userData
-	NANX_MEMBER_NUMBER	(float32, gravityScale)
+	NANX_MEMBER_NUMBER	(float32, friction)
+	NANX_MEMBER_NUMBER	(float32, restitution)
+	NANX_MEMBER_NUMBER	(float32, density)
+	NANX_MEMBER_BOOLEAN	(bool, isSensor)
+	NANX_MEMBER_OBJECT	(filter) // m_wrap_filter
 };
 
-//// b2Body
+//// b2Fixture
 
-class WrapBody : public Nan::ObjectWrap
+class WrapFixture : public Nan::ObjectWrap
 {
 private:
-	b2Body* m_body;
-	Nan::Persistent<v8::Object> m_body_world;
-	Nan::Persistent<v8::Value> m_body_userData;
+	b2Fixture* m_fixture;
+	Recorder* m_recorder; // owning world's recorder
+	Nan::Persistent<v8::Object> m_fixture_body;
+	Nan::Persistent<v8::Object> m_fixture_shape;
+	Nan::Persistent<v8::Value> m_fixture_userData;
 private:
-	WrapBody() : m_body(NULL) {}
-	~WrapBody()
+	WrapFixture() : m_fixture(NULL), m_recorder(NULL)
 	{
-		m_body_world.Reset();
-		m_body_userData.Reset();
+	}
+	~WrapFixture()
+	{
+		m_fixture_body.Reset();
+		m_fixture_shape.Reset();
+		m_fixture_userData.Reset();
 	}
 public:
-	b2Body* Peek() { return m_body; }
+	b2Fixture* Peek() { return m_fixture; }
+	void SetRecorder(Recorder* recorder) { m_recorder = recorder; }
+	Recorder* Recording() { return (m_recorder && m_recorder->IsRecording())?(m_recorder):(NULL); }
 public:
-	void SetupObject(v8::Local<v8::Object> h_world, WrapBodyDef* wrap_bd, b2Body* body)
+	void SetupObject(v8::Local<v8::Object> h_body, WrapFixtureDef* wrap_fd, b2Fixture* fixture)
 	{
-		m_body = body;
-		// set body internal data
-		WrapBody::SetWrap(m_body, this);
-		// set reference to this body (prevent GC)
+		m_fixture = fixture;
+		// set fixture internal data
+		WrapFixture::SetWrap(m_fixture, this);
+		// set reference to this fixture (prevent GC)
 		Ref();
-		// set reference to world object
-		m_body_world.Reset(h_world);
+		// set reference to body object
+		m_fixture_body.Reset(h_body);
+		// set reference to shape object
+		m_fixture_shape.Reset(wrap_fd->GetShapeHandle());
 		// set reference to user data object
-		m_body_userData.Reset(wrap_bd->GetUserDataHandle());
+		m_fixture_userData.Reset(wrap_fd->GetUserDataHandle());
 	}
-	b2Body* ResetObject()
+	void SetupObject(v8::Local<v8::Object> h_body, b2Fixture* fixture, v8::Local<v8::Value> h_userData)
 	{
-		// clear reference to world object
-		m_body_world.Reset();
+		m_fixture = fixture;
+		// set fixture internal data
+		WrapFixture::SetWrap(m_fixture, this);
+		// set reference to this fixture (prevent GC)
+		Ref();
+		// set reference to body object
+		m_fixture_body.Reset(h_body);
+		// shape object is created from the box2d shape on first GetShape
+		m_fixture_shape.Reset();
+		// set reference to user data object
+		m_fixture_userData.Reset(h_userData);
+	}
+	b2Fixture* ResetObject()
+	{
+		// clear reference to body object
+		m_fixture_body.Reset();
+		// clear reference to shape object
+		m_fixture_shape.Reset();
 		// clear reference to user data object
-		m_body_userData.Reset();
-		// clear reference to this body (allow GC)
+		m_fixture_userData.Reset();
+		// clear reference to this fixture (allow GC)
 		Unref();
-		// clear body internal data
-		WrapBody::SetWrap(m_body, NULL);
-		b2Body* body = m_body;
-		m_body = NULL;
-		return body;
+		// clear fixture internal data
+		WrapFixture::SetWrap(m_fixture, NULL);
+		b2Fixture* fixture = m_fixture;
+		m_fixture = NULL;
+		m_recorder = NULL;
+		return fixture;
+	}
+	int32 GetPersistentCount() const
+	{
+		// the object handle plus the references it holds
+		return 1 + (m_fixture_body.IsEmpty()?0:1) + (m_fixture_shape.IsEmpty()?0:1) + (m_fixture_userData.IsEmpty()?0:1);
 	}
 public:
-	static WrapBody* GetWrap(const b2Body* body)
+	static WrapFixture* GetWrap(const b2Fixture* fixture)
 	{
-		return static_cast<WrapBody*>(body->GetUserData());
+		return static_cast<WrapFixture*>(fixture->GetUserData());
 	}
-	static void SetWrap(b2Body* body, WrapBody* wrap)
+	static void SetWrap(b2Fixture* fixture, WrapFixture* wrap)
 	{
-		body->SetUserData(wrap);
+		fixture->SetUserData(wrap);
 	}
 public:
-	static WrapBody* Unwrap(v8::Local<v8::Value> value) { return (value->IsObject())?(Unwrap(v8::Local<v8::Object>::Cast(value))):(NULL); }
-	static WrapBody* Unwrap(v8::Local<v8::Object> object) { return Nan::ObjectWrap::Unwrap<WrapBody>(object); }
-	static b2Body* Peek(v8::Local<v8::Value> value) { WrapBody* wrap = Unwrap(value); return (wrap)?(wrap->Peek()):(NULL); }
+	static WrapFixture* Unwrap(v8::Local<v8::Value> value) { return (value->IsObject())?(Unwrap(v8::Local<v8::Object>::Cast(value))):(NULL); }
+	static WrapFixture* Unwrap(v8::Local<v8::Object> object) { return Nan::ObjectWrap::Unwrap<WrapFixture>(object); }
+	static b2Fixture* Peek(v8::Local<v8::Value> value) { WrapFixture* wrap = Unwrap(value); return (wrap)?(wrap->Peek()):(NULL); }
 public:
 	static NAN_MODULE_INIT(Init)
 	{
@@ -2100,7 +3974,6 @@ public:
 		v8::Local<v8::Object> instance = constructor->NewInstance();
 		return scope.Escape(instance);
 	}
-
 private:
 	static v8::Local<v8::Function> GetConstructor()
 	{
@@ -2116,62 +3989,28 @@ private:
 		if (g_function_template.IsEmpty())
 		{
 			v8::Local<v8::FunctionTemplate> function_template = Nan::New<v8::FunctionTemplate>(New);
-			function_template->SetClassName(NANX_SYMBOL("b2Body"));
+			function_template->SetClassName(NANX_SYMBOL("b2Fixture"));
 			function_template->InstanceTemplate()->SetInternalFieldCount(1);
 			v8::Local<v8::ObjectTemplate> prototype_template = function_template->PrototypeTemplate();
-			NANX_METHOD_APPLY(prototype_template, CreateFixture)
-			NANX_METHOD_APPLY(prototype_template, DestroyFixture)
-			NANX_METHOD_APPLY(prototype_template, SetTransform)
-			NANX_METHOD_APPLY(prototype_template, GetTransform)
-			NANX_METHOD_APPLY(prototype_template, GetPosition)
-			NANX_METHOD_APPLY(prototype_template, GetAngle)
-			NANX_METHOD_APPLY(prototype_template, GetWorldCenter)
-			NANX_METHOD_APPLY(prototype_template, GetLocalCenter)
-			NANX_METHOD_APPLY(prototype_template, SetLinearVelocity)
-			NANX_METHOD_APPLY(prototype_template, GetLinearVelocity)
-			NANX_METHOD_APPLY(prototype_template, SetAngularVelocity)
-			NANX_METHOD_APPLY(prototype_template, GetAngularVelocity)
-			NANX_METHOD_APPLY(prototype_template, ApplyForce)
-			NANX_METHOD_APPLY(prototype_template, ApplyForceToCenter)
-			NANX_METHOD_APPLY(prototype_template, ApplyTorque)
-			NANX_METHOD_APPLY(prototype_template, ApplyLinearImpulse)
-			NANX_METHOD_APPLY(prototype_template, ApplyLinearImpulseToCenter)
-			NANX_METHOD_APPLY(prototype_template, ApplyAngularImpulse)
-			NANX_METHOD_APPLY(prototype_template, GetMass)
-			NANX_METHOD_APPLY(prototype_template, GetInertia)
-			NANX_METHOD_APPLY(prototype_template, GetMassData)
-			NANX_METHOD_APPLY(prototype_template, SetMassData)
-			NANX_METHOD_APPLY(prototype_template, ResetMassData)
-			NANX_METHOD_APPLY(prototype_template, GetWorldPoint)
-			NANX_METHOD_APPLY(prototype_template, GetWorldVector)
-			NANX_METHOD_APPLY(prototype_template, GetLocalPoint)
-			NANX_METHOD_APPLY(prototype_template, GetLocalVector)
-			NANX_METHOD_APPLY(prototype_template, GetLinearVelocityFromWorldPoint)
-			NANX_METHOD_APPLY(prototype_template, GetLinearVelocityFromLocalPoint)
-			NANX_METHOD_APPLY(prototype_template, GetLinearDamping)
-			NANX_METHOD_APPLY(prototype_template, SetLinearDamping)
-			NANX_METHOD_APPLY(prototype_template, GetAngularDamping)
-			NANX_METHOD_APPLY(prototype_template, SetAngularDamping)
-			NANX_METHOD_APPLY(prototype_template, GetGravityScale)
-			NANX_METHOD_APPLY(prototype_template, SetGravityScale)
-			NANX_METHOD_APPLY(prototype_template, SetType)
 			NANX_METHOD_APPLY(prototype_template, GetType)
-			NANX_METHOD_APPLY(prototype_template, SetBullet)
-			NANX_METHOD_APPLY(prototype_template, IsBullet)
-			NANX_METHOD_APPLY(prototype_template, SetSleepingAllowed)
-			NANX_METHOD_APPLY(prototype_template, IsSleepingAllowed)
-			NANX_METHOD_APPLY(prototype_template, SetAwake)
-			NANX_METHOD_APPLY(prototype_template, IsAwake)
-			NANX_METHOD_APPLY(prototype_template, SetActive)
-			NANX_METHOD_APPLY(prototype_template, IsActive)
-			NANX_METHOD_APPLY(prototype_template, SetFixedRotation)
-			NANX_METHOD_APPLY(prototype_template, IsFixedRotation)
-			NANX_METHOD_APPLY(prototype_template, GetFixtureList)
+			NANX_METHOD_APPLY(prototype_template, GetShape)
+			NANX_METHOD_APPLY(prototype_template, SetSensor)
+			NANX_METHOD_APPLY(prototype_template, IsSensor)
+			NANX_METHOD_APPLY(prototype_template, SetFilterData)
+			NANX_METHOD_APPLY(prototype_template, GetFilterData)
+			NANX_METHOD_APPLY(prototype_template, Refilter)
+			NANX_METHOD_APPLY(prototype_template, GetBody)
 			NANX_METHOD_APPLY(prototype_template, GetNext)
 			NANX_METHOD_APPLY(prototype_template, GetUserData)
 			NANX_METHOD_APPLY(prototype_template, SetUserData)
-			NANX_METHOD_APPLY(prototype_template, GetWorld)
-			NANX_METHOD_APPLY(prototype_template, ShouldCollideConnected)
+			NANX_METHOD_APPLY(prototype_template, TestPoint)
+			NANX_METHOD_APPLY(prototype_template, GetDensity)
+			NANX_METHOD_APPLY(prototype_template, SetDensity)
+			NANX_METHOD_APPLY(prototype_template, GetFriction)
+			NANX_METHOD_APPLY(prototype_template, SetFriction)
+			NANX_METHOD_APPLY(prototype_template, GetRestitution)
+			NANX_METHOD_APPLY(prototype_template, SetRestitution)
+			NANX_METHOD_APPLY(prototype_template, GetAABB)
 			g_function_template.Reset(function_template);
 		}
 		v8::Local<v8::FunctionTemplate> function_template = Nan::New<v8::FunctionTemplate>(g_function_template);
@@ -2180,215 +4019,90 @@ private:
 private:
 	static NAN_METHOD(New)
 	{
-		WrapBody* wrap = new WrapBody();
-		wrap->Wrap(info.This());
-		info.GetReturnValue().Set(info.This());
+		if (info.IsConstructCall())
+		{
+			WrapFixture* wrap = new WrapFixture();
+			wrap->Wrap(info.This());
+			info.GetReturnValue().Set(info.This());
+		}
+		else
+		{
+			v8::Local<v8::Function> constructor = GetConstructor();
+			info.GetReturnValue().Set(constructor->NewInstance());
+		}
 	}
-	NANX_METHOD(CreateFixture)
+	NANX_METHOD(GetType)
 	{
-		WrapBody* wrap = Unwrap(info.This());
-		WrapFixtureDef* wrap_fd = WrapFixtureDef::Unwrap(v8::Local<v8::Object>::Cast(info[0]));
-		// create box2d fixture
-		b2Fixture* fixture = wrap->m_body->CreateFixture(&wrap_fd->UseFixtureDef());
-		// create javascript fixture object
-		v8::Local<v8::Object> h_fixture = WrapFixture::NewInstance();
-		WrapFixture* wrap_fixture = WrapFixture::Unwrap(h_fixture);
-		// set up javascript fixture object
-		wrap_fixture->SetupObject(info.This(), wrap_fd, fixture);
-		info.GetReturnValue().Set(h_fixture);
+		WrapFixture* wrap = Unwrap(info.This());
+		info.GetReturnValue().Set(Nan::New(wrap->m_fixture->GetType()));
 	}
-	NANX_METHOD(DestroyFixture)
+	NANX_METHOD(GetShape)
 	{
-		WrapBody* wrap = Unwrap(info.This());
-		v8::Local<v8::Object> h_fixture = v8::Local<v8::Object>::Cast(info[0]);
-		WrapFixture* wrap_fixture = WrapFixture::Unwrap(h_fixture);
-		// delete box2d fixture
-		wrap->m_body->DestroyFixture(wrap_fixture->Peek());
-		// reset javascript fixture object
-		wrap_fixture->ResetObject();
+		WrapFixture* wrap = Unwrap(info.This());
+		if (wrap->m_fixture_shape.IsEmpty() && wrap->m_fixture)
+		{
+			// fixture was created natively; make a javascript copy of its shape
+			b2Shape* shape = wrap->m_fixture->GetShape();
+			switch (shape->GetType())
+			{
+			case b2Shape::e_circle: wrap->m_fixture_shape.Reset(WrapCircleShape::NewInstance(*static_cast<b2CircleShape*>(shape))); break;
+			case b2Shape::e_edge: wrap->m_fixture_shape.Reset(WrapEdgeShape::NewInstance(*static_cast<b2EdgeShape*>(shape))); break;
+			case b2Shape::e_polygon: wrap->m_fixture_shape.Reset(WrapPolygonShape::NewInstance(*static_cast<b2PolygonShape*>(shape))); break;
+			case b2Shape::e_chain: wrap->m_fixture_shape.Reset(WrapChainShape::NewInstance(*static_cast<b2ChainShape*>(shape))); break;
+			default: break;
+			}
+		}
+		if (wrap->m_fixture_shape.IsEmpty())
+		{
+			info.GetReturnValue().SetNull();
+		}
+		else
+		{
+			info.GetReturnValue().Set(Nan::New(wrap->m_fixture_shape));
+		}
 	}
-	NANX_METHOD(SetTransform)
+	NANX_METHOD(SetSensor)
 	{
-		WrapBody* wrap = Unwrap(info.This());
-		WrapVec2* position = WrapVec2::Unwrap(v8::Local<v8::Object>::Cast(info[0]));
-		float32 angle = NANX_float32(info[1]);
-		wrap->m_body->SetTransform(position->GetVec2(), angle);
+		WrapFixture* wrap = Unwrap(info.This());
+		bool sensor = NANX_bool(info[0]);
+		Recorder* recorder = wrap->Recording();
+		if (recorder) { recorder->Op(e_recordSetSensor).Int(recorder->GetFixtureId(wrap->m_fixture)).Bool(sensor); }
+		wrap->m_fixture->SetSensor(sensor);
 	}
-	NANX_METHOD(GetTransform)
+	NANX_METHOD(IsSensor)
 	{
-		WrapBody* wrap = Unwrap(info.This());
-		v8::Local<v8::Object> out = info[0]->IsUndefined() ? WrapTransform::NewInstance() : v8::Local<v8::Object>::Cast(info[0]);
-		WrapTransform::Unwrap(out)->SetTransform(wrap->m_body->GetTransform());
-		info.GetReturnValue().Set(out);
+		WrapFixture* wrap = Unwrap(info.This());
+		info.GetReturnValue().Set(Nan::New(wrap->m_fixture->IsSensor()));
 	}
-	NANX_METHOD(GetPosition)
+	NANX_METHOD(SetFilterData)
 	{
-		WrapBody* wrap = Unwrap(info.This());
-		v8::Local<v8::Object> out = info[0]->IsUndefined() ? WrapVec2::NewInstance() : v8::Local<v8::Object>::Cast(info[0]);
-		WrapVec2::Unwrap(out)->SetVec2(wrap->m_body->GetPosition());
-		info.GetReturnValue().Set(out);
+		WrapFixture* wrap = Unwrap(info.This());
+		WrapFilter* wrap_filter = WrapFilter::Unwrap(v8::Local<v8::Object>::Cast(info[0]));
+		Recorder* recorder = wrap->Recording();
+		if (recorder) { recorder->Op(e_recordSetFilterData).Int(recorder->GetFixtureId(wrap->m_fixture)).Filter(wrap_filter->GetFilter()); }
+		wrap->m_fixture->SetFilterData(wrap_filter->GetFilter());
 	}
-	NANX_METHOD(GetAngle) { WrapBody* wrap = Unwrap(info.This()); info.GetReturnValue().Set(Nan::New(wrap->m_body->GetAngle())); }
-	NANX_METHOD(GetWorldCenter)
-	{
-		WrapBody* wrap = Unwrap(info.This());
-		v8::Local<v8::Object> out = info[0]->IsUndefined() ? WrapVec2::NewInstance() : v8::Local<v8::Object>::Cast(info[0]);
-		WrapVec2::Unwrap(out)->SetVec2(wrap->m_body->GetWorldCenter());
-		info.GetReturnValue().Set(out);
-	}
-	NANX_METHOD(GetLocalCenter)
-	{
-		WrapBody* wrap = Unwrap(info.This());
-		v8::Local<v8::Object> out = info[0]->IsUndefined() ? WrapVec2::NewInstance() : v8::Local<v8::Object>::Cast(info[0]);
-		WrapVec2::Unwrap(out)->SetVec2(wrap->m_body->GetLocalCenter());
-		info.GetReturnValue().Set(out);
-	}
-	NANX_METHOD(SetLinearVelocity)
-	{
-		WrapBody* wrap = Unwrap(info.This());
-		wrap->m_body->SetLinearVelocity(WrapVec2::Unwrap(v8::Local<v8::Object>::Cast(info[0]))->GetVec2());
-	}
-	NANX_METHOD(GetLinearVelocity)
-	{
-		WrapBody* wrap = Unwrap(info.This());
-		v8::Local<v8::Object> out = info[0]->IsUndefined() ? WrapVec2::NewInstance() : v8::Local<v8::Object>::Cast(info[0]);
-		WrapVec2::Unwrap(out)->SetVec2(wrap->m_body->GetLinearVelocity());
-		info.GetReturnValue().Set(out);
-	}
-	NANX_METHOD(SetAngularVelocity) { WrapBody* wrap = Unwrap(info.This()); wrap->m_body->SetAngularVelocity(NANX_float32(info[0])); }
-	NANX_METHOD(GetAngularVelocity) { WrapBody* wrap = Unwrap(info.This()); info.GetReturnValue().Set(Nan::New(wrap->m_body->GetAngularVelocity())); }
-	NANX_METHOD(ApplyForce)
-	{
-		WrapBody* wrap = Unwrap(info.This());
-		WrapVec2* force = WrapVec2::Unwrap(v8::Local<v8::Object>::Cast(info[0]));
-		WrapVec2* point = WrapVec2::Unwrap(v8::Local<v8::Object>::Cast(info[1]));
-		bool wake = (info.Length() > 2) ? NANX_bool(info[2]) : true;
-		wrap->m_body->ApplyForce(force->GetVec2(), point->GetVec2(), wake);
-	}
-	NANX_METHOD(ApplyForceToCenter)
-	{
-		WrapBody* wrap = Unwrap(info.This());
-		WrapVec2* force = WrapVec2::Unwrap(v8::Local<v8::Object>::Cast(info[0]));
-		bool wake = (info.Length() > 1) ? NANX_bool(info[1]) : true;
-		wrap->m_body->ApplyForceToCenter(force->GetVec2(), wake);
-	}
-	NANX_METHOD(ApplyTorque)
-	{
-		WrapBody* wrap = Unwrap(info.This());
-		float32 torque = NANX_float32(info[0]);
-		bool wake = (info.Length() > 1) ? NANX_bool(info[1]) : true;
-		wrap->m_body->ApplyTorque(torque, wake);
-	}
-	NANX_METHOD(ApplyLinearImpulse)
-	{
-		WrapBody* wrap = Unwrap(info.This());
-		WrapVec2* impulse = WrapVec2::Unwrap(v8::Local<v8::Object>::Cast(info[0]));
-		WrapVec2* point = WrapVec2::Unwrap(v8::Local<v8::Object>::Cast(info[1]));
-		bool wake = (info.Length() > 2) ? NANX_bool(info[2]) : true;
-		wrap->m_body->ApplyLinearImpulse(impulse->GetVec2(), point->GetVec2(), wake);
-	}
-	NANX_METHOD(ApplyLinearImpulseToCenter)
-	{
-		WrapBody* wrap = Unwrap(info.This());
-		WrapVec2* impulse = WrapVec2::Unwrap(v8::Local<v8::Object>::Cast(info[0]));
-		bool wake = (info.Length() > 1) ? NANX_bool(info[1]) : true;
-		wrap->m_body->ApplyLinearImpulse(impulse->GetVec2(), wrap->m_body->GetWorldCenter(), wake);
-	}
-	NANX_METHOD(ApplyAngularImpulse)
-	{
-		WrapBody* wrap = Unwrap(info.This());
-		float32 impulse = NANX_float32(info[0]);
-		bool wake = (info.Length() > 1) ? NANX_bool(info[1]) : true;
-		wrap->m_body->ApplyAngularImpulse(impulse, wake);
-	}
-	NANX_METHOD(GetMass) { WrapBody* wrap = Unwrap(info.This()); info.GetReturnValue().Set(Nan::New(wrap->m_body->GetMass())); }
-	NANX_METHOD(GetInertia) { WrapBody* wrap = Unwrap(info.This()); info.GetReturnValue().Set(Nan::New(wrap->m_body->GetInertia())); }
-	NANX_METHOD(GetMassData)
-	{
-		WrapBody* wrap = Unwrap(info.This());
-		v8::Local<v8::Object> out = info[0]->IsUndefined() ? WrapMassData::NewInstance() : v8::Local<v8::Object>::Cast(info[0]);
-		b2MassData mass_data;
-		wrap->m_body->GetMassData(&mass_data);
-		WrapMassData::Unwrap(out)->SetMassData(mass_data);
-		info.GetReturnValue().Set(out);
-	}
-	NANX_METHOD(SetMassData)
-	{
-		WrapBody* wrap = Unwrap(info.This());
-		const b2MassData& mass_data = WrapMassData::Unwrap(v8::Local<v8::Object>::Cast(info[0]))->GetMassData();
-		wrap->m_body->SetMassData(&mass_data);
-	}
-	NANX_METHOD(ResetMassData) { WrapBody* wrap = Unwrap(info.This()); wrap->m_body->ResetMassData(); }
-	NANX_METHOD(GetWorldPoint)
-	{
-		WrapBody* wrap = Unwrap(info.This());
-		WrapVec2* wrap_localPoint = WrapVec2::Unwrap(v8::Local<v8::Object>::Cast(info[0]));
-		v8::Local<v8::Object> out = info[1]->IsUndefined() ? WrapVec2::NewInstance() : v8::Local<v8::Object>::Cast(info[1]);
-		WrapVec2::Unwrap(out)->SetVec2(wrap->m_body->GetWorldPoint(wrap_localPoint->GetVec2()));
-		info.GetReturnValue().Set(out);
-	}
-	NANX_METHOD(GetWorldVector)
-	{
-		WrapBody* wrap = Unwrap(info.This());
-		WrapVec2* wrap_localVector = WrapVec2::Unwrap(v8::Local<v8::Object>::Cast(info[0]));
-		v8::Local<v8::Object> out = info[1]->IsUndefined() ? WrapVec2::NewInstance() : v8::Local<v8::Object>::Cast(info[1]);
-		WrapVec2::Unwrap(out)->SetVec2(wrap->m_body->GetWorldVector(wrap_localVector->GetVec2()));
-		info.GetReturnValue().Set(out);
-	}
-	NANX_METHOD(GetLocalPoint)
-	{
-		WrapBody* wrap = Unwrap(info.This());
-		WrapVec2* wrap_worldPoint = WrapVec2::Unwrap(v8::Local<v8::Object>::Cast(info[0]));
-		v8::Local<v8::Object> out = info[1]->IsUndefined() ? WrapVec2::NewInstance() : v8::Local<v8::Object>::Cast(info[1]);
-		WrapVec2::Unwrap(out)->SetVec2(wrap->m_body->GetLocalPoint(wrap_worldPoint->GetVec2()));
-		info.GetReturnValue().Set(out);
-	}
-	NANX_METHOD(GetLocalVector)
+	NANX_METHOD(GetFilterData)
 	{
-		WrapBody* wrap = Unwrap(info.This());
-		WrapVec2* wrap_worldVector = WrapVec2::Unwrap(v8::Local<v8::Object>::Cast(info[0]));
-		v8::Local<v8::Object> out = info[1]->IsUndefined() ? WrapVec2::NewInstance() : v8::Local<v8::Object>::Cast(info[1]);
-		WrapVec2::Unwrap(out)->SetVec2(wrap->m_body->GetLocalVector(wrap_worldVector->GetVec2()));
-		info.GetReturnValue().Set(out);
+		WrapFixture* wrap = Unwrap(info.This());
+		info.GetReturnValue().Set(WrapFilter::NewInstance(wrap->m_fixture->GetFilterData()));
 	}
-	NANX_METHOD(GetLinearVelocityFromWorldPoint)
+	NANX_METHOD(Refilter)
 	{
-		WrapBody* wrap = Unwrap(info.This());
-		WrapVec2* wrap_worldPoint = WrapVec2::Unwrap(v8::Local<v8::Object>::Cast(info[0]));
-		v8::Local<v8::Object> out = info[1]->IsUndefined() ? WrapVec2::NewInstance() : v8::Local<v8::Object>::Cast(info[1]);
-		WrapVec2::Unwrap(out)->SetVec2(wrap->m_body->GetLinearVelocityFromWorldPoint(wrap_worldPoint->GetVec2()));
-		info.GetReturnValue().Set(out);
+		WrapFixture* wrap = Unwrap(info.This());
+		Recorder* recorder = wrap->Recording();
+		if (recorder) { recorder->Op(e_recordRefilter).Int(recorder->GetFixtureId(wrap->m_fixture)); }
+		wrap->m_fixture->Refilter();
 	}
-	NANX_METHOD(GetLinearVelocityFromLocalPoint)
+	NANX_METHOD(GetBody)
 	{
-		WrapBody* wrap = Unwrap(info.This());
-		WrapVec2* wrap_localPoint = WrapVec2::Unwrap(v8::Local<v8::Object>::Cast(info[0]));
-		v8::Local<v8::Object> out = info[1]->IsUndefined() ? WrapVec2::NewInstance() : v8::Local<v8::Object>::Cast(info[1]);
-		WrapVec2::Unwrap(out)->SetVec2(wrap->m_body->GetLinearVelocityFromLocalPoint(wrap_localPoint->GetVec2()));
-		info.GetReturnValue().Set(out);
+		WrapFixture* wrap = Unwrap(info.This());
+		info.GetReturnValue().Set(Nan::New(wrap->m_fixture_body));
 	}
-	NANX_METHOD(GetLinearDamping) { WrapBody* wrap = Unwrap(info.This()); info.GetReturnValue().Set(Nan::New(wrap->m_body->GetLinearDamping())); }
-	NANX_METHOD(SetLinearDamping) { WrapBody* wrap = Unwrap(info.This()); wrap->m_body->SetLinearDamping(NANX_float32(info[0])); }
-	NANX_METHOD(GetAngularDamping) { WrapBody* wrap = Unwrap(info.This()); info.GetReturnValue().Set(Nan::New(wrap->m_body->GetAngularDamping())); }
-	NANX_METHOD(SetAngularDamping) { WrapBody* wrap = Unwrap(info.This()); wrap->m_body->SetAngularDamping(NANX_float32(info[0])); }
-	NANX_METHOD(GetGravityScale) { WrapBody* wrap = Unwrap(info.This()); info.GetReturnValue().Set(Nan::New(wrap->m_body->GetGravityScale())); }
-	NANX_METHOD(SetGravityScale) { WrapBody* wrap = Unwrap(info.This()); wrap->m_body->SetGravityScale(NANX_float32(info[0])); }
-	NANX_METHOD(SetType) { WrapBody* wrap = Unwrap(info.This()); wrap->m_body->SetType(NANX_b2BodyType(info[0])); }
-	NANX_METHOD(GetType) { WrapBody* wrap = Unwrap(info.This()); info.GetReturnValue().Set(Nan::New(wrap->m_body->GetType())); }
-	NANX_METHOD(SetBullet) { WrapBody* wrap = Unwrap(info.This()); wrap->m_body->SetBullet(NANX_bool(info[0])); }
-	NANX_METHOD(IsBullet) { WrapBody* wrap = Unwrap(info.This()); info.GetReturnValue().Set(Nan::New(wrap->m_body->IsBullet())); }
-	NANX_METHOD(SetSleepingAllowed) { WrapBody* wrap = Unwrap(info.This()); wrap->m_body->SetSleepingAllowed(NANX_bool(info[0])); }
-	NANX_METHOD(IsSleepingAllowed) { WrapBody* wrap = Unwrap(info.This()); info.GetReturnValue().Set(Nan::New(wrap->m_body->IsSleepingAllowed())); }
-	NANX_METHOD(SetAwake) { WrapBody* wrap = Unwrap(info.This()); wrap->m_body->SetAwake(NANX_bool(info[0])); }
-	NANX_METHOD(IsAwake) { WrapBody* wrap = Unwrap(info.This()); info.GetReturnValue().Set(Nan::New(wrap->m_body->IsAwake())); }
-	NANX_METHOD(SetActive) { WrapBody* wrap = Unwrap(info.This()); wrap->m_body->SetActive(NANX_bool(info[0])); }
-	NANX_METHOD(IsActive) { WrapBody* wrap = Unwrap(info.This()); info.GetReturnValue().Set(Nan::New(wrap->m_body->IsActive())); }
-	NANX_METHOD(SetFixedRotation) { WrapBody* wrap = Unwrap(info.This()); wrap->m_body->SetFixedRotation(NANX_bool(info[0])); }
-	NANX_METHOD(IsFixedRotation) { WrapBody* wrap = Unwrap(info.This()); info.GetReturnValue().Set(Nan::New(wrap->m_body->IsFixedRotation())); }
-	NANX_METHOD(GetFixtureList)
+	NANX_METHOD(GetNext)
 	{
-		WrapBody* wrap = Unwrap(info.This());
-		b2Fixture* fixture = wrap->m_body->GetFixtureList();
+		WrapFixture* wrap = Unwrap(info.This());
+		b2Fixture* fixture = wrap->m_fixture->GetNext();
 		if (fixture)
 		{
 			// get fixture internal data
@@ -2400,120 +4114,138 @@ private:
 			info.GetReturnValue().SetNull();
 		}
 	}
-	///b2JointEdge* GetJointList();
-	///const b2JointEdge* GetJointList() const;
-	///b2ContactEdge* GetContactList();
-	///const b2ContactEdge* GetContactList() const;
-	NANX_METHOD(GetNext)
+	NANX_METHOD(GetUserData)
 	{
-		WrapBody* wrap = Unwrap(info.This());
-		b2Body* body = wrap->m_body->GetNext();
-		if (body)
+		WrapFixture* wrap = Unwrap(info.This());
+		if (!wrap->m_fixture_userData.IsEmpty())
 		{
-			// get body internal data
-			WrapBody* wrap_body = WrapBody::GetWrap(body);
-			info.GetReturnValue().Set(wrap_body->handle());
+			info.GetReturnValue().Set(Nan::New<v8::Value>(wrap->m_fixture_userData));
 		}
 		else
 		{
 			info.GetReturnValue().SetNull();
 		}
 	}
-	NANX_METHOD(GetUserData)
-	{
-		WrapBody* wrap = Unwrap(info.This());
-		info.GetReturnValue().Set(Nan::New<v8::Value>(wrap->m_body_userData));
-	}
 	NANX_METHOD(SetUserData)
 	{
-		WrapBody* wrap = Unwrap(info.This());
-		if (!info[0]->IsUndefined())
+		WrapFixture* wrap = Unwrap(info.This());
+		if (!info[0]->IsNull())
 		{
-			wrap->m_body_userData.Reset(info[0]);
+			wrap->m_fixture_userData.Reset(info[0]);
 		}
 		else
 		{
-			wrap->m_body_userData.Reset();
+			wrap->m_fixture_userData.Reset();
 		}
 	}
-	NANX_METHOD(GetWorld)
+	NANX_METHOD(TestPoint)
 	{
-		WrapBody* wrap = Unwrap(info.This());
-		info.GetReturnValue().Set(Nan::New<v8::Object>(wrap->m_body_world));
+		WrapFixture* wrap = Unwrap(info.This());
+		WrapVec2* p = WrapVec2::Unwrap(v8::Local<v8::Object>::Cast(info[0]));
+		info.GetReturnValue().Set(Nan::New(wrap->m_fixture->TestPoint(p->GetVec2())));
 	}
-	NANX_METHOD(ShouldCollideConnected)
+	//bool RayCast(b2RayCastOutput* output, const b2RayCastInput& input, int32 childIndex) const;
+	//void GetMassData(b2MassData* massData) const;
+	NANX_METHOD(GetDensity)
 	{
-		WrapBody* wrap = Unwrap(info.This());
-		WrapBody* wrap_other = WrapBody::Unwrap(v8::Local<v8::Object>::Cast(info[0]));
-		info.GetReturnValue().Set(Nan::New(wrap->m_body->ShouldCollideConnected(wrap_other->m_body)));
+		WrapFixture* wrap = Unwrap(info.This());
+		info.GetReturnValue().Set(Nan::New(wrap->m_fixture->GetDensity()));
 	}
-	///void Dump();
+	NANX_METHOD(SetDensity)
+	{
+		WrapFixture* wrap = Unwrap(info.This());
+		float32 value = NANX_float32(info[0]);
+		Recorder* recorder = wrap->Recording();
+		if (recorder) { recorder->Op(e_recordSetFixtureFloat).Int(recorder->GetFixtureId(wrap->m_fixture)).Uint8(e_recordDensity).Float(value); }
+		wrap->m_fixture->SetDensity(value);
+	}
+	NANX_METHOD(GetFriction)
+	{
+		WrapFixture* wrap = Unwrap(info.This());
+		info.GetReturnValue().Set(Nan::New(wrap->m_fixture->GetFriction()));
+	}
+	NANX_METHOD(SetFriction)
+	{
+		WrapFixture* wrap = Unwrap(info.This());
+		float32 value = NANX_float32(info[0]);
+		Recorder* recorder = wrap->Recording();
+		if (recorder) { recorder->Op(e_recordSetFixtureFloat).Int(recorder->GetFixtureId(wrap->m_fixture)).Uint8(e_recordFriction).Float(value); }
+		wrap->m_fixture->SetFriction(value);
+	}
+	NANX_METHOD(GetRestitution)
+	{
+		WrapFixture* wrap = Unwrap(info.This());
+		info.GetReturnValue().Set(Nan::New(wrap->m_fixture->GetRestitution()));
+	}
+	NANX_METHOD(SetRestitution)
+	{
+		WrapFixture* wrap = Unwrap(info.This());
+		float32 value = NANX_float32(info[0]);
+		Recorder* recorder = wrap->Recording();
+		if (recorder) { recorder->Op(e_recordSetFixtureFloat).Int(recorder->GetFixtureId(wrap->m_fixture)).Uint8(e_recordRestitution).Float(value); }
+		wrap->m_fixture->SetRestitution(value);
+	}
+	NANX_METHOD(GetAABB)
+	{
+		WrapFixture* wrap = Unwrap(info.This());
+		int32 childIndex = NANX_int32(info[0]);
+		info.GetReturnValue().Set(WrapAABB::NewInstance(wrap->m_fixture->GetAABB(childIndex)));
+	}
+	///	void Dump(int32 bodyIndex);
 };
 
-//// b2JointDef
+//// b2BodyDef
 
-class WrapJointDef : public Nan::ObjectWrap
+class WrapBodyDef : public Nan::ObjectWrap
 {
-protected:
-	Nan::Persistent<v8::Value> m_wrap_userData; // m_jd.userData
-	Nan::Persistent<v8::Object> m_wrap_bodyA; // m_jd.bodyA
-	Nan::Persistent<v8::Object> m_wrap_bodyB; // m_jd.bodyB
-public:
-	WrapJointDef() {}
-	~WrapJointDef()
+private:
+	b2BodyDef m_bd;
+	Nan::Persistent<v8::Object> m_wrap_position; // m_bd.position
+	Nan::Persistent<v8::Object> m_wrap_linearVelocity; // m_bd.linearVelocity
+	Nan::Persistent<v8::Value> m_wrap_userData; // m_bd.userData
+private:
+	WrapBodyDef()
+	{
+		m_wrap_position.Reset(WrapVec2::NewInstance(m_bd.position));
+		m_wrap_linearVelocity.Reset(WrapVec2::NewInstance(m_bd.linearVelocity));
+	}
+	~WrapBodyDef()
 	{
+		m_wrap_position.Reset();
+		m_wrap_linearVelocity.Reset();
 		m_wrap_userData.Reset();
-		m_wrap_bodyA.Reset();
-		m_wrap_bodyB.Reset();
 	}
 public:
-	b2JointDef* Peek() { return &GetJointDef(); }
-	virtual b2JointDef& GetJointDef() = 0;
-	const b2JointDef& UseJointDef() { SyncPull(); return GetJointDef(); }
+	b2BodyDef* Peek() { SyncPull(); return &m_bd; } // TODO: is SyncPull necessary
+	b2BodyDef& GetBodyDef() { return m_bd; }
+	const b2BodyDef& UseBodyDef() { SyncPull(); return GetBodyDef(); }
 	v8::Local<v8::Value> GetUserDataHandle() { return Nan::New<v8::Value>(m_wrap_userData); }
-	v8::Local<v8::Object> GetBodyAHandle() { return Nan::New<v8::Object>(m_wrap_bodyA); }
-	v8::Local<v8::Object> GetBodyBHandle() { return Nan::New<v8::Object>(m_wrap_bodyB); }
 public:
-	virtual void SyncPull()
+	void SyncPull()
 	{
-		b2JointDef& jd = GetJointDef();
 		// sync: pull data from javascript objects
-		//jd.userData; // not used
-		jd.bodyA = m_wrap_bodyA.IsEmpty() ? NULL : WrapBody::Unwrap(Nan::New<v8::Object>(m_wrap_bodyA))->Peek();
-		jd.bodyB = m_wrap_bodyB.IsEmpty() ? NULL : WrapBody::Unwrap(Nan::New<v8::Object>(m_wrap_bodyB))->Peek();
+		m_bd.position = WrapVec2::Unwrap(Nan::New<v8::Object>(m_wrap_position))->GetVec2(); // struct copy
+		m_bd.linearVelocity = WrapVec2::Unwrap(Nan::New<v8::Object>(m_wrap_linearVelocity))->GetVec2(); // struct copy
+		//m_bd.userData; // not used
 	}
-	virtual void SyncPush()
+	void SyncPush()
 	{
-		b2JointDef& jd = GetJointDef();
 		// sync: push data into javascript objects
-		//jd.userData; // not used
-		if (jd.bodyA)
-		{
-			m_wrap_bodyA.Reset(WrapBody::GetWrap(jd.bodyA)->handle());
-		}
-		else
-		{
-			m_wrap_bodyA.Reset();
-		}
-		if (jd.bodyB)
-		{
-			m_wrap_bodyB.Reset(WrapBody::GetWrap(jd.bodyB)->handle());
-		}
-		else
-		{
-			m_wrap_bodyB.Reset();
-		}
+		WrapVec2::Unwrap(Nan::New<v8::Object>(m_wrap_position))->SetVec2(m_bd.position);
+		WrapVec2::Unwrap(Nan::New<v8::Object>(m_wrap_linearVelocity))->SetVec2(m_bd.linearVelocity);
+		//m_bd.userData; // not used
 	}
 public:
-	static WrapJointDef* Unwrap(v8::Local<v8::Value> value) { return (value->IsObject())?(Unwrap(v8::Local<v8::Object>::Cast(value))):(NULL); }
-	static WrapJointDef* Unwrap(v8::Local<v8::Object> object) { return Nan::ObjectWrap::Unwrap<WrapJointDef>(object); }
-	static b2JointDef* Peek(v8::Local<v8::Value> value) { WrapJointDef* wrap = Unwrap(value); return (wrap)?(wrap->Peek()):(NULL); }
+	static WrapBodyDef* Unwrap(v8::Local<v8::Value> value) { return (value->IsObject())?(Unwrap(v8::Local<v8::Object>::Cast(value))):(NULL); }
+	static WrapBodyDef* Unwrap(v8::Local<v8::Object> object) { return Nan::ObjectWrap::Unwrap<WrapBodyDef>(object); }
+	static b2BodyDef* Peek(v8::Local<v8::Value> value) { WrapBodyDef* wrap = Unwrap(value); return (wrap)?(wrap->Peek()):(NULL); }
 public:
 	static NAN_MODULE_INIT(Init)
 	{
 		v8::Local<v8::Function> constructor = GetConstructor();
 		target->Set(constructor->GetName(), constructor);
 	}
+private:
 	static v8::Local<v8::Function> GetConstructor()
 	{
 		Nan::EscapableHandleScope scope;
@@ -2527,289 +4259,514 @@ public:
 		static Nan::Persistent<v8::FunctionTemplate> g_function_template;
 		if (g_function_template.IsEmpty())
 		{
-			v8::Local<v8::FunctionTemplate> function_template = Nan::New<v8::FunctionTemplate>();
-			function_template->SetClassName(NANX_SYMBOL("b2JointDef"));
+			v8::Local<v8::FunctionTemplate> function_template = Nan::New<v8::FunctionTemplate>(New);
+			function_template->SetClassName(NANX_SYMBOL("b2BodyDef"));
 			function_template->InstanceTemplate()->SetInternalFieldCount(1);
 			v8::Local<v8::ObjectTemplate> prototype_template = function_template->PrototypeTemplate();
 			NANX_MEMBER_APPLY(prototype_template, type)
+			NANX_MEMBER_APPLY(prototype_template, position)
+			NANX_MEMBER_APPLY(prototype_template, angle)
+			NANX_MEMBER_APPLY(prototype_template, linearVelocity)
+			NANX_MEMBER_APPLY(prototype_template, angularVelocity)
+			NANX_MEMBER_APPLY(prototype_template, linearDamping)
+			NANX_MEMBER_APPLY(prototype_template, angularDamping)
+			NANX_MEMBER_APPLY(prototype_template, allowSleep)
+			NANX_MEMBER_APPLY(prototype_template, awake)
+			NANX_MEMBER_APPLY(prototype_template, fixedRotation)
+			NANX_MEMBER_APPLY(prototype_template, bullet)
+			NANX_MEMBER_APPLY(prototype_template, active)
 			NANX_MEMBER_APPLY(prototype_template, userData)
-			NANX_MEMBER_APPLY(prototype_template, bodyA)
-			NANX_MEMBER_APPLY(prototype_template, bodyB)
-			NANX_MEMBER_APPLY(prototype_template, collideConnected)
+			NANX_MEMBER_APPLY(prototype_template, gravityScale)
 			g_function_template.Reset(function_template);
 		}
 		v8::Local<v8::FunctionTemplate> function_template = Nan::New<v8::FunctionTemplate>(g_function_template);
 		return scope.Escape(function_template);
 	}
 private:
-	NANX_MEMBER_INTEGER	(b2JointType, type)
+	static NAN_METHOD(New)
+	{
+		WrapBodyDef* wrap = new WrapBodyDef();
+		wrap->Wrap(info.This());
+		info.GetReturnValue().Set(info.This());
+	}
+	NANX_MEMBER_INTEGER	(b2BodyType, type)
+	NANX_MEMBER_OBJECT	(position) // m_wrap_position
+	NANX_MEMBER_NUMBER	(float32, angle)
+	NANX_MEMBER_OBJECT	(linearVelocity) // m_wrap_linearVelocity
+	NANX_MEMBER_NUMBER	(float32, angularVelocity)
+	NANX_MEMBER_NUMBER	(float32, linearDamping)
+	NANX_MEMBER_NUMBER	(float32, angularDamping)
+	NANX_MEMBER_BOOLEAN	(bool, allowSleep)
+	NANX_MEMBER_BOOLEAN	(bool, awake)
+	NANX_MEMBER_BOOLEAN	(bool, fixedRotation)
+	NANX_MEMBER_BOOLEAN	(bool, bullet)
+	NANX_MEMBER_BOOLEAN	(bool, active)
 	NANX_MEMBER_VALUE	(userData) // m_wrap_userData
-	NANX_MEMBER_OBJECT	(bodyA) // m_wrap_bodyA
-	NANX_MEMBER_OBJECT	(bodyB) // m_wrap_bodyB
-	NANX_MEMBER_BOOLEAN	(bool, collideConnected)
+	NANX_MEMBER_NUMBER	(float32, gravityScale)
 };
 
-//// b2Joint
+//// polygon decomposition
 
-class WrapJoint : public Nan::ObjectWrap
+// triangulate a simple outline by ear clipping, testing ears only against the reflex
+// vertices, then merge triangles across the clipped diagonals in one Hertel-Mehlhorn pass
+// while the result stays convex and within b2_maxPolygonVertices; pieces that weld down
+// to slivers are dropped
+
+static float32 DecomposeCross(const b2Vec2& a, const b2Vec2& b, const b2Vec2& c)
+{
+	return b2Cross(b - a, c - b);
+}
+
+static int32 DecomposeCountCorners(const std::vector<b2Vec2>& points, const std::vector<int32>& poly)
+{
+	// collinear vertices are removed by b2PolygonShape::Set and do not count against the limit
+	const int32 n = static_cast<int32>(poly.size());
+	int32 corners = 0;
+	for (int32 i = 0; i < n; ++i)
+	{
+		const b2Vec2& a = points[poly[(i + n - 1) % n]];
+		const b2Vec2& b = points[poly[i]];
+		const b2Vec2& c = points[poly[(i + 1) % n]];
+		if (DecomposeCross(a, b, c) > b2_epsilon) { ++corners; }
+	}
+	return corners;
+}
+
+static bool DecomposePointInTriangle(const b2Vec2& p, const b2Vec2& a, const b2Vec2& b, const b2Vec2& c)
+{
+	return (b2Cross(b - a, p - a) >= 0.0f) && (b2Cross(c - b, p - b) >= 0.0f) && (b2Cross(a - c, p - c) >= 0.0f);
+}
+
+class DecomposeRing
 {
 private:
-	Nan::Persistent<v8::Object> m_joint_world;
-	Nan::Persistent<v8::Object> m_joint_bodyA;
-	Nan::Persistent<v8::Object> m_joint_bodyB;
-	Nan::Persistent<v8::Value> m_joint_userData;
+	const std::vector<b2Vec2>& m_points;
+	std::vector<int32> m_prev;
+	std::vector<int32> m_next;
+	std::vector<bool> m_reflex; // not strictly convex, collinear included
+	std::vector<bool> m_ear;
+	std::vector<int32> m_reflex_list;
 public:
-	WrapJoint() {}
-	~WrapJoint()
+	DecomposeRing(const std::vector<b2Vec2>& points) : m_points(points)
 	{
-		m_joint_bodyA.Reset();
-		m_joint_bodyB.Reset();
-		m_joint_userData.Reset();
+		const int32 n = static_cast<int32>(points.size());
+		m_prev.resize(n);
+		m_next.resize(n);
+		m_reflex.resize(n);
+		m_ear.resize(n);
+		for (int32 i = 0; i < n; ++i)
+		{
+			m_prev[i] = (i + n - 1) % n;
+			m_next[i] = (i + 1) % n;
+		}
+		for (int32 i = 0; i < n; ++i)
+		{
+			m_reflex[i] = (Cross(i) <= 0.0f);
+			if (m_reflex[i]) { m_reflex_list.push_back(i); }
+		}
+		for (int32 i = 0; i < n; ++i) { m_ear[i] = IsEar(i); }
 	}
-public:
-	b2Joint* Peek() { return GetJoint(); }
-	virtual b2Joint* GetJoint() = 0;
-public:
-	void SetupObject(v8::Local<v8::Object> h_world, WrapJointDef* wrap_jd)
+	int32 Prev(int32 i) const { return m_prev[i]; }
+	int32 Next(int32 i) const { return m_next[i]; }
+	bool Ear(int32 i) const { return m_ear[i]; }
+	float32 Cross(int32 i) const { return DecomposeCross(m_points[m_prev[i]], m_points[i], m_points[m_next[i]]); }
+	bool IsCollinear(int32 i) const
 	{
-		b2Joint* joint = GetJoint();
-		// set joint internal data
-		WrapJoint::SetWrap(joint, this);
-		// set reference to this joint (prevent GC)
-		Ref();
-		// set reference to joint world object
-		m_joint_world.Reset(h_world);
-		// set references to joint body objects
-		m_joint_bodyA.Reset(wrap_jd->GetBodyAHandle());
-		m_joint_bodyB.Reset(wrap_jd->GetBodyBHandle());
-		// set reference to joint user data object
-		m_joint_userData.Reset(wrap_jd->GetUserDataHandle());
+		// within a linear slop of the line through its neighbours, so removing it keeps the outline
+		b2Vec2 d = m_points[m_next[i]] - m_points[m_prev[i]];
+		return b2Abs(Cross(i)) <= b2_linearSlop * d.Length();
 	}
-	void ResetObject()
+	void Remove(int32 i)
 	{
-		b2Joint* joint = GetJoint();
-		// clear reference to joint world object
-		m_joint_world.Reset();
-		// clear references to joint body objects
-		m_joint_bodyA.Reset();
-		m_joint_bodyB.Reset();
-		// clear reference to joint user data object
-		m_joint_userData.Reset();
-		// clear reference to this joint (allow GC)
-		Unref();
-		// clear joint internal data
-		WrapJoint::SetWrap(joint, NULL);
+		const int32 a = m_prev[i];
+		const int32 c = m_next[i];
+		m_next[a] = c;
+		m_prev[c] = a;
+		if (m_reflex[i]) { Unreflex(i); }
+		m_ear[i] = false;
+		Update(a);
+		Update(c);
 	}
-public:
-	static WrapJoint* GetWrap(const b2Joint* joint)
+	void Refresh(int32 start, int32 remaining)
 	{
-		return static_cast<WrapJoint*>(joint->GetUserData());
+		// ear flags away from a removed reflex vertex can go stale
+		for (int32 k = 0, i = start; k < remaining; ++k, i = m_next[i]) { m_ear[i] = IsEar(i); }
 	}
-	static void SetWrap(b2Joint* joint, WrapJoint* wrap)
+private:
+	bool IsEar(int32 i) const
 	{
-		joint->SetUserData(wrap);
+		// a vertex inside a convex corner's triangle means some reflex vertex is inside it
+		if (m_reflex[i]) { return false; }
+		const int32 a = m_prev[i];
+		const int32 c = m_next[i];
+		for (size_t k = 0; k < m_reflex_list.size(); ++k)
+		{
+			const int32 v = m_reflex_list[k];
+			if ((v == a) || (v == c)) { continue; }
+			if (DecomposePointInTriangle(m_points[v], m_points[a], m_points[i], m_points[c])) { return false; }
+		}
+		return true;
 	}
-public:
-	static WrapJoint* Unwrap(v8::Local<v8::Value> value) { return (value->IsObject())?(Unwrap(v8::Local<v8::Object>::Cast(value))):(NULL); }
-	static WrapJoint* Unwrap(v8::Local<v8::Object> object) { return Nan::ObjectWrap::Unwrap<WrapJoint>(object); }
-	static b2Joint* Peek(v8::Local<v8::Value> value) { WrapJoint* wrap = Unwrap(value); return (wrap)?(wrap->Peek()):(NULL); }
-public:
-	static NAN_MODULE_INIT(Init)
+	void Unreflex(int32 i)
 	{
-		v8::Local<v8::Function> constructor = GetConstructor();
-		target->Set(constructor->GetName(), constructor);
+		m_reflex[i] = false;
+		m_reflex_list.erase(std::find(m_reflex_list.begin(), m_reflex_list.end(), i));
 	}
-	static v8::Local<v8::Function> GetConstructor()
+	void Update(int32 i)
 	{
-		Nan::EscapableHandleScope scope;
-		v8::Local<v8::FunctionTemplate> function_template = GetFunctionTemplate();
-		v8::Local<v8::Function> constructor = function_template->GetFunction();
-		return scope.Escape(constructor);
+		bool reflex = (Cross(i) <= 0.0f);
+		if (m_reflex[i] && !reflex) { Unreflex(i); }
+		else if (!m_reflex[i] && reflex) { m_reflex[i] = true; m_reflex_list.push_back(i); }
+		m_ear[i] = IsEar(i);
 	}
-	static v8::Local<v8::FunctionTemplate> GetFunctionTemplate()
+};
+
+static bool DecomposeMergeDiagonal(const std::vector<b2Vec2>& points, std::vector< std::vector<int32> >& polys, std::map<std::pair<int32,int32>,int32>& edges, int32 a, int32 c)
+{
+	// the diagonal is c -> a in one piece and a -> c in the other; both pieces are convex,
+	// so the union is convex when its corners at a and c are
+	std::map<std::pair<int32,int32>,int32>::iterator it_p = edges.find(std::make_pair(c, a));
+	std::map<std::pair<int32,int32>,int32>::iterator it_q = edges.find(std::make_pair(a, c));
+	if ((it_p == edges.end()) || (it_q == edges.end()) || (it_p->second == it_q->second)) { return false; }
+	const int32 pi = it_p->second;
+	const int32 qi = it_q->second;
+	const std::vector<int32>& p = polys[pi];
+	const std::vector<int32>& q = polys[qi];
+	const int32 np = static_cast<int32>(p.size());
+	const int32 nq = static_cast<int32>(q.size());
+	const int32 i = static_cast<int32>(std::find(p.begin(), p.end(), a) - p.begin()); // p[i - 1] == c
+	const int32 j = static_cast<int32>(std::find(q.begin(), q.end(), c) - q.begin()); // q[j - 1] == a
+	if ((i == np) || (j == nq) || (p[(i + np - 1) % np] != c) || (q[(j + nq - 1) % nq] != a)) { return false; }
+	std::vector<int32> poly;
+	for (int32 k = 0; k < np; ++k) { poly.push_back(p[(i + k) % np]); } // a ... c
+	for (int32 k = 1; k < nq - 1; ++k) { poly.push_back(q[(j + k) % nq]); } // after c ... before a
+	const int32 n = static_cast<int32>(poly.size());
+	if (DecomposeCross(points[poly[n - 1]], points[poly[0]], points[poly[1]]) < -b2_epsilon) { return false; }
+	if (DecomposeCross(points[poly[np - 2]], points[poly[np - 1]], points[poly[np % n]]) < -b2_epsilon) { return false; }
+	if (DecomposeCountCorners(points, poly) > b2_maxPolygonVertices) { return false; }
+	edges.erase(it_p);
+	edges.erase(it_q);
+	for (int32 k = 0; k < nq; ++k)
+	{
+		std::map<std::pair<int32,int32>,int32>::iterator it = edges.find(std::make_pair(q[k], q[(k + 1) % nq]));
+		if (it != edges.end()) { it->second = pi; }
+	}
+	polys[pi].swap(poly);
+	polys[qi].clear();
+	return true;
+}
+
+static bool DecomposePolygon(const b2Vec2* vertices, int32 count, std::vector<b2PolygonShape>& out)
+{
+	// false when the outline is degenerate or self intersecting
+	const float32 weld_sq = b2_linearSlop * b2_linearSlop;
+
+	// weld near duplicate vertices, including the closing vertex
+	std::vector<b2Vec2> points;
+	points.reserve(count);
+	for (int32 i = 0; i < count; ++i)
 	{
-		Nan::EscapableHandleScope scope;
-		static Nan::Persistent<v8::FunctionTemplate> g_function_template;
-		if (g_function_template.IsEmpty())
+		if (points.empty() || b2DistanceSquared(points.back(), vertices[i]) > weld_sq)
 		{
-			v8::Local<v8::FunctionTemplate> function_template = Nan::New<v8::FunctionTemplate>();
-			function_template->SetClassName(NANX_SYMBOL("b2Joint"));
-			function_template->InstanceTemplate()->SetInternalFieldCount(1);
-			v8::Local<v8::ObjectTemplate> prototype_template = function_template->PrototypeTemplate();
-			NANX_METHOD_APPLY(prototype_template, GetType)
-			NANX_METHOD_APPLY(prototype_template, GetBodyA)
-			NANX_METHOD_APPLY(prototype_template, GetBodyB)
-			NANX_METHOD_APPLY(prototype_template, GetAnchorA)
-			NANX_METHOD_APPLY(prototype_template, GetAnchorB)
-			NANX_METHOD_APPLY(prototype_template, GetReactionForce)
-			NANX_METHOD_APPLY(prototype_template, GetReactionTorque)
-			NANX_METHOD_APPLY(prototype_template, GetNext)
-			NANX_METHOD_APPLY(prototype_template, GetUserData)
-			NANX_METHOD_APPLY(prototype_template, SetUserData)
-			NANX_METHOD_APPLY(prototype_template, IsActive)
-			NANX_METHOD_APPLY(prototype_template, GetCollideConnected)
-			g_function_template.Reset(function_template);
+			points.push_back(vertices[i]);
 		}
-		v8::Local<v8::FunctionTemplate> function_template = Nan::New<v8::FunctionTemplate>(g_function_template);
-		return scope.Escape(function_template);
 	}
-private:
-	NANX_METHOD(GetType)
+	while ((points.size() > 1) && (b2DistanceSquared(points.front(), points.back()) <= weld_sq))
 	{
-		WrapJoint* wrap = Unwrap(info.This());
-		info.GetReturnValue().Set(Nan::New(wrap->GetJoint()->GetType()));
+		points.pop_back();
 	}
-	NANX_METHOD(GetBodyA)
+	if (points.size() < 3) { return false; }
+
+	// wind counter-clockwise
+	float32 area = 0.0f;
+	for (size_t i = 0, n = points.size(); i < n; ++i)
 	{
-		WrapJoint* wrap = Unwrap(info.This());
-		if (!wrap->m_joint_bodyA.IsEmpty())
-		{
-			info.GetReturnValue().Set(Nan::New<v8::Object>(wrap->m_joint_bodyA));
-		}
-		else
-		{
-			info.GetReturnValue().SetNull();
-		}
+		area += b2Cross(points[i], points[(i + 1) % n]);
 	}
-	NANX_METHOD(GetBodyB)
+	if (0.5f * b2Abs(area) <= weld_sq) { return false; }
+	if (area < 0.0f)
 	{
-		WrapJoint* wrap = Unwrap(info.This());
-		if (!wrap->m_joint_bodyB.IsEmpty())
+		std::reverse(points.begin(), points.end());
+	}
+
+	// ear clipping; the walk only moves on past vertices that are not ears, so a full lap without
+	// one means the outline crosses itself, unless a collinear vertex can be dropped first
+	DecomposeRing ring(points);
+	std::vector< std::vector<int32> > polys;
+	std::vector< std::pair<int32,int32> > diagonals;
+	int32 remaining = static_cast<int32>(points.size());
+	int32 v = 0;
+	int32 misses = 0;
+	while (remaining > 3)
+	{
+		if (ring.Ear(v))
 		{
-			info.GetReturnValue().Set(Nan::New<v8::Object>(wrap->m_joint_bodyB));
+			const int32 a = ring.Prev(v);
+			const int32 c = ring.Next(v);
+			std::vector<int32> tri;
+			tri.push_back(a);
+			tri.push_back(v);
+			tri.push_back(c);
+			polys.push_back(tri);
+			diagonals.push_back(std::make_pair(a, c));
+			ring.Remove(v);
+			--remaining;
+			v = a;
+			misses = 0;
+			continue;
 		}
-		else
+		v = ring.Next(v);
+		if (++misses < remaining) { continue; }
+		int32 collinear = -1;
+		for (int32 k = 0, x = v; (k < remaining) && (collinear < 0); ++k, x = ring.Next(x))
 		{
-			info.GetReturnValue().SetNull();
+			if (ring.IsCollinear(x)) { collinear = x; }
 		}
+		if (collinear < 0) { return false; }
+		v = ring.Prev(collinear);
+		ring.Remove(collinear);
+		--remaining;
+		ring.Refresh(v, remaining);
+		misses = 0;
 	}
-	NANX_METHOD(GetAnchorA)
-	{
-		WrapJoint* wrap = Unwrap(info.This());
-		v8::Local<v8::Object> out = info[0]->IsUndefined() ? WrapVec2::NewInstance() : v8::Local<v8::Object>::Cast(info[0]);
-		WrapVec2::Unwrap(out)->SetVec2(wrap->GetJoint()->GetAnchorA());
-		info.GetReturnValue().Set(out);
-	}
-	NANX_METHOD(GetAnchorB)
+	if (ring.Cross(v) > 0.0f)
 	{
-		WrapJoint* wrap = Unwrap(info.This());
-		v8::Local<v8::Object> out = info[0]->IsUndefined() ? WrapVec2::NewInstance() : v8::Local<v8::Object>::Cast(info[0]);
-		WrapVec2::Unwrap(out)->SetVec2(wrap->GetJoint()->GetAnchorB());
-		info.GetReturnValue().Set(out);
+		std::vector<int32> tri;
+		tri.push_back(ring.Prev(v));
+		tri.push_back(v);
+		tri.push_back(ring.Next(v));
+		polys.push_back(tri);
 	}
-	NANX_METHOD(GetReactionForce)
+
+	// merge neighbours across each diagonal once
+	std::map<std::pair<int32,int32>,int32> edges;
+	for (size_t p = 0; p < polys.size(); ++p)
 	{
-		WrapJoint* wrap = Unwrap(info.This());
-		float32 inv_dt = NANX_float32(info[0]);
-		v8::Local<v8::Object> out = info[1]->IsUndefined() ? WrapVec2::NewInstance() : v8::Local<v8::Object>::Cast(info[1]);
-		WrapVec2::Unwrap(out)->SetVec2(wrap->GetJoint()->GetReactionForce(inv_dt));
-		info.GetReturnValue().Set(out);
+		for (size_t i = 0; i < 3; ++i)
+		{
+			edges[std::make_pair(polys[p][i], polys[p][(i + 1) % 3])] = static_cast<int32>(p);
+		}
 	}
-	NANX_METHOD(GetReactionTorque)
+	for (size_t d = 0; d < diagonals.size(); ++d)
 	{
-		WrapJoint* wrap = Unwrap(info.This());
-		float32 inv_dt = NANX_float32(info[0]);
-		info.GetReturnValue().Set(Nan::New(wrap->GetJoint()->GetReactionTorque(inv_dt)));
+		DecomposeMergeDiagonal(points, polys, edges, diagonals[d].first, diagonals[d].second);
 	}
-	NANX_METHOD(GetNext)
+
+	// emit convex pieces, dropping slivers
+	for (size_t p = 0; p < polys.size(); ++p)
 	{
-		WrapJoint* wrap = Unwrap(info.This());
-		b2Joint* joint = wrap->GetJoint()->GetNext();
-		if (joint)
+		b2Vec2 piece[b2_maxPolygonVertices];
+		const int32 n = static_cast<int32>(polys[p].size());
+		int32 piece_count = 0;
+		float32 piece_area = 0.0f;
+		for (int32 i = 0; i < n; ++i)
 		{
-			// get joint internal data
-			WrapJoint* wrap_joint = WrapJoint::GetWrap(joint);
-			info.GetReturnValue().Set(wrap_joint->handle());
+			const b2Vec2& a = points[polys[p][(i + n - 1) % n]];
+			const b2Vec2& b = points[polys[p][i]];
+			const b2Vec2& c = points[polys[p][(i + 1) % n]];
+			piece_area += b2Cross(b, c);
+			if ((DecomposeCross(a, b, c) > b2_epsilon) && (piece_count < b2_maxPolygonVertices))
+			{
+				piece[piece_count++] = b;
+			}
 		}
-		else
+		if ((piece_count < 3) || (0.5f * piece_area <= weld_sq)) { continue; }
+		// vertices closer than half a linear slop are welded by box2d; skip pieces that would collapse
+		int32 unique_count = 0;
+		for (int32 i = 0; i < piece_count; ++i)
 		{
-			info.GetReturnValue().SetNull();
-		}
-	}
-	NANX_METHOD(GetUserData)
-	{
-		WrapJoint* wrap = Unwrap(info.This());
-		if (!wrap->m_joint_userData.IsEmpty())
-		{
-			info.GetReturnValue().Set(Nan::New<v8::Value>(wrap->m_joint_userData));
-		}
-		else
-		{
-			info.GetReturnValue().SetNull();
-		}
-	}
-	NANX_METHOD(SetUserData)
-	{
-		WrapJoint* wrap = Unwrap(info.This());
-		if (!info[0]->IsUndefined())
-		{
-			wrap->m_joint_userData.Reset(info[0]);
-		}
-		else
-		{
-			wrap->m_joint_userData.Reset();
+			bool unique = true;
+			for (int32 j = 0; (j < i) && unique; ++j)
+			{
+				unique = b2DistanceSquared(piece[i], piece[j]) > (0.25f * weld_sq);
+			}
+			if (unique) { ++unique_count; }
 		}
+		if (unique_count < 3) { continue; }
+		b2PolygonShape polygon;
+		polygon.Set(piece, piece_count);
+		out.push_back(polygon);
 	}
-	NANX_METHOD(IsActive)
-	{
-		WrapJoint* wrap = Unwrap(info.This());
-		info.GetReturnValue().Set(Nan::New(wrap->GetJoint()->IsActive()));
-	}
-	NANX_METHOD(GetCollideConnected)
+	return true;
+}
+
+//// b2Body
+
+// a body stepped at a reduced rate by b2World.SetBodyTickDivisor
+struct BodyTick
+{
+	int32 divisor; // 2, 4 or 8; bodies at full rate have no entry
+	int32 phase; // offset in steps, so regions can be staggered
+	uint32 visit; // step this body's island was last classified
+	bool promoted; // island touches a body at another rate; runs at full rate this step
+	bool scaled; // stepped with divisor * dt this step
+	bool frozen; // put to sleep between its steps; velocity kept below
+	b2Vec2 linear_velocity;
+	float32 angular_velocity;
+	float32 gravity_scale, linear_damping, angular_damping; // restored after a scaled step
+	float32 rest_time; // time spent under the sleep tolerances on its own steps
+	// b2Body has no getter for its force accumulators and SetAwake(false) zeroes them,
+	// so forces applied through the wrappers or a replay are summed here as well
+	b2Vec2 force; // about the center of mass, since the last step
+	float32 torque; // including the moment of off center forces
+	b2Vec2 dropped_force; // the part b2Body lost while frozen; applied again when thawed
+	float32 dropped_torque;
+	BodyTick() :
+		divisor(1), phase(0), visit(0), promoted(false), scaled(false), frozen(false),
+		linear_velocity(b2Vec2_zero), angular_velocity(0.0f),
+		gravity_scale(1.0f), linear_damping(0.0f), angular_damping(0.0f), rest_time(0.0f),
+		force(b2Vec2_zero), torque(0.0f), dropped_force(b2Vec2_zero), dropped_torque(0.0f) {}
+};
+typedef std::map<b2Body*,BodyTick> BodyTickMap;
+
+static BodyTick* FindBodyTick(BodyTickMap* ticks, const b2Body* body)
+{
+	if (!ticks || ticks->empty()) { return NULL; }
+	BodyTickMap::iterator it = ticks->find(const_cast<b2Body*>(body));
+	return (it != ticks->end())?(&it->second):(NULL);
+}
+
+// call after b2Body::ApplyForce/ApplyTorque; the engine ignores a force on a sleeping body unless woken
+static void AddTickForce(BodyTickMap* ticks, b2Body* body, const b2Vec2& force, float32 torque)
+{
+	BodyTick* tick = FindBodyTick(ticks, body);
+	if (!tick || (!body->IsAwake() && !tick->frozen)) { return; }
+	tick->force += force;
+	tick->torque += torque;
+	if (!body->IsAwake())
 	{
-		WrapJoint* wrap = Unwrap(info.This());
-		info.GetReturnValue().Set(Nan::New(wrap->GetJoint()->GetCollideConnected()));
+		tick->dropped_force += force;
+		tick->dropped_torque += torque;
 	}
-	///virtual void Dump() { b2Log("// Dump is not supported for this joint type.\n"); }
-	//virtual void ShiftOrigin(const b2Vec2& newOrigin) { B2_NOT_USED(newOrigin);  }
-};
+}
 
-//// b2RevoluteJointDef
+// call after b2Body::ApplyLinearImpulse/ApplyAngularImpulse; a frozen body not woken keeps it for later
+static void AddTickImpulse(BodyTickMap* ticks, b2Body* body, const b2Vec2& impulse, float32 angular_impulse)
+{
+	BodyTick* tick = FindBodyTick(ticks, body);
+	if (!tick || !tick->frozen || body->IsAwake()) { return; }
+	const float32 mass = body->GetMass();
+	const float32 inertia = body->GetInertia() - mass * b2Dot(body->GetLocalCenter(), body->GetLocalCenter());
+	tick->linear_velocity += ((mass > 0.0f)?(1.0f / mass):(0.0f)) * impulse;
+	tick->angular_velocity += ((inertia > 0.0f)?(1.0f / inertia):(0.0f)) * angular_impulse;
+}
 
-class WrapRevoluteJointDef : public WrapJointDef
+// call before b2Body::SetLinearVelocity/SetAngularVelocity; a set velocity replaces the one kept while frozen
+static void SetTickVelocity(BodyTickMap* ticks, b2Body* body, bool linear, bool angular)
+{
+	BodyTick* tick = FindBodyTick(ticks, body);
+	if (!tick || !tick->frozen) { return; }
+	if (linear) { tick->linear_velocity.SetZero(); }
+	if (angular) { tick->angular_velocity = 0.0f; }
+}
+
+// call before b2Body::SetAwake(false); a body put to sleep on purpose keeps nothing for later
+static void SleepBodyTick(BodyTickMap* ticks, b2Body* body)
+{
+	BodyTick* tick = FindBodyTick(ticks, body);
+	if (!tick) { return; }
+	tick->frozen = false;
+	tick->linear_velocity.SetZero();
+	tick->angular_velocity = 0.0f;
+	tick->force.SetZero();
+	tick->torque = 0.0f;
+	tick->dropped_force.SetZero();
+	tick->dropped_torque = 0.0f;
+}
+
+class WrapBody : public Nan::ObjectWrap
 {
 private:
-	b2RevoluteJointDef m_revolute_jd;
-	Nan::Persistent<v8::Object> m_wrap_localAnchorA; // m_revolute_jd.localAnchorA
-	Nan::Persistent<v8::Object> m_wrap_localAnchorB; // m_revolute_jd.localAnchorB
+	b2Body* m_body;
+	int32 m_body_id;
+	AllocStats* m_alloc_stats; // owning world's allocations
+	Recorder* m_recorder; // owning world's recorder
+	BodyTickMap* m_body_ticks; // owning world's reduced rate bodies
+	Nan::Persistent<v8::Object> m_body_world;
+	Nan::Persistent<v8::Value> m_body_userData;
 private:
-	WrapRevoluteJointDef()
+	WrapBody() : m_body(NULL), m_body_id(-1), m_alloc_stats(NULL), m_recorder(NULL), m_body_ticks(NULL) {}
+	~WrapBody()
 	{
-		m_wrap_localAnchorA.Reset(WrapVec2::NewInstance(m_revolute_jd.localAnchorA));
-		m_wrap_localAnchorB.Reset(WrapVec2::NewInstance(m_revolute_jd.localAnchorB));
+		m_body_world.Reset();
+		m_body_userData.Reset();
 	}
-	~WrapRevoluteJointDef()
+public:
+	b2Body* Peek() { return m_body; }
+	int32 GetId() const { return m_body_id; }
+public:
+	void SetupObject(v8::Local<v8::Object> h_world, WrapBodyDef* wrap_bd, b2Body* body, int32 body_id)
 	{
-		m_wrap_localAnchorA.Reset();
-		m_wrap_localAnchorB.Reset();
+		SetupObject(h_world, body, body_id, wrap_bd->GetUserDataHandle());
+	}
+	void SetupObject(v8::Local<v8::Object> h_world, b2Body* body, int32 body_id, v8::Local<v8::Value> h_userData)
+	{
+		m_body = body;
+		m_body_id = body_id;
+		// set body internal data
+		WrapBody::SetWrap(m_body, this);
+		// set reference to this body (prevent GC)
+		Ref();
+		// set reference to world object
+		m_body_world.Reset(h_world);
+		// set reference to user data object
+		m_body_userData.Reset(h_userData);
+	}
+	b2Body* ResetObject()
+	{
+		// clear reference to world object
+		m_body_world.Reset();
+		// clear reference to user data object
+		m_body_userData.Reset();
+		// clear reference to this body (allow GC)
+		Unref();
+		// clear body internal data
+		WrapBody::SetWrap(m_body, NULL);
+		b2Body* body = m_body;
+		m_body = NULL;
+		m_body_id = -1;
+		m_alloc_stats = NULL;
+		m_recorder = NULL;
+		m_body_ticks = NULL;
+		return body;
+	}
+	void SetAllocStats(AllocStats* stats) { m_alloc_stats = stats; }
+	void SetRecorder(Recorder* recorder) { m_recorder = recorder; }
+	void SetBodyTicks(BodyTickMap* ticks) { m_body_ticks = ticks; }
+	Recorder* Recording() { return (m_recorder && m_recorder->IsRecording())?(m_recorder):(NULL); }
+	int32 GetPersistentCount() const
+	{
+		// the object handle plus the references it holds
+		return 1 + (m_body_world.IsEmpty()?0:1) + (m_body_userData.IsEmpty()?0:1);
 	}
 public:
-	b2RevoluteJointDef* Peek() { return &m_revolute_jd; }
-	virtual b2JointDef& GetJointDef() { return m_revolute_jd; } // override WrapJointDef
-	virtual void SyncPull() // override WrapJointDef
+	static WrapBody* GetWrap(const b2Body* body)
 	{
-		// sync: pull data from javascript objects
-		WrapJointDef::SyncPull();
-		m_revolute_jd.localAnchorA = WrapVec2::Unwrap(Nan::New<v8::Object>(m_wrap_localAnchorA))->GetVec2(); // struct copy
-		m_revolute_jd.localAnchorB = WrapVec2::Unwrap(Nan::New<v8::Object>(m_wrap_localAnchorB))->GetVec2(); // struct copy
+		return static_cast<WrapBody*>(body->GetUserData());
 	}
-	virtual void SyncPush() // override WrapJointDef
+	static void SetWrap(b2Body* body, WrapBody* wrap)
 	{
-		// sync: push data into javascript objects
-		WrapJointDef::SyncPush();
-		WrapVec2::Unwrap(Nan::New<v8::Object>(m_wrap_localAnchorA))->SetVec2(m_revolute_jd.localAnchorA);
-		WrapVec2::Unwrap(Nan::New<v8::Object>(m_wrap_localAnchorB))->SetVec2(m_revolute_jd.localAnchorB);
+		body->SetUserData(wrap);
 	}
 public:
-	static WrapRevoluteJointDef* Unwrap(v8::Local<v8::Value> value) { return (value->IsObject())?(Unwrap(v8::Local<v8::Object>::Cast(value))):(NULL); }
-	static WrapRevoluteJointDef* Unwrap(v8::Local<v8::Object> object) { return Nan::ObjectWrap::Unwrap<WrapRevoluteJointDef>(object); }
-	static b2RevoluteJointDef* Peek(v8::Local<v8::Value> value) { WrapRevoluteJointDef* wrap = Unwrap(value); return (wrap)?(wrap->Peek()):(NULL); }
+	static WrapBody* Unwrap(v8::Local<v8::Value> value) { return (value->IsObject())?(Unwrap(v8::Local<v8::Object>::Cast(value))):(NULL); }
+	static WrapBody* Unwrap(v8::Local<v8::Object> object) { return Nan::ObjectWrap::Unwrap<WrapBody>(object); }
+	static b2Body* Peek(v8::Local<v8::Value> value) { WrapBody* wrap = Unwrap(value); return (wrap)?(wrap->Peek()):(NULL); }
 public:
 	static NAN_MODULE_INIT(Init)
 	{
 		v8::Local<v8::Function> constructor = GetConstructor();
 		target->Set(constructor->GetName(), constructor);
 	}
+	static v8::Local<v8::Object> NewInstance()
+	{
+		Nan::EscapableHandleScope scope;
+		v8::Local<v8::Function> constructor = GetConstructor();
+		v8::Local<v8::Object> instance = constructor->NewInstance();
+		return scope.Escape(instance);
+	}
+
+private:
 	static v8::Local<v8::Function> GetConstructor()
 	{
 		Nan::EscapableHandleScope scope;
@@ -2824,20 +4781,64 @@ public:
 		if (g_function_template.IsEmpty())
 		{
 			v8::Local<v8::FunctionTemplate> function_template = Nan::New<v8::FunctionTemplate>(New);
-			function_template->Inherit(WrapJointDef::GetFunctionTemplate());
-			function_template->SetClassName(NANX_SYMBOL("b2RevoluteJointDef"));
+			function_template->SetClassName(NANX_SYMBOL("b2Body"));
 			function_template->InstanceTemplate()->SetInternalFieldCount(1);
 			v8::Local<v8::ObjectTemplate> prototype_template = function_template->PrototypeTemplate();
-			NANX_MEMBER_APPLY(prototype_template, localAnchorA)
-			NANX_MEMBER_APPLY(prototype_template, localAnchorB)
-			NANX_MEMBER_APPLY(prototype_template, referenceAngle)
-			NANX_MEMBER_APPLY(prototype_template, enableLimit)
-			NANX_MEMBER_APPLY(prototype_template, lowerAngle)
-			NANX_MEMBER_APPLY(prototype_template, upperAngle)
-			NANX_MEMBER_APPLY(prototype_template, enableMotor)
-			NANX_MEMBER_APPLY(prototype_template, motorSpeed)
-			NANX_MEMBER_APPLY(prototype_template, maxMotorTorque)
-			NANX_METHOD_APPLY(prototype_template, Initialize)
+			NANX_METHOD_APPLY(prototype_template, CreateFixture)
+			NANX_METHOD_APPLY(prototype_template, CreatePolygonFixtures)
+			NANX_METHOD_APPLY(prototype_template, DestroyFixture)
+			NANX_METHOD_APPLY(prototype_template, SetTransform)
+			NANX_METHOD_APPLY(prototype_template, GetTransform)
+			NANX_METHOD_APPLY(prototype_template, GetPosition)
+			NANX_METHOD_APPLY(prototype_template, GetAngle)
+			NANX_METHOD_APPLY(prototype_template, GetWorldCenter)
+			NANX_METHOD_APPLY(prototype_template, GetLocalCenter)
+			NANX_METHOD_APPLY(prototype_template, SetLinearVelocity)
+			NANX_METHOD_APPLY(prototype_template, GetLinearVelocity)
+			NANX_METHOD_APPLY(prototype_template, SetAngularVelocity)
+			NANX_METHOD_APPLY(prototype_template, GetAngularVelocity)
+			NANX_METHOD_APPLY(prototype_template, ApplyForce)
+			NANX_METHOD_APPLY(prototype_template, ApplyForceToCenter)
+			NANX_METHOD_APPLY(prototype_template, ApplyTorque)
+			NANX_METHOD_APPLY(prototype_template, ApplyLinearImpulse)
+			NANX_METHOD_APPLY(prototype_template, ApplyLinearImpulseToCenter)
+			NANX_METHOD_APPLY(prototype_template, ApplyAngularImpulse)
+			NANX_METHOD_APPLY(prototype_template, GetMass)
+			NANX_METHOD_APPLY(prototype_template, GetInertia)
+			NANX_METHOD_APPLY(prototype_template, GetMassData)
+			NANX_METHOD_APPLY(prototype_template, SetMassData)
+			NANX_METHOD_APPLY(prototype_template, ResetMassData)
+			NANX_METHOD_APPLY(prototype_template, GetWorldPoint)
+			NANX_METHOD_APPLY(prototype_template, GetWorldVector)
+			NANX_METHOD_APPLY(prototype_template, GetLocalPoint)
+			NANX_METHOD_APPLY(prototype_template, GetLocalVector)
+			NANX_METHOD_APPLY(prototype_template, GetLinearVelocityFromWorldPoint)
+			NANX_METHOD_APPLY(prototype_template, GetLinearVelocityFromLocalPoint)
+			NANX_METHOD_APPLY(prototype_template, GetLinearDamping)
+			NANX_METHOD_APPLY(prototype_template, SetLinearDamping)
+			NANX_METHOD_APPLY(prototype_template, GetAngularDamping)
+			NANX_METHOD_APPLY(prototype_template, SetAngularDamping)
+			NANX_METHOD_APPLY(prototype_template, GetGravityScale)
+			NANX_METHOD_APPLY(prototype_template, SetGravityScale)
+			NANX_METHOD_APPLY(prototype_template, SetType)
+			NANX_METHOD_APPLY(prototype_template, GetType)
+			NANX_METHOD_APPLY(prototype_template, SetBullet)
+			NANX_METHOD_APPLY(prototype_template, IsBullet)
+			NANX_METHOD_APPLY(prototype_template, SetSleepingAllowed)
+			NANX_METHOD_APPLY(prototype_template, IsSleepingAllowed)
+			NANX_METHOD_APPLY(prototype_template, SetAwake)
+			NANX_METHOD_APPLY(prototype_template, IsAwake)
+			NANX_METHOD_APPLY(prototype_template, SetActive)
+			NANX_METHOD_APPLY(prototype_template, IsActive)
+			NANX_METHOD_APPLY(prototype_template, SetFixedRotation)
+			NANX_METHOD_APPLY(prototype_template, IsFixedRotation)
+			NANX_METHOD_APPLY(prototype_template, GetFixtureList)
+			NANX_METHOD_APPLY(prototype_template, GetNext)
+			NANX_METHOD_APPLY(prototype_template, GetUserData)
+			NANX_METHOD_APPLY(prototype_template, SetUserData)
+			NANX_METHOD_APPLY(prototype_template, GetWorld)
+			NANX_METHOD_APPLY(prototype_template, ShouldCollideConnected)
+			NANX_METHOD_APPLY(prototype_template, GetId)
 			g_function_template.Reset(function_template);
 		}
 		v8::Local<v8::FunctionTemplate> function_template = Nan::New<v8::FunctionTemplate>(g_function_template);
@@ -2846,357 +4847,510 @@ public:
 private:
 	static NAN_METHOD(New)
 	{
-		WrapRevoluteJointDef* wrap = new WrapRevoluteJointDef();
+		WrapBody* wrap = new WrapBody();
 		wrap->Wrap(info.This());
 		info.GetReturnValue().Set(info.This());
 	}
-	NANX_MEMBER_OBJECT	(localAnchorA) // m_wrap_localAnchorA
-	NANX_MEMBER_OBJECT	(localAnchorB) // m_wrap_localAnchorB
-	NANX_MEMBER_NUMBER	(float32, referenceAngle)
-	NANX_MEMBER_BOOLEAN	(bool, enableLimit)
-	NANX_MEMBER_NUMBER	(float32, lowerAngle)
-	NANX_MEMBER_NUMBER	(float32, upperAngle)
-	NANX_MEMBER_BOOLEAN	(bool, enableMotor)
-	NANX_MEMBER_NUMBER	(float32, motorSpeed)
-	NANX_MEMBER_NUMBER	(float32, maxMotorTorque)
-	NANX_METHOD(Initialize)
+	NANX_METHOD(CreateFixture)
 	{
-		WrapRevoluteJointDef* wrap = Unwrap(info.This());
-		WrapBody* wrap_bodyA = WrapBody::Unwrap(v8::Local<v8::Object>::Cast(info[0]));
-		WrapBody* wrap_bodyB = WrapBody::Unwrap(v8::Local<v8::Object>::Cast(info[1]));
-		WrapVec2* wrap_anchor = WrapVec2::Unwrap(v8::Local<v8::Object>::Cast(info[2]));
-		wrap->SyncPull();
-		wrap->m_revolute_jd.Initialize(wrap_bodyA->Peek(), wrap_bodyB->Peek(), wrap_anchor->GetVec2());
-		wrap->SyncPush();
+		WrapBody* wrap = Unwrap(info.This());
+		WrapFixtureDef* wrap_fd = WrapFixtureDef::Unwrap(v8::Local<v8::Object>::Cast(info[0]));
+		AllocScope alloc_scope(wrap->m_alloc_stats);
+		// create box2d fixture
+		const b2FixtureDef& fd = wrap_fd->UseFixtureDef();
+		b2Fixture* fixture = wrap->m_body->CreateFixture(&fd);
+		Recorder* recorder = wrap->Recording();
+		if (recorder) { recorder->Op(e_recordCreateFixture).Int(wrap->m_body_id).Int(recorder->AddFixture(fixture)).Material(fd).Shape(fd.shape); }
+		// create javascript fixture object
+		v8::Local<v8::Object> h_fixture = WrapFixture::NewInstance();
+		WrapFixture* wrap_fixture = WrapFixture::Unwrap(h_fixture);
+		// set up javascript fixture object
+		wrap_fixture->SetupObject(info.This(), wrap_fd, fixture);
+		wrap_fixture->SetRecorder(wrap->m_recorder);
+		info.GetReturnValue().Set(h_fixture);
 	}
-};
-
-//// b2RevoluteJoint
-
-class WrapRevoluteJoint : public WrapJoint
-{
-private:
-	b2RevoluteJoint* m_revolute_joint;
-private:
-	WrapRevoluteJoint() : m_revolute_joint(NULL) {}
-	~WrapRevoluteJoint() {}
-public:
-	b2RevoluteJoint* Peek() { return m_revolute_joint; }
-	virtual b2Joint* GetJoint() { return m_revolute_joint; } // override WrapJoint
-	void SetupObject(v8::Local<v8::Object> h_world, WrapRevoluteJointDef* wrap_revolute_jd, b2RevoluteJoint* revolute_joint)
+	NANX_METHOD(CreatePolygonFixtures)
 	{
-		m_revolute_joint = revolute_joint;
-		WrapJoint::SetupObject(h_world, wrap_revolute_jd);
+		WrapBody* wrap = Unwrap(info.This());
+		Nan::TypedArrayContents<float32> h_outline(info[0]);
+		WrapFixtureDef* wrap_fd = WrapFixtureDef::Unwrap(v8::Local<v8::Object>::Cast(info[1]));
+		int32 count = (info.Length() > 2 && !info[2]->IsUndefined())?(NANX_int32(info[2])):(static_cast<int32>(h_outline.length() / 2));
+		count = b2Clamp(count, 0, static_cast<int32>(h_outline.length() / 2));
+		if (count < 3)
+		{
+			return Nan::ThrowRangeError("outline needs at least 3 vertices");
+		}
+		// decompose outline into convex polygons
+		std::vector<b2PolygonShape> polygons;
+		if (!DecomposePolygon(reinterpret_cast<const b2Vec2*>(*h_outline), count, polygons))
+		{
+			return Nan::ThrowError("outline is degenerate or self intersecting");
+		}
+		// fixtures are created massless so the body mass is only computed once
+		b2FixtureDef fd = wrap_fd->UseFixtureDef(); // struct copy
+		float32 density = fd.density;
+		fd.density = 0.0f;
+		v8::Local<v8::Value> h_userData = wrap_fd->GetUserDataHandle();
+		v8::Local<v8::Array> h_fixtures = Nan::New<v8::Array>(static_cast<int>(polygons.size()));
+		AllocScope alloc_scope(wrap->m_alloc_stats);
+		Recorder* recorder = wrap->Recording();
+		for (size_t i = 0; i < polygons.size(); ++i)
+		{
+			fd.shape = &polygons[i];
+			// create box2d fixture
+			b2Fixture* fixture = wrap->m_body->CreateFixture(&fd);
+			fixture->SetDensity(density);
+			if (recorder)
+			{
+				int32 fixture_id = recorder->AddFixture(fixture);
+				recorder->Op(e_recordCreateFixture).Int(wrap->m_body_id).Int(fixture_id).Material(fd).Shape(fd.shape);
+				recorder->Op(e_recordSetFixtureFloat).Int(fixture_id).Uint8(e_recordDensity).Float(density);
+			}
+			// create javascript fixture object
+			v8::Local<v8::Object> h_fixture = WrapFixture::NewInstance();
+			WrapFixture* wrap_fixture = WrapFixture::Unwrap(h_fixture);
+			// set up javascript fixture object
+			wrap_fixture->SetupObject(info.This(), fixture, h_userData);
+			wrap_fixture->SetRecorder(wrap->m_recorder);
+			h_fixtures->Set(static_cast<uint32_t>(i), h_fixture);
+		}
+		if (!polygons.empty())
+		{
+			if (recorder) { recorder->Op(e_recordResetMassData).Int(wrap->m_body_id); }
+			wrap->m_body->ResetMassData();
+		}
+		info.GetReturnValue().Set(h_fixtures);
 	}
-	b2RevoluteJoint* ResetObject()
+	NANX_METHOD(DestroyFixture)
 	{
-		WrapJoint::ResetObject();
-		b2RevoluteJoint* revolute_joint = m_revolute_joint;
-		m_revolute_joint = NULL;
-		return revolute_joint;
-	}
-public:
-	static WrapRevoluteJoint* Unwrap(v8::Local<v8::Value> value) { return (value->IsObject())?(Unwrap(v8::Local<v8::Object>::Cast(value))):(NULL); }
-	static WrapRevoluteJoint* Unwrap(v8::Local<v8::Object> object) { return Nan::ObjectWrap::Unwrap<WrapRevoluteJoint>(object); }
-	static b2RevoluteJoint* Peek(v8::Local<v8::Value> value) { WrapRevoluteJoint* wrap = Unwrap(value); return (wrap)?(wrap->Peek()):(NULL); }
-public:
-	static NAN_MODULE_INIT(Init)
-	{
-		v8::Local<v8::Function> constructor = GetConstructor();
-		target->Set(constructor->GetName(), constructor);
-	}
-	static v8::Local<v8::Function> GetConstructor()
-	{
-		Nan::EscapableHandleScope scope;
-		v8::Local<v8::FunctionTemplate> function_template = GetFunctionTemplate();
-		v8::Local<v8::Function> constructor = function_template->GetFunction();
-		return scope.Escape(constructor);
-	}
-	static v8::Local<v8::FunctionTemplate> GetFunctionTemplate()
-	{
-		Nan::EscapableHandleScope scope;
-		static Nan::Persistent<v8::FunctionTemplate> g_function_template;
-		if (g_function_template.IsEmpty())
+		WrapBody* wrap = Unwrap(info.This());
+		v8::Local<v8::Object> h_fixture = v8::Local<v8::Object>::Cast(info[0]);
+		WrapFixture* wrap_fixture = WrapFixture::Unwrap(h_fixture);
+		AllocScope alloc_scope(wrap->m_alloc_stats);
+		Recorder* recorder = wrap->Recording();
+		if (recorder)
 		{
-			v8::Local<v8::FunctionTemplate> function_template = Nan::New<v8::FunctionTemplate>(New);
-			function_template->SetClassName(NANX_SYMBOL("b2RevoluteJoint"));
-			function_template->InstanceTemplate()->SetInternalFieldCount(1);
-			v8::Local<v8::ObjectTemplate> prototype_template = function_template->PrototypeTemplate();
-			NANX_METHOD_APPLY(prototype_template, GetLocalAnchorA)
-			NANX_METHOD_APPLY(prototype_template, GetLocalAnchorB)
-			NANX_METHOD_APPLY(prototype_template, GetReferenceAngle)
-			NANX_METHOD_APPLY(prototype_template, GetJointAngle)
-			NANX_METHOD_APPLY(prototype_template, GetJointSpeed)
-			NANX_METHOD_APPLY(prototype_template, IsLimitEnabled)
-			NANX_METHOD_APPLY(prototype_template, EnableLimit)
-			NANX_METHOD_APPLY(prototype_template, GetLowerLimit)
-			NANX_METHOD_APPLY(prototype_template, GetUpperLimit)
-			NANX_METHOD_APPLY(prototype_template, SetLimits)
-			NANX_METHOD_APPLY(prototype_template, IsMotorEnabled)
-			NANX_METHOD_APPLY(prototype_template, EnableMotor)
-			NANX_METHOD_APPLY(prototype_template, SetMotorSpeed)
-			NANX_METHOD_APPLY(prototype_template, GetMotorSpeed)
-			NANX_METHOD_APPLY(prototype_template, SetMaxMotorTorque)
-			NANX_METHOD_APPLY(prototype_template, GetMaxMotorTorque)
-			NANX_METHOD_APPLY(prototype_template, GetMotorTorque)
-			g_function_template.Reset(function_template);
+			recorder->Op(e_recordDestroyFixture).Int(recorder->GetFixtureId(wrap_fixture->Peek()));
+			recorder->RemoveFixture(wrap_fixture->Peek());
 		}
-		v8::Local<v8::FunctionTemplate> function_template = Nan::New<v8::FunctionTemplate>(g_function_template);
-		return scope.Escape(function_template);
+		// delete box2d fixture
+		wrap->m_body->DestroyFixture(wrap_fixture->Peek());
+		// reset javascript fixture object
+		wrap_fixture->ResetObject();
 	}
-	static v8::Local<v8::Object> NewInstance()
+	NANX_METHOD(SetTransform)
 	{
-		Nan::EscapableHandleScope scope;
-		v8::Local<v8::Function> constructor = GetConstructor();
-		v8::Local<v8::Object> instance = constructor->NewInstance();
-		return scope.Escape(instance);
+		WrapBody* wrap = Unwrap(info.This());
+		WrapVec2* position = WrapVec2::Unwrap(v8::Local<v8::Object>::Cast(info[0]));
+		float32 angle = NANX_float32(info[1]);
+		AllocScope alloc_scope(wrap->m_alloc_stats);
+		Recorder* recorder = wrap->Recording();
+		if (recorder) { recorder->Op(e_recordSetTransform).Int(wrap->m_body_id).Vec2(position->GetVec2()).Float(angle); }
+		wrap->m_body->SetTransform(position->GetVec2(), angle);
 	}
-private:
-	static NAN_METHOD(New)
+	NANX_METHOD(GetTransform)
 	{
-		WrapRevoluteJoint* wrap = new WrapRevoluteJoint();
-		wrap->Wrap(info.This());
-		info.GetReturnValue().Set(info.This());
+		WrapBody* wrap = Unwrap(info.This());
+		v8::Local<v8::Object> out = info[0]->IsUndefined() ? WrapTransform::NewInstance() : v8::Local<v8::Object>::Cast(info[0]);
+		WrapTransform::Unwrap(out)->SetTransform(wrap->m_body->GetTransform());
+		info.GetReturnValue().Set(out);
 	}
-	///	b2Vec2 GetAnchorA() const;
-	///	b2Vec2 GetAnchorB() const;
-	///	b2Vec2 GetReactionForce(float32 inv_dt) const;
-	///	float32 GetReactionTorque(float32 inv_dt) const;
-	NANX_METHOD(GetLocalAnchorA)
+	NANX_METHOD(GetPosition)
 	{
-		WrapRevoluteJoint* wrap = Unwrap(info.This());
+		WrapBody* wrap = Unwrap(info.This());
 		v8::Local<v8::Object> out = info[0]->IsUndefined() ? WrapVec2::NewInstance() : v8::Local<v8::Object>::Cast(info[0]);
-		WrapVec2::Unwrap(out)->SetVec2(wrap->m_revolute_joint->GetLocalAnchorA());
+		WrapVec2::Unwrap(out)->SetVec2(wrap->m_body->GetPosition());
 		info.GetReturnValue().Set(out);
 	}
-	NANX_METHOD(GetLocalAnchorB)
+	NANX_METHOD(GetAngle) { WrapBody* wrap = Unwrap(info.This()); info.GetReturnValue().Set(Nan::New(wrap->m_body->GetAngle())); }
+	NANX_METHOD(GetWorldCenter)
 	{
-		WrapRevoluteJoint* wrap = Unwrap(info.This());
+		WrapBody* wrap = Unwrap(info.This());
 		v8::Local<v8::Object> out = info[0]->IsUndefined() ? WrapVec2::NewInstance() : v8::Local<v8::Object>::Cast(info[0]);
-		WrapVec2::Unwrap(out)->SetVec2(wrap->m_revolute_joint->GetLocalAnchorB());
+		WrapVec2::Unwrap(out)->SetVec2(wrap->m_body->GetWorldCenter());
 		info.GetReturnValue().Set(out);
 	}
-	NANX_METHOD(GetReferenceAngle)
+	NANX_METHOD(GetLocalCenter)
 	{
-		WrapRevoluteJoint* wrap = Unwrap(info.This());
-		info.GetReturnValue().Set(Nan::New(wrap->m_revolute_joint->GetReferenceAngle()));
+		WrapBody* wrap = Unwrap(info.This());
+		v8::Local<v8::Object> out = info[0]->IsUndefined() ? WrapVec2::NewInstance() : v8::Local<v8::Object>::Cast(info[0]);
+		WrapVec2::Unwrap(out)->SetVec2(wrap->m_body->GetLocalCenter());
+		info.GetReturnValue().Set(out);
 	}
-	NANX_METHOD(GetJointAngle)
+	NANX_METHOD(SetLinearVelocity)
 	{
-		WrapRevoluteJoint* wrap = Unwrap(info.This());
-		info.GetReturnValue().Set(Nan::New(wrap->m_revolute_joint->GetJointAngle()));
+		WrapBody* wrap = Unwrap(info.This());
+		const b2Vec2& v = WrapVec2::Unwrap(v8::Local<v8::Object>::Cast(info[0]))->GetVec2();
+		Recorder* recorder = wrap->Recording();
+		if (recorder) { recorder->Op(e_recordSetLinearVelocity).Int(wrap->m_body_id).Vec2(v); }
+		SetTickVelocity(wrap->m_body_ticks, wrap->m_body, true, false);
+		wrap->m_body->SetLinearVelocity(v);
 	}
-	NANX_METHOD(GetJointSpeed)
+	NANX_METHOD(GetLinearVelocity)
 	{
-		WrapRevoluteJoint* wrap = Unwrap(info.This());
-		info.GetReturnValue().Set(Nan::New(wrap->m_revolute_joint->GetJointSpeed()));
+		WrapBody* wrap = Unwrap(info.This());
+		v8::Local<v8::Object> out = info[0]->IsUndefined() ? WrapVec2::NewInstance() : v8::Local<v8::Object>::Cast(info[0]);
+		WrapVec2::Unwrap(out)->SetVec2(wrap->m_body->GetLinearVelocity());
+		info.GetReturnValue().Set(out);
 	}
-	NANX_METHOD(IsLimitEnabled)
+	NANX_METHOD(SetAngularVelocity)
 	{
-		WrapRevoluteJoint* wrap = Unwrap(info.This());
-		info.GetReturnValue().Set(Nan::New(wrap->m_revolute_joint->IsLimitEnabled()));
+		WrapBody* wrap = Unwrap(info.This());
+		float32 w = NANX_float32(info[0]);
+		Recorder* recorder = wrap->Recording();
+		if (recorder) { recorder->Op(e_recordSetAngularVelocity).Int(wrap->m_body_id).Float(w); }
+		SetTickVelocity(wrap->m_body_ticks, wrap->m_body, false, true);
+		wrap->m_body->SetAngularVelocity(w);
 	}
-	NANX_METHOD(EnableLimit)
+	NANX_METHOD(GetAngularVelocity) { WrapBody* wrap = Unwrap(info.This()); info.GetReturnValue().Set(Nan::New(wrap->m_body->GetAngularVelocity())); }
+	NANX_METHOD(ApplyForce)
 	{
-		WrapRevoluteJoint* wrap = Unwrap(info.This());
-		wrap->m_revolute_joint->EnableLimit(NANX_bool(info[0]));
+		WrapBody* wrap = Unwrap(info.This());
+		WrapVec2* force = WrapVec2::Unwrap(v8::Local<v8::Object>::Cast(info[0]));
+		WrapVec2* point = WrapVec2::Unwrap(v8::Local<v8::Object>::Cast(info[1]));
+		bool wake = (info.Length() > 2) ? NANX_bool(info[2]) : true;
+		Recorder* recorder = wrap->Recording();
+		if (recorder) { recorder->Op(e_recordApplyForce).Int(wrap->m_body_id).Vec2(force->GetVec2()).Vec2(point->GetVec2()).Bool(wake); }
+		wrap->m_body->ApplyForce(force->GetVec2(), point->GetVec2(), wake);
+		AddTickForce(wrap->m_body_ticks, wrap->m_body, force->GetVec2(), b2Cross(point->GetVec2() - wrap->m_body->GetWorldCenter(), force->GetVec2()));
 	}
-	NANX_METHOD(GetLowerLimit)
+	NANX_METHOD(ApplyForceToCenter)
 	{
-		WrapRevoluteJoint* wrap = Unwrap(info.This());
-		info.GetReturnValue().Set(Nan::New(wrap->m_revolute_joint->GetLowerLimit()));
+		WrapBody* wrap = Unwrap(info.This());
+		WrapVec2* force = WrapVec2::Unwrap(v8::Local<v8::Object>::Cast(info[0]));
+		bool wake = (info.Length() > 1) ? NANX_bool(info[1]) : true;
+		Recorder* recorder = wrap->Recording();
+		if (recorder) { recorder->Op(e_recordApplyForceToCenter).Int(wrap->m_body_id).Vec2(force->GetVec2()).Bool(wake); }
+		wrap->m_body->ApplyForceToCenter(force->GetVec2(), wake);
+		AddTickForce(wrap->m_body_ticks, wrap->m_body, force->GetVec2(), 0.0f);
 	}
-	NANX_METHOD(GetUpperLimit)
+	NANX_METHOD(ApplyTorque)
 	{
-		WrapRevoluteJoint* wrap = Unwrap(info.This());
-		info.GetReturnValue().Set(Nan::New(wrap->m_revolute_joint->GetUpperLimit()));
+		WrapBody* wrap = Unwrap(info.This());
+		float32 torque = NANX_float32(info[0]);
+		bool wake = (info.Length() > 1) ? NANX_bool(info[1]) : true;
+		Recorder* recorder = wrap->Recording();
+		if (recorder) { recorder->Op(e_recordApplyTorque).Int(wrap->m_body_id).Float(torque).Bool(wake); }
+		wrap->m_body->ApplyTorque(torque, wake);
+		AddTickForce(wrap->m_body_ticks, wrap->m_body, b2Vec2_zero, torque);
 	}
-	NANX_METHOD(SetLimits)
+	NANX_METHOD(ApplyLinearImpulse)
 	{
-		WrapRevoluteJoint* wrap = Unwrap(info.This());
-		wrap->m_revolute_joint->SetLimits(NANX_float32(info[0]), NANX_float32(info[1]));
+		WrapBody* wrap = Unwrap(info.This());
+		WrapVec2* impulse = WrapVec2::Unwrap(v8::Local<v8::Object>::Cast(info[0]));
+		WrapVec2* point = WrapVec2::Unwrap(v8::Local<v8::Object>::Cast(info[1]));
+		bool wake = (info.Length() > 2) ? NANX_bool(info[2]) : true;
+		Recorder* recorder = wrap->Recording();
+		if (recorder) { recorder->Op(e_recordApplyLinearImpulse).Int(wrap->m_body_id).Vec2(impulse->GetVec2()).Vec2(point->GetVec2()).Bool(wake); }
+		wrap->m_body->ApplyLinearImpulse(impulse->GetVec2(), point->GetVec2(), wake);
+		AddTickImpulse(wrap->m_body_ticks, wrap->m_body, impulse->GetVec2(), b2Cross(point->GetVec2() - wrap->m_body->GetWorldCenter(), impulse->GetVec2()));
 	}
-	NANX_METHOD(IsMotorEnabled)
+	NANX_METHOD(ApplyLinearImpulseToCenter)
 	{
-		WrapRevoluteJoint* wrap = Unwrap(info.This());
-		info.GetReturnValue().Set(Nan::New(wrap->m_revolute_joint->IsMotorEnabled()));
+		WrapBody* wrap = Unwrap(info.This());
+		WrapVec2* impulse = WrapVec2::Unwrap(v8::Local<v8::Object>::Cast(info[0]));
+		bool wake = (info.Length() > 1) ? NANX_bool(info[1]) : true;
+		Recorder* recorder = wrap->Recording();
+		if (recorder) { recorder->Op(e_recordApplyLinearImpulse).Int(wrap->m_body_id).Vec2(impulse->GetVec2()).Vec2(wrap->m_body->GetWorldCenter()).Bool(wake); }
+		wrap->m_body->ApplyLinearImpulse(impulse->GetVec2(), wrap->m_body->GetWorldCenter(), wake);
+		AddTickImpulse(wrap->m_body_ticks, wrap->m_body, impulse->GetVec2(), 0.0f);
 	}
-	NANX_METHOD(EnableMotor)
+	NANX_METHOD(ApplyAngularImpulse)
 	{
-		WrapRevoluteJoint* wrap = Unwrap(info.This());
-		wrap->m_revolute_joint->EnableMotor(NANX_bool(info[0]));
+		WrapBody* wrap = Unwrap(info.This());
+		float32 impulse = NANX_float32(info[0]);
+		bool wake = (info.Length() > 1) ? NANX_bool(info[1]) : true;
+		Recorder* recorder = wrap->Recording();
+		if (recorder) { recorder->Op(e_recordApplyAngularImpulse).Int(wrap->m_body_id).Float(impulse).Bool(wake); }
+		wrap->m_body->ApplyAngularImpulse(impulse, wake);
+		AddTickImpulse(wrap->m_body_ticks, wrap->m_body, b2Vec2_zero, impulse);
 	}
-	NANX_METHOD(SetMotorSpeed)
+	NANX_METHOD(GetMass) { WrapBody* wrap = Unwrap(info.This()); info.GetReturnValue().Set(Nan::New(wrap->m_body->GetMass())); }
+	NANX_METHOD(GetInertia) { WrapBody* wrap = Unwrap(info.This()); info.GetReturnValue().Set(Nan::New(wrap->m_body->GetInertia())); }
+	NANX_METHOD(GetMassData)
 	{
-		WrapRevoluteJoint* wrap = Unwrap(info.This());
-		wrap->m_revolute_joint->SetMotorSpeed(NANX_float32(info[0]));
+		WrapBody* wrap = Unwrap(info.This());
+		v8::Local<v8::Object> out = info[0]->IsUndefined() ? WrapMassData::NewInstance() : v8::Local<v8::Object>::Cast(info[0]);
+		b2MassData mass_data;
+		wrap->m_body->GetMassData(&mass_data);
+		WrapMassData::Unwrap(out)->SetMassData(mass_data);
+		info.GetReturnValue().Set(out);
 	}
-	NANX_METHOD(GetMotorSpeed)
+	NANX_METHOD(SetMassData)
 	{
-		WrapRevoluteJoint* wrap = Unwrap(info.This());
-		info.GetReturnValue().Set(Nan::New(wrap->m_revolute_joint->GetMotorSpeed()));
+		WrapBody* wrap = Unwrap(info.This());
+		const b2MassData& mass_data = WrapMassData::Unwrap(v8::Local<v8::Object>::Cast(info[0]))->GetMassData();
+		Recorder* recorder = wrap->Recording();
+		if (recorder) { recorder->Op(e_recordSetMassData).Int(wrap->m_body_id).Float(mass_data.mass).Vec2(mass_data.center).Float(mass_data.I); }
+		wrap->m_body->SetMassData(&mass_data);
 	}
-	NANX_METHOD(SetMaxMotorTorque)
+	NANX_METHOD(ResetMassData)
 	{
-		WrapRevoluteJoint* wrap = Unwrap(info.This());
-		wrap->m_revolute_joint->SetMaxMotorTorque(NANX_float32(info[0]));
+		WrapBody* wrap = Unwrap(info.This());
+		Recorder* recorder = wrap->Recording();
+		if (recorder) { recorder->Op(e_recordResetMassData).Int(wrap->m_body_id); }
+		wrap->m_body->ResetMassData();
 	}
-	NANX_METHOD(GetMaxMotorTorque)
+	NANX_METHOD(GetWorldPoint)
 	{
-		WrapRevoluteJoint* wrap = Unwrap(info.This());
-		info.GetReturnValue().Set(Nan::New(wrap->m_revolute_joint->GetMaxMotorTorque()));
+		WrapBody* wrap = Unwrap(info.This());
+		WrapVec2* wrap_localPoint = WrapVec2::Unwrap(v8::Local<v8::Object>::Cast(info[0]));
+		v8::Local<v8::Object> out = info[1]->IsUndefined() ? WrapVec2::NewInstance() : v8::Local<v8::Object>::Cast(info[1]);
+		WrapVec2::Unwrap(out)->SetVec2(wrap->m_body->GetWorldPoint(wrap_localPoint->GetVec2()));
+		info.GetReturnValue().Set(out);
 	}
-	NANX_METHOD(GetMotorTorque)
+	NANX_METHOD(GetWorldVector)
 	{
-		WrapRevoluteJoint* wrap = Unwrap(info.This());
-		info.GetReturnValue().Set(Nan::New(wrap->m_revolute_joint->GetMotorTorque(NANX_float32(info[0]))));
+		WrapBody* wrap = Unwrap(info.This());
+		WrapVec2* wrap_localVector = WrapVec2::Unwrap(v8::Local<v8::Object>::Cast(info[0]));
+		v8::Local<v8::Object> out = info[1]->IsUndefined() ? WrapVec2::NewInstance() : v8::Local<v8::Object>::Cast(info[1]);
+		WrapVec2::Unwrap(out)->SetVec2(wrap->m_body->GetWorldVector(wrap_localVector->GetVec2()));
+		info.GetReturnValue().Set(out);
 	}
-	///	void Dump();
-};
-
-//// b2PrismaticJointDef
-
-class WrapPrismaticJointDef : public WrapJointDef
-{
-private:
-	b2PrismaticJointDef m_prismatic_jd;
-	Nan::Persistent<v8::Object> m_wrap_localAnchorA; // m_prismatic_jd.localAnchorA
-	Nan::Persistent<v8::Object> m_wrap_localAnchorB; // m_prismatic_jd.localAnchorB
-	Nan::Persistent<v8::Object> m_wrap_localAxisA; // m_prismatic_jd.localAxisA
-private:
-	WrapPrismaticJointDef()
+	NANX_METHOD(GetLocalPoint)
 	{
-		m_wrap_localAnchorA.Reset(WrapVec2::NewInstance(m_prismatic_jd.localAnchorA));
-		m_wrap_localAnchorB.Reset(WrapVec2::NewInstance(m_prismatic_jd.localAnchorB));
-		m_wrap_localAxisA.Reset(WrapVec2::NewInstance(m_prismatic_jd.localAxisA));
+		WrapBody* wrap = Unwrap(info.This());
+		WrapVec2* wrap_worldPoint = WrapVec2::Unwrap(v8::Local<v8::Object>::Cast(info[0]));
+		v8::Local<v8::Object> out = info[1]->IsUndefined() ? WrapVec2::NewInstance() : v8::Local<v8::Object>::Cast(info[1]);
+		WrapVec2::Unwrap(out)->SetVec2(wrap->m_body->GetLocalPoint(wrap_worldPoint->GetVec2()));
+		info.GetReturnValue().Set(out);
 	}
-	~WrapPrismaticJointDef()
+	NANX_METHOD(GetLocalVector)
 	{
-		m_wrap_localAnchorA.Reset();
-		m_wrap_localAnchorB.Reset();
-		m_wrap_localAxisA.Reset();
+		WrapBody* wrap = Unwrap(info.This());
+		WrapVec2* wrap_worldVector = WrapVec2::Unwrap(v8::Local<v8::Object>::Cast(info[0]));
+		v8::Local<v8::Object> out = info[1]->IsUndefined() ? WrapVec2::NewInstance() : v8::Local<v8::Object>::Cast(info[1]);
+		WrapVec2::Unwrap(out)->SetVec2(wrap->m_body->GetLocalVector(wrap_worldVector->GetVec2()));
+		info.GetReturnValue().Set(out);
 	}
-public:
-	b2PrismaticJointDef* Peek() { return &m_prismatic_jd; }
-	virtual b2JointDef& GetJointDef() { return m_prismatic_jd; } // override WrapJointDef
-	virtual void SyncPull() // override WrapJointDef
+	NANX_METHOD(GetLinearVelocityFromWorldPoint)
 	{
-		// sync: pull data from javascript objects
-		WrapJointDef::SyncPull();
-		m_prismatic_jd.localAnchorA = WrapVec2::Unwrap(Nan::New<v8::Object>(m_wrap_localAnchorA))->GetVec2(); // struct copy
-		m_prismatic_jd.localAnchorB = WrapVec2::Unwrap(Nan::New<v8::Object>(m_wrap_localAnchorB))->GetVec2(); // struct copy
-		m_prismatic_jd.localAxisA = WrapVec2::Unwrap(Nan::New<v8::Object>(m_wrap_localAxisA))->GetVec2(); // struct copy
+		WrapBody* wrap = Unwrap(info.This());
+		WrapVec2* wrap_worldPoint = WrapVec2::Unwrap(v8::Local<v8::Object>::Cast(info[0]));
+		v8::Local<v8::Object> out = info[1]->IsUndefined() ? WrapVec2::NewInstance() : v8::Local<v8::Object>::Cast(info[1]);
+		WrapVec2::Unwrap(out)->SetVec2(wrap->m_body->GetLinearVelocityFromWorldPoint(wrap_worldPoint->GetVec2()));
+		info.GetReturnValue().Set(out);
 	}
-	virtual void SyncPush() // override WrapJointDef
+	NANX_METHOD(GetLinearVelocityFromLocalPoint)
 	{
-		// sync: push data into javascript objects
-		WrapJointDef::SyncPush();
-		WrapVec2::Unwrap(Nan::New<v8::Object>(m_wrap_localAnchorA))->SetVec2(m_prismatic_jd.localAnchorA);
-		WrapVec2::Unwrap(Nan::New<v8::Object>(m_wrap_localAnchorB))->SetVec2(m_prismatic_jd.localAnchorB);
-		WrapVec2::Unwrap(Nan::New<v8::Object>(m_wrap_localAxisA))->SetVec2(m_prismatic_jd.localAxisA);
+		WrapBody* wrap = Unwrap(info.This());
+		WrapVec2* wrap_localPoint = WrapVec2::Unwrap(v8::Local<v8::Object>::Cast(info[0]));
+		v8::Local<v8::Object> out = info[1]->IsUndefined() ? WrapVec2::NewInstance() : v8::Local<v8::Object>::Cast(info[1]);
+		WrapVec2::Unwrap(out)->SetVec2(wrap->m_body->GetLinearVelocityFromLocalPoint(wrap_localPoint->GetVec2()));
+		info.GetReturnValue().Set(out);
 	}
-public:
-	static WrapPrismaticJointDef* Unwrap(v8::Local<v8::Value> value) { return (value->IsObject())?(Unwrap(v8::Local<v8::Object>::Cast(value))):(NULL); }
-	static WrapPrismaticJointDef* Unwrap(v8::Local<v8::Object> object) { return Nan::ObjectWrap::Unwrap<WrapPrismaticJointDef>(object); }
-	static b2PrismaticJointDef* Peek(v8::Local<v8::Value> value) { WrapPrismaticJointDef* wrap = Unwrap(value); return (wrap)?(wrap->Peek()):(NULL); }
-public:
-	static NAN_MODULE_INIT(Init)
+	NANX_METHOD(GetLinearDamping) { WrapBody* wrap = Unwrap(info.This()); info.GetReturnValue().Set(Nan::New(wrap->m_body->GetLinearDamping())); }
+	NANX_METHOD(SetLinearDamping)
 	{
-		v8::Local<v8::Function> constructor = GetConstructor();
-		target->Set(constructor->GetName(), constructor);
+		WrapBody* wrap = Unwrap(info.This());
+		float32 value = NANX_float32(info[0]);
+		Recorder* recorder = wrap->Recording();
+		if (recorder) { recorder->Op(e_recordSetBodyFloat).Int(wrap->m_body_id).Uint8(e_recordLinearDamping).Float(value); }
+		wrap->m_body->SetLinearDamping(value);
 	}
-	static v8::Local<v8::Function> GetConstructor()
+	NANX_METHOD(GetAngularDamping) { WrapBody* wrap = Unwrap(info.This()); info.GetReturnValue().Set(Nan::New(wrap->m_body->GetAngularDamping())); }
+	NANX_METHOD(SetAngularDamping)
 	{
-		Nan::EscapableHandleScope scope;
-		v8::Local<v8::FunctionTemplate> function_template = GetFunctionTemplate();
-		v8::Local<v8::Function> constructor = function_template->GetFunction();
-		return scope.Escape(constructor);
+		WrapBody* wrap = Unwrap(info.This());
+		float32 value = NANX_float32(info[0]);
+		Recorder* recorder = wrap->Recording();
+		if (recorder) { recorder->Op(e_recordSetBodyFloat).Int(wrap->m_body_id).Uint8(e_recordAngularDamping).Float(value); }
+		wrap->m_body->SetAngularDamping(value);
 	}
-	static v8::Local<v8::FunctionTemplate> GetFunctionTemplate()
+	NANX_METHOD(GetGravityScale) { WrapBody* wrap = Unwrap(info.This()); info.GetReturnValue().Set(Nan::New(wrap->m_body->GetGravityScale())); }
+	NANX_METHOD(SetGravityScale)
 	{
-		Nan::EscapableHandleScope scope;
-		static Nan::Persistent<v8::FunctionTemplate> g_function_template;
-		if (g_function_template.IsEmpty())
+		WrapBody* wrap = Unwrap(info.This());
+		float32 value = NANX_float32(info[0]);
+		Recorder* recorder = wrap->Recording();
+		if (recorder) { recorder->Op(e_recordSetBodyFloat).Int(wrap->m_body_id).Uint8(e_recordGravityScale).Float(value); }
+		wrap->m_body->SetGravityScale(value);
+	}
+	NANX_METHOD(SetType)
+	{
+		WrapBody* wrap = Unwrap(info.This());
+		b2BodyType type = NANX_b2BodyType(info[0]);
+		AllocScope alloc_scope(wrap->m_alloc_stats);
+		Recorder* recorder = wrap->Recording();
+		if (recorder) { recorder->Op(e_recordSetType).Int(wrap->m_body_id).Int(type); }
+		wrap->m_body->SetType(type);
+	}
+	NANX_METHOD(GetType) { WrapBody* wrap = Unwrap(info.This()); info.GetReturnValue().Set(Nan::New(wrap->m_body->GetType())); }
+	NANX_METHOD(SetBullet)
+	{
+		WrapBody* wrap = Unwrap(info.This());
+		bool flag = NANX_bool(info[0]);
+		Recorder* recorder = wrap->Recording();
+		if (recorder) { recorder->Op(e_recordSetBodyFlag).Int(wrap->m_body_id).Uint8(e_recordBullet).Bool(flag); }
+		wrap->m_body->SetBullet(flag);
+	}
+	NANX_METHOD(IsBullet) { WrapBody* wrap = Unwrap(info.This()); info.GetReturnValue().Set(Nan::New(wrap->m_body->IsBullet())); }
+	NANX_METHOD(SetSleepingAllowed)
+	{
+		WrapBody* wrap = Unwrap(info.This());
+		bool flag = NANX_bool(info[0]);
+		Recorder* recorder = wrap->Recording();
+		if (recorder) { recorder->Op(e_recordSetBodyFlag).Int(wrap->m_body_id).Uint8(e_recordSleepingAllowed).Bool(flag); }
+		wrap->m_body->SetSleepingAllowed(flag);
+	}
+	NANX_METHOD(IsSleepingAllowed) { WrapBody* wrap = Unwrap(info.This()); info.GetReturnValue().Set(Nan::New(wrap->m_body->IsSleepingAllowed())); }
+	NANX_METHOD(SetAwake)
+	{
+		WrapBody* wrap = Unwrap(info.This());
+		bool flag = NANX_bool(info[0]);
+		Recorder* recorder = wrap->Recording();
+		if (recorder) { recorder->Op(e_recordSetBodyFlag).Int(wrap->m_body_id).Uint8(e_recordAwake).Bool(flag); }
+		if (!flag) { SleepBodyTick(wrap->m_body_ticks, wrap->m_body); }
+		wrap->m_body->SetAwake(flag);
+	}
+	NANX_METHOD(IsAwake) { WrapBody* wrap = Unwrap(info.This()); info.GetReturnValue().Set(Nan::New(wrap->m_body->IsAwake())); }
+	NANX_METHOD(SetActive)
+	{
+		WrapBody* wrap = Unwrap(info.This());
+		bool flag = NANX_bool(info[0]);
+		AllocScope alloc_scope(wrap->m_alloc_stats);
+		Recorder* recorder = wrap->Recording();
+		if (recorder) { recorder->Op(e_recordSetBodyFlag).Int(wrap->m_body_id).Uint8(e_recordActive).Bool(flag); }
+		wrap->m_body->SetActive(flag);
+	}
+	NANX_METHOD(IsActive) { WrapBody* wrap = Unwrap(info.This()); info.GetReturnValue().Set(Nan::New(wrap->m_body->IsActive())); }
+	NANX_METHOD(SetFixedRotation)
+	{
+		WrapBody* wrap = Unwrap(info.This());
+		bool flag = NANX_bool(info[0]);
+		Recorder* recorder = wrap->Recording();
+		if (recorder) { recorder->Op(e_recordSetBodyFlag).Int(wrap->m_body_id).Uint8(e_recordFixedRotation).Bool(flag); }
+		wrap->m_body->SetFixedRotation(flag);
+	}
+	NANX_METHOD(IsFixedRotation) { WrapBody* wrap = Unwrap(info.This()); info.GetReturnValue().Set(Nan::New(wrap->m_body->IsFixedRotation())); }
+	NANX_METHOD(GetFixtureList)
+	{
+		WrapBody* wrap = Unwrap(info.This());
+		b2Fixture* fixture = wrap->m_body->GetFixtureList();
+		if (fixture)
 		{
-			v8::Local<v8::FunctionTemplate> function_template = Nan::New<v8::FunctionTemplate>(New);
-			function_template->Inherit(WrapJointDef::GetFunctionTemplate());
-			function_template->SetClassName(NANX_SYMBOL("b2PrismaticJointDef"));
-			function_template->InstanceTemplate()->SetInternalFieldCount(1);
-			v8::Local<v8::ObjectTemplate> prototype_template = function_template->PrototypeTemplate();
-			NANX_MEMBER_APPLY(prototype_template, localAnchorA)
-			NANX_MEMBER_APPLY(prototype_template, localAnchorB)
-			NANX_MEMBER_APPLY(prototype_template, localAxisA)
-			NANX_MEMBER_APPLY(prototype_template, referenceAngle)
-			NANX_MEMBER_APPLY(prototype_template, enableLimit)
-			NANX_MEMBER_APPLY(prototype_template, lowerTranslation)
-			NANX_MEMBER_APPLY(prototype_template, upperTranslation)
-			NANX_MEMBER_APPLY(prototype_template, enableMotor)
-			NANX_MEMBER_APPLY(prototype_template, maxMotorForce)
-			NANX_MEMBER_APPLY(prototype_template, motorSpeed)
-			NANX_METHOD_APPLY(prototype_template, Initialize)
-			g_function_template.Reset(function_template);
+			// get fixture internal data
+			WrapFixture* wrap_fixture = WrapFixture::GetWrap(fixture);
+			info.GetReturnValue().Set(wrap_fixture->handle());
+		}
+		else
+		{
+			info.GetReturnValue().SetNull();
 		}
-		v8::Local<v8::FunctionTemplate> function_template = Nan::New<v8::FunctionTemplate>(g_function_template);
-		return scope.Escape(function_template);
 	}
-private:
-	static NAN_METHOD(New)
+	///b2JointEdge* GetJointList();
+	///const b2JointEdge* GetJointList() const;
+	///b2ContactEdge* GetContactList();
+	///const b2ContactEdge* GetContactList() const;
+	NANX_METHOD(GetNext)
 	{
-		WrapPrismaticJointDef* wrap = new WrapPrismaticJointDef();
-		wrap->Wrap(info.This());
-		info.GetReturnValue().Set(info.This());
+		WrapBody* wrap = Unwrap(info.This());
+		b2Body* body = wrap->m_body->GetNext();
+		if (body)
+		{
+			// get body internal data
+			WrapBody* wrap_body = WrapBody::GetWrap(body);
+			info.GetReturnValue().Set(wrap_body->handle());
+		}
+		else
+		{
+			info.GetReturnValue().SetNull();
+		}
 	}
-	NANX_MEMBER_OBJECT	(localAnchorA) // m_wrap_localAnchorA
-	NANX_MEMBER_OBJECT	(localAnchorB) // m_wrap_localAnchorB
-	NANX_MEMBER_OBJECT	(localAxisA) // m_wrap_localAxisA
-	NANX_MEMBER_NUMBER	(float32, referenceAngle)
-	NANX_MEMBER_BOOLEAN	(bool, enableLimit)
-	NANX_MEMBER_NUMBER	(float32, lowerTranslation)
-	NANX_MEMBER_NUMBER	(float32, upperTranslation)
-	NANX_MEMBER_BOOLEAN	(bool, enableMotor)
-	NANX_MEMBER_NUMBER	(float32, maxMotorForce)
-	NANX_MEMBER_NUMBER	(float32, motorSpeed)
-	NANX_METHOD(Initialize)
+	NANX_METHOD(GetUserData)
 	{
-		WrapPrismaticJointDef* wrap = Unwrap(info.This());
-		WrapBody* wrap_bodyA = WrapBody::Unwrap(v8::Local<v8::Object>::Cast(info[0]));
-		WrapBody* wrap_bodyB = WrapBody::Unwrap(v8::Local<v8::Object>::Cast(info[1]));
-		WrapVec2* wrap_anchor = WrapVec2::Unwrap(v8::Local<v8::Object>::Cast(info[2]));
-		WrapVec2* wrap_axis = WrapVec2::Unwrap(v8::Local<v8::Object>::Cast(info[3]));
-		wrap->SyncPull();
-		wrap->m_prismatic_jd.Initialize(wrap_bodyA->Peek(), wrap_bodyB->Peek(), wrap_anchor->GetVec2(), wrap_axis->GetVec2());
-		wrap->SyncPush();
+		WrapBody* wrap = Unwrap(info.This());
+		info.GetReturnValue().Set(Nan::New<v8::Value>(wrap->m_body_userData));
+	}
+	NANX_METHOD(SetUserData)
+	{
+		WrapBody* wrap = Unwrap(info.This());
+		if (!info[0]->IsUndefined())
+		{
+			wrap->m_body_userData.Reset(info[0]);
+		}
+		else
+		{
+			wrap->m_body_userData.Reset();
+		}
+	}
+	NANX_METHOD(GetWorld)
+	{
+		WrapBody* wrap = Unwrap(info.This());
+		info.GetReturnValue().Set(Nan::New<v8::Object>(wrap->m_body_world));
+	}
+	NANX_METHOD(ShouldCollideConnected)
+	{
+		WrapBody* wrap = Unwrap(info.This());
+		WrapBody* wrap_other = WrapBody::Unwrap(v8::Local<v8::Object>::Cast(info[0]));
+		info.GetReturnValue().Set(Nan::New(wrap->m_body->ShouldCollideConnected(wrap_other->m_body)));
+	}
+	///void Dump();
+	NANX_METHOD(GetId)
+	{
+		WrapBody* wrap = Unwrap(info.This());
+		info.GetReturnValue().Set(Nan::New(wrap->m_body_id));
 	}
 };
 
-//// b2PrismaticJoint
+//// b2JointDef
 
-class WrapPrismaticJoint : public WrapJoint
+class WrapJointDef : public Nan::ObjectWrap
 {
-private:
-	b2PrismaticJoint* m_prismatic_joint;
-private:
-	WrapPrismaticJoint() : m_prismatic_joint(NULL) {}
-	~WrapPrismaticJoint() {}
+protected:
+	Nan::Persistent<v8::Value> m_wrap_userData; // m_jd.userData
+	Nan::Persistent<v8::Object> m_wrap_bodyA; // m_jd.bodyA
+	Nan::Persistent<v8::Object> m_wrap_bodyB; // m_jd.bodyB
 public:
-	b2PrismaticJoint* Peek() { return m_prismatic_joint; }
-	virtual b2Joint* GetJoint() { return m_prismatic_joint; } // override WrapJoint
-	void SetupObject(v8::Local<v8::Object> h_world, WrapPrismaticJointDef* wrap_prismatic_jd, b2PrismaticJoint* prismatic_joint)
+	WrapJointDef() {}
+	~WrapJointDef()
 	{
-		m_prismatic_joint = prismatic_joint;
-		WrapJoint::SetupObject(h_world, wrap_prismatic_jd);
+		m_wrap_userData.Reset();
+		m_wrap_bodyA.Reset();
+		m_wrap_bodyB.Reset();
 	}
-	b2PrismaticJoint* ResetObject()
+public:
+	b2JointDef* Peek() { return &GetJointDef(); }
+	virtual b2JointDef& GetJointDef() = 0;
+	const b2JointDef& UseJointDef() { SyncPull(); return GetJointDef(); }
+	v8::Local<v8::Value> GetUserDataHandle() { return Nan::New<v8::Value>(m_wrap_userData); }
+	v8::Local<v8::Object> GetBodyAHandle() { return Nan::New<v8::Object>(m_wrap_bodyA); }
+	v8::Local<v8::Object> GetBodyBHandle() { return Nan::New<v8::Object>(m_wrap_bodyB); }
+public:
+	virtual void SyncPull()
 	{
-		WrapJoint::ResetObject();
-		b2PrismaticJoint* prismatic_joint = m_prismatic_joint;
-		m_prismatic_joint = NULL;
-		return prismatic_joint;
+		b2JointDef& jd = GetJointDef();
+		// sync: pull data from javascript objects
+		//jd.userData; // not used
+		jd.bodyA = m_wrap_bodyA.IsEmpty() ? NULL : WrapBody::Unwrap(Nan::New<v8::Object>(m_wrap_bodyA))->Peek();
+		jd.bodyB = m_wrap_bodyB.IsEmpty() ? NULL : WrapBody::Unwrap(Nan::New<v8::Object>(m_wrap_bodyB))->Peek();
+	}
+	virtual void SyncPush()
+	{
+		b2JointDef& jd = GetJointDef();
+		// sync: push data into javascript objects
+		//jd.userData; // not used
+		if (jd.bodyA)
+		{
+			m_wrap_bodyA.Reset(WrapBody::GetWrap(jd.bodyA)->handle());
+		}
+		else
+		{
+			m_wrap_bodyA.Reset();
+		}
+		if (jd.bodyB)
+		{
+			m_wrap_bodyB.Reset(WrapBody::GetWrap(jd.bodyB)->handle());
+		}
+		else
+		{
+			m_wrap_bodyB.Reset();
+		}
 	}
 public:
-	static WrapPrismaticJoint* Unwrap(v8::Local<v8::Value> value) { return (value->IsObject())?(Unwrap(v8::Local<v8::Object>::Cast(value))):(NULL); }
-	static WrapPrismaticJoint* Unwrap(v8::Local<v8::Object> object) { return Nan::ObjectWrap::Unwrap<WrapPrismaticJoint>(object); }
-	static b2PrismaticJoint* Peek(v8::Local<v8::Value> value) { WrapPrismaticJoint* wrap = Unwrap(value); return (wrap)?(wrap->Peek()):(NULL); }
+	static WrapJointDef* Unwrap(v8::Local<v8::Value> value) { return (value->IsObject())?(Unwrap(v8::Local<v8::Object>::Cast(value))):(NULL); }
+	static WrapJointDef* Unwrap(v8::Local<v8::Object> object) { return Nan::ObjectWrap::Unwrap<WrapJointDef>(object); }
+	static b2JointDef* Peek(v8::Local<v8::Value> value) { WrapJointDef* wrap = Unwrap(value); return (wrap)?(wrap->Peek()):(NULL); }
 public:
 	static NAN_MODULE_INIT(Init)
 	{
@@ -3216,191 +5370,109 @@ public:
 		static Nan::Persistent<v8::FunctionTemplate> g_function_template;
 		if (g_function_template.IsEmpty())
 		{
-			v8::Local<v8::FunctionTemplate> function_template = Nan::New<v8::FunctionTemplate>(New);
-			function_template->Inherit(WrapJoint::GetFunctionTemplate());
-			function_template->SetClassName(NANX_SYMBOL("b2PrismaticJoint"));
+			v8::Local<v8::FunctionTemplate> function_template = Nan::New<v8::FunctionTemplate>();
+			function_template->SetClassName(NANX_SYMBOL("b2JointDef"));
 			function_template->InstanceTemplate()->SetInternalFieldCount(1);
 			v8::Local<v8::ObjectTemplate> prototype_template = function_template->PrototypeTemplate();
-			NANX_METHOD_APPLY(prototype_template, GetLocalAnchorA)
-			NANX_METHOD_APPLY(prototype_template, GetLocalAnchorB)
-			NANX_METHOD_APPLY(prototype_template, GetLocalAxisA)
-			NANX_METHOD_APPLY(prototype_template, GetReferenceAngle)
-			NANX_METHOD_APPLY(prototype_template, GetJointTranslation)
-			NANX_METHOD_APPLY(prototype_template, GetJointSpeed)
-			NANX_METHOD_APPLY(prototype_template, IsLimitEnabled)
-			NANX_METHOD_APPLY(prototype_template, EnableLimit)
-			NANX_METHOD_APPLY(prototype_template, GetLowerLimit)
-			NANX_METHOD_APPLY(prototype_template, GetUpperLimit)
-			NANX_METHOD_APPLY(prototype_template, SetLimits)
-			NANX_METHOD_APPLY(prototype_template, IsMotorEnabled)
-			NANX_METHOD_APPLY(prototype_template, EnableMotor)
-			NANX_METHOD_APPLY(prototype_template, SetMotorSpeed)
-			NANX_METHOD_APPLY(prototype_template, GetMotorSpeed)
-			NANX_METHOD_APPLY(prototype_template, SetMaxMotorForce)
-			NANX_METHOD_APPLY(prototype_template, GetMaxMotorForce)
-			NANX_METHOD_APPLY(prototype_template, GetMotorForce)
-			g_function_template.Reset(function_template);
-		}
-		v8::Local<v8::FunctionTemplate> function_template = Nan::New<v8::FunctionTemplate>(g_function_template);
+			NANX_MEMBER_APPLY(prototype_template, type)
+			NANX_MEMBER_APPLY(prototype_template, userData)
+			NANX_MEMBER_APPLY(prototype_template, bodyA)
+			NANX_MEMBER_APPLY(prototype_template, bodyB)
+			NANX_MEMBER_APPLY(prototype_template, collideConnected)
+			g_function_template.Reset(function_template);
+		}
+		v8::Local<v8::FunctionTemplate> function_template = Nan::New<v8::FunctionTemplate>(g_function_template);
 		return scope.Escape(function_template);
 	}
-	static v8::Local<v8::Object> NewInstance()
-	{
-		Nan::EscapableHandleScope scope;
-		v8::Local<v8::Function> constructor = GetConstructor();
-		v8::Local<v8::Object> instance = constructor->NewInstance();
-		return scope.Escape(instance);
-	}
 private:
-	static NAN_METHOD(New)
-	{
-		WrapPrismaticJoint* wrap = new WrapPrismaticJoint();
-		wrap->Wrap(info.This());
-		info.GetReturnValue().Set(info.This());
-	}
-	///b2Vec2 GetAnchorA() const;
-	///b2Vec2 GetAnchorB() const;
-	///b2Vec2 GetReactionForce(float32 inv_dt) const;
-	///float32 GetReactionTorque(float32 inv_dt) const;
-	NANX_METHOD(GetLocalAnchorA)
-	{
-		WrapPrismaticJoint* wrap = Unwrap(info.This());
-		v8::Local<v8::Object> out = info[0]->IsUndefined() ? WrapVec2::NewInstance() : v8::Local<v8::Object>::Cast(info[0]);
-		WrapVec2::Unwrap(out)->SetVec2(wrap->m_prismatic_joint->GetLocalAnchorA());
-		info.GetReturnValue().Set(out);
-	}
-	NANX_METHOD(GetLocalAnchorB)
-	{
-		WrapPrismaticJoint* wrap = Unwrap(info.This());
-		v8::Local<v8::Object> out = info[0]->IsUndefined() ? WrapVec2::NewInstance() : v8::Local<v8::Object>::Cast(info[0]);
-		WrapVec2::Unwrap(out)->SetVec2(wrap->m_prismatic_joint->GetLocalAnchorB());
-		info.GetReturnValue().Set(out);
-	}
-	NANX_METHOD(GetLocalAxisA)
-	{
-		WrapPrismaticJoint* wrap = Unwrap(info.This());
-		v8::Local<v8::Object> out = info[0]->IsUndefined() ? WrapVec2::NewInstance() : v8::Local<v8::Object>::Cast(info[0]);
-		WrapVec2::Unwrap(out)->SetVec2(wrap->m_prismatic_joint->GetLocalAxisA());
-		info.GetReturnValue().Set(out);
-	}
-	NANX_METHOD(GetReferenceAngle)
-	{
-		WrapPrismaticJoint* wrap = Unwrap(info.This());
-		info.GetReturnValue().Set(Nan::New(wrap->m_prismatic_joint->GetReferenceAngle()));
-	}
-	NANX_METHOD(GetJointTranslation)
-	{
-		WrapPrismaticJoint* wrap = Unwrap(info.This());
-		info.GetReturnValue().Set(Nan::New(wrap->m_prismatic_joint->GetJointTranslation()));
-	}
-	NANX_METHOD(GetJointSpeed)
-	{
-		WrapPrismaticJoint* wrap = Unwrap(info.This());
-		info.GetReturnValue().Set(Nan::New(wrap->m_prismatic_joint->GetJointSpeed()));
-	}
-	NANX_METHOD(IsLimitEnabled)
-	{
-		WrapPrismaticJoint* wrap = Unwrap(info.This());
-		info.GetReturnValue().Set(Nan::New(wrap->m_prismatic_joint->IsLimitEnabled()));
-	}
-	NANX_METHOD(EnableLimit)
-	{
-		WrapPrismaticJoint* wrap = Unwrap(info.This());
-		wrap->m_prismatic_joint->EnableLimit(NANX_bool(info[0]));
-	}
-	NANX_METHOD(GetLowerLimit)
-	{
-		WrapPrismaticJoint* wrap = Unwrap(info.This());
-		info.GetReturnValue().Set(Nan::New(wrap->m_prismatic_joint->GetLowerLimit()));
-	}
-	NANX_METHOD(GetUpperLimit)
-	{
-		WrapPrismaticJoint* wrap = Unwrap(info.This());
-		info.GetReturnValue().Set(Nan::New(wrap->m_prismatic_joint->GetUpperLimit()));
-	}
-	NANX_METHOD(SetLimits)
-	{
-		WrapPrismaticJoint* wrap = Unwrap(info.This());
-		wrap->m_prismatic_joint->SetLimits(NANX_float32(info[0]), NANX_float32(info[1]));
-	}
-	NANX_METHOD(IsMotorEnabled)
-	{
-		WrapPrismaticJoint* wrap = Unwrap(info.This());
-		info.GetReturnValue().Set(Nan::New(wrap->m_prismatic_joint->IsMotorEnabled()));
-	}
-	NANX_METHOD(EnableMotor)
-	{
-		WrapPrismaticJoint* wrap = Unwrap(info.This());
-		wrap->m_prismatic_joint->EnableMotor(NANX_bool(info[0]));
-	}
-	NANX_METHOD(SetMotorSpeed)
-	{
-		WrapPrismaticJoint* wrap = Unwrap(info.This());
-		wrap->m_prismatic_joint->SetMotorSpeed(NANX_float32(info[0]));
-	}
-	NANX_METHOD(GetMotorSpeed)
+	NANX_MEMBER_INTEGER	(b2JointType, type)
+	NANX_MEMBER_VALUE	(userData) // m_wrap_userData
+	NANX_MEMBER_OBJECT	(bodyA) // m_wrap_bodyA
+	NANX_MEMBER_OBJECT	(bodyB) // m_wrap_bodyB
+	NANX_MEMBER_BOOLEAN	(bool, collideConnected)
+};
+
+//// b2Joint
+
+class WrapJoint : public Nan::ObjectWrap
+{
+private:
+	Nan::Persistent<v8::Object> m_joint_world;
+	Nan::Persistent<v8::Object> m_joint_bodyA;
+	Nan::Persistent<v8::Object> m_joint_bodyB;
+	Nan::Persistent<v8::Value> m_joint_userData;
+public:
+	WrapJoint() {}
+	~WrapJoint()
 	{
-		WrapPrismaticJoint* wrap = Unwrap(info.This());
-		info.GetReturnValue().Set(Nan::New(wrap->m_prismatic_joint->GetMotorSpeed()));
+		m_joint_bodyA.Reset();
+		m_joint_bodyB.Reset();
+		m_joint_userData.Reset();
 	}
-	NANX_METHOD(SetMaxMotorForce)
+public:
+	b2Joint* Peek() { return GetJoint(); }
+	virtual b2Joint* GetJoint() = 0;
+	Recorder* Recording()
 	{
-		WrapPrismaticJoint* wrap = Unwrap(info.This());
-		wrap->m_prismatic_joint->SetMaxMotorForce(NANX_float32(info[0]));
+		// joints record through their first body's world
+		WrapBody* wrap_body = WrapBody::GetWrap(GetJoint()->GetBodyA());
+		return (wrap_body)?(wrap_body->Recording()):(NULL);
 	}
-	NANX_METHOD(GetMaxMotorForce)
+public:
+	void SetupObject(v8::Local<v8::Object> h_world, WrapJointDef* wrap_jd)
 	{
-		WrapPrismaticJoint* wrap = Unwrap(info.This());
-		info.GetReturnValue().Set(Nan::New(wrap->m_prismatic_joint->GetMaxMotorForce()));
+		b2Joint* joint = GetJoint();
+		// set joint internal data
+		WrapJoint::SetWrap(joint, this);
+		// set reference to this joint (prevent GC)
+		Ref();
+		// set reference to joint world object
+		m_joint_world.Reset(h_world);
+		// set references to joint body objects
+		m_joint_bodyA.Reset(wrap_jd->GetBodyAHandle());
+		m_joint_bodyB.Reset(wrap_jd->GetBodyBHandle());
+		// set reference to joint user data object
+		m_joint_userData.Reset(wrap_jd->GetUserDataHandle());
 	}
-	NANX_METHOD(GetMotorForce)
+	void ResetObject()
 	{
-		WrapPrismaticJoint* wrap = Unwrap(info.This());
-		info.GetReturnValue().Set(Nan::New(wrap->m_prismatic_joint->GetMotorForce(NANX_float32(info[0]))));
+		b2Joint* joint = GetJoint();
+		// clear reference to joint world object
+		m_joint_world.Reset();
+		// clear references to joint body objects
+		m_joint_bodyA.Reset();
+		m_joint_bodyB.Reset();
+		// clear reference to joint user data object
+		m_joint_userData.Reset();
+		// clear reference to this joint (allow GC)
+		Unref();
+		// clear joint internal data
+		WrapJoint::SetWrap(joint, NULL);
 	}
-	///void Dump();
-};
-
-//// b2DistanceJointDef
-
-class WrapDistanceJointDef : public WrapJointDef
-{
-private:
-	b2DistanceJointDef m_distance_jd;
-	Nan::Persistent<v8::Object> m_wrap_localAnchorA; // m_distance_jd.localAnchorA
-	Nan::Persistent<v8::Object> m_wrap_localAnchorB; // m_distance_jd.localAnchorB
-private:
-	WrapDistanceJointDef()
+	virtual int32 GetPersistentCount() const
 	{
-		m_wrap_localAnchorA.Reset(WrapVec2::NewInstance(m_distance_jd.localAnchorA));
-		m_wrap_localAnchorB.Reset(WrapVec2::NewInstance(m_distance_jd.localAnchorB));
+		// the object handle plus the references it holds
+		return 1 + (m_joint_world.IsEmpty()?0:1) + (m_joint_bodyA.IsEmpty()?0:1) + (m_joint_bodyB.IsEmpty()?0:1) + (m_joint_userData.IsEmpty()?0:1);
 	}
-	~WrapDistanceJointDef()
+public:
+	static WrapJoint* GetWrap(const b2Joint* joint)
 	{
-		m_wrap_localAnchorA.Reset();
-		m_wrap_localAnchorB.Reset();
+		return static_cast<WrapJoint*>(joint->GetUserData());
 	}
-public:
-	b2DistanceJointDef* Peek() { return &m_distance_jd; }
-	virtual b2JointDef& GetJointDef() { return m_distance_jd; } // override WrapJointDef
-	virtual void SyncPull() // override WrapJointDef
+	static b2Joint* SkipUnwrapped(b2Joint* joint)
 	{
-		// sync: pull data from javascript objects
-		WrapJointDef::SyncPull();
-		m_distance_jd.localAnchorA = WrapVec2::Unwrap(Nan::New<v8::Object>(m_wrap_localAnchorA))->GetVec2(); // struct copy
-		m_distance_jd.localAnchorB = WrapVec2::Unwrap(Nan::New<v8::Object>(m_wrap_localAnchorB))->GetVec2(); // struct copy
+		// joints made natively (scene loading) have no javascript object; lists skip them
+		while (joint && !GetWrap(joint)) { joint = joint->GetNext(); }
+		return joint;
 	}
-	virtual void SyncPush() // override WrapJointDef
+	static void SetWrap(b2Joint* joint, WrapJoint* wrap)
 	{
-		// sync: push data into javascript objects
-		WrapJointDef::SyncPush();
-		WrapVec2::Unwrap(Nan::New<v8::Object>(m_wrap_localAnchorA))->SetVec2(m_distance_jd.localAnchorA);
-		WrapVec2::Unwrap(Nan::New<v8::Object>(m_wrap_localAnchorB))->SetVec2(m_distance_jd.localAnchorB);
+		joint->SetUserData(wrap);
 	}
 public:
-	static WrapDistanceJointDef* Unwrap(v8::Local<v8::Value> value) { return (value->IsObject())?(Unwrap(v8::Local<v8::Object>::Cast(value))):(NULL); }
-	static WrapDistanceJointDef* Unwrap(v8::Local<v8::Object> object) { return Nan::ObjectWrap::Unwrap<WrapDistanceJointDef>(object); }
-	static b2DistanceJointDef* Peek(v8::Local<v8::Value> value) { WrapDistanceJointDef* wrap = Unwrap(value); return (wrap)?(wrap->Peek()):(NULL); }
+	static WrapJoint* Unwrap(v8::Local<v8::Value> value) { return (value->IsObject())?(Unwrap(v8::Local<v8::Object>::Cast(value))):(NULL); }
+	static WrapJoint* Unwrap(v8::Local<v8::Object> object) { return Nan::ObjectWrap::Unwrap<WrapJoint>(object); }
+	static b2Joint* Peek(v8::Local<v8::Value> value) { WrapJoint* wrap = Unwrap(value); return (wrap)?(wrap->Peek()):(NULL); }
 public:
 	static NAN_MODULE_INIT(Init)
 	{
@@ -3420,233 +5492,178 @@ public:
 		static Nan::Persistent<v8::FunctionTemplate> g_function_template;
 		if (g_function_template.IsEmpty())
 		{
-			v8::Local<v8::FunctionTemplate> function_template = Nan::New<v8::FunctionTemplate>(New);
-			function_template->Inherit(WrapJointDef::GetFunctionTemplate());
-			function_template->SetClassName(NANX_SYMBOL("b2DistanceJointDef"));
+			v8::Local<v8::FunctionTemplate> function_template = Nan::New<v8::FunctionTemplate>();
+			function_template->SetClassName(NANX_SYMBOL("b2Joint"));
 			function_template->InstanceTemplate()->SetInternalFieldCount(1);
 			v8::Local<v8::ObjectTemplate> prototype_template = function_template->PrototypeTemplate();
-			NANX_MEMBER_APPLY(prototype_template, localAnchorA)
-			NANX_MEMBER_APPLY(prototype_template, localAnchorB)
-			NANX_MEMBER_APPLY(prototype_template, length)
-			NANX_MEMBER_APPLY(prototype_template, frequencyHz)
-			NANX_MEMBER_APPLY(prototype_template, dampingRatio)
-			NANX_METHOD_APPLY(prototype_template, Initialize)
+			NANX_METHOD_APPLY(prototype_template, GetType)
+			NANX_METHOD_APPLY(prototype_template, GetBodyA)
+			NANX_METHOD_APPLY(prototype_template, GetBodyB)
+			NANX_METHOD_APPLY(prototype_template, GetAnchorA)
+			NANX_METHOD_APPLY(prototype_template, GetAnchorB)
+			NANX_METHOD_APPLY(prototype_template, GetReactionForce)
+			NANX_METHOD_APPLY(prototype_template, GetReactionTorque)
+			NANX_METHOD_APPLY(prototype_template, GetNext)
+			NANX_METHOD_APPLY(prototype_template, GetUserData)
+			NANX_METHOD_APPLY(prototype_template, SetUserData)
+			NANX_METHOD_APPLY(prototype_template, IsActive)
+			NANX_METHOD_APPLY(prototype_template, GetCollideConnected)
 			g_function_template.Reset(function_template);
 		}
 		v8::Local<v8::FunctionTemplate> function_template = Nan::New<v8::FunctionTemplate>(g_function_template);
 		return scope.Escape(function_template);
 	}
 private:
-	static NAN_METHOD(New)
+	NANX_METHOD(GetType)
 	{
-		WrapDistanceJointDef* wrap = new WrapDistanceJointDef();
-		wrap->Wrap(info.This());
-		info.GetReturnValue().Set(info.This());
+		WrapJoint* wrap = Unwrap(info.This());
+		info.GetReturnValue().Set(Nan::New(wrap->GetJoint()->GetType()));
 	}
-	NANX_MEMBER_OBJECT(localAnchorA) // m_wrap_localAnchorA
-	NANX_MEMBER_OBJECT(localAnchorB) // m_wrap_localAnchorB
-	NANX_MEMBER_NUMBER(float32, length)
-	NANX_MEMBER_NUMBER(float32, frequencyHz)
-	NANX_MEMBER_NUMBER(float32, dampingRatio)
-	NANX_METHOD(Initialize)
+	NANX_METHOD(GetBodyA)
 	{
-		WrapDistanceJointDef* wrap = Unwrap(info.This());
-		WrapBody* wrap_bodyA = WrapBody::Unwrap(v8::Local<v8::Object>::Cast(info[0]));
-		WrapBody* wrap_bodyB = WrapBody::Unwrap(v8::Local<v8::Object>::Cast(info[1]));
-		WrapVec2* wrap_anchorA = WrapVec2::Unwrap(v8::Local<v8::Object>::Cast(info[2]));
-		WrapVec2* wrap_anchorB = WrapVec2::Unwrap(v8::Local<v8::Object>::Cast(info[3]));
-		wrap->SyncPull();
-		wrap->m_distance_jd.Initialize(wrap_bodyA->Peek(), wrap_bodyB->Peek(), wrap_anchorA->GetVec2(), wrap_anchorB->GetVec2());
-		wrap->SyncPush();
-	}
-};
-
-//// b2DistanceJoint
-
-class WrapDistanceJoint : public WrapJoint
-{
-private:
-	b2DistanceJoint* m_distance_joint;
-private:
-	WrapDistanceJoint() : m_distance_joint(NULL) {}
-	~WrapDistanceJoint() {}
-public:
-	b2DistanceJoint* Peek() { return m_distance_joint; }
-	virtual b2Joint* GetJoint() { return m_distance_joint; } // override WrapJoint
-	void SetupObject(v8::Local<v8::Object> h_world, WrapDistanceJointDef* wrap_distance_jd, b2DistanceJoint* distance_joint)
-	{
-		m_distance_joint = distance_joint;
-		WrapJoint::SetupObject(h_world, wrap_distance_jd);
-	}
-	b2DistanceJoint* ResetObject()
-	{
-		WrapJoint::ResetObject();
-		b2DistanceJoint* distance_joint = m_distance_joint;
-		m_distance_joint = NULL;
-		return distance_joint;
-	}
-public:
-	static WrapDistanceJoint* Unwrap(v8::Local<v8::Value> value) { return (value->IsObject())?(Unwrap(v8::Local<v8::Object>::Cast(value))):(NULL); }
-	static WrapDistanceJoint* Unwrap(v8::Local<v8::Object> object) { return Nan::ObjectWrap::Unwrap<WrapDistanceJoint>(object); }
-	static b2DistanceJoint* Peek(v8::Local<v8::Value> value) { WrapDistanceJoint* wrap = Unwrap(value); return (wrap)?(wrap->Peek()):(NULL); }
-public:
-	static NAN_MODULE_INIT(Init)
-	{
-		v8::Local<v8::Function> constructor = GetConstructor();
-		target->Set(constructor->GetName(), constructor);
-	}
-	static v8::Local<v8::Function> GetConstructor()
-	{
-		Nan::EscapableHandleScope scope;
-		v8::Local<v8::FunctionTemplate> function_template = GetFunctionTemplate();
-		v8::Local<v8::Function> constructor = function_template->GetFunction();
-		return scope.Escape(constructor);
-	}
-	static v8::Local<v8::FunctionTemplate> GetFunctionTemplate()
-	{
-		Nan::EscapableHandleScope scope;
-		static Nan::Persistent<v8::FunctionTemplate> g_function_template;
-		if (g_function_template.IsEmpty())
+		WrapJoint* wrap = Unwrap(info.This());
+		if (!wrap->m_joint_bodyA.IsEmpty())
 		{
-			v8::Local<v8::FunctionTemplate> function_template = Nan::New<v8::FunctionTemplate>(New);
-			g_function_template.Reset(function_template);
-			function_template->SetClassName(NANX_SYMBOL("b2DistanceJoint"));
-			function_template->Inherit(WrapJoint::GetFunctionTemplate());
-			function_template->InstanceTemplate()->SetInternalFieldCount(1);
-			v8::Local<v8::ObjectTemplate> prototype_template = function_template->PrototypeTemplate();
-			NANX_METHOD_APPLY(prototype_template, GetLocalAnchorA)
-			NANX_METHOD_APPLY(prototype_template, GetLocalAnchorB)
-			NANX_METHOD_APPLY(prototype_template, SetLength)
-			NANX_METHOD_APPLY(prototype_template, GetLength)
-			NANX_METHOD_APPLY(prototype_template, SetFrequency)
-			NANX_METHOD_APPLY(prototype_template, GetFrequency)
-			NANX_METHOD_APPLY(prototype_template, SetDampingRatio)
-			NANX_METHOD_APPLY(prototype_template, GetDampingRatio)
+			info.GetReturnValue().Set(Nan::New<v8::Object>(wrap->m_joint_bodyA));
+		}
+		else
+		{
+			info.GetReturnValue().SetNull();
 		}
-		v8::Local<v8::FunctionTemplate> function_template = Nan::New<v8::FunctionTemplate>(g_function_template);
-		return scope.Escape(function_template);
-	}
-	static v8::Local<v8::Object> NewInstance()
-	{
-		Nan::EscapableHandleScope scope;
-		v8::Local<v8::Function> constructor = GetConstructor();
-		v8::Local<v8::Object> instance = constructor->NewInstance();
-		return scope.Escape(instance);
 	}
-private:
-	static NAN_METHOD(New)
+	NANX_METHOD(GetBodyB)
 	{
-		if (info.IsConstructCall())
+		WrapJoint* wrap = Unwrap(info.This());
+		if (!wrap->m_joint_bodyB.IsEmpty())
 		{
-			WrapDistanceJoint* wrap = new WrapDistanceJoint();
-			wrap->Wrap(info.This());
-			info.GetReturnValue().Set(info.This());
+			info.GetReturnValue().Set(Nan::New<v8::Object>(wrap->m_joint_bodyB));
 		}
 		else
 		{
-			v8::Local<v8::Function> constructor = GetConstructor();
-			info.GetReturnValue().Set(constructor->NewInstance());
+			info.GetReturnValue().SetNull();
 		}
 	}
-///	b2Vec2 GetAnchorA() const;
-///	b2Vec2 GetAnchorB() const;
-///	b2Vec2 GetReactionForce(float32 inv_dt) const;
-///	float32 GetReactionTorque(float32 inv_dt) const;
-	NANX_METHOD(GetLocalAnchorA)
+	NANX_METHOD(GetAnchorA)
 	{
-		WrapDistanceJoint* wrap = Unwrap(info.This());
+		WrapJoint* wrap = Unwrap(info.This());
 		v8::Local<v8::Object> out = info[0]->IsUndefined() ? WrapVec2::NewInstance() : v8::Local<v8::Object>::Cast(info[0]);
-		WrapVec2::Unwrap(out)->SetVec2(wrap->m_distance_joint->GetLocalAnchorA());
+		WrapVec2::Unwrap(out)->SetVec2(wrap->GetJoint()->GetAnchorA());
 		info.GetReturnValue().Set(out);
 	}
-	NANX_METHOD(GetLocalAnchorB)
+	NANX_METHOD(GetAnchorB)
 	{
-		WrapDistanceJoint* wrap = Unwrap(info.This());
+		WrapJoint* wrap = Unwrap(info.This());
 		v8::Local<v8::Object> out = info[0]->IsUndefined() ? WrapVec2::NewInstance() : v8::Local<v8::Object>::Cast(info[0]);
-		WrapVec2::Unwrap(out)->SetVec2(wrap->m_distance_joint->GetLocalAnchorB());
+		WrapVec2::Unwrap(out)->SetVec2(wrap->GetJoint()->GetAnchorB());
 		info.GetReturnValue().Set(out);
 	}
-	NANX_METHOD(SetLength)
+	NANX_METHOD(GetReactionForce)
 	{
-		WrapDistanceJoint* wrap = Unwrap(info.This());
-		wrap->m_distance_joint->SetLength(NANX_float32(info[0]));
+		WrapJoint* wrap = Unwrap(info.This());
+		float32 inv_dt = NANX_float32(info[0]);
+		v8::Local<v8::Object> out = info[1]->IsUndefined() ? WrapVec2::NewInstance() : v8::Local<v8::Object>::Cast(info[1]);
+		WrapVec2::Unwrap(out)->SetVec2(wrap->GetJoint()->GetReactionForce(inv_dt));
+		info.GetReturnValue().Set(out);
 	}
-	NANX_METHOD(GetLength)
+	NANX_METHOD(GetReactionTorque)
 	{
-		WrapDistanceJoint* wrap = Unwrap(info.This());
-		info.GetReturnValue().Set(Nan::New(wrap->m_distance_joint->GetLength()));
+		WrapJoint* wrap = Unwrap(info.This());
+		float32 inv_dt = NANX_float32(info[0]);
+		info.GetReturnValue().Set(Nan::New(wrap->GetJoint()->GetReactionTorque(inv_dt)));
 	}
-	NANX_METHOD(SetFrequency)
+	NANX_METHOD(GetNext)
 	{
-		WrapDistanceJoint* wrap = Unwrap(info.This());
-		wrap->m_distance_joint->SetFrequency(NANX_float32(info[0]));
+		WrapJoint* wrap = Unwrap(info.This());
+		b2Joint* joint = SkipUnwrapped(wrap->GetJoint()->GetNext());
+		if (joint)
+		{
+			// get joint internal data
+			WrapJoint* wrap_joint = WrapJoint::GetWrap(joint);
+			info.GetReturnValue().Set(wrap_joint->handle());
+		}
+		else
+		{
+			info.GetReturnValue().SetNull();
+		}
 	}
-	NANX_METHOD(GetFrequency)
+	NANX_METHOD(GetUserData)
 	{
-		WrapDistanceJoint* wrap = Unwrap(info.This());
-		info.GetReturnValue().Set(Nan::New(wrap->m_distance_joint->GetFrequency()));
+		WrapJoint* wrap = Unwrap(info.This());
+		if (!wrap->m_joint_userData.IsEmpty())
+		{
+			info.GetReturnValue().Set(Nan::New<v8::Value>(wrap->m_joint_userData));
+		}
+		else
+		{
+			info.GetReturnValue().SetNull();
+		}
 	}
-	NANX_METHOD(SetDampingRatio)
+	NANX_METHOD(SetUserData)
 	{
-		WrapDistanceJoint* wrap = Unwrap(info.This());
-		wrap->m_distance_joint->SetDampingRatio(NANX_float32(info[0]));
+		WrapJoint* wrap = Unwrap(info.This());
+		if (!info[0]->IsUndefined())
+		{
+			wrap->m_joint_userData.Reset(info[0]);
+		}
+		else
+		{
+			wrap->m_joint_userData.Reset();
+		}
 	}
-	NANX_METHOD(GetDampingRatio)
+	NANX_METHOD(IsActive)
 	{
-		WrapDistanceJoint* wrap = Unwrap(info.This());
-		info.GetReturnValue().Set(Nan::New(wrap->m_distance_joint->GetDampingRatio()));
+		WrapJoint* wrap = Unwrap(info.This());
+		info.GetReturnValue().Set(Nan::New(wrap->GetJoint()->IsActive()));
 	}
-///	void Dump();
+	NANX_METHOD(GetCollideConnected)
+	{
+		WrapJoint* wrap = Unwrap(info.This());
+		info.GetReturnValue().Set(Nan::New(wrap->GetJoint()->GetCollideConnected()));
+	}
+	///virtual void Dump() { b2Log("// Dump is not supported for this joint type.\n"); }
+	//virtual void ShiftOrigin(const b2Vec2& newOrigin) { B2_NOT_USED(newOrigin);  }
 };
 
-//// b2PulleyJointDef
+//// b2RevoluteJointDef
 
-class WrapPulleyJointDef : public WrapJointDef
+class WrapRevoluteJointDef : public WrapJointDef
 {
 private:
-	b2PulleyJointDef m_pulley_jd;
-	Nan::Persistent<v8::Object> m_wrap_groundAnchorA; // m_pulley_jd.groundAnchorA
-	Nan::Persistent<v8::Object> m_wrap_groundAnchorB; // m_pulley_jd.groundAnchorB
-	Nan::Persistent<v8::Object> m_wrap_localAnchorA; // m_pulley_jd.localAnchorA
-	Nan::Persistent<v8::Object> m_wrap_localAnchorB; // m_pulley_jd.localAnchorB
+	b2RevoluteJointDef m_revolute_jd;
+	Nan::Persistent<v8::Object> m_wrap_localAnchorA; // m_revolute_jd.localAnchorA
+	Nan::Persistent<v8::Object> m_wrap_localAnchorB; // m_revolute_jd.localAnchorB
 private:
-	WrapPulleyJointDef()
+	WrapRevoluteJointDef()
 	{
-		m_wrap_groundAnchorA.Reset(WrapVec2::NewInstance(m_pulley_jd.groundAnchorA));
-		m_wrap_groundAnchorB.Reset(WrapVec2::NewInstance(m_pulley_jd.groundAnchorB));
-		m_wrap_localAnchorA.Reset(WrapVec2::NewInstance(m_pulley_jd.localAnchorA));
-		m_wrap_localAnchorB.Reset(WrapVec2::NewInstance(m_pulley_jd.localAnchorB));
+		m_wrap_localAnchorA.Reset(WrapVec2::NewInstance(m_revolute_jd.localAnchorA));
+		m_wrap_localAnchorB.Reset(WrapVec2::NewInstance(m_revolute_jd.localAnchorB));
 	}
-	~WrapPulleyJointDef()
+	~WrapRevoluteJointDef()
 	{
 		m_wrap_localAnchorA.Reset();
 		m_wrap_localAnchorB.Reset();
 	}
 public:
-	b2PulleyJointDef* Peek() { return &m_pulley_jd; }
-	virtual b2JointDef& GetJointDef() { return m_pulley_jd; } // override WrapJointDef
+	b2RevoluteJointDef* Peek() { return &m_revolute_jd; }
+	virtual b2JointDef& GetJointDef() { return m_revolute_jd; } // override WrapJointDef
 	virtual void SyncPull() // override WrapJointDef
 	{
 		// sync: pull data from javascript objects
 		WrapJointDef::SyncPull();
-		m_pulley_jd.groundAnchorA = WrapVec2::Unwrap(Nan::New<v8::Object>(m_wrap_groundAnchorA))->GetVec2(); // struct copy
-		m_pulley_jd.groundAnchorB = WrapVec2::Unwrap(Nan::New<v8::Object>(m_wrap_groundAnchorB))->GetVec2(); // struct copy
-		m_pulley_jd.localAnchorA = WrapVec2::Unwrap(Nan::New<v8::Object>(m_wrap_localAnchorA))->GetVec2(); // struct copy
-		m_pulley_jd.localAnchorB = WrapVec2::Unwrap(Nan::New<v8::Object>(m_wrap_localAnchorB))->GetVec2(); // struct copy
+		m_revolute_jd.localAnchorA = WrapVec2::Unwrap(Nan::New<v8::Object>(m_wrap_localAnchorA))->GetVec2(); // struct copy
+		m_revolute_jd.localAnchorB = WrapVec2::Unwrap(Nan::New<v8::Object>(m_wrap_localAnchorB))->GetVec2(); // struct copy
 	}
 	virtual void SyncPush() // override WrapJointDef
 	{
 		// sync: push data into javascript objects
 		WrapJointDef::SyncPush();
-		WrapVec2::Unwrap(Nan::New<v8::Object>(m_wrap_groundAnchorA))->SetVec2(m_pulley_jd.groundAnchorA);
-		WrapVec2::Unwrap(Nan::New<v8::Object>(m_wrap_groundAnchorB))->SetVec2(m_pulley_jd.groundAnchorB);
-		WrapVec2::Unwrap(Nan::New<v8::Object>(m_wrap_localAnchorA))->SetVec2(m_pulley_jd.localAnchorA);
-		WrapVec2::Unwrap(Nan::New<v8::Object>(m_wrap_localAnchorB))->SetVec2(m_pulley_jd.localAnchorB);
+		WrapVec2::Unwrap(Nan::New<v8::Object>(m_wrap_localAnchorA))->SetVec2(m_revolute_jd.localAnchorA);
+		WrapVec2::Unwrap(Nan::New<v8::Object>(m_wrap_localAnchorB))->SetVec2(m_revolute_jd.localAnchorB);
 	}
 public:
-	static WrapPulleyJointDef* Unwrap(v8::Local<v8::Value> value) { return (value->IsObject())?(Unwrap(v8::Local<v8::Object>::Cast(value))):(NULL); }
-	static WrapPulleyJointDef* Unwrap(v8::Local<v8::Object> object) { return Nan::ObjectWrap::Unwrap<WrapPulleyJointDef>(object); }
-	static b2PulleyJointDef* Peek(v8::Local<v8::Value> value) { WrapPulleyJointDef* wrap = Unwrap(value); return (wrap)?(wrap->Peek()):(NULL); }
+	static WrapRevoluteJointDef* Unwrap(v8::Local<v8::Value> value) { return (value->IsObject())?(Unwrap(v8::Local<v8::Object>::Cast(value))):(NULL); }
+	static WrapRevoluteJointDef* Unwrap(v8::Local<v8::Object> object) { return Nan::ObjectWrap::Unwrap<WrapRevoluteJointDef>(object); }
+	static b2RevoluteJointDef* Peek(v8::Local<v8::Value> value) { WrapRevoluteJointDef* wrap = Unwrap(value); return (wrap)?(wrap->Peek()):(NULL); }
 public:
 	static NAN_MODULE_INIT(Init)
 	{
@@ -3667,100 +5684,81 @@ public:
 		if (g_function_template.IsEmpty())
 		{
 			v8::Local<v8::FunctionTemplate> function_template = Nan::New<v8::FunctionTemplate>(New);
-			g_function_template.Reset(function_template);
-			function_template->SetClassName(NANX_SYMBOL("b2PulleyJointDef"));
 			function_template->Inherit(WrapJointDef::GetFunctionTemplate());
+			function_template->SetClassName(NANX_SYMBOL("b2RevoluteJointDef"));
 			function_template->InstanceTemplate()->SetInternalFieldCount(1);
 			v8::Local<v8::ObjectTemplate> prototype_template = function_template->PrototypeTemplate();
-			NANX_MEMBER_APPLY(prototype_template, groundAnchorA)
-			NANX_MEMBER_APPLY(prototype_template, groundAnchorB)
 			NANX_MEMBER_APPLY(prototype_template, localAnchorA)
 			NANX_MEMBER_APPLY(prototype_template, localAnchorB)
-			NANX_MEMBER_APPLY(prototype_template, lengthA)
-			NANX_MEMBER_APPLY(prototype_template, lengthB)
-			NANX_MEMBER_APPLY(prototype_template, ratio)
+			NANX_MEMBER_APPLY(prototype_template, referenceAngle)
+			NANX_MEMBER_APPLY(prototype_template, enableLimit)
+			NANX_MEMBER_APPLY(prototype_template, lowerAngle)
+			NANX_MEMBER_APPLY(prototype_template, upperAngle)
+			NANX_MEMBER_APPLY(prototype_template, enableMotor)
+			NANX_MEMBER_APPLY(prototype_template, motorSpeed)
+			NANX_MEMBER_APPLY(prototype_template, maxMotorTorque)
 			NANX_METHOD_APPLY(prototype_template, Initialize)
+			g_function_template.Reset(function_template);
 		}
 		v8::Local<v8::FunctionTemplate> function_template = Nan::New<v8::FunctionTemplate>(g_function_template);
 		return scope.Escape(function_template);
 	}
-	static v8::Local<v8::Object> NewInstance()
-	{
-		Nan::EscapableHandleScope scope;
-		v8::Local<v8::Function> constructor = GetConstructor();
-		v8::Local<v8::Object> instance = constructor->NewInstance();
-		return scope.Escape(instance);
-	}
 private:
 	static NAN_METHOD(New)
 	{
-		if (info.IsConstructCall())
-		{
-			WrapPulleyJointDef* wrap = new WrapPulleyJointDef();
-			wrap->Wrap(info.This());
-			info.GetReturnValue().Set(info.This());
-		}
-		else
-		{
-			v8::Local<v8::Function> constructor = GetConstructor();
-			info.GetReturnValue().Set(constructor->NewInstance());
-		}
+		WrapRevoluteJointDef* wrap = new WrapRevoluteJointDef();
+		wrap->Wrap(info.This());
+		info.GetReturnValue().Set(info.This());
 	}
-	NANX_MEMBER_OBJECT(groundAnchorA) // m_wrap_groundAnchorA
-	NANX_MEMBER_OBJECT(groundAnchorB) // m_wrap_groundAnchorB
-	NANX_MEMBER_OBJECT(localAnchorA) // m_wrap_localAnchorA
-	NANX_MEMBER_OBJECT(localAnchorB) // m_wrap_localAnchorB
-	NANX_MEMBER_NUMBER(float32, lengthA)
-	NANX_MEMBER_NUMBER(float32, lengthB)
-	NANX_MEMBER_NUMBER(float32, ratio)
+	NANX_MEMBER_OBJECT	(localAnchorA) // m_wrap_localAnchorA
+	NANX_MEMBER_OBJECT	(localAnchorB) // m_wrap_localAnchorB
+	NANX_MEMBER_NUMBER	(float32, referenceAngle)
+	NANX_MEMBER_BOOLEAN	(bool, enableLimit)
+	NANX_MEMBER_NUMBER	(float32, lowerAngle)
+	NANX_MEMBER_NUMBER	(float32, upperAngle)
+	NANX_MEMBER_BOOLEAN	(bool, enableMotor)
+	NANX_MEMBER_NUMBER	(float32, motorSpeed)
+	NANX_MEMBER_NUMBER	(float32, maxMotorTorque)
 	NANX_METHOD(Initialize)
 	{
-		WrapPulleyJointDef* wrap = Unwrap(info.This());
+		WrapRevoluteJointDef* wrap = Unwrap(info.This());
 		WrapBody* wrap_bodyA = WrapBody::Unwrap(v8::Local<v8::Object>::Cast(info[0]));
 		WrapBody* wrap_bodyB = WrapBody::Unwrap(v8::Local<v8::Object>::Cast(info[1]));
-		WrapVec2* wrap_groundAnchorA = WrapVec2::Unwrap(v8::Local<v8::Object>::Cast(info[2]));
-		WrapVec2* wrap_groundAnchorB = WrapVec2::Unwrap(v8::Local<v8::Object>::Cast(info[3]));
-		WrapVec2* wrap_anchorA = WrapVec2::Unwrap(v8::Local<v8::Object>::Cast(info[4]));
-		WrapVec2* wrap_anchorB = WrapVec2::Unwrap(v8::Local<v8::Object>::Cast(info[5]));
-		float32 ratio = NANX_float32(info[6]);
+		WrapVec2* wrap_anchor = WrapVec2::Unwrap(v8::Local<v8::Object>::Cast(info[2]));
 		wrap->SyncPull();
-		wrap->m_pulley_jd.Initialize(
-		   wrap_bodyA->Peek(), wrap_bodyB->Peek(),
-		   wrap_groundAnchorA->GetVec2(), wrap_groundAnchorB->GetVec2(),
-		   wrap_anchorA->GetVec2(), wrap_anchorB->GetVec2(),
-		   ratio);
+		wrap->m_revolute_jd.Initialize(wrap_bodyA->Peek(), wrap_bodyB->Peek(), wrap_anchor->GetVec2());
 		wrap->SyncPush();
 	}
 };
 
-//// b2PulleyJoint
+//// b2RevoluteJoint
 
-class WrapPulleyJoint : public WrapJoint
+class WrapRevoluteJoint : public WrapJoint
 {
 private:
-	b2PulleyJoint* m_pulley_joint;
+	b2RevoluteJoint* m_revolute_joint;
 private:
-	WrapPulleyJoint() : m_pulley_joint(NULL) {}
-	~WrapPulleyJoint() {}
+	WrapRevoluteJoint() : m_revolute_joint(NULL) {}
+	~WrapRevoluteJoint() {}
 public:
-	b2PulleyJoint* Peek() { return m_pulley_joint; }
-	virtual b2Joint* GetJoint() { return m_pulley_joint; } // override WrapJoint
-	void SetupObject(v8::Local<v8::Object> h_world, WrapPulleyJointDef* wrap_pulley_jd, b2PulleyJoint* pulley_joint)
+	b2RevoluteJoint* Peek() { return m_revolute_joint; }
+	virtual b2Joint* GetJoint() { return m_revolute_joint; } // override WrapJoint
+	void SetupObject(v8::Local<v8::Object> h_world, WrapRevoluteJointDef* wrap_revolute_jd, b2RevoluteJoint* revolute_joint)
 	{
-		m_pulley_joint = pulley_joint;
-		WrapJoint::SetupObject(h_world, wrap_pulley_jd);
+		m_revolute_joint = revolute_joint;
+		WrapJoint::SetupObject(h_world, wrap_revolute_jd);
 	}
-	b2PulleyJoint* ResetObject()
+	b2RevoluteJoint* ResetObject()
 	{
 		WrapJoint::ResetObject();
-		b2PulleyJoint* pulley_joint = m_pulley_joint;
-		m_pulley_joint = NULL;
-		return pulley_joint;
+		b2RevoluteJoint* revolute_joint = m_revolute_joint;
+		m_revolute_joint = NULL;
+		return revolute_joint;
 	}
 public:
-	static WrapPulleyJoint* Unwrap(v8::Local<v8::Value> value) { return (value->IsObject())?(Unwrap(v8::Local<v8::Object>::Cast(value))):(NULL); }
-	static WrapPulleyJoint* Unwrap(v8::Local<v8::Object> object) { return Nan::ObjectWrap::Unwrap<WrapPulleyJoint>(object); }
-	static b2PulleyJoint* Peek(v8::Local<v8::Value> value) { WrapPulleyJoint* wrap = Unwrap(value); return (wrap)?(wrap->Peek()):(NULL); }
+	static WrapRevoluteJoint* Unwrap(v8::Local<v8::Value> value) { return (value->IsObject())?(Unwrap(v8::Local<v8::Object>::Cast(value))):(NULL); }
+	static WrapRevoluteJoint* Unwrap(v8::Local<v8::Object> object) { return Nan::ObjectWrap::Unwrap<WrapRevoluteJoint>(object); }
+	static b2RevoluteJoint* Peek(v8::Local<v8::Value> value) { WrapRevoluteJoint* wrap = Unwrap(value); return (wrap)?(wrap->Peek()):(NULL); }
 public:
 	static NAN_MODULE_INIT(Init)
 	{
@@ -3781,18 +5779,27 @@ public:
 		if (g_function_template.IsEmpty())
 		{
 			v8::Local<v8::FunctionTemplate> function_template = Nan::New<v8::FunctionTemplate>(New);
-			g_function_template.Reset(function_template);
-			function_template->SetClassName(NANX_SYMBOL("b2PulleyJoint"));
-			function_template->Inherit(WrapJoint::GetFunctionTemplate());
+			function_template->SetClassName(NANX_SYMBOL("b2RevoluteJoint"));
 			function_template->InstanceTemplate()->SetInternalFieldCount(1);
 			v8::Local<v8::ObjectTemplate> prototype_template = function_template->PrototypeTemplate();
-			NANX_METHOD_APPLY(prototype_template, GetGroundAnchorA)
-			NANX_METHOD_APPLY(prototype_template, GetGroundAnchorB)
-			NANX_METHOD_APPLY(prototype_template, GetLengthA)
-			NANX_METHOD_APPLY(prototype_template, GetLengthB)
-			NANX_METHOD_APPLY(prototype_template, GetRatio)
-			NANX_METHOD_APPLY(prototype_template, GetCurrentLengthA)
-			NANX_METHOD_APPLY(prototype_template, GetCurrentLengthB)
+			NANX_METHOD_APPLY(prototype_template, GetLocalAnchorA)
+			NANX_METHOD_APPLY(prototype_template, GetLocalAnchorB)
+			NANX_METHOD_APPLY(prototype_template, GetReferenceAngle)
+			NANX_METHOD_APPLY(prototype_template, GetJointAngle)
+			NANX_METHOD_APPLY(prototype_template, GetJointSpeed)
+			NANX_METHOD_APPLY(prototype_template, IsLimitEnabled)
+			NANX_METHOD_APPLY(prototype_template, EnableLimit)
+			NANX_METHOD_APPLY(prototype_template, GetLowerLimit)
+			NANX_METHOD_APPLY(prototype_template, GetUpperLimit)
+			NANX_METHOD_APPLY(prototype_template, SetLimits)
+			NANX_METHOD_APPLY(prototype_template, IsMotorEnabled)
+			NANX_METHOD_APPLY(prototype_template, EnableMotor)
+			NANX_METHOD_APPLY(prototype_template, SetMotorSpeed)
+			NANX_METHOD_APPLY(prototype_template, GetMotorSpeed)
+			NANX_METHOD_APPLY(prototype_template, SetMaxMotorTorque)
+			NANX_METHOD_APPLY(prototype_template, GetMaxMotorTorque)
+			NANX_METHOD_APPLY(prototype_template, GetMotorTorque)
+			g_function_template.Reset(function_template);
 		}
 		v8::Local<v8::FunctionTemplate> function_template = Nan::New<v8::FunctionTemplate>(g_function_template);
 		return scope.Escape(function_template);
@@ -3807,99 +5814,164 @@ public:
 private:
 	static NAN_METHOD(New)
 	{
-		if (info.IsConstructCall())
-		{
-			WrapPulleyJoint* wrap = new WrapPulleyJoint();
-			wrap->Wrap(info.This());
-			info.GetReturnValue().Set(info.This());
-		}
-		else
-		{
-			v8::Local<v8::Function> constructor = GetConstructor();
-			info.GetReturnValue().Set(constructor->NewInstance());
-		}
+		WrapRevoluteJoint* wrap = new WrapRevoluteJoint();
+		wrap->Wrap(info.This());
+		info.GetReturnValue().Set(info.This());
 	}
-///	b2Vec2 GetAnchorA() const;
-///	b2Vec2 GetAnchorB() const;
-///	b2Vec2 GetReactionForce(float32 inv_dt) const;
-///	float32 GetReactionTorque(float32 inv_dt) const;
-	NANX_METHOD(GetGroundAnchorA)
+	///	b2Vec2 GetAnchorA() const;
+	///	b2Vec2 GetAnchorB() const;
+	///	b2Vec2 GetReactionForce(float32 inv_dt) const;
+	///	float32 GetReactionTorque(float32 inv_dt) const;
+	NANX_METHOD(GetLocalAnchorA)
 	{
-		WrapPulleyJoint* wrap = Unwrap(info.This());
+		WrapRevoluteJoint* wrap = Unwrap(info.This());
 		v8::Local<v8::Object> out = info[0]->IsUndefined() ? WrapVec2::NewInstance() : v8::Local<v8::Object>::Cast(info[0]);
-		WrapVec2::Unwrap(out)->SetVec2(wrap->m_pulley_joint->GetGroundAnchorA());
+		WrapVec2::Unwrap(out)->SetVec2(wrap->m_revolute_joint->GetLocalAnchorA());
 		info.GetReturnValue().Set(out);
 	}
-	NANX_METHOD(GetGroundAnchorB)
+	NANX_METHOD(GetLocalAnchorB)
 	{
-		WrapPulleyJoint* wrap = Unwrap(info.This());
+		WrapRevoluteJoint* wrap = Unwrap(info.This());
 		v8::Local<v8::Object> out = info[0]->IsUndefined() ? WrapVec2::NewInstance() : v8::Local<v8::Object>::Cast(info[0]);
-		WrapVec2::Unwrap(out)->SetVec2(wrap->m_pulley_joint->GetGroundAnchorB());
+		WrapVec2::Unwrap(out)->SetVec2(wrap->m_revolute_joint->GetLocalAnchorB());
 		info.GetReturnValue().Set(out);
 	}
-	NANX_METHOD(GetLengthA)
+	NANX_METHOD(GetReferenceAngle)
 	{
-		WrapPulleyJoint* wrap = Unwrap(info.This());
-		info.GetReturnValue().Set(Nan::New(wrap->m_pulley_joint->GetLengthA()));
+		WrapRevoluteJoint* wrap = Unwrap(info.This());
+		info.GetReturnValue().Set(Nan::New(wrap->m_revolute_joint->GetReferenceAngle()));
 	}
-	NANX_METHOD(GetLengthB)
+	NANX_METHOD(GetJointAngle)
 	{
-		WrapPulleyJoint* wrap = Unwrap(info.This());
-		info.GetReturnValue().Set(Nan::New(wrap->m_pulley_joint->GetLengthB()));
+		WrapRevoluteJoint* wrap = Unwrap(info.This());
+		info.GetReturnValue().Set(Nan::New(wrap->m_revolute_joint->GetJointAngle()));
 	}
-	NANX_METHOD(GetRatio)
+	NANX_METHOD(GetJointSpeed)
 	{
-		WrapPulleyJoint* wrap = Unwrap(info.This());
-		info.GetReturnValue().Set(Nan::New(wrap->m_pulley_joint->GetRatio()));
+		WrapRevoluteJoint* wrap = Unwrap(info.This());
+		info.GetReturnValue().Set(Nan::New(wrap->m_revolute_joint->GetJointSpeed()));
 	}
-	NANX_METHOD(GetCurrentLengthA)
+	NANX_METHOD(IsLimitEnabled)
 	{
-		WrapPulleyJoint* wrap = Unwrap(info.This());
-		info.GetReturnValue().Set(Nan::New(wrap->m_pulley_joint->GetCurrentLengthA()));
+		WrapRevoluteJoint* wrap = Unwrap(info.This());
+		info.GetReturnValue().Set(Nan::New(wrap->m_revolute_joint->IsLimitEnabled()));
 	}
-	NANX_METHOD(GetCurrentLengthB)
+	NANX_METHOD(EnableLimit)
 	{
-		WrapPulleyJoint* wrap = Unwrap(info.This());
-		info.GetReturnValue().Set(Nan::New(wrap->m_pulley_joint->GetCurrentLengthB()));
+		WrapRevoluteJoint* wrap = Unwrap(info.This());
+		bool flag = NANX_bool(info[0]);
+		Recorder* recorder = wrap->Recording();
+		if (recorder) { recorder->Op(e_recordEnableLimit).Int(recorder->GetJointId(wrap->m_revolute_joint)).Bool(flag); }
+		wrap->m_revolute_joint->EnableLimit(flag);
 	}
-///	void Dump();
+	NANX_METHOD(GetLowerLimit)
+	{
+		WrapRevoluteJoint* wrap = Unwrap(info.This());
+		info.GetReturnValue().Set(Nan::New(wrap->m_revolute_joint->GetLowerLimit()));
+	}
+	NANX_METHOD(GetUpperLimit)
+	{
+		WrapRevoluteJoint* wrap = Unwrap(info.This());
+		info.GetReturnValue().Set(Nan::New(wrap->m_revolute_joint->GetUpperLimit()));
+	}
+	NANX_METHOD(SetLimits)
+	{
+		WrapRevoluteJoint* wrap = Unwrap(info.This());
+		float32 lower = NANX_float32(info[0]);
+		float32 upper = NANX_float32(info[1]);
+		Recorder* recorder = wrap->Recording();
+		if (recorder) { recorder->Op(e_recordSetLimits).Int(recorder->GetJointId(wrap->m_revolute_joint)).Float(lower).Float(upper); }
+		wrap->m_revolute_joint->SetLimits(lower, upper);
+	}
+	NANX_METHOD(IsMotorEnabled)
+	{
+		WrapRevoluteJoint* wrap = Unwrap(info.This());
+		info.GetReturnValue().Set(Nan::New(wrap->m_revolute_joint->IsMotorEnabled()));
+	}
+	NANX_METHOD(EnableMotor)
+	{
+		WrapRevoluteJoint* wrap = Unwrap(info.This());
+		bool flag = NANX_bool(info[0]);
+		Recorder* recorder = wrap->Recording();
+		if (recorder) { recorder->Op(e_recordEnableMotor).Int(recorder->GetJointId(wrap->m_revolute_joint)).Bool(flag); }
+		wrap->m_revolute_joint->EnableMotor(flag);
+	}
+	NANX_METHOD(SetMotorSpeed)
+	{
+		WrapRevoluteJoint* wrap = Unwrap(info.This());
+		float32 speed = NANX_float32(info[0]);
+		Recorder* recorder = wrap->Recording();
+		if (recorder) { recorder->Op(e_recordSetMotorSpeed).Int(recorder->GetJointId(wrap->m_revolute_joint)).Float(speed); }
+		wrap->m_revolute_joint->SetMotorSpeed(speed);
+	}
+	NANX_METHOD(GetMotorSpeed)
+	{
+		WrapRevoluteJoint* wrap = Unwrap(info.This());
+		info.GetReturnValue().Set(Nan::New(wrap->m_revolute_joint->GetMotorSpeed()));
+	}
+	NANX_METHOD(SetMaxMotorTorque)
+	{
+		WrapRevoluteJoint* wrap = Unwrap(info.This());
+		wrap->m_revolute_joint->SetMaxMotorTorque(NANX_float32(info[0]));
+	}
+	NANX_METHOD(GetMaxMotorTorque)
+	{
+		WrapRevoluteJoint* wrap = Unwrap(info.This());
+		info.GetReturnValue().Set(Nan::New(wrap->m_revolute_joint->GetMaxMotorTorque()));
+	}
+	NANX_METHOD(GetMotorTorque)
+	{
+		WrapRevoluteJoint* wrap = Unwrap(info.This());
+		info.GetReturnValue().Set(Nan::New(wrap->m_revolute_joint->GetMotorTorque(NANX_float32(info[0]))));
+	}
+	///	void Dump();
 };
 
-//// b2MouseJointDef
+//// b2PrismaticJointDef
 
-class WrapMouseJointDef : public WrapJointDef
+class WrapPrismaticJointDef : public WrapJointDef
 {
 private:
-	b2MouseJointDef m_mouse_jd;
-	Nan::Persistent<v8::Object> m_wrap_target; // m_mouse_jd.target
+	b2PrismaticJointDef m_prismatic_jd;
+	Nan::Persistent<v8::Object> m_wrap_localAnchorA; // m_prismatic_jd.localAnchorA
+	Nan::Persistent<v8::Object> m_wrap_localAnchorB; // m_prismatic_jd.localAnchorB
+	Nan::Persistent<v8::Object> m_wrap_localAxisA; // m_prismatic_jd.localAxisA
 private:
-	WrapMouseJointDef()
+	WrapPrismaticJointDef()
 	{
-		m_wrap_target.Reset(WrapVec2::NewInstance(m_mouse_jd.target));
+		m_wrap_localAnchorA.Reset(WrapVec2::NewInstance(m_prismatic_jd.localAnchorA));
+		m_wrap_localAnchorB.Reset(WrapVec2::NewInstance(m_prismatic_jd.localAnchorB));
+		m_wrap_localAxisA.Reset(WrapVec2::NewInstance(m_prismatic_jd.localAxisA));
 	}
-	~WrapMouseJointDef()
+	~WrapPrismaticJointDef()
 	{
-		m_wrap_target.Reset();
+		m_wrap_localAnchorA.Reset();
+		m_wrap_localAnchorB.Reset();
+		m_wrap_localAxisA.Reset();
 	}
 public:
-	b2MouseJointDef* Peek() { return &m_mouse_jd; }
-	virtual b2JointDef& GetJointDef() { return m_mouse_jd; } // override WrapJointDef
+	b2PrismaticJointDef* Peek() { return &m_prismatic_jd; }
+	virtual b2JointDef& GetJointDef() { return m_prismatic_jd; } // override WrapJointDef
 	virtual void SyncPull() // override WrapJointDef
 	{
 		// sync: pull data from javascript objects
 		WrapJointDef::SyncPull();
-		m_mouse_jd.target = WrapVec2::Unwrap(Nan::New<v8::Object>(m_wrap_target))->GetVec2(); // struct copy
+		m_prismatic_jd.localAnchorA = WrapVec2::Unwrap(Nan::New<v8::Object>(m_wrap_localAnchorA))->GetVec2(); // struct copy
+		m_prismatic_jd.localAnchorB = WrapVec2::Unwrap(Nan::New<v8::Object>(m_wrap_localAnchorB))->GetVec2(); // struct copy
+		m_prismatic_jd.localAxisA = WrapVec2::Unwrap(Nan::New<v8::Object>(m_wrap_localAxisA))->GetVec2(); // struct copy
 	}
 	virtual void SyncPush() // override WrapJointDef
 	{
 		// sync: push data into javascript objects
 		WrapJointDef::SyncPush();
-		WrapVec2::Unwrap(Nan::New<v8::Object>(m_wrap_target))->SetVec2(m_mouse_jd.target);
+		WrapVec2::Unwrap(Nan::New<v8::Object>(m_wrap_localAnchorA))->SetVec2(m_prismatic_jd.localAnchorA);
+		WrapVec2::Unwrap(Nan::New<v8::Object>(m_wrap_localAnchorB))->SetVec2(m_prismatic_jd.localAnchorB);
+		WrapVec2::Unwrap(Nan::New<v8::Object>(m_wrap_localAxisA))->SetVec2(m_prismatic_jd.localAxisA);
 	}
 public:
-	static WrapMouseJointDef* Unwrap(v8::Local<v8::Value> value) { return (value->IsObject())?(Unwrap(v8::Local<v8::Object>::Cast(value))):(NULL); }
-	static WrapMouseJointDef* Unwrap(v8::Local<v8::Object> object) { return Nan::ObjectWrap::Unwrap<WrapMouseJointDef>(object); }
-	static b2MouseJointDef* Peek(v8::Local<v8::Value> value) { WrapMouseJointDef* wrap = Unwrap(value); return (wrap)?(wrap->Peek()):(NULL); }
+	static WrapPrismaticJointDef* Unwrap(v8::Local<v8::Value> value) { return (value->IsObject())?(Unwrap(v8::Local<v8::Object>::Cast(value))):(NULL); }
+	static WrapPrismaticJointDef* Unwrap(v8::Local<v8::Object> object) { return Nan::ObjectWrap::Unwrap<WrapPrismaticJointDef>(object); }
+	static b2PrismaticJointDef* Peek(v8::Local<v8::Value> value) { WrapPrismaticJointDef* wrap = Unwrap(value); return (wrap)?(wrap->Peek()):(NULL); }
 public:
 	static NAN_MODULE_INIT(Init)
 	{
@@ -3920,75 +5992,84 @@ public:
 		if (g_function_template.IsEmpty())
 		{
 			v8::Local<v8::FunctionTemplate> function_template = Nan::New<v8::FunctionTemplate>(New);
-			g_function_template.Reset(function_template);
-			function_template->SetClassName(NANX_SYMBOL("b2MouseJointDef"));
 			function_template->Inherit(WrapJointDef::GetFunctionTemplate());
+			function_template->SetClassName(NANX_SYMBOL("b2PrismaticJointDef"));
 			function_template->InstanceTemplate()->SetInternalFieldCount(1);
 			v8::Local<v8::ObjectTemplate> prototype_template = function_template->PrototypeTemplate();
-			NANX_MEMBER_APPLY(prototype_template, target)
-			NANX_MEMBER_APPLY(prototype_template, maxForce)
-			NANX_MEMBER_APPLY(prototype_template, frequencyHz)
-			NANX_MEMBER_APPLY(prototype_template, dampingRatio)
-		}
-		v8::Local<v8::FunctionTemplate> function_template = Nan::New<v8::FunctionTemplate>(g_function_template);
-		return scope.Escape(function_template);
-	}
-	static v8::Local<v8::Object> NewInstance()
-	{
-		Nan::EscapableHandleScope scope;
-		v8::Local<v8::Function> constructor = GetConstructor();
-		v8::Local<v8::Object> instance = constructor->NewInstance();
-		return scope.Escape(instance);
+			NANX_MEMBER_APPLY(prototype_template, localAnchorA)
+			NANX_MEMBER_APPLY(prototype_template, localAnchorB)
+			NANX_MEMBER_APPLY(prototype_template, localAxisA)
+			NANX_MEMBER_APPLY(prototype_template, referenceAngle)
+			NANX_MEMBER_APPLY(prototype_template, enableLimit)
+			NANX_MEMBER_APPLY(prototype_template, lowerTranslation)
+			NANX_MEMBER_APPLY(prototype_template, upperTranslation)
+			NANX_MEMBER_APPLY(prototype_template, enableMotor)
+			NANX_MEMBER_APPLY(prototype_template, maxMotorForce)
+			NANX_MEMBER_APPLY(prototype_template, motorSpeed)
+			NANX_METHOD_APPLY(prototype_template, Initialize)
+			g_function_template.Reset(function_template);
+		}
+		v8::Local<v8::FunctionTemplate> function_template = Nan::New<v8::FunctionTemplate>(g_function_template);
+		return scope.Escape(function_template);
 	}
 private:
 	static NAN_METHOD(New)
 	{
-		if (info.IsConstructCall())
-		{
-			WrapMouseJointDef* wrap = new WrapMouseJointDef();
-			wrap->Wrap(info.This());
-			info.GetReturnValue().Set(info.This());
-		}
-		else
-		{
-			v8::Local<v8::Function> constructor = GetConstructor();
-			info.GetReturnValue().Set(constructor->NewInstance());
-		}
+		WrapPrismaticJointDef* wrap = new WrapPrismaticJointDef();
+		wrap->Wrap(info.This());
+		info.GetReturnValue().Set(info.This());
+	}
+	NANX_MEMBER_OBJECT	(localAnchorA) // m_wrap_localAnchorA
+	NANX_MEMBER_OBJECT	(localAnchorB) // m_wrap_localAnchorB
+	NANX_MEMBER_OBJECT	(localAxisA) // m_wrap_localAxisA
+	NANX_MEMBER_NUMBER	(float32, referenceAngle)
+	NANX_MEMBER_BOOLEAN	(bool, enableLimit)
+	NANX_MEMBER_NUMBER	(float32, lowerTranslation)
+	NANX_MEMBER_NUMBER	(float32, upperTranslation)
+	NANX_MEMBER_BOOLEAN	(bool, enableMotor)
+	NANX_MEMBER_NUMBER	(float32, maxMotorForce)
+	NANX_MEMBER_NUMBER	(float32, motorSpeed)
+	NANX_METHOD(Initialize)
+	{
+		WrapPrismaticJointDef* wrap = Unwrap(info.This());
+		WrapBody* wrap_bodyA = WrapBody::Unwrap(v8::Local<v8::Object>::Cast(info[0]));
+		WrapBody* wrap_bodyB = WrapBody::Unwrap(v8::Local<v8::Object>::Cast(info[1]));
+		WrapVec2* wrap_anchor = WrapVec2::Unwrap(v8::Local<v8::Object>::Cast(info[2]));
+		WrapVec2* wrap_axis = WrapVec2::Unwrap(v8::Local<v8::Object>::Cast(info[3]));
+		wrap->SyncPull();
+		wrap->m_prismatic_jd.Initialize(wrap_bodyA->Peek(), wrap_bodyB->Peek(), wrap_anchor->GetVec2(), wrap_axis->GetVec2());
+		wrap->SyncPush();
 	}
-	NANX_MEMBER_OBJECT(target) // m_wrap_target
-	NANX_MEMBER_NUMBER(float32, maxForce)
-	NANX_MEMBER_NUMBER(float32, frequencyHz)
-	NANX_MEMBER_NUMBER(float32, dampingRatio)
 };
 
-//// b2MouseJoint
+//// b2PrismaticJoint
 
-class WrapMouseJoint : public WrapJoint
+class WrapPrismaticJoint : public WrapJoint
 {
 private:
-	b2MouseJoint* m_mouse_joint;
+	b2PrismaticJoint* m_prismatic_joint;
 private:
-	WrapMouseJoint() : m_mouse_joint(NULL) {}
-	~WrapMouseJoint() {}
+	WrapPrismaticJoint() : m_prismatic_joint(NULL) {}
+	~WrapPrismaticJoint() {}
 public:
-	b2MouseJoint* Peek() { return m_mouse_joint; }
-	virtual b2Joint* GetJoint() { return m_mouse_joint; } // override WrapJoint
-	void SetupObject(v8::Local<v8::Object> h_world, WrapMouseJointDef* wrap_mouse_jd, b2MouseJoint* mouse_joint)
+	b2PrismaticJoint* Peek() { return m_prismatic_joint; }
+	virtual b2Joint* GetJoint() { return m_prismatic_joint; } // override WrapJoint
+	void SetupObject(v8::Local<v8::Object> h_world, WrapPrismaticJointDef* wrap_prismatic_jd, b2PrismaticJoint* prismatic_joint)
 	{
-		m_mouse_joint = mouse_joint;
-		WrapJoint::SetupObject(h_world, wrap_mouse_jd);
+		m_prismatic_joint = prismatic_joint;
+		WrapJoint::SetupObject(h_world, wrap_prismatic_jd);
 	}
-	b2MouseJoint* ResetObject()
+	b2PrismaticJoint* ResetObject()
 	{
 		WrapJoint::ResetObject();
-		b2MouseJoint* mouse_joint = m_mouse_joint;
-		m_mouse_joint = NULL;
-		return mouse_joint;
+		b2PrismaticJoint* prismatic_joint = m_prismatic_joint;
+		m_prismatic_joint = NULL;
+		return prismatic_joint;
 	}
 public:
-	static WrapMouseJoint* Unwrap(v8::Local<v8::Value> value) { return (value->IsObject())?(Unwrap(v8::Local<v8::Object>::Cast(value))):(NULL); }
-	static WrapMouseJoint* Unwrap(v8::Local<v8::Object> object) { return Nan::ObjectWrap::Unwrap<WrapMouseJoint>(object); }
-	static b2MouseJoint* Peek(v8::Local<v8::Value> value) { WrapMouseJoint* wrap = Unwrap(value); return (wrap)?(wrap->Peek()):(NULL); }
+	static WrapPrismaticJoint* Unwrap(v8::Local<v8::Value> value) { return (value->IsObject())?(Unwrap(v8::Local<v8::Object>::Cast(value))):(NULL); }
+	static WrapPrismaticJoint* Unwrap(v8::Local<v8::Object> object) { return Nan::ObjectWrap::Unwrap<WrapPrismaticJoint>(object); }
+	static b2PrismaticJoint* Peek(v8::Local<v8::Value> value) { WrapPrismaticJoint* wrap = Unwrap(value); return (wrap)?(wrap->Peek()):(NULL); }
 public:
 	static NAN_MODULE_INIT(Init)
 	{
@@ -4009,19 +6090,29 @@ public:
 		if (g_function_template.IsEmpty())
 		{
 			v8::Local<v8::FunctionTemplate> function_template = Nan::New<v8::FunctionTemplate>(New);
-			g_function_template.Reset(function_template);
-			function_template->SetClassName(NANX_SYMBOL("b2MouseJoint"));
 			function_template->Inherit(WrapJoint::GetFunctionTemplate());
+			function_template->SetClassName(NANX_SYMBOL("b2PrismaticJoint"));
 			function_template->InstanceTemplate()->SetInternalFieldCount(1);
 			v8::Local<v8::ObjectTemplate> prototype_template = function_template->PrototypeTemplate();
-			NANX_METHOD_APPLY(prototype_template, SetTarget)
-			NANX_METHOD_APPLY(prototype_template, GetTarget)
-			NANX_METHOD_APPLY(prototype_template, SetMaxForce)
-			NANX_METHOD_APPLY(prototype_template, GetMaxForce)
-			NANX_METHOD_APPLY(prototype_template, SetFrequency)
-			NANX_METHOD_APPLY(prototype_template, GetFrequency)
-			NANX_METHOD_APPLY(prototype_template, SetDampingRatio)
-			NANX_METHOD_APPLY(prototype_template, GetDampingRatio)
+			NANX_METHOD_APPLY(prototype_template, GetLocalAnchorA)
+			NANX_METHOD_APPLY(prototype_template, GetLocalAnchorB)
+			NANX_METHOD_APPLY(prototype_template, GetLocalAxisA)
+			NANX_METHOD_APPLY(prototype_template, GetReferenceAngle)
+			NANX_METHOD_APPLY(prototype_template, GetJointTranslation)
+			NANX_METHOD_APPLY(prototype_template, GetJointSpeed)
+			NANX_METHOD_APPLY(prototype_template, IsLimitEnabled)
+			NANX_METHOD_APPLY(prototype_template, EnableLimit)
+			NANX_METHOD_APPLY(prototype_template, GetLowerLimit)
+			NANX_METHOD_APPLY(prototype_template, GetUpperLimit)
+			NANX_METHOD_APPLY(prototype_template, SetLimits)
+			NANX_METHOD_APPLY(prototype_template, IsMotorEnabled)
+			NANX_METHOD_APPLY(prototype_template, EnableMotor)
+			NANX_METHOD_APPLY(prototype_template, SetMotorSpeed)
+			NANX_METHOD_APPLY(prototype_template, GetMotorSpeed)
+			NANX_METHOD_APPLY(prototype_template, SetMaxMotorForce)
+			NANX_METHOD_APPLY(prototype_template, GetMaxMotorForce)
+			NANX_METHOD_APPLY(prototype_template, GetMotorForce)
+			g_function_template.Reset(function_template);
 		}
 		v8::Local<v8::FunctionTemplate> function_template = Nan::New<v8::FunctionTemplate>(g_function_template);
 		return scope.Escape(function_template);
@@ -4036,203 +6127,166 @@ public:
 private:
 	static NAN_METHOD(New)
 	{
-		if (info.IsConstructCall())
-		{
-			WrapMouseJoint* wrap = new WrapMouseJoint();
-			wrap->Wrap(info.This());
-			info.GetReturnValue().Set(info.This());
-		}
-		else
-		{
-			v8::Local<v8::Function> constructor = GetConstructor();
-			info.GetReturnValue().Set(constructor->NewInstance());
-		}
+		WrapPrismaticJoint* wrap = new WrapPrismaticJoint();
+		wrap->Wrap(info.This());
+		info.GetReturnValue().Set(info.This());
 	}
-///	b2Vec2 GetAnchorA() const;
-///	b2Vec2 GetAnchorB() const;
-///	b2Vec2 GetReactionForce(float32 inv_dt) const;
-///	float32 GetReactionTorque(float32 inv_dt) const;
-	NANX_METHOD(SetTarget)
+	///b2Vec2 GetAnchorA() const;
+	///b2Vec2 GetAnchorB() const;
+	///b2Vec2 GetReactionForce(float32 inv_dt) const;
+	///float32 GetReactionTorque(float32 inv_dt) const;
+	NANX_METHOD(GetLocalAnchorA)
 	{
-		WrapMouseJoint* wrap = Unwrap(info.This());
-		WrapVec2* wrap_target = WrapVec2::Unwrap(v8::Local<v8::Object>::Cast(info[0]));
-		wrap->m_mouse_joint->SetTarget(wrap_target->GetVec2());
+		WrapPrismaticJoint* wrap = Unwrap(info.This());
+		v8::Local<v8::Object> out = info[0]->IsUndefined() ? WrapVec2::NewInstance() : v8::Local<v8::Object>::Cast(info[0]);
+		WrapVec2::Unwrap(out)->SetVec2(wrap->m_prismatic_joint->GetLocalAnchorA());
+		info.GetReturnValue().Set(out);
 	}
-	NANX_METHOD(GetTarget)
+	NANX_METHOD(GetLocalAnchorB)
 	{
-		WrapMouseJoint* wrap = Unwrap(info.This());
+		WrapPrismaticJoint* wrap = Unwrap(info.This());
 		v8::Local<v8::Object> out = info[0]->IsUndefined() ? WrapVec2::NewInstance() : v8::Local<v8::Object>::Cast(info[0]);
-		WrapVec2::Unwrap(out)->SetVec2(wrap->m_mouse_joint->GetTarget());
+		WrapVec2::Unwrap(out)->SetVec2(wrap->m_prismatic_joint->GetLocalAnchorB());
 		info.GetReturnValue().Set(out);
 	}
-	NANX_METHOD(SetMaxForce)
+	NANX_METHOD(GetLocalAxisA)
 	{
-		WrapMouseJoint* wrap = Unwrap(info.This());
-		wrap->m_mouse_joint->SetMaxForce(NANX_float32(info[0]));
+		WrapPrismaticJoint* wrap = Unwrap(info.This());
+		v8::Local<v8::Object> out = info[0]->IsUndefined() ? WrapVec2::NewInstance() : v8::Local<v8::Object>::Cast(info[0]);
+		WrapVec2::Unwrap(out)->SetVec2(wrap->m_prismatic_joint->GetLocalAxisA());
+		info.GetReturnValue().Set(out);
 	}
-	NANX_METHOD(GetMaxForce)
+	NANX_METHOD(GetReferenceAngle)
 	{
-		WrapMouseJoint* wrap = Unwrap(info.This());
-		info.GetReturnValue().Set(Nan::New(wrap->m_mouse_joint->GetMaxForce()));
+		WrapPrismaticJoint* wrap = Unwrap(info.This());
+		info.GetReturnValue().Set(Nan::New(wrap->m_prismatic_joint->GetReferenceAngle()));
 	}
-	NANX_METHOD(SetFrequency)
+	NANX_METHOD(GetJointTranslation)
 	{
-		WrapMouseJoint* wrap = Unwrap(info.This());
-		wrap->m_mouse_joint->SetFrequency(NANX_float32(info[0]));
+		WrapPrismaticJoint* wrap = Unwrap(info.This());
+		info.GetReturnValue().Set(Nan::New(wrap->m_prismatic_joint->GetJointTranslation()));
 	}
-	NANX_METHOD(GetFrequency)
+	NANX_METHOD(GetJointSpeed)
 	{
-		WrapMouseJoint* wrap = Unwrap(info.This());
-		info.GetReturnValue().Set(Nan::New(wrap->m_mouse_joint->GetFrequency()));
+		WrapPrismaticJoint* wrap = Unwrap(info.This());
+		info.GetReturnValue().Set(Nan::New(wrap->m_prismatic_joint->GetJointSpeed()));
 	}
-	NANX_METHOD(SetDampingRatio)
+	NANX_METHOD(IsLimitEnabled)
 	{
-		WrapMouseJoint* wrap = Unwrap(info.This());
-		wrap->m_mouse_joint->SetDampingRatio(NANX_float32(info[0]));
+		WrapPrismaticJoint* wrap = Unwrap(info.This());
+		info.GetReturnValue().Set(Nan::New(wrap->m_prismatic_joint->IsLimitEnabled()));
 	}
-	NANX_METHOD(GetDampingRatio)
+	NANX_METHOD(EnableLimit)
 	{
-		WrapMouseJoint* wrap = Unwrap(info.This());
-		info.GetReturnValue().Set(Nan::New(wrap->m_mouse_joint->GetDampingRatio()));
+		WrapPrismaticJoint* wrap = Unwrap(info.This());
+		bool flag = NANX_bool(info[0]);
+		Recorder* recorder = wrap->Recording();
+		if (recorder) { recorder->Op(e_recordEnableLimit).Int(recorder->GetJointId(wrap->m_prismatic_joint)).Bool(flag); }
+		wrap->m_prismatic_joint->EnableLimit(flag);
 	}
-///	void Dump();
-};
-
-//// b2GearJointDef
-
-class WrapGearJointDef : public WrapJointDef
-{
-private:
-	b2GearJointDef m_gear_jd;
-	Nan::Persistent<v8::Object> m_wrap_joint1; // m_gear_jd.joint1
-	Nan::Persistent<v8::Object> m_wrap_joint2; // m_gear_jd.joint2
-private:
-	WrapGearJointDef() {}
-	~WrapGearJointDef()
+	NANX_METHOD(GetLowerLimit)
 	{
-		m_wrap_joint1.Reset();
-		m_wrap_joint2.Reset();
+		WrapPrismaticJoint* wrap = Unwrap(info.This());
+		info.GetReturnValue().Set(Nan::New(wrap->m_prismatic_joint->GetLowerLimit()));
 	}
-public:
-	b2GearJointDef* Peek() { return & m_gear_jd; }
-	virtual b2JointDef& GetJointDef() { return m_gear_jd; } // override WrapJointDef
-	v8::Local<v8::Object> GetJoint1Handle() { return Nan::New<v8::Object>(m_wrap_joint1); }
-	v8::Local<v8::Object> GetJoint2Handle() { return Nan::New<v8::Object>(m_wrap_joint2); }
-	virtual void SyncPull() // override WrapJointDef
+	NANX_METHOD(GetUpperLimit)
 	{
-		// sync: pull data from javascript objects
-		WrapJointDef::SyncPull();
-		m_gear_jd.joint1 = WrapJoint::Unwrap(Nan::New<v8::Object>(m_wrap_joint1))->GetJoint();
-		m_gear_jd.joint2 = WrapJoint::Unwrap(Nan::New<v8::Object>(m_wrap_joint2))->GetJoint();
+		WrapPrismaticJoint* wrap = Unwrap(info.This());
+		info.GetReturnValue().Set(Nan::New(wrap->m_prismatic_joint->GetUpperLimit()));
 	}
-	virtual void SyncPush() // override WrapJointDef
+	NANX_METHOD(SetLimits)
 	{
-		// sync: push data into javascript objects
-		WrapJointDef::SyncPush();
-		m_wrap_joint1.Reset(WrapJoint::GetWrap(m_gear_jd.joint1)->handle());
-		m_wrap_joint2.Reset(WrapJoint::GetWrap(m_gear_jd.joint2)->handle());
+		WrapPrismaticJoint* wrap = Unwrap(info.This());
+		float32 lower = NANX_float32(info[0]);
+		float32 upper = NANX_float32(info[1]);
+		Recorder* recorder = wrap->Recording();
+		if (recorder) { recorder->Op(e_recordSetLimits).Int(recorder->GetJointId(wrap->m_prismatic_joint)).Float(lower).Float(upper); }
+		wrap->m_prismatic_joint->SetLimits(lower, upper);
 	}
-public:
-	static WrapGearJointDef* Unwrap(v8::Local<v8::Value> value) { return (value->IsObject())?(Unwrap(v8::Local<v8::Object>::Cast(value))):(NULL); }
-	static WrapGearJointDef* Unwrap(v8::Local<v8::Object> object) { return Nan::ObjectWrap::Unwrap<WrapGearJointDef>(object); }
-	static b2GearJointDef* Peek(v8::Local<v8::Value> value) { WrapGearJointDef* wrap = Unwrap(value); return (wrap)?(wrap->Peek()):(NULL); }
-public:
-	static NAN_MODULE_INIT(Init)
+	NANX_METHOD(IsMotorEnabled)
 	{
-		v8::Local<v8::Function> constructor = GetConstructor();
-		target->Set(constructor->GetName(), constructor);
+		WrapPrismaticJoint* wrap = Unwrap(info.This());
+		info.GetReturnValue().Set(Nan::New(wrap->m_prismatic_joint->IsMotorEnabled()));
 	}
-	static v8::Local<v8::Function> GetConstructor()
+	NANX_METHOD(EnableMotor)
 	{
-		Nan::EscapableHandleScope scope;
-		v8::Local<v8::FunctionTemplate> function_template = GetFunctionTemplate();
-		v8::Local<v8::Function> constructor = function_template->GetFunction();
-		return scope.Escape(constructor);
+		WrapPrismaticJoint* wrap = Unwrap(info.This());
+		bool flag = NANX_bool(info[0]);
+		Recorder* recorder = wrap->Recording();
+		if (recorder) { recorder->Op(e_recordEnableMotor).Int(recorder->GetJointId(wrap->m_prismatic_joint)).Bool(flag); }
+		wrap->m_prismatic_joint->EnableMotor(flag);
 	}
-	static v8::Local<v8::FunctionTemplate> GetFunctionTemplate()
+	NANX_METHOD(SetMotorSpeed)
 	{
-		Nan::EscapableHandleScope scope;
-		static Nan::Persistent<v8::FunctionTemplate> g_function_template;
-		if (g_function_template.IsEmpty())
-		{
-			v8::Local<v8::FunctionTemplate> function_template = Nan::New<v8::FunctionTemplate>(New);
-			g_function_template.Reset(function_template);
-			function_template->SetClassName(NANX_SYMBOL("b2GearJointDef"));
-			function_template->Inherit(WrapJointDef::GetFunctionTemplate());
-			function_template->InstanceTemplate()->SetInternalFieldCount(1);
-			v8::Local<v8::ObjectTemplate> prototype_template = function_template->PrototypeTemplate();
-			NANX_MEMBER_APPLY(prototype_template, joint1)
-			NANX_MEMBER_APPLY(prototype_template, joint2)
-			NANX_MEMBER_APPLY(prototype_template, ratio)
-		}
-		v8::Local<v8::FunctionTemplate> function_template = Nan::New<v8::FunctionTemplate>(g_function_template);
-		return scope.Escape(function_template);
+		WrapPrismaticJoint* wrap = Unwrap(info.This());
+		float32 speed = NANX_float32(info[0]);
+		Recorder* recorder = wrap->Recording();
+		if (recorder) { recorder->Op(e_recordSetMotorSpeed).Int(recorder->GetJointId(wrap->m_prismatic_joint)).Float(speed); }
+		wrap->m_prismatic_joint->SetMotorSpeed(speed);
 	}
-	static v8::Local<v8::Object> NewInstance()
+	NANX_METHOD(GetMotorSpeed)
 	{
-		Nan::EscapableHandleScope scope;
-		v8::Local<v8::Function> constructor = GetConstructor();
-		v8::Local<v8::Object> instance = constructor->NewInstance();
-		return scope.Escape(instance);
+		WrapPrismaticJoint* wrap = Unwrap(info.This());
+		info.GetReturnValue().Set(Nan::New(wrap->m_prismatic_joint->GetMotorSpeed()));
 	}
-private:
-	static NAN_METHOD(New)
+	NANX_METHOD(SetMaxMotorForce)
 	{
-		if (info.IsConstructCall())
-		{
-			WrapGearJointDef* wrap = new WrapGearJointDef();
-			wrap->Wrap(info.This());
-			info.GetReturnValue().Set(info.This());
-		}
-		else
-		{
-			v8::Local<v8::Function> constructor = GetConstructor();
-			info.GetReturnValue().Set(constructor->NewInstance());
-		}
+		WrapPrismaticJoint* wrap = Unwrap(info.This());
+		wrap->m_prismatic_joint->SetMaxMotorForce(NANX_float32(info[0]));
 	}
-	NANX_MEMBER_OBJECT(joint1) // m_wrap_joint1
-	NANX_MEMBER_OBJECT(joint2) // m_wrap_joint2
-	NANX_MEMBER_NUMBER(float32, ratio)
+	NANX_METHOD(GetMaxMotorForce)
+	{
+		WrapPrismaticJoint* wrap = Unwrap(info.This());
+		info.GetReturnValue().Set(Nan::New(wrap->m_prismatic_joint->GetMaxMotorForce()));
+	}
+	NANX_METHOD(GetMotorForce)
+	{
+		WrapPrismaticJoint* wrap = Unwrap(info.This());
+		info.GetReturnValue().Set(Nan::New(wrap->m_prismatic_joint->GetMotorForce(NANX_float32(info[0]))));
+	}
+	///void Dump();
 };
 
-//// b2GearJoint
+//// b2DistanceJointDef
 
-class WrapGearJoint : public WrapJoint
+class WrapDistanceJointDef : public WrapJointDef
 {
 private:
-	b2GearJoint* m_gear_joint;
-	Nan::Persistent<v8::Object> m_gear_joint_joint1;
-	Nan::Persistent<v8::Object> m_gear_joint_joint2;
+	b2DistanceJointDef m_distance_jd;
+	Nan::Persistent<v8::Object> m_wrap_localAnchorA; // m_distance_jd.localAnchorA
+	Nan::Persistent<v8::Object> m_wrap_localAnchorB; // m_distance_jd.localAnchorB
 private:
-	WrapGearJoint() : m_gear_joint(NULL) {}
-	~WrapGearJoint()
+	WrapDistanceJointDef()
 	{
-		m_gear_joint_joint1.Reset();
-		m_gear_joint_joint2.Reset();
+		m_wrap_localAnchorA.Reset(WrapVec2::NewInstance(m_distance_jd.localAnchorA));
+		m_wrap_localAnchorB.Reset(WrapVec2::NewInstance(m_distance_jd.localAnchorB));
+	}
+	~WrapDistanceJointDef()
+	{
+		m_wrap_localAnchorA.Reset();
+		m_wrap_localAnchorB.Reset();
 	}
 public:
-	b2GearJoint* Peek() { return m_gear_joint; }
-	virtual b2Joint* GetJoint() { return m_gear_joint; } // override WrapJoint
-	void SetupObject(v8::Local<v8::Object> h_world, WrapGearJointDef* wrap_gear_jd, b2GearJoint* gear_joint)
+	b2DistanceJointDef* Peek() { return &m_distance_jd; }
+	virtual b2JointDef& GetJointDef() { return m_distance_jd; } // override WrapJointDef
+	virtual void SyncPull() // override WrapJointDef
 	{
-		m_gear_joint = gear_joint;
-		m_gear_joint_joint1.Reset(WrapJoint::GetWrap(gear_joint->GetJoint1())->handle());
-		m_gear_joint_joint2.Reset(WrapJoint::GetWrap(gear_joint->GetJoint2())->handle());
-		WrapJoint::SetupObject(h_world, wrap_gear_jd);
+		// sync: pull data from javascript objects
+		WrapJointDef::SyncPull();
+		m_distance_jd.localAnchorA = WrapVec2::Unwrap(Nan::New<v8::Object>(m_wrap_localAnchorA))->GetVec2(); // struct copy
+		m_distance_jd.localAnchorB = WrapVec2::Unwrap(Nan::New<v8::Object>(m_wrap_localAnchorB))->GetVec2(); // struct copy
 	}
-	b2GearJoint* ResetObject()
+	virtual void SyncPush() // override WrapJointDef
 	{
-		WrapJoint::ResetObject();
-		m_gear_joint_joint1.Reset();
-		m_gear_joint_joint2.Reset();
-		b2GearJoint* gear_joint = m_gear_joint;
-		m_gear_joint = NULL;
-		return gear_joint;
+		// sync: push data into javascript objects
+		WrapJointDef::SyncPush();
+		WrapVec2::Unwrap(Nan::New<v8::Object>(m_wrap_localAnchorA))->SetVec2(m_distance_jd.localAnchorA);
+		WrapVec2::Unwrap(Nan::New<v8::Object>(m_wrap_localAnchorB))->SetVec2(m_distance_jd.localAnchorB);
 	}
 public:
-	static WrapGearJoint* Unwrap(v8::Local<v8::Value> value) { return (value->IsObject())?(Unwrap(v8::Local<v8::Object>::Cast(value))):(NULL); }
-	static WrapGearJoint* Unwrap(v8::Local<v8::Object> object) { return Nan::ObjectWrap::Unwrap<WrapGearJoint>(object); }
-	static b2GearJoint* Peek(v8::Local<v8::Value> value) { WrapGearJoint* wrap = Unwrap(value); return (wrap)?(wrap->Peek()):(NULL); }
+	static WrapDistanceJointDef* Unwrap(v8::Local<v8::Value> value) { return (value->IsObject())?(Unwrap(v8::Local<v8::Object>::Cast(value))):(NULL); }
+	static WrapDistanceJointDef* Unwrap(v8::Local<v8::Object> object) { return Nan::ObjectWrap::Unwrap<WrapDistanceJointDef>(object); }
+	static b2DistanceJointDef* Peek(v8::Local<v8::Value> value) { WrapDistanceJointDef* wrap = Unwrap(value); return (wrap)?(wrap->Peek()):(NULL); }
 public:
 	static NAN_MODULE_INIT(Init)
 	{
@@ -4253,127 +6307,74 @@ public:
 		if (g_function_template.IsEmpty())
 		{
 			v8::Local<v8::FunctionTemplate> function_template = Nan::New<v8::FunctionTemplate>(New);
-			g_function_template.Reset(function_template);
-			function_template->SetClassName(NANX_SYMBOL("b2GearJoint"));
-			function_template->Inherit(WrapJoint::GetFunctionTemplate());
+			function_template->Inherit(WrapJointDef::GetFunctionTemplate());
+			function_template->SetClassName(NANX_SYMBOL("b2DistanceJointDef"));
 			function_template->InstanceTemplate()->SetInternalFieldCount(1);
 			v8::Local<v8::ObjectTemplate> prototype_template = function_template->PrototypeTemplate();
-			NANX_METHOD_APPLY(prototype_template, GetJoint1)
-			NANX_METHOD_APPLY(prototype_template, GetJoint2)
-			NANX_METHOD_APPLY(prototype_template, SetRatio)
-			NANX_METHOD_APPLY(prototype_template, GetRatio)
+			NANX_MEMBER_APPLY(prototype_template, localAnchorA)
+			NANX_MEMBER_APPLY(prototype_template, localAnchorB)
+			NANX_MEMBER_APPLY(prototype_template, length)
+			NANX_MEMBER_APPLY(prototype_template, frequencyHz)
+			NANX_MEMBER_APPLY(prototype_template, dampingRatio)
+			NANX_METHOD_APPLY(prototype_template, Initialize)
+			g_function_template.Reset(function_template);
 		}
 		v8::Local<v8::FunctionTemplate> function_template = Nan::New<v8::FunctionTemplate>(g_function_template);
 		return scope.Escape(function_template);
 	}
-	static v8::Local<v8::Object> NewInstance()
-	{
-		Nan::EscapableHandleScope scope;
-		v8::Local<v8::Function> constructor = GetConstructor();
-		v8::Local<v8::Object> instance = constructor->NewInstance();
-		return scope.Escape(instance);
-	}
 private:
 	static NAN_METHOD(New)
 	{
-		if (info.IsConstructCall())
-		{
-			WrapGearJoint* wrap = new WrapGearJoint();
-			wrap->Wrap(info.This());
-			info.GetReturnValue().Set(info.This());
-		}
-		else
-		{
-			v8::Local<v8::Function> constructor = GetConstructor();
-			info.GetReturnValue().Set(constructor->NewInstance());
-		}
-	}
-///	b2Vec2 GetAnchorA() const;
-///	b2Vec2 GetAnchorB() const;
-///	b2Vec2 GetReactionForce(float32 inv_dt) const;
-///	float32 GetReactionTorque(float32 inv_dt) const;
-	NANX_METHOD(GetJoint1)
-	{
-		WrapGearJoint* wrap = Unwrap(info.This());
-		if (!wrap->m_gear_joint_joint1.IsEmpty())
-		{
-			info.GetReturnValue().Set(Nan::New<v8::Object>(wrap->m_gear_joint_joint1));
-		}
-		else
-		{
-			info.GetReturnValue().SetNull();
-		}
-	}
-	NANX_METHOD(GetJoint2)
-	{
-		WrapGearJoint* wrap = Unwrap(info.This());
-		if (!wrap->m_gear_joint_joint2.IsEmpty())
-		{
-			info.GetReturnValue().Set(Nan::New<v8::Object>(wrap->m_gear_joint_joint2));
-		}
-		else
-		{
-			info.GetReturnValue().SetNull();
-		}
-	}
-	NANX_METHOD(SetRatio)
-	{
-		WrapGearJoint* wrap = Unwrap(info.This());
-		wrap->m_gear_joint->SetRatio(NANX_float32(info[0]));
+		WrapDistanceJointDef* wrap = new WrapDistanceJointDef();
+		wrap->Wrap(info.This());
+		info.GetReturnValue().Set(info.This());
 	}
-	NANX_METHOD(GetRatio)
+	NANX_MEMBER_OBJECT(localAnchorA) // m_wrap_localAnchorA
+	NANX_MEMBER_OBJECT(localAnchorB) // m_wrap_localAnchorB
+	NANX_MEMBER_NUMBER(float32, length)
+	NANX_MEMBER_NUMBER(float32, frequencyHz)
+	NANX_MEMBER_NUMBER(float32, dampingRatio)
+	NANX_METHOD(Initialize)
 	{
-		WrapGearJoint* wrap = Unwrap(info.This());
-		info.GetReturnValue().Set(Nan::New(wrap->m_gear_joint->GetRatio()));
+		WrapDistanceJointDef* wrap = Unwrap(info.This());
+		WrapBody* wrap_bodyA = WrapBody::Unwrap(v8::Local<v8::Object>::Cast(info[0]));
+		WrapBody* wrap_bodyB = WrapBody::Unwrap(v8::Local<v8::Object>::Cast(info[1]));
+		WrapVec2* wrap_anchorA = WrapVec2::Unwrap(v8::Local<v8::Object>::Cast(info[2]));
+		WrapVec2* wrap_anchorB = WrapVec2::Unwrap(v8::Local<v8::Object>::Cast(info[3]));
+		wrap->SyncPull();
+		wrap->m_distance_jd.Initialize(wrap_bodyA->Peek(), wrap_bodyB->Peek(), wrap_anchorA->GetVec2(), wrap_anchorB->GetVec2());
+		wrap->SyncPush();
 	}
-///	void Dump();
 };
 
-//// b2WheelJointDef
+//// b2DistanceJoint
 
-class WrapWheelJointDef : public WrapJointDef
+class WrapDistanceJoint : public WrapJoint
 {
 private:
-	b2WheelJointDef m_wheel_jd;
-	Nan::Persistent<v8::Object> m_wrap_localAnchorA; // m_wheel_jd.localAnchorA
-	Nan::Persistent<v8::Object> m_wrap_localAnchorB; // m_wheel_jd.localAnchorB
-	Nan::Persistent<v8::Object> m_wrap_localAxisA; // m_wheel_jd.localAxisA
+	b2DistanceJoint* m_distance_joint;
 private:
-	WrapWheelJointDef()
-	{
-		m_wrap_localAnchorA.Reset(WrapVec2::NewInstance(m_wheel_jd.localAnchorA));
-		m_wrap_localAnchorB.Reset(WrapVec2::NewInstance(m_wheel_jd.localAnchorB));
-		m_wrap_localAxisA.Reset(WrapVec2::NewInstance(m_wheel_jd.localAxisA));
-	}
-	~WrapWheelJointDef()
-	{
-		m_wrap_localAnchorA.Reset();
-		m_wrap_localAnchorB.Reset();
-		m_wrap_localAxisA.Reset();
-	}
+	WrapDistanceJoint() : m_distance_joint(NULL) {}
+	~WrapDistanceJoint() {}
 public:
-	b2WheelJointDef* Peek() { return &m_wheel_jd; }
-	virtual b2JointDef& GetJointDef() { return m_wheel_jd; } // override WrapJointDef
-	virtual void SyncPull() // override WrapJointDef
+	b2DistanceJoint* Peek() { return m_distance_joint; }
+	virtual b2Joint* GetJoint() { return m_distance_joint; } // override WrapJoint
+	void SetupObject(v8::Local<v8::Object> h_world, WrapDistanceJointDef* wrap_distance_jd, b2DistanceJoint* distance_joint)
 	{
-		// sync: pull data from javascript objects
-		WrapJointDef::SyncPull();
-		m_wheel_jd.localAnchorA = WrapVec2::Unwrap(Nan::New<v8::Object>(m_wrap_localAnchorA))->GetVec2(); // struct copy
-		m_wheel_jd.localAnchorB = WrapVec2::Unwrap(Nan::New<v8::Object>(m_wrap_localAnchorB))->GetVec2(); // struct copy
-		m_wheel_jd.localAxisA = WrapVec2::Unwrap(Nan::New<v8::Object>(m_wrap_localAxisA))->GetVec2(); // struct copy
+		m_distance_joint = distance_joint;
+		WrapJoint::SetupObject(h_world, wrap_distance_jd);
 	}
-	virtual void SyncPush() // override WrapJointDef
+	b2DistanceJoint* ResetObject()
 	{
-		// sync: push data into javascript objects
-		WrapJointDef::SyncPush();
-		WrapVec2::Unwrap(Nan::New<v8::Object>(m_wrap_localAnchorA))->SetVec2(m_wheel_jd.localAnchorA);
-		WrapVec2::Unwrap(Nan::New<v8::Object>(m_wrap_localAnchorB))->SetVec2(m_wheel_jd.localAnchorB);
-		WrapVec2::Unwrap(Nan::New<v8::Object>(m_wrap_localAxisA))->SetVec2(m_wheel_jd.localAxisA);
+		WrapJoint::ResetObject();
+		b2DistanceJoint* distance_joint = m_distance_joint;
+		m_distance_joint = NULL;
+		return distance_joint;
 	}
 public:
-	static WrapWheelJointDef* Unwrap(v8::Local<v8::Value> value) { return (value->IsObject())?(Unwrap(v8::Local<v8::Object>::Cast(value))):(NULL); }
-	static WrapWheelJointDef* Unwrap(v8::Local<v8::Object> object) { return Nan::ObjectWrap::Unwrap<WrapWheelJointDef>(object); }
-	static b2WheelJointDef* Peek(v8::Local<v8::Value> value) { WrapWheelJointDef* wrap = Unwrap(value); return (wrap)?(wrap->Peek()):(NULL); }
+	static WrapDistanceJoint* Unwrap(v8::Local<v8::Value> value) { return (value->IsObject())?(Unwrap(v8::Local<v8::Object>::Cast(value))):(NULL); }
+	static WrapDistanceJoint* Unwrap(v8::Local<v8::Object> object) { return Nan::ObjectWrap::Unwrap<WrapDistanceJoint>(object); }
+	static b2DistanceJoint* Peek(v8::Local<v8::Value> value) { WrapDistanceJoint* wrap = Unwrap(value); return (wrap)?(wrap->Peek()):(NULL); }
 public:
 	static NAN_MODULE_INIT(Init)
 	{
@@ -4395,135 +6396,18 @@ public:
 		{
 			v8::Local<v8::FunctionTemplate> function_template = Nan::New<v8::FunctionTemplate>(New);
 			g_function_template.Reset(function_template);
-			function_template->SetClassName(NANX_SYMBOL("b2WheelJointDef"));
-			function_template->Inherit(WrapJointDef::GetFunctionTemplate());
-			function_template->InstanceTemplate()->SetInternalFieldCount(1);
-			v8::Local<v8::ObjectTemplate> prototype_template = function_template->PrototypeTemplate();
-			NANX_MEMBER_APPLY(prototype_template, localAnchorA)
-			NANX_MEMBER_APPLY(prototype_template, localAnchorB)
-			NANX_MEMBER_APPLY(prototype_template, localAxisA)
-			NANX_MEMBER_APPLY(prototype_template, enableMotor)
-			NANX_MEMBER_APPLY(prototype_template, maxMotorTorque)
-			NANX_MEMBER_APPLY(prototype_template, motorSpeed)
-			NANX_MEMBER_APPLY(prototype_template, frequencyHz)
-			NANX_MEMBER_APPLY(prototype_template, dampingRatio)
-			NANX_METHOD_APPLY(prototype_template, Initialize)
-		}
-		v8::Local<v8::FunctionTemplate> function_template = Nan::New<v8::FunctionTemplate>(g_function_template);
-		return scope.Escape(function_template);
-	}
-	static v8::Local<v8::Object> NewInstance()
-	{
-		Nan::EscapableHandleScope scope;
-		v8::Local<v8::Function> constructor = GetConstructor();
-		v8::Local<v8::Object> instance = constructor->NewInstance();
-		return scope.Escape(instance);
-	}
-private:
-	static NAN_METHOD(New)
-	{
-		if (info.IsConstructCall())
-		{
-			WrapWheelJointDef* wrap = new WrapWheelJointDef();
-			wrap->Wrap(info.This());
-			info.GetReturnValue().Set(info.This());
-		}
-		else
-		{
-			v8::Local<v8::Function> constructor = GetConstructor();
-			info.GetReturnValue().Set(constructor->NewInstance());
-		}
-	}
-	NANX_MEMBER_OBJECT(localAnchorA) // m_wrap_localAnchorA
-	NANX_MEMBER_OBJECT(localAnchorB) // m_wrap_localAnchorB
-	NANX_MEMBER_OBJECT(localAxisA) // m_wrap_localAxisA
-	NANX_MEMBER_BOOLEAN(bool, enableMotor)
-	NANX_MEMBER_NUMBER(float32, maxMotorTorque)
-	NANX_MEMBER_NUMBER(float32, motorSpeed)
-	NANX_MEMBER_NUMBER(float32, frequencyHz)
-	NANX_MEMBER_NUMBER(float32, dampingRatio)
-	NANX_METHOD(Initialize)
-	{
-		WrapWheelJointDef* wrap = Unwrap(info.This());
-		WrapBody* wrap_bodyA = WrapBody::Unwrap(v8::Local<v8::Object>::Cast(info[0]));
-		WrapBody* wrap_bodyB = WrapBody::Unwrap(v8::Local<v8::Object>::Cast(info[1]));
-		WrapVec2* wrap_anchor = WrapVec2::Unwrap(v8::Local<v8::Object>::Cast(info[2]));
-		WrapVec2* wrap_axis = WrapVec2::Unwrap(v8::Local<v8::Object>::Cast(info[3]));
-		wrap->SyncPull();
-		wrap->m_wheel_jd.Initialize(wrap_bodyA->Peek(), wrap_bodyB->Peek(), wrap_anchor->GetVec2(), wrap_axis->GetVec2());
-		wrap->SyncPush();
-	}
-};
-
-//// b2WheelJoint
-
-class WrapWheelJoint : public WrapJoint
-{
-private:
-	b2WheelJoint* m_wheel_joint;
-private:
-	WrapWheelJoint() : m_wheel_joint(NULL) {}
-	~WrapWheelJoint() {}
-public:
-	b2WheelJoint* Peek() { return m_wheel_joint; }
-	virtual b2Joint* GetJoint() { return m_wheel_joint; } // override WrapJoint
-	void SetupObject(v8::Local<v8::Object> h_world, WrapWheelJointDef* wrap_wheel_jd, b2WheelJoint* wheel_joint)
-	{
-		m_wheel_joint = wheel_joint;
-		WrapJoint::SetupObject(h_world, wrap_wheel_jd);
-	}
-	b2WheelJoint* ResetObject()
-	{
-		WrapJoint::ResetObject();
-		b2WheelJoint* wheel_joint = m_wheel_joint;
-		m_wheel_joint = NULL;
-		return wheel_joint;
-	}
-public:
-	static WrapWheelJoint* Unwrap(v8::Local<v8::Value> value) { return (value->IsObject())?(Unwrap(v8::Local<v8::Object>::Cast(value))):(NULL); }
-	static WrapWheelJoint* Unwrap(v8::Local<v8::Object> object) { return Nan::ObjectWrap::Unwrap<WrapWheelJoint>(object); }
-	static b2WheelJoint* Peek(v8::Local<v8::Value> value) { WrapWheelJoint* wrap = Unwrap(value); return (wrap)?(wrap->Peek()):(NULL); }
-public:
-	static NAN_MODULE_INIT(Init)
-	{
-		v8::Local<v8::Function> constructor = GetConstructor();
-		target->Set(constructor->GetName(), constructor);
-	}
-	static v8::Local<v8::Function> GetConstructor()
-	{
-		Nan::EscapableHandleScope scope;
-		v8::Local<v8::FunctionTemplate> function_template = GetFunctionTemplate();
-		v8::Local<v8::Function> constructor = function_template->GetFunction();
-		return scope.Escape(constructor);
-	}
-	static v8::Local<v8::FunctionTemplate> GetFunctionTemplate()
-	{
-		Nan::EscapableHandleScope scope;
-		static Nan::Persistent<v8::FunctionTemplate> g_function_template;
-		if (g_function_template.IsEmpty())
-		{
-			v8::Local<v8::FunctionTemplate> function_template = Nan::New<v8::FunctionTemplate>(New);
-			g_function_template.Reset(function_template);
-			function_template->SetClassName(NANX_SYMBOL("b2WheelJoint"));
-			function_template->Inherit(WrapJoint::GetFunctionTemplate());
+			function_template->SetClassName(NANX_SYMBOL("b2DistanceJoint"));
+			function_template->Inherit(WrapJoint::GetFunctionTemplate());
 			function_template->InstanceTemplate()->SetInternalFieldCount(1);
 			v8::Local<v8::ObjectTemplate> prototype_template = function_template->PrototypeTemplate();
 			NANX_METHOD_APPLY(prototype_template, GetLocalAnchorA)
 			NANX_METHOD_APPLY(prototype_template, GetLocalAnchorB)
-			NANX_METHOD_APPLY(prototype_template, GetLocalAxisA)
-			NANX_METHOD_APPLY(prototype_template, GetJointTranslation)
-			NANX_METHOD_APPLY(prototype_template, GetJointSpeed)
-			NANX_METHOD_APPLY(prototype_template, IsMotorEnabled)
-			NANX_METHOD_APPLY(prototype_template, EnableMotor)
-			NANX_METHOD_APPLY(prototype_template, SetMotorSpeed)
-			NANX_METHOD_APPLY(prototype_template, GetMotorSpeed)
-			NANX_METHOD_APPLY(prototype_template, SetMaxMotorTorque)
-			NANX_METHOD_APPLY(prototype_template, GetMaxMotorTorque)
-			NANX_METHOD_APPLY(prototype_template, GetMotorTorque)
-			NANX_METHOD_APPLY(prototype_template, SetSpringFrequencyHz)
-			NANX_METHOD_APPLY(prototype_template, GetSpringFrequencyHz)
-			NANX_METHOD_APPLY(prototype_template, SetSpringDampingRatio)
-			NANX_METHOD_APPLY(prototype_template, GetSpringDampingRatio)
+			NANX_METHOD_APPLY(prototype_template, SetLength)
+			NANX_METHOD_APPLY(prototype_template, GetLength)
+			NANX_METHOD_APPLY(prototype_template, SetFrequency)
+			NANX_METHOD_APPLY(prototype_template, GetFrequency)
+			NANX_METHOD_APPLY(prototype_template, SetDampingRatio)
+			NANX_METHOD_APPLY(prototype_template, GetDampingRatio)
 		}
 		v8::Local<v8::FunctionTemplate> function_template = Nan::New<v8::FunctionTemplate>(g_function_template);
 		return scope.Escape(function_template);
@@ -4540,7 +6424,7 @@ private:
 	{
 		if (info.IsConstructCall())
 		{
-			WrapWheelJoint* wrap = new WrapWheelJoint();
+			WrapDistanceJoint* wrap = new WrapDistanceJoint();
 			wrap->Wrap(info.This());
 			info.GetReturnValue().Set(info.This());
 		}
@@ -4556,133 +6440,99 @@ private:
 ///	float32 GetReactionTorque(float32 inv_dt) const;
 	NANX_METHOD(GetLocalAnchorA)
 	{
-		WrapWheelJoint* wrap = Unwrap(info.This());
+		WrapDistanceJoint* wrap = Unwrap(info.This());
 		v8::Local<v8::Object> out = info[0]->IsUndefined() ? WrapVec2::NewInstance() : v8::Local<v8::Object>::Cast(info[0]);
-		WrapVec2::Unwrap(out)->SetVec2(wrap->m_wheel_joint->GetLocalAnchorA());
+		WrapVec2::Unwrap(out)->SetVec2(wrap->m_distance_joint->GetLocalAnchorA());
 		info.GetReturnValue().Set(out);
 	}
 	NANX_METHOD(GetLocalAnchorB)
 	{
-		WrapWheelJoint* wrap = Unwrap(info.This());
-		v8::Local<v8::Object> out = info[0]->IsUndefined() ? WrapVec2::NewInstance() : v8::Local<v8::Object>::Cast(info[0]);
-		WrapVec2::Unwrap(out)->SetVec2(wrap->m_wheel_joint->GetLocalAnchorB());
-		info.GetReturnValue().Set(out);
-	}
-	NANX_METHOD(GetLocalAxisA)
-	{
-		WrapWheelJoint* wrap = Unwrap(info.This());
+		WrapDistanceJoint* wrap = Unwrap(info.This());
 		v8::Local<v8::Object> out = info[0]->IsUndefined() ? WrapVec2::NewInstance() : v8::Local<v8::Object>::Cast(info[0]);
-		WrapVec2::Unwrap(out)->SetVec2(wrap->m_wheel_joint->GetLocalAxisA());
+		WrapVec2::Unwrap(out)->SetVec2(wrap->m_distance_joint->GetLocalAnchorB());
 		info.GetReturnValue().Set(out);
 	}
-	NANX_METHOD(GetJointTranslation)
-	{
-		WrapWheelJoint* wrap = Unwrap(info.This());
-		info.GetReturnValue().Set(Nan::New(wrap->m_wheel_joint->GetJointTranslation()));
-	}
-	NANX_METHOD(GetJointSpeed)
-	{
-		WrapWheelJoint* wrap = Unwrap(info.This());
-		info.GetReturnValue().Set(Nan::New(wrap->m_wheel_joint->GetJointSpeed()));
-	}
-	NANX_METHOD(IsMotorEnabled)
-	{
-		WrapWheelJoint* wrap = Unwrap(info.This());
-		info.GetReturnValue().Set(Nan::New(wrap->m_wheel_joint->IsMotorEnabled()));
-	}
-	NANX_METHOD(EnableMotor)
-	{
-		WrapWheelJoint* wrap = Unwrap(info.This());
-		wrap->m_wheel_joint->EnableMotor(NANX_bool(info[0]));
-	}
-	NANX_METHOD(SetMotorSpeed)
-	{
-		WrapWheelJoint* wrap = Unwrap(info.This());
-		wrap->m_wheel_joint->SetMotorSpeed(NANX_float32(info[0]));
-	}
-	NANX_METHOD(GetMotorSpeed)
-	{
-		WrapWheelJoint* wrap = Unwrap(info.This());
-		info.GetReturnValue().Set(Nan::New(wrap->m_wheel_joint->GetMotorSpeed()));
-	}
-	NANX_METHOD(SetMaxMotorTorque)
-	{
-		WrapWheelJoint* wrap = Unwrap(info.This());
-		wrap->m_wheel_joint->SetMaxMotorTorque(NANX_float32(info[0]));
-	}
-	NANX_METHOD(GetMaxMotorTorque)
+	NANX_METHOD(SetLength)
 	{
-		WrapWheelJoint* wrap = Unwrap(info.This());
-		info.GetReturnValue().Set(Nan::New(wrap->m_wheel_joint->GetMaxMotorTorque()));
+		WrapDistanceJoint* wrap = Unwrap(info.This());
+		wrap->m_distance_joint->SetLength(NANX_float32(info[0]));
 	}
-	NANX_METHOD(GetMotorTorque)
+	NANX_METHOD(GetLength)
 	{
-		WrapWheelJoint* wrap = Unwrap(info.This());
-		info.GetReturnValue().Set(Nan::New(wrap->m_wheel_joint->GetMotorTorque(NANX_float32(info[0]))));
+		WrapDistanceJoint* wrap = Unwrap(info.This());
+		info.GetReturnValue().Set(Nan::New(wrap->m_distance_joint->GetLength()));
 	}
-	NANX_METHOD(SetSpringFrequencyHz)
+	NANX_METHOD(SetFrequency)
 	{
-		WrapWheelJoint* wrap = Unwrap(info.This());
-		wrap->m_wheel_joint->SetSpringFrequencyHz(NANX_float32(info[0]));
+		WrapDistanceJoint* wrap = Unwrap(info.This());
+		wrap->m_distance_joint->SetFrequency(NANX_float32(info[0]));
 	}
-	NANX_METHOD(GetSpringFrequencyHz)
+	NANX_METHOD(GetFrequency)
 	{
-		WrapWheelJoint* wrap = Unwrap(info.This());
-		info.GetReturnValue().Set(Nan::New(wrap->m_wheel_joint->GetSpringFrequencyHz()));
+		WrapDistanceJoint* wrap = Unwrap(info.This());
+		info.GetReturnValue().Set(Nan::New(wrap->m_distance_joint->GetFrequency()));
 	}
-	NANX_METHOD(SetSpringDampingRatio)
+	NANX_METHOD(SetDampingRatio)
 	{
-		WrapWheelJoint* wrap = Unwrap(info.This());
-		wrap->m_wheel_joint->SetSpringDampingRatio(NANX_float32(info[0]));
+		WrapDistanceJoint* wrap = Unwrap(info.This());
+		wrap->m_distance_joint->SetDampingRatio(NANX_float32(info[0]));
 	}
-	NANX_METHOD(GetSpringDampingRatio)
+	NANX_METHOD(GetDampingRatio)
 	{
-		WrapWheelJoint* wrap = Unwrap(info.This());
-		info.GetReturnValue().Set(Nan::New(wrap->m_wheel_joint->GetSpringDampingRatio()));
+		WrapDistanceJoint* wrap = Unwrap(info.This());
+		info.GetReturnValue().Set(Nan::New(wrap->m_distance_joint->GetDampingRatio()));
 	}
 ///	void Dump();
 };
 
-//// b2WeldJointDef
+//// b2PulleyJointDef
 
-class WrapWeldJointDef : public WrapJointDef
+class WrapPulleyJointDef : public WrapJointDef
 {
 private:
-	b2WeldJointDef m_weld_jd;
-	Nan::Persistent<v8::Object> m_wrap_localAnchorA; // m_weld_jd.localAnchorA
-	Nan::Persistent<v8::Object> m_wrap_localAnchorB; // m_weld_jd.localAnchorB
+	b2PulleyJointDef m_pulley_jd;
+	Nan::Persistent<v8::Object> m_wrap_groundAnchorA; // m_pulley_jd.groundAnchorA
+	Nan::Persistent<v8::Object> m_wrap_groundAnchorB; // m_pulley_jd.groundAnchorB
+	Nan::Persistent<v8::Object> m_wrap_localAnchorA; // m_pulley_jd.localAnchorA
+	Nan::Persistent<v8::Object> m_wrap_localAnchorB; // m_pulley_jd.localAnchorB
 private:
-	WrapWeldJointDef()
+	WrapPulleyJointDef()
 	{
-		m_wrap_localAnchorA.Reset(WrapVec2::NewInstance(m_weld_jd.localAnchorA));
-		m_wrap_localAnchorB.Reset(WrapVec2::NewInstance(m_weld_jd.localAnchorB));
+		m_wrap_groundAnchorA.Reset(WrapVec2::NewInstance(m_pulley_jd.groundAnchorA));
+		m_wrap_groundAnchorB.Reset(WrapVec2::NewInstance(m_pulley_jd.groundAnchorB));
+		m_wrap_localAnchorA.Reset(WrapVec2::NewInstance(m_pulley_jd.localAnchorA));
+		m_wrap_localAnchorB.Reset(WrapVec2::NewInstance(m_pulley_jd.localAnchorB));
 	}
-	~WrapWeldJointDef()
+	~WrapPulleyJointDef()
 	{
 		m_wrap_localAnchorA.Reset();
 		m_wrap_localAnchorB.Reset();
 	}
 public:
-	b2WeldJointDef* Peek() { return &m_weld_jd; }
-	virtual b2JointDef& GetJointDef() { return m_weld_jd; } // override WrapJointDef
+	b2PulleyJointDef* Peek() { return &m_pulley_jd; }
+	virtual b2JointDef& GetJointDef() { return m_pulley_jd; } // override WrapJointDef
 	virtual void SyncPull() // override WrapJointDef
 	{
 		// sync: pull data from javascript objects
 		WrapJointDef::SyncPull();
-		m_weld_jd.localAnchorA = WrapVec2::Unwrap(Nan::New<v8::Object>(m_wrap_localAnchorA))->GetVec2(); // struct copy
-		m_weld_jd.localAnchorB = WrapVec2::Unwrap(Nan::New<v8::Object>(m_wrap_localAnchorB))->GetVec2(); // struct copy
+		m_pulley_jd.groundAnchorA = WrapVec2::Unwrap(Nan::New<v8::Object>(m_wrap_groundAnchorA))->GetVec2(); // struct copy
+		m_pulley_jd.groundAnchorB = WrapVec2::Unwrap(Nan::New<v8::Object>(m_wrap_groundAnchorB))->GetVec2(); // struct copy
+		m_pulley_jd.localAnchorA = WrapVec2::Unwrap(Nan::New<v8::Object>(m_wrap_localAnchorA))->GetVec2(); // struct copy
+		m_pulley_jd.localAnchorB = WrapVec2::Unwrap(Nan::New<v8::Object>(m_wrap_localAnchorB))->GetVec2(); // struct copy
 	}
 	virtual void SyncPush() // override WrapJointDef
 	{
 		// sync: push data into javascript objects
 		WrapJointDef::SyncPush();
-		WrapVec2::Unwrap(Nan::New<v8::Object>(m_wrap_localAnchorA))->SetVec2(m_weld_jd.localAnchorA);
-		WrapVec2::Unwrap(Nan::New<v8::Object>(m_wrap_localAnchorB))->SetVec2(m_weld_jd.localAnchorB);
+		WrapVec2::Unwrap(Nan::New<v8::Object>(m_wrap_groundAnchorA))->SetVec2(m_pulley_jd.groundAnchorA);
+		WrapVec2::Unwrap(Nan::New<v8::Object>(m_wrap_groundAnchorB))->SetVec2(m_pulley_jd.groundAnchorB);
+		WrapVec2::Unwrap(Nan::New<v8::Object>(m_wrap_localAnchorA))->SetVec2(m_pulley_jd.localAnchorA);
+		WrapVec2::Unwrap(Nan::New<v8::Object>(m_wrap_localAnchorB))->SetVec2(m_pulley_jd.localAnchorB);
 	}
 public:
-	static WrapWeldJointDef* Unwrap(v8::Local<v8::Value> value) { return (value->IsObject())?(Unwrap(v8::Local<v8::Object>::Cast(value))):(NULL); }
-	static WrapWeldJointDef* Unwrap(v8::Local<v8::Object> object) { return Nan::ObjectWrap::Unwrap<WrapWeldJointDef>(object); }
-	static b2WeldJointDef* Peek(v8::Local<v8::Value> value) { WrapWeldJointDef* wrap = Unwrap(value); return (wrap)?(wrap->Peek()):(NULL); }
+	static WrapPulleyJointDef* Unwrap(v8::Local<v8::Value> value) { return (value->IsObject())?(Unwrap(v8::Local<v8::Object>::Cast(value))):(NULL); }
+	static WrapPulleyJointDef* Unwrap(v8::Local<v8::Object> object) { return Nan::ObjectWrap::Unwrap<WrapPulleyJointDef>(object); }
+	static b2PulleyJointDef* Peek(v8::Local<v8::Value> value) { WrapPulleyJointDef* wrap = Unwrap(value); return (wrap)?(wrap->Peek()):(NULL); }
 public:
 	static NAN_MODULE_INIT(Init)
 	{
@@ -4704,15 +6554,17 @@ public:
 		{
 			v8::Local<v8::FunctionTemplate> function_template = Nan::New<v8::FunctionTemplate>(New);
 			g_function_template.Reset(function_template);
-			function_template->SetClassName(NANX_SYMBOL("b2WeldJointDef"));
+			function_template->SetClassName(NANX_SYMBOL("b2PulleyJointDef"));
 			function_template->Inherit(WrapJointDef::GetFunctionTemplate());
 			function_template->InstanceTemplate()->SetInternalFieldCount(1);
 			v8::Local<v8::ObjectTemplate> prototype_template = function_template->PrototypeTemplate();
+			NANX_MEMBER_APPLY(prototype_template, groundAnchorA)
+			NANX_MEMBER_APPLY(prototype_template, groundAnchorB)
 			NANX_MEMBER_APPLY(prototype_template, localAnchorA)
 			NANX_MEMBER_APPLY(prototype_template, localAnchorB)
-			NANX_MEMBER_APPLY(prototype_template, referenceAngle)
-			NANX_MEMBER_APPLY(prototype_template, frequencyHz)
-			NANX_MEMBER_APPLY(prototype_template, dampingRatio)
+			NANX_MEMBER_APPLY(prototype_template, lengthA)
+			NANX_MEMBER_APPLY(prototype_template, lengthB)
+			NANX_MEMBER_APPLY(prototype_template, ratio)
 			NANX_METHOD_APPLY(prototype_template, Initialize)
 		}
 		v8::Local<v8::FunctionTemplate> function_template = Nan::New<v8::FunctionTemplate>(g_function_template);
@@ -4730,7 +6582,7 @@ private:
 	{
 		if (info.IsConstructCall())
 		{
-			WrapWeldJointDef* wrap = new WrapWeldJointDef();
+			WrapPulleyJointDef* wrap = new WrapPulleyJointDef();
 			wrap->Wrap(info.This());
 			info.GetReturnValue().Set(info.This());
 		}
@@ -4740,51 +6592,61 @@ private:
 			info.GetReturnValue().Set(constructor->NewInstance());
 		}
 	}
+	NANX_MEMBER_OBJECT(groundAnchorA) // m_wrap_groundAnchorA
+	NANX_MEMBER_OBJECT(groundAnchorB) // m_wrap_groundAnchorB
 	NANX_MEMBER_OBJECT(localAnchorA) // m_wrap_localAnchorA
 	NANX_MEMBER_OBJECT(localAnchorB) // m_wrap_localAnchorB
-	NANX_MEMBER_NUMBER(float32, referenceAngle)
-	NANX_MEMBER_NUMBER(float32, frequencyHz)
-	NANX_MEMBER_NUMBER(float32, dampingRatio)
+	NANX_MEMBER_NUMBER(float32, lengthA)
+	NANX_MEMBER_NUMBER(float32, lengthB)
+	NANX_MEMBER_NUMBER(float32, ratio)
 	NANX_METHOD(Initialize)
 	{
-		WrapWeldJointDef* wrap = Unwrap(info.This());
+		WrapPulleyJointDef* wrap = Unwrap(info.This());
 		WrapBody* wrap_bodyA = WrapBody::Unwrap(v8::Local<v8::Object>::Cast(info[0]));
 		WrapBody* wrap_bodyB = WrapBody::Unwrap(v8::Local<v8::Object>::Cast(info[1]));
-		WrapVec2* wrap_anchor = WrapVec2::Unwrap(v8::Local<v8::Object>::Cast(info[2]));
+		WrapVec2* wrap_groundAnchorA = WrapVec2::Unwrap(v8::Local<v8::Object>::Cast(info[2]));
+		WrapVec2* wrap_groundAnchorB = WrapVec2::Unwrap(v8::Local<v8::Object>::Cast(info[3]));
+		WrapVec2* wrap_anchorA = WrapVec2::Unwrap(v8::Local<v8::Object>::Cast(info[4]));
+		WrapVec2* wrap_anchorB = WrapVec2::Unwrap(v8::Local<v8::Object>::Cast(info[5]));
+		float32 ratio = NANX_float32(info[6]);
 		wrap->SyncPull();
-		wrap->m_weld_jd.Initialize(wrap_bodyA->Peek(), wrap_bodyB->Peek(), wrap_anchor->GetVec2());
+		wrap->m_pulley_jd.Initialize(
+		   wrap_bodyA->Peek(), wrap_bodyB->Peek(),
+		   wrap_groundAnchorA->GetVec2(), wrap_groundAnchorB->GetVec2(),
+		   wrap_anchorA->GetVec2(), wrap_anchorB->GetVec2(),
+		   ratio);
 		wrap->SyncPush();
 	}
 };
 
-//// b2WeldJoint
+//// b2PulleyJoint
 
-class WrapWeldJoint : public WrapJoint
+class WrapPulleyJoint : public WrapJoint
 {
 private:
-	b2WeldJoint* m_weld_joint;
+	b2PulleyJoint* m_pulley_joint;
 private:
-	WrapWeldJoint() : m_weld_joint(NULL) {}
-	~WrapWeldJoint() {}
+	WrapPulleyJoint() : m_pulley_joint(NULL) {}
+	~WrapPulleyJoint() {}
 public:
-	b2WeldJoint* Peek() { return m_weld_joint; }
-	virtual b2Joint* GetJoint() { return m_weld_joint; } // override WrapJoint
-	void SetupObject(v8::Local<v8::Object> h_world, WrapWeldJointDef* wrap_weld_jd, b2WeldJoint* weld_joint)
+	b2PulleyJoint* Peek() { return m_pulley_joint; }
+	virtual b2Joint* GetJoint() { return m_pulley_joint; } // override WrapJoint
+	void SetupObject(v8::Local<v8::Object> h_world, WrapPulleyJointDef* wrap_pulley_jd, b2PulleyJoint* pulley_joint)
 	{
-		m_weld_joint = weld_joint;
-		WrapJoint::SetupObject(h_world, wrap_weld_jd);
+		m_pulley_joint = pulley_joint;
+		WrapJoint::SetupObject(h_world, wrap_pulley_jd);
 	}
-	b2WeldJoint* ResetObject()
+	b2PulleyJoint* ResetObject()
 	{
 		WrapJoint::ResetObject();
-		b2WeldJoint* weld_joint = m_weld_joint;
-		m_weld_joint = NULL;
-		return weld_joint;
+		b2PulleyJoint* pulley_joint = m_pulley_joint;
+		m_pulley_joint = NULL;
+		return pulley_joint;
 	}
 public:
-	static WrapWeldJoint* Unwrap(v8::Local<v8::Value> value) { return (value->IsObject())?(Unwrap(v8::Local<v8::Object>::Cast(value))):(NULL); }
-	static WrapWeldJoint* Unwrap(v8::Local<v8::Object> object) { return Nan::ObjectWrap::Unwrap<WrapWeldJoint>(object); }
-	static b2WeldJoint* Peek(v8::Local<v8::Value> value) { WrapWeldJoint* wrap = Unwrap(value); return (wrap)?(wrap->Peek()):(NULL); }
+	static WrapPulleyJoint* Unwrap(v8::Local<v8::Value> value) { return (value->IsObject())?(Unwrap(v8::Local<v8::Object>::Cast(value))):(NULL); }
+	static WrapPulleyJoint* Unwrap(v8::Local<v8::Object> object) { return Nan::ObjectWrap::Unwrap<WrapPulleyJoint>(object); }
+	static b2PulleyJoint* Peek(v8::Local<v8::Value> value) { WrapPulleyJoint* wrap = Unwrap(value); return (wrap)?(wrap->Peek()):(NULL); }
 public:
 	static NAN_MODULE_INIT(Init)
 	{
@@ -4806,17 +6668,17 @@ public:
 		{
 			v8::Local<v8::FunctionTemplate> function_template = Nan::New<v8::FunctionTemplate>(New);
 			g_function_template.Reset(function_template);
-			function_template->SetClassName(NANX_SYMBOL("b2WeldJoint"));
+			function_template->SetClassName(NANX_SYMBOL("b2PulleyJoint"));
 			function_template->Inherit(WrapJoint::GetFunctionTemplate());
 			function_template->InstanceTemplate()->SetInternalFieldCount(1);
 			v8::Local<v8::ObjectTemplate> prototype_template = function_template->PrototypeTemplate();
-			NANX_METHOD_APPLY(prototype_template, GetLocalAnchorA)
-			NANX_METHOD_APPLY(prototype_template, GetLocalAnchorB)
-			NANX_METHOD_APPLY(prototype_template, GetReferenceAngle)
-			NANX_METHOD_APPLY(prototype_template, SetFrequency)
-			NANX_METHOD_APPLY(prototype_template, GetFrequency)
-			NANX_METHOD_APPLY(prototype_template, SetDampingRatio)
-			NANX_METHOD_APPLY(prototype_template, GetDampingRatio)
+			NANX_METHOD_APPLY(prototype_template, GetGroundAnchorA)
+			NANX_METHOD_APPLY(prototype_template, GetGroundAnchorB)
+			NANX_METHOD_APPLY(prototype_template, GetLengthA)
+			NANX_METHOD_APPLY(prototype_template, GetLengthB)
+			NANX_METHOD_APPLY(prototype_template, GetRatio)
+			NANX_METHOD_APPLY(prototype_template, GetCurrentLengthA)
+			NANX_METHOD_APPLY(prototype_template, GetCurrentLengthB)
 		}
 		v8::Local<v8::FunctionTemplate> function_template = Nan::New<v8::FunctionTemplate>(g_function_template);
 		return scope.Escape(function_template);
@@ -4833,7 +6695,7 @@ private:
 	{
 		if (info.IsConstructCall())
 		{
-			WrapWeldJoint* wrap = new WrapWeldJoint();
+			WrapPulleyJoint* wrap = new WrapPulleyJoint();
 			wrap->Wrap(info.This());
 			info.GetReturnValue().Set(info.This());
 		}
@@ -4847,88 +6709,83 @@ private:
 ///	b2Vec2 GetAnchorB() const;
 ///	b2Vec2 GetReactionForce(float32 inv_dt) const;
 ///	float32 GetReactionTorque(float32 inv_dt) const;
-	NANX_METHOD(GetLocalAnchorA)
+	NANX_METHOD(GetGroundAnchorA)
 	{
-		WrapWeldJoint* wrap = Unwrap(info.This());
+		WrapPulleyJoint* wrap = Unwrap(info.This());
 		v8::Local<v8::Object> out = info[0]->IsUndefined() ? WrapVec2::NewInstance() : v8::Local<v8::Object>::Cast(info[0]);
-		WrapVec2::Unwrap(out)->SetVec2(wrap->m_weld_joint->GetLocalAnchorA());
+		WrapVec2::Unwrap(out)->SetVec2(wrap->m_pulley_joint->GetGroundAnchorA());
 		info.GetReturnValue().Set(out);
 	}
-	NANX_METHOD(GetLocalAnchorB)
+	NANX_METHOD(GetGroundAnchorB)
 	{
-		WrapWeldJoint* wrap = Unwrap(info.This());
+		WrapPulleyJoint* wrap = Unwrap(info.This());
 		v8::Local<v8::Object> out = info[0]->IsUndefined() ? WrapVec2::NewInstance() : v8::Local<v8::Object>::Cast(info[0]);
-		WrapVec2::Unwrap(out)->SetVec2(wrap->m_weld_joint->GetLocalAnchorB());
+		WrapVec2::Unwrap(out)->SetVec2(wrap->m_pulley_joint->GetGroundAnchorB());
 		info.GetReturnValue().Set(out);
 	}
-	NANX_METHOD(GetReferenceAngle)
+	NANX_METHOD(GetLengthA)
 	{
-		WrapWeldJoint* wrap = Unwrap(info.This());
-		info.GetReturnValue().Set(Nan::New(wrap->m_weld_joint->GetReferenceAngle()));
+		WrapPulleyJoint* wrap = Unwrap(info.This());
+		info.GetReturnValue().Set(Nan::New(wrap->m_pulley_joint->GetLengthA()));
 	}
-	NANX_METHOD(SetFrequency)
+	NANX_METHOD(GetLengthB)
 	{
-		WrapWeldJoint* wrap = Unwrap(info.This());
-		wrap->m_weld_joint->SetFrequency(NANX_float32(info[0]));
+		WrapPulleyJoint* wrap = Unwrap(info.This());
+		info.GetReturnValue().Set(Nan::New(wrap->m_pulley_joint->GetLengthB()));
 	}
-	NANX_METHOD(GetFrequency)
+	NANX_METHOD(GetRatio)
 	{
-		WrapWeldJoint* wrap = Unwrap(info.This());
-		info.GetReturnValue().Set(Nan::New(wrap->m_weld_joint->GetFrequency()));
+		WrapPulleyJoint* wrap = Unwrap(info.This());
+		info.GetReturnValue().Set(Nan::New(wrap->m_pulley_joint->GetRatio()));
 	}
-	NANX_METHOD(SetDampingRatio)
+	NANX_METHOD(GetCurrentLengthA)
 	{
-		WrapWeldJoint* wrap = Unwrap(info.This());
-		wrap->m_weld_joint->SetDampingRatio(NANX_float32(info[0]));
+		WrapPulleyJoint* wrap = Unwrap(info.This());
+		info.GetReturnValue().Set(Nan::New(wrap->m_pulley_joint->GetCurrentLengthA()));
 	}
-	NANX_METHOD(GetDampingRatio)
+	NANX_METHOD(GetCurrentLengthB)
 	{
-		WrapWeldJoint* wrap = Unwrap(info.This());
-		info.GetReturnValue().Set(Nan::New(wrap->m_weld_joint->GetDampingRatio()));
+		WrapPulleyJoint* wrap = Unwrap(info.This());
+		info.GetReturnValue().Set(Nan::New(wrap->m_pulley_joint->GetCurrentLengthB()));
 	}
 ///	void Dump();
 };
 
-//// b2FrictionJointDef
+//// b2MouseJointDef
 
-class WrapFrictionJointDef : public WrapJointDef
+class WrapMouseJointDef : public WrapJointDef
 {
 private:
-	b2FrictionJointDef m_friction_jd;
-	Nan::Persistent<v8::Object> m_wrap_localAnchorA; // m_friction_jd.localAnchorA
-	Nan::Persistent<v8::Object> m_wrap_localAnchorB; // m_friction_jd.localAnchorB
+	b2MouseJointDef m_mouse_jd;
+	Nan::Persistent<v8::Object> m_wrap_target; // m_mouse_jd.target
 private:
-	WrapFrictionJointDef()
+	WrapMouseJointDef()
 	{
-		m_wrap_localAnchorA.Reset(WrapVec2::NewInstance(m_friction_jd.localAnchorA));
-		m_wrap_localAnchorB.Reset(WrapVec2::NewInstance(m_friction_jd.localAnchorB));
+		m_wrap_target.Reset(WrapVec2::NewInstance(m_mouse_jd.target));
 	}
-	~WrapFrictionJointDef()
+	~WrapMouseJointDef()
 	{
-		m_wrap_localAnchorA.Reset();
-		m_wrap_localAnchorB.Reset();
+		m_wrap_target.Reset();
 	}
 public:
-	b2FrictionJointDef* Peek() { return &m_friction_jd; }
-	virtual b2JointDef& GetJointDef() { return m_friction_jd; } // override WrapJointDef
+	b2MouseJointDef* Peek() { return &m_mouse_jd; }
+	virtual b2JointDef& GetJointDef() { return m_mouse_jd; } // override WrapJointDef
 	virtual void SyncPull() // override WrapJointDef
 	{
 		// sync: pull data from javascript objects
 		WrapJointDef::SyncPull();
-		m_friction_jd.localAnchorA = WrapVec2::Unwrap(Nan::New<v8::Object>(m_wrap_localAnchorA))->GetVec2(); // struct copy
-		m_friction_jd.localAnchorB = WrapVec2::Unwrap(Nan::New<v8::Object>(m_wrap_localAnchorB))->GetVec2(); // struct copy
+		m_mouse_jd.target = WrapVec2::Unwrap(Nan::New<v8::Object>(m_wrap_target))->GetVec2(); // struct copy
 	}
 	virtual void SyncPush() // override WrapJointDef
 	{
 		// sync: push data into javascript objects
 		WrapJointDef::SyncPush();
-		WrapVec2::Unwrap(Nan::New<v8::Object>(m_wrap_localAnchorA))->SetVec2(m_friction_jd.localAnchorA);
-		WrapVec2::Unwrap(Nan::New<v8::Object>(m_wrap_localAnchorB))->SetVec2(m_friction_jd.localAnchorB);
+		WrapVec2::Unwrap(Nan::New<v8::Object>(m_wrap_target))->SetVec2(m_mouse_jd.target);
 	}
 public:
-	static WrapFrictionJointDef* Unwrap(v8::Local<v8::Value> value) { return (value->IsObject())?(Unwrap(v8::Local<v8::Object>::Cast(value))):(NULL); }
-	static WrapFrictionJointDef* Unwrap(v8::Local<v8::Object> object) { return Nan::ObjectWrap::Unwrap<WrapFrictionJointDef>(object); }
-	static b2FrictionJointDef* Peek(v8::Local<v8::Value> value) { WrapFrictionJointDef* wrap = Unwrap(value); return (wrap)?(wrap->Peek()):(NULL); }
+	static WrapMouseJointDef* Unwrap(v8::Local<v8::Value> value) { return (value->IsObject())?(Unwrap(v8::Local<v8::Object>::Cast(value))):(NULL); }
+	static WrapMouseJointDef* Unwrap(v8::Local<v8::Object> object) { return Nan::ObjectWrap::Unwrap<WrapMouseJointDef>(object); }
+	static b2MouseJointDef* Peek(v8::Local<v8::Value> value) { WrapMouseJointDef* wrap = Unwrap(value); return (wrap)?(wrap->Peek()):(NULL); }
 public:
 	static NAN_MODULE_INIT(Init)
 	{
@@ -4950,15 +6807,14 @@ public:
 		{
 			v8::Local<v8::FunctionTemplate> function_template = Nan::New<v8::FunctionTemplate>(New);
 			g_function_template.Reset(function_template);
-			function_template->SetClassName(NANX_SYMBOL("b2FrictionJointDef"));
+			function_template->SetClassName(NANX_SYMBOL("b2MouseJointDef"));
 			function_template->Inherit(WrapJointDef::GetFunctionTemplate());
 			function_template->InstanceTemplate()->SetInternalFieldCount(1);
 			v8::Local<v8::ObjectTemplate> prototype_template = function_template->PrototypeTemplate();
-			NANX_MEMBER_APPLY(prototype_template, localAnchorA)
-			NANX_MEMBER_APPLY(prototype_template, localAnchorB)
+			NANX_MEMBER_APPLY(prototype_template, target)
 			NANX_MEMBER_APPLY(prototype_template, maxForce)
-			NANX_MEMBER_APPLY(prototype_template, maxTorque)
-			NANX_METHOD_APPLY(prototype_template, Initialize)
+			NANX_MEMBER_APPLY(prototype_template, frequencyHz)
+			NANX_MEMBER_APPLY(prototype_template, dampingRatio)
 		}
 		v8::Local<v8::FunctionTemplate> function_template = Nan::New<v8::FunctionTemplate>(g_function_template);
 		return scope.Escape(function_template);
@@ -4975,7 +6831,7 @@ private:
 	{
 		if (info.IsConstructCall())
 		{
-			WrapFrictionJointDef* wrap = new WrapFrictionJointDef();
+			WrapMouseJointDef* wrap = new WrapMouseJointDef();
 			wrap->Wrap(info.This());
 			info.GetReturnValue().Set(info.This());
 		}
@@ -4985,50 +6841,40 @@ private:
 			info.GetReturnValue().Set(constructor->NewInstance());
 		}
 	}
-	NANX_MEMBER_OBJECT(localAnchorA) // m_wrap_localAnchorA
-	NANX_MEMBER_OBJECT(localAnchorB) // m_wrap_localAnchorB
+	NANX_MEMBER_OBJECT(target) // m_wrap_target
 	NANX_MEMBER_NUMBER(float32, maxForce)
-	NANX_MEMBER_NUMBER(float32, maxTorque)
-	NANX_METHOD(Initialize)
-	{
-		WrapFrictionJointDef* wrap = Unwrap(info.This());
-		WrapBody* wrap_bodyA = WrapBody::Unwrap(v8::Local<v8::Object>::Cast(info[0]));
-		WrapBody* wrap_bodyB = WrapBody::Unwrap(v8::Local<v8::Object>::Cast(info[1]));
-		WrapVec2* wrap_anchor = WrapVec2::Unwrap(v8::Local<v8::Object>::Cast(info[2]));
-		wrap->SyncPull();
-		wrap->m_friction_jd.Initialize(wrap_bodyA->Peek(), wrap_bodyB->Peek(), wrap_anchor->GetVec2());
-		wrap->SyncPush();
-	}
+	NANX_MEMBER_NUMBER(float32, frequencyHz)
+	NANX_MEMBER_NUMBER(float32, dampingRatio)
 };
 
-//// b2FrictionJoint
+//// b2MouseJoint
 
-class WrapFrictionJoint : public WrapJoint
+class WrapMouseJoint : public WrapJoint
 {
 private:
-	b2FrictionJoint* m_friction_joint;
+	b2MouseJoint* m_mouse_joint;
 private:
-	WrapFrictionJoint() : m_friction_joint(NULL) {}
-	~WrapFrictionJoint() {}
+	WrapMouseJoint() : m_mouse_joint(NULL) {}
+	~WrapMouseJoint() {}
 public:
-	b2FrictionJoint* Peek() { return m_friction_joint; }
-	virtual b2Joint* GetJoint() { return m_friction_joint; } // override WrapJoint
-	void SetupObject(v8::Local<v8::Object> h_world, WrapFrictionJointDef* wrap_friction_jd, b2FrictionJoint* friction_joint)
+	b2MouseJoint* Peek() { return m_mouse_joint; }
+	virtual b2Joint* GetJoint() { return m_mouse_joint; } // override WrapJoint
+	void SetupObject(v8::Local<v8::Object> h_world, WrapMouseJointDef* wrap_mouse_jd, b2MouseJoint* mouse_joint)
 	{
-		m_friction_joint = friction_joint;
-		WrapJoint::SetupObject(h_world, wrap_friction_jd);
+		m_mouse_joint = mouse_joint;
+		WrapJoint::SetupObject(h_world, wrap_mouse_jd);
 	}
-	b2FrictionJoint* ResetObject()
+	b2MouseJoint* ResetObject()
 	{
 		WrapJoint::ResetObject();
-		b2FrictionJoint* friction_joint = m_friction_joint;
-		m_friction_joint = NULL;
-		return friction_joint;
+		b2MouseJoint* mouse_joint = m_mouse_joint;
+		m_mouse_joint = NULL;
+		return mouse_joint;
 	}
 public:
-	static WrapFrictionJoint* Unwrap(v8::Local<v8::Value> value) { return (value->IsObject())?(Unwrap(v8::Local<v8::Object>::Cast(value))):(NULL); }
-	static WrapFrictionJoint* Unwrap(v8::Local<v8::Object> object) { return Nan::ObjectWrap::Unwrap<WrapFrictionJoint>(object); }
-	static b2FrictionJoint* Peek(v8::Local<v8::Value> value) { WrapFrictionJoint* wrap = Unwrap(value); return (wrap)?(wrap->Peek()):(NULL); }
+	static WrapMouseJoint* Unwrap(v8::Local<v8::Value> value) { return (value->IsObject())?(Unwrap(v8::Local<v8::Object>::Cast(value))):(NULL); }
+	static WrapMouseJoint* Unwrap(v8::Local<v8::Object> object) { return Nan::ObjectWrap::Unwrap<WrapMouseJoint>(object); }
+	static b2MouseJoint* Peek(v8::Local<v8::Value> value) { WrapMouseJoint* wrap = Unwrap(value); return (wrap)?(wrap->Peek()):(NULL); }
 public:
 	static NAN_MODULE_INIT(Init)
 	{
@@ -5050,16 +6896,18 @@ public:
 		{
 			v8::Local<v8::FunctionTemplate> function_template = Nan::New<v8::FunctionTemplate>(New);
 			g_function_template.Reset(function_template);
-			function_template->SetClassName(NANX_SYMBOL("b2FrictionJoint"));
+			function_template->SetClassName(NANX_SYMBOL("b2MouseJoint"));
 			function_template->Inherit(WrapJoint::GetFunctionTemplate());
 			function_template->InstanceTemplate()->SetInternalFieldCount(1);
 			v8::Local<v8::ObjectTemplate> prototype_template = function_template->PrototypeTemplate();
-			NANX_METHOD_APPLY(prototype_template, GetLocalAnchorA)
-			NANX_METHOD_APPLY(prototype_template, GetLocalAnchorB)
+			NANX_METHOD_APPLY(prototype_template, SetTarget)
+			NANX_METHOD_APPLY(prototype_template, GetTarget)
 			NANX_METHOD_APPLY(prototype_template, SetMaxForce)
 			NANX_METHOD_APPLY(prototype_template, GetMaxForce)
-			NANX_METHOD_APPLY(prototype_template, SetMaxTorque)
-			NANX_METHOD_APPLY(prototype_template, GetMaxTorque)
+			NANX_METHOD_APPLY(prototype_template, SetFrequency)
+			NANX_METHOD_APPLY(prototype_template, GetFrequency)
+			NANX_METHOD_APPLY(prototype_template, SetDampingRatio)
+			NANX_METHOD_APPLY(prototype_template, GetDampingRatio)
 		}
 		v8::Local<v8::FunctionTemplate> function_template = Nan::New<v8::FunctionTemplate>(g_function_template);
 		return scope.Escape(function_template);
@@ -5076,7 +6924,7 @@ private:
 	{
 		if (info.IsConstructCall())
 		{
-			WrapFrictionJoint* wrap = new WrapFrictionJoint();
+			WrapMouseJoint* wrap = new WrapMouseJoint();
 			wrap->Wrap(info.This());
 			info.GetReturnValue().Set(info.This());
 		}
@@ -5090,83 +6938,94 @@ private:
 ///	b2Vec2 GetAnchorB() const;
 ///	b2Vec2 GetReactionForce(float32 inv_dt) const;
 ///	float32 GetReactionTorque(float32 inv_dt) const;
-	NANX_METHOD(GetLocalAnchorA)
+	NANX_METHOD(SetTarget)
 	{
-		WrapFrictionJoint* wrap = Unwrap(info.This());
-		v8::Local<v8::Object> out = info[0]->IsUndefined() ? WrapVec2::NewInstance() : v8::Local<v8::Object>::Cast(info[0]);
-		WrapVec2::Unwrap(out)->SetVec2(wrap->m_friction_joint->GetLocalAnchorA());
-		info.GetReturnValue().Set(out);
+		WrapMouseJoint* wrap = Unwrap(info.This());
+		WrapVec2* wrap_target = WrapVec2::Unwrap(v8::Local<v8::Object>::Cast(info[0]));
+		Recorder* recorder = wrap->Recording();
+		if (recorder) { recorder->Op(e_recordSetTarget).Int(recorder->GetJointId(wrap->m_mouse_joint)).Vec2(wrap_target->GetVec2()); }
+		wrap->m_mouse_joint->SetTarget(wrap_target->GetVec2());
 	}
-	NANX_METHOD(GetLocalAnchorB)
+	NANX_METHOD(GetTarget)
 	{
-		WrapFrictionJoint* wrap = Unwrap(info.This());
+		WrapMouseJoint* wrap = Unwrap(info.This());
 		v8::Local<v8::Object> out = info[0]->IsUndefined() ? WrapVec2::NewInstance() : v8::Local<v8::Object>::Cast(info[0]);
-		WrapVec2::Unwrap(out)->SetVec2(wrap->m_friction_joint->GetLocalAnchorB());
+		WrapVec2::Unwrap(out)->SetVec2(wrap->m_mouse_joint->GetTarget());
 		info.GetReturnValue().Set(out);
 	}
 	NANX_METHOD(SetMaxForce)
 	{
-		WrapFrictionJoint* wrap = Unwrap(info.This());
-		wrap->m_friction_joint->SetMaxForce(NANX_float32(info[0]));
+		WrapMouseJoint* wrap = Unwrap(info.This());
+		wrap->m_mouse_joint->SetMaxForce(NANX_float32(info[0]));
 	}
 	NANX_METHOD(GetMaxForce)
 	{
-		WrapFrictionJoint* wrap = Unwrap(info.This());
-		info.GetReturnValue().Set(Nan::New(wrap->m_friction_joint->GetMaxForce()));
+		WrapMouseJoint* wrap = Unwrap(info.This());
+		info.GetReturnValue().Set(Nan::New(wrap->m_mouse_joint->GetMaxForce()));
 	}
-	NANX_METHOD(SetMaxTorque)
+	NANX_METHOD(SetFrequency)
 	{
-		WrapFrictionJoint* wrap = Unwrap(info.This());
-		wrap->m_friction_joint->SetMaxTorque(NANX_float32(info[0]));
+		WrapMouseJoint* wrap = Unwrap(info.This());
+		wrap->m_mouse_joint->SetFrequency(NANX_float32(info[0]));
 	}
-	NANX_METHOD(GetMaxTorque)
+	NANX_METHOD(GetFrequency)
 	{
-		WrapFrictionJoint* wrap = Unwrap(info.This());
-		info.GetReturnValue().Set(Nan::New(wrap->m_friction_joint->GetMaxTorque()));
+		WrapMouseJoint* wrap = Unwrap(info.This());
+		info.GetReturnValue().Set(Nan::New(wrap->m_mouse_joint->GetFrequency()));
+	}
+	NANX_METHOD(SetDampingRatio)
+	{
+		WrapMouseJoint* wrap = Unwrap(info.This());
+		wrap->m_mouse_joint->SetDampingRatio(NANX_float32(info[0]));
+	}
+	NANX_METHOD(GetDampingRatio)
+	{
+		WrapMouseJoint* wrap = Unwrap(info.This());
+		info.GetReturnValue().Set(Nan::New(wrap->m_mouse_joint->GetDampingRatio()));
 	}
 ///	void Dump();
 };
 
-//// b2RopeJointDef
+//// b2GearJointDef
 
-class WrapRopeJointDef : public WrapJointDef
+class WrapGearJointDef : public WrapJointDef
 {
 private:
-	b2RopeJointDef m_rope_jd;
-	Nan::Persistent<v8::Object> m_wrap_localAnchorA; // m_rope_jd.localAnchorA
-	Nan::Persistent<v8::Object> m_wrap_localAnchorB; // m_rope_jd.localAnchorB
+	b2GearJointDef m_gear_jd;
+	Nan::Persistent<v8::Object> m_wrap_joint1; // m_gear_jd.joint1
+	Nan::Persistent<v8::Object> m_wrap_joint2; // m_gear_jd.joint2
 private:
-	WrapRopeJointDef()
-	{
-		m_wrap_localAnchorA.Reset(WrapVec2::NewInstance(m_rope_jd.localAnchorA));
-		m_wrap_localAnchorB.Reset(WrapVec2::NewInstance(m_rope_jd.localAnchorB));
-	}
-	~WrapRopeJointDef()
+	WrapGearJointDef() {}
+	~WrapGearJointDef()
 	{
-		m_wrap_localAnchorA.Reset();
-		m_wrap_localAnchorB.Reset();
+		m_wrap_joint1.Reset();
+		m_wrap_joint2.Reset();
 	}
 public:
-	b2RopeJointDef* Peek() { return &m_rope_jd; }
-	virtual b2JointDef& GetJointDef() { return m_rope_jd; } // override WrapJointDef
+	b2GearJointDef* Peek() { return & m_gear_jd; }
+	virtual b2JointDef& GetJointDef() { return m_gear_jd; } // override WrapJointDef
+	v8::Local<v8::Object> GetJoint1Handle() { return Nan::New<v8::Object>(m_wrap_joint1); }
+	v8::Local<v8::Object> GetJoint2Handle() { return Nan::New<v8::Object>(m_wrap_joint2); }
 	virtual void SyncPull() // override WrapJointDef
 	{
 		// sync: pull data from javascript objects
 		WrapJointDef::SyncPull();
-		m_rope_jd.localAnchorA = WrapVec2::Unwrap(Nan::New<v8::Object>(m_wrap_localAnchorA))->GetVec2(); // struct copy
-		m_rope_jd.localAnchorB = WrapVec2::Unwrap(Nan::New<v8::Object>(m_wrap_localAnchorB))->GetVec2(); // struct copy
+		m_gear_jd.joint1 = m_wrap_joint1.IsEmpty() ? NULL : WrapJoint::Unwrap(Nan::New<v8::Object>(m_wrap_joint1))->GetJoint();
+		m_gear_jd.joint2 = m_wrap_joint2.IsEmpty() ? NULL : WrapJoint::Unwrap(Nan::New<v8::Object>(m_wrap_joint2))->GetJoint();
 	}
 	virtual void SyncPush() // override WrapJointDef
 	{
 		// sync: push data into javascript objects
 		WrapJointDef::SyncPush();
-		WrapVec2::Unwrap(Nan::New<v8::Object>(m_wrap_localAnchorA))->SetVec2(m_rope_jd.localAnchorA);
-		WrapVec2::Unwrap(Nan::New<v8::Object>(m_wrap_localAnchorB))->SetVec2(m_rope_jd.localAnchorB);
+		WrapJoint* wrap_joint1 = (m_gear_jd.joint1)?(WrapJoint::GetWrap(m_gear_jd.joint1)):(NULL);
+		WrapJoint* wrap_joint2 = (m_gear_jd.joint2)?(WrapJoint::GetWrap(m_gear_jd.joint2)):(NULL);
+		if (wrap_joint1) { m_wrap_joint1.Reset(wrap_joint1->handle()); } else { m_wrap_joint1.Reset(); }
+		if (wrap_joint2) { m_wrap_joint2.Reset(wrap_joint2->handle()); } else { m_wrap_joint2.Reset(); }
 	}
 public:
-	static WrapRopeJointDef* Unwrap(v8::Local<v8::Value> value) { return (value->IsObject())?(Unwrap(v8::Local<v8::Object>::Cast(value))):(NULL); }
-	static WrapRopeJointDef* Unwrap(v8::Local<v8::Object> object) { return Nan::ObjectWrap::Unwrap<WrapRopeJointDef>(object); }
-	static b2RopeJointDef* Peek(v8::Local<v8::Value> value) { WrapRopeJointDef* wrap = Unwrap(value); return (wrap)?(wrap->Peek()):(NULL); }
+	static WrapGearJointDef* Unwrap(v8::Local<v8::Value> value) { return (value->IsObject())?(Unwrap(v8::Local<v8::Object>::Cast(value))):(NULL); }
+	static WrapGearJointDef* Unwrap(v8::Local<v8::Object> object) { return Nan::ObjectWrap::Unwrap<WrapGearJointDef>(object); }
+	static b2GearJointDef* Peek(v8::Local<v8::Value> value) { WrapGearJointDef* wrap = Unwrap(value); return (wrap)?(wrap->Peek()):(NULL); }
 public:
 	static NAN_MODULE_INIT(Init)
 	{
@@ -5188,13 +7047,13 @@ public:
 		{
 			v8::Local<v8::FunctionTemplate> function_template = Nan::New<v8::FunctionTemplate>(New);
 			g_function_template.Reset(function_template);
-			function_template->SetClassName(NANX_SYMBOL("b2RopeJointDef"));
+			function_template->SetClassName(NANX_SYMBOL("b2GearJointDef"));
 			function_template->Inherit(WrapJointDef::GetFunctionTemplate());
 			function_template->InstanceTemplate()->SetInternalFieldCount(1);
 			v8::Local<v8::ObjectTemplate> prototype_template = function_template->PrototypeTemplate();
-			NANX_MEMBER_APPLY(prototype_template, localAnchorA)
-			NANX_MEMBER_APPLY(prototype_template, localAnchorB)
-			NANX_MEMBER_APPLY(prototype_template, maxLength)
+			NANX_MEMBER_APPLY(prototype_template, joint1)
+			NANX_MEMBER_APPLY(prototype_template, joint2)
+			NANX_MEMBER_APPLY(prototype_template, ratio)
 		}
 		v8::Local<v8::FunctionTemplate> function_template = Nan::New<v8::FunctionTemplate>(g_function_template);
 		return scope.Escape(function_template);
@@ -5211,7 +7070,7 @@ private:
 	{
 		if (info.IsConstructCall())
 		{
-			WrapRopeJointDef* wrap = new WrapRopeJointDef();
+			WrapGearJointDef* wrap = new WrapGearJointDef();
 			wrap->Wrap(info.This());
 			info.GetReturnValue().Set(info.This());
 		}
@@ -5221,39 +7080,53 @@ private:
 			info.GetReturnValue().Set(constructor->NewInstance());
 		}
 	}
-	NANX_MEMBER_OBJECT(localAnchorA) // m_wrap_localAnchorA
-	NANX_MEMBER_OBJECT(localAnchorB) // m_wrap_localAnchorB
-	NANX_MEMBER_NUMBER(float32, maxLength)
+	NANX_MEMBER_OBJECT(joint1) // m_wrap_joint1
+	NANX_MEMBER_OBJECT(joint2) // m_wrap_joint2
+	NANX_MEMBER_NUMBER(float32, ratio)
 };
 
-//// b2RopeJoint
+//// b2GearJoint
 
-class WrapRopeJoint : public WrapJoint
+class WrapGearJoint : public WrapJoint
 {
 private:
-	b2RopeJoint* m_rope_joint;
+	b2GearJoint* m_gear_joint;
+	Nan::Persistent<v8::Object> m_gear_joint_joint1;
+	Nan::Persistent<v8::Object> m_gear_joint_joint2;
 private:
-	WrapRopeJoint() : m_rope_joint(NULL) {}
-	~WrapRopeJoint() {}
+	WrapGearJoint() : m_gear_joint(NULL) {}
+	~WrapGearJoint()
+	{
+		m_gear_joint_joint1.Reset();
+		m_gear_joint_joint2.Reset();
+	}
 public:
-	b2RopeJoint* Peek() { return m_rope_joint; }
-	virtual b2Joint* GetJoint() { return m_rope_joint; } // override WrapJoint
-	void SetupObject(v8::Local<v8::Object> h_world, WrapRopeJointDef* wrap_rope_jd, b2RopeJoint* rope_joint)
+	b2GearJoint* Peek() { return m_gear_joint; }
+	virtual b2Joint* GetJoint() { return m_gear_joint; } // override WrapJoint
+	void SetupObject(v8::Local<v8::Object> h_world, WrapGearJointDef* wrap_gear_jd, b2GearJoint* gear_joint)
 	{
-		m_rope_joint = rope_joint;
-		WrapJoint::SetupObject(h_world, wrap_rope_jd);
+		m_gear_joint = gear_joint;
+		m_gear_joint_joint1.Reset(WrapJoint::GetWrap(gear_joint->GetJoint1())->handle());
+		m_gear_joint_joint2.Reset(WrapJoint::GetWrap(gear_joint->GetJoint2())->handle());
+		WrapJoint::SetupObject(h_world, wrap_gear_jd);
 	}
-	b2RopeJoint* ResetObject()
+	b2GearJoint* ResetObject()
 	{
 		WrapJoint::ResetObject();
-		b2RopeJoint* rope_joint = m_rope_joint;
-		m_rope_joint = NULL;
-		return rope_joint;
+		m_gear_joint_joint1.Reset();
+		m_gear_joint_joint2.Reset();
+		b2GearJoint* gear_joint = m_gear_joint;
+		m_gear_joint = NULL;
+		return gear_joint;
+	}
+	virtual int32 GetPersistentCount() const // override WrapJoint
+	{
+		return WrapJoint::GetPersistentCount() + (m_gear_joint_joint1.IsEmpty()?0:1) + (m_gear_joint_joint2.IsEmpty()?0:1);
 	}
 public:
-	static WrapRopeJoint* Unwrap(v8::Local<v8::Value> value) { return (value->IsObject())?(Unwrap(v8::Local<v8::Object>::Cast(value))):(NULL); }
-	static WrapRopeJoint* Unwrap(v8::Local<v8::Object> object) { return Nan::ObjectWrap::Unwrap<WrapRopeJoint>(object); }
-	static b2RopeJoint* Peek(v8::Local<v8::Value> value) { WrapRopeJoint* wrap = Unwrap(value); return (wrap)?(wrap->Peek()):(NULL); }
+	static WrapGearJoint* Unwrap(v8::Local<v8::Value> value) { return (value->IsObject())?(Unwrap(v8::Local<v8::Object>::Cast(value))):(NULL); }
+	static WrapGearJoint* Unwrap(v8::Local<v8::Object> object) { return Nan::ObjectWrap::Unwrap<WrapGearJoint>(object); }
+	static b2GearJoint* Peek(v8::Local<v8::Value> value) { WrapGearJoint* wrap = Unwrap(value); return (wrap)?(wrap->Peek()):(NULL); }
 public:
 	static NAN_MODULE_INIT(Init)
 	{
@@ -5275,15 +7148,14 @@ public:
 		{
 			v8::Local<v8::FunctionTemplate> function_template = Nan::New<v8::FunctionTemplate>(New);
 			g_function_template.Reset(function_template);
-			function_template->SetClassName(NANX_SYMBOL("b2RopeJoint"));
+			function_template->SetClassName(NANX_SYMBOL("b2GearJoint"));
 			function_template->Inherit(WrapJoint::GetFunctionTemplate());
 			function_template->InstanceTemplate()->SetInternalFieldCount(1);
 			v8::Local<v8::ObjectTemplate> prototype_template = function_template->PrototypeTemplate();
-			NANX_METHOD_APPLY(prototype_template, GetLocalAnchorA)
-			NANX_METHOD_APPLY(prototype_template, GetLocalAnchorB)
-			NANX_METHOD_APPLY(prototype_template, SetMaxLength)
-			NANX_METHOD_APPLY(prototype_template, GetMaxLength)
-			NANX_METHOD_APPLY(prototype_template, GetLimitState)
+			NANX_METHOD_APPLY(prototype_template, GetJoint1)
+			NANX_METHOD_APPLY(prototype_template, GetJoint2)
+			NANX_METHOD_APPLY(prototype_template, SetRatio)
+			NANX_METHOD_APPLY(prototype_template, GetRatio)
 		}
 		v8::Local<v8::FunctionTemplate> function_template = Nan::New<v8::FunctionTemplate>(g_function_template);
 		return scope.Escape(function_template);
@@ -5300,7 +7172,7 @@ private:
 	{
 		if (info.IsConstructCall())
 		{
-			WrapRopeJoint* wrap = new WrapRopeJoint();
+			WrapGearJoint* wrap = new WrapGearJoint();
 			wrap->Wrap(info.This());
 			info.GetReturnValue().Set(info.This());
 		}
@@ -5314,73 +7186,88 @@ private:
 ///	b2Vec2 GetAnchorB() const;
 ///	b2Vec2 GetReactionForce(float32 inv_dt) const;
 ///	float32 GetReactionTorque(float32 inv_dt) const;
-	NANX_METHOD(GetLocalAnchorA)
-	{
-		WrapRopeJoint* wrap = Unwrap(info.This());
-		v8::Local<v8::Object> out = info[0]->IsUndefined() ? WrapVec2::NewInstance() : v8::Local<v8::Object>::Cast(info[0]);
-		WrapVec2::Unwrap(out)->SetVec2(wrap->m_rope_joint->GetLocalAnchorA());
-		info.GetReturnValue().Set(out);
-	}
-	NANX_METHOD(GetLocalAnchorB)
+	NANX_METHOD(GetJoint1)
 	{
-		WrapRopeJoint* wrap = Unwrap(info.This());
-		v8::Local<v8::Object> out = info[0]->IsUndefined() ? WrapVec2::NewInstance() : v8::Local<v8::Object>::Cast(info[0]);
-		WrapVec2::Unwrap(out)->SetVec2(wrap->m_rope_joint->GetLocalAnchorB());
-		info.GetReturnValue().Set(out);
+		WrapGearJoint* wrap = Unwrap(info.This());
+		if (!wrap->m_gear_joint_joint1.IsEmpty())
+		{
+			info.GetReturnValue().Set(Nan::New<v8::Object>(wrap->m_gear_joint_joint1));
+		}
+		else
+		{
+			info.GetReturnValue().SetNull();
+		}
 	}
-	NANX_METHOD(SetMaxLength)
+	NANX_METHOD(GetJoint2)
 	{
-		WrapRopeJoint* wrap = Unwrap(info.This());
-		wrap->m_rope_joint->SetMaxLength(NANX_float32(info[0]));
+		WrapGearJoint* wrap = Unwrap(info.This());
+		if (!wrap->m_gear_joint_joint2.IsEmpty())
+		{
+			info.GetReturnValue().Set(Nan::New<v8::Object>(wrap->m_gear_joint_joint2));
+		}
+		else
+		{
+			info.GetReturnValue().SetNull();
+		}
 	}
-	NANX_METHOD(GetMaxLength)
+	NANX_METHOD(SetRatio)
 	{
-		WrapRopeJoint* wrap = Unwrap(info.This());
-		info.GetReturnValue().Set(Nan::New(wrap->m_rope_joint->GetMaxLength()));
+		WrapGearJoint* wrap = Unwrap(info.This());
+		wrap->m_gear_joint->SetRatio(NANX_float32(info[0]));
 	}
-	NANX_METHOD(GetLimitState)
+	NANX_METHOD(GetRatio)
 	{
-		WrapRopeJoint* wrap = Unwrap(info.This());
-		info.GetReturnValue().Set(Nan::New(wrap->m_rope_joint->GetLimitState()));
+		WrapGearJoint* wrap = Unwrap(info.This());
+		info.GetReturnValue().Set(Nan::New(wrap->m_gear_joint->GetRatio()));
 	}
 ///	void Dump();
 };
 
-//// b2MotorJointDef
+//// b2WheelJointDef
 
-class WrapMotorJointDef : public WrapJointDef
+class WrapWheelJointDef : public WrapJointDef
 {
 private:
-	b2MotorJointDef m_motor_jd;
-	Nan::Persistent<v8::Object> m_wrap_linearOffset; // m_motor_jd.linearOffset
+	b2WheelJointDef m_wheel_jd;
+	Nan::Persistent<v8::Object> m_wrap_localAnchorA; // m_wheel_jd.localAnchorA
+	Nan::Persistent<v8::Object> m_wrap_localAnchorB; // m_wheel_jd.localAnchorB
+	Nan::Persistent<v8::Object> m_wrap_localAxisA; // m_wheel_jd.localAxisA
 private:
-	WrapMotorJointDef()
+	WrapWheelJointDef()
 	{
-		m_wrap_linearOffset.Reset(WrapVec2::NewInstance(m_motor_jd.linearOffset));
+		m_wrap_localAnchorA.Reset(WrapVec2::NewInstance(m_wheel_jd.localAnchorA));
+		m_wrap_localAnchorB.Reset(WrapVec2::NewInstance(m_wheel_jd.localAnchorB));
+		m_wrap_localAxisA.Reset(WrapVec2::NewInstance(m_wheel_jd.localAxisA));
 	}
-	~WrapMotorJointDef()
+	~WrapWheelJointDef()
 	{
-		m_wrap_linearOffset.Reset();
+		m_wrap_localAnchorA.Reset();
+		m_wrap_localAnchorB.Reset();
+		m_wrap_localAxisA.Reset();
 	}
 public:
-	b2MotorJointDef* Peek() { return &m_motor_jd; }
-	virtual b2JointDef& GetJointDef() { return m_motor_jd; } // override WrapJointDef
+	b2WheelJointDef* Peek() { return &m_wheel_jd; }
+	virtual b2JointDef& GetJointDef() { return m_wheel_jd; } // override WrapJointDef
 	virtual void SyncPull() // override WrapJointDef
 	{
 		// sync: pull data from javascript objects
 		WrapJointDef::SyncPull();
-		m_motor_jd.linearOffset = WrapVec2::Unwrap(Nan::New<v8::Object>(m_wrap_linearOffset))->GetVec2(); // struct copy
+		m_wheel_jd.localAnchorA = WrapVec2::Unwrap(Nan::New<v8::Object>(m_wrap_localAnchorA))->GetVec2(); // struct copy
+		m_wheel_jd.localAnchorB = WrapVec2::Unwrap(Nan::New<v8::Object>(m_wrap_localAnchorB))->GetVec2(); // struct copy
+		m_wheel_jd.localAxisA = WrapVec2::Unwrap(Nan::New<v8::Object>(m_wrap_localAxisA))->GetVec2(); // struct copy
 	}
 	virtual void SyncPush() // override WrapJointDef
 	{
 		// sync: push data into javascript objects
 		WrapJointDef::SyncPush();
-		WrapVec2::Unwrap(Nan::New<v8::Object>(m_wrap_linearOffset))->SetVec2(m_motor_jd.linearOffset);
+		WrapVec2::Unwrap(Nan::New<v8::Object>(m_wrap_localAnchorA))->SetVec2(m_wheel_jd.localAnchorA);
+		WrapVec2::Unwrap(Nan::New<v8::Object>(m_wrap_localAnchorB))->SetVec2(m_wheel_jd.localAnchorB);
+		WrapVec2::Unwrap(Nan::New<v8::Object>(m_wrap_localAxisA))->SetVec2(m_wheel_jd.localAxisA);
 	}
 public:
-	static WrapMotorJointDef* Unwrap(v8::Local<v8::Value> value) { return (value->IsObject())?(Unwrap(v8::Local<v8::Object>::Cast(value))):(NULL); }
-	static WrapMotorJointDef* Unwrap(v8::Local<v8::Object> object) { return Nan::ObjectWrap::Unwrap<WrapMotorJointDef>(object); }
-	static b2MotorJointDef* Peek(v8::Local<v8::Value> value) { WrapMotorJointDef* wrap = Unwrap(value); return (wrap)?(wrap->Peek()):(NULL); }
+	static WrapWheelJointDef* Unwrap(v8::Local<v8::Value> value) { return (value->IsObject())?(Unwrap(v8::Local<v8::Object>::Cast(value))):(NULL); }
+	static WrapWheelJointDef* Unwrap(v8::Local<v8::Object> object) { return Nan::ObjectWrap::Unwrap<WrapWheelJointDef>(object); }
+	static b2WheelJointDef* Peek(v8::Local<v8::Value> value) { WrapWheelJointDef* wrap = Unwrap(value); return (wrap)?(wrap->Peek()):(NULL); }
 public:
 	static NAN_MODULE_INIT(Init)
 	{
@@ -5402,15 +7289,18 @@ public:
 		{
 			v8::Local<v8::FunctionTemplate> function_template = Nan::New<v8::FunctionTemplate>(New);
 			g_function_template.Reset(function_template);
-			function_template->SetClassName(NANX_SYMBOL("b2MotorJointDef"));
+			function_template->SetClassName(NANX_SYMBOL("b2WheelJointDef"));
 			function_template->Inherit(WrapJointDef::GetFunctionTemplate());
 			function_template->InstanceTemplate()->SetInternalFieldCount(1);
 			v8::Local<v8::ObjectTemplate> prototype_template = function_template->PrototypeTemplate();
-			NANX_MEMBER_APPLY(prototype_template, linearOffset)
-			NANX_MEMBER_APPLY(prototype_template, angularOffset)
-			NANX_MEMBER_APPLY(prototype_template, maxForce)
-			NANX_MEMBER_APPLY(prototype_template, maxTorque)
-			NANX_MEMBER_APPLY(prototype_template, correctionFactor)
+			NANX_MEMBER_APPLY(prototype_template, localAnchorA)
+			NANX_MEMBER_APPLY(prototype_template, localAnchorB)
+			NANX_MEMBER_APPLY(prototype_template, localAxisA)
+			NANX_MEMBER_APPLY(prototype_template, enableMotor)
+			NANX_MEMBER_APPLY(prototype_template, maxMotorTorque)
+			NANX_MEMBER_APPLY(prototype_template, motorSpeed)
+			NANX_MEMBER_APPLY(prototype_template, frequencyHz)
+			NANX_MEMBER_APPLY(prototype_template, dampingRatio)
 			NANX_METHOD_APPLY(prototype_template, Initialize)
 		}
 		v8::Local<v8::FunctionTemplate> function_template = Nan::New<v8::FunctionTemplate>(g_function_template);
@@ -5428,7 +7318,7 @@ private:
 	{
 		if (info.IsConstructCall())
 		{
-			WrapMotorJointDef* wrap = new WrapMotorJointDef();
+			WrapWheelJointDef* wrap = new WrapWheelJointDef();
 			wrap->Wrap(info.This());
 			info.GetReturnValue().Set(info.This());
 		}
@@ -5438,50 +7328,55 @@ private:
 			info.GetReturnValue().Set(constructor->NewInstance());
 		}
 	}
-	NANX_MEMBER_OBJECT(linearOffset) // m_wrap_linearOffset
-	NANX_MEMBER_NUMBER(float32, angularOffset)
-	NANX_MEMBER_NUMBER(float32, maxForce)
-	NANX_MEMBER_NUMBER(float32, maxTorque)
-	NANX_MEMBER_NUMBER(float32, correctionFactor)
+	NANX_MEMBER_OBJECT(localAnchorA) // m_wrap_localAnchorA
+	NANX_MEMBER_OBJECT(localAnchorB) // m_wrap_localAnchorB
+	NANX_MEMBER_OBJECT(localAxisA) // m_wrap_localAxisA
+	NANX_MEMBER_BOOLEAN(bool, enableMotor)
+	NANX_MEMBER_NUMBER(float32, maxMotorTorque)
+	NANX_MEMBER_NUMBER(float32, motorSpeed)
+	NANX_MEMBER_NUMBER(float32, frequencyHz)
+	NANX_MEMBER_NUMBER(float32, dampingRatio)
 	NANX_METHOD(Initialize)
 	{
-		WrapMotorJointDef* wrap = Unwrap(info.This());
+		WrapWheelJointDef* wrap = Unwrap(info.This());
 		WrapBody* wrap_bodyA = WrapBody::Unwrap(v8::Local<v8::Object>::Cast(info[0]));
 		WrapBody* wrap_bodyB = WrapBody::Unwrap(v8::Local<v8::Object>::Cast(info[1]));
+		WrapVec2* wrap_anchor = WrapVec2::Unwrap(v8::Local<v8::Object>::Cast(info[2]));
+		WrapVec2* wrap_axis = WrapVec2::Unwrap(v8::Local<v8::Object>::Cast(info[3]));
 		wrap->SyncPull();
-		wrap->m_motor_jd.Initialize(wrap_bodyA->Peek(), wrap_bodyB->Peek());
+		wrap->m_wheel_jd.Initialize(wrap_bodyA->Peek(), wrap_bodyB->Peek(), wrap_anchor->GetVec2(), wrap_axis->GetVec2());
 		wrap->SyncPush();
 	}
 };
 
-//// b2MotorJoint
+//// b2WheelJoint
 
-class WrapMotorJoint : public WrapJoint
+class WrapWheelJoint : public WrapJoint
 {
 private:
-	b2MotorJoint* m_motor_joint;
+	b2WheelJoint* m_wheel_joint;
 private:
-	WrapMotorJoint() : m_motor_joint(NULL) {}
-	~WrapMotorJoint() {}
+	WrapWheelJoint() : m_wheel_joint(NULL) {}
+	~WrapWheelJoint() {}
 public:
-	b2MotorJoint* Peek() { return m_motor_joint; }
-	virtual b2Joint* GetJoint() { return m_motor_joint; } // override WrapJoint
-	void SetupObject(v8::Local<v8::Object> h_world, WrapMotorJointDef* wrap_motor_jd, b2MotorJoint* motor_joint)
+	b2WheelJoint* Peek() { return m_wheel_joint; }
+	virtual b2Joint* GetJoint() { return m_wheel_joint; } // override WrapJoint
+	void SetupObject(v8::Local<v8::Object> h_world, WrapWheelJointDef* wrap_wheel_jd, b2WheelJoint* wheel_joint)
 	{
-		m_motor_joint = motor_joint;
-		WrapJoint::SetupObject(h_world, wrap_motor_jd);
+		m_wheel_joint = wheel_joint;
+		WrapJoint::SetupObject(h_world, wrap_wheel_jd);
 	}
-	b2MotorJoint* ResetObject()
+	b2WheelJoint* ResetObject()
 	{
 		WrapJoint::ResetObject();
-		b2MotorJoint* motor_joint = m_motor_joint;
-		m_motor_joint = NULL;
-		return motor_joint;
+		b2WheelJoint* wheel_joint = m_wheel_joint;
+		m_wheel_joint = NULL;
+		return wheel_joint;
 	}
 public:
-	static WrapMotorJoint* Unwrap(v8::Local<v8::Value> value) { return (value->IsObject())?(Unwrap(v8::Local<v8::Object>::Cast(value))):(NULL); }
-	static WrapMotorJoint* Unwrap(v8::Local<v8::Object> object) { return Nan::ObjectWrap::Unwrap<WrapMotorJoint>(object); }
-	static b2MotorJoint* Peek(v8::Local<v8::Value> value) { WrapMotorJoint* wrap = Unwrap(value); return (wrap)?(wrap->Peek()):(NULL); }
+	static WrapWheelJoint* Unwrap(v8::Local<v8::Value> value) { return (value->IsObject())?(Unwrap(v8::Local<v8::Object>::Cast(value))):(NULL); }
+	static WrapWheelJoint* Unwrap(v8::Local<v8::Object> object) { return Nan::ObjectWrap::Unwrap<WrapWheelJoint>(object); }
+	static b2WheelJoint* Peek(v8::Local<v8::Value> value) { WrapWheelJoint* wrap = Unwrap(value); return (wrap)?(wrap->Peek()):(NULL); }
 public:
 	static NAN_MODULE_INIT(Init)
 	{
@@ -5503,20 +7398,26 @@ public:
 		{
 			v8::Local<v8::FunctionTemplate> function_template = Nan::New<v8::FunctionTemplate>(New);
 			g_function_template.Reset(function_template);
-			function_template->SetClassName(NANX_SYMBOL("b2MotorJoint"));
+			function_template->SetClassName(NANX_SYMBOL("b2WheelJoint"));
 			function_template->Inherit(WrapJoint::GetFunctionTemplate());
 			function_template->InstanceTemplate()->SetInternalFieldCount(1);
 			v8::Local<v8::ObjectTemplate> prototype_template = function_template->PrototypeTemplate();
-			NANX_METHOD_APPLY(prototype_template, SetLinearOffset)
-			NANX_METHOD_APPLY(prototype_template, GetLinearOffset)
-			NANX_METHOD_APPLY(prototype_template, SetAngularOffset)
-			NANX_METHOD_APPLY(prototype_template, GetAngularOffset)
-			NANX_METHOD_APPLY(prototype_template, SetMaxForce)
-			NANX_METHOD_APPLY(prototype_template, GetMaxForce)
-			NANX_METHOD_APPLY(prototype_template, SetMaxTorque)
-			NANX_METHOD_APPLY(prototype_template, GetMaxTorque)
-			NANX_METHOD_APPLY(prototype_template, SetCorrectionFactor)
-			NANX_METHOD_APPLY(prototype_template, GetCorrectionFactor)
+			NANX_METHOD_APPLY(prototype_template, GetLocalAnchorA)
+			NANX_METHOD_APPLY(prototype_template, GetLocalAnchorB)
+			NANX_METHOD_APPLY(prototype_template, GetLocalAxisA)
+			NANX_METHOD_APPLY(prototype_template, GetJointTranslation)
+			NANX_METHOD_APPLY(prototype_template, GetJointSpeed)
+			NANX_METHOD_APPLY(prototype_template, IsMotorEnabled)
+			NANX_METHOD_APPLY(prototype_template, EnableMotor)
+			NANX_METHOD_APPLY(prototype_template, SetMotorSpeed)
+			NANX_METHOD_APPLY(prototype_template, GetMotorSpeed)
+			NANX_METHOD_APPLY(prototype_template, SetMaxMotorTorque)
+			NANX_METHOD_APPLY(prototype_template, GetMaxMotorTorque)
+			NANX_METHOD_APPLY(prototype_template, GetMotorTorque)
+			NANX_METHOD_APPLY(prototype_template, SetSpringFrequencyHz)
+			NANX_METHOD_APPLY(prototype_template, GetSpringFrequencyHz)
+			NANX_METHOD_APPLY(prototype_template, SetSpringDampingRatio)
+			NANX_METHOD_APPLY(prototype_template, GetSpringDampingRatio)
 		}
 		v8::Local<v8::FunctionTemplate> function_template = Nan::New<v8::FunctionTemplate>(g_function_template);
 		return scope.Escape(function_template);
@@ -5533,7 +7434,7 @@ private:
 	{
 		if (info.IsConstructCall())
 		{
-			WrapMotorJoint* wrap = new WrapMotorJoint();
+			WrapWheelJoint* wrap = new WrapWheelJoint();
 			wrap->Wrap(info.This());
 			info.GetReturnValue().Set(info.This());
 		}
@@ -5547,76 +7448,141 @@ private:
 ///	b2Vec2 GetAnchorB() const;
 ///	b2Vec2 GetReactionForce(float32 inv_dt) const;
 ///	float32 GetReactionTorque(float32 inv_dt) const;
-	NANX_METHOD(SetLinearOffset)
+	NANX_METHOD(GetLocalAnchorA)
 	{
-		WrapMotorJoint* wrap = Unwrap(info.This());
-		wrap->m_motor_joint->SetLinearOffset(WrapVec2::Unwrap(v8::Local<v8::Object>::Cast(info[0]))->GetVec2());
+		WrapWheelJoint* wrap = Unwrap(info.This());
+		v8::Local<v8::Object> out = info[0]->IsUndefined() ? WrapVec2::NewInstance() : v8::Local<v8::Object>::Cast(info[0]);
+		WrapVec2::Unwrap(out)->SetVec2(wrap->m_wheel_joint->GetLocalAnchorA());
+		info.GetReturnValue().Set(out);
 	}
-	NANX_METHOD(GetLinearOffset)
+	NANX_METHOD(GetLocalAnchorB)
 	{
-		WrapMotorJoint* wrap = Unwrap(info.This());
+		WrapWheelJoint* wrap = Unwrap(info.This());
 		v8::Local<v8::Object> out = info[0]->IsUndefined() ? WrapVec2::NewInstance() : v8::Local<v8::Object>::Cast(info[0]);
-		WrapVec2::Unwrap(out)->SetVec2(wrap->m_motor_joint->GetLinearOffset());
+		WrapVec2::Unwrap(out)->SetVec2(wrap->m_wheel_joint->GetLocalAnchorB());
 		info.GetReturnValue().Set(out);
 	}
-	NANX_METHOD(SetAngularOffset)
+	NANX_METHOD(GetLocalAxisA)
 	{
-		WrapMotorJoint* wrap = Unwrap(info.This());
-		wrap->m_motor_joint->SetAngularOffset(NANX_float32(info[0]));
+		WrapWheelJoint* wrap = Unwrap(info.This());
+		v8::Local<v8::Object> out = info[0]->IsUndefined() ? WrapVec2::NewInstance() : v8::Local<v8::Object>::Cast(info[0]);
+		WrapVec2::Unwrap(out)->SetVec2(wrap->m_wheel_joint->GetLocalAxisA());
+		info.GetReturnValue().Set(out);
 	}
-	NANX_METHOD(GetAngularOffset)
+	NANX_METHOD(GetJointTranslation)
 	{
-		WrapMotorJoint* wrap = Unwrap(info.This());
-		info.GetReturnValue().Set(Nan::New(wrap->m_motor_joint->GetAngularOffset()));
+		WrapWheelJoint* wrap = Unwrap(info.This());
+		info.GetReturnValue().Set(Nan::New(wrap->m_wheel_joint->GetJointTranslation()));
 	}
-	NANX_METHOD(SetMaxForce)
+	NANX_METHOD(GetJointSpeed)
 	{
-		WrapMotorJoint* wrap = Unwrap(info.This());
-		wrap->m_motor_joint->SetMaxForce(NANX_float32(info[0]));
+		WrapWheelJoint* wrap = Unwrap(info.This());
+		info.GetReturnValue().Set(Nan::New(wrap->m_wheel_joint->GetJointSpeed()));
 	}
-	NANX_METHOD(GetMaxForce)
+	NANX_METHOD(IsMotorEnabled)
 	{
-		WrapMotorJoint* wrap = Unwrap(info.This());
-		info.GetReturnValue().Set(Nan::New(wrap->m_motor_joint->GetMaxForce()));
+		WrapWheelJoint* wrap = Unwrap(info.This());
+		info.GetReturnValue().Set(Nan::New(wrap->m_wheel_joint->IsMotorEnabled()));
 	}
-	NANX_METHOD(SetMaxTorque)
+	NANX_METHOD(EnableMotor)
 	{
-		WrapMotorJoint* wrap = Unwrap(info.This());
-		wrap->m_motor_joint->SetMaxTorque(NANX_float32(info[0]));
+		WrapWheelJoint* wrap = Unwrap(info.This());
+		bool flag = NANX_bool(info[0]);
+		Recorder* recorder = wrap->Recording();
+		if (recorder) { recorder->Op(e_recordEnableMotor).Int(recorder->GetJointId(wrap->m_wheel_joint)).Bool(flag); }
+		wrap->m_wheel_joint->EnableMotor(flag);
 	}
-	NANX_METHOD(GetMaxTorque)
+	NANX_METHOD(SetMotorSpeed)
 	{
-		WrapMotorJoint* wrap = Unwrap(info.This());
-		info.GetReturnValue().Set(Nan::New(wrap->m_motor_joint->GetMaxTorque()));
+		WrapWheelJoint* wrap = Unwrap(info.This());
+		float32 speed = NANX_float32(info[0]);
+		Recorder* recorder = wrap->Recording();
+		if (recorder) { recorder->Op(e_recordSetMotorSpeed).Int(recorder->GetJointId(wrap->m_wheel_joint)).Float(speed); }
+		wrap->m_wheel_joint->SetMotorSpeed(speed);
 	}
-	NANX_METHOD(SetCorrectionFactor)
+	NANX_METHOD(GetMotorSpeed)
 	{
-		WrapMotorJoint* wrap = Unwrap(info.This());
-		wrap->m_motor_joint->SetCorrectionFactor(NANX_float32(info[0]));
+		WrapWheelJoint* wrap = Unwrap(info.This());
+		info.GetReturnValue().Set(Nan::New(wrap->m_wheel_joint->GetMotorSpeed()));
 	}
-	NANX_METHOD(GetCorrectionFactor)
+	NANX_METHOD(SetMaxMotorTorque)
 	{
-		WrapMotorJoint* wrap = Unwrap(info.This());
-		info.GetReturnValue().Set(Nan::New(wrap->m_motor_joint->GetCorrectionFactor()));
+		WrapWheelJoint* wrap = Unwrap(info.This());
+		wrap->m_wheel_joint->SetMaxMotorTorque(NANX_float32(info[0]));
+	}
+	NANX_METHOD(GetMaxMotorTorque)
+	{
+		WrapWheelJoint* wrap = Unwrap(info.This());
+		info.GetReturnValue().Set(Nan::New(wrap->m_wheel_joint->GetMaxMotorTorque()));
+	}
+	NANX_METHOD(GetMotorTorque)
+	{
+		WrapWheelJoint* wrap = Unwrap(info.This());
+		info.GetReturnValue().Set(Nan::New(wrap->m_wheel_joint->GetMotorTorque(NANX_float32(info[0]))));
+	}
+	NANX_METHOD(SetSpringFrequencyHz)
+	{
+		WrapWheelJoint* wrap = Unwrap(info.This());
+		wrap->m_wheel_joint->SetSpringFrequencyHz(NANX_float32(info[0]));
+	}
+	NANX_METHOD(GetSpringFrequencyHz)
+	{
+		WrapWheelJoint* wrap = Unwrap(info.This());
+		info.GetReturnValue().Set(Nan::New(wrap->m_wheel_joint->GetSpringFrequencyHz()));
+	}
+	NANX_METHOD(SetSpringDampingRatio)
+	{
+		WrapWheelJoint* wrap = Unwrap(info.This());
+		wrap->m_wheel_joint->SetSpringDampingRatio(NANX_float32(info[0]));
+	}
+	NANX_METHOD(GetSpringDampingRatio)
+	{
+		WrapWheelJoint* wrap = Unwrap(info.This());
+		info.GetReturnValue().Set(Nan::New(wrap->m_wheel_joint->GetSpringDampingRatio()));
 	}
 ///	void Dump();
 };
 
-//// b2ContactID
+//// b2WeldJointDef
 
-class WrapContactID : public Nan::ObjectWrap
+class WrapWeldJointDef : public WrapJointDef
 {
-public:
-	b2ContactID m_contact_id;
 private:
-	WrapContactID() {}
-	~WrapContactID() {}
+	b2WeldJointDef m_weld_jd;
+	Nan::Persistent<v8::Object> m_wrap_localAnchorA; // m_weld_jd.localAnchorA
+	Nan::Persistent<v8::Object> m_wrap_localAnchorB; // m_weld_jd.localAnchorB
+private:
+	WrapWeldJointDef()
+	{
+		m_wrap_localAnchorA.Reset(WrapVec2::NewInstance(m_weld_jd.localAnchorA));
+		m_wrap_localAnchorB.Reset(WrapVec2::NewInstance(m_weld_jd.localAnchorB));
+	}
+	~WrapWeldJointDef()
+	{
+		m_wrap_localAnchorA.Reset();
+		m_wrap_localAnchorB.Reset();
+	}
 public:
-	b2ContactID* Peek() { return &m_contact_id; }
+	b2WeldJointDef* Peek() { return &m_weld_jd; }
+	virtual b2JointDef& GetJointDef() { return m_weld_jd; } // override WrapJointDef
+	virtual void SyncPull() // override WrapJointDef
+	{
+		// sync: pull data from javascript objects
+		WrapJointDef::SyncPull();
+		m_weld_jd.localAnchorA = WrapVec2::Unwrap(Nan::New<v8::Object>(m_wrap_localAnchorA))->GetVec2(); // struct copy
+		m_weld_jd.localAnchorB = WrapVec2::Unwrap(Nan::New<v8::Object>(m_wrap_localAnchorB))->GetVec2(); // struct copy
+	}
+	virtual void SyncPush() // override WrapJointDef
+	{
+		// sync: push data into javascript objects
+		WrapJointDef::SyncPush();
+		WrapVec2::Unwrap(Nan::New<v8::Object>(m_wrap_localAnchorA))->SetVec2(m_weld_jd.localAnchorA);
+		WrapVec2::Unwrap(Nan::New<v8::Object>(m_wrap_localAnchorB))->SetVec2(m_weld_jd.localAnchorB);
+	}
 public:
-	static WrapContactID* Unwrap(v8::Local<v8::Value> value) { return (value->IsObject())?(Unwrap(v8::Local<v8::Object>::Cast(value))):(NULL); }
-	static WrapContactID* Unwrap(v8::Local<v8::Object> object) { return Nan::ObjectWrap::Unwrap<WrapContactID>(object); }
-	static b2ContactID* Peek(v8::Local<v8::Value> value) { WrapContactID* wrap = Unwrap(value); return (wrap)?(wrap->Peek()):(NULL); }
+	static WrapWeldJointDef* Unwrap(v8::Local<v8::Value> value) { return (value->IsObject())?(Unwrap(v8::Local<v8::Object>::Cast(value))):(NULL); }
+	static WrapWeldJointDef* Unwrap(v8::Local<v8::Object> object) { return Nan::ObjectWrap::Unwrap<WrapWeldJointDef>(object); }
+	static b2WeldJointDef* Peek(v8::Local<v8::Value> value) { WrapWeldJointDef* wrap = Unwrap(value); return (wrap)?(wrap->Peek()):(NULL); }
 public:
 	static NAN_MODULE_INIT(Init)
 	{
@@ -5638,22 +7604,25 @@ public:
 		{
 			v8::Local<v8::FunctionTemplate> function_template = Nan::New<v8::FunctionTemplate>(New);
 			g_function_template.Reset(function_template);
-			function_template->SetClassName(NANX_SYMBOL("b2ContactID"));
+			function_template->SetClassName(NANX_SYMBOL("b2WeldJointDef"));
+			function_template->Inherit(WrapJointDef::GetFunctionTemplate());
 			function_template->InstanceTemplate()->SetInternalFieldCount(1);
 			v8::Local<v8::ObjectTemplate> prototype_template = function_template->PrototypeTemplate();
-			//NANX_MEMBER_APPLY(prototype_template, cf) // TODO
-			NANX_MEMBER_APPLY(prototype_template, key)
+			NANX_MEMBER_APPLY(prototype_template, localAnchorA)
+			NANX_MEMBER_APPLY(prototype_template, localAnchorB)
+			NANX_MEMBER_APPLY(prototype_template, referenceAngle)
+			NANX_MEMBER_APPLY(prototype_template, frequencyHz)
+			NANX_MEMBER_APPLY(prototype_template, dampingRatio)
+			NANX_METHOD_APPLY(prototype_template, Initialize)
 		}
 		v8::Local<v8::FunctionTemplate> function_template = Nan::New<v8::FunctionTemplate>(g_function_template);
 		return scope.Escape(function_template);
 	}
-	static v8::Local<v8::Object> NewInstance(const b2ContactID& contact_id)
+	static v8::Local<v8::Object> NewInstance()
 	{
 		Nan::EscapableHandleScope scope;
 		v8::Local<v8::Function> constructor = GetConstructor();
 		v8::Local<v8::Object> instance = constructor->NewInstance();
-		WrapContactID* wrap = Unwrap(instance);
-		wrap->m_contact_id = contact_id;
 		return scope.Escape(instance);
 	}
 private:
@@ -5661,7 +7630,7 @@ private:
 	{
 		if (info.IsConstructCall())
 		{
-			WrapContactID* wrap = new WrapContactID();
+			WrapWeldJointDef* wrap = new WrapWeldJointDef();
 			wrap->Wrap(info.This());
 			info.GetReturnValue().Set(info.This());
 		}
@@ -5671,47 +7640,51 @@ private:
 			info.GetReturnValue().Set(constructor->NewInstance());
 		}
 	}
-	//NANX_MEMBER_OBJECT(cf) // TODO
-	NANX_MEMBER_UINT32(uint32, key)
+	NANX_MEMBER_OBJECT(localAnchorA) // m_wrap_localAnchorA
+	NANX_MEMBER_OBJECT(localAnchorB) // m_wrap_localAnchorB
+	NANX_MEMBER_NUMBER(float32, referenceAngle)
+	NANX_MEMBER_NUMBER(float32, frequencyHz)
+	NANX_MEMBER_NUMBER(float32, dampingRatio)
+	NANX_METHOD(Initialize)
+	{
+		WrapWeldJointDef* wrap = Unwrap(info.This());
+		WrapBody* wrap_bodyA = WrapBody::Unwrap(v8::Local<v8::Object>::Cast(info[0]));
+		WrapBody* wrap_bodyB = WrapBody::Unwrap(v8::Local<v8::Object>::Cast(info[1]));
+		WrapVec2* wrap_anchor = WrapVec2::Unwrap(v8::Local<v8::Object>::Cast(info[2]));
+		wrap->SyncPull();
+		wrap->m_weld_jd.Initialize(wrap_bodyA->Peek(), wrap_bodyB->Peek(), wrap_anchor->GetVec2());
+		wrap->SyncPush();
+	}
 };
 
-//// b2ManifoldPoint
+//// b2WeldJoint
 
-class WrapManifoldPoint : public Nan::ObjectWrap
+class WrapWeldJoint : public WrapJoint
 {
-public:
-	b2ManifoldPoint m_manifold_point;
-	Nan::Persistent<v8::Object> m_wrap_localPoint; // m_manifold_point.localPoint
-	Nan::Persistent<v8::Object> m_wrap_id; // m_manifold_point.id
 private:
-	WrapManifoldPoint()
+	b2WeldJoint* m_weld_joint;
+private:
+	WrapWeldJoint() : m_weld_joint(NULL) {}
+	~WrapWeldJoint() {}
+public:
+	b2WeldJoint* Peek() { return m_weld_joint; }
+	virtual b2Joint* GetJoint() { return m_weld_joint; } // override WrapJoint
+	void SetupObject(v8::Local<v8::Object> h_world, WrapWeldJointDef* wrap_weld_jd, b2WeldJoint* weld_joint)
 	{
-		m_wrap_localPoint.Reset(WrapVec2::NewInstance(m_manifold_point.localPoint));
-		m_wrap_id.Reset(WrapContactID::NewInstance(m_manifold_point.id));
-	}
-	~WrapManifoldPoint()
-	{
-		m_wrap_localPoint.Reset();
-		m_wrap_id.Reset();
-	}
-public:
-	b2ManifoldPoint* Peek() { return &m_manifold_point; }
-	void SyncPull()
-	{
-		// sync: pull data from javascript objects
-		m_manifold_point.localPoint = WrapVec2::Unwrap(Nan::New<v8::Object>(m_wrap_localPoint))->GetVec2(); // struct copy
-		m_manifold_point.id = WrapContactID::Unwrap(Nan::New<v8::Object>(m_wrap_id))->m_contact_id;
+		m_weld_joint = weld_joint;
+		WrapJoint::SetupObject(h_world, wrap_weld_jd);
 	}
-	void SyncPush()
+	b2WeldJoint* ResetObject()
 	{
-		// sync: push data into javascript objects
-		WrapVec2::Unwrap(Nan::New<v8::Object>(m_wrap_localPoint))->SetVec2(m_manifold_point.localPoint);
-		WrapContactID::Unwrap(Nan::New<v8::Object>(m_wrap_id))->m_contact_id = m_manifold_point.id;
+		WrapJoint::ResetObject();
+		b2WeldJoint* weld_joint = m_weld_joint;
+		m_weld_joint = NULL;
+		return weld_joint;
 	}
 public:
-	static WrapManifoldPoint* Unwrap(v8::Local<v8::Value> value) { return (value->IsObject())?(Unwrap(v8::Local<v8::Object>::Cast(value))):(NULL); }
-	static WrapManifoldPoint* Unwrap(v8::Local<v8::Object> object) { return Nan::ObjectWrap::Unwrap<WrapManifoldPoint>(object); }
-	static b2ManifoldPoint* Peek(v8::Local<v8::Value> value) { WrapManifoldPoint* wrap = Unwrap(value); return (wrap)?(wrap->Peek()):(NULL); }
+	static WrapWeldJoint* Unwrap(v8::Local<v8::Value> value) { return (value->IsObject())?(Unwrap(v8::Local<v8::Object>::Cast(value))):(NULL); }
+	static WrapWeldJoint* Unwrap(v8::Local<v8::Object> object) { return Nan::ObjectWrap::Unwrap<WrapWeldJoint>(object); }
+	static b2WeldJoint* Peek(v8::Local<v8::Value> value) { WrapWeldJoint* wrap = Unwrap(value); return (wrap)?(wrap->Peek()):(NULL); }
 public:
 	static NAN_MODULE_INIT(Init)
 	{
@@ -5733,25 +7706,26 @@ public:
 		{
 			v8::Local<v8::FunctionTemplate> function_template = Nan::New<v8::FunctionTemplate>(New);
 			g_function_template.Reset(function_template);
-			function_template->SetClassName(NANX_SYMBOL("b2ManifoldPoint"));
+			function_template->SetClassName(NANX_SYMBOL("b2WeldJoint"));
+			function_template->Inherit(WrapJoint::GetFunctionTemplate());
 			function_template->InstanceTemplate()->SetInternalFieldCount(1);
 			v8::Local<v8::ObjectTemplate> prototype_template = function_template->PrototypeTemplate();
-			NANX_MEMBER_APPLY(prototype_template, localPoint)
-			NANX_MEMBER_APPLY(prototype_template, normalImpulse)
-			NANX_MEMBER_APPLY(prototype_template, tangentImpulse)
-			NANX_MEMBER_APPLY(prototype_template, id)
+			NANX_METHOD_APPLY(prototype_template, GetLocalAnchorA)
+			NANX_METHOD_APPLY(prototype_template, GetLocalAnchorB)
+			NANX_METHOD_APPLY(prototype_template, GetReferenceAngle)
+			NANX_METHOD_APPLY(prototype_template, SetFrequency)
+			NANX_METHOD_APPLY(prototype_template, GetFrequency)
+			NANX_METHOD_APPLY(prototype_template, SetDampingRatio)
+			NANX_METHOD_APPLY(prototype_template, GetDampingRatio)
 		}
 		v8::Local<v8::FunctionTemplate> function_template = Nan::New<v8::FunctionTemplate>(g_function_template);
 		return scope.Escape(function_template);
 	}
-	static v8::Local<v8::Object> NewInstance(const b2ManifoldPoint& manifold_point)
+	static v8::Local<v8::Object> NewInstance()
 	{
 		Nan::EscapableHandleScope scope;
 		v8::Local<v8::Function> constructor = GetConstructor();
 		v8::Local<v8::Object> instance = constructor->NewInstance();
-		WrapManifoldPoint* wrap = Unwrap(instance);
-		wrap->m_manifold_point = manifold_point; // struct copy
-		wrap->SyncPush();
 		return scope.Escape(instance);
 	}
 private:
@@ -5759,7 +7733,7 @@ private:
 	{
 		if (info.IsConstructCall())
 		{
-			WrapManifoldPoint* wrap = new WrapManifoldPoint();
+			WrapWeldJoint* wrap = new WrapWeldJoint();
 			wrap->Wrap(info.This());
 			info.GetReturnValue().Set(info.This());
 		}
@@ -5769,71 +7743,92 @@ private:
 			info.GetReturnValue().Set(constructor->NewInstance());
 		}
 	}
-	NANX_MEMBER_OBJECT(localPoint) // m_wrap_localPoint
-	NANX_MEMBER_NUMBER(float32, normalImpulse)
-	NANX_MEMBER_NUMBER(float32, tangentImpulse)
-	NANX_MEMBER_OBJECT(id) // m_wrap_id
+///	b2Vec2 GetAnchorA() const;
+///	b2Vec2 GetAnchorB() const;
+///	b2Vec2 GetReactionForce(float32 inv_dt) const;
+///	float32 GetReactionTorque(float32 inv_dt) const;
+	NANX_METHOD(GetLocalAnchorA)
+	{
+		WrapWeldJoint* wrap = Unwrap(info.This());
+		v8::Local<v8::Object> out = info[0]->IsUndefined() ? WrapVec2::NewInstance() : v8::Local<v8::Object>::Cast(info[0]);
+		WrapVec2::Unwrap(out)->SetVec2(wrap->m_weld_joint->GetLocalAnchorA());
+		info.GetReturnValue().Set(out);
+	}
+	NANX_METHOD(GetLocalAnchorB)
+	{
+		WrapWeldJoint* wrap = Unwrap(info.This());
+		v8::Local<v8::Object> out = info[0]->IsUndefined() ? WrapVec2::NewInstance() : v8::Local<v8::Object>::Cast(info[0]);
+		WrapVec2::Unwrap(out)->SetVec2(wrap->m_weld_joint->GetLocalAnchorB());
+		info.GetReturnValue().Set(out);
+	}
+	NANX_METHOD(GetReferenceAngle)
+	{
+		WrapWeldJoint* wrap = Unwrap(info.This());
+		info.GetReturnValue().Set(Nan::New(wrap->m_weld_joint->GetReferenceAngle()));
+	}
+	NANX_METHOD(SetFrequency)
+	{
+		WrapWeldJoint* wrap = Unwrap(info.This());
+		wrap->m_weld_joint->SetFrequency(NANX_float32(info[0]));
+	}
+	NANX_METHOD(GetFrequency)
+	{
+		WrapWeldJoint* wrap = Unwrap(info.This());
+		info.GetReturnValue().Set(Nan::New(wrap->m_weld_joint->GetFrequency()));
+	}
+	NANX_METHOD(SetDampingRatio)
+	{
+		WrapWeldJoint* wrap = Unwrap(info.This());
+		wrap->m_weld_joint->SetDampingRatio(NANX_float32(info[0]));
+	}
+	NANX_METHOD(GetDampingRatio)
+	{
+		WrapWeldJoint* wrap = Unwrap(info.This());
+		info.GetReturnValue().Set(Nan::New(wrap->m_weld_joint->GetDampingRatio()));
+	}
+///	void Dump();
 };
 
-//// b2Manifold
+//// b2FrictionJointDef
 
-class WrapManifold : public Nan::ObjectWrap
+class WrapFrictionJointDef : public WrapJointDef
 {
-public:
-	b2Manifold m_manifold;
-	Nan::Persistent<v8::Array> m_wrap_points; // m_manifold.points
-	Nan::Persistent<v8::Object> m_wrap_localNormal; // m_manifold.localNormal
-	Nan::Persistent<v8::Object> m_wrap_localPoint; // m_manifold.localPoint
 private:
-	WrapManifold()
+	b2FrictionJointDef m_friction_jd;
+	Nan::Persistent<v8::Object> m_wrap_localAnchorA; // m_friction_jd.localAnchorA
+	Nan::Persistent<v8::Object> m_wrap_localAnchorB; // m_friction_jd.localAnchorB
+private:
+	WrapFrictionJointDef()
 	{
-		m_wrap_points.Reset(Nan::New<v8::Array>(b2_maxManifoldPoints));
-		m_wrap_localNormal.Reset(WrapVec2::NewInstance(m_manifold.localNormal));
-		m_wrap_localPoint.Reset(WrapVec2::NewInstance(m_manifold.localPoint));
-		v8::Local<v8::Array> manifold_points = Nan::New<v8::Array>(m_wrap_points);
-		for (uint32_t i = 0; i < manifold_points->Length(); ++i)
-		{
-			manifold_points->Set(i, WrapManifoldPoint::NewInstance(m_manifold.points[i]));
-		}
+		m_wrap_localAnchorA.Reset(WrapVec2::NewInstance(m_friction_jd.localAnchorA));
+		m_wrap_localAnchorB.Reset(WrapVec2::NewInstance(m_friction_jd.localAnchorB));
 	}
-	~WrapManifold()
+	~WrapFrictionJointDef()
 	{
-		m_wrap_points.Reset();
-		m_wrap_localNormal.Reset();
-		m_wrap_localPoint.Reset();
+		m_wrap_localAnchorA.Reset();
+		m_wrap_localAnchorB.Reset();
 	}
 public:
-	b2Manifold* Peek() { return &m_manifold; }
-	void SyncPull()
+	b2FrictionJointDef* Peek() { return &m_friction_jd; }
+	virtual b2JointDef& GetJointDef() { return m_friction_jd; } // override WrapJointDef
+	virtual void SyncPull() // override WrapJointDef
 	{
 		// sync: pull data from javascript objects
-		v8::Local<v8::Array> manifold_points = Nan::New<v8::Array>(m_wrap_points);
-		for (uint32_t i = 0; i < manifold_points->Length(); ++i)
-		{
-			WrapManifoldPoint* wrap_manifold_point = WrapManifoldPoint::Unwrap(v8::Local<v8::Object>::Cast(manifold_points->Get(i)));
-			m_manifold.points[i] = wrap_manifold_point->m_manifold_point; // struct copy
-			wrap_manifold_point->SyncPull();
-		}
-		m_manifold.localNormal = WrapVec2::Unwrap(Nan::New<v8::Object>(m_wrap_localNormal))->GetVec2(); // struct copy
-		m_manifold.localPoint = WrapVec2::Unwrap(Nan::New<v8::Object>(m_wrap_localPoint))->GetVec2(); // struct copy
+		WrapJointDef::SyncPull();
+		m_friction_jd.localAnchorA = WrapVec2::Unwrap(Nan::New<v8::Object>(m_wrap_localAnchorA))->GetVec2(); // struct copy
+		m_friction_jd.localAnchorB = WrapVec2::Unwrap(Nan::New<v8::Object>(m_wrap_localAnchorB))->GetVec2(); // struct copy
 	}
-	void SyncPush()
+	virtual void SyncPush() // override WrapJointDef
 	{
 		// sync: push data into javascript objects
-		v8::Local<v8::Array> manifold_points = Nan::New<v8::Array>(m_wrap_points);
-		for (uint32_t i = 0; i < manifold_points->Length(); ++i)
-		{
-			WrapManifoldPoint* wrap_manifold_point = WrapManifoldPoint::Unwrap(v8::Local<v8::Object>::Cast(manifold_points->Get(i)));
-			wrap_manifold_point->m_manifold_point = m_manifold.points[i]; // struct copy
-			wrap_manifold_point->SyncPush();
-		}
-		WrapVec2::Unwrap(Nan::New<v8::Object>(m_wrap_localNormal))->SetVec2(m_manifold.localNormal);
-		WrapVec2::Unwrap(Nan::New<v8::Object>(m_wrap_localPoint))->SetVec2(m_manifold.localPoint);
+		WrapJointDef::SyncPush();
+		WrapVec2::Unwrap(Nan::New<v8::Object>(m_wrap_localAnchorA))->SetVec2(m_friction_jd.localAnchorA);
+		WrapVec2::Unwrap(Nan::New<v8::Object>(m_wrap_localAnchorB))->SetVec2(m_friction_jd.localAnchorB);
 	}
 public:
-	static WrapManifold* Unwrap(v8::Local<v8::Value> value) { return (value->IsObject())?(Unwrap(v8::Local<v8::Object>::Cast(value))):(NULL); }
-	static WrapManifold* Unwrap(v8::Local<v8::Object> object) { return Nan::ObjectWrap::Unwrap<WrapManifold>(object); }
-	static b2Manifold* Peek(v8::Local<v8::Value> value) { WrapManifold* wrap = Unwrap(value); return (wrap)?(wrap->Peek()):(NULL); }
+	static WrapFrictionJointDef* Unwrap(v8::Local<v8::Value> value) { return (value->IsObject())?(Unwrap(v8::Local<v8::Object>::Cast(value))):(NULL); }
+	static WrapFrictionJointDef* Unwrap(v8::Local<v8::Object> object) { return Nan::ObjectWrap::Unwrap<WrapFrictionJointDef>(object); }
+	static b2FrictionJointDef* Peek(v8::Local<v8::Value> value) { WrapFrictionJointDef* wrap = Unwrap(value); return (wrap)?(wrap->Peek()):(NULL); }
 public:
 	static NAN_MODULE_INIT(Init)
 	{
@@ -5855,14 +7850,15 @@ public:
 		{
 			v8::Local<v8::FunctionTemplate> function_template = Nan::New<v8::FunctionTemplate>(New);
 			g_function_template.Reset(function_template);
-			function_template->SetClassName(NANX_SYMBOL("b2Manifold"));
+			function_template->SetClassName(NANX_SYMBOL("b2FrictionJointDef"));
+			function_template->Inherit(WrapJointDef::GetFunctionTemplate());
 			function_template->InstanceTemplate()->SetInternalFieldCount(1);
 			v8::Local<v8::ObjectTemplate> prototype_template = function_template->PrototypeTemplate();
-			NANX_MEMBER_APPLY(prototype_template, points)
-			NANX_MEMBER_APPLY(prototype_template, localNormal)
-			NANX_MEMBER_APPLY(prototype_template, localPoint)
-			NANX_MEMBER_APPLY(prototype_template, type)
-			NANX_MEMBER_APPLY(prototype_template, pointCount)
+			NANX_MEMBER_APPLY(prototype_template, localAnchorA)
+			NANX_MEMBER_APPLY(prototype_template, localAnchorB)
+			NANX_MEMBER_APPLY(prototype_template, maxForce)
+			NANX_MEMBER_APPLY(prototype_template, maxTorque)
+			NANX_METHOD_APPLY(prototype_template, Initialize)
 		}
 		v8::Local<v8::FunctionTemplate> function_template = Nan::New<v8::FunctionTemplate>(g_function_template);
 		return scope.Escape(function_template);
@@ -5872,17 +7868,6 @@ public:
 		Nan::EscapableHandleScope scope;
 		v8::Local<v8::Function> constructor = GetConstructor();
 		v8::Local<v8::Object> instance = constructor->NewInstance();
-		//wrap->SyncPush();
-		return scope.Escape(instance);
-	}
-	static v8::Local<v8::Object> NewInstance(const b2Manifold& manifold)
-	{
-		Nan::EscapableHandleScope scope;
-		v8::Local<v8::Function> constructor = GetConstructor();
-		v8::Local<v8::Object> instance = constructor->NewInstance();
-		WrapManifold* wrap = Unwrap(instance);
-		wrap->m_manifold = manifold; // struct copy
-		wrap->SyncPush();
 		return scope.Escape(instance);
 	}
 private:
@@ -5890,7 +7875,7 @@ private:
 	{
 		if (info.IsConstructCall())
 		{
-			WrapManifold* wrap = new WrapManifold();
+			WrapFrictionJointDef* wrap = new WrapFrictionJointDef();
 			wrap->Wrap(info.This());
 			info.GetReturnValue().Set(info.This());
 		}
@@ -5900,81 +7885,188 @@ private:
 			info.GetReturnValue().Set(constructor->NewInstance());
 		}
 	}
-	NANX_MEMBER_ARRAY(points) // m_wrap_points
-	NANX_MEMBER_OBJECT(localNormal) // m_wrap_localNormal
-	NANX_MEMBER_OBJECT(localPoint) // m_wrap_localPoint
-	NANX_MEMBER_INTEGER(b2Manifold::Type, type)
-	NANX_MEMBER_INTEGER(int32, pointCount)
+	NANX_MEMBER_OBJECT(localAnchorA) // m_wrap_localAnchorA
+	NANX_MEMBER_OBJECT(localAnchorB) // m_wrap_localAnchorB
+	NANX_MEMBER_NUMBER(float32, maxForce)
+	NANX_MEMBER_NUMBER(float32, maxTorque)
+	NANX_METHOD(Initialize)
+	{
+		WrapFrictionJointDef* wrap = Unwrap(info.This());
+		WrapBody* wrap_bodyA = WrapBody::Unwrap(v8::Local<v8::Object>::Cast(info[0]));
+		WrapBody* wrap_bodyB = WrapBody::Unwrap(v8::Local<v8::Object>::Cast(info[1]));
+		WrapVec2* wrap_anchor = WrapVec2::Unwrap(v8::Local<v8::Object>::Cast(info[2]));
+		wrap->SyncPull();
+		wrap->m_friction_jd.Initialize(wrap_bodyA->Peek(), wrap_bodyB->Peek(), wrap_anchor->GetVec2());
+		wrap->SyncPush();
+	}
 };
 
-//// b2WorldManifold
+//// b2FrictionJoint
 
-class WrapWorldManifold : public Nan::ObjectWrap
+class WrapFrictionJoint : public WrapJoint
 {
-public:
-	b2WorldManifold m_world_manifold;
-	Nan::Persistent<v8::Object> m_wrap_normal; // m_world_manifold.normal
-	Nan::Persistent<v8::Array> m_wrap_points; // m_world_manifold.points
-	Nan::Persistent<v8::Array> m_wrap_separations; // m_world_manifold.separations
 private:
-	WrapWorldManifold()
+	b2FrictionJoint* m_friction_joint;
+private:
+	WrapFrictionJoint() : m_friction_joint(NULL) {}
+	~WrapFrictionJoint() {}
+public:
+	b2FrictionJoint* Peek() { return m_friction_joint; }
+	virtual b2Joint* GetJoint() { return m_friction_joint; } // override WrapJoint
+	void SetupObject(v8::Local<v8::Object> h_world, WrapFrictionJointDef* wrap_friction_jd, b2FrictionJoint* friction_joint)
 	{
-		m_wrap_normal.Reset(WrapVec2::NewInstance(m_world_manifold.normal));
-		m_wrap_points.Reset(Nan::New<v8::Array>(b2_maxManifoldPoints));
-		m_wrap_separations.Reset(Nan::New<v8::Array>(b2_maxManifoldPoints));
-		v8::Local<v8::Array> world_manifold_points = Nan::New<v8::Array>(m_wrap_points);
-		for (uint32_t i = 0; i < world_manifold_points->Length(); ++i)
-		{
-			world_manifold_points->Set(i, WrapVec2::NewInstance(m_world_manifold.points[i]));
-		}
-		v8::Local<v8::Array> world_manifold_separations = Nan::New<v8::Array>(m_wrap_separations);
-		for (uint32_t i = 0; i < world_manifold_separations->Length(); ++i)
-		{
-			world_manifold_separations->Set(i, Nan::New(m_world_manifold.separations[i]));
-		}
+		m_friction_joint = friction_joint;
+		WrapJoint::SetupObject(h_world, wrap_friction_jd);
 	}
-	~WrapWorldManifold()
+	b2FrictionJoint* ResetObject()
 	{
-		m_wrap_normal.Reset();
-		m_wrap_points.Reset();
-		m_wrap_separations.Reset();
+		WrapJoint::ResetObject();
+		b2FrictionJoint* friction_joint = m_friction_joint;
+		m_friction_joint = NULL;
+		return friction_joint;
 	}
 public:
-	b2WorldManifold* Peek() { return &m_world_manifold; }
-	void SyncPull()
+	static WrapFrictionJoint* Unwrap(v8::Local<v8::Value> value) { return (value->IsObject())?(Unwrap(v8::Local<v8::Object>::Cast(value))):(NULL); }
+	static WrapFrictionJoint* Unwrap(v8::Local<v8::Object> object) { return Nan::ObjectWrap::Unwrap<WrapFrictionJoint>(object); }
+	static b2FrictionJoint* Peek(v8::Local<v8::Value> value) { WrapFrictionJoint* wrap = Unwrap(value); return (wrap)?(wrap->Peek()):(NULL); }
+public:
+	static NAN_MODULE_INIT(Init)
 	{
-		// sync: pull data from javascript objects
-		m_world_manifold.normal = WrapVec2::Unwrap(Nan::New<v8::Object>(m_wrap_normal))->GetVec2(); // struct copy
-		v8::Local<v8::Array> world_manifold_points = Nan::New<v8::Array>(m_wrap_points);
-		for (uint32_t i = 0; i < world_manifold_points->Length(); ++i)
-		{
-			m_world_manifold.points[i] = WrapVec2::Unwrap(v8::Local<v8::Object>::Cast(world_manifold_points->Get(i)))->GetVec2(); // struct copy
-		}
-		v8::Local<v8::Array> world_manifold_separations = Nan::New<v8::Array>(m_wrap_separations);
-		for (uint32_t i = 0; i < world_manifold_separations->Length(); ++i)
+		v8::Local<v8::Function> constructor = GetConstructor();
+		target->Set(constructor->GetName(), constructor);
+	}
+	static v8::Local<v8::Function> GetConstructor()
+	{
+		Nan::EscapableHandleScope scope;
+		v8::Local<v8::FunctionTemplate> function_template = GetFunctionTemplate();
+		v8::Local<v8::Function> constructor = function_template->GetFunction();
+		return scope.Escape(constructor);
+	}
+	static v8::Local<v8::FunctionTemplate> GetFunctionTemplate()
+	{
+		Nan::EscapableHandleScope scope;
+		static Nan::Persistent<v8::FunctionTemplate> g_function_template;
+		if (g_function_template.IsEmpty())
 		{
-			m_world_manifold.separations[i] = NANX_float32(world_manifold_separations->Get(i));
+			v8::Local<v8::FunctionTemplate> function_template = Nan::New<v8::FunctionTemplate>(New);
+			g_function_template.Reset(function_template);
+			function_template->SetClassName(NANX_SYMBOL("b2FrictionJoint"));
+			function_template->Inherit(WrapJoint::GetFunctionTemplate());
+			function_template->InstanceTemplate()->SetInternalFieldCount(1);
+			v8::Local<v8::ObjectTemplate> prototype_template = function_template->PrototypeTemplate();
+			NANX_METHOD_APPLY(prototype_template, GetLocalAnchorA)
+			NANX_METHOD_APPLY(prototype_template, GetLocalAnchorB)
+			NANX_METHOD_APPLY(prototype_template, SetMaxForce)
+			NANX_METHOD_APPLY(prototype_template, GetMaxForce)
+			NANX_METHOD_APPLY(prototype_template, SetMaxTorque)
+			NANX_METHOD_APPLY(prototype_template, GetMaxTorque)
 		}
+		v8::Local<v8::FunctionTemplate> function_template = Nan::New<v8::FunctionTemplate>(g_function_template);
+		return scope.Escape(function_template);
 	}
-	void SyncPush()
+	static v8::Local<v8::Object> NewInstance()
 	{
-		// sync: push data into javascript objects
-		WrapVec2::Unwrap(Nan::New<v8::Object>(m_wrap_normal))->SetVec2(m_world_manifold.normal);
-		v8::Local<v8::Array> world_manifold_points = Nan::New<v8::Array>(m_wrap_points);
-		for (uint32_t i = 0; i < world_manifold_points->Length(); ++i)
+		Nan::EscapableHandleScope scope;
+		v8::Local<v8::Function> constructor = GetConstructor();
+		v8::Local<v8::Object> instance = constructor->NewInstance();
+		return scope.Escape(instance);
+	}
+private:
+	static NAN_METHOD(New)
+	{
+		if (info.IsConstructCall())
 		{
-			WrapVec2::Unwrap(v8::Local<v8::Object>::Cast(world_manifold_points->Get(i)))->SetVec2(m_world_manifold.points[i]);
+			WrapFrictionJoint* wrap = new WrapFrictionJoint();
+			wrap->Wrap(info.This());
+			info.GetReturnValue().Set(info.This());
 		}
-		v8::Local<v8::Array> world_manifold_separations = Nan::New<v8::Array>(m_wrap_separations);
-		for (uint32_t i = 0; i < world_manifold_separations->Length(); ++i)
+		else
 		{
-			world_manifold_separations->Set(i, Nan::New(m_world_manifold.separations[i]));
+			v8::Local<v8::Function> constructor = GetConstructor();
+			info.GetReturnValue().Set(constructor->NewInstance());
 		}
 	}
+///	b2Vec2 GetAnchorA() const;
+///	b2Vec2 GetAnchorB() const;
+///	b2Vec2 GetReactionForce(float32 inv_dt) const;
+///	float32 GetReactionTorque(float32 inv_dt) const;
+	NANX_METHOD(GetLocalAnchorA)
+	{
+		WrapFrictionJoint* wrap = Unwrap(info.This());
+		v8::Local<v8::Object> out = info[0]->IsUndefined() ? WrapVec2::NewInstance() : v8::Local<v8::Object>::Cast(info[0]);
+		WrapVec2::Unwrap(out)->SetVec2(wrap->m_friction_joint->GetLocalAnchorA());
+		info.GetReturnValue().Set(out);
+	}
+	NANX_METHOD(GetLocalAnchorB)
+	{
+		WrapFrictionJoint* wrap = Unwrap(info.This());
+		v8::Local<v8::Object> out = info[0]->IsUndefined() ? WrapVec2::NewInstance() : v8::Local<v8::Object>::Cast(info[0]);
+		WrapVec2::Unwrap(out)->SetVec2(wrap->m_friction_joint->GetLocalAnchorB());
+		info.GetReturnValue().Set(out);
+	}
+	NANX_METHOD(SetMaxForce)
+	{
+		WrapFrictionJoint* wrap = Unwrap(info.This());
+		wrap->m_friction_joint->SetMaxForce(NANX_float32(info[0]));
+	}
+	NANX_METHOD(GetMaxForce)
+	{
+		WrapFrictionJoint* wrap = Unwrap(info.This());
+		info.GetReturnValue().Set(Nan::New(wrap->m_friction_joint->GetMaxForce()));
+	}
+	NANX_METHOD(SetMaxTorque)
+	{
+		WrapFrictionJoint* wrap = Unwrap(info.This());
+		wrap->m_friction_joint->SetMaxTorque(NANX_float32(info[0]));
+	}
+	NANX_METHOD(GetMaxTorque)
+	{
+		WrapFrictionJoint* wrap = Unwrap(info.This());
+		info.GetReturnValue().Set(Nan::New(wrap->m_friction_joint->GetMaxTorque()));
+	}
+///	void Dump();
+};
+
+//// b2RopeJointDef
+
+class WrapRopeJointDef : public WrapJointDef
+{
+private:
+	b2RopeJointDef m_rope_jd;
+	Nan::Persistent<v8::Object> m_wrap_localAnchorA; // m_rope_jd.localAnchorA
+	Nan::Persistent<v8::Object> m_wrap_localAnchorB; // m_rope_jd.localAnchorB
+private:
+	WrapRopeJointDef()
+	{
+		m_wrap_localAnchorA.Reset(WrapVec2::NewInstance(m_rope_jd.localAnchorA));
+		m_wrap_localAnchorB.Reset(WrapVec2::NewInstance(m_rope_jd.localAnchorB));
+	}
+	~WrapRopeJointDef()
+	{
+		m_wrap_localAnchorA.Reset();
+		m_wrap_localAnchorB.Reset();
+	}
 public:
-	static WrapWorldManifold* Unwrap(v8::Local<v8::Value> value) { return (value->IsObject())?(Unwrap(v8::Local<v8::Object>::Cast(value))):(NULL); }
-	static WrapWorldManifold* Unwrap(v8::Local<v8::Object> object) { return Nan::ObjectWrap::Unwrap<WrapWorldManifold>(object); }
-	static b2WorldManifold* Peek(v8::Local<v8::Value> value) { WrapWorldManifold* wrap = Unwrap(value); return (wrap)?(wrap->Peek()):(NULL); }
+	b2RopeJointDef* Peek() { return &m_rope_jd; }
+	virtual b2JointDef& GetJointDef() { return m_rope_jd; } // override WrapJointDef
+	virtual void SyncPull() // override WrapJointDef
+	{
+		// sync: pull data from javascript objects
+		WrapJointDef::SyncPull();
+		m_rope_jd.localAnchorA = WrapVec2::Unwrap(Nan::New<v8::Object>(m_wrap_localAnchorA))->GetVec2(); // struct copy
+		m_rope_jd.localAnchorB = WrapVec2::Unwrap(Nan::New<v8::Object>(m_wrap_localAnchorB))->GetVec2(); // struct copy
+	}
+	virtual void SyncPush() // override WrapJointDef
+	{
+		// sync: push data into javascript objects
+		WrapJointDef::SyncPush();
+		WrapVec2::Unwrap(Nan::New<v8::Object>(m_wrap_localAnchorA))->SetVec2(m_rope_jd.localAnchorA);
+		WrapVec2::Unwrap(Nan::New<v8::Object>(m_wrap_localAnchorB))->SetVec2(m_rope_jd.localAnchorB);
+	}
+public:
+	static WrapRopeJointDef* Unwrap(v8::Local<v8::Value> value) { return (value->IsObject())?(Unwrap(v8::Local<v8::Object>::Cast(value))):(NULL); }
+	static WrapRopeJointDef* Unwrap(v8::Local<v8::Object> object) { return Nan::ObjectWrap::Unwrap<WrapRopeJointDef>(object); }
+	static b2RopeJointDef* Peek(v8::Local<v8::Value> value) { WrapRopeJointDef* wrap = Unwrap(value); return (wrap)?(wrap->Peek()):(NULL); }
 public:
 	static NAN_MODULE_INIT(Init)
 	{
@@ -5996,12 +8088,13 @@ public:
 		{
 			v8::Local<v8::FunctionTemplate> function_template = Nan::New<v8::FunctionTemplate>(New);
 			g_function_template.Reset(function_template);
-			function_template->SetClassName(NANX_SYMBOL("b2WorldManifold"));
+			function_template->SetClassName(NANX_SYMBOL("b2RopeJointDef"));
+			function_template->Inherit(WrapJointDef::GetFunctionTemplate());
 			function_template->InstanceTemplate()->SetInternalFieldCount(1);
 			v8::Local<v8::ObjectTemplate> prototype_template = function_template->PrototypeTemplate();
-			NANX_MEMBER_APPLY(prototype_template, normal)
-			NANX_MEMBER_APPLY(prototype_template, points)
-			NANX_MEMBER_APPLY(prototype_template, separations)
+			NANX_MEMBER_APPLY(prototype_template, localAnchorA)
+			NANX_MEMBER_APPLY(prototype_template, localAnchorB)
+			NANX_MEMBER_APPLY(prototype_template, maxLength)
 		}
 		v8::Local<v8::FunctionTemplate> function_template = Nan::New<v8::FunctionTemplate>(g_function_template);
 		return scope.Escape(function_template);
@@ -6011,17 +8104,6 @@ public:
 		Nan::EscapableHandleScope scope;
 		v8::Local<v8::Function> constructor = GetConstructor();
 		v8::Local<v8::Object> instance = constructor->NewInstance();
-		//wrap->SyncPush();
-		return scope.Escape(instance);
-	}
-	static v8::Local<v8::Object> NewInstance(const b2WorldManifold& world_manifold)
-	{
-		Nan::EscapableHandleScope scope;
-		v8::Local<v8::Function> constructor = GetConstructor();
-		v8::Local<v8::Object> instance = constructor->NewInstance();
-		WrapWorldManifold* wrap = Unwrap(instance);
-		wrap->m_world_manifold = world_manifold; // struct copy
-		wrap->SyncPush();
 		return scope.Escape(instance);
 	}
 private:
@@ -6029,7 +8111,7 @@ private:
 	{
 		if (info.IsConstructCall())
 		{
-			WrapWorldManifold* wrap = new WrapWorldManifold();
+			WrapRopeJointDef* wrap = new WrapRopeJointDef();
 			wrap->Wrap(info.This());
 			info.GetReturnValue().Set(info.This());
 		}
@@ -6039,26 +8121,39 @@ private:
 			info.GetReturnValue().Set(constructor->NewInstance());
 		}
 	}
-	NANX_MEMBER_OBJECT(normal) // m_wrap_normal
-	NANX_MEMBER_ARRAY(points) // m_wrap_points
-	NANX_MEMBER_ARRAY(separations) // m_wrap_separations
+	NANX_MEMBER_OBJECT(localAnchorA) // m_wrap_localAnchorA
+	NANX_MEMBER_OBJECT(localAnchorB) // m_wrap_localAnchorB
+	NANX_MEMBER_NUMBER(float32, maxLength)
 };
 
-//// b2Contact
+//// b2RopeJoint
 
-class WrapContact : public Nan::ObjectWrap
+class WrapRopeJoint : public WrapJoint
 {
-public:
-	b2Contact* m_contact;
 private:
-	WrapContact() : m_contact(NULL) {}
-	~WrapContact() { m_contact = NULL; }
+	b2RopeJoint* m_rope_joint;
+private:
+	WrapRopeJoint() : m_rope_joint(NULL) {}
+	~WrapRopeJoint() {}
 public:
-	b2Contact* Peek() { return m_contact; }
+	b2RopeJoint* Peek() { return m_rope_joint; }
+	virtual b2Joint* GetJoint() { return m_rope_joint; } // override WrapJoint
+	void SetupObject(v8::Local<v8::Object> h_world, WrapRopeJointDef* wrap_rope_jd, b2RopeJoint* rope_joint)
+	{
+		m_rope_joint = rope_joint;
+		WrapJoint::SetupObject(h_world, wrap_rope_jd);
+	}
+	b2RopeJoint* ResetObject()
+	{
+		WrapJoint::ResetObject();
+		b2RopeJoint* rope_joint = m_rope_joint;
+		m_rope_joint = NULL;
+		return rope_joint;
+	}
 public:
-	static WrapContact* Unwrap(v8::Local<v8::Value> value) { return (value->IsObject())?(Unwrap(v8::Local<v8::Object>::Cast(value))):(NULL); }
-	static WrapContact* Unwrap(v8::Local<v8::Object> object) { return Nan::ObjectWrap::Unwrap<WrapContact>(object); }
-	static b2Contact* Peek(v8::Local<v8::Value> value) { WrapContact* wrap = Unwrap(value); return (wrap)?(wrap->Peek()):(NULL); }
+	static WrapRopeJoint* Unwrap(v8::Local<v8::Value> value) { return (value->IsObject())?(Unwrap(v8::Local<v8::Object>::Cast(value))):(NULL); }
+	static WrapRopeJoint* Unwrap(v8::Local<v8::Object> object) { return Nan::ObjectWrap::Unwrap<WrapRopeJoint>(object); }
+	static b2RopeJoint* Peek(v8::Local<v8::Value> value) { WrapRopeJoint* wrap = Unwrap(value); return (wrap)?(wrap->Peek()):(NULL); }
 public:
 	static NAN_MODULE_INIT(Init)
 	{
@@ -6080,27 +8175,15 @@ public:
 		{
 			v8::Local<v8::FunctionTemplate> function_template = Nan::New<v8::FunctionTemplate>(New);
 			g_function_template.Reset(function_template);
-			function_template->SetClassName(NANX_SYMBOL("b2Contact"));
+			function_template->SetClassName(NANX_SYMBOL("b2RopeJoint"));
+			function_template->Inherit(WrapJoint::GetFunctionTemplate());
 			function_template->InstanceTemplate()->SetInternalFieldCount(1);
 			v8::Local<v8::ObjectTemplate> prototype_template = function_template->PrototypeTemplate();
-			NANX_METHOD_APPLY(prototype_template, GetManifold)
-			NANX_METHOD_APPLY(prototype_template, GetWorldManifold)
-			NANX_METHOD_APPLY(prototype_template, IsTouching)
-			NANX_METHOD_APPLY(prototype_template, SetEnabled)
-			NANX_METHOD_APPLY(prototype_template, IsEnabled)
-			NANX_METHOD_APPLY(prototype_template, GetNext)
-			NANX_METHOD_APPLY(prototype_template, GetFixtureA)
-			NANX_METHOD_APPLY(prototype_template, GetChildIndexA)
-			NANX_METHOD_APPLY(prototype_template, GetFixtureB)
-			NANX_METHOD_APPLY(prototype_template, GetChildIndexB)
-			NANX_METHOD_APPLY(prototype_template, SetFriction)
-			NANX_METHOD_APPLY(prototype_template, GetFriction)
-			NANX_METHOD_APPLY(prototype_template, ResetFriction)
-			NANX_METHOD_APPLY(prototype_template, SetRestitution)
-			NANX_METHOD_APPLY(prototype_template, GetRestitution)
-			NANX_METHOD_APPLY(prototype_template, ResetRestitution)
-			NANX_METHOD_APPLY(prototype_template, SetTangentSpeed)
-			NANX_METHOD_APPLY(prototype_template, GetTangentSpeed)
+			NANX_METHOD_APPLY(prototype_template, GetLocalAnchorA)
+			NANX_METHOD_APPLY(prototype_template, GetLocalAnchorB)
+			NANX_METHOD_APPLY(prototype_template, SetMaxLength)
+			NANX_METHOD_APPLY(prototype_template, GetMaxLength)
+			NANX_METHOD_APPLY(prototype_template, GetLimitState)
 		}
 		v8::Local<v8::FunctionTemplate> function_template = Nan::New<v8::FunctionTemplate>(g_function_template);
 		return scope.Escape(function_template);
@@ -6112,21 +8195,12 @@ public:
 		v8::Local<v8::Object> instance = constructor->NewInstance();
 		return scope.Escape(instance);
 	}
-	static v8::Local<v8::Object> NewInstance(b2Contact* contact)
-	{
-		Nan::EscapableHandleScope scope;
-		v8::Local<v8::Function> constructor = GetConstructor();
-		v8::Local<v8::Object> instance = constructor->NewInstance();
-		WrapContact* wrap = Unwrap(instance);
-		wrap->m_contact = contact; // struct copy
-		return scope.Escape(instance);
-	}
 private:
 	static NAN_METHOD(New)
 	{
 		if (info.IsConstructCall())
 		{
-			WrapContact* wrap = new WrapContact();
+			WrapRopeJoint* wrap = new WrapRopeJoint();
 			wrap->Wrap(info.This());
 			info.GetReturnValue().Set(info.This());
 		}
@@ -6136,137 +8210,77 @@ private:
 			info.GetReturnValue().Set(constructor->NewInstance());
 		}
 	}
-	NANX_METHOD(GetManifold)
+///	b2Vec2 GetAnchorA() const;
+///	b2Vec2 GetAnchorB() const;
+///	b2Vec2 GetReactionForce(float32 inv_dt) const;
+///	float32 GetReactionTorque(float32 inv_dt) const;
+	NANX_METHOD(GetLocalAnchorA)
 	{
-		WrapContact* wrap = Unwrap(info.This());
-		const b2Manifold* manifold = wrap->m_contact->GetManifold();
-		info.GetReturnValue().Set(WrapManifold::NewInstance(*manifold));
-	}
-	NANX_METHOD(GetWorldManifold)
-	{
-		WrapContact* wrap = Unwrap(info.This());
-		WrapWorldManifold* wrap_world_manifold = WrapWorldManifold::Unwrap(v8::Local<v8::Object>::Cast(info[0]));
-		wrap->m_contact->GetWorldManifold(&wrap_world_manifold->m_world_manifold);
-		wrap_world_manifold->SyncPush();
-	}
-	NANX_METHOD(IsTouching)
-	{
-		WrapContact* wrap = Unwrap(info.This());
-		info.GetReturnValue().Set(Nan::New(wrap->m_contact->IsTouching()));
-	}
-	NANX_METHOD(SetEnabled)
-	{
-		WrapContact* wrap = Unwrap(info.This());
-		wrap->m_contact->SetEnabled(NANX_bool(info[0]));
-	}
-	NANX_METHOD(IsEnabled)
-	{
-		WrapContact* wrap = Unwrap(info.This());
-		info.GetReturnValue().Set(Nan::New(wrap->m_contact->IsEnabled()));
-	}
-	NANX_METHOD(GetNext)
-	{
-		WrapContact* wrap = Unwrap(info.This());
-		b2Contact* contact = wrap->m_contact->GetNext();
-		if (contact)
-		{
-			info.GetReturnValue().Set(WrapContact::NewInstance(contact));
-		}
-		else
-		{
-			info.GetReturnValue().SetNull();
-		}
+		WrapRopeJoint* wrap = Unwrap(info.This());
+		v8::Local<v8::Object> out = info[0]->IsUndefined() ? WrapVec2::NewInstance() : v8::Local<v8::Object>::Cast(info[0]);
+		WrapVec2::Unwrap(out)->SetVec2(wrap->m_rope_joint->GetLocalAnchorA());
+		info.GetReturnValue().Set(out);
 	}
-	NANX_METHOD(GetFixtureA)
+	NANX_METHOD(GetLocalAnchorB)
 	{
-		WrapContact* wrap = Unwrap(info.This());
-		b2Fixture* fixture = wrap->m_contact->GetFixtureA();
-		// get fixture internal data
-		WrapFixture* wrap_fixture = WrapFixture::GetWrap(fixture);
-		info.GetReturnValue().Set(wrap_fixture->handle());
+		WrapRopeJoint* wrap = Unwrap(info.This());
+		v8::Local<v8::Object> out = info[0]->IsUndefined() ? WrapVec2::NewInstance() : v8::Local<v8::Object>::Cast(info[0]);
+		WrapVec2::Unwrap(out)->SetVec2(wrap->m_rope_joint->GetLocalAnchorB());
+		info.GetReturnValue().Set(out);
 	}
-	NANX_METHOD(GetChildIndexA)
+	NANX_METHOD(SetMaxLength)
 	{
-		WrapContact* wrap = Unwrap(info.This());
-		info.GetReturnValue().Set(Nan::New(wrap->m_contact->GetChildIndexA()));
+		WrapRopeJoint* wrap = Unwrap(info.This());
+		wrap->m_rope_joint->SetMaxLength(NANX_float32(info[0]));
 	}
-	NANX_METHOD(GetFixtureB)
+	NANX_METHOD(GetMaxLength)
 	{
-		WrapContact* wrap = Unwrap(info.This());
-		b2Fixture* fixture = wrap->m_contact->GetFixtureB();
-		// get fixture internal data
-		WrapFixture* wrap_fixture = WrapFixture::GetWrap(fixture);
-		info.GetReturnValue().Set(wrap_fixture->handle());
+		WrapRopeJoint* wrap = Unwrap(info.This());
+		info.GetReturnValue().Set(Nan::New(wrap->m_rope_joint->GetMaxLength()));
 	}
-	NANX_METHOD(GetChildIndexB)
+	NANX_METHOD(GetLimitState)
 	{
-		WrapContact* wrap = Unwrap(info.This());
-		info.GetReturnValue().Set(Nan::New(wrap->m_contact->GetChildIndexB()));
+		WrapRopeJoint* wrap = Unwrap(info.This());
+		info.GetReturnValue().Set(Nan::New(wrap->m_rope_joint->GetLimitState()));
 	}
-	NANX_METHOD(SetFriction) { WrapContact* wrap = Unwrap(info.This()); wrap->m_contact->SetFriction(NANX_float32(info[0])); }
-	NANX_METHOD(GetFriction) { WrapContact* wrap = Unwrap(info.This()); info.GetReturnValue().Set(Nan::New(wrap->m_contact->GetFriction())); }
-	NANX_METHOD(ResetFriction) { WrapContact* wrap = Unwrap(info.This()); wrap->m_contact->ResetFriction(); }
-	NANX_METHOD(SetRestitution) { WrapContact* wrap = Unwrap(info.This()); wrap->m_contact->SetRestitution(NANX_float32(info[0])); }
-	NANX_METHOD(GetRestitution) { WrapContact* wrap = Unwrap(info.This()); info.GetReturnValue().Set(Nan::New(wrap->m_contact->GetRestitution())); }
-	NANX_METHOD(ResetRestitution) { WrapContact* wrap = Unwrap(info.This()); wrap->m_contact->ResetRestitution(); }
-	NANX_METHOD(SetTangentSpeed) { WrapContact* wrap = Unwrap(info.This()); wrap->m_contact->SetTangentSpeed(NANX_float32(info[0])); }
-	NANX_METHOD(GetTangentSpeed) { WrapContact* wrap = Unwrap(info.This()); info.GetReturnValue().Set(Nan::New(wrap->m_contact->GetTangentSpeed())); }
-//	virtual void Evaluate(b2Manifold* manifold, const b2Transform& xfA, const b2Transform& xfB) = 0;
+///	void Dump();
 };
 
-//// b2ContactImpulse
+//// b2MotorJointDef
 
-class WrapContactImpulse : public Nan::ObjectWrap
+class WrapMotorJointDef : public WrapJointDef
 {
-public:
-	b2ContactImpulse m_contact_impulse;
-	Nan::Persistent<v8::Array> m_wrap_normalImpulses; // m_contact_impulse.normalImpulses
-	Nan::Persistent<v8::Array> m_wrap_tangentImpulses; // m_contact_impulse.tangentImpulses
 private:
-	WrapContactImpulse()
+	b2MotorJointDef m_motor_jd;
+	Nan::Persistent<v8::Object> m_wrap_linearOffset; // m_motor_jd.linearOffset
+private:
+	WrapMotorJointDef()
 	{
-		m_wrap_normalImpulses.Reset(Nan::New<v8::Array>(b2_maxManifoldPoints));
-		m_wrap_tangentImpulses.Reset(Nan::New<v8::Array>(b2_maxManifoldPoints));
+		m_wrap_linearOffset.Reset(WrapVec2::NewInstance(m_motor_jd.linearOffset));
 	}
-	~WrapContactImpulse()
+	~WrapMotorJointDef()
 	{
-		m_wrap_normalImpulses.Reset();
-		m_wrap_tangentImpulses.Reset();
+		m_wrap_linearOffset.Reset();
 	}
 public:
-	b2ContactImpulse* Peek() { return &m_contact_impulse; }
-	void SyncPull()
+	b2MotorJointDef* Peek() { return &m_motor_jd; }
+	virtual b2JointDef& GetJointDef() { return m_motor_jd; } // override WrapJointDef
+	virtual void SyncPull() // override WrapJointDef
 	{
 		// sync: pull data from javascript objects
-		v8::Local<v8::Array> contact_impulse_normalImpulses = Nan::New<v8::Array>(m_wrap_normalImpulses);
-		for (uint32_t i = 0; i < contact_impulse_normalImpulses->Length(); ++i)
-		{
-			m_contact_impulse.normalImpulses[i] = NANX_float32(contact_impulse_normalImpulses->Get(i));
-		}
-		v8::Local<v8::Array> contact_impulse_tangentImpulses = Nan::New<v8::Array>(m_wrap_tangentImpulses);
-		for (uint32_t i = 0; i < contact_impulse_tangentImpulses->Length(); ++i)
-		{
-			m_contact_impulse.tangentImpulses[i] = NANX_float32(contact_impulse_tangentImpulses->Get(i));
-		}
+		WrapJointDef::SyncPull();
+		m_motor_jd.linearOffset = WrapVec2::Unwrap(Nan::New<v8::Object>(m_wrap_linearOffset))->GetVec2(); // struct copy
 	}
-	void SyncPush()
+	virtual void SyncPush() // override WrapJointDef
 	{
 		// sync: push data into javascript objects
-		v8::Local<v8::Array> contact_impulse_normalImpulses = Nan::New<v8::Array>(m_wrap_normalImpulses);
-		for (uint32_t i = 0; i < contact_impulse_normalImpulses->Length(); ++i)
-		{
-			contact_impulse_normalImpulses->Set(i, Nan::New(m_contact_impulse.normalImpulses[i]));
-		}
-		v8::Local<v8::Array> contact_impulse_tangentImpulses = Nan::New<v8::Array>(m_wrap_tangentImpulses);
-		for (uint32_t i = 0; i < contact_impulse_tangentImpulses->Length(); ++i)
-		{
-			contact_impulse_tangentImpulses->Set(i, Nan::New(m_contact_impulse.tangentImpulses[i]));
-		}
+		WrapJointDef::SyncPush();
+		WrapVec2::Unwrap(Nan::New<v8::Object>(m_wrap_linearOffset))->SetVec2(m_motor_jd.linearOffset);
 	}
 public:
-	static WrapContactImpulse* Unwrap(v8::Local<v8::Value> value) { return (value->IsObject())?(Unwrap(v8::Local<v8::Object>::Cast(value))):(NULL); }
-	static WrapContactImpulse* Unwrap(v8::Local<v8::Object> object) { return Nan::ObjectWrap::Unwrap<WrapContactImpulse>(object); }
-	static b2ContactImpulse* Peek(v8::Local<v8::Value> value) { WrapContactImpulse* wrap = Unwrap(value); return (wrap)?(wrap->Peek()):(NULL); }
+	static WrapMotorJointDef* Unwrap(v8::Local<v8::Value> value) { return (value->IsObject())?(Unwrap(v8::Local<v8::Object>::Cast(value))):(NULL); }
+	static WrapMotorJointDef* Unwrap(v8::Local<v8::Object> object) { return Nan::ObjectWrap::Unwrap<WrapMotorJointDef>(object); }
+	static b2MotorJointDef* Peek(v8::Local<v8::Value> value) { WrapMotorJointDef* wrap = Unwrap(value); return (wrap)?(wrap->Peek()):(NULL); }
 public:
 	static NAN_MODULE_INIT(Init)
 	{
@@ -6288,12 +8302,16 @@ public:
 		{
 			v8::Local<v8::FunctionTemplate> function_template = Nan::New<v8::FunctionTemplate>(New);
 			g_function_template.Reset(function_template);
-			function_template->SetClassName(NANX_SYMBOL("b2ContactImpulse"));
+			function_template->SetClassName(NANX_SYMBOL("b2MotorJointDef"));
+			function_template->Inherit(WrapJointDef::GetFunctionTemplate());
 			function_template->InstanceTemplate()->SetInternalFieldCount(1);
 			v8::Local<v8::ObjectTemplate> prototype_template = function_template->PrototypeTemplate();
-			NANX_MEMBER_APPLY(prototype_template, normalImpulses)
-			NANX_MEMBER_APPLY(prototype_template, tangentImpulses)
-			NANX_MEMBER_APPLY(prototype_template, count)
+			NANX_MEMBER_APPLY(prototype_template, linearOffset)
+			NANX_MEMBER_APPLY(prototype_template, angularOffset)
+			NANX_MEMBER_APPLY(prototype_template, maxForce)
+			NANX_MEMBER_APPLY(prototype_template, maxTorque)
+			NANX_MEMBER_APPLY(prototype_template, correctionFactor)
+			NANX_METHOD_APPLY(prototype_template, Initialize)
 		}
 		v8::Local<v8::FunctionTemplate> function_template = Nan::New<v8::FunctionTemplate>(g_function_template);
 		return scope.Escape(function_template);
@@ -6303,17 +8321,6 @@ public:
 		Nan::EscapableHandleScope scope;
 		v8::Local<v8::Function> constructor = GetConstructor();
 		v8::Local<v8::Object> instance = constructor->NewInstance();
-		//wrap->SyncPush();
-		return scope.Escape(instance);
-	}
-	static v8::Local<v8::Object> NewInstance(const b2ContactImpulse& contact_impulse)
-	{
-		Nan::EscapableHandleScope scope;
-		v8::Local<v8::Function> constructor = GetConstructor();
-		v8::Local<v8::Object> instance = constructor->NewInstance();
-		WrapContactImpulse* wrap = Unwrap(instance);
-		wrap->m_contact_impulse = contact_impulse; // struct copy
-		wrap->SyncPush();
 		return scope.Escape(instance);
 	}
 private:
@@ -6321,7 +8328,7 @@ private:
 	{
 		if (info.IsConstructCall())
 		{
-			WrapContactImpulse* wrap = new WrapContactImpulse();
+			WrapMotorJointDef* wrap = new WrapMotorJointDef();
 			wrap->Wrap(info.This());
 			info.GetReturnValue().Set(info.This());
 		}
@@ -6331,29 +8338,50 @@ private:
 			info.GetReturnValue().Set(constructor->NewInstance());
 		}
 	}
-	NANX_MEMBER_ARRAY(normalImpulses) // m_wrap_normalImpulses
-	NANX_MEMBER_ARRAY(tangentImpulses) // m_wrap_tangentImpulses
-	NANX_MEMBER_INTEGER(int32, count)
+	NANX_MEMBER_OBJECT(linearOffset) // m_wrap_linearOffset
+	NANX_MEMBER_NUMBER(float32, angularOffset)
+	NANX_MEMBER_NUMBER(float32, maxForce)
+	NANX_MEMBER_NUMBER(float32, maxTorque)
+	NANX_MEMBER_NUMBER(float32, correctionFactor)
+	NANX_METHOD(Initialize)
+	{
+		WrapMotorJointDef* wrap = Unwrap(info.This());
+		WrapBody* wrap_bodyA = WrapBody::Unwrap(v8::Local<v8::Object>::Cast(info[0]));
+		WrapBody* wrap_bodyB = WrapBody::Unwrap(v8::Local<v8::Object>::Cast(info[1]));
+		wrap->SyncPull();
+		wrap->m_motor_jd.Initialize(wrap_bodyA->Peek(), wrap_bodyB->Peek());
+		wrap->SyncPush();
+	}
 };
 
-//// b2Color
+//// b2MotorJoint
 
-class WrapColor : public Nan::ObjectWrap
+class WrapMotorJoint : public WrapJoint
 {
 private:
-	b2Color m_color;
+	b2MotorJoint* m_motor_joint;
 private:
-	WrapColor() {}
-	WrapColor(float32 r, float32 g, float32 b, float32 a) : m_color(r, g, b, a) {}
-	~WrapColor() {}
+	WrapMotorJoint() : m_motor_joint(NULL) {}
+	~WrapMotorJoint() {}
 public:
-	b2Color* Peek() { return &m_color; }
-	const b2Color& GetColor() const { return m_color; }
-	void SetColor(const b2Color& color) { m_color = color; } // struct copy
+	b2MotorJoint* Peek() { return m_motor_joint; }
+	virtual b2Joint* GetJoint() { return m_motor_joint; } // override WrapJoint
+	void SetupObject(v8::Local<v8::Object> h_world, WrapMotorJointDef* wrap_motor_jd, b2MotorJoint* motor_joint)
+	{
+		m_motor_joint = motor_joint;
+		WrapJoint::SetupObject(h_world, wrap_motor_jd);
+	}
+	b2MotorJoint* ResetObject()
+	{
+		WrapJoint::ResetObject();
+		b2MotorJoint* motor_joint = m_motor_joint;
+		m_motor_joint = NULL;
+		return motor_joint;
+	}
 public:
-	static WrapColor* Unwrap(v8::Local<v8::Value> value) { return (value->IsObject())?(Unwrap(v8::Local<v8::Object>::Cast(value))):(NULL); }
-	static WrapColor* Unwrap(v8::Local<v8::Object> object) { return Nan::ObjectWrap::Unwrap<WrapColor>(object); }
-	static b2Color* Peek(v8::Local<v8::Value> value) { WrapColor* wrap = Unwrap(value); return (wrap)?(wrap->Peek()):(NULL); }
+	static WrapMotorJoint* Unwrap(v8::Local<v8::Value> value) { return (value->IsObject())?(Unwrap(v8::Local<v8::Object>::Cast(value))):(NULL); }
+	static WrapMotorJoint* Unwrap(v8::Local<v8::Object> object) { return Nan::ObjectWrap::Unwrap<WrapMotorJoint>(object); }
+	static b2MotorJoint* Peek(v8::Local<v8::Value> value) { WrapMotorJoint* wrap = Unwrap(value); return (wrap)?(wrap->Peek()):(NULL); }
 public:
 	static NAN_MODULE_INIT(Init)
 	{
@@ -6375,13 +8403,20 @@ public:
 		{
 			v8::Local<v8::FunctionTemplate> function_template = Nan::New<v8::FunctionTemplate>(New);
 			g_function_template.Reset(function_template);
-			function_template->SetClassName(NANX_SYMBOL("b2Color"));
+			function_template->SetClassName(NANX_SYMBOL("b2MotorJoint"));
+			function_template->Inherit(WrapJoint::GetFunctionTemplate());
 			function_template->InstanceTemplate()->SetInternalFieldCount(1);
 			v8::Local<v8::ObjectTemplate> prototype_template = function_template->PrototypeTemplate();
-			NANX_MEMBER_APPLY(prototype_template, r)
-			NANX_MEMBER_APPLY(prototype_template, g)
-			NANX_MEMBER_APPLY(prototype_template, b)
-			NANX_MEMBER_APPLY(prototype_template, a)
+			NANX_METHOD_APPLY(prototype_template, SetLinearOffset)
+			NANX_METHOD_APPLY(prototype_template, GetLinearOffset)
+			NANX_METHOD_APPLY(prototype_template, SetAngularOffset)
+			NANX_METHOD_APPLY(prototype_template, GetAngularOffset)
+			NANX_METHOD_APPLY(prototype_template, SetMaxForce)
+			NANX_METHOD_APPLY(prototype_template, GetMaxForce)
+			NANX_METHOD_APPLY(prototype_template, SetMaxTorque)
+			NANX_METHOD_APPLY(prototype_template, GetMaxTorque)
+			NANX_METHOD_APPLY(prototype_template, SetCorrectionFactor)
+			NANX_METHOD_APPLY(prototype_template, GetCorrectionFactor)
 		}
 		v8::Local<v8::FunctionTemplate> function_template = Nan::New<v8::FunctionTemplate>(g_function_template);
 		return scope.Escape(function_template);
@@ -6393,25 +8428,12 @@ public:
 		v8::Local<v8::Object> instance = constructor->NewInstance();
 		return scope.Escape(instance);
 	}
-	static v8::Local<v8::Object> NewInstance(const b2Color& color)
-	{
-		Nan::EscapableHandleScope scope;
-		v8::Local<v8::Function> constructor = GetConstructor();
-		v8::Local<v8::Object> instance = constructor->NewInstance();
-		WrapColor* wrap = Unwrap(instance);
-		wrap->SetColor(color);
-		return scope.Escape(instance);
-	}
 private:
 	static NAN_METHOD(New)
 	{
 		if (info.IsConstructCall())
 		{
-			float32 r = (info.Length() > 0) ? NANX_float32(info[0]) : 0.5f;
-			float32 g = (info.Length() > 1) ? NANX_float32(info[1]) : 0.5f;
-			float32 b = (info.Length() > 2) ? NANX_float32(info[2]) : 0.5f;
-			float32 a = (info.Length() > 3) ? NANX_float32(info[3]) : 0.5f;
-			WrapColor* wrap = new WrapColor(r, g, b, a);
+			WrapMotorJoint* wrap = new WrapMotorJoint();
 			wrap->Wrap(info.This());
 			info.GetReturnValue().Set(info.This());
 		}
@@ -6421,37 +8443,80 @@ private:
 			info.GetReturnValue().Set(constructor->NewInstance());
 		}
 	}
-	NANX_MEMBER_NUMBER(float32, r)
-	NANX_MEMBER_NUMBER(float32, g)
-	NANX_MEMBER_NUMBER(float32, b)
-	NANX_MEMBER_NUMBER(float32, a)
-};
-
-//// b2Draw
-
-#if B2_ENABLE_PARTICLE
-
-//// b2Particle
+///	b2Vec2 GetAnchorA() const;
+///	b2Vec2 GetAnchorB() const;
+///	b2Vec2 GetReactionForce(float32 inv_dt) const;
+///	float32 GetReactionTorque(float32 inv_dt) const;
+	NANX_METHOD(SetLinearOffset)
+	{
+		WrapMotorJoint* wrap = Unwrap(info.This());
+		wrap->m_motor_joint->SetLinearOffset(WrapVec2::Unwrap(v8::Local<v8::Object>::Cast(info[0]))->GetVec2());
+	}
+	NANX_METHOD(GetLinearOffset)
+	{
+		WrapMotorJoint* wrap = Unwrap(info.This());
+		v8::Local<v8::Object> out = info[0]->IsUndefined() ? WrapVec2::NewInstance() : v8::Local<v8::Object>::Cast(info[0]);
+		WrapVec2::Unwrap(out)->SetVec2(wrap->m_motor_joint->GetLinearOffset());
+		info.GetReturnValue().Set(out);
+	}
+	NANX_METHOD(SetAngularOffset)
+	{
+		WrapMotorJoint* wrap = Unwrap(info.This());
+		wrap->m_motor_joint->SetAngularOffset(NANX_float32(info[0]));
+	}
+	NANX_METHOD(GetAngularOffset)
+	{
+		WrapMotorJoint* wrap = Unwrap(info.This());
+		info.GetReturnValue().Set(Nan::New(wrap->m_motor_joint->GetAngularOffset()));
+	}
+	NANX_METHOD(SetMaxForce)
+	{
+		WrapMotorJoint* wrap = Unwrap(info.This());
+		wrap->m_motor_joint->SetMaxForce(NANX_float32(info[0]));
+	}
+	NANX_METHOD(GetMaxForce)
+	{
+		WrapMotorJoint* wrap = Unwrap(info.This());
+		info.GetReturnValue().Set(Nan::New(wrap->m_motor_joint->GetMaxForce()));
+	}
+	NANX_METHOD(SetMaxTorque)
+	{
+		WrapMotorJoint* wrap = Unwrap(info.This());
+		wrap->m_motor_joint->SetMaxTorque(NANX_float32(info[0]));
+	}
+	NANX_METHOD(GetMaxTorque)
+	{
+		WrapMotorJoint* wrap = Unwrap(info.This());
+		info.GetReturnValue().Set(Nan::New(wrap->m_motor_joint->GetMaxTorque()));
+	}
+	NANX_METHOD(SetCorrectionFactor)
+	{
+		WrapMotorJoint* wrap = Unwrap(info.This());
+		wrap->m_motor_joint->SetCorrectionFactor(NANX_float32(info[0]));
+	}
+	NANX_METHOD(GetCorrectionFactor)
+	{
+		WrapMotorJoint* wrap = Unwrap(info.This());
+		info.GetReturnValue().Set(Nan::New(wrap->m_motor_joint->GetCorrectionFactor()));
+	}
+///	void Dump();
+};
 
-//// b2ParticleColor
+//// b2ContactID
 
-class WrapParticleColor : public Nan::ObjectWrap
+class WrapContactID : public Nan::ObjectWrap
 {
+public:
+	b2ContactID m_contact_id;
 private:
-	b2ParticleColor m_particle_color;
-private:
-	WrapParticleColor() {}
-	WrapParticleColor(const b2ParticleColor& particle_color) : m_particle_color(particle_color) {}
-	WrapParticleColor(uint8 r, uint8 g, uint8 b, uint8 a) : m_particle_color(r, g, b, a) {}
-	~WrapParticleColor() {}
+	WrapContactID() {}
+	~WrapContactID() {}
 public:
-	b2ParticleColor* Peek() { return &m_particle_color; }
-	const b2ParticleColor& GetParticleColor() const { return m_particle_color; }
-	void SetParticleColor(const b2ParticleColor& particle_color) { m_particle_color = particle_color; } // struct copy
+	b2ContactID* Peek() { return &m_contact_id; }
 public:
-	static WrapParticleColor* Unwrap(v8::Local<v8::Value> value) { return (value->IsObject())?(Unwrap(v8::Local<v8::Object>::Cast(value))):(NULL); }
-	static WrapParticleColor* Unwrap(v8::Local<v8::Object> object) { return Nan::ObjectWrap::Unwrap<WrapParticleColor>(object); }
-	static b2ParticleColor* Peek(v8::Local<v8::Value> value) { WrapParticleColor* wrap = Unwrap(value); return (wrap)?(wrap->Peek()):(NULL); }
+	static WrapContactID* Unwrap(v8::Local<v8::Value> value) { return (value->IsObject())?(Unwrap(v8::Local<v8::Object>::Cast(value))):(NULL); }
+	static WrapContactID* Unwrap(v8::Local<v8::Object> object) { return Nan::ObjectWrap::Unwrap<WrapContactID>(object); }
+	static b2ContactID* Peek(v8::Local<v8::Value> value) { WrapContactID* wrap = Unwrap(value); return (wrap)?(wrap->Peek()):(NULL); }
 public:
 	static NAN_MODULE_INIT(Init)
 	{
@@ -6473,31 +8538,22 @@ public:
 		{
 			v8::Local<v8::FunctionTemplate> function_template = Nan::New<v8::FunctionTemplate>(New);
 			g_function_template.Reset(function_template);
-			function_template->SetClassName(NANX_SYMBOL("b2ParticleColor"));
+			function_template->SetClassName(NANX_SYMBOL("b2ContactID"));
 			function_template->InstanceTemplate()->SetInternalFieldCount(1);
 			v8::Local<v8::ObjectTemplate> prototype_template = function_template->PrototypeTemplate();
-			NANX_MEMBER_APPLY(prototype_template, r)
-			NANX_MEMBER_APPLY(prototype_template, g)
-			NANX_MEMBER_APPLY(prototype_template, b)
-			NANX_MEMBER_APPLY(prototype_template, a)
+			//NANX_MEMBER_APPLY(prototype_template, cf) // TODO
+			NANX_MEMBER_APPLY(prototype_template, key)
 		}
 		v8::Local<v8::FunctionTemplate> function_template = Nan::New<v8::FunctionTemplate>(g_function_template);
 		return scope.Escape(function_template);
 	}
-	static v8::Local<v8::Object> NewInstance()
-	{
-		Nan::EscapableHandleScope scope;
-		v8::Local<v8::Function> constructor = GetConstructor();
-		v8::Local<v8::Object> instance = constructor->NewInstance();
-		return scope.Escape(instance);
-	}
-	static v8::Local<v8::Object> NewInstance(const b2ParticleColor& particle_color)
+	static v8::Local<v8::Object> NewInstance(const b2ContactID& contact_id)
 	{
 		Nan::EscapableHandleScope scope;
 		v8::Local<v8::Function> constructor = GetConstructor();
 		v8::Local<v8::Object> instance = constructor->NewInstance();
-		WrapParticleColor* wrap = Unwrap(instance);
-		wrap->SetParticleColor(particle_color);
+		WrapContactID* wrap = Unwrap(instance);
+		wrap->m_contact_id = contact_id;
 		return scope.Escape(instance);
 	}
 private:
@@ -6505,11 +8561,7 @@ private:
 	{
 		if (info.IsConstructCall())
 		{
-			uint8 r = (info.Length() > 0) ? NANX_uint8(info[0]) : 0;
-			uint8 g = (info.Length() > 1) ? NANX_uint8(info[1]) : 0;
-			uint8 b = (info.Length() > 2) ? NANX_uint8(info[2]) : 0;
-			uint8 a = (info.Length() > 3) ? NANX_uint8(info[3]) : 0;
-			WrapParticleColor* wrap = new WrapParticleColor(r, g, b, a);
+			WrapContactID* wrap = new WrapContactID();
 			wrap->Wrap(info.This());
 			info.GetReturnValue().Set(info.This());
 		}
@@ -6519,61 +8571,47 @@ private:
 			info.GetReturnValue().Set(constructor->NewInstance());
 		}
 	}
-	NANX_MEMBER_UINT32(uint8, r)
-	NANX_MEMBER_UINT32(uint8, g)
-	NANX_MEMBER_UINT32(uint8, b)
-	NANX_MEMBER_UINT32(uint8, a)
+	//NANX_MEMBER_OBJECT(cf) // TODO
+	NANX_MEMBER_UINT32(uint32, key)
 };
 
-//// b2ParticleDef
+//// b2ManifoldPoint
 
-class WrapParticleDef : public Nan::ObjectWrap
+class WrapManifoldPoint : public Nan::ObjectWrap
 {
+public:
+	b2ManifoldPoint m_manifold_point;
+	Nan::Persistent<v8::Object> m_wrap_localPoint; // m_manifold_point.localPoint
+	Nan::Persistent<v8::Object> m_wrap_id; // m_manifold_point.id
 private:
-	b2ParticleDef m_pd;
-	Nan::Persistent<v8::Object> m_wrap_position; // m_pd.position
-	Nan::Persistent<v8::Object> m_wrap_velocity; // m_pd.velocity
-	Nan::Persistent<v8::Object> m_wrap_color; // m_pd.color
-	Nan::Persistent<v8::Value> m_wrap_userData; // m_pd.userData
-private:
-	WrapParticleDef()
+	WrapManifoldPoint()
 	{
-		m_wrap_position.Reset(WrapVec2::NewInstance(m_pd.position));
-		m_wrap_velocity.Reset(WrapVec2::NewInstance(m_pd.velocity));
-		m_wrap_color.Reset(WrapParticleColor::NewInstance(m_pd.color));
+		m_wrap_localPoint.Reset(WrapVec2::NewInstance(m_manifold_point.localPoint));
+		m_wrap_id.Reset(WrapContactID::NewInstance(m_manifold_point.id));
 	}
-	~WrapParticleDef()
+	~WrapManifoldPoint()
 	{
-		m_wrap_position.Reset();
-		m_wrap_velocity.Reset();
-		m_wrap_color.Reset();
-		m_wrap_userData.Reset();
+		m_wrap_localPoint.Reset();
+		m_wrap_id.Reset();
 	}
 public:
-	b2ParticleDef* Peek() { return &m_pd; }
-	b2ParticleDef& GetParticleDef() { return m_pd; }
-	const b2ParticleDef& UseParticleDef() { SyncPull(); return GetParticleDef(); }
-	v8::Local<v8::Value> GetUserDataHandle() { return Nan::New<v8::Value>(m_wrap_userData); }
+	b2ManifoldPoint* Peek() { return &m_manifold_point; }
 	void SyncPull()
 	{
 		// sync: pull data from javascript objects
-		m_pd.position = WrapVec2::Unwrap(Nan::New<v8::Object>(m_wrap_position))->GetVec2(); // struct copy
-		m_pd.velocity = WrapVec2::Unwrap(Nan::New<v8::Object>(m_wrap_velocity))->GetVec2(); // struct copy
-		m_pd.color = WrapParticleColor::Unwrap(Nan::New<v8::Object>(m_wrap_color))->GetParticleColor(); // struct copy
-		//m_pd.userData; // not used
+		m_manifold_point.localPoint = WrapVec2::Unwrap(Nan::New<v8::Object>(m_wrap_localPoint))->GetVec2(); // struct copy
+		m_manifold_point.id = WrapContactID::Unwrap(Nan::New<v8::Object>(m_wrap_id))->m_contact_id;
 	}
 	void SyncPush()
 	{
 		// sync: push data into javascript objects
-		WrapVec2::Unwrap(Nan::New<v8::Object>(m_wrap_position))->SetVec2(m_pd.position);
-		WrapVec2::Unwrap(Nan::New<v8::Object>(m_wrap_velocity))->SetVec2(m_pd.velocity);
-		WrapParticleColor::Unwrap(Nan::New<v8::Object>(m_wrap_color))->SetParticleColor(m_pd.color);
-		//m_pd.userData; // not used
+		WrapVec2::Unwrap(Nan::New<v8::Object>(m_wrap_localPoint))->SetVec2(m_manifold_point.localPoint);
+		WrapContactID::Unwrap(Nan::New<v8::Object>(m_wrap_id))->m_contact_id = m_manifold_point.id;
 	}
 public:
-	static WrapParticleDef* Unwrap(v8::Local<v8::Value> value) { return (value->IsObject())?(Unwrap(v8::Local<v8::Object>::Cast(value))):(NULL); }
-	static WrapParticleDef* Unwrap(v8::Local<v8::Object> object) { return Nan::ObjectWrap::Unwrap<WrapParticleDef>(object); }
-	static b2ParticleDef* Peek(v8::Local<v8::Value> value) { WrapParticleDef* wrap = Unwrap(value); return (wrap)?(wrap->Peek()):(NULL); }
+	static WrapManifoldPoint* Unwrap(v8::Local<v8::Value> value) { return (value->IsObject())?(Unwrap(v8::Local<v8::Object>::Cast(value))):(NULL); }
+	static WrapManifoldPoint* Unwrap(v8::Local<v8::Object> object) { return Nan::ObjectWrap::Unwrap<WrapManifoldPoint>(object); }
+	static b2ManifoldPoint* Peek(v8::Local<v8::Value> value) { WrapManifoldPoint* wrap = Unwrap(value); return (wrap)?(wrap->Peek()):(NULL); }
 public:
 	static NAN_MODULE_INIT(Init)
 	{
@@ -6595,25 +8633,25 @@ public:
 		{
 			v8::Local<v8::FunctionTemplate> function_template = Nan::New<v8::FunctionTemplate>(New);
 			g_function_template.Reset(function_template);
-			function_template->SetClassName(NANX_SYMBOL("b2ParticleDef"));
+			function_template->SetClassName(NANX_SYMBOL("b2ManifoldPoint"));
 			function_template->InstanceTemplate()->SetInternalFieldCount(1);
 			v8::Local<v8::ObjectTemplate> prototype_template = function_template->PrototypeTemplate();
-			NANX_MEMBER_APPLY(prototype_template, flags)
-			NANX_MEMBER_APPLY(prototype_template, position)
-			NANX_MEMBER_APPLY(prototype_template, velocity)
-			NANX_MEMBER_APPLY(prototype_template, color)
-			NANX_MEMBER_APPLY(prototype_template, lifetime)
-			NANX_MEMBER_APPLY(prototype_template, userData)
-			//b2ParticleGroup* group;
+			NANX_MEMBER_APPLY(prototype_template, localPoint)
+			NANX_MEMBER_APPLY(prototype_template, normalImpulse)
+			NANX_MEMBER_APPLY(prototype_template, tangentImpulse)
+			NANX_MEMBER_APPLY(prototype_template, id)
 		}
 		v8::Local<v8::FunctionTemplate> function_template = Nan::New<v8::FunctionTemplate>(g_function_template);
 		return scope.Escape(function_template);
 	}
-	static v8::Local<v8::Object> NewInstance()
+	static v8::Local<v8::Object> NewInstance(const b2ManifoldPoint& manifold_point)
 	{
 		Nan::EscapableHandleScope scope;
 		v8::Local<v8::Function> constructor = GetConstructor();
 		v8::Local<v8::Object> instance = constructor->NewInstance();
+		WrapManifoldPoint* wrap = Unwrap(instance);
+		wrap->m_manifold_point = manifold_point; // struct copy
+		wrap->SyncPush();
 		return scope.Escape(instance);
 	}
 private:
@@ -6621,7 +8659,7 @@ private:
 	{
 		if (info.IsConstructCall())
 		{
-			WrapParticleDef* wrap = new WrapParticleDef();
+			WrapManifoldPoint* wrap = new WrapManifoldPoint();
 			wrap->Wrap(info.This());
 			info.GetReturnValue().Set(info.This());
 		}
@@ -6631,55 +8669,100 @@ private:
 			info.GetReturnValue().Set(constructor->NewInstance());
 		}
 	}
-	NANX_MEMBER_INTEGER(uint32, flags)
-	NANX_MEMBER_OBJECT(position) // m_wrap_position
-	NANX_MEMBER_OBJECT(velocity) // m_wrap_velocity
-	NANX_MEMBER_OBJECT(color) // m_wrap_color
-	NANX_MEMBER_NUMBER(float32, lifetime)
-	NANX_MEMBER_VALUE(userData) // m_wrap_userData
-//	b2ParticleGroup* group;
+	NANX_MEMBER_OBJECT(localPoint) // m_wrap_localPoint
+	NANX_MEMBER_NUMBER(float32, normalImpulse)
+	NANX_MEMBER_NUMBER(float32, tangentImpulse)
+	NANX_MEMBER_OBJECT(id) // m_wrap_id
 };
 
-//// b2ParticleHandle
+//// b2Manifold
 
-class WrapParticleHandle : public Nan::ObjectWrap
+class WrapManifold : public Nan::ObjectWrap
 {
-private:
-	b2ParticleHandle m_particle_handle;
-private:
-	WrapParticleHandle() {}
-	~WrapParticleHandle() {}
-public:
-	b2ParticleHandle* Peek() { return &m_particle_handle; }
-public:
-	static WrapParticleHandle* Unwrap(v8::Local<v8::Value> value) { return (value->IsObject())?(Unwrap(v8::Local<v8::Object>::Cast(value))):(NULL); }
-	static WrapParticleHandle* Unwrap(v8::Local<v8::Object> object) { return Nan::ObjectWrap::Unwrap<WrapParticleHandle>(object); }
-	static b2ParticleHandle* Peek(v8::Local<v8::Value> value) { WrapParticleHandle* wrap = Unwrap(value); return (wrap)?(wrap->Peek()):(NULL); }
 public:
-	static NAN_MODULE_INIT(Init)
+	b2Manifold m_manifold;
+	Nan::Persistent<v8::Array> m_wrap_points; // m_manifold.points
+	Nan::Persistent<v8::Object> m_wrap_localNormal; // m_manifold.localNormal
+	Nan::Persistent<v8::Object> m_wrap_localPoint; // m_manifold.localPoint
+private:
+	WrapManifold()
 	{
-		v8::Local<v8::Function> constructor = GetConstructor();
-		target->Set(constructor->GetName(), constructor);
+		m_wrap_points.Reset(Nan::New<v8::Array>(b2_maxManifoldPoints));
+		m_wrap_localNormal.Reset(WrapVec2::NewInstance(m_manifold.localNormal));
+		m_wrap_localPoint.Reset(WrapVec2::NewInstance(m_manifold.localPoint));
+		v8::Local<v8::Array> manifold_points = Nan::New<v8::Array>(m_wrap_points);
+		for (uint32_t i = 0; i < manifold_points->Length(); ++i)
+		{
+			manifold_points->Set(i, WrapManifoldPoint::NewInstance(m_manifold.points[i]));
+		}
 	}
-	static v8::Local<v8::Function> GetConstructor()
+	~WrapManifold()
 	{
-		Nan::EscapableHandleScope scope;
-		v8::Local<v8::FunctionTemplate> function_template = GetFunctionTemplate();
-		v8::Local<v8::Function> constructor = function_template->GetFunction();
-		return scope.Escape(constructor);
+		m_wrap_points.Reset();
+		m_wrap_localNormal.Reset();
+		m_wrap_localPoint.Reset();
 	}
-	static v8::Local<v8::FunctionTemplate> GetFunctionTemplate()
+public:
+	b2Manifold* Peek() { return &m_manifold; }
+	void SyncPull()
 	{
-		Nan::EscapableHandleScope scope;
-		static Nan::Persistent<v8::FunctionTemplate> g_function_template;
-		if (g_function_template.IsEmpty())
+		// sync: pull data from javascript objects
+		v8::Local<v8::Array> manifold_points = Nan::New<v8::Array>(m_wrap_points);
+		for (uint32_t i = 0; i < manifold_points->Length(); ++i)
 		{
-			v8::Local<v8::FunctionTemplate> function_template = Nan::New<v8::FunctionTemplate>(New);
-			g_function_template.Reset(function_template);
-			function_template->SetClassName(NANX_SYMBOL("b2ParticleHandle"));
+			WrapManifoldPoint* wrap_manifold_point = WrapManifoldPoint::Unwrap(v8::Local<v8::Object>::Cast(manifold_points->Get(i)));
+			m_manifold.points[i] = wrap_manifold_point->m_manifold_point; // struct copy
+			wrap_manifold_point->SyncPull();
+		}
+		m_manifold.localNormal = WrapVec2::Unwrap(Nan::New<v8::Object>(m_wrap_localNormal))->GetVec2(); // struct copy
+		m_manifold.localPoint = WrapVec2::Unwrap(Nan::New<v8::Object>(m_wrap_localPoint))->GetVec2(); // struct copy
+	}
+	void SyncPush()
+	{
+		// sync: push data into javascript objects
+		v8::Local<v8::Array> manifold_points = Nan::New<v8::Array>(m_wrap_points);
+		for (uint32_t i = 0; i < manifold_points->Length(); ++i)
+		{
+			WrapManifoldPoint* wrap_manifold_point = WrapManifoldPoint::Unwrap(v8::Local<v8::Object>::Cast(manifold_points->Get(i)));
+			wrap_manifold_point->m_manifold_point = m_manifold.points[i]; // struct copy
+			wrap_manifold_point->SyncPush();
+		}
+		WrapVec2::Unwrap(Nan::New<v8::Object>(m_wrap_localNormal))->SetVec2(m_manifold.localNormal);
+		WrapVec2::Unwrap(Nan::New<v8::Object>(m_wrap_localPoint))->SetVec2(m_manifold.localPoint);
+	}
+public:
+	static WrapManifold* Unwrap(v8::Local<v8::Value> value) { return (value->IsObject())?(Unwrap(v8::Local<v8::Object>::Cast(value))):(NULL); }
+	static WrapManifold* Unwrap(v8::Local<v8::Object> object) { return Nan::ObjectWrap::Unwrap<WrapManifold>(object); }
+	static b2Manifold* Peek(v8::Local<v8::Value> value) { WrapManifold* wrap = Unwrap(value); return (wrap)?(wrap->Peek()):(NULL); }
+public:
+	static NAN_MODULE_INIT(Init)
+	{
+		v8::Local<v8::Function> constructor = GetConstructor();
+		target->Set(constructor->GetName(), constructor);
+	}
+	static v8::Local<v8::Function> GetConstructor()
+	{
+		Nan::EscapableHandleScope scope;
+		v8::Local<v8::FunctionTemplate> function_template = GetFunctionTemplate();
+		v8::Local<v8::Function> constructor = function_template->GetFunction();
+		return scope.Escape(constructor);
+	}
+	static v8::Local<v8::FunctionTemplate> GetFunctionTemplate()
+	{
+		Nan::EscapableHandleScope scope;
+		static Nan::Persistent<v8::FunctionTemplate> g_function_template;
+		if (g_function_template.IsEmpty())
+		{
+			v8::Local<v8::FunctionTemplate> function_template = Nan::New<v8::FunctionTemplate>(New);
+			g_function_template.Reset(function_template);
+			function_template->SetClassName(NANX_SYMBOL("b2Manifold"));
 			function_template->InstanceTemplate()->SetInternalFieldCount(1);
 			v8::Local<v8::ObjectTemplate> prototype_template = function_template->PrototypeTemplate();
-			NANX_METHOD_APPLY(prototype_template, GetIndex)
+			NANX_MEMBER_APPLY(prototype_template, points)
+			NANX_MEMBER_APPLY(prototype_template, localNormal)
+			NANX_MEMBER_APPLY(prototype_template, localPoint)
+			NANX_MEMBER_APPLY(prototype_template, type)
+			NANX_MEMBER_APPLY(prototype_template, pointCount)
 		}
 		v8::Local<v8::FunctionTemplate> function_template = Nan::New<v8::FunctionTemplate>(g_function_template);
 		return scope.Escape(function_template);
@@ -6689,6 +8772,17 @@ public:
 		Nan::EscapableHandleScope scope;
 		v8::Local<v8::Function> constructor = GetConstructor();
 		v8::Local<v8::Object> instance = constructor->NewInstance();
+		//wrap->SyncPush();
+		return scope.Escape(instance);
+	}
+	static v8::Local<v8::Object> NewInstance(const b2Manifold& manifold)
+	{
+		Nan::EscapableHandleScope scope;
+		v8::Local<v8::Function> constructor = GetConstructor();
+		v8::Local<v8::Object> instance = constructor->NewInstance();
+		WrapManifold* wrap = Unwrap(instance);
+		wrap->m_manifold = manifold; // struct copy
+		wrap->SyncPush();
 		return scope.Escape(instance);
 	}
 private:
@@ -6696,7 +8790,7 @@ private:
 	{
 		if (info.IsConstructCall())
 		{
-			WrapParticleHandle* wrap = new WrapParticleHandle();
+			WrapManifold* wrap = new WrapManifold();
 			wrap->Wrap(info.This());
 			info.GetReturnValue().Set(info.This());
 		}
@@ -6706,81 +8800,81 @@ private:
 			info.GetReturnValue().Set(constructor->NewInstance());
 		}
 	}
-	NANX_METHOD(GetIndex)
-	{
-		WrapParticleHandle* wrap = Unwrap(info.This());
-		info.GetReturnValue().Set(Nan::New(wrap->m_particle_handle.GetIndex()));
-	}
+	NANX_MEMBER_ARRAY(points) // m_wrap_points
+	NANX_MEMBER_OBJECT(localNormal) // m_wrap_localNormal
+	NANX_MEMBER_OBJECT(localPoint) // m_wrap_localPoint
+	NANX_MEMBER_INTEGER(b2Manifold::Type, type)
+	NANX_MEMBER_INTEGER(int32, pointCount)
 };
 
-//// b2ParticleGroupDef
+//// b2WorldManifold
 
-class WrapParticleGroupDef : public Nan::ObjectWrap
+class WrapWorldManifold : public Nan::ObjectWrap
 {
+public:
+	b2WorldManifold m_world_manifold;
+	Nan::Persistent<v8::Object> m_wrap_normal; // m_world_manifold.normal
+	Nan::Persistent<v8::Array> m_wrap_points; // m_world_manifold.points
+	Nan::Persistent<v8::Array> m_wrap_separations; // m_world_manifold.separations
 private:
-	b2ParticleGroupDef m_pgd;
-	Nan::Persistent<v8::Object> m_wrap_position; // m_pgd.position
-	Nan::Persistent<v8::Object> m_wrap_linearVelocity; // m_pgd.linearVelocity
-	Nan::Persistent<v8::Object> m_wrap_color; // m_pgd.color
-	Nan::Persistent<v8::Object> m_wrap_shape; // m_pgd.shape
-	Nan::Persistent<v8::Value> m_wrap_userData; // m_pgd.userData
-private:
-	WrapParticleGroupDef()
+	WrapWorldManifold()
 	{
-		m_wrap_position.Reset(WrapVec2::NewInstance(m_pgd.position));
-		m_wrap_linearVelocity.Reset(WrapVec2::NewInstance(m_pgd.linearVelocity));
-		m_wrap_color.Reset(WrapParticleColor::NewInstance(m_pgd.color));
+		m_wrap_normal.Reset(WrapVec2::NewInstance(m_world_manifold.normal));
+		m_wrap_points.Reset(Nan::New<v8::Array>(b2_maxManifoldPoints));
+		m_wrap_separations.Reset(Nan::New<v8::Array>(b2_maxManifoldPoints));
+		v8::Local<v8::Array> world_manifold_points = Nan::New<v8::Array>(m_wrap_points);
+		for (uint32_t i = 0; i < world_manifold_points->Length(); ++i)
+		{
+			world_manifold_points->Set(i, WrapVec2::NewInstance(m_world_manifold.points[i]));
+		}
+		v8::Local<v8::Array> world_manifold_separations = Nan::New<v8::Array>(m_wrap_separations);
+		for (uint32_t i = 0; i < world_manifold_separations->Length(); ++i)
+		{
+			world_manifold_separations->Set(i, Nan::New(m_world_manifold.separations[i]));
+		}
 	}
-	~WrapParticleGroupDef()
+	~WrapWorldManifold()
 	{
-		m_wrap_position.Reset();
-		m_wrap_linearVelocity.Reset();
-		m_wrap_color.Reset();
-		m_wrap_shape.Reset();
-		m_wrap_userData.Reset();
+		m_wrap_normal.Reset();
+		m_wrap_points.Reset();
+		m_wrap_separations.Reset();
 	}
 public:
-	b2ParticleGroupDef* Peek() { return &m_pgd; }
-	b2ParticleGroupDef& GetParticleGroupDef() { return m_pgd; }
-	const b2ParticleGroupDef& UseParticleGroupDef() { SyncPull(); return GetParticleGroupDef(); }
-	v8::Local<v8::Value> GetUserDataHandle() { return Nan::New<v8::Value>(m_wrap_userData); }
+	b2WorldManifold* Peek() { return &m_world_manifold; }
 	void SyncPull()
 	{
 		// sync: pull data from javascript objects
-		m_pgd.position = WrapVec2::Unwrap(Nan::New<v8::Object>(m_wrap_position))->GetVec2(); // struct copy
-		m_pgd.linearVelocity = WrapVec2::Unwrap(Nan::New<v8::Object>(m_wrap_linearVelocity))->GetVec2(); // struct copy
-		m_pgd.color = WrapParticleColor::Unwrap(Nan::New<v8::Object>(m_wrap_color))->GetParticleColor(); // struct copy
-		if (!m_wrap_shape.IsEmpty())
+		m_world_manifold.normal = WrapVec2::Unwrap(Nan::New<v8::Object>(m_wrap_normal))->GetVec2(); // struct copy
+		v8::Local<v8::Array> world_manifold_points = Nan::New<v8::Array>(m_wrap_points);
+		for (uint32_t i = 0; i < world_manifold_points->Length(); ++i)
 		{
-			WrapShape* wrap_shape = WrapShape::Unwrap(Nan::New<v8::Object>(m_wrap_shape));
-			m_pgd.shape = &wrap_shape->UseShape();
+			m_world_manifold.points[i] = WrapVec2::Unwrap(v8::Local<v8::Object>::Cast(world_manifold_points->Get(i)))->GetVec2(); // struct copy
 		}
-		else
+		v8::Local<v8::Array> world_manifold_separations = Nan::New<v8::Array>(m_wrap_separations);
+		for (uint32_t i = 0; i < world_manifold_separations->Length(); ++i)
 		{
-			m_pgd.shape = NULL;
+			m_world_manifold.separations[i] = NANX_float32(world_manifold_separations->Get(i));
 		}
-		//m_pgd.userData; // not used
 	}
 	void SyncPush()
 	{
 		// sync: push data into javascript objects
-		WrapVec2::Unwrap(Nan::New<v8::Object>(m_wrap_position))->SetVec2(m_pgd.position);
-		WrapVec2::Unwrap(Nan::New<v8::Object>(m_wrap_linearVelocity))->SetVec2(m_pgd.linearVelocity);
-		WrapParticleColor::Unwrap(Nan::New<v8::Object>(m_wrap_color))->SetParticleColor(m_pgd.color);
-		if (m_pgd.shape)
+		WrapVec2::Unwrap(Nan::New<v8::Object>(m_wrap_normal))->SetVec2(m_world_manifold.normal);
+		v8::Local<v8::Array> world_manifold_points = Nan::New<v8::Array>(m_wrap_points);
+		for (uint32_t i = 0; i < world_manifold_points->Length(); ++i)
 		{
-			// TODO: m_wrap_shape.Reset(WrapShape::GetWrap(m_pgd.shape)->handle());
+			WrapVec2::Unwrap(v8::Local<v8::Object>::Cast(world_manifold_points->Get(i)))->SetVec2(m_world_manifold.points[i]);
 		}
-		else
+		v8::Local<v8::Array> world_manifold_separations = Nan::New<v8::Array>(m_wrap_separations);
+		for (uint32_t i = 0; i < world_manifold_separations->Length(); ++i)
 		{
-			// TODO: m_wrap_shape.Reset();
+			world_manifold_separations->Set(i, Nan::New(m_world_manifold.separations[i]));
 		}
-		//m_pgd.userData; // not used
 	}
 public:
-	static WrapParticleGroupDef* Unwrap(v8::Local<v8::Value> value) { return (value->IsObject())?(Unwrap(v8::Local<v8::Object>::Cast(value))):(NULL); }
-	static WrapParticleGroupDef* Unwrap(v8::Local<v8::Object> object) { return Nan::ObjectWrap::Unwrap<WrapParticleGroupDef>(object); }
-	static b2ParticleGroupDef* Peek(v8::Local<v8::Value> value) { WrapParticleGroupDef* wrap = Unwrap(value); return (wrap)?(wrap->Peek()):(NULL); }
+	static WrapWorldManifold* Unwrap(v8::Local<v8::Value> value) { return (value->IsObject())?(Unwrap(v8::Local<v8::Object>::Cast(value))):(NULL); }
+	static WrapWorldManifold* Unwrap(v8::Local<v8::Object> object) { return Nan::ObjectWrap::Unwrap<WrapWorldManifold>(object); }
+	static b2WorldManifold* Peek(v8::Local<v8::Value> value) { WrapWorldManifold* wrap = Unwrap(value); return (wrap)?(wrap->Peek()):(NULL); }
 public:
 	static NAN_MODULE_INIT(Init)
 	{
@@ -6802,26 +8896,12 @@ public:
 		{
 			v8::Local<v8::FunctionTemplate> function_template = Nan::New<v8::FunctionTemplate>(New);
 			g_function_template.Reset(function_template);
-			function_template->SetClassName(NANX_SYMBOL("b2ParticleGroupDef"));
+			function_template->SetClassName(NANX_SYMBOL("b2WorldManifold"));
 			function_template->InstanceTemplate()->SetInternalFieldCount(1);
 			v8::Local<v8::ObjectTemplate> prototype_template = function_template->PrototypeTemplate();
-			NANX_MEMBER_APPLY(prototype_template, flags)
-			NANX_MEMBER_APPLY(prototype_template, groupFlags)
-			NANX_MEMBER_APPLY(prototype_template, position)
-			NANX_MEMBER_APPLY(prototype_template, angle)
-			NANX_MEMBER_APPLY(prototype_template, linearVelocity)
-			NANX_MEMBER_APPLY(prototype_template, angularVelocity)
-			NANX_MEMBER_APPLY(prototype_template, color)
-			NANX_MEMBER_APPLY(prototype_template, strength)
-			NANX_MEMBER_APPLY(prototype_template, shape)
-			//const b2Shape* const* shapes;
-			//int32 shapeCount;
-			//float32 stride;
-			//int32 particleCount;
-			//const b2Vec2* positionData;
-			NANX_MEMBER_APPLY(prototype_template, lifetime)
-			NANX_MEMBER_APPLY(prototype_template, userData)
-			//b2ParticleGroup* group;
+			NANX_MEMBER_APPLY(prototype_template, normal)
+			NANX_MEMBER_APPLY(prototype_template, points)
+			NANX_MEMBER_APPLY(prototype_template, separations)
 		}
 		v8::Local<v8::FunctionTemplate> function_template = Nan::New<v8::FunctionTemplate>(g_function_template);
 		return scope.Escape(function_template);
@@ -6831,6 +8911,17 @@ public:
 		Nan::EscapableHandleScope scope;
 		v8::Local<v8::Function> constructor = GetConstructor();
 		v8::Local<v8::Object> instance = constructor->NewInstance();
+		//wrap->SyncPush();
+		return scope.Escape(instance);
+	}
+	static v8::Local<v8::Object> NewInstance(const b2WorldManifold& world_manifold)
+	{
+		Nan::EscapableHandleScope scope;
+		v8::Local<v8::Function> constructor = GetConstructor();
+		v8::Local<v8::Object> instance = constructor->NewInstance();
+		WrapWorldManifold* wrap = Unwrap(instance);
+		wrap->m_world_manifold = world_manifold; // struct copy
+		wrap->SyncPush();
 		return scope.Escape(instance);
 	}
 private:
@@ -6838,7 +8929,7 @@ private:
 	{
 		if (info.IsConstructCall())
 		{
-			WrapParticleGroupDef* wrap = new WrapParticleGroupDef();
+			WrapWorldManifold* wrap = new WrapWorldManifold();
 			wrap->Wrap(info.This());
 			info.GetReturnValue().Set(info.This());
 		}
@@ -6848,87 +8939,31 @@ private:
 			info.GetReturnValue().Set(constructor->NewInstance());
 		}
 	}
-	NANX_MEMBER_INTEGER(uint32, flags)
-	NANX_MEMBER_INTEGER(uint32, groupFlags)
-	NANX_MEMBER_OBJECT(position) // m_wrap_position
-	NANX_MEMBER_NUMBER(float32, angle)
-	NANX_MEMBER_OBJECT(linearVelocity) // m_wrap_linearVelocity
-	NANX_MEMBER_NUMBER(float32, angularVelocity)
-	NANX_MEMBER_OBJECT(color) // m_wrap_color
-	NANX_MEMBER_NUMBER(float32, strength)
-	NANX_MEMBER_OBJECT(shape) // m_wrap_shape
-	//const b2Shape* const* shapes;
-	//int32 shapeCount;
-	//float32 stride;
-	//int32 particleCount;
-	//const b2Vec2* positionData;
-	NANX_MEMBER_NUMBER(float32, lifetime)
-	NANX_MEMBER_VALUE(userData) // m_wrap_userData
-	//b2ParticleGroup* group;
+	NANX_MEMBER_OBJECT(normal) // m_wrap_normal
+	NANX_MEMBER_ARRAY(points) // m_wrap_points
+	NANX_MEMBER_ARRAY(separations) // m_wrap_separations
 };
 
-//// b2ParticleGroup
+//// b2Contact
 
-class WrapParticleGroup : public Nan::ObjectWrap
+class WrapContact : public Nan::ObjectWrap
 {
+public:
+	b2Contact* m_contact;
 private:
-	b2ParticleGroup* m_particle_group;
-	Nan::Persistent<v8::Object> m_particle_group_particle_system;
-	Nan::Persistent<v8::Value> m_particle_group_userData;
-private:
-	WrapParticleGroup() : m_particle_group(NULL) {}
-	~WrapParticleGroup()
-	{
-		m_particle_group_particle_system.Reset();
-		m_particle_group_userData.Reset();
-	}
+	WrapContact() : m_contact(NULL) {}
+	~WrapContact() { m_contact = NULL; }
 public:
-	b2ParticleGroup* Peek() { return m_particle_group; }
-	b2ParticleGroup* GetParticleGroup() { return m_particle_group; }
-	void SetupObject(v8::Local<v8::Object> h_particle_system, WrapParticleGroupDef* wrap_pgd, b2ParticleGroup* particle_group)
+	b2Contact* Peek() { return m_contact; }
+public:
+	static WrapContact* Unwrap(v8::Local<v8::Value> value) { return (value->IsObject())?(Unwrap(v8::Local<v8::Object>::Cast(value))):(NULL); }
+	static WrapContact* Unwrap(v8::Local<v8::Object> object) { return Nan::ObjectWrap::Unwrap<WrapContact>(object); }
+	static b2Contact* Peek(v8::Local<v8::Value> value) { WrapContact* wrap = Unwrap(value); return (wrap)?(wrap->Peek()):(NULL); }
+public:
+	static NAN_MODULE_INIT(Init)
 	{
-		m_particle_group = particle_group;
-		// set particle_group internal data
-		WrapParticleGroup::SetWrap(m_particle_group, this);
-		// set reference to this particle_group (prevent GC)
-		Ref();
-		// set reference to world object
-		m_particle_group_particle_system.Reset(h_particle_system);
-		// set reference to user data object
-		m_particle_group_userData.Reset(wrap_pgd->GetUserDataHandle());
-	}
-	b2ParticleGroup* ResetObject()
-	{
-		// clear reference to world object
-		m_particle_group_particle_system.Reset();
-		// clear reference to user data object
-		m_particle_group_userData.Reset();
-		// clear reference to this particle_group (allow GC)
-		Unref();
-		// clear particle_group internal data
-		WrapParticleGroup::SetWrap(m_particle_group, NULL);
-		b2ParticleGroup* particle_group = m_particle_group;
-		m_particle_group = NULL;
-		return particle_group;
-	}
-public:
-	static WrapParticleGroup* GetWrap(const b2ParticleGroup* particle_group)
-	{
-		return static_cast<WrapParticleGroup*>(particle_group->GetUserData());
-	}
-	static void SetWrap(b2ParticleGroup* particle_group, WrapParticleGroup* wrap)
-	{
-		particle_group->SetUserData(wrap);
-	}
-public:
-	static WrapParticleGroup* Unwrap(v8::Local<v8::Value> value) { return (value->IsObject())?(Unwrap(v8::Local<v8::Object>::Cast(value))):(NULL); }
-	static WrapParticleGroup* Unwrap(v8::Local<v8::Object> object) { return Nan::ObjectWrap::Unwrap<WrapParticleGroup>(object); }
-	static b2ParticleGroup* Peek(v8::Local<v8::Value> value) { WrapParticleGroup* wrap = Unwrap(value); return (wrap)?(wrap->Peek()):(NULL); }
-public:
-	static NAN_MODULE_INIT(Init)
-	{
-		v8::Local<v8::Function> constructor = GetConstructor();
-		target->Set(constructor->GetName(), constructor);
+		v8::Local<v8::Function> constructor = GetConstructor();
+		target->Set(constructor->GetName(), constructor);
 	}
 	static v8::Local<v8::Function> GetConstructor()
 	{
@@ -6945,31 +8980,27 @@ public:
 		{
 			v8::Local<v8::FunctionTemplate> function_template = Nan::New<v8::FunctionTemplate>(New);
 			g_function_template.Reset(function_template);
-			function_template->SetClassName(NANX_SYMBOL("b2ParticleGroup"));
+			function_template->SetClassName(NANX_SYMBOL("b2Contact"));
 			function_template->InstanceTemplate()->SetInternalFieldCount(1);
 			v8::Local<v8::ObjectTemplate> prototype_template = function_template->PrototypeTemplate();
-			//b2ParticleGroup* GetNext();
-			//b2ParticleSystem* GetParticleSystem();
-			NANX_METHOD_APPLY(prototype_template, GetParticleCount)
-			NANX_METHOD_APPLY(prototype_template, GetBufferIndex)
-			NANX_METHOD_APPLY(prototype_template, ContainsParticle)
-			NANX_METHOD_APPLY(prototype_template, DestroyParticles)
-			//uint32 GetAllParticleFlags() const;
-			//uint32 GetGroupFlags() const;
-			//void SetGroupFlags(uint32 flags);
-			//float32 GetMass() const;
-			//float32 GetInertia() const;
-			//b2Vec2 GetCenter() const;
-			//b2Vec2 GetLinearVelocity() const;
-			//float32 GetAngularVelocity() const;
-			//const b2Transform& GetTransform() const;
-			//const b2Vec2& GetPosition() const;
-			//float32 GetAngle() const;
-			//b2Vec2 GetLinearVelocityFromWorldPoint(const b2Vec2& worldPoint) const;
-			//void* GetUserData() const;
-			//void SetUserData(void* data);
-			//void ApplyForce(const b2Vec2& force);
-			//void ApplyLinearImpulse(const b2Vec2& impulse);
+			NANX_METHOD_APPLY(prototype_template, GetManifold)
+			NANX_METHOD_APPLY(prototype_template, GetWorldManifold)
+			NANX_METHOD_APPLY(prototype_template, IsTouching)
+			NANX_METHOD_APPLY(prototype_template, SetEnabled)
+			NANX_METHOD_APPLY(prototype_template, IsEnabled)
+			NANX_METHOD_APPLY(prototype_template, GetNext)
+			NANX_METHOD_APPLY(prototype_template, GetFixtureA)
+			NANX_METHOD_APPLY(prototype_template, GetChildIndexA)
+			NANX_METHOD_APPLY(prototype_template, GetFixtureB)
+			NANX_METHOD_APPLY(prototype_template, GetChildIndexB)
+			NANX_METHOD_APPLY(prototype_template, SetFriction)
+			NANX_METHOD_APPLY(prototype_template, GetFriction)
+			NANX_METHOD_APPLY(prototype_template, ResetFriction)
+			NANX_METHOD_APPLY(prototype_template, SetRestitution)
+			NANX_METHOD_APPLY(prototype_template, GetRestitution)
+			NANX_METHOD_APPLY(prototype_template, ResetRestitution)
+			NANX_METHOD_APPLY(prototype_template, SetTangentSpeed)
+			NANX_METHOD_APPLY(prototype_template, GetTangentSpeed)
 		}
 		v8::Local<v8::FunctionTemplate> function_template = Nan::New<v8::FunctionTemplate>(g_function_template);
 		return scope.Escape(function_template);
@@ -6981,12 +9012,21 @@ public:
 		v8::Local<v8::Object> instance = constructor->NewInstance();
 		return scope.Escape(instance);
 	}
+	static v8::Local<v8::Object> NewInstance(b2Contact* contact)
+	{
+		Nan::EscapableHandleScope scope;
+		v8::Local<v8::Function> constructor = GetConstructor();
+		v8::Local<v8::Object> instance = constructor->NewInstance();
+		WrapContact* wrap = Unwrap(instance);
+		wrap->m_contact = contact; // struct copy
+		return scope.Escape(instance);
+	}
 private:
 	static NAN_METHOD(New)
 	{
 		if (info.IsConstructCall())
 		{
-			WrapParticleGroup* wrap = new WrapParticleGroup();
+			WrapContact* wrap = new WrapContact();
 			wrap->Wrap(info.This());
 			info.GetReturnValue().Set(info.This());
 		}
@@ -6996,73 +9036,137 @@ private:
 			info.GetReturnValue().Set(constructor->NewInstance());
 		}
 	}
-	//b2ParticleGroup* GetNext();
-	//b2ParticleSystem* GetParticleSystem();
-	NANX_METHOD(GetParticleCount)
+	NANX_METHOD(GetManifold)
 	{
-		WrapParticleGroup* wrap = Unwrap(info.This());
-		info.GetReturnValue().Set(Nan::New(wrap->m_particle_group->GetParticleCount()));
+		WrapContact* wrap = Unwrap(info.This());
+		const b2Manifold* manifold = wrap->m_contact->GetManifold();
+		info.GetReturnValue().Set(WrapManifold::NewInstance(*manifold));
 	}
-	NANX_METHOD(GetBufferIndex)
+	NANX_METHOD(GetWorldManifold)
 	{
-		WrapParticleGroup* wrap = Unwrap(info.This());
-		info.GetReturnValue().Set(Nan::New(wrap->m_particle_group->GetBufferIndex()));
+		WrapContact* wrap = Unwrap(info.This());
+		WrapWorldManifold* wrap_world_manifold = WrapWorldManifold::Unwrap(v8::Local<v8::Object>::Cast(info[0]));
+		wrap->m_contact->GetWorldManifold(&wrap_world_manifold->m_world_manifold);
+		wrap_world_manifold->SyncPush();
 	}
-	NANX_METHOD(ContainsParticle)
+	NANX_METHOD(IsTouching)
 	{
-		WrapParticleGroup* wrap = Unwrap(info.This());
-		int32 index = NANX_int32(info[0]);
-		info.GetReturnValue().Set(Nan::New(wrap->m_particle_group->ContainsParticle(index)));
+		WrapContact* wrap = Unwrap(info.This());
+		info.GetReturnValue().Set(Nan::New(wrap->m_contact->IsTouching()));
 	}
-	//uint32 GetAllParticleFlags() const;
-	//uint32 GetGroupFlags() const;
-	//void SetGroupFlags(uint32 flags);
-	//float32 GetMass() const;
-	//float32 GetInertia() const;
-	//b2Vec2 GetCenter() const;
-	//b2Vec2 GetLinearVelocity() const;
-	//float32 GetAngularVelocity() const;
-	//const b2Transform& GetTransform() const;
-	//const b2Vec2& GetPosition() const;
-	//float32 GetAngle() const;
-	//b2Vec2 GetLinearVelocityFromWorldPoint(const b2Vec2& worldPoint) const;
-	//void* GetUserData() const;
-	//void SetUserData(void* data);
-	//void ApplyForce(const b2Vec2& force);
-	//void ApplyLinearImpulse(const b2Vec2& impulse);
-	NANX_METHOD(DestroyParticles)
+	NANX_METHOD(SetEnabled)
 	{
-		WrapParticleGroup* wrap = Unwrap(info.This());
-		bool callDestructionListener = (info.Length() > 0) ? NANX_bool(info[0]) : false;
-		wrap->m_particle_group->DestroyParticles(callDestructionListener);
+		WrapContact* wrap = Unwrap(info.This());
+		wrap->m_contact->SetEnabled(NANX_bool(info[0]));
+	}
+	NANX_METHOD(IsEnabled)
+	{
+		WrapContact* wrap = Unwrap(info.This());
+		info.GetReturnValue().Set(Nan::New(wrap->m_contact->IsEnabled()));
+	}
+	NANX_METHOD(GetNext)
+	{
+		WrapContact* wrap = Unwrap(info.This());
+		b2Contact* contact = wrap->m_contact->GetNext();
+		if (contact)
+		{
+			info.GetReturnValue().Set(WrapContact::NewInstance(contact));
+		}
+		else
+		{
+			info.GetReturnValue().SetNull();
+		}
+	}
+	NANX_METHOD(GetFixtureA)
+	{
+		WrapContact* wrap = Unwrap(info.This());
+		b2Fixture* fixture = wrap->m_contact->GetFixtureA();
+		// get fixture internal data
+		WrapFixture* wrap_fixture = WrapFixture::GetWrap(fixture);
+		info.GetReturnValue().Set(wrap_fixture->handle());
+	}
+	NANX_METHOD(GetChildIndexA)
+	{
+		WrapContact* wrap = Unwrap(info.This());
+		info.GetReturnValue().Set(Nan::New(wrap->m_contact->GetChildIndexA()));
+	}
+	NANX_METHOD(GetFixtureB)
+	{
+		WrapContact* wrap = Unwrap(info.This());
+		b2Fixture* fixture = wrap->m_contact->GetFixtureB();
+		// get fixture internal data
+		WrapFixture* wrap_fixture = WrapFixture::GetWrap(fixture);
+		info.GetReturnValue().Set(wrap_fixture->handle());
+	}
+	NANX_METHOD(GetChildIndexB)
+	{
+		WrapContact* wrap = Unwrap(info.This());
+		info.GetReturnValue().Set(Nan::New(wrap->m_contact->GetChildIndexB()));
 	}
+	NANX_METHOD(SetFriction) { WrapContact* wrap = Unwrap(info.This()); wrap->m_contact->SetFriction(NANX_float32(info[0])); }
+	NANX_METHOD(GetFriction) { WrapContact* wrap = Unwrap(info.This()); info.GetReturnValue().Set(Nan::New(wrap->m_contact->GetFriction())); }
+	NANX_METHOD(ResetFriction) { WrapContact* wrap = Unwrap(info.This()); wrap->m_contact->ResetFriction(); }
+	NANX_METHOD(SetRestitution) { WrapContact* wrap = Unwrap(info.This()); wrap->m_contact->SetRestitution(NANX_float32(info[0])); }
+	NANX_METHOD(GetRestitution) { WrapContact* wrap = Unwrap(info.This()); info.GetReturnValue().Set(Nan::New(wrap->m_contact->GetRestitution())); }
+	NANX_METHOD(ResetRestitution) { WrapContact* wrap = Unwrap(info.This()); wrap->m_contact->ResetRestitution(); }
+	NANX_METHOD(SetTangentSpeed) { WrapContact* wrap = Unwrap(info.This()); wrap->m_contact->SetTangentSpeed(NANX_float32(info[0])); }
+	NANX_METHOD(GetTangentSpeed) { WrapContact* wrap = Unwrap(info.This()); info.GetReturnValue().Set(Nan::New(wrap->m_contact->GetTangentSpeed())); }
+//	virtual void Evaluate(b2Manifold* manifold, const b2Transform& xfA, const b2Transform& xfB) = 0;
 };
 
-//// b2ParticleSystemDef
+//// b2ContactImpulse
 
-class WrapParticleSystemDef : public Nan::ObjectWrap
+class WrapContactImpulse : public Nan::ObjectWrap
 {
+public:
+	b2ContactImpulse m_contact_impulse;
+	Nan::Persistent<v8::Array> m_wrap_normalImpulses; // m_contact_impulse.normalImpulses
+	Nan::Persistent<v8::Array> m_wrap_tangentImpulses; // m_contact_impulse.tangentImpulses
 private:
-	b2ParticleSystemDef m_psd;
-private:
-	WrapParticleSystemDef() {}
-	~WrapParticleSystemDef() {}
+	WrapContactImpulse()
+	{
+		m_wrap_normalImpulses.Reset(Nan::New<v8::Array>(b2_maxManifoldPoints));
+		m_wrap_tangentImpulses.Reset(Nan::New<v8::Array>(b2_maxManifoldPoints));
+	}
+	~WrapContactImpulse()
+	{
+		m_wrap_normalImpulses.Reset();
+		m_wrap_tangentImpulses.Reset();
+	}
 public:
-	b2ParticleSystemDef* Peek() { return &m_psd; }
-	b2ParticleSystemDef& GetParticleSystemDef() { return m_psd; }
-	const b2ParticleSystemDef& UseParticleSystemDef() { SyncPull(); return GetParticleSystemDef(); }
+	b2ContactImpulse* Peek() { return &m_contact_impulse; }
 	void SyncPull()
 	{
 		// sync: pull data from javascript objects
+		v8::Local<v8::Array> contact_impulse_normalImpulses = Nan::New<v8::Array>(m_wrap_normalImpulses);
+		for (uint32_t i = 0; i < contact_impulse_normalImpulses->Length(); ++i)
+		{
+			m_contact_impulse.normalImpulses[i] = NANX_float32(contact_impulse_normalImpulses->Get(i));
+		}
+		v8::Local<v8::Array> contact_impulse_tangentImpulses = Nan::New<v8::Array>(m_wrap_tangentImpulses);
+		for (uint32_t i = 0; i < contact_impulse_tangentImpulses->Length(); ++i)
+		{
+			m_contact_impulse.tangentImpulses[i] = NANX_float32(contact_impulse_tangentImpulses->Get(i));
+		}
 	}
 	void SyncPush()
 	{
 		// sync: push data into javascript objects
+		v8::Local<v8::Array> contact_impulse_normalImpulses = Nan::New<v8::Array>(m_wrap_normalImpulses);
+		for (uint32_t i = 0; i < contact_impulse_normalImpulses->Length(); ++i)
+		{
+			contact_impulse_normalImpulses->Set(i, Nan::New(m_contact_impulse.normalImpulses[i]));
+		}
+		v8::Local<v8::Array> contact_impulse_tangentImpulses = Nan::New<v8::Array>(m_wrap_tangentImpulses);
+		for (uint32_t i = 0; i < contact_impulse_tangentImpulses->Length(); ++i)
+		{
+			contact_impulse_tangentImpulses->Set(i, Nan::New(m_contact_impulse.tangentImpulses[i]));
+		}
 	}
 public:
-	static WrapParticleSystemDef* Unwrap(v8::Local<v8::Value> value) { return (value->IsObject())?(Unwrap(v8::Local<v8::Object>::Cast(value))):(NULL); }
-	static WrapParticleSystemDef* Unwrap(v8::Local<v8::Object> object) { return Nan::ObjectWrap::Unwrap<WrapParticleSystemDef>(object); }
-	static b2ParticleSystemDef* Peek(v8::Local<v8::Value> value) { WrapParticleSystemDef* wrap = Unwrap(value); return (wrap)?(wrap->Peek()):(NULL); }
+	static WrapContactImpulse* Unwrap(v8::Local<v8::Value> value) { return (value->IsObject())?(Unwrap(v8::Local<v8::Object>::Cast(value))):(NULL); }
+	static WrapContactImpulse* Unwrap(v8::Local<v8::Object> object) { return Nan::ObjectWrap::Unwrap<WrapContactImpulse>(object); }
+	static b2ContactImpulse* Peek(v8::Local<v8::Value> value) { WrapContactImpulse* wrap = Unwrap(value); return (wrap)?(wrap->Peek()):(NULL); }
 public:
 	static NAN_MODULE_INIT(Init)
 	{
@@ -7084,31 +9188,12 @@ public:
 		{
 			v8::Local<v8::FunctionTemplate> function_template = Nan::New<v8::FunctionTemplate>(New);
 			g_function_template.Reset(function_template);
-			function_template->SetClassName(NANX_SYMBOL("b2ParticleSystemDef"));
+			function_template->SetClassName(NANX_SYMBOL("b2ContactImpulse"));
 			function_template->InstanceTemplate()->SetInternalFieldCount(1);
 			v8::Local<v8::ObjectTemplate> prototype_template = function_template->PrototypeTemplate();
-			NANX_MEMBER_APPLY(prototype_template, strictContactCheck)
-			NANX_MEMBER_APPLY(prototype_template, strictContactCheck)
-			NANX_MEMBER_APPLY(prototype_template, density)
-			NANX_MEMBER_APPLY(prototype_template, gravityScale)
-			NANX_MEMBER_APPLY(prototype_template, radius)
-			NANX_MEMBER_APPLY(prototype_template, maxCount)
-			NANX_MEMBER_APPLY(prototype_template, pressureStrength)
-			NANX_MEMBER_APPLY(prototype_template, dampingStrength)
-			NANX_MEMBER_APPLY(prototype_template, elasticStrength)
-			NANX_MEMBER_APPLY(prototype_template, springStrength)
-			NANX_MEMBER_APPLY(prototype_template, viscousStrength)
-			NANX_MEMBER_APPLY(prototype_template, surfaceTensionPressureStrength)
-			NANX_MEMBER_APPLY(prototype_template, surfaceTensionNormalStrength)
-			NANX_MEMBER_APPLY(prototype_template, repulsiveStrength)
-			NANX_MEMBER_APPLY(prototype_template, powderStrength)
-			NANX_MEMBER_APPLY(prototype_template, ejectionStrength)
-			NANX_MEMBER_APPLY(prototype_template, staticPressureStrength)
-			NANX_MEMBER_APPLY(prototype_template, staticPressureRelaxation)
-			NANX_MEMBER_APPLY(prototype_template, staticPressureIterations)
-			NANX_MEMBER_APPLY(prototype_template, colorMixingStrength)
-			NANX_MEMBER_APPLY(prototype_template, destroyByAge)
-			NANX_MEMBER_APPLY(prototype_template, lifetimeGranularity)
+			NANX_MEMBER_APPLY(prototype_template, normalImpulses)
+			NANX_MEMBER_APPLY(prototype_template, tangentImpulses)
+			NANX_MEMBER_APPLY(prototype_template, count)
 		}
 		v8::Local<v8::FunctionTemplate> function_template = Nan::New<v8::FunctionTemplate>(g_function_template);
 		return scope.Escape(function_template);
@@ -7118,6 +9203,17 @@ public:
 		Nan::EscapableHandleScope scope;
 		v8::Local<v8::Function> constructor = GetConstructor();
 		v8::Local<v8::Object> instance = constructor->NewInstance();
+		//wrap->SyncPush();
+		return scope.Escape(instance);
+	}
+	static v8::Local<v8::Object> NewInstance(const b2ContactImpulse& contact_impulse)
+	{
+		Nan::EscapableHandleScope scope;
+		v8::Local<v8::Function> constructor = GetConstructor();
+		v8::Local<v8::Object> instance = constructor->NewInstance();
+		WrapContactImpulse* wrap = Unwrap(instance);
+		wrap->m_contact_impulse = contact_impulse; // struct copy
+		wrap->SyncPush();
 		return scope.Escape(instance);
 	}
 private:
@@ -7125,7 +9221,7 @@ private:
 	{
 		if (info.IsConstructCall())
 		{
-			WrapParticleSystemDef* wrap = new WrapParticleSystemDef();
+			WrapContactImpulse* wrap = new WrapContactImpulse();
 			wrap->Wrap(info.This());
 			info.GetReturnValue().Set(info.This());
 		}
@@ -7135,77 +9231,127 @@ private:
 			info.GetReturnValue().Set(constructor->NewInstance());
 		}
 	}
-	NANX_MEMBER_BOOLEAN(bool, strictContactCheck)
-	NANX_MEMBER_NUMBER(float32, density)
-	NANX_MEMBER_NUMBER(float32, gravityScale)
-	NANX_MEMBER_NUMBER(float32, radius)
-	NANX_MEMBER_INTEGER(int32, maxCount)
-	NANX_MEMBER_NUMBER(float32, pressureStrength)
-	NANX_MEMBER_NUMBER(float32, dampingStrength)
-	NANX_MEMBER_NUMBER(float32, elasticStrength)
-	NANX_MEMBER_NUMBER(float32, springStrength)
-	NANX_MEMBER_NUMBER(float32, viscousStrength)
-	NANX_MEMBER_NUMBER(float32, surfaceTensionPressureStrength)
-	NANX_MEMBER_NUMBER(float32, surfaceTensionNormalStrength)
-	NANX_MEMBER_NUMBER(float32, repulsiveStrength)
-	NANX_MEMBER_NUMBER(float32, powderStrength)
-	NANX_MEMBER_NUMBER(float32, ejectionStrength)
-	NANX_MEMBER_NUMBER(float32, staticPressureStrength)
-	NANX_MEMBER_NUMBER(float32, staticPressureRelaxation)
-	NANX_MEMBER_INTEGER(int32, staticPressureIterations)
-	NANX_MEMBER_NUMBER(float32, colorMixingStrength)
-	NANX_MEMBER_BOOLEAN(bool, destroyByAge)
-	NANX_MEMBER_NUMBER(float32, lifetimeGranularity)
+	NANX_MEMBER_ARRAY(normalImpulses) // m_wrap_normalImpulses
+	NANX_MEMBER_ARRAY(tangentImpulses) // m_wrap_tangentImpulses
+	NANX_MEMBER_INTEGER(int32, count)
 };
 
-//// b2ParticleSystem
+//// b2Color
 
-class WrapParticleSystem : public Nan::ObjectWrap
+class WrapColor : public Nan::ObjectWrap
 {
 private:
-	b2ParticleSystem* m_particle_system;
-	Nan::Persistent<v8::Object> m_particle_system_world;
+	b2Color m_color;
 private:
-	WrapParticleSystem() : m_particle_system(NULL) {}
-	~WrapParticleSystem()
+	WrapColor() {}
+	WrapColor(float32 r, float32 g, float32 b, float32 a) : m_color(r, g, b, a) {}
+	~WrapColor() {}
+public:
+	b2Color* Peek() { return &m_color; }
+	const b2Color& GetColor() const { return m_color; }
+	void SetColor(const b2Color& color) { m_color = color; } // struct copy
+public:
+	static WrapColor* Unwrap(v8::Local<v8::Value> value) { return (value->IsObject())?(Unwrap(v8::Local<v8::Object>::Cast(value))):(NULL); }
+	static WrapColor* Unwrap(v8::Local<v8::Object> object) { return Nan::ObjectWrap::Unwrap<WrapColor>(object); }
+	static b2Color* Peek(v8::Local<v8::Value> value) { WrapColor* wrap = Unwrap(value); return (wrap)?(wrap->Peek()):(NULL); }
+public:
+	static NAN_MODULE_INIT(Init)
 	{
-		m_particle_system_world.Reset();
+		v8::Local<v8::Function> constructor = GetConstructor();
+		target->Set(constructor->GetName(), constructor);
 	}
-public:
-	b2ParticleSystem* Peek() { return m_particle_system; }
-	b2ParticleSystem* GetParticleSystem() { return m_particle_system; }
-	void SetupObject(v8::Local<v8::Object> h_world, WrapParticleSystemDef* wrap_psd, b2ParticleSystem* particle_system)
+	static v8::Local<v8::Function> GetConstructor()
 	{
-		m_particle_system = particle_system;
-		// set reference to this particle_system (prevent GC)
-		Ref();
-		// set reference to world object
-		m_particle_system_world.Reset(h_world);
+		Nan::EscapableHandleScope scope;
+		v8::Local<v8::FunctionTemplate> function_template = GetFunctionTemplate();
+		v8::Local<v8::Function> constructor = function_template->GetFunction();
+		return scope.Escape(constructor);
 	}
-	b2ParticleSystem* ResetObject()
+	static v8::Local<v8::FunctionTemplate> GetFunctionTemplate()
 	{
-		// clear reference to world object
-		m_particle_system_world.Reset();
-		// clear reference to this particle_system (allow GC)
-		Unref();
-		b2ParticleSystem* particle_system = m_particle_system;
-		m_particle_system = NULL;
-		return particle_system;
+		Nan::EscapableHandleScope scope;
+		static Nan::Persistent<v8::FunctionTemplate> g_function_template;
+		if (g_function_template.IsEmpty())
+		{
+			v8::Local<v8::FunctionTemplate> function_template = Nan::New<v8::FunctionTemplate>(New);
+			g_function_template.Reset(function_template);
+			function_template->SetClassName(NANX_SYMBOL("b2Color"));
+			function_template->InstanceTemplate()->SetInternalFieldCount(1);
+			v8::Local<v8::ObjectTemplate> prototype_template = function_template->PrototypeTemplate();
+			NANX_MEMBER_APPLY(prototype_template, r)
+			NANX_MEMBER_APPLY(prototype_template, g)
+			NANX_MEMBER_APPLY(prototype_template, b)
+			NANX_MEMBER_APPLY(prototype_template, a)
+		}
+		v8::Local<v8::FunctionTemplate> function_template = Nan::New<v8::FunctionTemplate>(g_function_template);
+		return scope.Escape(function_template);
 	}
-public:
-	static WrapParticleSystem* GetWrap(const b2ParticleSystem* particle_system)
+	static v8::Local<v8::Object> NewInstance()
 	{
-		//return static_cast<WrapParticleSystem*>(particle_system->GetUserData());
-		return NULL;
+		Nan::EscapableHandleScope scope;
+		v8::Local<v8::Function> constructor = GetConstructor();
+		v8::Local<v8::Object> instance = constructor->NewInstance();
+		return scope.Escape(instance);
 	}
-	static void SetWrap(b2ParticleSystem* particle_system, WrapParticleSystem* wrap)
+	static v8::Local<v8::Object> NewInstance(const b2Color& color)
 	{
-		//particle_system->SetUserData(wrap);
+		Nan::EscapableHandleScope scope;
+		v8::Local<v8::Function> constructor = GetConstructor();
+		v8::Local<v8::Object> instance = constructor->NewInstance();
+		WrapColor* wrap = Unwrap(instance);
+		wrap->SetColor(color);
+		return scope.Escape(instance);
+	}
+private:
+	static NAN_METHOD(New)
+	{
+		if (info.IsConstructCall())
+		{
+			float32 r = (info.Length() > 0) ? NANX_float32(info[0]) : 0.5f;
+			float32 g = (info.Length() > 1) ? NANX_float32(info[1]) : 0.5f;
+			float32 b = (info.Length() > 2) ? NANX_float32(info[2]) : 0.5f;
+			float32 a = (info.Length() > 3) ? NANX_float32(info[3]) : 0.5f;
+			WrapColor* wrap = new WrapColor(r, g, b, a);
+			wrap->Wrap(info.This());
+			info.GetReturnValue().Set(info.This());
+		}
+		else
+		{
+			v8::Local<v8::Function> constructor = GetConstructor();
+			info.GetReturnValue().Set(constructor->NewInstance());
+		}
 	}
+	NANX_MEMBER_NUMBER(float32, r)
+	NANX_MEMBER_NUMBER(float32, g)
+	NANX_MEMBER_NUMBER(float32, b)
+	NANX_MEMBER_NUMBER(float32, a)
+};
+
+//// b2Draw
+
+#if B2_ENABLE_PARTICLE
+
+//// b2Particle
+
+//// b2ParticleColor
+
+class WrapParticleColor : public Nan::ObjectWrap
+{
+private:
+	b2ParticleColor m_particle_color;
+private:
+	WrapParticleColor() {}
+	WrapParticleColor(const b2ParticleColor& particle_color) : m_particle_color(particle_color) {}
+	WrapParticleColor(uint8 r, uint8 g, uint8 b, uint8 a) : m_particle_color(r, g, b, a) {}
+	~WrapParticleColor() {}
 public:
-	static WrapParticleSystem* Unwrap(v8::Local<v8::Value> value) { return (value->IsObject())?(Unwrap(v8::Local<v8::Object>::Cast(value))):(NULL); }
-	static WrapParticleSystem* Unwrap(v8::Local<v8::Object> object) { return Nan::ObjectWrap::Unwrap<WrapParticleSystem>(object); }
-	static b2ParticleSystem* Peek(v8::Local<v8::Value> value) { WrapParticleSystem* wrap = Unwrap(value); return (wrap)?(wrap->Peek()):(NULL); }
+	b2ParticleColor* Peek() { return &m_particle_color; }
+	const b2ParticleColor& GetParticleColor() const { return m_particle_color; }
+	void SetParticleColor(const b2ParticleColor& particle_color) { m_particle_color = particle_color; } // struct copy
+public:
+	static WrapParticleColor* Unwrap(v8::Local<v8::Value> value) { return (value->IsObject())?(Unwrap(v8::Local<v8::Object>::Cast(value))):(NULL); }
+	static WrapParticleColor* Unwrap(v8::Local<v8::Object> object) { return Nan::ObjectWrap::Unwrap<WrapParticleColor>(object); }
+	static b2ParticleColor* Peek(v8::Local<v8::Value> value) { WrapParticleColor* wrap = Unwrap(value); return (wrap)?(wrap->Peek()):(NULL); }
 public:
 	static NAN_MODULE_INIT(Init)
 	{
@@ -7227,18 +9373,13 @@ public:
 		{
 			v8::Local<v8::FunctionTemplate> function_template = Nan::New<v8::FunctionTemplate>(New);
 			g_function_template.Reset(function_template);
-			function_template->SetClassName(NANX_SYMBOL("b2ParticleSystem"));
+			function_template->SetClassName(NANX_SYMBOL("b2ParticleColor"));
 			function_template->InstanceTemplate()->SetInternalFieldCount(1);
 			v8::Local<v8::ObjectTemplate> prototype_template = function_template->PrototypeTemplate();
-			NANX_METHOD_APPLY(prototype_template, CreateParticle)
-			NANX_METHOD_APPLY(prototype_template, DestroyParticle)
-			NANX_METHOD_APPLY(prototype_template, DestroyOldestParticle)
-			NANX_METHOD_APPLY(prototype_template, CreateParticleGroup)
-			NANX_METHOD_APPLY(prototype_template, GetParticleCount)
-			NANX_METHOD_APPLY(prototype_template, GetRadius)
-			NANX_METHOD_APPLY(prototype_template, SetPositionBuffer)
-			NANX_METHOD_APPLY(prototype_template, SetVelocityBuffer)
-			NANX_METHOD_APPLY(prototype_template, SetColorBuffer)
+			NANX_MEMBER_APPLY(prototype_template, r)
+			NANX_MEMBER_APPLY(prototype_template, g)
+			NANX_MEMBER_APPLY(prototype_template, b)
+			NANX_MEMBER_APPLY(prototype_template, a)
 		}
 		v8::Local<v8::FunctionTemplate> function_template = Nan::New<v8::FunctionTemplate>(g_function_template);
 		return scope.Escape(function_template);
@@ -7250,12 +9391,25 @@ public:
 		v8::Local<v8::Object> instance = constructor->NewInstance();
 		return scope.Escape(instance);
 	}
+	static v8::Local<v8::Object> NewInstance(const b2ParticleColor& particle_color)
+	{
+		Nan::EscapableHandleScope scope;
+		v8::Local<v8::Function> constructor = GetConstructor();
+		v8::Local<v8::Object> instance = constructor->NewInstance();
+		WrapParticleColor* wrap = Unwrap(instance);
+		wrap->SetParticleColor(particle_color);
+		return scope.Escape(instance);
+	}
 private:
 	static NAN_METHOD(New)
 	{
 		if (info.IsConstructCall())
 		{
-			WrapParticleSystem* wrap = new WrapParticleSystem();
+			uint8 r = (info.Length() > 0) ? NANX_uint8(info[0]) : 0;
+			uint8 g = (info.Length() > 1) ? NANX_uint8(info[1]) : 0;
+			uint8 b = (info.Length() > 2) ? NANX_uint8(info[2]) : 0;
+			uint8 a = (info.Length() > 3) ? NANX_uint8(info[3]) : 0;
+			WrapParticleColor* wrap = new WrapParticleColor(r, g, b, a);
 			wrap->Wrap(info.This());
 			info.GetReturnValue().Set(info.This());
 		}
@@ -7265,356 +9419,3072 @@ private:
 			info.GetReturnValue().Set(constructor->NewInstance());
 		}
 	}
-	NANX_METHOD(CreateParticle)
+	NANX_MEMBER_UINT32(uint8, r)
+	NANX_MEMBER_UINT32(uint8, g)
+	NANX_MEMBER_UINT32(uint8, b)
+	NANX_MEMBER_UINT32(uint8, a)
+};
+
+//// b2ParticleDef
+
+class WrapParticleDef : public Nan::ObjectWrap
+{
+private:
+	b2ParticleDef m_pd;
+	Nan::Persistent<v8::Object> m_wrap_position; // m_pd.position
+	Nan::Persistent<v8::Object> m_wrap_velocity; // m_pd.velocity
+	Nan::Persistent<v8::Object> m_wrap_color; // m_pd.color
+	Nan::Persistent<v8::Value> m_wrap_userData; // m_pd.userData
+private:
+	WrapParticleDef()
 	{
-		WrapParticleSystem* wrap = Unwrap(info.This());
-		WrapParticleDef* wrap_pd = WrapParticleDef::Unwrap(v8::Local<v8::Object>::Cast(info[0]));
-		// create box2d particle
-		int32 particle_index = wrap->m_particle_system->CreateParticle(wrap_pd->UseParticleDef());
-		info.GetReturnValue().Set(Nan::New(particle_index));
+		m_wrap_position.Reset(WrapVec2::NewInstance(m_pd.position));
+		m_wrap_velocity.Reset(WrapVec2::NewInstance(m_pd.velocity));
+		m_wrap_color.Reset(WrapParticleColor::NewInstance(m_pd.color));
 	}
-//	const b2ParticleHandle* GetParticleHandleFromIndex(const int32 index);
-	NANX_METHOD(DestroyParticle)
+	~WrapParticleDef()
 	{
-		WrapParticleSystem* wrap = Unwrap(info.This());
-		int32 particle_index = NANX_int32(info[0]);
-		bool callDestructionListener = (info.Length() > 1) ? NANX_bool(info[1]) : false;
-		// destroy box2d particle
-		wrap->m_particle_system->DestroyParticle(particle_index, callDestructionListener);
+		m_wrap_position.Reset();
+		m_wrap_velocity.Reset();
+		m_wrap_color.Reset();
+		m_wrap_userData.Reset();
 	}
-	NANX_METHOD(DestroyOldestParticle)
+public:
+	b2ParticleDef* Peek() { return &m_pd; }
+	b2ParticleDef& GetParticleDef() { return m_pd; }
+	const b2ParticleDef& UseParticleDef() { SyncPull(); return GetParticleDef(); }
+	v8::Local<v8::Value> GetUserDataHandle() { return Nan::New<v8::Value>(m_wrap_userData); }
+	void SyncPull()
 	{
-		WrapParticleSystem* wrap = Unwrap(info.This());
-		int32 particle_index = NANX_int32(info[0]);
-		bool callDestructionListener = (info.Length() > 1) ? NANX_bool(info[1]) : false;
-		// destroy box2d particle
-		wrap->m_particle_system->DestroyOldestParticle(particle_index, callDestructionListener);
+		// sync: pull data from javascript objects
+		m_pd.position = WrapVec2::Unwrap(Nan::New<v8::Object>(m_wrap_position))->GetVec2(); // struct copy
+		m_pd.velocity = WrapVec2::Unwrap(Nan::New<v8::Object>(m_wrap_velocity))->GetVec2(); // struct copy
+		m_pd.color = WrapParticleColor::Unwrap(Nan::New<v8::Object>(m_wrap_color))->GetParticleColor(); // struct copy
+		//m_pd.userData; // not used
 	}
-//	int32 DestroyParticlesInShape(const b2Shape& shape, const b2Transform& xf);
-//	int32 DestroyParticlesInShape(const b2Shape& shape, const b2Transform& xf, bool callDestructionListener);
-	NANX_METHOD(CreateParticleGroup)
+	void SyncPush()
 	{
-		WrapParticleSystem* wrap = Unwrap(info.This());
-		WrapParticleGroupDef* wrap_pgd = WrapParticleGroupDef::Unwrap(v8::Local<v8::Object>::Cast(info[0]));
-		// create box2d particle group
-		b2ParticleGroup* particle_group = wrap->m_particle_system->CreateParticleGroup(wrap_pgd->UseParticleGroupDef());
-		// create javascript particle group object
-		v8::Local<v8::Object> h_particle_group = WrapParticleGroup::NewInstance();
-		WrapParticleGroup* wrap_particle_group = WrapParticleGroup::Unwrap(h_particle_group);
-		// set up javascript particle group object
-		wrap_particle_group->SetupObject(info.This(), wrap_pgd, particle_group);
-		info.GetReturnValue().Set(h_particle_group);
+		// sync: push data into javascript objects
+		WrapVec2::Unwrap(Nan::New<v8::Object>(m_wrap_position))->SetVec2(m_pd.position);
+		WrapVec2::Unwrap(Nan::New<v8::Object>(m_wrap_velocity))->SetVec2(m_pd.velocity);
+		WrapParticleColor::Unwrap(Nan::New<v8::Object>(m_wrap_color))->SetParticleColor(m_pd.color);
+		//m_pd.userData; // not used
 	}
-//	void JoinParticleGroups(b2ParticleGroup* groupA, b2ParticleGroup* groupB);
-//	void SplitParticleGroup(b2ParticleGroup* group);
-//	b2ParticleGroup* GetParticleGroupList();
-//	int32 GetParticleGroupCount() const;
-	NANX_METHOD(GetParticleCount)
+public:
+	static WrapParticleDef* Unwrap(v8::Local<v8::Value> value) { return (value->IsObject())?(Unwrap(v8::Local<v8::Object>::Cast(value))):(NULL); }
+	static WrapParticleDef* Unwrap(v8::Local<v8::Object> object) { return Nan::ObjectWrap::Unwrap<WrapParticleDef>(object); }
+	static b2ParticleDef* Peek(v8::Local<v8::Value> value) { WrapParticleDef* wrap = Unwrap(value); return (wrap)?(wrap->Peek()):(NULL); }
+public:
+	static NAN_MODULE_INIT(Init)
 	{
-		WrapParticleSystem* wrap = Unwrap(info.This());
-		info.GetReturnValue().Set(Nan::New(wrap->m_particle_system->GetParticleCount()));
+		v8::Local<v8::Function> constructor = GetConstructor();
+		target->Set(constructor->GetName(), constructor);
 	}
-//	int32 GetMaxParticleCount() const;
-//	void SetMaxParticleCount(int32 count);
-//	uint32 GetAllParticleFlags() const;
-//	uint32 GetAllGroupFlags() const;
-//	void SetPaused(bool paused);
-//	bool GetPaused() const;
-//	void SetDensity(float32 density);
-//	float32 GetDensity() const;
-//	void SetGravityScale(float32 gravityScale);
-//	float32 GetGravityScale() const;
-//	void SetDamping(float32 damping);
-//	float32 GetDamping() const;
-//	void SetStaticPressureIterations(int32 iterations);
-//	int32 GetStaticPressureIterations() const;
-//	void SetRadius(float32 radius);
-//	float32 GetRadius() const;
-	NANX_METHOD(GetRadius)
+	static v8::Local<v8::Function> GetConstructor()
 	{
-		WrapParticleSystem* wrap = Unwrap(info.This());
-		info.GetReturnValue().Set(Nan::New(wrap->m_particle_system->GetRadius()));
+		Nan::EscapableHandleScope scope;
+		v8::Local<v8::FunctionTemplate> function_template = GetFunctionTemplate();
+		v8::Local<v8::Function> constructor = function_template->GetFunction();
+		return scope.Escape(constructor);
 	}
-//	b2Vec2* GetPositionBuffer();
-//	b2Vec2* GetVelocityBuffer();
-//	b2ParticleColor* GetColorBuffer();
-//	b2ParticleGroup* const* GetGroupBuffer();
-//	float32* GetWeightBuffer();
-//	void** GetUserDataBuffer();
-//	const uint32* GetFlagsBuffer() const;
-//	void SetParticleFlags(int32 index, uint32 flags);
-//	uint32 GetParticleFlags(const int32 index);
-//	void SetFlagsBuffer(uint32* buffer, int32 capacity);
-//	void SetPositionBuffer(b2Vec2* buffer, int32 capacity);
-	NANX_METHOD(SetPositionBuffer)
+	static v8::Local<v8::FunctionTemplate> GetFunctionTemplate()
 	{
-		WrapParticleSystem* wrap = Unwrap(info.This());
-		#if NODE_VERSION_AT_LEAST(4, 0, 0)
-		v8::Local<v8::Float32Array> _buffer = v8::Local<v8::Float32Array>::Cast(info[0]);
-		if (!_buffer->HasBuffer())
+		Nan::EscapableHandleScope scope;
+		static Nan::Persistent<v8::FunctionTemplate> g_function_template;
+		if (g_function_template.IsEmpty())
 		{
-			_buffer->Get(NANX_SYMBOL("buffer"));
-			assert(_buffer->HasBuffer());
+			v8::Local<v8::FunctionTemplate> function_template = Nan::New<v8::FunctionTemplate>(New);
+			g_function_template.Reset(function_template);
+			function_template->SetClassName(NANX_SYMBOL("b2ParticleDef"));
+			function_template->InstanceTemplate()->SetInternalFieldCount(1);
+			v8::Local<v8::ObjectTemplate> prototype_template = function_template->PrototypeTemplate();
+			NANX_MEMBER_APPLY(prototype_template, flags)
+			NANX_MEMBER_APPLY(prototype_template, position)
+			NANX_MEMBER_APPLY(prototype_template, velocity)
+			NANX_MEMBER_APPLY(prototype_template, color)
+			NANX_MEMBER_APPLY(prototype_template, lifetime)
+			NANX_MEMBER_APPLY(prototype_template, userData)
+			//b2ParticleGroup* group;
 		}
-		int32 capacity = NANX_int32(info[1]);
-		b2Vec2* buffer = reinterpret_cast<b2Vec2*>(static_cast<char*>(_buffer->Buffer()->GetContents().Data()) + _buffer->ByteOffset());
-		#else
-		v8::Local<v8::Object> _buffer = v8::Local<v8::Object>::Cast(info[0]);
-		int32 capacity = NANX_int32(info[1]);
-		b2Vec2* buffer = static_cast<b2Vec2*>(_buffer->GetIndexedPropertiesExternalArrayData());
-		#endif
-		wrap->m_particle_system->SetPositionBuffer(buffer, capacity);
+		v8::Local<v8::FunctionTemplate> function_template = Nan::New<v8::FunctionTemplate>(g_function_template);
+		return scope.Escape(function_template);
 	}
-//	void SetVelocityBuffer(b2Vec2* buffer, int32 capacity);
-	NANX_METHOD(SetVelocityBuffer)
+	static v8::Local<v8::Object> NewInstance()
 	{
-		WrapParticleSystem* wrap = Unwrap(info.This());
-		#if NODE_VERSION_AT_LEAST(4, 0, 0)
-		v8::Local<v8::Float32Array> _buffer = v8::Local<v8::Float32Array>::Cast(info[0]);
-		if (!_buffer->HasBuffer())
-		{
-			_buffer->Get(NANX_SYMBOL("buffer"));
-			assert(_buffer->HasBuffer());
-		}
-		int32 capacity = NANX_int32(info[1]);
-		b2Vec2* buffer = reinterpret_cast<b2Vec2*>(static_cast<char*>(_buffer->Buffer()->GetContents().Data()) + _buffer->ByteOffset());
-		#else
-		v8::Local<v8::Object> _buffer = v8::Local<v8::Object>::Cast(info[0]);
-		int32 capacity = NANX_int32(info[1]);
-		b2Vec2* buffer = static_cast<b2Vec2*>(_buffer->GetIndexedPropertiesExternalArrayData());
-		#endif
-		wrap->m_particle_system->SetVelocityBuffer(buffer, capacity);
+		Nan::EscapableHandleScope scope;
+		v8::Local<v8::Function> constructor = GetConstructor();
+		v8::Local<v8::Object> instance = constructor->NewInstance();
+		return scope.Escape(instance);
 	}
-//	void SetColorBuffer(b2ParticleColor* buffer, int32 capacity);
-	NANX_METHOD(SetColorBuffer)
+private:
+	static NAN_METHOD(New)
 	{
-		WrapParticleSystem* wrap = Unwrap(info.This());
-		#if NODE_VERSION_AT_LEAST(4, 0, 0)
-		v8::Local<v8::Uint8Array> _buffer = v8::Local<v8::Uint8Array>::Cast(info[0]);
-		if (!_buffer->HasBuffer())
+		if (info.IsConstructCall())
 		{
-			_buffer->Get(NANX_SYMBOL("buffer"));
-			assert(_buffer->HasBuffer());
+			WrapParticleDef* wrap = new WrapParticleDef();
+			wrap->Wrap(info.This());
+			info.GetReturnValue().Set(info.This());
+		}
+		else
+		{
+			v8::Local<v8::Function> constructor = GetConstructor();
+			info.GetReturnValue().Set(constructor->NewInstance());
 		}
-		int32 capacity = NANX_int32(info[1]);
-		b2ParticleColor* buffer = reinterpret_cast<b2ParticleColor*>(static_cast<char*>(_buffer->Buffer()->GetContents().Data()) + _buffer->ByteOffset());
-		#else
-		v8::Local<v8::Object> _buffer = v8::Local<v8::Object>::Cast(info[0]);
-		int32 capacity = NANX_int32(info[1]);
-		b2ParticleColor* buffer = static_cast<b2ParticleColor*>(_buffer->GetIndexedPropertiesExternalArrayData());
-		#endif
-		wrap->m_particle_system->SetColorBuffer(buffer, capacity);
 	}
-//	void SetUserDataBuffer(void** buffer, int32 capacity);
-//	const b2ParticleContact* GetContacts() const;
-//	int32 GetContactCount() const;
-//	const b2ParticleBodyContact* GetBodyContacts() const;
-//	int32 GetBodyContactCount() const;
-//	const b2ParticlePair* GetPairs() const;
-//	int32 GetPairCount() const;
-//	const b2ParticleTriad* GetTriads() const;
-//	int32 GetTriadCount() const;
-//	void SetStuckThreshold(int32 iterations);
-//	const int32* GetStuckCandidates() const;
-//	int32 GetStuckCandidateCount() const;
-//	float32 ComputeCollisionEnergy() const;
-//	void SetStrictContactCheck(bool enabled);
-//	bool GetStrictContactCheck() const;
-//	void SetParticleLifetime(const int32 index, const float32 lifetime);
-//	float32 GetParticleLifetime(const int32 index);
-//	void SetDestructionByAge(const bool enable);
-//	bool GetDestructionByAge() const;
-//	const int32* GetExpirationTimeBuffer();
-//	float32 ExpirationTimeToLifetime(const int32 expirationTime) const;
-//	const int32* GetIndexByExpirationTimeBuffer();
-//	void ParticleApplyLinearImpulse(int32 index, const b2Vec2& impulse);
-//	void ApplyLinearImpulse(int32 firstIndex, int32 lastIndex, const b2Vec2& impulse);
-//	void ParticleApplyForce(int32 index, const b2Vec2& force);
-//	void ApplyForce(int32 firstIndex, int32 lastIndex, const b2Vec2& force);
-//	b2ParticleSystem* GetNext();
-//	void QueryAABB(b2QueryCallback* callback, const b2AABB& mass_data) const;
-//	void QueryShapeAABB(b2QueryCallback* callback, const b2Shape& shape, const b2Transform& xf) const;
-//	void RayCast(b2RayCastCallback* callback, const b2Vec2& point1, const b2Vec2& point2) const;
-//	void ComputeAABB(b2AABB* const mass_data) const;
+	NANX_MEMBER_INTEGER(uint32, flags)
+	NANX_MEMBER_OBJECT(position) // m_wrap_position
+	NANX_MEMBER_OBJECT(velocity) // m_wrap_velocity
+	NANX_MEMBER_OBJECT(color) // m_wrap_color
+	NANX_MEMBER_NUMBER(float32, lifetime)
+	NANX_MEMBER_VALUE(userData) // m_wrap_userData
+//	b2ParticleGroup* group;
 };
 
-#endif
-
-//// b2World
+//// b2ParticleHandle
 
-class WrapWorld : public Nan::ObjectWrap
+class WrapParticleHandle : public Nan::ObjectWrap
 {
 private:
-	class WrapDestructionListener : public b2DestructionListener
-	{
-	public:
-		WrapWorld* m_wrap_world;
-	public:
-		WrapDestructionListener(WrapWorld* wrap) : m_wrap_world(wrap) {}
-		~WrapDestructionListener() { m_wrap_world = NULL; }
-	public:
-		virtual void SayGoodbye(b2Joint* joint);
-		virtual void SayGoodbye(b2Fixture* fixture);
-		#if B2_ENABLE_PARTICLE
-		virtual void SayGoodbye(b2ParticleGroup* group);
-		virtual void SayGoodbye(b2ParticleSystem* particleSystem, int32 index);
-		#endif
-	};
-
+	b2ParticleHandle m_particle_handle;
 private:
-	class WrapContactFilter : public b2ContactFilter
+	WrapParticleHandle() {}
+	~WrapParticleHandle() {}
+public:
+	b2ParticleHandle* Peek() { return &m_particle_handle; }
+public:
+	static WrapParticleHandle* Unwrap(v8::Local<v8::Value> value) { return (value->IsObject())?(Unwrap(v8::Local<v8::Object>::Cast(value))):(NULL); }
+	static WrapParticleHandle* Unwrap(v8::Local<v8::Object> object) { return Nan::ObjectWrap::Unwrap<WrapParticleHandle>(object); }
+	static b2ParticleHandle* Peek(v8::Local<v8::Value> value) { WrapParticleHandle* wrap = Unwrap(value); return (wrap)?(wrap->Peek()):(NULL); }
+public:
+	static NAN_MODULE_INIT(Init)
 	{
-	public:
-		WrapWorld* m_wrap_world;
-	public:
-		WrapContactFilter(WrapWorld* wrap) : m_wrap_world(wrap) {}
-		~WrapContactFilter() { m_wrap_world = NULL; }
-	public:
-		virtual bool ShouldCollide(b2Fixture* fixtureA, b2Fixture* fixtureB);
-		#if B2_ENABLE_PARTICLE
-		virtual bool ShouldCollide(b2Fixture* fixture, b2ParticleSystem* particleSystem, int32 particleIndex);
-		virtual bool ShouldCollide(b2ParticleSystem* particleSystem, int32 particleIndexA, int32 particleIndexB);
-		#endif
-	};
-
-private:
-	class WrapContactListener : public b2ContactListener
+		v8::Local<v8::Function> constructor = GetConstructor();
+		target->Set(constructor->GetName(), constructor);
+	}
+	static v8::Local<v8::Function> GetConstructor()
 	{
-	public:
-		WrapWorld* m_wrap_world;
-	public:
-		WrapContactListener(WrapWorld* wrap) : m_wrap_world(wrap) {}
-		~WrapContactListener() { m_wrap_world = NULL; }
-	public:
-		virtual void BeginContact(b2Contact* contact);
-		virtual void EndContact(b2Contact* contact);
-		#if B2_ENABLE_PARTICLE
-		virtual void BeginContact(b2ParticleSystem* particleSystem, b2ParticleBodyContact* particleBodyContact);
-		virtual void EndContact(b2Fixture* fixture, b2ParticleSystem* particleSystem, int32 index);
-		virtual void BeginContact(b2ParticleSystem* particleSystem, b2ParticleContact* particleContact);
-		virtual void EndContact(b2ParticleSystem* particleSystem, int32 indexA, int32 indexB);
-		#endif
-		virtual void PreSolve(b2Contact* contact, const b2Manifold* oldManifold);
-		virtual void PostSolve(b2Contact* contact, const b2ContactImpulse* impulse);
-	};
-
+		Nan::EscapableHandleScope scope;
+		v8::Local<v8::FunctionTemplate> function_template = GetFunctionTemplate();
+		v8::Local<v8::Function> constructor = function_template->GetFunction();
+		return scope.Escape(constructor);
+	}
+	static v8::Local<v8::FunctionTemplate> GetFunctionTemplate()
+	{
+		Nan::EscapableHandleScope scope;
+		static Nan::Persistent<v8::FunctionTemplate> g_function_template;
+		if (g_function_template.IsEmpty())
+		{
+			v8::Local<v8::FunctionTemplate> function_template = Nan::New<v8::FunctionTemplate>(New);
+			g_function_template.Reset(function_template);
+			function_template->SetClassName(NANX_SYMBOL("b2ParticleHandle"));
+			function_template->InstanceTemplate()->SetInternalFieldCount(1);
+			v8::Local<v8::ObjectTemplate> prototype_template = function_template->PrototypeTemplate();
+			NANX_METHOD_APPLY(prototype_template, GetIndex)
+		}
+		v8::Local<v8::FunctionTemplate> function_template = Nan::New<v8::FunctionTemplate>(g_function_template);
+		return scope.Escape(function_template);
+	}
+	static v8::Local<v8::Object> NewInstance()
+	{
+		Nan::EscapableHandleScope scope;
+		v8::Local<v8::Function> constructor = GetConstructor();
+		v8::Local<v8::Object> instance = constructor->NewInstance();
+		return scope.Escape(instance);
+	}
 private:
-	class WrapDraw : public b2Draw
+	static NAN_METHOD(New)
 	{
-	public:
-		WrapWorld* m_wrap_world;
-	public:
-		WrapDraw(WrapWorld* wrap) : m_wrap_world(wrap) {}
-		~WrapDraw() { m_wrap_world = NULL; }
-	public:
-		virtual void DrawPolygon(const b2Vec2* vertices, int32 vertexCount, const b2Color& color);
-		virtual void DrawSolidPolygon(const b2Vec2* vertices, int32 vertexCount, const b2Color& color);
-		virtual void DrawCircle(const b2Vec2& center, float32 radius, const b2Color& color);
-		virtual void DrawSolidCircle(const b2Vec2& center, float32 radius, const b2Vec2& axis, const b2Color& color);
-		#if B2_ENABLE_PARTICLE
-		virtual void DrawParticles(const b2Vec2 *centers, float32 radius, const b2ParticleColor *colors, int32 count);
-		#endif
-		virtual void DrawSegment(const b2Vec2& p1, const b2Vec2& p2, const b2Color& color);
-		virtual void DrawTransform(const b2Transform& xf);
-	};
+		if (info.IsConstructCall())
+		{
+			WrapParticleHandle* wrap = new WrapParticleHandle();
+			wrap->Wrap(info.This());
+			info.GetReturnValue().Set(info.This());
+		}
+		else
+		{
+			v8::Local<v8::Function> constructor = GetConstructor();
+			info.GetReturnValue().Set(constructor->NewInstance());
+		}
+	}
+	NANX_METHOD(GetIndex)
+	{
+		WrapParticleHandle* wrap = Unwrap(info.This());
+		info.GetReturnValue().Set(Nan::New(wrap->m_particle_handle.GetIndex()));
+	}
+};
+
+//// b2ParticleGroupDef
 
+class WrapParticleGroupDef : public Nan::ObjectWrap
+{
 private:
-	class WrapQueryCallback : public b2QueryCallback
+	b2ParticleGroupDef m_pgd;
+	Nan::Persistent<v8::Object> m_wrap_position; // m_pgd.position
+	Nan::Persistent<v8::Object> m_wrap_linearVelocity; // m_pgd.linearVelocity
+	Nan::Persistent<v8::Object> m_wrap_color; // m_pgd.color
+	Nan::Persistent<v8::Object> m_wrap_shape; // m_pgd.shape
+	Nan::Persistent<v8::Value> m_wrap_userData; // m_pgd.userData
+private:
+	WrapParticleGroupDef()
 	{
-	private:
-		v8::Local<v8::Function> m_callback;
-	public:
-		WrapQueryCallback(v8::Local<v8::Function> callback) : m_callback(callback) {}
-		bool ReportFixture(b2Fixture* fixture)
+		m_wrap_position.Reset(WrapVec2::NewInstance(m_pgd.position));
+		m_wrap_linearVelocity.Reset(WrapVec2::NewInstance(m_pgd.linearVelocity));
+		m_wrap_color.Reset(WrapParticleColor::NewInstance(m_pgd.color));
+	}
+	~WrapParticleGroupDef()
+	{
+		m_wrap_position.Reset();
+		m_wrap_linearVelocity.Reset();
+		m_wrap_color.Reset();
+		m_wrap_shape.Reset();
+		m_wrap_userData.Reset();
+	}
+public:
+	b2ParticleGroupDef* Peek() { return &m_pgd; }
+	b2ParticleGroupDef& GetParticleGroupDef() { return m_pgd; }
+	const b2ParticleGroupDef& UseParticleGroupDef() { SyncPull(); return GetParticleGroupDef(); }
+	v8::Local<v8::Value> GetUserDataHandle() { return Nan::New<v8::Value>(m_wrap_userData); }
+	void SyncPull()
+	{
+		// sync: pull data from javascript objects
+		m_pgd.position = WrapVec2::Unwrap(Nan::New<v8::Object>(m_wrap_position))->GetVec2(); // struct copy
+		m_pgd.linearVelocity = WrapVec2::Unwrap(Nan::New<v8::Object>(m_wrap_linearVelocity))->GetVec2(); // struct copy
+		m_pgd.color = WrapParticleColor::Unwrap(Nan::New<v8::Object>(m_wrap_color))->GetParticleColor(); // struct copy
+		if (!m_wrap_shape.IsEmpty())
 		{
-			// get fixture internal data
-			WrapFixture* wrap_fixture = WrapFixture::GetWrap(fixture);
-			v8::Local<v8::Object> h_fixture = wrap_fixture->handle();
-			v8::Local<v8::Value> argv[] = { h_fixture };
-			return NANX_bool(Nan::MakeCallback(Nan::GetCurrentContext()->Global(), m_callback, countof(argv), argv));
+			WrapShape* wrap_shape = WrapShape::Unwrap(Nan::New<v8::Object>(m_wrap_shape));
+			m_pgd.shape = &wrap_shape->UseShape();
 		}
-		#if B2_ENABLE_PARTICLE
-		bool ReportParticle(const b2ParticleSystem* particleSystem, int32 index)
+		else
 		{
-			// TODO
-			return b2QueryCallback::ReportParticle(particleSystem, index);
+			m_pgd.shape = NULL;
 		}
-		bool ShouldQueryParticleSystem(const b2ParticleSystem* particleSystem)
+		//m_pgd.userData; // not used
+	}
+	void SyncPush()
+	{
+		// sync: push data into javascript objects
+		WrapVec2::Unwrap(Nan::New<v8::Object>(m_wrap_position))->SetVec2(m_pgd.position);
+		WrapVec2::Unwrap(Nan::New<v8::Object>(m_wrap_linearVelocity))->SetVec2(m_pgd.linearVelocity);
+		WrapParticleColor::Unwrap(Nan::New<v8::Object>(m_wrap_color))->SetParticleColor(m_pgd.color);
+		if (m_pgd.shape)
 		{
-			// TODO
-			return b2QueryCallback::ShouldQueryParticleSystem(particleSystem);
+			// TODO: m_wrap_shape.Reset(WrapShape::GetWrap(m_pgd.shape)->handle());
 		}
-		#endif
-	};
-
+		else
+		{
+			// TODO: m_wrap_shape.Reset();
+		}
+		//m_pgd.userData; // not used
+	}
+public:
+	static WrapParticleGroupDef* Unwrap(v8::Local<v8::Value> value) { return (value->IsObject())?(Unwrap(v8::Local<v8::Object>::Cast(value))):(NULL); }
+	static WrapParticleGroupDef* Unwrap(v8::Local<v8::Object> object) { return Nan::ObjectWrap::Unwrap<WrapParticleGroupDef>(object); }
+	static b2ParticleGroupDef* Peek(v8::Local<v8::Value> value) { WrapParticleGroupDef* wrap = Unwrap(value); return (wrap)?(wrap->Peek()):(NULL); }
+public:
+	static NAN_MODULE_INIT(Init)
+	{
+		v8::Local<v8::Function> constructor = GetConstructor();
+		target->Set(constructor->GetName(), constructor);
+	}
+	static v8::Local<v8::Function> GetConstructor()
+	{
+		Nan::EscapableHandleScope scope;
+		v8::Local<v8::FunctionTemplate> function_template = GetFunctionTemplate();
+		v8::Local<v8::Function> constructor = function_template->GetFunction();
+		return scope.Escape(constructor);
+	}
+	static v8::Local<v8::FunctionTemplate> GetFunctionTemplate()
+	{
+		Nan::EscapableHandleScope scope;
+		static Nan::Persistent<v8::FunctionTemplate> g_function_template;
+		if (g_function_template.IsEmpty())
+		{
+			v8::Local<v8::FunctionTemplate> function_template = Nan::New<v8::FunctionTemplate>(New);
+			g_function_template.Reset(function_template);
+			function_template->SetClassName(NANX_SYMBOL("b2ParticleGroupDef"));
+			function_template->InstanceTemplate()->SetInternalFieldCount(1);
+			v8::Local<v8::ObjectTemplate> prototype_template = function_template->PrototypeTemplate();
+			NANX_MEMBER_APPLY(prototype_template, flags)
+			NANX_MEMBER_APPLY(prototype_template, groupFlags)
+			NANX_MEMBER_APPLY(prototype_template, position)
+			NANX_MEMBER_APPLY(prototype_template, angle)
+			NANX_MEMBER_APPLY(prototype_template, linearVelocity)
+			NANX_MEMBER_APPLY(prototype_template, angularVelocity)
+			NANX_MEMBER_APPLY(prototype_template, color)
+			NANX_MEMBER_APPLY(prototype_template, strength)
+			NANX_MEMBER_APPLY(prototype_template, shape)
+			//const b2Shape* const* shapes;
+			//int32 shapeCount;
+			//float32 stride;
+			//int32 particleCount;
+			//const b2Vec2* positionData;
+			NANX_MEMBER_APPLY(prototype_template, lifetime)
+			NANX_MEMBER_APPLY(prototype_template, userData)
+			//b2ParticleGroup* group;
+		}
+		v8::Local<v8::FunctionTemplate> function_template = Nan::New<v8::FunctionTemplate>(g_function_template);
+		return scope.Escape(function_template);
+	}
+	static v8::Local<v8::Object> NewInstance()
+	{
+		Nan::EscapableHandleScope scope;
+		v8::Local<v8::Function> constructor = GetConstructor();
+		v8::Local<v8::Object> instance = constructor->NewInstance();
+		return scope.Escape(instance);
+	}
 private:
-	class WrapRayCastCallback : public b2RayCastCallback
+	static NAN_METHOD(New)
 	{
-	private:
-		v8::Local<v8::Function> m_callback;
-	public:
-		WrapRayCastCallback(v8::Local<v8::Function> callback) : m_callback(callback) {}
-		float32 ReportFixture(b2Fixture* fixture, const b2Vec2& point, const b2Vec2& normal, float32 fraction)
+		if (info.IsConstructCall())
 		{
-			// get fixture internal data
-			WrapFixture* wrap_fixture = WrapFixture::GetWrap(fixture);
-			v8::Local<v8::Object> h_fixture = wrap_fixture->handle();
-			v8::Local<v8::Object> h_point = WrapVec2::NewInstance(point);
-			v8::Local<v8::Object> h_normal = WrapVec2::NewInstance(normal);
-			v8::Local<v8::Number> h_fraction = Nan::New(fraction);
-			v8::Local<v8::Value> argv[] = { h_fixture, h_point, h_normal, h_fraction };
-			return NANX_float32(Nan::MakeCallback(Nan::GetCurrentContext()->Global(), m_callback, countof(argv), argv));
+			WrapParticleGroupDef* wrap = new WrapParticleGroupDef();
+			wrap->Wrap(info.This());
+			info.GetReturnValue().Set(info.This());
 		}
-		#if B2_ENABLE_PARTICLE
-		float32 ReportParticle(const b2ParticleSystem* particleSystem, int32 index, const b2Vec2& point, const b2Vec2& normal, float32 fraction)
+		else
 		{
-			// TODO:
-			return b2RayCastCallback::ReportParticle(particleSystem, index, point, normal, fraction);
+			v8::Local<v8::Function> constructor = GetConstructor();
+			info.GetReturnValue().Set(constructor->NewInstance());
+		}
+	}
+	NANX_MEMBER_INTEGER(uint32, flags)
+	NANX_MEMBER_INTEGER(uint32, groupFlags)
+	NANX_MEMBER_OBJECT(position) // m_wrap_position
+	NANX_MEMBER_NUMBER(float32, angle)
+	NANX_MEMBER_OBJECT(linearVelocity) // m_wrap_linearVelocity
+	NANX_MEMBER_NUMBER(float32, angularVelocity)
+	NANX_MEMBER_OBJECT(color) // m_wrap_color
+	NANX_MEMBER_NUMBER(float32, strength)
+	NANX_MEMBER_OBJECT(shape) // m_wrap_shape
+	//const b2Shape* const* shapes;
+	//int32 shapeCount;
+	//float32 stride;
+	//int32 particleCount;
+	//const b2Vec2* positionData;
+	NANX_MEMBER_NUMBER(float32, lifetime)
+	NANX_MEMBER_VALUE(userData) // m_wrap_userData
+	//b2ParticleGroup* group;
+};
+
+//// b2ParticleGroup
+
+class WrapParticleGroup : public Nan::ObjectWrap
+{
+private:
+	b2ParticleGroup* m_particle_group;
+	Nan::Persistent<v8::Object> m_particle_group_particle_system;
+	Nan::Persistent<v8::Value> m_particle_group_userData;
+private:
+	WrapParticleGroup() : m_particle_group(NULL) {}
+	~WrapParticleGroup()
+	{
+		m_particle_group_particle_system.Reset();
+		m_particle_group_userData.Reset();
+	}
+public:
+	b2ParticleGroup* Peek() { return m_particle_group; }
+	b2ParticleGroup* GetParticleGroup() { return m_particle_group; }
+	void SetupObject(v8::Local<v8::Object> h_particle_system, WrapParticleGroupDef* wrap_pgd, b2ParticleGroup* particle_group)
+	{
+		m_particle_group = particle_group;
+		// set particle_group internal data
+		WrapParticleGroup::SetWrap(m_particle_group, this);
+		// set reference to this particle_group (prevent GC)
+		Ref();
+		// set reference to world object
+		m_particle_group_particle_system.Reset(h_particle_system);
+		// set reference to user data object
+		m_particle_group_userData.Reset(wrap_pgd->GetUserDataHandle());
+	}
+	b2ParticleGroup* ResetObject()
+	{
+		// clear reference to world object
+		m_particle_group_particle_system.Reset();
+		// clear reference to user data object
+		m_particle_group_userData.Reset();
+		// clear reference to this particle_group (allow GC)
+		Unref();
+		// clear particle_group internal data
+		WrapParticleGroup::SetWrap(m_particle_group, NULL);
+		b2ParticleGroup* particle_group = m_particle_group;
+		m_particle_group = NULL;
+		return particle_group;
+	}
+public:
+	static WrapParticleGroup* GetWrap(const b2ParticleGroup* particle_group)
+	{
+		return static_cast<WrapParticleGroup*>(particle_group->GetUserData());
+	}
+	static void SetWrap(b2ParticleGroup* particle_group, WrapParticleGroup* wrap)
+	{
+		particle_group->SetUserData(wrap);
+	}
+public:
+	static WrapParticleGroup* Unwrap(v8::Local<v8::Value> value) { return (value->IsObject())?(Unwrap(v8::Local<v8::Object>::Cast(value))):(NULL); }
+	static WrapParticleGroup* Unwrap(v8::Local<v8::Object> object) { return Nan::ObjectWrap::Unwrap<WrapParticleGroup>(object); }
+	static b2ParticleGroup* Peek(v8::Local<v8::Value> value) { WrapParticleGroup* wrap = Unwrap(value); return (wrap)?(wrap->Peek()):(NULL); }
+public:
+	static NAN_MODULE_INIT(Init)
+	{
+		v8::Local<v8::Function> constructor = GetConstructor();
+		target->Set(constructor->GetName(), constructor);
+	}
+	static v8::Local<v8::Function> GetConstructor()
+	{
+		Nan::EscapableHandleScope scope;
+		v8::Local<v8::FunctionTemplate> function_template = GetFunctionTemplate();
+		v8::Local<v8::Function> constructor = function_template->GetFunction();
+		return scope.Escape(constructor);
+	}
+	static v8::Local<v8::FunctionTemplate> GetFunctionTemplate()
+	{
+		Nan::EscapableHandleScope scope;
+		static Nan::Persistent<v8::FunctionTemplate> g_function_template;
+		if (g_function_template.IsEmpty())
+		{
+			v8::Local<v8::FunctionTemplate> function_template = Nan::New<v8::FunctionTemplate>(New);
+			g_function_template.Reset(function_template);
+			function_template->SetClassName(NANX_SYMBOL("b2ParticleGroup"));
+			function_template->InstanceTemplate()->SetInternalFieldCount(1);
+			v8::Local<v8::ObjectTemplate> prototype_template = function_template->PrototypeTemplate();
+			//b2ParticleGroup* GetNext();
+			//b2ParticleSystem* GetParticleSystem();
+			NANX_METHOD_APPLY(prototype_template, GetParticleCount)
+			NANX_METHOD_APPLY(prototype_template, GetBufferIndex)
+			NANX_METHOD_APPLY(prototype_template, ContainsParticle)
+			NANX_METHOD_APPLY(prototype_template, DestroyParticles)
+			//uint32 GetAllParticleFlags() const;
+			//uint32 GetGroupFlags() const;
+			//void SetGroupFlags(uint32 flags);
+			//float32 GetMass() const;
+			//float32 GetInertia() const;
+			//b2Vec2 GetCenter() const;
+			//b2Vec2 GetLinearVelocity() const;
+			//float32 GetAngularVelocity() const;
+			//const b2Transform& GetTransform() const;
+			//const b2Vec2& GetPosition() const;
+			//float32 GetAngle() const;
+			//b2Vec2 GetLinearVelocityFromWorldPoint(const b2Vec2& worldPoint) const;
+			//void* GetUserData() const;
+			//void SetUserData(void* data);
+			//void ApplyForce(const b2Vec2& force);
+			//void ApplyLinearImpulse(const b2Vec2& impulse);
+		}
+		v8::Local<v8::FunctionTemplate> function_template = Nan::New<v8::FunctionTemplate>(g_function_template);
+		return scope.Escape(function_template);
+	}
+	static v8::Local<v8::Object> NewInstance()
+	{
+		Nan::EscapableHandleScope scope;
+		v8::Local<v8::Function> constructor = GetConstructor();
+		v8::Local<v8::Object> instance = constructor->NewInstance();
+		return scope.Escape(instance);
+	}
+private:
+	static NAN_METHOD(New)
+	{
+		if (info.IsConstructCall())
+		{
+			WrapParticleGroup* wrap = new WrapParticleGroup();
+			wrap->Wrap(info.This());
+			info.GetReturnValue().Set(info.This());
+		}
+		else
+		{
+			v8::Local<v8::Function> constructor = GetConstructor();
+			info.GetReturnValue().Set(constructor->NewInstance());
+		}
+	}
+	//b2ParticleGroup* GetNext();
+	//b2ParticleSystem* GetParticleSystem();
+	NANX_METHOD(GetParticleCount)
+	{
+		WrapParticleGroup* wrap = Unwrap(info.This());
+		info.GetReturnValue().Set(Nan::New(wrap->m_particle_group->GetParticleCount()));
+	}
+	NANX_METHOD(GetBufferIndex)
+	{
+		WrapParticleGroup* wrap = Unwrap(info.This());
+		info.GetReturnValue().Set(Nan::New(wrap->m_particle_group->GetBufferIndex()));
+	}
+	NANX_METHOD(ContainsParticle)
+	{
+		WrapParticleGroup* wrap = Unwrap(info.This());
+		int32 index = NANX_int32(info[0]);
+		info.GetReturnValue().Set(Nan::New(wrap->m_particle_group->ContainsParticle(index)));
+	}
+	//uint32 GetAllParticleFlags() const;
+	//uint32 GetGroupFlags() const;
+	//void SetGroupFlags(uint32 flags);
+	//float32 GetMass() const;
+	//float32 GetInertia() const;
+	//b2Vec2 GetCenter() const;
+	//b2Vec2 GetLinearVelocity() const;
+	//float32 GetAngularVelocity() const;
+	//const b2Transform& GetTransform() const;
+	//const b2Vec2& GetPosition() const;
+	//float32 GetAngle() const;
+	//b2Vec2 GetLinearVelocityFromWorldPoint(const b2Vec2& worldPoint) const;
+	//void* GetUserData() const;
+	//void SetUserData(void* data);
+	//void ApplyForce(const b2Vec2& force);
+	//void ApplyLinearImpulse(const b2Vec2& impulse);
+	NANX_METHOD(DestroyParticles)
+	{
+		WrapParticleGroup* wrap = Unwrap(info.This());
+		bool callDestructionListener = (info.Length() > 0) ? NANX_bool(info[0]) : false;
+		wrap->m_particle_group->DestroyParticles(callDestructionListener);
+	}
+};
+
+//// b2ParticleSystemDef
+
+class WrapParticleSystemDef : public Nan::ObjectWrap
+{
+private:
+	b2ParticleSystemDef m_psd;
+private:
+	WrapParticleSystemDef() {}
+	~WrapParticleSystemDef() {}
+public:
+	b2ParticleSystemDef* Peek() { return &m_psd; }
+	b2ParticleSystemDef& GetParticleSystemDef() { return m_psd; }
+	const b2ParticleSystemDef& UseParticleSystemDef() { SyncPull(); return GetParticleSystemDef(); }
+	void SyncPull()
+	{
+		// sync: pull data from javascript objects
+	}
+	void SyncPush()
+	{
+		// sync: push data into javascript objects
+	}
+public:
+	static WrapParticleSystemDef* Unwrap(v8::Local<v8::Value> value) { return (value->IsObject())?(Unwrap(v8::Local<v8::Object>::Cast(value))):(NULL); }
+	static WrapParticleSystemDef* Unwrap(v8::Local<v8::Object> object) { return Nan::ObjectWrap::Unwrap<WrapParticleSystemDef>(object); }
+	static b2ParticleSystemDef* Peek(v8::Local<v8::Value> value) { WrapParticleSystemDef* wrap = Unwrap(value); return (wrap)?(wrap->Peek()):(NULL); }
+public:
+	static NAN_MODULE_INIT(Init)
+	{
+		v8::Local<v8::Function> constructor = GetConstructor();
+		target->Set(constructor->GetName(), constructor);
+	}
+	static v8::Local<v8::Function> GetConstructor()
+	{
+		Nan::EscapableHandleScope scope;
+		v8::Local<v8::FunctionTemplate> function_template = GetFunctionTemplate();
+		v8::Local<v8::Function> constructor = function_template->GetFunction();
+		return scope.Escape(constructor);
+	}
+	static v8::Local<v8::FunctionTemplate> GetFunctionTemplate()
+	{
+		Nan::EscapableHandleScope scope;
+		static Nan::Persistent<v8::FunctionTemplate> g_function_template;
+		if (g_function_template.IsEmpty())
+		{
+			v8::Local<v8::FunctionTemplate> function_template = Nan::New<v8::FunctionTemplate>(New);
+			g_function_template.Reset(function_template);
+			function_template->SetClassName(NANX_SYMBOL("b2ParticleSystemDef"));
+			function_template->InstanceTemplate()->SetInternalFieldCount(1);
+			v8::Local<v8::ObjectTemplate> prototype_template = function_template->PrototypeTemplate();
+			NANX_MEMBER_APPLY(prototype_template, strictContactCheck)
+			NANX_MEMBER_APPLY(prototype_template, strictContactCheck)
+			NANX_MEMBER_APPLY(prototype_template, density)
+			NANX_MEMBER_APPLY(prototype_template, gravityScale)
+			NANX_MEMBER_APPLY(prototype_template, radius)
+			NANX_MEMBER_APPLY(prototype_template, maxCount)
+			NANX_MEMBER_APPLY(prototype_template, pressureStrength)
+			NANX_MEMBER_APPLY(prototype_template, dampingStrength)
+			NANX_MEMBER_APPLY(prototype_template, elasticStrength)
+			NANX_MEMBER_APPLY(prototype_template, springStrength)
+			NANX_MEMBER_APPLY(prototype_template, viscousStrength)
+			NANX_MEMBER_APPLY(prototype_template, surfaceTensionPressureStrength)
+			NANX_MEMBER_APPLY(prototype_template, surfaceTensionNormalStrength)
+			NANX_MEMBER_APPLY(prototype_template, repulsiveStrength)
+			NANX_MEMBER_APPLY(prototype_template, powderStrength)
+			NANX_MEMBER_APPLY(prototype_template, ejectionStrength)
+			NANX_MEMBER_APPLY(prototype_template, staticPressureStrength)
+			NANX_MEMBER_APPLY(prototype_template, staticPressureRelaxation)
+			NANX_MEMBER_APPLY(prototype_template, staticPressureIterations)
+			NANX_MEMBER_APPLY(prototype_template, colorMixingStrength)
+			NANX_MEMBER_APPLY(prototype_template, destroyByAge)
+			NANX_MEMBER_APPLY(prototype_template, lifetimeGranularity)
+		}
+		v8::Local<v8::FunctionTemplate> function_template = Nan::New<v8::FunctionTemplate>(g_function_template);
+		return scope.Escape(function_template);
+	}
+	static v8::Local<v8::Object> NewInstance()
+	{
+		Nan::EscapableHandleScope scope;
+		v8::Local<v8::Function> constructor = GetConstructor();
+		v8::Local<v8::Object> instance = constructor->NewInstance();
+		return scope.Escape(instance);
+	}
+private:
+	static NAN_METHOD(New)
+	{
+		if (info.IsConstructCall())
+		{
+			WrapParticleSystemDef* wrap = new WrapParticleSystemDef();
+			wrap->Wrap(info.This());
+			info.GetReturnValue().Set(info.This());
+		}
+		else
+		{
+			v8::Local<v8::Function> constructor = GetConstructor();
+			info.GetReturnValue().Set(constructor->NewInstance());
+		}
+	}
+	NANX_MEMBER_BOOLEAN(bool, strictContactCheck)
+	NANX_MEMBER_NUMBER(float32, density)
+	NANX_MEMBER_NUMBER(float32, gravityScale)
+	NANX_MEMBER_NUMBER(float32, radius)
+	NANX_MEMBER_INTEGER(int32, maxCount)
+	NANX_MEMBER_NUMBER(float32, pressureStrength)
+	NANX_MEMBER_NUMBER(float32, dampingStrength)
+	NANX_MEMBER_NUMBER(float32, elasticStrength)
+	NANX_MEMBER_NUMBER(float32, springStrength)
+	NANX_MEMBER_NUMBER(float32, viscousStrength)
+	NANX_MEMBER_NUMBER(float32, surfaceTensionPressureStrength)
+	NANX_MEMBER_NUMBER(float32, surfaceTensionNormalStrength)
+	NANX_MEMBER_NUMBER(float32, repulsiveStrength)
+	NANX_MEMBER_NUMBER(float32, powderStrength)
+	NANX_MEMBER_NUMBER(float32, ejectionStrength)
+	NANX_MEMBER_NUMBER(float32, staticPressureStrength)
+	NANX_MEMBER_NUMBER(float32, staticPressureRelaxation)
+	NANX_MEMBER_INTEGER(int32, staticPressureIterations)
+	NANX_MEMBER_NUMBER(float32, colorMixingStrength)
+	NANX_MEMBER_BOOLEAN(bool, destroyByAge)
+	NANX_MEMBER_NUMBER(float32, lifetimeGranularity)
+};
+
+//// b2ParticleSystem
+
+class WrapParticleSystem : public Nan::ObjectWrap
+{
+private:
+	b2ParticleSystem* m_particle_system;
+	AllocStats* m_alloc_stats; // this system's allocations, owned by the world
+	Nan::Persistent<v8::Object> m_particle_system_world;
+private:
+	WrapParticleSystem() : m_particle_system(NULL), m_alloc_stats(NULL) {}
+	~WrapParticleSystem()
+	{
+		m_particle_system_world.Reset();
+	}
+public:
+	b2ParticleSystem* Peek() { return m_particle_system; }
+	b2ParticleSystem* GetParticleSystem() { return m_particle_system; }
+	void SetupObject(v8::Local<v8::Object> h_world, WrapParticleSystemDef* wrap_psd, b2ParticleSystem* particle_system)
+	{
+		m_particle_system = particle_system;
+		// set reference to this particle_system (prevent GC)
+		Ref();
+		// set reference to world object
+		m_particle_system_world.Reset(h_world);
+	}
+	b2ParticleSystem* ResetObject()
+	{
+		// clear reference to world object
+		m_particle_system_world.Reset();
+		// clear reference to this particle_system (allow GC)
+		Unref();
+		b2ParticleSystem* particle_system = m_particle_system;
+		m_particle_system = NULL;
+		m_alloc_stats = NULL;
+		return particle_system;
+	}
+	AllocStats* GetAllocStats() { return m_alloc_stats; }
+	void SetAllocStats(AllocStats* stats) { m_alloc_stats = stats; }
+public:
+	static WrapParticleSystem* GetWrap(const b2ParticleSystem* particle_system)
+	{
+		//return static_cast<WrapParticleSystem*>(particle_system->GetUserData());
+		return NULL;
+	}
+	static void SetWrap(b2ParticleSystem* particle_system, WrapParticleSystem* wrap)
+	{
+		//particle_system->SetUserData(wrap);
+	}
+public:
+	static WrapParticleSystem* Unwrap(v8::Local<v8::Value> value) { return (value->IsObject())?(Unwrap(v8::Local<v8::Object>::Cast(value))):(NULL); }
+	static WrapParticleSystem* Unwrap(v8::Local<v8::Object> object) { return Nan::ObjectWrap::Unwrap<WrapParticleSystem>(object); }
+	static b2ParticleSystem* Peek(v8::Local<v8::Value> value) { WrapParticleSystem* wrap = Unwrap(value); return (wrap)?(wrap->Peek()):(NULL); }
+public:
+	static NAN_MODULE_INIT(Init)
+	{
+		v8::Local<v8::Function> constructor = GetConstructor();
+		target->Set(constructor->GetName(), constructor);
+	}
+	static v8::Local<v8::Function> GetConstructor()
+	{
+		Nan::EscapableHandleScope scope;
+		v8::Local<v8::FunctionTemplate> function_template = GetFunctionTemplate();
+		v8::Local<v8::Function> constructor = function_template->GetFunction();
+		return scope.Escape(constructor);
+	}
+	static v8::Local<v8::FunctionTemplate> GetFunctionTemplate()
+	{
+		Nan::EscapableHandleScope scope;
+		static Nan::Persistent<v8::FunctionTemplate> g_function_template;
+		if (g_function_template.IsEmpty())
+		{
+			v8::Local<v8::FunctionTemplate> function_template = Nan::New<v8::FunctionTemplate>(New);
+			g_function_template.Reset(function_template);
+			function_template->SetClassName(NANX_SYMBOL("b2ParticleSystem"));
+			function_template->InstanceTemplate()->SetInternalFieldCount(1);
+			v8::Local<v8::ObjectTemplate> prototype_template = function_template->PrototypeTemplate();
+			NANX_METHOD_APPLY(prototype_template, CreateParticle)
+			NANX_METHOD_APPLY(prototype_template, DestroyParticle)
+			NANX_METHOD_APPLY(prototype_template, DestroyOldestParticle)
+			NANX_METHOD_APPLY(prototype_template, CreateParticleGroup)
+			NANX_METHOD_APPLY(prototype_template, GetParticleCount)
+			NANX_METHOD_APPLY(prototype_template, GetRadius)
+			NANX_METHOD_APPLY(prototype_template, SetPositionBuffer)
+			NANX_METHOD_APPLY(prototype_template, SetVelocityBuffer)
+			NANX_METHOD_APPLY(prototype_template, SetColorBuffer)
+		}
+		v8::Local<v8::FunctionTemplate> function_template = Nan::New<v8::FunctionTemplate>(g_function_template);
+		return scope.Escape(function_template);
+	}
+	static v8::Local<v8::Object> NewInstance()
+	{
+		Nan::EscapableHandleScope scope;
+		v8::Local<v8::Function> constructor = GetConstructor();
+		v8::Local<v8::Object> instance = constructor->NewInstance();
+		return scope.Escape(instance);
+	}
+private:
+	static NAN_METHOD(New)
+	{
+		if (info.IsConstructCall())
+		{
+			WrapParticleSystem* wrap = new WrapParticleSystem();
+			wrap->Wrap(info.This());
+			info.GetReturnValue().Set(info.This());
+		}
+		else
+		{
+			v8::Local<v8::Function> constructor = GetConstructor();
+			info.GetReturnValue().Set(constructor->NewInstance());
+		}
+	}
+	NANX_METHOD(CreateParticle)
+	{
+		WrapParticleSystem* wrap = Unwrap(info.This());
+		WrapParticleDef* wrap_pd = WrapParticleDef::Unwrap(v8::Local<v8::Object>::Cast(info[0]));
+		AllocScope alloc_scope(wrap->m_alloc_stats);
+		// create box2d particle
+		int32 particle_index = wrap->m_particle_system->CreateParticle(wrap_pd->UseParticleDef());
+		info.GetReturnValue().Set(Nan::New(particle_index));
+	}
+//	const b2ParticleHandle* GetParticleHandleFromIndex(const int32 index);
+	NANX_METHOD(DestroyParticle)
+	{
+		WrapParticleSystem* wrap = Unwrap(info.This());
+		int32 particle_index = NANX_int32(info[0]);
+		bool callDestructionListener = (info.Length() > 1) ? NANX_bool(info[1]) : false;
+		// destroy box2d particle
+		wrap->m_particle_system->DestroyParticle(particle_index, callDestructionListener);
+	}
+	NANX_METHOD(DestroyOldestParticle)
+	{
+		WrapParticleSystem* wrap = Unwrap(info.This());
+		int32 particle_index = NANX_int32(info[0]);
+		bool callDestructionListener = (info.Length() > 1) ? NANX_bool(info[1]) : false;
+		// destroy box2d particle
+		wrap->m_particle_system->DestroyOldestParticle(particle_index, callDestructionListener);
+	}
+//	int32 DestroyParticlesInShape(const b2Shape& shape, const b2Transform& xf);
+//	int32 DestroyParticlesInShape(const b2Shape& shape, const b2Transform& xf, bool callDestructionListener);
+	NANX_METHOD(CreateParticleGroup)
+	{
+		WrapParticleSystem* wrap = Unwrap(info.This());
+		WrapParticleGroupDef* wrap_pgd = WrapParticleGroupDef::Unwrap(v8::Local<v8::Object>::Cast(info[0]));
+		AllocScope alloc_scope(wrap->m_alloc_stats);
+		// create box2d particle group
+		b2ParticleGroup* particle_group = wrap->m_particle_system->CreateParticleGroup(wrap_pgd->UseParticleGroupDef());
+		// create javascript particle group object
+		v8::Local<v8::Object> h_particle_group = WrapParticleGroup::NewInstance();
+		WrapParticleGroup* wrap_particle_group = WrapParticleGroup::Unwrap(h_particle_group);
+		// set up javascript particle group object
+		wrap_particle_group->SetupObject(info.This(), wrap_pgd, particle_group);
+		info.GetReturnValue().Set(h_particle_group);
+	}
+//	void JoinParticleGroups(b2ParticleGroup* groupA, b2ParticleGroup* groupB);
+//	void SplitParticleGroup(b2ParticleGroup* group);
+//	b2ParticleGroup* GetParticleGroupList();
+//	int32 GetParticleGroupCount() const;
+	NANX_METHOD(GetParticleCount)
+	{
+		WrapParticleSystem* wrap = Unwrap(info.This());
+		info.GetReturnValue().Set(Nan::New(wrap->m_particle_system->GetParticleCount()));
+	}
+//	int32 GetMaxParticleCount() const;
+//	void SetMaxParticleCount(int32 count);
+//	uint32 GetAllParticleFlags() const;
+//	uint32 GetAllGroupFlags() const;
+//	void SetPaused(bool paused);
+//	bool GetPaused() const;
+//	void SetDensity(float32 density);
+//	float32 GetDensity() const;
+//	void SetGravityScale(float32 gravityScale);
+//	float32 GetGravityScale() const;
+//	void SetDamping(float32 damping);
+//	float32 GetDamping() const;
+//	void SetStaticPressureIterations(int32 iterations);
+//	int32 GetStaticPressureIterations() const;
+//	void SetRadius(float32 radius);
+//	float32 GetRadius() const;
+	NANX_METHOD(GetRadius)
+	{
+		WrapParticleSystem* wrap = Unwrap(info.This());
+		info.GetReturnValue().Set(Nan::New(wrap->m_particle_system->GetRadius()));
+	}
+//	b2Vec2* GetPositionBuffer();
+//	b2Vec2* GetVelocityBuffer();
+//	b2ParticleColor* GetColorBuffer();
+//	b2ParticleGroup* const* GetGroupBuffer();
+//	float32* GetWeightBuffer();
+//	void** GetUserDataBuffer();
+//	const uint32* GetFlagsBuffer() const;
+//	void SetParticleFlags(int32 index, uint32 flags);
+//	uint32 GetParticleFlags(const int32 index);
+//	void SetFlagsBuffer(uint32* buffer, int32 capacity);
+//	void SetPositionBuffer(b2Vec2* buffer, int32 capacity);
+	NANX_METHOD(SetPositionBuffer)
+	{
+		WrapParticleSystem* wrap = Unwrap(info.This());
+		#if NODE_VERSION_AT_LEAST(4, 0, 0)
+		v8::Local<v8::Float32Array> _buffer = v8::Local<v8::Float32Array>::Cast(info[0]);
+		if (!_buffer->HasBuffer())
+		{
+			_buffer->Get(NANX_SYMBOL("buffer"));
+			assert(_buffer->HasBuffer());
+		}
+		int32 capacity = NANX_int32(info[1]);
+		b2Vec2* buffer = reinterpret_cast<b2Vec2*>(static_cast<char*>(_buffer->Buffer()->GetContents().Data()) + _buffer->ByteOffset());
+		#else
+		v8::Local<v8::Object> _buffer = v8::Local<v8::Object>::Cast(info[0]);
+		int32 capacity = NANX_int32(info[1]);
+		b2Vec2* buffer = static_cast<b2Vec2*>(_buffer->GetIndexedPropertiesExternalArrayData());
+		#endif
+		wrap->m_particle_system->SetPositionBuffer(buffer, capacity);
+	}
+//	void SetVelocityBuffer(b2Vec2* buffer, int32 capacity);
+	NANX_METHOD(SetVelocityBuffer)
+	{
+		WrapParticleSystem* wrap = Unwrap(info.This());
+		#if NODE_VERSION_AT_LEAST(4, 0, 0)
+		v8::Local<v8::Float32Array> _buffer = v8::Local<v8::Float32Array>::Cast(info[0]);
+		if (!_buffer->HasBuffer())
+		{
+			_buffer->Get(NANX_SYMBOL("buffer"));
+			assert(_buffer->HasBuffer());
+		}
+		int32 capacity = NANX_int32(info[1]);
+		b2Vec2* buffer = reinterpret_cast<b2Vec2*>(static_cast<char*>(_buffer->Buffer()->GetContents().Data()) + _buffer->ByteOffset());
+		#else
+		v8::Local<v8::Object> _buffer = v8::Local<v8::Object>::Cast(info[0]);
+		int32 capacity = NANX_int32(info[1]);
+		b2Vec2* buffer = static_cast<b2Vec2*>(_buffer->GetIndexedPropertiesExternalArrayData());
+		#endif
+		wrap->m_particle_system->SetVelocityBuffer(buffer, capacity);
+	}
+//	void SetColorBuffer(b2ParticleColor* buffer, int32 capacity);
+	NANX_METHOD(SetColorBuffer)
+	{
+		WrapParticleSystem* wrap = Unwrap(info.This());
+		#if NODE_VERSION_AT_LEAST(4, 0, 0)
+		v8::Local<v8::Uint8Array> _buffer = v8::Local<v8::Uint8Array>::Cast(info[0]);
+		if (!_buffer->HasBuffer())
+		{
+			_buffer->Get(NANX_SYMBOL("buffer"));
+			assert(_buffer->HasBuffer());
+		}
+		int32 capacity = NANX_int32(info[1]);
+		b2ParticleColor* buffer = reinterpret_cast<b2ParticleColor*>(static_cast<char*>(_buffer->Buffer()->GetContents().Data()) + _buffer->ByteOffset());
+		#else
+		v8::Local<v8::Object> _buffer = v8::Local<v8::Object>::Cast(info[0]);
+		int32 capacity = NANX_int32(info[1]);
+		b2ParticleColor* buffer = static_cast<b2ParticleColor*>(_buffer->GetIndexedPropertiesExternalArrayData());
+		#endif
+		wrap->m_particle_system->SetColorBuffer(buffer, capacity);
+	}
+//	void SetUserDataBuffer(void** buffer, int32 capacity);
+//	const b2ParticleContact* GetContacts() const;
+//	int32 GetContactCount() const;
+//	const b2ParticleBodyContact* GetBodyContacts() const;
+//	int32 GetBodyContactCount() const;
+//	const b2ParticlePair* GetPairs() const;
+//	int32 GetPairCount() const;
+//	const b2ParticleTriad* GetTriads() const;
+//	int32 GetTriadCount() const;
+//	void SetStuckThreshold(int32 iterations);
+//	const int32* GetStuckCandidates() const;
+//	int32 GetStuckCandidateCount() const;
+//	float32 ComputeCollisionEnergy() const;
+//	void SetStrictContactCheck(bool enabled);
+//	bool GetStrictContactCheck() const;
+//	void SetParticleLifetime(const int32 index, const float32 lifetime);
+//	float32 GetParticleLifetime(const int32 index);
+//	void SetDestructionByAge(const bool enable);
+//	bool GetDestructionByAge() const;
+//	const int32* GetExpirationTimeBuffer();
+//	float32 ExpirationTimeToLifetime(const int32 expirationTime) const;
+//	const int32* GetIndexByExpirationTimeBuffer();
+//	void ParticleApplyLinearImpulse(int32 index, const b2Vec2& impulse);
+//	void ApplyLinearImpulse(int32 firstIndex, int32 lastIndex, const b2Vec2& impulse);
+//	void ParticleApplyForce(int32 index, const b2Vec2& force);
+//	void ApplyForce(int32 firstIndex, int32 lastIndex, const b2Vec2& force);
+//	b2ParticleSystem* GetNext();
+//	void QueryAABB(b2QueryCallback* callback, const b2AABB& mass_data) const;
+//	void QueryShapeAABB(b2QueryCallback* callback, const b2Shape& shape, const b2Transform& xf) const;
+//	void RayCast(b2RayCastCallback* callback, const b2Vec2& point1, const b2Vec2& point2) const;
+//	void ComputeAABB(b2AABB* const mass_data) const;
+};
+
+#endif
+
+//// tile collision
+
+// trace the outlines of solid tiles into loops of tile corners; tile (x, y)
+// spans corners (x, y) to (x + 1, y + 1), solid stays on the left so outer
+// loops wind counter-clockwise and holes clockwise, collinear runs are merged
+
+struct TileLoop
+{
+	std::vector<b2Vec2> vertices; // tile corner coordinates
+	int32 x0, y0, x1, y1; // corner bounds
+};
+
+static bool IsTileSolid(const std::vector<uint8>& grid, int32 width, int32 height, int32 x, int32 y)
+{
+	return (x >= 0) && (x < width) && (y >= 0) && (y < height) && (grid[y * width + x] != 0);
+}
+
+static void TraceTileLoops(const std::vector<uint8>& grid, int32 width, int32 height, std::vector<TileLoop>& loops)
+{
+	struct Edge { int32 x, y, dir; bool used; };
+	static const int32 dx[4] = { 1, 0, -1, 0 };
+	static const int32 dy[4] = { 0, 1, 0, -1 };
+	const int32 stride = width + 1;
+	// boundary edges, indexed by start corner; a corner has at most two outgoing edges
+	std::vector<Edge> edges;
+	std::vector<int32> corner_edges(2 * stride * (height + 1), -1);
+	for (int32 y = 0; y < height; ++y)
+	{
+		for (int32 x = 0; x < width; ++x)
+		{
+			if (!IsTileSolid(grid, width, height, x, y)) { continue; }
+			Edge side[4] = { { x, y, 0, false }, { x + 1, y, 1, false }, { x + 1, y + 1, 2, false }, { x, y + 1, 3, false } };
+			bool open[4] = { !IsTileSolid(grid, width, height, x, y - 1), !IsTileSolid(grid, width, height, x + 1, y), !IsTileSolid(grid, width, height, x, y + 1), !IsTileSolid(grid, width, height, x - 1, y) };
+			for (int32 i = 0; i < 4; ++i)
+			{
+				if (!open[i]) { continue; }
+				int32 corner = 2 * (side[i].y * stride + side[i].x);
+				corner_edges[(corner_edges[corner] < 0)?(corner):(corner + 1)] = static_cast<int32>(edges.size());
+				edges.push_back(side[i]);
+			}
+		}
+	}
+	for (size_t start = 0; start < edges.size(); ++start)
+	{
+		if (edges[start].used) { continue; }
+		TileLoop loop;
+		loop.x0 = loop.x1 = edges[start].x;
+		loop.y0 = loop.y1 = edges[start].y;
+		int32 e = static_cast<int32>(start);
+		while ((e >= 0) && !edges[e].used)
+		{
+			Edge& edge = edges[e];
+			edge.used = true;
+			loop.x0 = b2Min(loop.x0, edge.x); loop.x1 = b2Max(loop.x1, edge.x);
+			loop.y0 = b2Min(loop.y0, edge.y); loop.y1 = b2Max(loop.y1, edge.y);
+			// pick the next edge; at a saddle turn left so diagonal tiles stay separate loops
+			int32 corner = 2 * ((edge.y + dy[edge.dir]) * stride + (edge.x + dx[edge.dir]));
+			int32 next = corner_edges[corner];
+			int32 other = corner_edges[corner + 1];
+			if ((other >= 0) && (edges[other].dir == (edge.dir + 1) % 4)) { next = other; }
+			// emit corners only where the direction changes
+			if ((next >= 0) && (edges[next].dir != edge.dir))
+			{
+				loop.vertices.push_back(b2Vec2(static_cast<float32>(edge.x + dx[edge.dir]), static_cast<float32>(edge.y + dy[edge.dir])));
+			}
+			e = next;
+		}
+		if (loop.vertices.size() >= 3)
+		{
+			loops.push_back(loop);
+		}
+	}
+}
+
+//// b2Prefab
+
+// a prefab is a Scene built from def objects by b2World.CreatePrefab; body positions are
+// relative to the prefab origin, and joints name their bodies (and gear joints their joints) by index
+
+static bool SceneCopyShape(const b2Shape* shape, SceneFixture& fixture)
+{
+	if (!shape) { return false; }
+	fixture.shape_type = shape->GetType();
+	fixture.chain_has_prev = false;
+	fixture.chain_has_next = false;
+	switch (fixture.shape_type)
+	{
+	case b2Shape::e_circle:
+		fixture.circle = *static_cast<const b2CircleShape*>(shape); // struct copy
+		return true;
+	case b2Shape::e_edge:
+		fixture.edge = *static_cast<const b2EdgeShape*>(shape); // struct copy
+		return true;
+	case b2Shape::e_polygon:
+		fixture.polygon = *static_cast<const b2PolygonShape*>(shape); // struct copy
+		return fixture.polygon.m_count >= 3;
+	case b2Shape::e_chain:
+	{
+		// the chain owns its vertices, so they are copied out and the chain is rebuilt per copy
+		const b2ChainShape* chain = static_cast<const b2ChainShape*>(shape);
+		if (chain->m_count < 2) { return false; }
+		fixture.chain.assign(chain->m_vertices, chain->m_vertices + chain->m_count);
+		fixture.chain_prev = chain->m_prevVertex;
+		fixture.chain_next = chain->m_nextVertex;
+		fixture.chain_has_prev = chain->m_hasPrevVertex;
+		fixture.chain_has_next = chain->m_hasNextVertex;
+		return true;
+	}
+	default:
+		return false;
+	}
+}
+
+class WrapPrefab : public Nan::ObjectWrap
+{
+private:
+	Scene m_scene;
+private:
+	WrapPrefab()
+	{
+		// a prefab leaves the world settings alone
+		m_scene.has_gravity = false;
+		for (int32 i = 0; i < static_cast<int32>(countof(m_scene.world_flags)); ++i) { m_scene.world_flags[i] = -1; }
+		m_scene.velocity_iterations = 8;
+		m_scene.position_iterations = 3;
+		m_scene.steps_per_second = 60.0f;
+	}
+	~WrapPrefab() {}
+public:
+	Scene& GetScene() { return m_scene; }
+public:
+	static WrapPrefab* Unwrap(v8::Local<v8::Value> value) { return (value->IsObject())?(Unwrap(v8::Local<v8::Object>::Cast(value))):(NULL); }
+	static WrapPrefab* Unwrap(v8::Local<v8::Object> object) { return Nan::ObjectWrap::Unwrap<WrapPrefab>(object); }
+public:
+	static NAN_MODULE_INIT(Init)
+	{
+		v8::Local<v8::Function> constructor = GetConstructor();
+		target->Set(constructor->GetName(), constructor);
+	}
+	static v8::Local<v8::Function> GetConstructor()
+	{
+		Nan::EscapableHandleScope scope;
+		v8::Local<v8::FunctionTemplate> function_template = GetFunctionTemplate();
+		v8::Local<v8::Function> constructor = function_template->GetFunction();
+		return scope.Escape(constructor);
+	}
+	static v8::Local<v8::FunctionTemplate> GetFunctionTemplate()
+	{
+		Nan::EscapableHandleScope scope;
+		static Nan::Persistent<v8::FunctionTemplate> g_function_template;
+		if (g_function_template.IsEmpty())
+		{
+			v8::Local<v8::FunctionTemplate> function_template = Nan::New<v8::FunctionTemplate>(New);
+			g_function_template.Reset(function_template);
+			function_template->SetClassName(NANX_SYMBOL("b2Prefab"));
+			function_template->InstanceTemplate()->SetInternalFieldCount(1);
+			v8::Local<v8::ObjectTemplate> prototype_template = function_template->PrototypeTemplate();
+			NANX_METHOD_APPLY(prototype_template, GetBodyCount)
+			NANX_METHOD_APPLY(prototype_template, GetJointCount)
+		}
+		v8::Local<v8::FunctionTemplate> function_template = Nan::New<v8::FunctionTemplate>(g_function_template);
+		return scope.Escape(function_template);
+	}
+	static v8::Local<v8::Object> NewInstance()
+	{
+		Nan::EscapableHandleScope scope;
+		v8::Local<v8::Function> constructor = GetConstructor();
+		v8::Local<v8::Object> instance = constructor->NewInstance();
+		return scope.Escape(instance);
+	}
+private:
+	static NAN_METHOD(New)
+	{
+		if (info.IsConstructCall())
+		{
+			WrapPrefab* wrap = new WrapPrefab();
+			wrap->Wrap(info.This());
+			info.GetReturnValue().Set(info.This());
+		}
+		else
+		{
+			v8::Local<v8::Function> constructor = GetConstructor();
+			info.GetReturnValue().Set(constructor->NewInstance());
+		}
+	}
+	NANX_METHOD(GetBodyCount)
+	{
+		WrapPrefab* wrap = Unwrap(info.This());
+		info.GetReturnValue().Set(Nan::New(static_cast<int32>(wrap->m_scene.bodies.size())));
+	}
+	NANX_METHOD(GetJointCount)
+	{
+		WrapPrefab* wrap = Unwrap(info.This());
+		info.GetReturnValue().Set(Nan::New(static_cast<int32>(wrap->m_scene.joints.size())));
+	}
+};
+
+//// b2World
+
+// the module exports, which node-box2d.js extends with the stock callback classes
+static Nan::Persistent<v8::Object>& ModuleExports()
+{
+	static Nan::Persistent<v8::Object> g_exports;
+	return g_exports;
+}
+
+// true if h_method is the one node-box2d.js puts on the prototype of class_name; those are
+// empty or, for b2ContactFilter, the default filter, so the engine can skip calling them
+static bool IsStockMethod(const char* class_name, const char* method_name, v8::Local<v8::Value> h_method)
+{
+	if (ModuleExports().IsEmpty()) { return false; }
+	v8::Local<v8::Value> h_class = Nan::New<v8::Object>(ModuleExports())->Get(NANX_SYMBOL(class_name));
+	if (!h_class->IsObject()) { return false; }
+	v8::Local<v8::Value> h_prototype = v8::Local<v8::Object>::Cast(h_class)->Get(NANX_SYMBOL("prototype"));
+	if (!h_prototype->IsObject()) { return false; }
+	return v8::Local<v8::Object>::Cast(h_prototype)->Get(NANX_SYMBOL(method_name))->StrictEquals(h_method);
+}
+
+class WrapWorld : public Nan::ObjectWrap
+{
+private:
+	enum CallbackType
+	{
+		e_callbackSayGoodbye,
+		e_callbackShouldCollide,
+		e_callbackBeginContact,
+		e_callbackEndContact,
+		e_callbackPreSolve,
+		e_callbackPostSolve,
+		e_callbackDraw,
+		e_callbackQuery,
+		e_callbackRayCast,
+		e_callbackCount
+	};
+	enum ContactListenerMethod
+	{
+		e_beginContact,
+		e_endContact,
+		e_beginContactFixtureParticle,
+		e_endContactFixtureParticle,
+		e_beginContactParticleParticle,
+		e_endContactParticleParticle,
+		e_preSolve,
+		e_postSolve,
+		e_contactListenerMethodCount
+	};
+	struct CallbackStat
+	{
+		int32 count;
+		float64 ms;
+	};
+	// times one javascript callback when callback stats are enabled
+	class ScopedCallbackStat
+	{
+	private:
+		WrapWorld* m_wrap_world;
+		CallbackType m_type;
+		float64 m_start;
+		AllocScope m_alloc_scope; // objects made from javascript may outlive the world
+	public:
+		ScopedCallbackStat(WrapWorld* wrap, CallbackType type) : m_wrap_world(wrap->m_callback_stats_enabled?wrap:NULL), m_type(type), m_start(0.0), m_alloc_scope(NULL)
+		{
+			if (m_wrap_world) { m_start = m_wrap_world->m_callback_timer.GetMilliseconds(); }
+		}
+		~ScopedCallbackStat()
+		{
+			if (m_wrap_world)
+			{
+				CallbackStat& stat = m_wrap_world->m_callback_stats[m_type];
+				++stat.count;
+				stat.ms += m_wrap_world->m_callback_timer.GetMilliseconds() - m_start;
+			}
+		}
+	};
+
+private:
+	class WrapDestructionListener : public b2DestructionListener
+	{
+	public:
+		WrapWorld* m_wrap_world;
+	public:
+		WrapDestructionListener(WrapWorld* wrap) : m_wrap_world(wrap) {}
+		~WrapDestructionListener() { m_wrap_world = NULL; }
+	public:
+		virtual void SayGoodbye(b2Joint* joint);
+		virtual void SayGoodbye(b2Fixture* fixture);
+		#if B2_ENABLE_PARTICLE
+		virtual void SayGoodbye(b2ParticleGroup* group);
+		virtual void SayGoodbye(b2ParticleSystem* particleSystem, int32 index);
+		#endif
+	};
+
+private:
+	class WrapContactFilter : public b2ContactFilter
+	{
+	public:
+		WrapWorld* m_wrap_world;
+	public:
+		WrapContactFilter(WrapWorld* wrap) : m_wrap_world(wrap) {}
+		~WrapContactFilter() { m_wrap_world = NULL; }
+	public:
+		virtual bool ShouldCollide(b2Fixture* fixtureA, b2Fixture* fixtureB);
+		#if B2_ENABLE_PARTICLE
+		virtual bool ShouldCollide(b2Fixture* fixture, b2ParticleSystem* particleSystem, int32 particleIndex);
+		virtual bool ShouldCollide(b2ParticleSystem* particleSystem, int32 particleIndexA, int32 particleIndexB);
+		#endif
+	};
+
+private:
+	class WrapContactListener : public b2ContactListener
+	{
+	public:
+		WrapWorld* m_wrap_world;
+	public:
+		WrapContactListener(WrapWorld* wrap) : m_wrap_world(wrap) {}
+		~WrapContactListener() { m_wrap_world = NULL; }
+	public:
+		virtual void BeginContact(b2Contact* contact);
+		virtual void EndContact(b2Contact* contact);
+		#if B2_ENABLE_PARTICLE
+		virtual void BeginContact(b2ParticleSystem* particleSystem, b2ParticleBodyContact* particleBodyContact);
+		virtual void EndContact(b2Fixture* fixture, b2ParticleSystem* particleSystem, int32 index);
+		virtual void BeginContact(b2ParticleSystem* particleSystem, b2ParticleContact* particleContact);
+		virtual void EndContact(b2ParticleSystem* particleSystem, int32 indexA, int32 indexB);
+		#endif
+		virtual void PreSolve(b2Contact* contact, const b2Manifold* oldManifold);
+		virtual void PostSolve(b2Contact* contact, const b2ContactImpulse* impulse);
+	};
+
+private:
+	class WrapDraw : public b2Draw
+	{
+	public:
+		WrapWorld* m_wrap_world;
+	public:
+		WrapDraw(WrapWorld* wrap) : m_wrap_world(wrap) {}
+		~WrapDraw() { m_wrap_world = NULL; }
+	public:
+		virtual void DrawPolygon(const b2Vec2* vertices, int32 vertexCount, const b2Color& color);
+		virtual void DrawSolidPolygon(const b2Vec2* vertices, int32 vertexCount, const b2Color& color);
+		virtual void DrawCircle(const b2Vec2& center, float32 radius, const b2Color& color);
+		virtual void DrawSolidCircle(const b2Vec2& center, float32 radius, const b2Vec2& axis, const b2Color& color);
+		#if B2_ENABLE_PARTICLE
+		virtual void DrawParticles(const b2Vec2 *centers, float32 radius, const b2ParticleColor *colors, int32 count);
+		#endif
+		virtual void DrawSegment(const b2Vec2& p1, const b2Vec2& p2, const b2Color& color);
+		virtual void DrawTransform(const b2Transform& xf);
+	};
+
+private:
+	class WrapQueryCallback : public b2QueryCallback
+	{
+	private:
+		WrapWorld* m_wrap_world;
+		v8::Local<v8::Function> m_callback;
+	public:
+		WrapQueryCallback(WrapWorld* wrap, v8::Local<v8::Function> callback) : m_wrap_world(wrap), m_callback(callback) {}
+		bool ReportFixture(b2Fixture* fixture)
+		{
+			// get fixture internal data
+			WrapFixture* wrap_fixture = WrapFixture::GetWrap(fixture);
+			v8::Local<v8::Object> h_fixture = wrap_fixture->handle();
+			v8::Local<v8::Value> argv[] = { h_fixture };
+			ScopedCallbackStat callback_stat(m_wrap_world, e_callbackQuery);
+			return NANX_bool(Nan::MakeCallback(Nan::GetCurrentContext()->Global(), m_callback, countof(argv), argv));
+		}
+		#if B2_ENABLE_PARTICLE
+		bool ReportParticle(const b2ParticleSystem* particleSystem, int32 index)
+		{
+			// TODO
+			return b2QueryCallback::ReportParticle(particleSystem, index);
+		}
+		bool ShouldQueryParticleSystem(const b2ParticleSystem* particleSystem)
+		{
+			// TODO
+			return b2QueryCallback::ShouldQueryParticleSystem(particleSystem);
+		}
+		#endif
+	};
+
+private:
+	class WrapRayCastCallback : public b2RayCastCallback
+	{
+	private:
+		WrapWorld* m_wrap_world;
+		v8::Local<v8::Function> m_callback;
+	public:
+		WrapRayCastCallback(WrapWorld* wrap, v8::Local<v8::Function> callback) : m_wrap_world(wrap), m_callback(callback) {}
+		float32 ReportFixture(b2Fixture* fixture, const b2Vec2& point, const b2Vec2& normal, float32 fraction)
+		{
+			// get fixture internal data
+			WrapFixture* wrap_fixture = WrapFixture::GetWrap(fixture);
+			v8::Local<v8::Object> h_fixture = wrap_fixture->handle();
+			v8::Local<v8::Object> h_point = WrapVec2::NewInstance(point);
+			v8::Local<v8::Object> h_normal = WrapVec2::NewInstance(normal);
+			v8::Local<v8::Number> h_fraction = Nan::New(fraction);
+			v8::Local<v8::Value> argv[] = { h_fixture, h_point, h_normal, h_fraction };
+			ScopedCallbackStat callback_stat(m_wrap_world, e_callbackRayCast);
+			return NANX_float32(Nan::MakeCallback(Nan::GetCurrentContext()->Global(), m_callback, countof(argv), argv));
+		}
+		#if B2_ENABLE_PARTICLE
+		float32 ReportParticle(const b2ParticleSystem* particleSystem, int32 index, const b2Vec2& point, const b2Vec2& normal, float32 fraction)
+		{
+			// TODO:
+			return b2RayCastCallback::ReportParticle(particleSystem, index, point, normal, fraction);
+		}
+		bool ShouldQueryParticleSystem(const b2ParticleSystem* particleSystem)
+		{
+			// TODO:
+			return b2RayCastCallback::ShouldQueryParticleSystem(particleSystem);
+		}
+		#endif
+	};
+
+private:
+	Arena m_arena; // declared first so it is released after everything that points into it
+	AllocStats m_alloc_stats; // declared before m_world so it outlives the world's last free
+	std::list<AllocStats> m_particle_alloc_stats; // one per particle system; block allocator chunks they grow stay with the world
+	AllocScope m_alloc_setup; // charges the b2World constructor to this world
+	b2World m_world;
+	Nan::Persistent<v8::Object> m_destruction_listener;
+	WrapDestructionListener m_wrap_destruction_listener;
+	Nan::Persistent<v8::Object> m_contact_filter;
+	Nan::Persistent<v8::Function> m_contact_filter_method; // ShouldCollide, looked up once by SetContactFilter
+	WrapContactFilter m_wrap_contact_filter;
+	Nan::Persistent<v8::Object> m_contact_listener;
+	Nan::Persistent<v8::Function> m_contact_listener_methods[e_contactListenerMethodCount]; // looked up once by SetContactListener
+	WrapContactListener m_wrap_contact_listener;
+	Nan::Persistent<v8::Object> m_draw;
+	WrapDraw m_wrap_draw;
+	std::vector<b2Body*> m_body_table; // body id -> box2d body
+	std::vector<int32> m_body_table_free; // recycled body ids
+	std::vector<b2Joint*> m_joint_table; // joint id -> box2d joint
+	std::vector<int32> m_joint_table_free; // recycled joint ids
+	std::map<b2Joint*,int32> m_joint_ids; // box2d joint -> joint id; native joints have no object to hold it
+	struct TileCollision
+	{
+		int32 width, height;
+		float32 tileSize;
+		std::vector<uint8> grid;
+		b2FixtureDef fd; // shape and userData unused
+		std::vector<TileLoop> loops;
+		std::vector<b2Fixture*> fixtures; // one chain loop fixture per loop
+	};
+	std::map<b2Body*,TileCollision> m_tile_collisions; // keyed by static tile body
+	BodyTickMap m_body_ticks; // bodies stepped at a reduced rate
+	uint32 m_tick; // steps taken; wraps cleanly for power of two divisors
+	Recorder m_recorder; // mutation log while recording
+	float32 m_accumulator; // time left over by Advance
+	struct Interpolation
+	{
+		int32 body_id;
+		b2Vec2 position; // before the last step
+		float32 angle; // before the last step
+	};
+	std::vector<Interpolation> m_interpolation; // bodies registered with SetInterpolationBodies
+	std::vector<b2Profile> m_profile_history; // ring buffer of the last steps
+	int32 m_profile_window;
+	int32 m_profile_next;
+	int32 m_profile_count;
+	bool m_callback_stats_enabled;
+	CallbackStat m_callback_stats[e_callbackCount];
+	b2Timer m_callback_timer;
+private:
+	WrapWorld(const b2Vec2& gravity, size_t arena_size) :
+		m_arena(arena_size),
+		m_alloc_stats((arena_size > 0)?(&m_arena):(NULL)),
+		m_alloc_setup(&m_alloc_stats),
+		m_world(gravity),
+		m_wrap_destruction_listener(this),
+		m_wrap_contact_filter(this),
+		m_wrap_contact_listener(this),
+		m_wrap_draw(this),
+		m_tick(0),
+		m_accumulator(0.0f),
+		m_profile_window(60),
+		m_profile_next(0),
+		m_profile_count(0),
+		m_callback_stats_enabled(false)
+	{
+		Nan::AdjustExternalMemory(sizeof(WrapWorld));
+		m_alloc_setup.Leave();
+		ResetCallbackStats();
+		m_world.SetDestructionListener(&m_wrap_destruction_listener);
+		m_world.SetContactFilter(&m_wrap_contact_filter);
+		m_world.SetContactListener(&m_wrap_contact_listener);
+		m_world.SetDebugDraw(&m_wrap_draw);
+	}
+	~WrapWorld()
+	{
+		m_world.SetDestructionListener(NULL);
+		m_world.SetContactFilter(NULL);
+		m_world.SetContactListener(NULL);
+		m_world.SetDebugDraw(NULL);
+		m_destruction_listener.Reset();
+		m_contact_filter.Reset();
+		m_contact_filter_method.Reset();
+		m_contact_listener.Reset();
+		for (int32 i = 0; i < e_contactListenerMethodCount; ++i)
+		{
+			m_contact_listener_methods[i].Reset();
+		}
+		m_draw.Reset();
+		// m_world frees everything it still holds after this; with an arena those frees only fill
+		// its free lists and m_arena then returns all of its pages at once
+		size_t reported = m_alloc_stats.reported;
+		for (std::list<AllocStats>::const_iterator it = m_particle_alloc_stats.begin(); it != m_particle_alloc_stats.end(); ++it)
+		{
+			reported += it->reported;
+		}
+		Nan::AdjustExternalMemory(-static_cast<int>(sizeof(WrapWorld) + reported));
+	}
+public:
+	b2World* Peek() { return &m_world; }
+public:
+	int32 AddBodyId(b2Body* body)
+	{
+		if (!m_body_table_free.empty())
+		{
+			int32 body_id = m_body_table_free.back();
+			m_body_table_free.pop_back();
+			m_body_table[body_id] = body;
+			return body_id;
+		}
+		m_body_table.push_back(body);
+		return static_cast<int32>(m_body_table.size()) - 1;
+	}
+	void RemoveBodyId(int32 body_id)
+	{
+		if ((body_id >= 0) && (body_id < static_cast<int32>(m_body_table.size())) && m_body_table[body_id])
+		{
+			m_body_table[body_id] = NULL;
+			m_body_table_free.push_back(body_id);
+			// the id may be reused; interpolation must not blend into the next body that gets it
+			for (size_t i = 0; i < m_interpolation.size(); ++i)
+			{
+				if (m_interpolation[i].body_id == body_id) { m_interpolation[i].body_id = -1; }
+			}
+		}
+	}
+	b2Body* GetBodyById(int32 body_id) const
+	{
+		return ((body_id >= 0) && (body_id < static_cast<int32>(m_body_table.size())))?(m_body_table[body_id]):(NULL);
+	}
+	int32 AddJointId(b2Joint* joint)
+	{
+		int32 joint_id;
+		if (!m_joint_table_free.empty())
+		{
+			joint_id = m_joint_table_free.back();
+			m_joint_table_free.pop_back();
+			m_joint_table[joint_id] = joint;
+		}
+		else
+		{
+			m_joint_table.push_back(joint);
+			joint_id = static_cast<int32>(m_joint_table.size()) - 1;
+		}
+		m_joint_ids[joint] = joint_id;
+		return joint_id;
+	}
+	void RemoveJointId(b2Joint* joint)
+	{
+		std::map<b2Joint*,int32>::iterator it = m_joint_ids.find(joint);
+		if (it != m_joint_ids.end())
+		{
+			m_joint_table[it->second] = NULL;
+			m_joint_table_free.push_back(it->second);
+			m_joint_ids.erase(it);
+		}
+	}
+	b2Joint* GetJointById(int32 joint_id) const
+	{
+		return ((joint_id >= 0) && (joint_id < static_cast<int32>(m_joint_table.size())))?(m_joint_table[joint_id]):(NULL);
+	}
+	static void ResetJointObject(b2Joint* joint)
+	{
+		// reset javascript joint object, if any
+		WrapJoint* wrap_joint = WrapJoint::GetWrap(joint);
+		if (!wrap_joint) { return; }
+		switch (joint->GetType())
+		{
+		case e_revoluteJoint: static_cast<WrapRevoluteJoint*>(wrap_joint)->ResetObject(); break;
+		case e_prismaticJoint: static_cast<WrapPrismaticJoint*>(wrap_joint)->ResetObject(); break;
+		case e_distanceJoint: static_cast<WrapDistanceJoint*>(wrap_joint)->ResetObject(); break;
+		case e_pulleyJoint: static_cast<WrapPulleyJoint*>(wrap_joint)->ResetObject(); break;
+		case e_mouseJoint: static_cast<WrapMouseJoint*>(wrap_joint)->ResetObject(); break;
+		case e_gearJoint: static_cast<WrapGearJoint*>(wrap_joint)->ResetObject(); break;
+		case e_wheelJoint: static_cast<WrapWheelJoint*>(wrap_joint)->ResetObject(); break;
+		case e_weldJoint: static_cast<WrapWeldJoint*>(wrap_joint)->ResetObject(); break;
+		case e_frictionJoint: static_cast<WrapFrictionJoint*>(wrap_joint)->ResetObject(); break;
+		case e_ropeJoint: static_cast<WrapRopeJoint*>(wrap_joint)->ResetObject(); break;
+		case e_motorJoint: static_cast<WrapMotorJoint*>(wrap_joint)->ResetObject(); break;
+		default: wrap_joint->ResetObject(); break;
+		}
+	}
+	void DestroyBodyQuiet(b2Body* body)
+	{
+		// reset javascript joint and fixture objects while the box2d objects are still alive
+		for (b2JointEdge* je = body->GetJointList(); je; je = je->next)
+		{
+			ResetJointObject(je->joint);
+			RemoveJointId(je->joint);
+		}
+		for (b2Fixture* fixture = body->GetFixtureList(); fixture; fixture = fixture->GetNext())
+		{
+			WrapFixture* wrap_fixture = WrapFixture::GetWrap(fixture);
+			if (wrap_fixture) { wrap_fixture->ResetObject(); }
+		}
+		// reset javascript body object
+		WrapBody* wrap_body = WrapBody::GetWrap(body);
+		if (wrap_body)
+		{
+			RemoveBodyId(wrap_body->GetId());
+			wrap_body->ResetObject();
+		}
+		m_tile_collisions.erase(body);
+		m_body_ticks.erase(body);
+		// delete box2d body; joints and fixtures go with it
+		m_world.DestroyBody(body);
+	}
+	bool ResetArena()
+	{
+		// an empty world is rebuilt so its block allocator chunks go back with the arena pages;
+		// particle systems have javascript objects pointing into the world, so they keep it alive
+		if (!m_arena.IsEnabled() || m_world.GetBodyList()) { return false; }
+		#if B2_ENABLE_PARTICLE
+		if (m_world.GetParticleSystemList()) { return false; }
+		#endif
+		b2Vec2 gravity = m_world.GetGravity();
+		bool allowSleeping = m_world.GetAllowSleeping();
+		bool warmStarting = m_world.GetWarmStarting();
+		bool continuousPhysics = m_world.GetContinuousPhysics();
+		bool subStepping = m_world.GetSubStepping();
+		bool autoClearForces = m_world.GetAutoClearForces();
+		m_world.~b2World();
+		m_arena.Release();
+		new (&m_world) b2World(gravity);
+		m_world.SetAllowSleeping(allowSleeping);
+		m_world.SetWarmStarting(warmStarting);
+		m_world.SetContinuousPhysics(continuousPhysics);
+		m_world.SetSubStepping(subStepping);
+		m_world.SetAutoClearForces(autoClearForces);
+		m_world.SetDestructionListener(&m_wrap_destruction_listener);
+		m_world.SetContactFilter(&m_wrap_contact_filter);
+		m_world.SetContactListener(&m_wrap_contact_listener);
+		m_world.SetDebugDraw(&m_wrap_draw);
+		return true;
+	}
+	static bool IsTickDivisor(int32 divisor)
+	{
+		return (divisor == 1) || (divisor == 2) || (divisor == 4) || (divisor == 8);
+	}
+	bool IsBodyTick(const BodyTick& tick) const
+	{
+		return ((m_tick + static_cast<uint32>(tick.phase)) % static_cast<uint32>(tick.divisor)) == 0;
+	}
+	void SetBodyTick(b2Body* body, int32 divisor, int32 phase)
+	{
+		BodyTickMap::iterator it = m_body_ticks.find(body);
+		if (divisor <= 1)
+		{
+			if (it != m_body_ticks.end())
+			{
+				ThawBody(body, it->second);
+				m_body_ticks.erase(it);
+			}
+			return;
+		}
+		if (it == m_body_ticks.end())
+		{
+			it = m_body_ticks.insert(std::make_pair(body, BodyTick())).first;
+		}
+		it->second.divisor = divisor;
+		it->second.phase = ((phase % divisor) + divisor) % divisor;
+		it->second.visit = m_tick - 1; // classify at the next step
+	}
+	void ThawBody(b2Body* body, BodyTick& tick)
+	{
+		// wake a body we put to sleep and hand back its velocity, plus anything it picked up since
+		if (!tick.frozen) { return; }
+		tick.frozen = false;
+		body->SetAwake(true);
+		body->SetLinearVelocity(body->GetLinearVelocity() + tick.linear_velocity);
+		body->SetAngularVelocity(body->GetAngularVelocity() + tick.angular_velocity);
+		body->ApplyForceToCenter(tick.dropped_force, false);
+		body->ApplyTorque(tick.dropped_torque, false);
+		tick.dropped_force.SetZero();
+		tick.dropped_torque = 0.0f;
+	}
+	void FreezeBody(b2Body* body, BodyTick& tick)
+	{
+		// SetAwake(false) zeroes velocity and force; keep both for the next step it takes
+		tick.frozen = true;
+		tick.linear_velocity = body->GetLinearVelocity();
+		tick.angular_velocity = body->GetAngularVelocity();
+		tick.dropped_force = tick.force;
+		tick.dropped_torque = tick.torque;
+		body->SetAwake(false);
+	}
+	static void AddFrozenForce(b2Body* body, BodyTick& tick, float32 timeStep)
+	{
+		// the forces of a step spent frozen go into the kept velocity, as the solver would have added them
+		const float32 mass = body->GetMass();
+		const float32 inertia = body->GetInertia() - mass * b2Dot(body->GetLocalCenter(), body->GetLocalCenter());
+		tick.linear_velocity += ((mass > 0.0f)?(timeStep / mass):(0.0f)) * tick.force;
+		tick.angular_velocity += ((inertia > 0.0f)?(timeStep / inertia):(0.0f)) * tick.torque;
+	}
+	static bool IsScaleFreeJoint(b2Joint* joint)
+	{
+		// rigid constraints solve the same in scaled velocities; motors, springs and friction
+		// limits are given per second or per step and would need scaling per joint type
+		switch (joint->GetType())
+		{
+		case e_revoluteJoint: return !static_cast<b2RevoluteJoint*>(joint)->IsMotorEnabled();
+		case e_prismaticJoint: return !static_cast<b2PrismaticJoint*>(joint)->IsMotorEnabled();
+		case e_distanceJoint: return static_cast<b2DistanceJoint*>(joint)->GetFrequency() == 0.0f;
+		case e_weldJoint: return static_cast<b2WeldJoint*>(joint)->GetFrequency() == 0.0f;
+		case e_pulleyJoint: return true;
+		case e_gearJoint: return true;
+		case e_ropeJoint: return true;
+		default: return false; // wheel, mouse, friction, motor
+		}
+	}
+	void VisitTickIsland(b2Body* other, const BodyTick& seed, std::vector<BodyTickMap::iterator>& stack, bool& mixed)
+	{
+		// islands do not propagate across static bodies
+		if (other->GetType() == b2_staticBody) { return; }
+		BodyTickMap::iterator it = m_body_ticks.find(other);
+		if ((it == m_body_ticks.end()) || (other->GetType() != b2_dynamicBody) || (it->second.divisor != seed.divisor) || (it->second.phase != seed.phase))
+		{
+			// another rate; not expanded, as reduced rate bodies behind it find it from their own side
+			mixed = true;
+			return;
+		}
+		if (it->second.visit == m_tick) { return; }
+		it->second.visit = m_tick;
+		stack.push_back(it);
+	}
+	void ClassifyTickIsland(BodyTickMap::iterator seed)
+	{
+		// an island keeps its reduced rate only if every body in it shares the same divisor and phase;
+		// touching (or jointed to) anything stepped at another rate puts the whole island at full rate,
+		// and so does a joint with a motor, spring or friction limit, whose targets are not scaled
+		std::vector<BodyTickMap::iterator> stack(1, seed);
+		std::vector<BodyTickMap::iterator> island;
+		bool mixed = false;
+		seed->second.visit = m_tick;
+		while (!stack.empty())
+		{
+			BodyTickMap::iterator it = stack.back();
+			stack.pop_back();
+			island.push_back(it);
+			for (b2ContactEdge* ce = it->first->GetContactList(); ce; ce = ce->next)
+			{
+				b2Contact* contact = ce->contact;
+				if (!contact->IsEnabled() || !contact->IsTouching()) { continue; }
+				if (contact->GetFixtureA()->IsSensor() || contact->GetFixtureB()->IsSensor()) { continue; }
+				VisitTickIsland(ce->other, seed->second, stack, mixed);
+			}
+			for (b2JointEdge* je = it->first->GetJointList(); je; je = je->next)
+			{
+				if (!IsScaleFreeJoint(je->joint)) { mixed = true; }
+				VisitTickIsland(je->other, seed->second, stack, mixed);
+			}
+		}
+		for (size_t i = 0; i < island.size(); ++i)
+		{
+			island[i]->second.promoted = mixed;
+		}
+	}
+	void BeginBodyTicks(float32 timeStep)
+	{
+		for (BodyTickMap::iterator it = m_body_ticks.begin(); it != m_body_ticks.end(); ++it)
+		{
+			b2Body* body = it->first;
+			BodyTick& tick = it->second;
+			tick.scaled = false;
+			if ((body->GetType() != b2_dynamicBody) || !body->IsActive())
+			{
+				ThawBody(body, tick);
+				continue;
+			}
+			// woken between steps by a contact or the caller
+			if (tick.frozen && body->IsAwake()) { ThawBody(body, tick); }
+			if (tick.visit != m_tick) { ClassifyTickIsland(it); }
+			bool on_tick = tick.promoted || IsBodyTick(tick);
+			if (on_tick) { ThawBody(body, tick); }
+			if (tick.frozen)
+			{
+				// still between its steps
+				AddFrozenForce(body, tick, timeStep);
+				continue;
+			}
+			// asleep on its own; contacts wake it as usual
+			if (!body->IsAwake()) { continue; }
+			if (tick.promoted)
+			{
+				// at full rate b2Body's own sleep timer runs
+				tick.rest_time = 0.0f;
+				continue;
+			}
+			if (on_tick)
+			{
+				// cover divisor steps at once: x += k dt v and v += k dt g, solved in velocities scaled by k;
+				// forces act for one step, so k f gives them their unscaled effect
+				float32 k = static_cast<float32>(tick.divisor);
+				tick.scaled = true;
+				tick.gravity_scale = body->GetGravityScale();
+				tick.linear_damping = body->GetLinearDamping();
+				tick.angular_damping = body->GetAngularDamping();
+				body->SetLinearVelocity(k * body->GetLinearVelocity());
+				body->SetAngularVelocity(k * body->GetAngularVelocity());
+				body->SetGravityScale(k * k * tick.gravity_scale);
+				body->SetLinearDamping(k * tick.linear_damping);
+				body->SetAngularDamping(k * tick.angular_damping);
+				body->ApplyForceToCenter((k - 1.0f) * tick.force, false);
+				body->ApplyTorque((k - 1.0f) * tick.torque, false);
+			}
+			else if (m_world.GetAllowSleeping() && body->IsSleepingAllowed() && (tick.rest_time >= b2_timeToSleep))
+			{
+				// b2Body restarts its sleep timer whenever a frozen body wakes, so the rest time
+				// counted over its own steps decides; asleep like any other body from here
+				SleepBodyTick(&m_body_ticks, body);
+				tick.rest_time = 0.0f;
+				body->SetAwake(false);
+			}
+			else
+			{
+				// sit this step out
+				FreezeBody(body, tick);
+				AddFrozenForce(body, tick, timeStep);
+			}
+		}
+	}
+	void EndBodyTicks(float32 timeStep)
+	{
+		const bool clear_forces = m_world.GetAutoClearForces();
+		for (BodyTickMap::iterator it = m_body_ticks.begin(); it != m_body_ticks.end(); ++it)
+		{
+			b2Body* body = it->first;
+			BodyTick& tick = it->second;
+			if (clear_forces)
+			{
+				// the step has cleared the bodies' own accumulators
+				tick.force.SetZero();
+				tick.torque = 0.0f;
+				tick.dropped_force.SetZero();
+				tick.dropped_torque = 0.0f;
+			}
+			if (tick.scaled)
+			{
+				float32 k = static_cast<float32>(tick.divisor);
+				tick.scaled = false;
+				body->SetLinearVelocity((1.0f / k) * body->GetLinearVelocity());
+				body->SetAngularVelocity((1.0f / k) * body->GetAngularVelocity());
+				body->SetGravityScale(tick.gravity_scale);
+				body->SetLinearDamping(tick.linear_damping);
+				body->SetAngularDamping(tick.angular_damping);
+				if (!clear_forces)
+				{
+					// take the extra (k - 1) f back off the accumulators
+					body->ApplyForceToCenter((1.0f - k) * tick.force, false);
+					body->ApplyTorque((1.0f - k) * tick.torque, false);
+				}
+				b2Vec2 v = body->GetLinearVelocity();
+				float32 w = body->GetAngularVelocity();
+				bool slow = (b2Dot(v, v) <= b2_linearSleepTolerance * b2_linearSleepTolerance) &&
+					(w * w <= b2_angularSleepTolerance * b2_angularSleepTolerance);
+				tick.rest_time = (slow)?(tick.rest_time + k * timeStep):(0.0f);
+			}
+			else if (tick.frozen && body->IsAwake())
+			{
+				// woken mid-step by a new contact: carry on with the impulse it took on top of its own velocity
+				ThawBody(body, tick);
+			}
+		}
+	}
+	void ClearForces()
+	{
+		m_world.ClearForces();
+		for (BodyTickMap::iterator it = m_body_ticks.begin(); it != m_body_ticks.end(); ++it)
+		{
+			BodyTick& tick = it->second;
+			tick.force.SetZero();
+			tick.torque = 0.0f;
+			tick.dropped_force.SetZero();
+			tick.dropped_torque = 0.0f;
+		}
+	}
+	void StepWorld(float32 timeStep, int32 velocityIterations, int32 positionIterations, int32 particleIterations)
+	{
+		if (m_recorder.IsRecording())
+		{
+			m_recorder.Op(e_recordStep).Float(timeStep).Int(velocityIterations).Int(positionIterations).Int(particleIterations);
+		}
+		bool body_ticks = !m_body_ticks.empty();
+		if (body_ticks) { BeginBodyTicks(timeStep); }
+		#if B2_ENABLE_PARTICLE
+		m_world.Step(timeStep, velocityIterations, positionIterations, particleIterations);
+		#else
+		m_world.Step(timeStep, velocityIterations, positionIterations);
+		#endif
+		if (body_ticks) { EndBodyTicks(timeStep); }
+		++m_tick;
+		// keep the step profile for rolling statistics
+		if (m_profile_window > 0)
+		{
+			if (m_profile_history.size() != static_cast<size_t>(m_profile_window))
+			{
+				m_profile_history.resize(m_profile_window);
+			}
+			m_profile_history[m_profile_next] = m_world.GetProfile(); // struct copy
+			m_profile_next = (m_profile_next + 1) % m_profile_window;
+			m_profile_count = b2Min(m_profile_count + 1, m_profile_window);
+		}
+	}
+	bool CanStepOffThread() const
+	{
+		// stepping calls into javascript only through these
+		if (!m_destruction_listener.IsEmpty() || !m_contact_filter_method.IsEmpty()) { return false; }
+		for (int32 i = 0; i < e_contactListenerMethodCount; ++i)
+		{
+			if (!m_contact_listener_methods[i].IsEmpty()) { return false; }
+		}
+		return true;
+	}
+	struct StepWorldsJob
+	{
+		std::vector<WrapWorld*> worlds;
+		std::vector<int32> particleIterations; // per world
+		float32 timeStep;
+		int32 velocityIterations;
+		int32 positionIterations;
+		size_t next; // next world to claim
+		uv_mutex_t mutex;
+	};
+	static void StepWorldsThread(void* arg)
+	{
+		// no v8 here; the caller reports external memory once every thread is done
+		StepWorldsJob* job = static_cast<StepWorldsJob*>(arg);
+		for (;;)
+		{
+			uv_mutex_lock(&job->mutex);
+			size_t index = job->next++;
+			uv_mutex_unlock(&job->mutex);
+			if (index >= job->worlds.size()) { break; }
+			WrapWorld* wrap = job->worlds[index];
+			AllocScope alloc_scope(&wrap->m_alloc_stats, false);
+			wrap->StepWorld(job->timeStep, job->velocityIterations, job->positionIterations, job->particleIterations[index]);
+		}
+	}
+	void ResetCallbackStats()
+	{
+		for (int32 i = 0; i < e_callbackCount; ++i)
+		{
+			m_callback_stats[i].count = 0;
+			m_callback_stats[i].ms = 0.0;
+		}
+		m_callback_timer.Reset();
+	}
+	static size_t GetArenaSize(v8::Local<v8::Object> h_options)
+	{
+		// options: { arena: true, arenaSize: bytes } or size hints { bodyCount, fixtureCount, jointCount, contactCount }
+		if (!NANX_bool(h_options->Get(NANX_SYMBOL("arena")))) { return 0; }
+		v8::Local<v8::Value> h_size = h_options->Get(NANX_SYMBOL("arenaSize"));
+		if (h_size->IsNumber())
+		{
+			return static_cast<size_t>(b2Max(h_size->NumberValue(), 1.0));
+		}
+		double body_count = b2Max(h_options->Get(NANX_SYMBOL("bodyCount"))->NumberValue(), 0.0);
+		double fixture_count = b2Max(h_options->Get(NANX_SYMBOL("fixtureCount"))->NumberValue(), body_count);
+		double joint_count = b2Max(h_options->Get(NANX_SYMBOL("jointCount"))->NumberValue(), 0.0);
+		double contact_count = b2Max(h_options->Get(NANX_SYMBOL("contactCount"))->NumberValue(), 0.0);
+		// NaN (missing hints) fails every comparison above and falls through as zero
+		double bytes =
+			body_count * sizeof(b2Body) +
+			fixture_count * (sizeof(b2Fixture) + sizeof(b2PolygonShape) + sizeof(b2FixtureProxy) + 2 * sizeof(b2TreeNode)) +
+			joint_count * sizeof(b2RevoluteJoint) +
+			contact_count * sizeof(b2Contact);
+		return static_cast<size_t>(b2Max(bytes, 1.0));
+	}
+	static int32 GetShapeSize(const b2Shape* shape)
+	{
+		switch (shape->GetType())
+		{
+		case b2Shape::e_circle: return sizeof(b2CircleShape);
+		case b2Shape::e_edge: return sizeof(b2EdgeShape);
+		case b2Shape::e_polygon: return sizeof(b2PolygonShape);
+		case b2Shape::e_chain: return sizeof(b2ChainShape);
+		default: return 0;
+		}
+	}
+	static int32 GetJointSize(const b2Joint* joint)
+	{
+		switch (joint->GetType())
+		{
+		case e_revoluteJoint: return sizeof(b2RevoluteJoint);
+		case e_prismaticJoint: return sizeof(b2PrismaticJoint);
+		case e_distanceJoint: return sizeof(b2DistanceJoint);
+		case e_pulleyJoint: return sizeof(b2PulleyJoint);
+		case e_mouseJoint: return sizeof(b2MouseJoint);
+		case e_gearJoint: return sizeof(b2GearJoint);
+		case e_wheelJoint: return sizeof(b2WheelJoint);
+		case e_weldJoint: return sizeof(b2WeldJoint);
+		case e_frictionJoint: return sizeof(b2FrictionJoint);
+		case e_ropeJoint: return sizeof(b2RopeJoint);
+		case e_motorJoint: return sizeof(b2MotorJoint);
+		default: return 0;
+		}
+	}
+	static void AddBlocks(double* blocks, double& large_bytes, int32 size, int32 count)
+	{
+		// box2d objects come from the block allocator unless they are too big for it
+		int32 index = BlockSizeClass(size);
+		if (index >= 0) { blocks[index] += count; }
+		else { large_bytes += static_cast<double>(size) * count; }
+	}
+	void SaveInterpolation()
+	{
+		for (size_t i = 0; i < m_interpolation.size(); ++i)
+		{
+			Interpolation& state = m_interpolation[i];
+			b2Body* body = GetBodyById(state.body_id);
+			if (body)
+			{
+				state.position = body->GetPosition();
+				state.angle = body->GetAngle();
+			}
+		}
+	}
+	v8::Local<v8::Object> NewBodyObject(v8::Local<v8::Object> h_world, b2Body* body, v8::Local<v8::Value> h_userData)
+	{
+		Nan::EscapableHandleScope scope;
+		// create javascript body object
+		v8::Local<v8::Object> h_body = WrapBody::NewInstance();
+		WrapBody* wrap_body = WrapBody::Unwrap(h_body);
+		// set up javascript body object
+		wrap_body->SetupObject(h_world, body, AddBodyId(body), h_userData);
+		wrap_body->SetAllocStats(&m_alloc_stats);
+		wrap_body->SetRecorder(&m_recorder);
+		wrap_body->SetBodyTicks(&m_body_ticks);
+		return scope.Escape(h_body);
+	}
+	void SetupTileCollision(b2Body* body, int32 width, int32 height, float32 tileSize, const uint8* grid, const b2FixtureDef& fd)
+	{
+		TileCollision& tiles = m_tile_collisions[body];
+		tiles.width = width;
+		tiles.height = height;
+		tiles.tileSize = tileSize;
+		tiles.grid.assign(grid, grid + width * height);
+		tiles.fd = fd; // struct copy
+		tiles.fd.shape = NULL;
+		tiles.fd.userData = NULL;
+		RebuildTileCollision(body, tiles, 0, 0, width, height);
+	}
+	static int32 GetRecordBodyId(const b2Body* body)
+	{
+		WrapBody* wrap_body = WrapBody::GetWrap(body);
+		return (wrap_body)?(wrap_body->GetId()):(-1);
+	}
+	void RecordCreateJoint(const b2Joint* joint, const b2JointDef& jd)
+	{
+		// the def is logged as raw bytes; its body and joint pointers are rewritten on replay
+		int32 size = GetJointDefSize(jd.type);
+		if (size == 0) { return; }
+		int32 joint1 = -1;
+		int32 joint2 = -1;
+		if (jd.type == e_gearJoint)
+		{
+			const b2GearJointDef& gear_jd = static_cast<const b2GearJointDef&>(jd);
+			joint1 = m_recorder.GetJointId(gear_jd.joint1);
+			joint2 = m_recorder.GetJointId(gear_jd.joint2);
+		}
+		m_recorder.Op(e_recordCreateJoint).Int(m_recorder.AddJoint(joint)).Int(jd.type);
+		m_recorder.Int(GetRecordBodyId(jd.bodyA)).Int(GetRecordBodyId(jd.bodyB)).Int(joint1).Int(joint2);
+		m_recorder.Int(size).Bytes(&jd, size);
+	}
+	static int32 GetJointParamCount(b2JointType type)
+	{
+		// floats per CreateJoints record, collideConnected last
+		switch (type)
+		{
+		case e_revoluteJoint: return 12;
+		case e_prismaticJoint: return 14;
+		case e_distanceJoint: return 8;
+		case e_pulleyJoint: return 12;
+		case e_mouseJoint: return 6;
+		case e_wheelJoint: return 12;
+		case e_weldJoint: return 8;
+		case e_frictionJoint: return 7;
+		case e_ropeJoint: return 6;
+		case e_motorJoint: return 7;
+		default: return 0; // gear joints join joints, not bodies
+		}
+	}
+	static b2JointDef* ReadJointParams(b2JointType type, const float32* p, RecordJointDefs& defs)
+	{
+		b2JointDef* jd = defs.Get(type);
+		switch (type)
+		{
+		case e_revoluteJoint:
+			defs.revolute.localAnchorA.Set(p[0], p[1]);
+			defs.revolute.localAnchorB.Set(p[2], p[3]);
+			defs.revolute.referenceAngle = p[4];
+			defs.revolute.enableLimit = (p[5] != 0.0f);
+			defs.revolute.lowerAngle = p[6];
+			defs.revolute.upperAngle = p[7];
+			defs.revolute.enableMotor = (p[8] != 0.0f);
+			defs.revolute.motorSpeed = p[9];
+			defs.revolute.maxMotorTorque = p[10];
+			break;
+		case e_prismaticJoint:
+			defs.prismatic.localAnchorA.Set(p[0], p[1]);
+			defs.prismatic.localAnchorB.Set(p[2], p[3]);
+			defs.prismatic.localAxisA.Set(p[4], p[5]);
+			defs.prismatic.localAxisA.Normalize();
+			defs.prismatic.referenceAngle = p[6];
+			defs.prismatic.enableLimit = (p[7] != 0.0f);
+			defs.prismatic.lowerTranslation = p[8];
+			defs.prismatic.upperTranslation = p[9];
+			defs.prismatic.enableMotor = (p[10] != 0.0f);
+			defs.prismatic.motorSpeed = p[11];
+			defs.prismatic.maxMotorForce = p[12];
+			break;
+		case e_distanceJoint:
+			defs.distance.localAnchorA.Set(p[0], p[1]);
+			defs.distance.localAnchorB.Set(p[2], p[3]);
+			defs.distance.length = p[4];
+			defs.distance.frequencyHz = p[5];
+			defs.distance.dampingRatio = p[6];
+			break;
+		case e_pulleyJoint:
+			defs.pulley.groundAnchorA.Set(p[0], p[1]);
+			defs.pulley.groundAnchorB.Set(p[2], p[3]);
+			defs.pulley.localAnchorA.Set(p[4], p[5]);
+			defs.pulley.localAnchorB.Set(p[6], p[7]);
+			defs.pulley.lengthA = p[8];
+			defs.pulley.lengthB = p[9];
+			defs.pulley.ratio = p[10];
+			break;
+		case e_mouseJoint:
+			defs.mouse.target.Set(p[0], p[1]);
+			defs.mouse.maxForce = p[2];
+			defs.mouse.frequencyHz = p[3];
+			defs.mouse.dampingRatio = p[4];
+			break;
+		case e_wheelJoint:
+			defs.wheel.localAnchorA.Set(p[0], p[1]);
+			defs.wheel.localAnchorB.Set(p[2], p[3]);
+			defs.wheel.localAxisA.Set(p[4], p[5]);
+			defs.wheel.localAxisA.Normalize();
+			defs.wheel.enableMotor = (p[6] != 0.0f);
+			defs.wheel.motorSpeed = p[7];
+			defs.wheel.maxMotorTorque = p[8];
+			defs.wheel.frequencyHz = p[9];
+			defs.wheel.dampingRatio = p[10];
+			break;
+		case e_weldJoint:
+			defs.weld.localAnchorA.Set(p[0], p[1]);
+			defs.weld.localAnchorB.Set(p[2], p[3]);
+			defs.weld.referenceAngle = p[4];
+			defs.weld.frequencyHz = p[5];
+			defs.weld.dampingRatio = p[6];
+			break;
+		case e_frictionJoint:
+			defs.friction.localAnchorA.Set(p[0], p[1]);
+			defs.friction.localAnchorB.Set(p[2], p[3]);
+			defs.friction.maxForce = p[4];
+			defs.friction.maxTorque = p[5];
+			break;
+		case e_ropeJoint:
+			defs.rope.localAnchorA.Set(p[0], p[1]);
+			defs.rope.localAnchorB.Set(p[2], p[3]);
+			defs.rope.maxLength = p[4];
+			break;
+		case e_motorJoint:
+			defs.motor.linearOffset.Set(p[0], p[1]);
+			defs.motor.angularOffset = p[2];
+			defs.motor.maxForce = p[3];
+			defs.motor.maxTorque = p[4];
+			defs.motor.correctionFactor = p[5];
+			break;
+		default:
+			return NULL;
+		}
+		jd->collideConnected = (p[GetJointParamCount(type) - 1] != 0.0f);
+		return jd;
+	}
+	static b2JointDef* ReadJointDef(b2Joint* joint, RecordJointDefs& defs)
+	{
+		// a def that recreates joint as it is now; box2d keeps no def, so it is read back through the getters
+		b2JointDef* jd = defs.Get(joint->GetType());
+		switch (joint->GetType())
+		{
+		case e_revoluteJoint:
+		{
+			b2RevoluteJoint* revolute_joint = static_cast<b2RevoluteJoint*>(joint);
+			defs.revolute.localAnchorA = revolute_joint->GetLocalAnchorA();
+			defs.revolute.localAnchorB = revolute_joint->GetLocalAnchorB();
+			defs.revolute.referenceAngle = revolute_joint->GetReferenceAngle();
+			defs.revolute.enableLimit = revolute_joint->IsLimitEnabled();
+			defs.revolute.lowerAngle = revolute_joint->GetLowerLimit();
+			defs.revolute.upperAngle = revolute_joint->GetUpperLimit();
+			defs.revolute.enableMotor = revolute_joint->IsMotorEnabled();
+			defs.revolute.motorSpeed = revolute_joint->GetMotorSpeed();
+			defs.revolute.maxMotorTorque = revolute_joint->GetMaxMotorTorque();
+			break;
+		}
+		case e_prismaticJoint:
+		{
+			b2PrismaticJoint* prismatic_joint = static_cast<b2PrismaticJoint*>(joint);
+			defs.prismatic.localAnchorA = prismatic_joint->GetLocalAnchorA();
+			defs.prismatic.localAnchorB = prismatic_joint->GetLocalAnchorB();
+			defs.prismatic.localAxisA = prismatic_joint->GetLocalAxisA();
+			defs.prismatic.referenceAngle = prismatic_joint->GetReferenceAngle();
+			defs.prismatic.enableLimit = prismatic_joint->IsLimitEnabled();
+			defs.prismatic.lowerTranslation = prismatic_joint->GetLowerLimit();
+			defs.prismatic.upperTranslation = prismatic_joint->GetUpperLimit();
+			defs.prismatic.enableMotor = prismatic_joint->IsMotorEnabled();
+			defs.prismatic.motorSpeed = prismatic_joint->GetMotorSpeed();
+			defs.prismatic.maxMotorForce = prismatic_joint->GetMaxMotorForce();
+			break;
+		}
+		case e_distanceJoint:
+		{
+			b2DistanceJoint* distance_joint = static_cast<b2DistanceJoint*>(joint);
+			defs.distance.localAnchorA = distance_joint->GetLocalAnchorA();
+			defs.distance.localAnchorB = distance_joint->GetLocalAnchorB();
+			defs.distance.length = distance_joint->GetLength();
+			defs.distance.frequencyHz = distance_joint->GetFrequency();
+			defs.distance.dampingRatio = distance_joint->GetDampingRatio();
+			break;
+		}
+		case e_pulleyJoint:
+		{
+			// pulley joints only report world anchors
+			b2PulleyJoint* pulley_joint = static_cast<b2PulleyJoint*>(joint);
+			defs.pulley.groundAnchorA = pulley_joint->GetGroundAnchorA();
+			defs.pulley.groundAnchorB = pulley_joint->GetGroundAnchorB();
+			defs.pulley.localAnchorA = joint->GetBodyA()->GetLocalPoint(pulley_joint->GetAnchorA());
+			defs.pulley.localAnchorB = joint->GetBodyB()->GetLocalPoint(pulley_joint->GetAnchorB());
+			defs.pulley.lengthA = pulley_joint->GetLengthA();
+			defs.pulley.lengthB = pulley_joint->GetLengthB();
+			defs.pulley.ratio = pulley_joint->GetRatio();
+			break;
+		}
+		case e_mouseJoint:
+		{
+			b2MouseJoint* mouse_joint = static_cast<b2MouseJoint*>(joint);
+			defs.mouse.target = mouse_joint->GetTarget();
+			defs.mouse.maxForce = mouse_joint->GetMaxForce();
+			defs.mouse.frequencyHz = mouse_joint->GetFrequency();
+			defs.mouse.dampingRatio = mouse_joint->GetDampingRatio();
+			break;
+		}
+		case e_gearJoint:
+		{
+			b2GearJoint* gear_joint = static_cast<b2GearJoint*>(joint);
+			defs.gear.joint1 = gear_joint->GetJoint1();
+			defs.gear.joint2 = gear_joint->GetJoint2();
+			defs.gear.ratio = gear_joint->GetRatio();
+			break;
+		}
+		case e_wheelJoint:
+		{
+			b2WheelJoint* wheel_joint = static_cast<b2WheelJoint*>(joint);
+			defs.wheel.localAnchorA = wheel_joint->GetLocalAnchorA();
+			defs.wheel.localAnchorB = wheel_joint->GetLocalAnchorB();
+			defs.wheel.localAxisA = wheel_joint->GetLocalAxisA();
+			defs.wheel.enableMotor = wheel_joint->IsMotorEnabled();
+			defs.wheel.motorSpeed = wheel_joint->GetMotorSpeed();
+			defs.wheel.maxMotorTorque = wheel_joint->GetMaxMotorTorque();
+			defs.wheel.frequencyHz = wheel_joint->GetSpringFrequencyHz();
+			defs.wheel.dampingRatio = wheel_joint->GetSpringDampingRatio();
+			break;
+		}
+		case e_weldJoint:
+		{
+			b2WeldJoint* weld_joint = static_cast<b2WeldJoint*>(joint);
+			defs.weld.localAnchorA = weld_joint->GetLocalAnchorA();
+			defs.weld.localAnchorB = weld_joint->GetLocalAnchorB();
+			defs.weld.referenceAngle = weld_joint->GetReferenceAngle();
+			defs.weld.frequencyHz = weld_joint->GetFrequency();
+			defs.weld.dampingRatio = weld_joint->GetDampingRatio();
+			break;
+		}
+		case e_frictionJoint:
+		{
+			b2FrictionJoint* friction_joint = static_cast<b2FrictionJoint*>(joint);
+			defs.friction.localAnchorA = friction_joint->GetLocalAnchorA();
+			defs.friction.localAnchorB = friction_joint->GetLocalAnchorB();
+			defs.friction.maxForce = friction_joint->GetMaxForce();
+			defs.friction.maxTorque = friction_joint->GetMaxTorque();
+			break;
+		}
+		case e_ropeJoint:
+		{
+			b2RopeJoint* rope_joint = static_cast<b2RopeJoint*>(joint);
+			defs.rope.localAnchorA = rope_joint->GetLocalAnchorA();
+			defs.rope.localAnchorB = rope_joint->GetLocalAnchorB();
+			defs.rope.maxLength = rope_joint->GetMaxLength();
+			break;
+		}
+		case e_motorJoint:
+		{
+			b2MotorJoint* motor_joint = static_cast<b2MotorJoint*>(joint);
+			defs.motor.linearOffset = motor_joint->GetLinearOffset();
+			defs.motor.angularOffset = motor_joint->GetAngularOffset();
+			defs.motor.maxForce = motor_joint->GetMaxForce();
+			defs.motor.maxTorque = motor_joint->GetMaxTorque();
+			defs.motor.correctionFactor = motor_joint->GetCorrectionFactor();
+			break;
+		}
+		default:
+			return NULL;
+		}
+		jd->bodyA = joint->GetBodyA();
+		jd->bodyB = joint->GetBodyB();
+		jd->collideConnected = joint->GetCollideConnected();
+		return jd;
+	}
+	template <typename WRAP_JD, typename WRAP_JOINT, typename JD, typename JOINT>
+	static v8::Local<v8::Object> NewJointObject(v8::Local<v8::Object> h_world, const b2JointDef& jd, b2Joint* joint)
+	{
+		// a joint object keeps its bodies through a def object, so one is made to match the native def
+		Nan::EscapableHandleScope scope;
+		v8::Local<v8::Object> h_jd = WRAP_JD::GetConstructor()->NewInstance();
+		WRAP_JD* wrap_jd = WRAP_JD::Unwrap(h_jd);
+		*wrap_jd->Peek() = static_cast<const JD&>(jd); // struct copy
+		wrap_jd->SyncPush();
+		v8::Local<v8::Object> h_joint = WRAP_JOINT::NewInstance();
+		WRAP_JOINT::Unwrap(h_joint)->SetupObject(h_world, wrap_jd, static_cast<JOINT*>(joint));
+		return scope.Escape(h_joint);
+	}
+	static v8::Local<v8::Value> NewJointObject(v8::Local<v8::Object> h_world, const b2JointDef& jd, b2Joint* joint)
+	{
+		switch (jd.type)
+		{
+		case e_revoluteJoint: return NewJointObject<WrapRevoluteJointDef, WrapRevoluteJoint, b2RevoluteJointDef, b2RevoluteJoint>(h_world, jd, joint);
+		case e_prismaticJoint: return NewJointObject<WrapPrismaticJointDef, WrapPrismaticJoint, b2PrismaticJointDef, b2PrismaticJoint>(h_world, jd, joint);
+		case e_distanceJoint: return NewJointObject<WrapDistanceJointDef, WrapDistanceJoint, b2DistanceJointDef, b2DistanceJoint>(h_world, jd, joint);
+		case e_pulleyJoint: return NewJointObject<WrapPulleyJointDef, WrapPulleyJoint, b2PulleyJointDef, b2PulleyJoint>(h_world, jd, joint);
+		case e_mouseJoint: return NewJointObject<WrapMouseJointDef, WrapMouseJoint, b2MouseJointDef, b2MouseJoint>(h_world, jd, joint);
+		case e_gearJoint: return NewJointObject<WrapGearJointDef, WrapGearJoint, b2GearJointDef, b2GearJoint>(h_world, jd, joint);
+		case e_wheelJoint: return NewJointObject<WrapWheelJointDef, WrapWheelJoint, b2WheelJointDef, b2WheelJoint>(h_world, jd, joint);
+		case e_weldJoint: return NewJointObject<WrapWeldJointDef, WrapWeldJoint, b2WeldJointDef, b2WeldJoint>(h_world, jd, joint);
+		case e_frictionJoint: return NewJointObject<WrapFrictionJointDef, WrapFrictionJoint, b2FrictionJointDef, b2FrictionJoint>(h_world, jd, joint);
+		case e_ropeJoint: return NewJointObject<WrapRopeJointDef, WrapRopeJoint, b2RopeJointDef, b2RopeJoint>(h_world, jd, joint);
+		case e_motorJoint: return NewJointObject<WrapMotorJointDef, WrapMotorJoint, b2MotorJointDef, b2MotorJoint>(h_world, jd, joint);
+		default: return Nan::Null();
+		}
+	}
+	static v8::Local<v8::Value> GetJointObject(v8::Local<v8::Object> h_world, b2Joint* joint)
+	{
+		// the joint object of joint, made on first use for a native joint; null if a body it joins has no object
+		Nan::EscapableHandleScope scope;
+		WrapJoint* wrap_joint = WrapJoint::GetWrap(joint);
+		if (wrap_joint)
+		{
+			return scope.Escape(wrap_joint->handle());
+		}
+		if (!WrapBody::GetWrap(joint->GetBodyA()) || !WrapBody::GetWrap(joint->GetBodyB()))
+		{
+			return scope.Escape(Nan::Null());
+		}
+		if (joint->GetType() == e_gearJoint)
+		{
+			// the def of a gear joint holds the objects of the joints it joins
+			b2GearJoint* gear_joint = static_cast<b2GearJoint*>(joint);
+			if (GetJointObject(h_world, gear_joint->GetJoint1())->IsNull() || GetJointObject(h_world, gear_joint->GetJoint2())->IsNull())
+			{
+				return scope.Escape(Nan::Null());
+			}
+		}
+		RecordJointDefs defs;
+		b2JointDef* jd = ReadJointDef(joint, defs);
+		return scope.Escape((jd)?(NewJointObject(h_world, *jd, joint)):(v8::Local<v8::Value>(Nan::Null())));
+	}
+	bool SetWorldFlag(int32 which, bool flag)
+	{
+		switch (which)
+		{
+		case e_recordAllowSleeping: m_world.SetAllowSleeping(flag); return true;
+		case e_recordWarmStarting: m_world.SetWarmStarting(flag); return true;
+		case e_recordContinuousPhysics: m_world.SetContinuousPhysics(flag); return true;
+		case e_recordSubStepping: m_world.SetSubStepping(flag); return true;
+		case e_recordAutoClearForces: m_world.SetAutoClearForces(flag); return true;
+		default: return false;
+		}
+	}
+	static v8::Local<v8::Value> NewSceneProperties(const SceneProperties& properties)
+	{
+		Nan::EscapableHandleScope scope;
+		v8::Local<v8::Object> h_properties = Nan::New<v8::Object>();
+		for (size_t i = 0; i < properties.size(); ++i)
+		{
+			const SceneProperty& property = properties[i];
+			v8::Local<v8::Value> h_value;
+			switch (property.type)
+			{
+			case SceneProperty::e_int:
+			case SceneProperty::e_float:
+				h_value = Nan::New(property.number);
+				break;
+			case SceneProperty::e_string:
+				h_value = NANX_STRING(property.string);
+				break;
+			case SceneProperty::e_bool:
+				h_value = Nan::New(property.number != 0.0);
+				break;
+			case SceneProperty::e_vec2:
+				h_value = WrapVec2::NewInstance(property.vec2);
+				break;
+			case SceneProperty::e_color:
+			{
+				v8::Local<v8::Array> h_color = Nan::New<v8::Array>(4);
+				for (uint32_t c = 0; c < 4; ++c) { Nan::Set(h_color, c, Nan::New(property.color[c])); }
+				h_value = h_color;
+				break;
+			}
+			}
+			Nan::Set(h_properties, NANX_STRING(property.name), h_value);
+		}
+		return scope.Escape(h_properties);
+	}
+	static v8::Local<v8::Value> NewSceneUserData(const std::string& name, const SceneProperties& properties)
+	{
+		// { name, properties }, or undefined when the scene gives neither
+		Nan::EscapableHandleScope scope;
+		if (name.empty() && properties.empty()) { return scope.Escape(Nan::Undefined()); }
+		v8::Local<v8::Object> h_userData = Nan::New<v8::Object>();
+		Nan::Set(h_userData, NANX_SYMBOL("name"), NANX_STRING(name));
+		Nan::Set(h_userData, NANX_SYMBOL("properties"), NewSceneProperties(properties));
+		return scope.Escape(h_userData);
+	}
+	void CreateSceneFixtures(v8::Local<v8::Object> h_body, b2Body* body, int32 body_id, const std::vector<SceneFixture>& scene_fixtures)
+	{
+		// fixtures are created massless so the body mass is only computed once
+		for (size_t i = 0; i < scene_fixtures.size(); ++i)
+		{
+			Nan::HandleScope scope;
+			const SceneFixture& scene_fixture = scene_fixtures[i];
+			b2FixtureDef fd = scene_fixture.fd; // struct copy
+			fd.density = 0.0f;
+			b2ChainShape chain;
+			switch (scene_fixture.shape_type)
+			{
+			case b2Shape::e_circle: fd.shape = &scene_fixture.circle; break;
+			case b2Shape::e_edge: fd.shape = &scene_fixture.edge; break;
+			case b2Shape::e_polygon: fd.shape = &scene_fixture.polygon; break;
+			case b2Shape::e_chain:
+				chain.CreateChain(&scene_fixture.chain[0], static_cast<int32>(scene_fixture.chain.size()));
+				if (scene_fixture.chain_has_prev) { chain.SetPrevVertex(scene_fixture.chain_prev); }
+				if (scene_fixture.chain_has_next) { chain.SetNextVertex(scene_fixture.chain_next); }
+				fd.shape = &chain;
+				break;
+			default:
+				continue;
+			}
+			b2Fixture* fixture = body->CreateFixture(&fd);
+			fixture->SetDensity(scene_fixture.fd.density);
+			if (m_recorder.IsRecording())
+			{
+				int32 fixture_id = m_recorder.AddFixture(fixture);
+				m_recorder.Op(e_recordCreateFixture).Int(body_id).Int(fixture_id).Material(fd).Shape(fd.shape);
+				m_recorder.Op(e_recordSetFixtureFloat).Int(fixture_id).Uint8(e_recordDensity).Float(scene_fixture.fd.density);
+			}
+			// create javascript fixture object
+			v8::Local<v8::Object> h_fixture = WrapFixture::NewInstance();
+			WrapFixture* wrap_fixture = WrapFixture::Unwrap(h_fixture);
+			wrap_fixture->SetupObject(h_body, fixture, NewSceneUserData(scene_fixture.name, scene_fixture.properties));
+			wrap_fixture->SetRecorder(&m_recorder);
+		}
+		if (!scene_fixtures.empty())
+		{
+			if (m_recorder.IsRecording()) { m_recorder.Op(e_recordResetMassData).Int(body_id); }
+			body->ResetMassData();
+		}
+	}
+	static void TransformSceneJointDef(b2JointDef* jd, const b2Transform& xf)
+	{
+		// anchors are body local, except the world points of pulley and mouse joints
+		switch (jd->type)
+		{
+		case e_pulleyJoint:
+		{
+			b2PulleyJointDef* pulley_jd = static_cast<b2PulleyJointDef*>(jd);
+			pulley_jd->groundAnchorA = b2Mul(xf, pulley_jd->groundAnchorA);
+			pulley_jd->groundAnchorB = b2Mul(xf, pulley_jd->groundAnchorB);
+			break;
+		}
+		case e_mouseJoint:
+		{
+			b2MouseJointDef* mouse_jd = static_cast<b2MouseJointDef*>(jd);
+			mouse_jd->target = b2Mul(xf, mouse_jd->target);
+			break;
+		}
+		default:
+			break;
+		}
+	}
+	void CreateSceneBodies(v8::Local<v8::Object> h_world, const Scene& scene, const b2Transform& xf, std::vector<b2Body*>& bodies, std::vector<int32>& body_ids)
+	{
+		// scene bodies are placed by xf; velocities turn with it
+		const int32 body_count = static_cast<int32>(scene.bodies.size());
+		bodies.resize(body_count);
+		body_ids.resize(body_count);
+		for (int32 i = 0; i < body_count; ++i)
+		{
+			Nan::HandleScope scope;
+			const SceneBody& scene_body = scene.bodies[i];
+			b2BodyDef bd = scene_body.bd; // struct copy
+			bd.position = b2Mul(xf, bd.position);
+			bd.angle += xf.q.GetAngle();
+			bd.linearVelocity = b2Mul(xf.q, bd.linearVelocity);
+			b2Body* body = m_world.CreateBody(&bd);
+			v8::Local<v8::Object> h_body = NewBodyObject(h_world, body, NewSceneUserData(scene_body.name, scene_body.properties));
+			int32 body_id = WrapBody::GetWrap(body)->GetId();
+			if (m_recorder.IsRecording()) { m_recorder.Op(e_recordCreateBody).Int(body_id).BodyDef(bd); }
+			CreateSceneFixtures(h_body, body, body_id, scene_body.fixtures);
+			if (scene_body.has_mass_data && (bd.type == b2_dynamicBody))
+			{
+				const b2MassData& mass_data = scene_body.mass_data;
+				if (m_recorder.IsRecording()) { m_recorder.Op(e_recordSetMassData).Int(body_id).Float(mass_data.mass).Vec2(mass_data.center).Float(mass_data.I); }
+				body->SetMassData(&mass_data);
+			}
+			bodies[i] = body;
+			body_ids[i] = body_id;
+		}
+	}
+	void CreateSceneJoints(const Scene& scene, const b2Transform& xf, const std::vector<b2Body*>& bodies, std::vector<b2Joint*>& joints, std::vector<int32>& joint_ids)
+	{
+		const int32 joint_count = static_cast<int32>(scene.joints.size());
+		joints.assign(joint_count, static_cast<b2Joint*>(NULL));
+		joint_ids.assign(joint_count, -1);
+		for (int32 pass = 0; pass < 2; ++pass)
+		{
+			// gear joints last, once the joints they join exist
+			for (int32 i = 0; i < joint_count; ++i)
+			{
+				const SceneJoint& scene_joint = scene.joints[i];
+				if ((scene_joint.type == e_gearJoint) != (pass == 1)) { continue; }
+				RecordJointDefs defs = scene_joint.defs; // struct copy
+				b2JointDef* jd = defs.Get(scene_joint.type);
+				jd->bodyA = bodies[scene_joint.bodyA];
+				jd->bodyB = bodies[scene_joint.bodyB];
+				if (scene_joint.type == e_gearJoint)
+				{
+					defs.gear.joint1 = joints[scene_joint.joint1];
+					defs.gear.joint2 = joints[scene_joint.joint2];
+				}
+				TransformSceneJointDef(jd, xf);
+				joints[i] = m_world.CreateJoint(jd);
+				joint_ids[i] = AddJointId(joints[i]);
+				if (m_recorder.IsRecording()) { RecordCreateJoint(joints[i], *jd); }
+			}
+		}
+	}
+	v8::Local<v8::Object> InstantiateScene(v8::Local<v8::Object> h_world, const Scene& scene)
+	{
+		// bodies and fixtures get javascript objects (names and custom properties in their user data);
+		// joints are native only and described in the returned map, each with the id GetJointById takes
+		Nan::EscapableHandleScope scope;
+		AllocScope alloc_scope(&m_alloc_stats);
+		if (scene.has_gravity)
+		{
+			if (m_recorder.IsRecording()) { m_recorder.Op(e_recordSetGravity).Vec2(scene.gravity); }
+			m_world.SetGravity(scene.gravity);
+		}
+		for (int32 i = 0; i < static_cast<int32>(countof(scene.world_flags)); ++i)
+		{
+			if (scene.world_flags[i] < 0) { continue; }
+			if (m_recorder.IsRecording()) { m_recorder.Op(e_recordSetWorldFlag).Uint8(static_cast<uint8>(i)).Bool(scene.world_flags[i] != 0); }
+			SetWorldFlag(i, scene.world_flags[i] != 0);
+		}
+		b2Transform xf;
+		xf.SetIdentity();
+		std::vector<b2Body*> bodies;
+		std::vector<int32> body_ids;
+		CreateSceneBodies(h_world, scene, xf, bodies, body_ids);
+		std::vector<b2Joint*> joints;
+		std::vector<int32> joint_ids;
+		CreateSceneJoints(scene, xf, bodies, joints, joint_ids);
+		const int32 body_count = static_cast<int32>(scene.bodies.size());
+		v8::Local<v8::Object> h_names = Nan::New<v8::Object>();
+		for (int32 i = 0; i < body_count; ++i)
+		{
+			// first body wins a shared name
+			const SceneBody& scene_body = scene.bodies[i];
+			if (!scene_body.name.empty() && !Nan::Has(h_names, NANX_STRING(scene_body.name)).FromJust())
+			{
+				Nan::Set(h_names, NANX_STRING(scene_body.name), Nan::New(body_ids[i]));
+			}
+		}
+		const int32 joint_count = static_cast<int32>(scene.joints.size());
+		v8::Local<v8::Array> h_joints = Nan::New<v8::Array>(joint_count);
+		for (int32 i = 0; i < joint_count; ++i)
+		{
+			const SceneJoint& scene_joint = scene.joints[i];
+			v8::Local<v8::Object> h_joint = Nan::New<v8::Object>();
+			Nan::Set(h_joint, NANX_SYMBOL("id"), Nan::New(joint_ids[i]));
+			Nan::Set(h_joint, NANX_SYMBOL("name"), NANX_STRING(scene_joint.name));
+			Nan::Set(h_joint, NANX_SYMBOL("type"), Nan::New(static_cast<int32>(scene_joint.type)));
+			Nan::Set(h_joint, NANX_SYMBOL("bodyA"), Nan::New(body_ids[scene_joint.bodyA]));
+			Nan::Set(h_joint, NANX_SYMBOL("bodyB"), Nan::New(body_ids[scene_joint.bodyB]));
+			Nan::Set(h_joint, NANX_SYMBOL("properties"), NewSceneProperties(scene_joint.properties));
+			Nan::Set(h_joints, static_cast<uint32_t>(i), h_joint);
+		}
+		v8::Local<v8::Int32Array> h_bodies = v8::Int32Array::New(v8::ArrayBuffer::New(v8::Isolate::GetCurrent(), body_count * sizeof(int32)), 0, body_count);
+		Nan::TypedArrayContents<int32_t> out(h_bodies);
+		for (int32 i = 0; (i < body_count) && (i < static_cast<int32>(out.length())); ++i)
+		{
+			(*out)[i] = body_ids[i];
+		}
+		v8::Local<v8::Object> h_result = Nan::New<v8::Object>();
+		Nan::Set(h_result, NANX_SYMBOL("bodies"), h_bodies);
+		Nan::Set(h_result, NANX_SYMBOL("names"), h_names);
+		Nan::Set(h_result, NANX_SYMBOL("joints"), h_joints);
+		Nan::Set(h_result, NANX_SYMBOL("velocityIterations"), Nan::New(scene.velocity_iterations));
+		Nan::Set(h_result, NANX_SYMBOL("positionIterations"), Nan::New(scene.position_iterations));
+		Nan::Set(h_result, NANX_SYMBOL("stepsPerSecond"), Nan::New(static_cast<double>(scene.steps_per_second)));
+		return scope.Escape(h_result);
+	}
+	static bool IsReplayId(int32 id) { return (id >= 0) && (id < g_record_max_id); }
+	template <typename T>
+	static T* GetReplayItem(const std::vector<T*>& items, int32 id)
+	{
+		return ((id >= 0) && (id < static_cast<int32>(items.size())))?(items[id]):(NULL);
+	}
+	template <typename T>
+	static void SetReplayItem(std::vector<T*>& items, int32 id, T* item)
+	{
+		if (id >= static_cast<int32>(items.size())) { items.resize(id + 1, NULL); }
+		items[id] = item;
+	}
+	bool ReplayLog(RecordReader& in, std::vector<double>& step_ms)
+	{
+		// log ids index these tables; an id that names nothing means the log is malformed
+		std::vector<b2Body*> bodies;
+		std::vector<b2Fixture*> fixtures;
+		std::vector<b2Joint*> joints;
+		while (true)
+		{
+			RecordOp op = static_cast<RecordOp>(in.Uint8());
+			if (!in.IsOk()) { return false; }
+			switch (op)
+			{
+			case e_recordEnd:
+				return true;
+			case e_recordStep:
+			{
+				float32 timeStep = in.Float();
+				int32 velocityIterations = in.Int();
+				int32 positionIterations = in.Int();
+				int32 particleIterations = in.Int();
+				if (!in.IsOk()) { return false; }
+				b2Timer timer;
+				StepWorld(timeStep, velocityIterations, positionIterations, particleIterations);
+				step_ms.push_back(timer.GetMilliseconds());
+				break;
+			}
+			case e_recordCreateBody:
+			{
+				int32 id = in.Int();
+				b2BodyDef bd;
+				in.BodyDef(bd);
+				if (!in.IsOk() || !IsReplayId(id)) { return false; }
+				SetReplayItem(bodies, id, m_world.CreateBody(&bd));
+				break;
+			}
+			case e_recordDestroyBody:
+			{
+				int32 id = in.Int();
+				b2Body* body = GetReplayItem(bodies, id);
+				if (!body) { return false; }
+				bodies[id] = NULL;
+				// its fixtures and joints go with it; later ops naming them are malformed
+				for (size_t i = 0; i < fixtures.size(); ++i)
+				{
+					if (fixtures[i] && (fixtures[i]->GetBody() == body)) { fixtures[i] = NULL; }
+				}
+				for (size_t i = 0; i < joints.size(); ++i)
+				{
+					if (joints[i] && ((joints[i]->GetBodyA() == body) || (joints[i]->GetBodyB() == body))) { joints[i] = NULL; }
+				}
+				DestroyBodyQuiet(body);
+				break;
+			}
+			case e_recordClear:
+			{
+				b2Body* body = m_world.GetBodyList();
+				while (body)
+				{
+					b2Body* next = body->GetNext();
+					DestroyBodyQuiet(body);
+					body = next;
+				}
+				bodies.clear();
+				fixtures.clear();
+				joints.clear();
+				break;
+			}
+			case e_recordCreateFixture:
+			{
+				b2Body* body = GetReplayItem(bodies, in.Int());
+				int32 id = in.Int();
+				b2FixtureDef fd;
+				in.Material(fd);
+				RecordShapes shapes;
+				fd.shape = in.Shape(shapes);
+				if (!body || !fd.shape || !IsReplayId(id)) { return false; }
+				SetReplayItem(fixtures, id, body->CreateFixture(&fd));
+				break;
+			}
+			case e_recordDestroyFixture:
+			{
+				int32 id = in.Int();
+				b2Fixture* fixture = GetReplayItem(fixtures, id);
+				if (!fixture) { return false; }
+				fixtures[id] = NULL;
+				fixture->GetBody()->DestroyFixture(fixture);
+				break;
+			}
+			case e_recordCreateJoint:
+			{
+				int32 id = in.Int();
+				b2JointType type = static_cast<b2JointType>(in.Int());
+				b2Body* bodyA = GetReplayItem(bodies, in.Int());
+				b2Body* bodyB = GetReplayItem(bodies, in.Int());
+				int32 joint1 = in.Int();
+				int32 joint2 = in.Int();
+				int32 size = in.Int();
+				const uint8* bytes = in.Bytes(b2Max(size, 0));
+				RecordJointDefs defs;
+				b2JointDef* jd = defs.Get(type);
+				if (!bytes || !jd || (size != GetJointDefSize(type)) || !bodyA || !bodyB || !IsReplayId(id)) { return false; }
+				memcpy(static_cast<void*>(jd), bytes, size);
+				jd->userData = NULL;
+				jd->bodyA = bodyA;
+				jd->bodyB = bodyB;
+				if (type == e_gearJoint)
+				{
+					defs.gear.joint1 = GetReplayItem(joints, joint1);
+					defs.gear.joint2 = GetReplayItem(joints, joint2);
+					if (!defs.gear.joint1 || !defs.gear.joint2) { return false; }
+				}
+				SetReplayItem(joints, id, m_world.CreateJoint(jd));
+				break;
+			}
+			case e_recordDestroyJoint:
+			{
+				int32 id = in.Int();
+				b2Joint* joint = GetReplayItem(joints, id);
+				if (!joint) { return false; }
+				joints[id] = NULL;
+				m_world.DestroyJoint(joint);
+				break;
+			}
+			case e_recordCreateTileCollision:
+			{
+				int32 id = in.Int();
+				b2BodyDef bd;
+				bd.position = in.Vec2();
+				int32 width = in.Int();
+				int32 height = in.Int();
+				float32 tileSize = in.Float();
+				b2FixtureDef fd;
+				in.Material(fd);
+				if (!in.IsOk() || !IsReplayId(id) || (width <= 0) || (height <= 0) || (width > g_record_max_id / height)) { return false; }
+				const uint8* grid = in.Bytes(width * height);
+				if (!grid) { return false; }
+				b2Body* body = m_world.CreateBody(&bd);
+				SetReplayItem(bodies, id, body);
+				SetupTileCollision(body, width, height, tileSize, grid, fd);
+				break;
+			}
+			case e_recordUpdateTileCollision:
+			{
+				b2Body* body = GetReplayItem(bodies, in.Int());
+				int32 x0 = in.Int();
+				int32 y0 = in.Int();
+				int32 x1 = in.Int();
+				int32 y1 = in.Int();
+				std::map<b2Body*,TileCollision>::iterator it = m_tile_collisions.find(body);
+				if (!in.IsOk() || !body || (it == m_tile_collisions.end())) { return false; }
+				TileCollision& tiles = it->second;
+				if ((x0 < 0) || (y0 < 0) || (x0 > x1) || (y0 > y1) || (x1 > tiles.width) || (y1 > tiles.height)) { return false; }
+				for (int32 y = y0; (y < y1) && (x1 > x0); ++y)
+				{
+					const uint8* row = in.Bytes(x1 - x0);
+					if (!row) { return false; }
+					memcpy(&tiles.grid[y * tiles.width + x0], row, x1 - x0);
+				}
+				RebuildTileCollision(body, tiles, x0, y0, x1, y1);
+				break;
+			}
+			case e_recordSetGravity:
+				m_world.SetGravity(in.Vec2());
+				break;
+			case e_recordSetWorldFlag:
+			{
+				uint8 which = in.Uint8();
+				bool flag = in.Bool();
+				if (!SetWorldFlag(which, flag)) { return false; }
+				break;
+			}
+			case e_recordClearForces:
+				ClearForces();
+				break;
+			case e_recordSetBodyTick:
+			{
+				b2Body* body = GetReplayItem(bodies, in.Int());
+				int32 divisor = in.Int();
+				int32 phase = in.Int();
+				if (!in.IsOk() || !body || !IsTickDivisor(divisor)) { return false; }
+				SetBodyTick(body, divisor, phase);
+				break;
+			}
+			case e_recordSetTransform:
+			{
+				b2Body* body = GetReplayItem(bodies, in.Int());
+				b2Vec2 position = in.Vec2();
+				float32 angle = in.Float();
+				if (!in.IsOk() || !body) { return false; }
+				body->SetTransform(position, angle);
+				break;
+			}
+			case e_recordSetLinearVelocity:
+			{
+				b2Body* body = GetReplayItem(bodies, in.Int());
+				b2Vec2 v = in.Vec2();
+				if (!in.IsOk() || !body) { return false; }
+				SetTickVelocity(&m_body_ticks, body, true, false);
+				body->SetLinearVelocity(v);
+				break;
+			}
+			case e_recordSetAngularVelocity:
+			{
+				b2Body* body = GetReplayItem(bodies, in.Int());
+				float32 w = in.Float();
+				if (!in.IsOk() || !body) { return false; }
+				SetTickVelocity(&m_body_ticks, body, false, true);
+				body->SetAngularVelocity(w);
+				break;
+			}
+			case e_recordApplyForce:
+			{
+				b2Body* body = GetReplayItem(bodies, in.Int());
+				b2Vec2 force = in.Vec2();
+				b2Vec2 point = in.Vec2();
+				bool wake = in.Bool();
+				if (!in.IsOk() || !body) { return false; }
+				body->ApplyForce(force, point, wake);
+				AddTickForce(&m_body_ticks, body, force, b2Cross(point - body->GetWorldCenter(), force));
+				break;
+			}
+			case e_recordApplyForceToCenter:
+			{
+				b2Body* body = GetReplayItem(bodies, in.Int());
+				b2Vec2 force = in.Vec2();
+				bool wake = in.Bool();
+				if (!in.IsOk() || !body) { return false; }
+				body->ApplyForceToCenter(force, wake);
+				AddTickForce(&m_body_ticks, body, force, 0.0f);
+				break;
+			}
+			case e_recordApplyTorque:
+			{
+				b2Body* body = GetReplayItem(bodies, in.Int());
+				float32 torque = in.Float();
+				bool wake = in.Bool();
+				if (!in.IsOk() || !body) { return false; }
+				body->ApplyTorque(torque, wake);
+				AddTickForce(&m_body_ticks, body, b2Vec2_zero, torque);
+				break;
+			}
+			case e_recordApplyLinearImpulse:
+			{
+				b2Body* body = GetReplayItem(bodies, in.Int());
+				b2Vec2 impulse = in.Vec2();
+				b2Vec2 point = in.Vec2();
+				bool wake = in.Bool();
+				if (!in.IsOk() || !body) { return false; }
+				body->ApplyLinearImpulse(impulse, point, wake);
+				AddTickImpulse(&m_body_ticks, body, impulse, b2Cross(point - body->GetWorldCenter(), impulse));
+				break;
+			}
+			case e_recordApplyAngularImpulse:
+			{
+				b2Body* body = GetReplayItem(bodies, in.Int());
+				float32 impulse = in.Float();
+				bool wake = in.Bool();
+				if (!in.IsOk() || !body) { return false; }
+				body->ApplyAngularImpulse(impulse, wake);
+				AddTickImpulse(&m_body_ticks, body, b2Vec2_zero, impulse);
+				break;
+			}
+			case e_recordSetMassData:
+			{
+				b2Body* body = GetReplayItem(bodies, in.Int());
+				b2MassData mass_data;
+				mass_data.mass = in.Float();
+				mass_data.center = in.Vec2();
+				mass_data.I = in.Float();
+				if (!in.IsOk() || !body) { return false; }
+				body->SetMassData(&mass_data);
+				break;
+			}
+			case e_recordResetMassData:
+			{
+				b2Body* body = GetReplayItem(bodies, in.Int());
+				if (!body) { return false; }
+				body->ResetMassData();
+				break;
+			}
+			case e_recordSetBodyFloat:
+			{
+				b2Body* body = GetReplayItem(bodies, in.Int());
+				uint8 which = in.Uint8();
+				float32 value = in.Float();
+				if (!in.IsOk() || !body) { return false; }
+				switch (which)
+				{
+				case e_recordLinearDamping: body->SetLinearDamping(value); break;
+				case e_recordAngularDamping: body->SetAngularDamping(value); break;
+				case e_recordGravityScale: body->SetGravityScale(value); break;
+				default: return false;
+				}
+				break;
+			}
+			case e_recordSetBodyFlag:
+			{
+				b2Body* body = GetReplayItem(bodies, in.Int());
+				uint8 which = in.Uint8();
+				bool flag = in.Bool();
+				if (!in.IsOk() || !body) { return false; }
+				switch (which)
+				{
+				case e_recordBullet: body->SetBullet(flag); break;
+				case e_recordSleepingAllowed: body->SetSleepingAllowed(flag); break;
+				case e_recordAwake: if (!flag) { SleepBodyTick(&m_body_ticks, body); } body->SetAwake(flag); break;
+				case e_recordActive: body->SetActive(flag); break;
+				case e_recordFixedRotation: body->SetFixedRotation(flag); break;
+				default: return false;
+				}
+				break;
+			}
+			case e_recordSetType:
+			{
+				b2Body* body = GetReplayItem(bodies, in.Int());
+				int32 type = in.Int();
+				if (!in.IsOk() || !body) { return false; }
+				if ((type != b2_staticBody) && (type != b2_kinematicBody) && (type != b2_dynamicBody)) { return false; }
+				body->SetType(static_cast<b2BodyType>(type));
+				break;
+			}
+			case e_recordSetFixtureFloat:
+			{
+				b2Fixture* fixture = GetReplayItem(fixtures, in.Int());
+				uint8 which = in.Uint8();
+				float32 value = in.Float();
+				if (!in.IsOk() || !fixture) { return false; }
+				switch (which)
+				{
+				case e_recordDensity: fixture->SetDensity(value); break;
+				case e_recordFriction: fixture->SetFriction(value); break;
+				case e_recordRestitution: fixture->SetRestitution(value); break;
+				default: return false;
+				}
+				break;
+			}
+			case e_recordSetSensor:
+			{
+				b2Fixture* fixture = GetReplayItem(fixtures, in.Int());
+				bool flag = in.Bool();
+				if (!in.IsOk() || !fixture) { return false; }
+				fixture->SetSensor(flag);
+				break;
+			}
+			case e_recordSetFilterData:
+			{
+				b2Fixture* fixture = GetReplayItem(fixtures, in.Int());
+				b2Filter filter;
+				in.Filter(filter);
+				if (!in.IsOk() || !fixture) { return false; }
+				fixture->SetFilterData(filter);
+				break;
+			}
+			case e_recordRefilter:
+			{
+				b2Fixture* fixture = GetReplayItem(fixtures, in.Int());
+				if (!fixture) { return false; }
+				fixture->Refilter();
+				break;
+			}
+			case e_recordSetTarget:
+			{
+				b2Joint* joint = GetReplayItem(joints, in.Int());
+				b2Vec2 target = in.Vec2();
+				if (!in.IsOk() || !joint || (joint->GetType() != e_mouseJoint)) { return false; }
+				static_cast<b2MouseJoint*>(joint)->SetTarget(target);
+				break;
+			}
+			case e_recordEnableMotor:
+			{
+				b2Joint* joint = GetReplayItem(joints, in.Int());
+				bool flag = in.Bool();
+				if (!in.IsOk() || !joint) { return false; }
+				switch (joint->GetType())
+				{
+				case e_revoluteJoint: static_cast<b2RevoluteJoint*>(joint)->EnableMotor(flag); break;
+				case e_prismaticJoint: static_cast<b2PrismaticJoint*>(joint)->EnableMotor(flag); break;
+				case e_wheelJoint: static_cast<b2WheelJoint*>(joint)->EnableMotor(flag); break;
+				default: return false;
+				}
+				break;
+			}
+			case e_recordSetMotorSpeed:
+			{
+				b2Joint* joint = GetReplayItem(joints, in.Int());
+				float32 speed = in.Float();
+				if (!in.IsOk() || !joint) { return false; }
+				switch (joint->GetType())
+				{
+				case e_revoluteJoint: static_cast<b2RevoluteJoint*>(joint)->SetMotorSpeed(speed); break;
+				case e_prismaticJoint: static_cast<b2PrismaticJoint*>(joint)->SetMotorSpeed(speed); break;
+				case e_wheelJoint: static_cast<b2WheelJoint*>(joint)->SetMotorSpeed(speed); break;
+				default: return false;
+				}
+				break;
+			}
+			case e_recordEnableLimit:
+			{
+				b2Joint* joint = GetReplayItem(joints, in.Int());
+				bool flag = in.Bool();
+				if (!in.IsOk() || !joint) { return false; }
+				switch (joint->GetType())
+				{
+				case e_revoluteJoint: static_cast<b2RevoluteJoint*>(joint)->EnableLimit(flag); break;
+				case e_prismaticJoint: static_cast<b2PrismaticJoint*>(joint)->EnableLimit(flag); break;
+				default: return false;
+				}
+				break;
+			}
+			case e_recordSetLimits:
+			{
+				b2Joint* joint = GetReplayItem(joints, in.Int());
+				float32 lower = in.Float();
+				float32 upper = in.Float();
+				if (!in.IsOk() || !joint) { return false; }
+				switch (joint->GetType())
+				{
+				case e_revoluteJoint: static_cast<b2RevoluteJoint*>(joint)->SetLimits(lower, upper); break;
+				case e_prismaticJoint: static_cast<b2PrismaticJoint*>(joint)->SetLimits(lower, upper); break;
+				default: return false;
+				}
+				break;
+			}
+			default:
+				return false;
+			}
 		}
-		bool ShouldQueryParticleSystem(const b2ParticleSystem* particleSystem)
+	}
+	static b2Fixture* CreateTileLoopFixture(b2Body* body, const TileCollision& tiles, const TileLoop& loop, std::vector<b2Vec2>& vertices)
+	{
+		// one chain loop in world units; vertices is scratch space
+		vertices.resize(loop.vertices.size());
+		for (size_t j = 0; j < loop.vertices.size(); ++j)
 		{
-			// TODO:
-			return b2RayCastCallback::ShouldQueryParticleSystem(particleSystem);
+			vertices[j] = tiles.tileSize * loop.vertices[j];
 		}
-		#endif
-	};
-
-private:
-	b2World m_world;
-	Nan::Persistent<v8::Object> m_destruction_listener;
-	WrapDestructionListener m_wrap_destruction_listener;
-	Nan::Persistent<v8::Object> m_contact_filter;
-	WrapContactFilter m_wrap_contact_filter;
-	Nan::Persistent<v8::Object> m_contact_listener;
-	WrapContactListener m_wrap_contact_listener;
-	Nan::Persistent<v8::Object> m_draw;
-	WrapDraw m_wrap_draw;
-private:
-	WrapWorld(const b2Vec2& gravity) :
-		m_world(gravity),
-		m_wrap_destruction_listener(this),
-		m_wrap_contact_filter(this),
-		m_wrap_contact_listener(this),
-		m_wrap_draw(this)
-	{
-		m_world.SetDestructionListener(&m_wrap_destruction_listener);
-		m_world.SetContactFilter(&m_wrap_contact_filter);
-		m_world.SetContactListener(&m_wrap_contact_listener);
-		m_world.SetDebugDraw(&m_wrap_draw);
+		b2ChainShape chain;
+		chain.CreateLoop(&vertices[0], static_cast<int32>(vertices.size()));
+		b2FixtureDef fd = tiles.fd; // struct copy
+		fd.shape = &chain;
+		return body->CreateFixture(&fd);
 	}
-	~WrapWorld()
+	int32 RebuildTileCollision(b2Body* body, TileCollision& tiles, int32 x0, int32 y0, int32 x1, int32 y1)
 	{
-		m_world.SetDestructionListener(NULL);
-		m_world.SetContactFilter(NULL);
-		m_world.SetContactListener(NULL);
-		m_world.SetDebugDraw(NULL);
-		m_destruction_listener.Reset();
-		m_contact_filter.Reset();
-		m_contact_listener.Reset();
-		m_draw.Reset();
+		// tiles in [x0, x1) x [y0, y1) changed; only edges on corners [x0, x1] x [y0, y1] can differ
+		std::vector<TileLoop> loops;
+		TraceTileLoops(tiles.grid, tiles.width, tiles.height, loops);
+		// bodies created by a replay have no javascript object, and their fixtures get none either
+		WrapBody* wrap_body = WrapBody::GetWrap(body);
+		// fixtures may have been destroyed from script
+		std::set<b2Fixture*> live;
+		for (b2Fixture* fixture = body->GetFixtureList(); fixture; fixture = fixture->GetNext())
+		{
+			live.insert(fixture);
+		}
+		// drop old loops touching the dirty rect
+		std::vector<TileLoop> kept_loops;
+		std::vector<b2Fixture*> kept_fixtures;
+		for (size_t i = 0; i < tiles.loops.size(); ++i)
+		{
+			const TileLoop& loop = tiles.loops[i];
+			b2Fixture* fixture = tiles.fixtures[i];
+			if ((loop.x1 < x0) || (loop.x0 > x1) || (loop.y1 < y0) || (loop.y0 > y1))
+			{
+				if (live.count(fixture))
+				{
+					kept_loops.push_back(loop);
+					kept_fixtures.push_back(fixture);
+				}
+				continue;
+			}
+			if (live.count(fixture))
+			{
+				WrapFixture* wrap_fixture = WrapFixture::GetWrap(fixture);
+				if (wrap_fixture) { wrap_fixture->ResetObject(); }
+				body->DestroyFixture(fixture);
+			}
+		}
+		tiles.loops.swap(kept_loops);
+		tiles.fixtures.swap(kept_fixtures);
+		// add new loops touching the dirty rect
+		int32 built = 0;
+		std::vector<b2Vec2> vertices;
+		for (size_t i = 0; i < loops.size(); ++i)
+		{
+			const TileLoop& loop = loops[i];
+			if ((loop.x1 < x0) || (loop.x0 > x1) || (loop.y1 < y0) || (loop.y0 > y1)) { continue; }
+			// create box2d fixture
+			b2Fixture* fixture = CreateTileLoopFixture(body, tiles, loop, vertices);
+			if (wrap_body)
+			{
+				// create javascript fixture object
+				v8::Local<v8::Object> h_fixture = WrapFixture::NewInstance();
+				WrapFixture* wrap_fixture = WrapFixture::Unwrap(h_fixture);
+				// set up javascript fixture object
+				wrap_fixture->SetupObject(wrap_body->handle(), fixture, Nan::Undefined());
+			}
+			tiles.loops.push_back(loop);
+			tiles.fixtures.push_back(fixture);
+			++built;
+		}
+		return built;
 	}
-public:
-	b2World* Peek() { return &m_world; }
 public:
 	static WrapWorld* GetWrap(const b2World* world)
 	{
@@ -7652,6 +12522,8 @@ public:
 			g_function_template.Reset(function_template);
 			function_template->SetClassName(NANX_SYMBOL("b2World"));
 			function_template->InstanceTemplate()->SetInternalFieldCount(1);
+			NANX_METHOD_APPLY(function_template, StepWorlds)
+			NANX_METHOD_APPLY(function_template, Replay)
 			v8::Local<v8::ObjectTemplate> prototype_template = function_template->PrototypeTemplate();
 			NANX_METHOD_APPLY(prototype_template, SetDestructionListener)
 			NANX_METHOD_APPLY(prototype_template, SetContactFilter)
@@ -7659,9 +12531,24 @@ public:
 			NANX_METHOD_APPLY(prototype_template, SetDebugDraw)
 			NANX_METHOD_APPLY(prototype_template, CreateBody)
 			NANX_METHOD_APPLY(prototype_template, DestroyBody)
+			NANX_METHOD_APPLY(prototype_template, DestroyBodies)
+			NANX_METHOD_APPLY(prototype_template, Clear)
+			NANX_METHOD_APPLY(prototype_template, GetBodyById)
+			NANX_METHOD_APPLY(prototype_template, GetJointById)
+			NANX_METHOD_APPLY(prototype_template, CreateTileCollision)
+			NANX_METHOD_APPLY(prototype_template, UpdateTileCollision)
+			NANX_METHOD_APPLY(prototype_template, SetBodyTickDivisor)
+			NANX_METHOD_APPLY(prototype_template, SetBodyTickDivisors)
+			NANX_METHOD_APPLY(prototype_template, GetBodyTickDivisor)
 			NANX_METHOD_APPLY(prototype_template, CreateJoint)
+			NANX_METHOD_APPLY(prototype_template, CreateJoints)
 			NANX_METHOD_APPLY(prototype_template, DestroyJoint)
+			NANX_METHOD_APPLY(prototype_template, DestroyJoints)
+			NANX_METHOD_APPLY(prototype_template, CreatePrefab)
+			NANX_METHOD_APPLY(prototype_template, InstantiatePrefab)
 			NANX_METHOD_APPLY(prototype_template, Step)
+			NANX_METHOD_APPLY(prototype_template, SetInterpolationBodies)
+			NANX_METHOD_APPLY(prototype_template, Advance)
 			NANX_METHOD_APPLY(prototype_template, ClearForces)
 			NANX_METHOD_APPLY(prototype_template, DrawDebugData)
 			NANX_METHOD_APPLY(prototype_template, QueryAABB)
@@ -7680,14 +12567,28 @@ public:
 			NANX_METHOD_APPLY(prototype_template, GetContinuousPhysics)
 			NANX_METHOD_APPLY(prototype_template, SetSubStepping)
 			NANX_METHOD_APPLY(prototype_template, GetSubStepping)
+			NANX_METHOD_APPLY(prototype_template, GetProxyCount)
 			NANX_METHOD_APPLY(prototype_template, GetBodyCount)
 			NANX_METHOD_APPLY(prototype_template, GetJointCount)
 			NANX_METHOD_APPLY(prototype_template, GetContactCount)
+			NANX_METHOD_APPLY(prototype_template, GetTreeHeight)
+			NANX_METHOD_APPLY(prototype_template, GetTreeBalance)
+			NANX_METHOD_APPLY(prototype_template, GetTreeQuality)
 			NANX_METHOD_APPLY(prototype_template, SetGravity)
 			NANX_METHOD_APPLY(prototype_template, GetGravity)
 			NANX_METHOD_APPLY(prototype_template, IsLocked)
 			NANX_METHOD_APPLY(prototype_template, SetAutoClearForces)
 			NANX_METHOD_APPLY(prototype_template, GetAutoClearForces)
+			NANX_METHOD_APPLY(prototype_template, SetProfileWindow)
+			NANX_METHOD_APPLY(prototype_template, GetProfile)
+			NANX_METHOD_APPLY(prototype_template, GetStats)
+			NANX_METHOD_APPLY(prototype_template, ComputeStateHash)
+			NANX_METHOD_APPLY(prototype_template, StartRecording)
+			NANX_METHOD_APPLY(prototype_template, StopRecording)
+			NANX_METHOD_APPLY(prototype_template, IsRecording)
+			NANX_METHOD_APPLY(prototype_template, SetCallbackStatsEnabled)
+			NANX_METHOD_APPLY(prototype_template, GetCallbackStats)
+			NANX_METHOD_APPLY(prototype_template, GetMemoryStats)
 			#if B2_ENABLE_PARTICLE
 			NANX_METHOD_APPLY(prototype_template, CreateParticleSystem)
 			NANX_METHOD_APPLY(prototype_template, DestroyParticleSystem)
@@ -7712,7 +12613,14 @@ private:
 		if (info.IsConstructCall())
 		{
 			WrapVec2* wrap_gravity = WrapVec2::Unwrap(v8::Local<v8::Object>::Cast(info[0]));
-			WrapWorld* wrap = new WrapWorld(wrap_gravity->GetVec2());
+			size_t arena_size = 0;
+			#if NODE_BOX2D_TRACK_ALLOC
+			if (info[1]->IsObject())
+			{
+				arena_size = GetArenaSize(v8::Local<v8::Object>::Cast(info[1]));
+			}
+			#endif
+			WrapWorld* wrap = new WrapWorld(wrap_gravity->GetVec2(), arena_size);
 			wrap->Wrap(info.This());
 			info.GetReturnValue().Set(info.This());
 		}
@@ -7737,9 +12645,18 @@ private:
 	NANX_METHOD(SetContactFilter)
 	{
 		WrapWorld* wrap = Unwrap(info.This());
+		wrap->m_contact_filter_method.Reset();
 		if (info[0]->IsObject())
 		{
-			wrap->m_contact_filter.Reset(info[0].As<v8::Object>());
+			v8::Local<v8::Object> h_filter = info[0].As<v8::Object>();
+			wrap->m_contact_filter.Reset(h_filter);
+			// ShouldCollide is resolved once, here; new broad-phase pairs go straight to the default filter
+			// unless it is a function other than the one b2ContactFilter gives, which is the default filter
+			v8::Local<v8::Value> h_method = h_filter->Get(NANX_SYMBOL("ShouldCollide"));
+			if (h_method->IsFunction() && !IsStockMethod("b2ContactFilter", "ShouldCollide", h_method))
+			{
+				wrap->m_contact_filter_method.Reset(h_method.As<v8::Function>());
+			}
 		}
 		else
 		{
@@ -7749,9 +12666,25 @@ private:
 	NANX_METHOD(SetContactListener)
 	{
 		WrapWorld* wrap = Unwrap(info.This());
+		static const char* names[e_contactListenerMethodCount] = { "BeginContact", "EndContact", "BeginContactFixtureParticle", "EndContactFixtureParticle", "BeginContactParticleParticle", "EndContactParticleParticle", "PreSolve", "PostSolve" };
+		for (int32 i = 0; i < e_contactListenerMethodCount; ++i)
+		{
+			wrap->m_contact_listener_methods[i].Reset();
+		}
 		if (info[0]->IsObject())
 		{
-			wrap->m_contact_listener.Reset(info[0].As<v8::Object>());
+			v8::Local<v8::Object> h_listener = info[0].As<v8::Object>();
+			wrap->m_contact_listener.Reset(h_listener);
+			// methods are resolved once, here; later assignments need another SetContactListener.
+			// contacts with no method, or the empty one inherited from b2ContactListener, skip javascript
+			for (int32 i = 0; i < e_contactListenerMethodCount; ++i)
+			{
+				v8::Local<v8::Value> h_method = h_listener->Get(NANX_SYMBOL(names[i]));
+				if (h_method->IsFunction() && !IsStockMethod("b2ContactListener", names[i], h_method))
+				{
+					wrap->m_contact_listener_methods[i].Reset(h_method.As<v8::Function>());
+				}
+			}
 		}
 		else
 		{
@@ -7774,13 +12707,21 @@ private:
 	{
 		WrapWorld* wrap = Unwrap(info.This());
 		WrapBodyDef* wrap_bd = WrapBodyDef::Unwrap(v8::Local<v8::Object>::Cast(info[0]));
+		AllocScope alloc_scope(&wrap->m_alloc_stats);
 		// create box2d body
 		b2Body* body = wrap->m_world.CreateBody(&wrap_bd->UseBodyDef());
 		// create javascript body object
 		v8::Local<v8::Object> h_body = WrapBody::NewInstance();
 		WrapBody* wrap_body = WrapBody::Unwrap(h_body);
 		// set up javascript body object
-		wrap_body->SetupObject(info.This(), wrap_bd, body);
+		wrap_body->SetupObject(info.This(), wrap_bd, body, wrap->AddBodyId(body));
+		wrap_body->SetAllocStats(&wrap->m_alloc_stats);
+		wrap_body->SetRecorder(&wrap->m_recorder);
+		wrap_body->SetBodyTicks(&wrap->m_body_ticks);
+		if (wrap->m_recorder.IsRecording())
+		{
+			wrap->m_recorder.Op(e_recordCreateBody).Int(wrap_body->GetId()).BodyDef(wrap_bd->UseBodyDef());
+		}
 		info.GetReturnValue().Set(h_body);
 	}
 	NANX_METHOD(DestroyBody)
@@ -7788,15 +12729,249 @@ private:
 		WrapWorld* wrap = Unwrap(info.This());
 		v8::Local<v8::Object> h_body = v8::Local<v8::Object>::Cast(info[0]);
 		WrapBody* wrap_body = WrapBody::Unwrap(h_body);
+		AllocScope alloc_scope(&wrap->m_alloc_stats);
+		if (wrap->m_recorder.IsRecording())
+		{
+			wrap->m_recorder.Op(e_recordDestroyBody).Int(wrap_body->GetId());
+		}
+		wrap->RemoveBodyId(wrap_body->GetId());
+		wrap->m_tile_collisions.erase(wrap_body->Peek());
+		wrap->m_body_ticks.erase(wrap_body->Peek());
+		// reset javascript body object before the box2d body is freed
+		b2Body* body = wrap_body->ResetObject();
 		// delete box2d body
-		wrap->m_world.DestroyBody(wrap_body->Peek());
-		// reset javascript body object
-		wrap_body->ResetObject();
+		wrap->m_world.DestroyBody(body);
+	}
+	NANX_METHOD(DestroyBodies)
+	{
+		WrapWorld* wrap = Unwrap(info.This());
+		if (wrap->m_world.IsLocked())
+		{
+			return Nan::ThrowError("bodies cannot be destroyed during a step");
+		}
+		Nan::TypedArrayContents<int32_t> ids(info[0]);
+		int32 count = (info.Length() > 1)?(b2Min(NANX_int32(info[1]), static_cast<int32>(ids.length()))):(static_cast<int32>(ids.length()));
+		AllocScope alloc_scope(&wrap->m_alloc_stats);
+		// no per-item listener calls during bulk teardown
+		wrap->m_world.SetDestructionListener(NULL);
+		int32 destroyed = 0;
+		for (int32 i = 0; i < count; ++i)
+		{
+			b2Body* body = wrap->GetBodyById((*ids)[i]);
+			if (body)
+			{
+				if (wrap->m_recorder.IsRecording())
+				{
+					wrap->m_recorder.Op(e_recordDestroyBody).Int((*ids)[i]);
+				}
+				wrap->DestroyBodyQuiet(body);
+				++destroyed;
+			}
+		}
+		wrap->m_world.SetDestructionListener(&wrap->m_wrap_destruction_listener);
+		info.GetReturnValue().Set(Nan::New(destroyed));
+	}
+	NANX_METHOD(Clear)
+	{
+		WrapWorld* wrap = Unwrap(info.This());
+		if (wrap->m_world.IsLocked())
+		{
+			return Nan::ThrowError("bodies cannot be destroyed during a step");
+		}
+		AllocScope alloc_scope(&wrap->m_alloc_stats);
+		if (wrap->m_recorder.IsRecording())
+		{
+			wrap->m_recorder.Op(e_recordClear);
+		}
+		// no per-item listener calls during bulk teardown
+		wrap->m_world.SetDestructionListener(NULL);
+		int32 destroyed = 0;
+		b2Body* body = wrap->m_world.GetBodyList();
+		while (body)
+		{
+			b2Body* next = body->GetNext();
+			wrap->DestroyBodyQuiet(body);
+			++destroyed;
+			body = next;
+		}
+		wrap->m_world.SetDestructionListener(&wrap->m_wrap_destruction_listener);
+		// the world (and its block allocator pages) is kept for reuse, except with an arena,
+		// where the empty world is rebuilt and the arena pages released
+		wrap->m_body_table.clear();
+		wrap->m_body_table_free.clear();
+		wrap->m_joint_table.clear();
+		wrap->m_joint_table_free.clear();
+		wrap->m_joint_ids.clear();
+		wrap->m_tile_collisions.clear();
+		wrap->m_body_ticks.clear();
+		wrap->ResetArena();
+		info.GetReturnValue().Set(Nan::New(destroyed));
+	}
+	NANX_METHOD(CreateTileCollision)
+	{
+		WrapWorld* wrap = Unwrap(info.This());
+		Nan::TypedArrayContents<uint8_t> h_grid(info[0]);
+		int32 width = NANX_int32(info[1]);
+		int32 height = NANX_int32(info[2]);
+		float32 tileSize = (info.Length() > 3 && !info[3]->IsUndefined())?(NANX_float32(info[3])):(1.0f);
+		b2Vec2* origin = WrapVec2::Peek(info[4]);
+		WrapFixtureDef* wrap_fd = WrapFixtureDef::Unwrap(info[5]);
+		if ((width <= 0) || (height <= 0) || (h_grid.length() < static_cast<size_t>(width * height)))
+		{
+			return Nan::ThrowRangeError("grid is smaller than width * height");
+		}
+		AllocScope alloc_scope(&wrap->m_alloc_stats);
+		// create static box2d body at the grid origin
+		b2BodyDef bd;
+		if (origin) { bd.position = *origin; }
+		b2Body* body = wrap->m_world.CreateBody(&bd);
+		v8::Local<v8::Object> h_body = wrap->NewBodyObject(info.This(), body, Nan::Undefined());
+		b2FixtureDef fd;
+		if (wrap_fd)
+		{
+			fd = wrap_fd->UseFixtureDef(); // struct copy
+		}
+		if (wrap->m_recorder.IsRecording())
+		{
+			wrap->m_recorder.Op(e_recordCreateTileCollision).Int(WrapBody::GetWrap(body)->GetId()).Vec2(bd.position);
+			wrap->m_recorder.Int(width).Int(height).Float(tileSize).Material(fd).Bytes(*h_grid, width * height);
+		}
+		wrap->SetupTileCollision(body, width, height, tileSize, *h_grid, fd);
+		info.GetReturnValue().Set(h_body);
+	}
+	NANX_METHOD(UpdateTileCollision)
+	{
+		WrapWorld* wrap = Unwrap(info.This());
+		b2Body* body = WrapBody::Peek(info[0]);
+		std::map<b2Body*,TileCollision>::iterator it = wrap->m_tile_collisions.find(body);
+		if (it == wrap->m_tile_collisions.end())
+		{
+			return Nan::ThrowError("body was not created by CreateTileCollision");
+		}
+		TileCollision& tiles = it->second;
+		Nan::TypedArrayContents<uint8_t> h_grid(info[1]);
+		if (h_grid.length() < tiles.grid.size())
+		{
+			return Nan::ThrowRangeError("grid is smaller than width * height");
+		}
+		AllocScope alloc_scope(&wrap->m_alloc_stats);
+		// dirty rect defaults to the whole grid
+		int32 x0 = (info.Length() > 2)?(b2Clamp(NANX_int32(info[2]), 0, tiles.width)):(0);
+		int32 y0 = (info.Length() > 3)?(b2Clamp(NANX_int32(info[3]), 0, tiles.height)):(0);
+		int32 x1 = (info.Length() > 4)?(b2Clamp(x0 + NANX_int32(info[4]), x0, tiles.width)):(tiles.width);
+		int32 y1 = (info.Length() > 5)?(b2Clamp(y0 + NANX_int32(info[5]), y0, tiles.height)):(tiles.height);
+		if (wrap->m_recorder.IsRecording())
+		{
+			// only the dirty rect, row by row
+			wrap->m_recorder.Op(e_recordUpdateTileCollision).Int(WrapBody::GetWrap(body)->GetId()).Int(x0).Int(y0).Int(x1).Int(y1);
+			for (int32 y = y0; (y < y1) && (x1 > x0); ++y)
+			{
+				wrap->m_recorder.Bytes(*h_grid + y * tiles.width + x0, x1 - x0);
+			}
+		}
+		for (int32 y = y0; y < y1; ++y)
+		{
+			for (int32 x = x0; x < x1; ++x)
+			{
+				tiles.grid[y * tiles.width + x] = (*h_grid)[y * tiles.width + x];
+			}
+		}
+		info.GetReturnValue().Set(Nan::New(wrap->RebuildTileCollision(body, tiles, x0, y0, x1, y1)));
+	}
+	NANX_METHOD(SetBodyTickDivisor)
+	{
+		WrapWorld* wrap = Unwrap(info.This());
+		b2Body* body = WrapBody::Peek(info[0]);
+		int32 divisor = NANX_int32(info[1]);
+		int32 phase = (info.Length() > 2)?(NANX_int32(info[2])):(0);
+		if (!body)
+		{
+			return Nan::ThrowError("body was destroyed");
+		}
+		if (!IsTickDivisor(divisor))
+		{
+			return Nan::ThrowRangeError("divisor must be 1, 2, 4 or 8");
+		}
+		if (wrap->m_world.IsLocked())
+		{
+			return Nan::ThrowError("tick divisors cannot change during a step");
+		}
+		if (wrap->m_recorder.IsRecording())
+		{
+			wrap->m_recorder.Op(e_recordSetBodyTick).Int(WrapBody::Unwrap(info[0])->GetId()).Int(divisor).Int(phase);
+		}
+		wrap->SetBodyTick(body, divisor, phase);
+	}
+	NANX_METHOD(SetBodyTickDivisors)
+	{
+		WrapWorld* wrap = Unwrap(info.This());
+		Nan::TypedArrayContents<int32_t> ids(info[0]);
+		int32 divisor = NANX_int32(info[1]);
+		int32 phase = (info.Length() > 2)?(NANX_int32(info[2])):(0);
+		if (!IsTickDivisor(divisor))
+		{
+			return Nan::ThrowRangeError("divisor must be 1, 2, 4 or 8");
+		}
+		if (wrap->m_world.IsLocked())
+		{
+			return Nan::ThrowError("tick divisors cannot change during a step");
+		}
+		int32 count = 0;
+		for (size_t i = 0; i < ids.length(); ++i)
+		{
+			b2Body* body = wrap->GetBodyById((*ids)[i]);
+			if (body)
+			{
+				if (wrap->m_recorder.IsRecording())
+				{
+					wrap->m_recorder.Op(e_recordSetBodyTick).Int((*ids)[i]).Int(divisor).Int(phase);
+				}
+				wrap->SetBodyTick(body, divisor, phase);
+				++count;
+			}
+		}
+		info.GetReturnValue().Set(Nan::New(count));
+	}
+	NANX_METHOD(GetBodyTickDivisor)
+	{
+		WrapWorld* wrap = Unwrap(info.This());
+		BodyTickMap::const_iterator it = wrap->m_body_ticks.find(WrapBody::Peek(info[0]));
+		info.GetReturnValue().Set(Nan::New((it != wrap->m_body_ticks.end())?(it->second.divisor):(1)));
+	}
+	NANX_METHOD(GetBodyById)
+	{
+		WrapWorld* wrap = Unwrap(info.This());
+		b2Body* body = wrap->GetBodyById(NANX_int32(info[0]));
+		WrapBody* wrap_body = (body)?(WrapBody::GetWrap(body)):(NULL);
+		if (wrap_body)
+		{
+			info.GetReturnValue().Set(wrap_body->handle());
+		}
+		else
+		{
+			info.GetReturnValue().SetNull();
+		}
+	}
+	NANX_METHOD(GetJointById)
+	{
+		// native joints get their object here, on first use
+		WrapWorld* wrap = Unwrap(info.This());
+		b2Joint* joint = wrap->GetJointById(NANX_int32(info[0]));
+		if (joint)
+		{
+			info.GetReturnValue().Set(GetJointObject(info.This(), joint));
+		}
+		else
+		{
+			info.GetReturnValue().SetNull();
+		}
 	}
 	NANX_METHOD(CreateJoint)
 	{
 		WrapWorld* wrap = Unwrap(info.This());
 		WrapJointDef* wrap_jd = WrapJointDef::Unwrap(v8::Local<v8::Object>::Cast(info[0]));
+		AllocScope alloc_scope(&wrap->m_alloc_stats);
+		b2Joint* joint = NULL; // box2d joint created, if any
 		switch (wrap_jd->GetJointDef().type)
 		{
 		case e_unknownJoint:
@@ -7808,6 +12983,7 @@ private:
 			WrapRevoluteJointDef* wrap_revolute_jd = WrapRevoluteJointDef::Unwrap(v8::Local<v8::Object>::Cast(info[0]));
 			// create box2d revolute joint
 			b2RevoluteJoint* revolute_joint = static_cast<b2RevoluteJoint*>(wrap->m_world.CreateJoint(&wrap_revolute_jd->UseJointDef()));
+			joint = revolute_joint;
 			// create javascript revolute joint object
 			v8::Local<v8::Object> h_revolute_joint = WrapRevoluteJoint::NewInstance();
 			WrapRevoluteJoint* wrap_revolute_joint = WrapRevoluteJoint::Unwrap(h_revolute_joint);
@@ -7821,6 +12997,7 @@ private:
 			WrapPrismaticJointDef* wrap_prismatic_jd = WrapPrismaticJointDef::Unwrap(v8::Local<v8::Object>::Cast(info[0]));
 			// create box2d prismatic joint
 			b2PrismaticJoint* prismatic_joint = static_cast<b2PrismaticJoint*>(wrap->m_world.CreateJoint(&wrap_prismatic_jd->UseJointDef()));
+			joint = prismatic_joint;
 			// create javascript prismatic joint object
 			v8::Local<v8::Object> h_prismatic_joint = WrapPrismaticJoint::NewInstance();
 			WrapPrismaticJoint* wrap_prismatic_joint = WrapPrismaticJoint::Unwrap(h_prismatic_joint);
@@ -7834,6 +13011,7 @@ private:
 			WrapDistanceJointDef* wrap_distance_jd = WrapDistanceJointDef::Unwrap(v8::Local<v8::Object>::Cast(info[0]));
 			// create box2d distance joint
 			b2DistanceJoint* distance_joint = static_cast<b2DistanceJoint*>(wrap->m_world.CreateJoint(&wrap_distance_jd->UseJointDef()));
+			joint = distance_joint;
 			// create javascript distance joint object
 			v8::Local<v8::Object> h_distance_joint = WrapDistanceJoint::NewInstance();
 			WrapDistanceJoint* wrap_distance_joint = WrapDistanceJoint::Unwrap(h_distance_joint);
@@ -7847,6 +13025,7 @@ private:
 			WrapPulleyJointDef* wrap_pulley_jd = WrapPulleyJointDef::Unwrap(v8::Local<v8::Object>::Cast(info[0]));
 			// create box2d pulley joint
 			b2PulleyJoint* pulley_joint = static_cast<b2PulleyJoint*>(wrap->m_world.CreateJoint(&wrap_pulley_jd->UseJointDef()));
+			joint = pulley_joint;
 			// create javascript pulley joint object
 			v8::Local<v8::Object> h_pulley_joint = WrapPulleyJoint::NewInstance();
 			WrapPulleyJoint* wrap_pulley_joint = WrapPulleyJoint::Unwrap(h_pulley_joint);
@@ -7860,6 +13039,7 @@ private:
 			WrapMouseJointDef* wrap_mouse_jd = WrapMouseJointDef::Unwrap(v8::Local<v8::Object>::Cast(info[0]));
 			// create box2d mouse joint
 			b2MouseJoint* mouse_joint = static_cast<b2MouseJoint*>(wrap->m_world.CreateJoint(&wrap_mouse_jd->UseJointDef()));
+			joint = mouse_joint;
 			// create javascript mouse joint object
 			v8::Local<v8::Object> h_mouse_joint = WrapMouseJoint::NewInstance();
 			WrapMouseJoint* wrap_mouse_joint = WrapMouseJoint::Unwrap(h_mouse_joint);
@@ -7871,8 +13051,14 @@ private:
 		case e_gearJoint:
 		{
 			WrapGearJointDef* wrap_gear_jd = WrapGearJointDef::Unwrap(v8::Local<v8::Object>::Cast(info[0]));
+			const b2JointDef& gear_jd = wrap_gear_jd->UseJointDef();
+			if (!wrap_gear_jd->Peek()->joint1 || !wrap_gear_jd->Peek()->joint2)
+			{
+				return Nan::ThrowError("gear joint needs joint1 and joint2");
+			}
 			// create box2d gear joint
-			b2GearJoint* gear_joint = static_cast<b2GearJoint*>(wrap->m_world.CreateJoint(&wrap_gear_jd->UseJointDef()));
+			b2GearJoint* gear_joint = static_cast<b2GearJoint*>(wrap->m_world.CreateJoint(&gear_jd));
+			joint = gear_joint;
 			// create javascript gear joint object
 			v8::Local<v8::Object> h_gear_joint = WrapGearJoint::NewInstance();
 			WrapGearJoint* wrap_gear_joint = WrapGearJoint::Unwrap(h_gear_joint);
@@ -7886,6 +13072,7 @@ private:
 			WrapWheelJointDef* wrap_wheel_jd = WrapWheelJointDef::Unwrap(v8::Local<v8::Object>::Cast(info[0]));
 			// create box2d wheel joint
 			b2WheelJoint* wheel_joint = static_cast<b2WheelJoint*>(wrap->m_world.CreateJoint(&wrap_wheel_jd->UseJointDef()));
+			joint = wheel_joint;
 			// create javascript wheel joint object
 			v8::Local<v8::Object> h_wheel_joint = WrapWheelJoint::NewInstance();
 			WrapWheelJoint* wrap_wheel_joint = WrapWheelJoint::Unwrap(h_wheel_joint);
@@ -7899,6 +13086,7 @@ private:
 			WrapWeldJointDef* wrap_weld_jd = WrapWeldJointDef::Unwrap(v8::Local<v8::Object>::Cast(info[0]));
 			// create box2d weld joint
 			b2WeldJoint* weld_joint = static_cast<b2WeldJoint*>(wrap->m_world.CreateJoint(&wrap_weld_jd->UseJointDef()));
+			joint = weld_joint;
 			// create javascript weld joint object
 			v8::Local<v8::Object> h_weld_joint = WrapWeldJoint::NewInstance();
 			WrapWeldJoint* wrap_weld_joint = WrapWeldJoint::Unwrap(h_weld_joint);
@@ -7912,6 +13100,7 @@ private:
 			WrapFrictionJointDef* wrap_friction_jd = WrapFrictionJointDef::Unwrap(v8::Local<v8::Object>::Cast(info[0]));
 			// create box2d friction joint
 			b2FrictionJoint* friction_joint = static_cast<b2FrictionJoint*>(wrap->m_world.CreateJoint(&wrap_friction_jd->UseJointDef()));
+			joint = friction_joint;
 			// create javascript friction joint object
 			v8::Local<v8::Object> h_friction_joint = WrapFrictionJoint::NewInstance();
 			WrapFrictionJoint* wrap_friction_joint = WrapFrictionJoint::Unwrap(h_friction_joint);
@@ -7925,6 +13114,7 @@ private:
 			WrapRopeJointDef* wrap_rope_jd = WrapRopeJointDef::Unwrap(v8::Local<v8::Object>::Cast(info[0]));
 			// create box2d rope joint
 			b2RopeJoint* rope_joint = static_cast<b2RopeJoint*>(wrap->m_world.CreateJoint(&wrap_rope_jd->UseJointDef()));
+			joint = rope_joint;
 			// create javascript rope joint object
 			v8::Local<v8::Object> h_rope_joint = WrapRopeJoint::NewInstance();
 			WrapRopeJoint* wrap_rope_joint = WrapRopeJoint::Unwrap(h_rope_joint);
@@ -7938,6 +13128,7 @@ private:
 			WrapMotorJointDef* wrap_motor_jd = WrapMotorJointDef::Unwrap(v8::Local<v8::Object>::Cast(info[0]));
 			// create box2d motor joint
 			b2MotorJoint* motor_joint = static_cast<b2MotorJoint*>(wrap->m_world.CreateJoint(&wrap_motor_jd->UseJointDef()));
+			joint = motor_joint;
 			// create javascript motor joint object
 			v8::Local<v8::Object> h_motor_joint = WrapMotorJoint::NewInstance();
 			WrapMotorJoint* wrap_motor_joint = WrapMotorJoint::Unwrap(h_motor_joint);
@@ -7947,12 +13138,92 @@ private:
 			break;
 		}
 		}
+		if (joint)
+		{
+			// box2d returns NULL while the world is locked
+			wrap->AddJointId(joint);
+			if (wrap->m_recorder.IsRecording()) { wrap->RecordCreateJoint(joint, wrap_jd->GetJointDef()); }
+		}
+	}
+	NANX_METHOD(CreateJoints)
+	{
+		// world.CreateJoints(type, bodyPairs, params[, outJoints]) creates one joint of type per [bodyA id, bodyB id]
+		// in the Int32Array bodyPairs, reading its settings from the next record of the Float32Array params:
+		//   revolute: localAnchorA x y, localAnchorB x y, referenceAngle, enableLimit, lowerAngle, upperAngle, enableMotor, motorSpeed, maxMotorTorque
+		//   prismatic: localAnchorA x y, localAnchorB x y, localAxisA x y, referenceAngle, enableLimit, lowerTranslation, upperTranslation, enableMotor, motorSpeed, maxMotorForce
+		//   distance: localAnchorA x y, localAnchorB x y, length, frequencyHz, dampingRatio
+		//   pulley: groundAnchorA x y, groundAnchorB x y, localAnchorA x y, localAnchorB x y, lengthA, lengthB, ratio
+		//   mouse: target x y, maxForce, frequencyHz, dampingRatio
+		//   wheel: localAnchorA x y, localAnchorB x y, localAxisA x y, enableMotor, motorSpeed, maxMotorTorque, frequencyHz, dampingRatio
+		//   weld: localAnchorA x y, localAnchorB x y, referenceAngle, frequencyHz, dampingRatio
+		//   friction: localAnchorA x y, localAnchorB x y, maxForce, maxTorque
+		//   rope: localAnchorA x y, localAnchorB x y, maxLength
+		//   motor: linearOffset x y, angularOffset, maxForce, maxTorque, correctionFactor
+		// each followed by collideConnected; flags are non-zero for true. joints are native only unless
+		// outJoints is an Array, which then gets a joint object per record; returns an Int32Array of
+		// joint ids for GetJointById and DestroyJoints
+		WrapWorld* wrap = Unwrap(info.This());
+		b2JointType type = static_cast<b2JointType>(NANX_int32(info[0]));
+		const int32 param_count = GetJointParamCount(type);
+		if (param_count == 0)
+		{
+			return Nan::ThrowRangeError("joint type cannot be created from body pairs");
+		}
+		if (wrap->m_world.IsLocked())
+		{
+			return Nan::ThrowError("joints cannot be created during a step");
+		}
+		Nan::TypedArrayContents<int32_t> h_body_pairs(info[1]);
+		Nan::TypedArrayContents<float32> h_params(info[2]);
+		const int32 count = static_cast<int32>(h_body_pairs.length() / 2);
+		if (h_params.length() < static_cast<size_t>(count) * param_count)
+		{
+			return Nan::ThrowRangeError("params is smaller than bodyPairs.length / 2 records");
+		}
+		// check every pair first so a bad id creates nothing
+		for (int32 i = 0; i < count; ++i)
+		{
+			b2Body* bodyA = wrap->GetBodyById((*h_body_pairs)[2 * i + 0]);
+			b2Body* bodyB = wrap->GetBodyById((*h_body_pairs)[2 * i + 1]);
+			if (!bodyA || !bodyB || (bodyA == bodyB))
+			{
+				return Nan::ThrowRangeError("bodyPairs holds an invalid body id");
+			}
+		}
+		v8::Local<v8::Array> h_out_joints;
+		if (info[3]->IsArray()) { h_out_joints = v8::Local<v8::Array>::Cast(info[3]); }
+		v8::Local<v8::Int32Array> h_joint_ids = v8::Int32Array::New(v8::ArrayBuffer::New(v8::Isolate::GetCurrent(), count * sizeof(int32)), 0, count);
+		Nan::TypedArrayContents<int32_t> joint_ids(h_joint_ids);
+		AllocScope alloc_scope(&wrap->m_alloc_stats);
+		RecordJointDefs defs;
+		for (int32 i = 0; i < count; ++i)
+		{
+			b2JointDef* jd = ReadJointParams(type, *h_params + i * param_count, defs);
+			jd->bodyA = wrap->GetBodyById((*h_body_pairs)[2 * i + 0]);
+			jd->bodyB = wrap->GetBodyById((*h_body_pairs)[2 * i + 1]);
+			b2Joint* joint = wrap->m_world.CreateJoint(jd);
+			(*joint_ids)[i] = wrap->AddJointId(joint);
+			if (wrap->m_recorder.IsRecording()) { wrap->RecordCreateJoint(joint, *jd); }
+			if (!h_out_joints.IsEmpty())
+			{
+				Nan::HandleScope scope;
+				Nan::Set(h_out_joints, static_cast<uint32_t>(i), NewJointObject(info.This(), *jd, joint));
+			}
+		}
+		info.GetReturnValue().Set(h_joint_ids);
 	}
 	NANX_METHOD(DestroyJoint)
 	{
 		WrapWorld* wrap = Unwrap(info.This());
 		v8::Local<v8::Object> h_joint = v8::Local<v8::Object>::Cast(info[0]);
 		WrapJoint* wrap_joint = WrapJoint::Unwrap(h_joint);
+		AllocScope alloc_scope(&wrap->m_alloc_stats);
+		if (wrap->m_recorder.IsRecording())
+		{
+			wrap->m_recorder.Op(e_recordDestroyJoint).Int(wrap->m_recorder.GetJointId(wrap_joint->GetJoint()));
+			wrap->m_recorder.RemoveJoint(wrap_joint->GetJoint());
+		}
+		wrap->RemoveJointId(wrap_joint->GetJoint());
 		switch (wrap_joint->GetJoint()->GetType())
 		{
 		case e_unknownJoint:
@@ -8071,23 +13342,365 @@ private:
 			break;
 		}
 	}
-	NANX_METHOD(Step)
+	NANX_METHOD(DestroyJoints)
+	{
+		// world.DestroyJoints(ids[, count]) destroys the joints named by the Int32Array ids, as returned by
+		// CreateJoints and InstantiatePrefab; ids that name no joint are skipped; returns the number destroyed
+		WrapWorld* wrap = Unwrap(info.This());
+		if (wrap->m_world.IsLocked())
+		{
+			return Nan::ThrowError("joints cannot be destroyed during a step");
+		}
+		Nan::TypedArrayContents<int32_t> ids(info[0]);
+		int32 count = (info.Length() > 1)?(b2Min(NANX_int32(info[1]), static_cast<int32>(ids.length()))):(static_cast<int32>(ids.length()));
+		AllocScope alloc_scope(&wrap->m_alloc_stats);
+		int32 destroyed = 0;
+		for (int32 i = 0; i < count; ++i)
+		{
+			b2Joint* joint = wrap->GetJointById((*ids)[i]);
+			if (joint)
+			{
+				if (wrap->m_recorder.IsRecording())
+				{
+					wrap->m_recorder.Op(e_recordDestroyJoint).Int(wrap->m_recorder.GetJointId(joint));
+					wrap->m_recorder.RemoveJoint(joint);
+				}
+				// reset javascript joint object, if any, while the box2d joint is still alive
+				ResetJointObject(joint);
+				wrap->RemoveJointId(joint);
+				wrap->m_world.DestroyJoint(joint);
+				++destroyed;
+			}
+		}
+		info.GetReturnValue().Set(Nan::New(destroyed));
+	}
+	NANX_METHOD(CreatePrefab)
+	{
+		// world.CreatePrefab(bodies, fixtures, joints) copies def objects into a b2Prefab: bodies is an Array of
+		// b2BodyDef placed relative to the prefab origin, fixtures[i] an Array of b2FixtureDef for body i, and
+		// joints an Array of { def, bodyA, bodyB, joint1, joint2 } naming bodies (and gear joints) by index;
+		// user data is not copied, and later changes to the defs do not affect the prefab
+		if (!info[0]->IsArray())
+		{
+			return Nan::ThrowTypeError("bodies must be an Array of b2BodyDef");
+		}
+		v8::Local<v8::Array> h_bodies = v8::Local<v8::Array>::Cast(info[0]);
+		v8::Local<v8::Array> h_fixtures = (info[1]->IsArray())?(v8::Local<v8::Array>::Cast(info[1])):(Nan::New<v8::Array>(0));
+		v8::Local<v8::Array> h_joints = (info[2]->IsArray())?(v8::Local<v8::Array>::Cast(info[2])):(Nan::New<v8::Array>(0));
+		v8::Local<v8::Object> h_prefab = WrapPrefab::NewInstance();
+		Scene& scene = WrapPrefab::Unwrap(h_prefab)->GetScene();
+		const int32 body_count = static_cast<int32>(h_bodies->Length());
+		scene.bodies.resize(body_count);
+		for (int32 i = 0; i < body_count; ++i)
+		{
+			WrapBodyDef* wrap_bd = WrapBodyDef::Unwrap(h_bodies->Get(i));
+			if (!wrap_bd)
+			{
+				return Nan::ThrowTypeError("bodies must be an Array of b2BodyDef");
+			}
+			SceneBody& scene_body = scene.bodies[i];
+			scene_body.bd = wrap_bd->UseBodyDef(); // struct copy
+			scene_body.bd.userData = NULL;
+			scene_body.has_mass_data = false;
+			v8::Local<v8::Value> h_body_fixtures = (static_cast<uint32_t>(i) < h_fixtures->Length())?(h_fixtures->Get(i)):(v8::Local<v8::Value>(Nan::Undefined()));
+			if (!h_body_fixtures->IsArray()) { continue; }
+			v8::Local<v8::Array> h_fds = v8::Local<v8::Array>::Cast(h_body_fixtures);
+			scene_body.fixtures.resize(h_fds->Length());
+			for (uint32_t j = 0; j < h_fds->Length(); ++j)
+			{
+				WrapFixtureDef* wrap_fd = WrapFixtureDef::Unwrap(h_fds->Get(j));
+				if (!wrap_fd)
+				{
+					return Nan::ThrowTypeError("fixtures must be an Array of Arrays of b2FixtureDef");
+				}
+				SceneFixture& scene_fixture = scene_body.fixtures[j];
+				scene_fixture.fd = wrap_fd->UseFixtureDef(); // struct copy
+				if (!SceneCopyShape(scene_fixture.fd.shape, scene_fixture))
+				{
+					return Nan::ThrowError("prefab fixture shape is missing or invalid");
+				}
+				scene_fixture.fd.shape = NULL;
+				scene_fixture.fd.userData = NULL;
+			}
+		}
+		const int32 joint_count = static_cast<int32>(h_joints->Length());
+		scene.joints.resize(joint_count);
+		for (int32 i = 0; i < joint_count; ++i)
+		{
+			v8::Local<v8::Value> h_joint = h_joints->Get(i);
+			if (!h_joint->IsObject())
+			{
+				return Nan::ThrowTypeError("joints must be an Array of { def, bodyA, bodyB }");
+			}
+			v8::Local<v8::Object> h_joint_object = v8::Local<v8::Object>::Cast(h_joint);
+			WrapJointDef* wrap_jd = WrapJointDef::Unwrap(h_joint_object->Get(NANX_SYMBOL("def")));
+			if (!wrap_jd)
+			{
+				return Nan::ThrowTypeError("joints must be an Array of { def, bodyA, bodyB }");
+			}
+			SceneJoint& scene_joint = scene.joints[i];
+			// a gear def here names its joints by index, so its joint1 and joint2 objects may be unset
+			const b2JointDef& jd = wrap_jd->UseJointDef();
+			scene_joint.type = jd.type;
+			b2JointDef* scene_jd = scene_joint.defs.Get(jd.type);
+			if (!scene_jd)
+			{
+				return Nan::ThrowError("prefab joint type is unknown");
+			}
+			// the def wrapper holds the derived def, so it is copied whole like a replayed one
+			memcpy(static_cast<void*>(scene_jd), &jd, GetJointDefSize(jd.type));
+			scene_jd->userData = NULL;
+			scene_jd->bodyA = NULL;
+			scene_jd->bodyB = NULL;
+			if (jd.type == e_gearJoint)
+			{
+				scene_joint.defs.gear.joint1 = NULL;
+				scene_joint.defs.gear.joint2 = NULL;
+			}
+			v8::Local<v8::Value> h_joint1 = h_joint_object->Get(NANX_SYMBOL("joint1"));
+			v8::Local<v8::Value> h_joint2 = h_joint_object->Get(NANX_SYMBOL("joint2"));
+			scene_joint.bodyA = NANX_int32(h_joint_object->Get(NANX_SYMBOL("bodyA")));
+			scene_joint.bodyB = NANX_int32(h_joint_object->Get(NANX_SYMBOL("bodyB")));
+			scene_joint.joint1 = (h_joint1->IsNumber())?(NANX_int32(h_joint1)):(-1);
+			scene_joint.joint2 = (h_joint2->IsNumber())?(NANX_int32(h_joint2)):(-1);
+			if ((scene_joint.bodyA < 0) || (scene_joint.bodyA >= body_count) || (scene_joint.bodyB < 0) || (scene_joint.bodyB >= body_count) || (scene_joint.bodyA == scene_joint.bodyB))
+			{
+				return Nan::ThrowRangeError("prefab joint bodies are invalid");
+			}
+		}
+		// gear joints are created after the others and must join two revolute or prismatic joints
+		for (int32 i = 0; i < joint_count; ++i)
+		{
+			const SceneJoint& scene_joint = scene.joints[i];
+			if (scene_joint.type != e_gearJoint) { continue; }
+			int32 ends[2] = { scene_joint.joint1, scene_joint.joint2 };
+			for (int32 e = 0; e < 2; ++e)
+			{
+				b2JointType type = ((ends[e] >= 0) && (ends[e] < joint_count))?(scene.joints[ends[e]].type):(e_unknownJoint);
+				if ((type != e_revoluteJoint) && (type != e_prismaticJoint))
+				{
+					return Nan::ThrowRangeError("prefab gear joint must join revolute or prismatic joints");
+				}
+			}
+		}
+		info.GetReturnValue().Set(h_prefab);
+	}
+	NANX_METHOD(InstantiatePrefab)
+	{
+		// world.InstantiatePrefab(prefab, transforms, outIds[, outJointIds]) creates one copy of prefab per
+		// [x, y, angle] in the Float32Array transforms and writes the body ids of each copy, in prefab order,
+		// to the Int32Array outIds one copy after another; joints are native only, like those of LoadScene,
+		// and their ids go to the Int32Array outJointIds the same way; returns the number of copies
+		WrapWorld* wrap = Unwrap(info.This());
+		WrapPrefab* wrap_prefab = WrapPrefab::Unwrap(info[0]);
+		if (!wrap_prefab)
+		{
+			return Nan::ThrowTypeError("prefab must be a b2Prefab");
+		}
+		if (wrap->m_world.IsLocked())
+		{
+			return Nan::ThrowError("prefab cannot be instantiated during a step");
+		}
+		const Scene& scene = wrap_prefab->GetScene();
+		Nan::TypedArrayContents<float32> h_transforms(info[1]);
+		Nan::TypedArrayContents<int32_t> h_out_ids(info[2]);
+		const int32 count = static_cast<int32>(h_transforms.length() / 3);
+		const size_t body_count = scene.bodies.size();
+		if (h_out_ids.length() < static_cast<size_t>(count) * body_count)
+		{
+			return Nan::ThrowRangeError("outIds is smaller than copies * prefab.GetBodyCount()");
+		}
+		const bool has_out_joint_ids = (info.Length() > 3) && !info[3]->IsUndefined();
+		Nan::TypedArrayContents<int32_t> h_out_joint_ids(info[3]);
+		const size_t joint_count = scene.joints.size();
+		if (has_out_joint_ids && (h_out_joint_ids.length() < static_cast<size_t>(count) * joint_count))
+		{
+			return Nan::ThrowRangeError("outJointIds is smaller than copies * prefab.GetJointCount()");
+		}
+		AllocScope alloc_scope(&wrap->m_alloc_stats);
+		std::vector<b2Body*> bodies;
+		std::vector<int32> body_ids;
+		std::vector<b2Joint*> joints;
+		std::vector<int32> joint_ids;
+		for (int32 i = 0; i < count; ++i)
+		{
+			Nan::HandleScope scope;
+			const float32* transform = *h_transforms + 3 * i;
+			b2Transform xf(b2Vec2(transform[0], transform[1]), b2Rot(transform[2]));
+			wrap->CreateSceneBodies(info.This(), scene, xf, bodies, body_ids);
+			wrap->CreateSceneJoints(scene, xf, bodies, joints, joint_ids);
+			for (size_t j = 0; j < body_count; ++j)
+			{
+				(*h_out_ids)[i * body_count + j] = body_ids[j];
+			}
+			for (size_t j = 0; has_out_joint_ids && (j < joint_count); ++j)
+			{
+				(*h_out_joint_ids)[i * joint_count + j] = joint_ids[j];
+			}
+		}
+		info.GetReturnValue().Set(Nan::New(count));
+	}
+	NANX_METHOD(Step)
+	{
+		WrapWorld* wrap = Unwrap(info.This());
+		float32 timeStep = NANX_float32(info[0]);
+		int32 velocityIterations = NANX_int32(info[1]);
+		int32 positionIterations = NANX_int32(info[2]);
+		#if B2_ENABLE_PARTICLE
+		int32 particleIterations = (info.Length() > 3)?(NANX_int32(info[3])):(wrap->m_world.CalculateReasonableParticleIterations(timeStep));
+		#else
+		int32 particleIterations = 0;
+		#endif
+		wrap->ResetCallbackStats();
+		AllocScope alloc_scope(&wrap->m_alloc_stats);
+		wrap->StepWorld(timeStep, velocityIterations, positionIterations, particleIterations);
+	}
+	NANX_METHOD(StepWorlds)
+	{
+		// b2World.StepWorlds(worlds, timeStep, velocityIterations, positionIterations[, threadCount])
+		// each world is stepped whole by one thread, so results match stepping them one by one;
+		// worlds with javascript listeners are stepped on this thread afterwards
+		v8::Local<v8::Array> h_worlds = v8::Local<v8::Array>::Cast(info[0]);
+		StepWorldsJob job;
+		job.timeStep = NANX_float32(info[1]);
+		job.velocityIterations = NANX_int32(info[2]);
+		job.positionIterations = NANX_int32(info[3]);
+		job.next = 0;
+		int32 thread_count = 0;
+		if (info.Length() > 4 && !info[4]->IsUndefined())
+		{
+			thread_count = NANX_int32(info[4]);
+		}
+		else
+		{
+			uv_cpu_info_t* cpu_infos = NULL;
+			int cpu_count = 0;
+			if (uv_cpu_info(&cpu_infos, &cpu_count) == 0) { uv_free_cpu_info(cpu_infos, cpu_count); }
+			thread_count = b2Max(cpu_count, 1);
+		}
+		std::vector<WrapWorld*> serial;
+		std::set<WrapWorld*> seen;
+		for (uint32_t i = 0; i < h_worlds->Length(); ++i)
+		{
+			WrapWorld* wrap = Unwrap(h_worlds->Get(i));
+			if (!wrap || !seen.insert(wrap).second) { continue; }
+			wrap->ResetCallbackStats();
+			if (wrap->CanStepOffThread())
+			{
+				job.worlds.push_back(wrap);
+				#if B2_ENABLE_PARTICLE
+				job.particleIterations.push_back(wrap->m_world.CalculateReasonableParticleIterations(job.timeStep));
+				#else
+				job.particleIterations.push_back(0);
+				#endif
+			}
+			else
+			{
+				serial.push_back(wrap);
+			}
+		}
+		// this thread works through the list alongside the pool
+		uv_mutex_init(&job.mutex);
+		int32 worker_count = b2Min(thread_count, static_cast<int32>(job.worlds.size())) - 1;
+		StepPool().Run(StepWorldsThread, &job, worker_count);
+		uv_mutex_destroy(&job.mutex);
+		for (size_t i = 0; i < job.worlds.size(); ++i)
+		{
+			ReportExternalMemory(&job.worlds[i]->m_alloc_stats);
+		}
+		for (size_t i = 0; i < serial.size(); ++i)
+		{
+			WrapWorld* wrap = serial[i];
+			AllocScope alloc_scope(&wrap->m_alloc_stats);
+			#if B2_ENABLE_PARTICLE
+			int32 particleIterations = wrap->m_world.CalculateReasonableParticleIterations(job.timeStep);
+			#else
+			int32 particleIterations = 0;
+			#endif
+			wrap->StepWorld(job.timeStep, job.velocityIterations, job.positionIterations, particleIterations);
+		}
+	}
+	NANX_METHOD(SetInterpolationBodies)
+	{
+		WrapWorld* wrap = Unwrap(info.This());
+		Nan::TypedArrayContents<int32_t> ids(info[0]);
+		int32 count = (info.Length() > 1)?(b2Min(NANX_int32(info[1]), static_cast<int32>(ids.length()))):(static_cast<int32>(ids.length()));
+		wrap->m_interpolation.resize(b2Max(count, 0));
+		for (int32 i = 0; i < count; ++i)
+		{
+			wrap->m_interpolation[i].body_id = (*ids)[i];
+			wrap->m_interpolation[i].position.SetZero();
+			wrap->m_interpolation[i].angle = 0.0f;
+		}
+		// start from the current transforms
+		wrap->SaveInterpolation();
+	}
+	NANX_METHOD(Advance)
 	{
 		WrapWorld* wrap = Unwrap(info.This());
-		float32 timeStep = NANX_float32(info[0]);
-		int32 velocityIterations = NANX_int32(info[1]);
-		int32 positionIterations = NANX_int32(info[2]);
+		float32 realDt = NANX_float32(info[0]);
+		float32 fixedDt = NANX_float32(info[1]);
+		int32 maxSubsteps = NANX_int32(info[2]);
+		Nan::TypedArrayContents<float32> out(info[3]);
+		int32 velocityIterations = (info.Length() > 4)?(NANX_int32(info[4])):(8);
+		int32 positionIterations = (info.Length() > 5)?(NANX_int32(info[5])):(3);
+		if (!(fixedDt > 0.0f))
+		{
+			return Nan::ThrowRangeError("fixedDt must be positive");
+		}
 		#if B2_ENABLE_PARTICLE
-		int32 particleIterations = (info.Length() > 3)?(NANX_int32(info[3])):(wrap->m_world.CalculateReasonableParticleIterations(timeStep));
-		wrap->m_world.Step(timeStep, velocityIterations, positionIterations, particleIterations);
+		int32 particleIterations = wrap->m_world.CalculateReasonableParticleIterations(fixedDt);
 		#else
-		wrap->m_world.Step(timeStep, velocityIterations, positionIterations);
+		int32 particleIterations = 0;
 		#endif
+		wrap->ResetCallbackStats();
+		AllocScope alloc_scope(&wrap->m_alloc_stats);
+		// run the whole substeps that fit into the accumulated time
+		wrap->m_accumulator += realDt;
+		int32 substeps = 0;
+		while ((wrap->m_accumulator >= fixedDt) && (substeps < maxSubsteps))
+		{
+			wrap->SaveInterpolation();
+			wrap->StepWorld(fixedDt, velocityIterations, positionIterations, particleIterations);
+			wrap->m_accumulator -= fixedDt;
+			++substeps;
+		}
+		// drop time we could not catch up on
+		if (wrap->m_accumulator >= fixedDt)
+		{
+			wrap->m_accumulator = fmodf(wrap->m_accumulator, fixedDt);
+		}
+		// blend previous and current transforms: x, y, angle per registered body
+		float32 alpha = wrap->m_accumulator / fixedDt;
+		size_t count = b2Min(wrap->m_interpolation.size(), out.length() / 3);
+		for (size_t i = 0; i < count; ++i)
+		{
+			const Interpolation& state = wrap->m_interpolation[i];
+			b2Body* body = wrap->GetBodyById(state.body_id);
+			if (!body)
+			{
+				// destroyed bodies read as NaN
+				(*out)[3 * i + 0] = (*out)[3 * i + 1] = (*out)[3 * i + 2] = std::numeric_limits<float32>::quiet_NaN();
+				continue;
+			}
+			b2Vec2 position = (1.0f - alpha) * state.position + alpha * body->GetPosition();
+			// take the short way around
+			float32 delta = body->GetAngle() - state.angle;
+			delta -= 2.0f * b2_pi * floorf((delta + b2_pi) / (2.0f * b2_pi));
+			(*out)[3 * i + 0] = position.x;
+			(*out)[3 * i + 1] = position.y;
+			(*out)[3 * i + 2] = state.angle + alpha * delta;
+		}
+		info.GetReturnValue().Set(Nan::New(substeps));
 	}
 	NANX_METHOD(ClearForces)
 	{
 		WrapWorld* wrap = Unwrap(info.This());
-		wrap->m_world.ClearForces();
+		if (wrap->m_recorder.IsRecording())
+		{
+			wrap->m_recorder.Op(e_recordClearForces);
+		}
+		wrap->ClearForces();
 	}
 	NANX_METHOD(DrawDebugData)
 	{
@@ -8111,7 +13724,7 @@ private:
 		WrapWorld* wrap = Unwrap(info.This());
 		v8::Local<v8::Function> callback = v8::Local<v8::Function>::Cast(info[0]);
 		WrapAABB* wrap_mass_data = WrapAABB::Unwrap(v8::Local<v8::Object>::Cast(info[1]));
-		WrapQueryCallback wrap_callback(callback);
+		WrapQueryCallback wrap_callback(wrap, callback);
 		wrap->m_world.QueryAABB(&wrap_callback, wrap_mass_data->GetAABB());
 	}
 	#if B2_ENABLE_PARTICLE
@@ -8121,7 +13734,7 @@ private:
 		v8::Local<v8::Function> callback = v8::Local<v8::Function>::Cast(info[0]);
 		WrapShape* wrap_shape = WrapShape::Unwrap(v8::Local<v8::Object>::Cast(info[1]));
 	    WrapTransform* wrap_transform = WrapTransform::Unwrap(v8::Local<v8::Object>::Cast(info[2]));
-		WrapQueryCallback wrap_callback(callback);
+		WrapQueryCallback wrap_callback(wrap, callback);
 		wrap->m_world.QueryShapeAABB(&wrap_callback, wrap_shape->GetShape(), wrap_transform->GetTransform());
 	}
 	#endif
@@ -8131,7 +13744,7 @@ private:
 		v8::Local<v8::Function> callback = v8::Local<v8::Function>::Cast(info[0]);
 		WrapVec2* point1 = WrapVec2::Unwrap(v8::Local<v8::Object>::Cast(info[1]));
 		WrapVec2* point2 = WrapVec2::Unwrap(v8::Local<v8::Object>::Cast(info[2]));
-		WrapRayCastCallback wrap_callback(callback);
+		WrapRayCastCallback wrap_callback(wrap, callback);
 		wrap->m_world.RayCast(&wrap_callback, point1->GetVec2(), point2->GetVec2());
 	}
 	NANX_METHOD(GetBodyList)
@@ -8152,7 +13765,7 @@ private:
 	NANX_METHOD(GetJointList)
 	{
 		WrapWorld* wrap = Unwrap(info.This());
-		b2Joint* joint = wrap->m_world.GetJointList();
+		b2Joint* joint = WrapJoint::SkipUnwrapped(wrap->m_world.GetJointList());
 		if (joint)
 		{
 			// get joint internal data
@@ -8180,7 +13793,12 @@ private:
 	NANX_METHOD(SetAllowSleeping)
 	{
 		WrapWorld* wrap = Unwrap(info.This());
-		wrap->m_world.SetAllowSleeping(NANX_bool(info[0]));
+		bool flag = NANX_bool(info[0]);
+		if (wrap->m_recorder.IsRecording())
+		{
+			wrap->m_recorder.Op(e_recordSetWorldFlag).Uint8(e_recordAllowSleeping).Bool(flag);
+		}
+		wrap->m_world.SetAllowSleeping(flag);
 	}
 	NANX_METHOD(GetAllowSleeping)
 	{
@@ -8190,7 +13808,12 @@ private:
 	NANX_METHOD(SetWarmStarting)
 	{
 		WrapWorld* wrap = Unwrap(info.This());
-		wrap->m_world.SetWarmStarting(NANX_bool(info[0]));
+		bool flag = NANX_bool(info[0]);
+		if (wrap->m_recorder.IsRecording())
+		{
+			wrap->m_recorder.Op(e_recordSetWorldFlag).Uint8(e_recordWarmStarting).Bool(flag);
+		}
+		wrap->m_world.SetWarmStarting(flag);
 	}
 	NANX_METHOD(GetWarmStarting)
 	{
@@ -8200,7 +13823,12 @@ private:
 	NANX_METHOD(SetContinuousPhysics)
 	{
 		WrapWorld* wrap = Unwrap(info.This());
-		wrap->m_world.SetContinuousPhysics(NANX_bool(info[0]));
+		bool flag = NANX_bool(info[0]);
+		if (wrap->m_recorder.IsRecording())
+		{
+			wrap->m_recorder.Op(e_recordSetWorldFlag).Uint8(e_recordContinuousPhysics).Bool(flag);
+		}
+		wrap->m_world.SetContinuousPhysics(flag);
 	}
 	NANX_METHOD(GetContinuousPhysics)
 	{
@@ -8210,14 +13838,23 @@ private:
 	NANX_METHOD(SetSubStepping)
 	{
 		WrapWorld* wrap = Unwrap(info.This());
-		wrap->m_world.SetSubStepping(NANX_bool(info[0]));
+		bool flag = NANX_bool(info[0]);
+		if (wrap->m_recorder.IsRecording())
+		{
+			wrap->m_recorder.Op(e_recordSetWorldFlag).Uint8(e_recordSubStepping).Bool(flag);
+		}
+		wrap->m_world.SetSubStepping(flag);
 	}
 	NANX_METHOD(GetSubStepping)
 	{
 		WrapWorld* wrap = Unwrap(info.This());
 		info.GetReturnValue().Set(Nan::New(wrap->m_world.GetSubStepping()));
 	}
-//	int32 GetProxyCount() const;
+	NANX_METHOD(GetProxyCount)
+	{
+		WrapWorld* wrap = Unwrap(info.This());
+		info.GetReturnValue().Set(Nan::New(wrap->m_world.GetProxyCount()));
+	}
 	NANX_METHOD(GetBodyCount)
 	{
 		WrapWorld* wrap = Unwrap(info.This());
@@ -8233,13 +13870,29 @@ private:
 		WrapWorld* wrap = Unwrap(info.This());
 		info.GetReturnValue().Set(Nan::New(wrap->m_world.GetContactCount()));
 	}
-//	int32 GetTreeHeight() const;
-//	int32 GetTreeBalance() const;
-//	float32 GetTreeQuality() const;
+	NANX_METHOD(GetTreeHeight)
+	{
+		WrapWorld* wrap = Unwrap(info.This());
+		info.GetReturnValue().Set(Nan::New(wrap->m_world.GetTreeHeight()));
+	}
+	NANX_METHOD(GetTreeBalance)
+	{
+		WrapWorld* wrap = Unwrap(info.This());
+		info.GetReturnValue().Set(Nan::New(wrap->m_world.GetTreeBalance()));
+	}
+	NANX_METHOD(GetTreeQuality)
+	{
+		WrapWorld* wrap = Unwrap(info.This());
+		info.GetReturnValue().Set(Nan::New(wrap->m_world.GetTreeQuality()));
+	}
 	NANX_METHOD(SetGravity)
 	{
 		WrapWorld* wrap = Unwrap(info.This());
 		WrapVec2* wrap_gravity = WrapVec2::Unwrap(v8::Local<v8::Object>::Cast(info[0]));
+		if (wrap->m_recorder.IsRecording())
+		{
+			wrap->m_recorder.Op(e_recordSetGravity).Vec2(wrap_gravity->GetVec2());
+		}
 		wrap->m_world.SetGravity(wrap_gravity->GetVec2());
 	}
 	NANX_METHOD(GetGravity)
@@ -8255,7 +13908,12 @@ private:
 	NANX_METHOD(SetAutoClearForces)
 	{
 		WrapWorld* wrap = Unwrap(info.This());
-		wrap->m_world.SetAutoClearForces(NANX_bool(info[0]));
+		bool flag = NANX_bool(info[0]);
+		if (wrap->m_recorder.IsRecording())
+		{
+			wrap->m_recorder.Op(e_recordSetWorldFlag).Uint8(e_recordAutoClearForces).Bool(flag);
+		}
+		wrap->m_world.SetAutoClearForces(flag);
 	}
 	NANX_METHOD(GetAutoClearForces)
 	{
@@ -8264,18 +13922,429 @@ private:
 	}
 //	void ShiftOrigin(const b2Vec2& newOrigin);
 ///	const b2ContactManager& GetContactManager() const;
-///	const b2Profile& GetProfile() const;
+	NANX_METHOD(SetProfileWindow)
+	{
+		WrapWorld* wrap = Unwrap(info.This());
+		wrap->m_profile_window = b2Max(NANX_int32(info[0]), 0);
+		wrap->m_profile_history.clear();
+		wrap->m_profile_next = 0;
+		wrap->m_profile_count = 0;
+	}
+	NANX_METHOD(GetProfile)
+	{
+		// out: [0,8) last step, [8,16) min, [16,24) avg, [24,32) max over the profile window;
+		// each block is step, collide, solve, solveInit, solveVelocity, solvePosition, broadphase, solveTOI (ms)
+		WrapWorld* wrap = Unwrap(info.This());
+		v8::Local<v8::Value> h_out = info[0];
+		if (h_out->IsUndefined())
+		{
+			h_out = v8::Float64Array::New(v8::ArrayBuffer::New(v8::Isolate::GetCurrent(), 32 * sizeof(double)), 0, 32);
+		}
+		Nan::TypedArrayContents<double> out(h_out);
+		const size_t field_count = 8;
+		#define PROFILE_FIELDS(PROFILE) { (PROFILE).step, (PROFILE).collide, (PROFILE).solve, (PROFILE).solveInit, (PROFILE).solveVelocity, (PROFILE).solvePosition, (PROFILE).broadphase, (PROFILE).solveTOI }
+		const b2Profile& profile = wrap->m_world.GetProfile();
+		double current[field_count] = PROFILE_FIELDS(profile);
+		double lo[field_count], sum[field_count], hi[field_count];
+		for (size_t j = 0; j < field_count; ++j)
+		{
+			lo[j] = (wrap->m_profile_count > 0)?(b2_maxFloat):(0.0);
+			sum[j] = hi[j] = 0.0;
+		}
+		for (int32 i = 0; i < wrap->m_profile_count; ++i)
+		{
+			const b2Profile& sample = wrap->m_profile_history[i];
+			double fields[field_count] = PROFILE_FIELDS(sample);
+			for (size_t j = 0; j < field_count; ++j)
+			{
+				lo[j] = b2Min(lo[j], fields[j]);
+				sum[j] += fields[j];
+				hi[j] = b2Max(hi[j], fields[j]);
+			}
+		}
+		#undef PROFILE_FIELDS
+		for (size_t j = 0; j < field_count; ++j)
+		{
+			if (out.length() > j) { (*out)[j] = current[j]; }
+			if (out.length() > field_count * 1 + j) { (*out)[field_count * 1 + j] = lo[j]; }
+			if (out.length() > field_count * 2 + j) { (*out)[field_count * 2 + j] = (wrap->m_profile_count > 0)?(sum[j] / wrap->m_profile_count):(0.0); }
+			if (out.length() > field_count * 3 + j) { (*out)[field_count * 3 + j] = hi[j]; }
+		}
+		info.GetReturnValue().Set(h_out);
+	}
+	struct StateHash
+	{
+		// 64-bit FNV-1a over the raw bits, fed a byte at a time so byte order does not matter
+		uint64 value;
+		StateHash() : value(14695981039346656037ULL) {}
+		void Add(uint32 bits)
+		{
+			for (int32 i = 0; i < 4; ++i)
+			{
+				value ^= (bits >> (8 * i)) & 0xff;
+				value *= 1099511628211ULL;
+			}
+		}
+		void Add(float32 f) { uint32 bits; memcpy(&bits, &f, sizeof(bits)); Add(bits); }
+		void Add(const b2Vec2& v) { Add(v.x); Add(v.y); }
+	};
+	NANX_METHOD(ComputeStateHash)
+	{
+		// hash of every body's transform, velocity and sleep state (and particles), in world order;
+		// equal worlds stepped with equal inputs on a deterministic build hash equal
+		WrapWorld* wrap = Unwrap(info.This());
+		StateHash hash;
+		for (b2Body* body = wrap->m_world.GetBodyList(); body; body = body->GetNext())
+		{
+			hash.Add(body->GetPosition());
+			hash.Add(body->GetAngle());
+			hash.Add(body->GetLinearVelocity());
+			hash.Add(body->GetAngularVelocity());
+			hash.Add(static_cast<uint32>(body->IsAwake()?1:0));
+		}
+		#if B2_ENABLE_PARTICLE
+		for (b2ParticleSystem* system = wrap->m_world.GetParticleSystemList(); system; system = system->GetNext())
+		{
+			int32 count = system->GetParticleCount();
+			const b2Vec2* positions = system->GetPositionBuffer();
+			const b2Vec2* velocities = system->GetVelocityBuffer();
+			hash.Add(static_cast<uint32>(count));
+			for (int32 i = 0; i < count; ++i)
+			{
+				hash.Add(positions[i]);
+				hash.Add(velocities[i]);
+			}
+		}
+		#endif
+		// 16 hex digits; a javascript number cannot hold all 64 bits
+		char hex[17];
+		for (int32 i = 0; i < 16; ++i)
+		{
+			hex[i] = "0123456789abcdef"[(hash.value >> (60 - 4 * i)) & 0xf];
+		}
+		hex[16] = '\0';
+		info.GetReturnValue().Set(NANX_STRING(hex));
+	}
+	NANX_METHOD(StartRecording)
+	{
+		// logs every mutation made through the binding, and every step, until StopRecording
+		WrapWorld* wrap = Unwrap(info.This());
+		if (wrap->m_world.GetBodyCount() > 0)
+		{
+			return Nan::ThrowError("recording must start on an empty world");
+		}
+		wrap->m_recorder.Start(wrap->m_world.GetGravity());
+	}
+	NANX_METHOD(StopRecording)
+	{
+		// returns the log as a Buffer, or null when not recording
+		WrapWorld* wrap = Unwrap(info.This());
+		if (!wrap->m_recorder.IsRecording())
+		{
+			info.GetReturnValue().SetNull();
+			return;
+		}
+		std::vector<uint8> data;
+		wrap->m_recorder.Stop(data);
+		info.GetReturnValue().Set(Nan::CopyBuffer(reinterpret_cast<const char*>(data.data()), static_cast<uint32_t>(data.size())).ToLocalChecked());
+	}
+	NANX_METHOD(IsRecording)
+	{
+		WrapWorld* wrap = Unwrap(info.This());
+		info.GetReturnValue().Set(Nan::New(wrap->m_recorder.IsRecording()));
+	}
+	NANX_METHOD(Replay)
+	{
+		// b2World.Replay(log[, stepMs]) re-runs a log in a fresh native world, without javascript objects or callbacks;
+		// returns { steps, totalMs, maxStepMs, maxStepIndex } and fills stepMs (Float64Array) with each step's time
+		Nan::TypedArrayContents<uint8_t> log(info[0]);
+		RecordReader in(*log, log.length());
+		uint32 magic = in.Uint();
+		uint32 version = in.Uint();
+		uint32 pointer_size = in.Uint();
+		int32 major = in.Int();
+		int32 minor = in.Int();
+		int32 revision = in.Int();
+		b2Vec2 gravity = in.Vec2();
+		if (!in.IsOk() || (magic != g_record_magic))
+		{
+			return Nan::ThrowError("replay log is truncated or malformed");
+		}
+		if ((version != g_record_version) || (pointer_size != sizeof(void*)) ||
+			(major != b2_version.major) || (minor != b2_version.minor) || (revision != b2_version.revision))
+		{
+			return Nan::ThrowError("replay log was written by a different build");
+		}
+		WrapWorld* replay = new WrapWorld(gravity, 0);
+		std::vector<double> step_ms;
+		b2Timer timer;
+		bool ok;
+		{
+			AllocScope alloc_scope(&replay->m_alloc_stats);
+			ok = replay->ReplayLog(in, step_ms);
+		}
+		double total_ms = timer.GetMilliseconds();
+		delete replay;
+		if (!ok)
+		{
+			return Nan::ThrowError("replay log is truncated or malformed");
+		}
+		double max_ms = 0.0;
+		int32 max_index = -1;
+		for (size_t i = 0; i < step_ms.size(); ++i)
+		{
+			if (step_ms[i] > max_ms) { max_ms = step_ms[i]; max_index = static_cast<int32>(i); }
+		}
+		if (info[1]->IsFloat64Array())
+		{
+			Nan::TypedArrayContents<double> out(info[1]);
+			for (size_t i = 0; (i < step_ms.size()) && (i < out.length()); ++i)
+			{
+				(*out)[i] = step_ms[i];
+			}
+		}
+		v8::Local<v8::Object> h_result = Nan::New<v8::Object>();
+		Nan::Set(h_result, NANX_SYMBOL("steps"), Nan::New(static_cast<int32>(step_ms.size())));
+		Nan::Set(h_result, NANX_SYMBOL("totalMs"), Nan::New(total_ms));
+		Nan::Set(h_result, NANX_SYMBOL("maxStepMs"), Nan::New(max_ms));
+		Nan::Set(h_result, NANX_SYMBOL("maxStepIndex"), Nan::New(max_index));
+		info.GetReturnValue().Set(h_result);
+	}
+	NANX_METHOD(GetStats)
+	{
+		// out: bodyCount, jointCount, contactCount, proxyCount, treeHeight, treeBalance, treeQuality, awakeBodyCount
+		WrapWorld* wrap = Unwrap(info.This());
+		v8::Local<v8::Value> h_out = info[0];
+		if (h_out->IsUndefined())
+		{
+			h_out = v8::Float64Array::New(v8::ArrayBuffer::New(v8::Isolate::GetCurrent(), 8 * sizeof(double)), 0, 8);
+		}
+		Nan::TypedArrayContents<double> out(h_out);
+		int32 awake_count = 0;
+		for (b2Body* body = wrap->m_world.GetBodyList(); body; body = body->GetNext())
+		{
+			if (body->IsAwake() && (body->GetType() != b2_staticBody)) { ++awake_count; }
+		}
+		double stats[] =
+		{
+			static_cast<double>(wrap->m_world.GetBodyCount()),
+			static_cast<double>(wrap->m_world.GetJointCount()),
+			static_cast<double>(wrap->m_world.GetContactCount()),
+			static_cast<double>(wrap->m_world.GetProxyCount()),
+			static_cast<double>(wrap->m_world.GetTreeHeight()),
+			static_cast<double>(wrap->m_world.GetTreeBalance()),
+			static_cast<double>(wrap->m_world.GetTreeQuality()),
+			static_cast<double>(awake_count)
+		};
+		for (size_t i = 0; (i < countof(stats)) && (i < out.length()); ++i)
+		{
+			(*out)[i] = stats[i];
+		}
+		info.GetReturnValue().Set(h_out);
+	}
+	NANX_METHOD(SetCallbackStatsEnabled)
+	{
+		WrapWorld* wrap = Unwrap(info.This());
+		wrap->m_callback_stats_enabled = NANX_bool(info[0]);
+		wrap->ResetCallbackStats();
+	}
+	NANX_METHOD(GetCallbackStats)
+	{
+		// counts and milliseconds spent in javascript since the start of the last step
+		WrapWorld* wrap = Unwrap(info.This());
+		static const char* names[e_callbackCount] = { "SayGoodbye", "ShouldCollide", "BeginContact", "EndContact", "PreSolve", "PostSolve", "Draw", "Query", "RayCast" };
+		v8::Local<v8::Object> out = info[0]->IsObject() ? v8::Local<v8::Object>::Cast(info[0]) : Nan::New<v8::Object>();
+		for (int32 i = 0; i < e_callbackCount; ++i)
+		{
+			v8::Local<v8::Object> h_stat = Nan::New<v8::Object>();
+			Nan::Set(h_stat, NANX_SYMBOL("count"), Nan::New(wrap->m_callback_stats[i].count));
+			Nan::Set(h_stat, NANX_SYMBOL("ms"), Nan::New(wrap->m_callback_stats[i].ms));
+			Nan::Set(out, NANX_SYMBOL(names[i]), h_stat);
+		}
+		info.GetReturnValue().Set(out);
+	}
+	NANX_METHOD(GetMemoryStats)
+	{
+		// block usage is counted from the live box2d objects; allocated and reserved bytes come from b2Alloc
+		WrapWorld* wrap = Unwrap(info.This());
+		double blocks[countof(g_block_sizes)] = { 0.0 };
+		double large_bytes = 0.0; // objects too big for the block allocator
+		int32 body_wrappers = 0, fixture_wrappers = 0, joint_wrappers = 0, particle_system_wrappers = 0;
+		int32 persistents = 1; // the world handle
+		persistents += (wrap->m_destruction_listener.IsEmpty()?0:1) + (wrap->m_contact_filter.IsEmpty()?0:1) + (wrap->m_contact_listener.IsEmpty()?0:1) + (wrap->m_draw.IsEmpty()?0:1);
+		persistents += wrap->m_contact_filter_method.IsEmpty()?0:1;
+		for (int32 i = 0; i < e_contactListenerMethodCount; ++i)
+		{
+			persistents += wrap->m_contact_listener_methods[i].IsEmpty()?0:1;
+		}
+		int32 fixture_count = 0;
+		double fixture_bytes = 0.0;
+		for (b2Body* body = wrap->m_world.GetBodyList(); body; body = body->GetNext())
+		{
+			AddBlocks(blocks, large_bytes, sizeof(b2Body), 1);
+			WrapBody* wrap_body = WrapBody::GetWrap(body);
+			if (wrap_body) { ++body_wrappers; persistents += wrap_body->GetPersistentCount(); }
+			for (b2Fixture* fixture = body->GetFixtureList(); fixture; fixture = fixture->GetNext())
+			{
+				const b2Shape* shape = fixture->GetShape();
+				int32 proxy_size = shape->GetChildCount() * static_cast<int32>(sizeof(b2FixtureProxy));
+				++fixture_count;
+				fixture_bytes += sizeof(b2Fixture) + GetShapeSize(shape) + proxy_size;
+				AddBlocks(blocks, large_bytes, sizeof(b2Fixture), 1);
+				AddBlocks(blocks, large_bytes, GetShapeSize(shape), 1);
+				AddBlocks(blocks, large_bytes, proxy_size, 1);
+				if (shape->GetType() == b2Shape::e_chain)
+				{
+					// chain vertices come straight from b2Alloc
+					double vertex_bytes = static_cast<double>(static_cast<const b2ChainShape*>(shape)->m_count * sizeof(b2Vec2));
+					large_bytes += vertex_bytes;
+					fixture_bytes += vertex_bytes;
+				}
+				WrapFixture* wrap_fixture = WrapFixture::GetWrap(fixture);
+				if (wrap_fixture) { ++fixture_wrappers; persistents += wrap_fixture->GetPersistentCount(); }
+			}
+		}
+		double joint_bytes = 0.0;
+		for (b2Joint* joint = wrap->m_world.GetJointList(); joint; joint = joint->GetNext())
+		{
+			joint_bytes += GetJointSize(joint);
+			AddBlocks(blocks, large_bytes, GetJointSize(joint), 1);
+			WrapJoint* wrap_joint = WrapJoint::GetWrap(joint);
+			if (wrap_joint) { ++joint_wrappers; persistents += wrap_joint->GetPersistentCount(); }
+		}
+		int32 contact_count = wrap->m_world.GetContactCount();
+		AddBlocks(blocks, large_bytes, sizeof(b2Contact), contact_count); // contact subclasses add no members
+		v8::Local<v8::Object> h_stats = Nan::New<v8::Object>();
+		#if NODE_BOX2D_TRACK_ALLOC
+		Nan::Set(h_stats, NANX_SYMBOL("allocatedBytes"), Nan::New<v8::Number>(static_cast<double>(wrap->m_alloc_stats.bytes)));
+		Nan::Set(h_stats, NANX_SYMBOL("peakAllocatedBytes"), Nan::New<v8::Number>(static_cast<double>(wrap->m_alloc_stats.peak)));
+		Nan::Set(h_stats, NANX_SYMBOL("allocationCount"), Nan::New(wrap->m_alloc_stats.count));
+		double particle_allocated_bytes = 0.0;
+		for (std::list<AllocStats>::const_iterator it = wrap->m_particle_alloc_stats.begin(); it != wrap->m_particle_alloc_stats.end(); ++it)
+		{
+			particle_allocated_bytes += static_cast<double>(it->bytes);
+		}
+		Nan::Set(h_stats, NANX_SYMBOL("particleAllocatedBytes"), Nan::New<v8::Number>(particle_allocated_bytes));
+		#endif
+		Nan::Set(h_stats, NANX_SYMBOL("worldBytes"), Nan::New<v8::Number>(sizeof(WrapWorld))); // includes the b2StackAllocator buffer
+		if (wrap->m_arena.IsEnabled())
+		{
+			v8::Local<v8::Object> h_arena = Nan::New<v8::Object>();
+			Nan::Set(h_arena, NANX_SYMBOL("reservedBytes"), Nan::New<v8::Number>(static_cast<double>(wrap->m_arena.GetReservedBytes())));
+			Nan::Set(h_arena, NANX_SYMBOL("usedBytes"), Nan::New<v8::Number>(static_cast<double>(wrap->m_arena.GetUsedBytes())));
+			Nan::Set(h_stats, NANX_SYMBOL("arena"), h_arena);
+		}
+		// block allocator
+		v8::Local<v8::Object> h_block = Nan::New<v8::Object>();
+		v8::Local<v8::Array> h_classes = Nan::New<v8::Array>(static_cast<int>(countof(g_block_sizes)));
+		double used_bytes = 0.0;
+		for (size_t i = 0; i < countof(g_block_sizes); ++i)
+		{
+			v8::Local<v8::Object> h_class = Nan::New<v8::Object>();
+			Nan::Set(h_class, NANX_SYMBOL("size"), Nan::New(g_block_sizes[i]));
+			Nan::Set(h_class, NANX_SYMBOL("blocks"), Nan::New<v8::Number>(blocks[i]));
+			Nan::Set(h_class, NANX_SYMBOL("bytes"), Nan::New<v8::Number>(blocks[i] * g_block_sizes[i]));
+			h_classes->Set(static_cast<uint32_t>(i), h_class);
+			used_bytes += blocks[i] * g_block_sizes[i];
+		}
+		Nan::Set(h_block, NANX_SYMBOL("usedBytes"), Nan::New<v8::Number>(used_bytes));
+		#if NODE_BOX2D_TRACK_ALLOC
+		Nan::Set(h_block, NANX_SYMBOL("reservedBytes"), Nan::New<v8::Number>(static_cast<double>(wrap->m_alloc_stats.chunks) * b2_chunkSize));
+		#endif
+		Nan::Set(h_block, NANX_SYMBOL("largeBytes"), Nan::New<v8::Number>(large_bytes));
+		Nan::Set(h_block, NANX_SYMBOL("sizeClasses"), h_classes);
+		Nan::Set(h_stats, NANX_SYMBOL("blockAllocator"), h_block);
+		// stack allocator; the high water mark is private to b2World
+		v8::Local<v8::Object> h_stack = Nan::New<v8::Object>();
+		Nan::Set(h_stack, NANX_SYMBOL("size"), Nan::New(b2_stackSize));
+		Nan::Set(h_stats, NANX_SYMBOL("stackAllocator"), h_stack);
+		// broad-phase: 2n - 1 tree nodes in a buffer that starts at 16 and doubles, never shrinking
+		int32 proxy_count = wrap->m_world.GetProxyCount();
+		int32 node_capacity = 16;
+		while (node_capacity < 2 * proxy_count - 1) { node_capacity *= 2; }
+		v8::Local<v8::Object> h_tree = Nan::New<v8::Object>();
+		Nan::Set(h_tree, NANX_SYMBOL("proxyCount"), Nan::New(proxy_count));
+		Nan::Set(h_tree, NANX_SYMBOL("treeHeight"), Nan::New(wrap->m_world.GetTreeHeight()));
+		Nan::Set(h_tree, NANX_SYMBOL("nodeCapacity"), Nan::New(node_capacity));
+		Nan::Set(h_tree, NANX_SYMBOL("bytes"), Nan::New<v8::Number>(static_cast<double>(node_capacity) * sizeof(b2TreeNode)));
+		Nan::Set(h_stats, NANX_SYMBOL("broadPhase"), h_tree);
+		// objects
+		v8::Local<v8::Object> h_bodies = Nan::New<v8::Object>();
+		Nan::Set(h_bodies, NANX_SYMBOL("count"), Nan::New(wrap->m_world.GetBodyCount()));
+		Nan::Set(h_bodies, NANX_SYMBOL("bytes"), Nan::New<v8::Number>(static_cast<double>(wrap->m_world.GetBodyCount()) * sizeof(b2Body)));
+		Nan::Set(h_stats, NANX_SYMBOL("bodies"), h_bodies);
+		v8::Local<v8::Object> h_fixtures = Nan::New<v8::Object>();
+		Nan::Set(h_fixtures, NANX_SYMBOL("count"), Nan::New(fixture_count));
+		Nan::Set(h_fixtures, NANX_SYMBOL("bytes"), Nan::New<v8::Number>(fixture_bytes));
+		Nan::Set(h_stats, NANX_SYMBOL("fixtures"), h_fixtures);
+		v8::Local<v8::Object> h_contacts = Nan::New<v8::Object>();
+		Nan::Set(h_contacts, NANX_SYMBOL("count"), Nan::New(contact_count));
+		Nan::Set(h_contacts, NANX_SYMBOL("size"), Nan::New<v8::Number>(sizeof(b2Contact)));
+		Nan::Set(h_contacts, NANX_SYMBOL("bytes"), Nan::New<v8::Number>(static_cast<double>(contact_count) * sizeof(b2Contact)));
+		Nan::Set(h_stats, NANX_SYMBOL("contacts"), h_contacts);
+		v8::Local<v8::Object> h_joints = Nan::New<v8::Object>();
+		Nan::Set(h_joints, NANX_SYMBOL("count"), Nan::New(wrap->m_world.GetJointCount()));
+		Nan::Set(h_joints, NANX_SYMBOL("bytes"), Nan::New<v8::Number>(joint_bytes));
+		Nan::Set(h_stats, NANX_SYMBOL("joints"), h_joints);
+		// particle systems
+		v8::Local<v8::Array> h_systems = Nan::New<v8::Array>();
+		#if B2_ENABLE_PARTICLE
+		uint32_t system_index = 0;
+		for (b2ParticleSystem* system = wrap->m_world.GetParticleSystemList(); system; system = system->GetNext())
+		{
+			++particle_system_wrappers;
+			++persistents;
+			// particle buffers start at 256 and double, capped by the max particle count
+			int32 particle_count = system->GetParticleCount();
+			int32 capacity = 0;
+			if (particle_count > 0)
+			{
+				capacity = 256;
+				while (capacity < particle_count) { capacity *= 2; }
+				if (system->GetMaxParticleCount() > 0) { capacity = b2Min(capacity, system->GetMaxParticleCount()); }
+			}
+			// flags, position, velocity, weight, group and proxy buffers
+			int32 particle_size = sizeof(uint32) + 2 * sizeof(b2Vec2) + sizeof(float32) + sizeof(b2ParticleGroup*) + 2 * sizeof(int32);
+			double contact_bytes =
+				static_cast<double>(system->GetContactCount()) * sizeof(b2ParticleContact) +
+				static_cast<double>(system->GetBodyContactCount()) * sizeof(b2ParticleBodyContact) +
+				static_cast<double>(system->GetPairCount()) * sizeof(b2ParticlePair) +
+				static_cast<double>(system->GetTriadCount()) * sizeof(b2ParticleTriad);
+			v8::Local<v8::Object> h_system = Nan::New<v8::Object>();
+			Nan::Set(h_system, NANX_SYMBOL("particleCount"), Nan::New(particle_count));
+			Nan::Set(h_system, NANX_SYMBOL("maxParticleCount"), Nan::New(system->GetMaxParticleCount()));
+			Nan::Set(h_system, NANX_SYMBOL("capacity"), Nan::New(capacity));
+			Nan::Set(h_system, NANX_SYMBOL("bufferBytes"), Nan::New<v8::Number>(static_cast<double>(capacity) * particle_size));
+			Nan::Set(h_system, NANX_SYMBOL("groupCount"), Nan::New(system->GetParticleGroupCount()));
+			Nan::Set(h_system, NANX_SYMBOL("contactBytes"), Nan::New<v8::Number>(contact_bytes));
+			h_systems->Set(system_index++, h_system);
+		}
+		#endif
+		Nan::Set(h_stats, NANX_SYMBOL("particleSystems"), h_systems);
+		// javascript side
+		v8::Local<v8::Object> h_wrappers = Nan::New<v8::Object>();
+		Nan::Set(h_wrappers, NANX_SYMBOL("bodies"), Nan::New(body_wrappers));
+		Nan::Set(h_wrappers, NANX_SYMBOL("fixtures"), Nan::New(fixture_wrappers));
+		Nan::Set(h_wrappers, NANX_SYMBOL("joints"), Nan::New(joint_wrappers));
+		Nan::Set(h_wrappers, NANX_SYMBOL("particleSystems"), Nan::New(particle_system_wrappers));
+		Nan::Set(h_stats, NANX_SYMBOL("wrappers"), h_wrappers);
+		Nan::Set(h_stats, NANX_SYMBOL("persistentHandles"), Nan::New(persistents));
+		info.GetReturnValue().Set(h_stats);
+	}
 ///	void Dump();
 	#if B2_ENABLE_PARTICLE
 	NANX_METHOD(CreateParticleSystem)
 	{
 		WrapWorld* wrap = Unwrap(info.This());
 		WrapParticleSystemDef* wrap_psd = WrapParticleSystemDef::Unwrap(v8::Local<v8::Object>::Cast(info[0]));
-		// create box2d particle system
-		b2ParticleSystem* system = wrap->m_world.CreateParticleSystem(&wrap_psd->UseParticleSystemDef());
-		// create javascript particle system object
+		// create javascript particle system object first so the system is charged to it
 		v8::Local<v8::Object> h_particle_system = WrapParticleSystem::NewInstance();
 		WrapParticleSystem* wrap_particle_system = WrapParticleSystem::Unwrap(h_particle_system);
+		wrap->m_particle_alloc_stats.push_back(AllocStats(wrap->m_alloc_stats.arena));
+		wrap_particle_system->SetAllocStats(&wrap->m_particle_alloc_stats.back());
+		AllocScope alloc_scope(wrap_particle_system->GetAllocStats());
+		// create box2d particle system
+		b2ParticleSystem* system = wrap->m_world.CreateParticleSystem(&wrap_psd->UseParticleSystemDef());
 		// set up javascript particle system object
 		wrap_particle_system->SetupObject(info.This(), wrap_psd, system);
 		info.GetReturnValue().Set(h_particle_system);
@@ -8285,6 +14354,7 @@ private:
 		WrapWorld* wrap = Unwrap(info.This());
 		v8::Local<v8::Object> h_particle_system = v8::Local<v8::Object>::Cast(info[0]);
 		WrapParticleSystem* wrap_particle_system = WrapParticleSystem::Unwrap(h_particle_system);
+		AllocScope alloc_scope(wrap_particle_system->GetAllocStats());
 		// delete box2d particle system
 		wrap->m_world.DestroyParticleSystem(wrap_particle_system->GetParticleSystem());
 		// reset javascript system object
@@ -8301,14 +14371,16 @@ private:
 
 void WrapWorld::WrapDestructionListener::SayGoodbye(b2Joint* joint)
 {
-	if (!m_wrap_world->m_destruction_listener.IsEmpty())
+	m_wrap_world->RemoveJointId(joint);
+	// get joint internal data; natively created joints have none to report
+	WrapJoint* wrap_joint = WrapJoint::GetWrap(joint);
+	if (wrap_joint && !m_wrap_world->m_destruction_listener.IsEmpty())
 	{
 		v8::Local<v8::Object> h_that = Nan::New<v8::Object>(m_wrap_world->m_destruction_listener);
 		v8::Local<v8::Function> h_method = v8::Local<v8::Function>::Cast(h_that->Get(NANX_SYMBOL("SayGoodbyeJoint")));
-		// get joint internal data
-		WrapJoint* wrap_joint = WrapJoint::GetWrap(joint);
 		v8::Local<v8::Object> h_joint = wrap_joint->handle();
 		v8::Local<v8::Value> argv[] = { h_joint };
+		ScopedCallbackStat callback_stat(m_wrap_world, e_callbackSayGoodbye);
 		Nan::MakeCallback(h_that, h_method, countof(argv), argv);
 	}
 }
@@ -8323,6 +14395,7 @@ void WrapWorld::WrapDestructionListener::SayGoodbye(b2Fixture* fixture)
 		WrapFixture* wrap_fixture = WrapFixture::GetWrap(fixture);
 		v8::Local<v8::Object> h_fixture = wrap_fixture->handle();
 		v8::Local<v8::Value> argv[] = { h_fixture };
+		ScopedCallbackStat callback_stat(m_wrap_world, e_callbackSayGoodbye);
 		Nan::MakeCallback(h_that, h_method, countof(argv), argv);
 	}
 }
@@ -8339,6 +14412,7 @@ void WrapWorld::WrapDestructionListener::SayGoodbye(b2ParticleGroup* group)
 		WrapParticleGroup* wrap_group = WrapParticleGroup::GetWrap(group);
 		v8::Local<v8::Object> h_group = wrap_group->handle();
 		v8::Local<v8::Value> argv[] = { h_group };
+		ScopedCallbackStat callback_stat(m_wrap_world, e_callbackSayGoodbye);
 		Nan::MakeCallback(h_that, h_method, countof(argv), argv);
 	}
 }
@@ -8361,16 +14435,21 @@ void WrapWorld::WrapDestructionListener::SayGoodbye(b2ParticleSystem* particleSy
 
 bool WrapWorld::WrapContactFilter::ShouldCollide(b2Fixture* fixtureA, b2Fixture* fixtureB)
 {
-	if (!m_wrap_world->m_contact_filter.IsEmpty())
+	if (!m_wrap_world->m_contact_filter_method.IsEmpty())
 	{
 		v8::Local<v8::Object> h_that = Nan::New<v8::Object>(m_wrap_world->m_contact_filter);
-		v8::Local<v8::Function> h_method = v8::Local<v8::Function>::Cast(h_that->Get(NANX_SYMBOL("ShouldCollide")));
-		// get fixture internal data
+		v8::Local<v8::Function> h_method = Nan::New<v8::Function>(m_wrap_world->m_contact_filter_method);
+		// get fixture internal data; native fixtures (tile collision) have no object to pass
 		WrapFixture* wrap_fixtureA = WrapFixture::GetWrap(fixtureA);
 		WrapFixture* wrap_fixtureB = WrapFixture::GetWrap(fixtureB);
+		if (!wrap_fixtureA || !wrap_fixtureB)
+		{
+			return b2ContactFilter::ShouldCollide(fixtureA, fixtureB);
+		}
 		v8::Local<v8::Object> h_fixtureA = wrap_fixtureA->handle();
 		v8::Local<v8::Object> h_fixtureB = wrap_fixtureB->handle();
 		v8::Local<v8::Value> argv[] = { h_fixtureA, h_fixtureB };
+		ScopedCallbackStat callback_stat(m_wrap_world, e_callbackShouldCollide);
 		return NANX_bool(Nan::MakeCallback(h_that, h_method, countof(argv), argv));
 	}
 	return b2ContactFilter::ShouldCollide(fixtureA, fixtureB);
@@ -8382,12 +14461,11 @@ bool WrapWorld::WrapContactFilter::ShouldCollide(b2Fixture* fixture, b2ParticleS
 {
 	if (!m_wrap_world->m_contact_filter.IsEmpty())
 	{
-		v8::Local<v8::Object> h_that = Nan::New<v8::Object>(m_wrap_world->m_contact_filter);
-		v8::Local<v8::Function> h_method = v8::Local<v8::Function>::Cast(h_that->Get(NANX_SYMBOL("ShouldCollideFixtureParticle")));
-		// get fixture internal data
-		WrapFixture* wrap_fixture = WrapFixture::GetWrap(fixture);
-		v8::Local<v8::Object> h_fixture = wrap_fixture->handle();
-		// TODO: get particle system internal data
+		// TODO: get particle system internal data; no per-pair method lookup until then
+		///	v8::Local<v8::Object> h_that = Nan::New<v8::Object>(m_wrap_world->m_contact_filter);
+		///	v8::Local<v8::Function> h_method = v8::Local<v8::Function>::Cast(h_that->Get(NANX_SYMBOL("ShouldCollideFixtureParticle")));
+		///	WrapFixture* wrap_fixture = WrapFixture::GetWrap(fixture);
+		///	v8::Local<v8::Object> h_fixture = wrap_fixture->handle();
 		///	WrapParticleSystem* wrap_system = WrapParticleSystem::GetWrap(particleSystem);
 		///	v8::Local<v8::Object> h_system = wrap_system->handle();
 		///	v8::Local<v8::Value> argv[] = { h_fixture, h_system, Nan::New(particleIndex) };
@@ -8400,9 +14478,9 @@ bool WrapWorld::WrapContactFilter::ShouldCollide(b2ParticleSystem* particleSyste
 {
 	if (!m_wrap_world->m_contact_filter.IsEmpty())
 	{
-		v8::Local<v8::Object> h_that = Nan::New<v8::Object>(m_wrap_world->m_contact_filter);
-		v8::Local<v8::Function> h_method = v8::Local<v8::Function>::Cast(h_that->Get(NANX_SYMBOL("ShouldCollideParticleParticle")));
-		// TODO: get particle system internal data
+		// TODO: get particle system internal data; no per-pair method lookup until then
+		///	v8::Local<v8::Object> h_that = Nan::New<v8::Object>(m_wrap_world->m_contact_filter);
+		///	v8::Local<v8::Function> h_method = v8::Local<v8::Function>::Cast(h_that->Get(NANX_SYMBOL("ShouldCollideParticleParticle")));
 		///	WrapParticleSystem* wrap_system = WrapParticleSystem::GetWrap(particleSystem);
 		///	v8::Local<v8::Object> h_system = wrap_system->handle();
 		///	v8::Local<v8::Value> argv[] = { h_system, Nan::New(particleIndexA), Nan::New(particleIndexB) };
@@ -8415,24 +14493,26 @@ bool WrapWorld::WrapContactFilter::ShouldCollide(b2ParticleSystem* particleSyste
 
 void WrapWorld::WrapContactListener::BeginContact(b2Contact* contact)
 {
-	if (!m_wrap_world->m_contact_listener.IsEmpty())
+	if (!m_wrap_world->m_contact_listener_methods[e_beginContact].IsEmpty())
 	{
 		v8::Local<v8::Object> h_that = Nan::New<v8::Object>(m_wrap_world->m_contact_listener);
-		v8::Local<v8::Function> h_method = v8::Local<v8::Function>::Cast(h_that->Get(NANX_SYMBOL("BeginContact")));
+		v8::Local<v8::Function> h_method = Nan::New<v8::Function>(m_wrap_world->m_contact_listener_methods[e_beginContact]);
 		v8::Local<v8::Object> h_contact = WrapContact::NewInstance(contact);
 		v8::Local<v8::Value> argv[] = { h_contact };
+		ScopedCallbackStat callback_stat(m_wrap_world, e_callbackBeginContact);
 		Nan::MakeCallback(h_that, h_method, countof(argv), argv);
 	}
 }
 
 void WrapWorld::WrapContactListener::EndContact(b2Contact* contact)
 {
-	if (!m_wrap_world->m_contact_listener.IsEmpty())
+	if (!m_wrap_world->m_contact_listener_methods[e_endContact].IsEmpty())
 	{
 		v8::Local<v8::Object> h_that = Nan::New<v8::Object>(m_wrap_world->m_contact_listener);
-		v8::Local<v8::Function> h_method = v8::Local<v8::Function>::Cast(h_that->Get(NANX_SYMBOL("EndContact")));
+		v8::Local<v8::Function> h_method = Nan::New<v8::Function>(m_wrap_world->m_contact_listener_methods[e_endContact]);
 		v8::Local<v8::Object> h_contact = WrapContact::NewInstance(contact);
 		v8::Local<v8::Value> argv[] = { h_contact };
+		ScopedCallbackStat callback_stat(m_wrap_world, e_callbackEndContact);
 		Nan::MakeCallback(h_that, h_method, countof(argv), argv);
 	}
 }
@@ -8441,10 +14521,10 @@ void WrapWorld::WrapContactListener::EndContact(b2Contact* contact)
 
 void WrapWorld::WrapContactListener::BeginContact(b2ParticleSystem* particleSystem, b2ParticleBodyContact* particleBodyContact)
 {
-	if (!m_wrap_world->m_contact_listener.IsEmpty())
+	if (!m_wrap_world->m_contact_listener_methods[e_beginContactFixtureParticle].IsEmpty())
 	{
 		v8::Local<v8::Object> h_that = Nan::New<v8::Object>(m_wrap_world->m_contact_listener);
-		v8::Local<v8::Function> h_method = v8::Local<v8::Function>::Cast(h_that->Get(NANX_SYMBOL("BeginContactFixtureParticle")));
+		v8::Local<v8::Function> h_method = Nan::New<v8::Function>(m_wrap_world->m_contact_listener_methods[e_beginContactFixtureParticle]);
 		// TODO: get particle system internal data, wrap b2ParticleBodyContact
 		///	WrapParticleSystem* wrap_system = WrapParticleSystem::GetWrap(particleSystem);
 		///	v8::Local<v8::Value> argv[] = {};
@@ -8454,10 +14534,10 @@ void WrapWorld::WrapContactListener::BeginContact(b2ParticleSystem* particleSyst
 
 void WrapWorld::WrapContactListener::EndContact(b2Fixture* fixture, b2ParticleSystem* particleSystem, int32 index)
 {
-	if (!m_wrap_world->m_contact_listener.IsEmpty())
+	if (!m_wrap_world->m_contact_listener_methods[e_endContactFixtureParticle].IsEmpty())
 	{
 		v8::Local<v8::Object> h_that = Nan::New<v8::Object>(m_wrap_world->m_contact_listener);
-		v8::Local<v8::Function> h_method = v8::Local<v8::Function>::Cast(h_that->Get(NANX_SYMBOL("EndContactFixtureParticle")));
+		v8::Local<v8::Function> h_method = Nan::New<v8::Function>(m_wrap_world->m_contact_listener_methods[e_endContactFixtureParticle]);
 		// TODO: get particle system internal data
 		///	WrapParticleSystem* wrap_system = WrapParticleSystem::GetWrap(particleSystem);
 		///	v8::Local<v8::Value> argv[] = {};
@@ -8467,10 +14547,10 @@ void WrapWorld::WrapContactListener::EndContact(b2Fixture* fixture, b2ParticleSy
 
 void WrapWorld::WrapContactListener::BeginContact(b2ParticleSystem* particleSystem, b2ParticleContact* particleContact)
 {
-	if (!m_wrap_world->m_contact_listener.IsEmpty())
+	if (!m_wrap_world->m_contact_listener_methods[e_beginContactParticleParticle].IsEmpty())
 	{
 		v8::Local<v8::Object> h_that = Nan::New<v8::Object>(m_wrap_world->m_contact_listener);
-		v8::Local<v8::Function> h_method = v8::Local<v8::Function>::Cast(h_that->Get(NANX_SYMBOL("BeginContactParticleParticle")));
+		v8::Local<v8::Function> h_method = Nan::New<v8::Function>(m_wrap_world->m_contact_listener_methods[e_beginContactParticleParticle]);
 		// TODO: get particle system internal data, wrap b2ParticleContact
 		///	WrapParticleSystem* wrap_system = WrapParticleSystem::GetWrap(particleSystem);
 		///	v8::Local<v8::Value> argv[] = {};
@@ -8480,10 +14560,10 @@ void WrapWorld::WrapContactListener::BeginContact(b2ParticleSystem* particleSyst
 
 void WrapWorld::WrapContactListener::EndContact(b2ParticleSystem* particleSystem, int32 indexA, int32 indexB)
 {
-	if (!m_wrap_world->m_contact_listener.IsEmpty())
+	if (!m_wrap_world->m_contact_listener_methods[e_endContactParticleParticle].IsEmpty())
 	{
 		v8::Local<v8::Object> h_that = Nan::New<v8::Object>(m_wrap_world->m_contact_listener);
-		v8::Local<v8::Function> h_method = v8::Local<v8::Function>::Cast(h_that->Get(NANX_SYMBOL("EndContactParticleParticle")));
+		v8::Local<v8::Function> h_method = Nan::New<v8::Function>(m_wrap_world->m_contact_listener_methods[e_endContactParticleParticle]);
 		// TODO: get particle system internal data
 		///	WrapParticleSystem* wrap_system = WrapParticleSystem::GetWrap(particleSystem);
 		///	v8::Local<v8::Value> argv[] = {};
@@ -8495,26 +14575,28 @@ void WrapWorld::WrapContactListener::EndContact(b2ParticleSystem* particleSystem
 
 void WrapWorld::WrapContactListener::PreSolve(b2Contact* contact, const b2Manifold* oldManifold)
 {
-	if (!m_wrap_world->m_contact_listener.IsEmpty())
+	if (!m_wrap_world->m_contact_listener_methods[e_preSolve].IsEmpty())
 	{
 		v8::Local<v8::Object> h_that = Nan::New<v8::Object>(m_wrap_world->m_contact_listener);
-		v8::Local<v8::Function> h_method = v8::Local<v8::Function>::Cast(h_that->Get(NANX_SYMBOL("PreSolve")));
+		v8::Local<v8::Function> h_method = Nan::New<v8::Function>(m_wrap_world->m_contact_listener_methods[e_preSolve]);
 		v8::Local<v8::Object> h_contact = WrapContact::NewInstance(contact);
 		v8::Local<v8::Object> h_oldManifold = WrapManifold::NewInstance(*oldManifold);
 		v8::Local<v8::Value> argv[] = { h_contact, h_oldManifold };
+		ScopedCallbackStat callback_stat(m_wrap_world, e_callbackPreSolve);
 		Nan::MakeCallback(h_that, h_method, countof(argv), argv);
 	}
 }
 
 void WrapWorld::WrapContactListener::PostSolve(b2Contact* contact, const b2ContactImpulse* impulse)
 {
-	if (!m_wrap_world->m_contact_listener.IsEmpty())
+	if (!m_wrap_world->m_contact_listener_methods[e_postSolve].IsEmpty())
 	{
 		v8::Local<v8::Object> h_that = Nan::New<v8::Object>(m_wrap_world->m_contact_listener);
-		v8::Local<v8::Function> h_method = v8::Local<v8::Function>::Cast(h_that->Get(NANX_SYMBOL("PostSolve")));
+		v8::Local<v8::Function> h_method = Nan::New<v8::Function>(m_wrap_world->m_contact_listener_methods[e_postSolve]);
 		v8::Local<v8::Object> h_contact = WrapContact::NewInstance(contact);
 		v8::Local<v8::Object> h_impulse = WrapContactImpulse::NewInstance(*impulse);
 		v8::Local<v8::Value> argv[] = { h_contact, h_impulse };
+		ScopedCallbackStat callback_stat(m_wrap_world, e_callbackPostSolve);
 		Nan::MakeCallback(h_that, h_method, countof(argv), argv);
 	}
 }
@@ -8533,6 +14615,7 @@ void WrapWorld::WrapDraw::DrawPolygon(const b2Vec2* vertices, int32 vertexCount,
 		v8::Local<v8::Integer> h_vertexCount = Nan::New(vertexCount);
 		v8::Local<v8::Object> h_color = WrapColor::NewInstance(color);
 		v8::Local<v8::Value> argv[] = { h_vertices, h_vertexCount, h_color };
+		ScopedCallbackStat callback_stat(m_wrap_world, e_callbackDraw);
 		Nan::MakeCallback(h_that, h_method, countof(argv), argv);
 	}
 }
@@ -8551,6 +14634,7 @@ void WrapWorld::WrapDraw::DrawSolidPolygon(const b2Vec2* vertices, int32 vertexC
 		v8::Local<v8::Integer> h_vertexCount = Nan::New(vertexCount);
 		v8::Local<v8::Object> h_color = WrapColor::NewInstance(color);
 		v8::Local<v8::Value> argv[] = { h_vertices, h_vertexCount, h_color };
+		ScopedCallbackStat callback_stat(m_wrap_world, e_callbackDraw);
 		Nan::MakeCallback(h_that, h_method, countof(argv), argv);
 	}
 }
@@ -8568,6 +14652,7 @@ void WrapWorld::WrapDraw::DrawCircle(const b2Vec2& center, float32 radius, const
 		v8::Local<v8::Number> h_radius = Nan::New(radius);
 		v8::Local<v8::Object> h_color = WrapColor::NewInstance(color);
 		v8::Local<v8::Value> argv[] = { h_center, h_radius, h_color };
+		ScopedCallbackStat callback_stat(m_wrap_world, e_callbackDraw);
 		Nan::MakeCallback(h_that, h_method, countof(argv), argv);
 	}
 }
@@ -8586,6 +14671,7 @@ void WrapWorld::WrapDraw::DrawSolidCircle(const b2Vec2& center, float32 radius,
 		v8::Local<v8::Object> h_axis = WrapVec2::NewInstance(axis);
 		v8::Local<v8::Object> h_color = WrapColor::NewInstance(color);
 		v8::Local<v8::Value> argv[] = { h_center, h_radius, h_axis, h_color };
+		ScopedCallbackStat callback_stat(m_wrap_world, e_callbackDraw);
 		Nan::MakeCallback(h_that, h_method, countof(argv), argv);
 	}
 }
@@ -8615,11 +14701,13 @@ void WrapWorld::WrapDraw::DrawParticles(const b2Vec2 *centers, float32 radius, c
 				h_colors->Set(i, WrapParticleColor::NewInstance(colors[i]));
 			}
 			v8::Local<v8::Value> argv[] = { h_centers, h_radius, h_colors, h_count };
+			ScopedCallbackStat callback_stat(m_wrap_world, e_callbackDraw);
 			Nan::MakeCallback(h_that, h_method, countof(argv), argv);
 		}
 		else
 		{
 			v8::Local<v8::Value> argv[] = { h_centers, h_radius, Nan::Null(), h_count };
+			ScopedCallbackStat callback_stat(m_wrap_world, e_callbackDraw);
 			Nan::MakeCallback(h_that, h_method, countof(argv), argv);
 		}
 	}
@@ -8636,6 +14724,7 @@ void WrapWorld::WrapDraw::DrawSegment(const b2Vec2& p1, const b2Vec2& p2, const
 		v8::Local<v8::Object> h_p2 = WrapVec2::NewInstance(p2);
 		v8::Local<v8::Object> h_color = WrapColor::NewInstance(color);
 		v8::Local<v8::Value> argv[] = { h_p1, h_p2, h_color };
+		ScopedCallbackStat callback_stat(m_wrap_world, e_callbackDraw);
 		Nan::MakeCallback(h_that, h_method, countof(argv), argv);
 	}
 }
@@ -8648,6 +14737,7 @@ void WrapWorld::WrapDraw::DrawTransform(const b2Transform& xf)
 		v8::Local<v8::Function> h_method = v8::Local<v8::Function>::Cast(h_that->Get(NANX_SYMBOL("DrawTransform")));
 		v8::Local<v8::Object> h_xf = WrapTransform::NewInstance(xf);
 		v8::Local<v8::Value> argv[] = { h_xf };
+		ScopedCallbackStat callback_stat(m_wrap_world, e_callbackDraw);
 		Nan::MakeCallback(h_that, h_method, countof(argv), argv);
 	}
 }
@@ -8775,10 +14865,241 @@ NANX_EXPORT(b2CalculateParticleIterations)
 
 #endif
 
+class LoadSceneWorker : public Nan::AsyncWorker
+{
+private:
+	std::string m_json;
+	Scene m_scene;
+public:
+	LoadSceneWorker(Nan::Callback* callback, v8::Local<v8::Object> h_world, const char* json, size_t size) :
+		Nan::AsyncWorker(callback),
+		m_json(json, size)
+	{
+		SaveToPersistent("world", h_world);
+	}
+	virtual void Execute()
+	{
+		// thread pool: parse only, no v8 or world access
+		if (!ReadScene(m_json.data(), m_json.size(), m_scene))
+		{
+			SetErrorMessage(m_scene.error.c_str());
+		}
+		std::string().swap(m_json);
+	}
+	virtual void HandleOKCallback()
+	{
+		Nan::HandleScope scope;
+		v8::Local<v8::Object> h_world = v8::Local<v8::Object>::Cast(GetFromPersistent("world"));
+		WrapWorld* wrap = WrapWorld::Unwrap(h_world);
+		v8::Local<v8::Value> argv[] = { Nan::Null(), wrap->InstantiateScene(h_world, m_scene) };
+		callback->Call(countof(argv), argv, async_resource);
+	}
+};
+
+NANX_EXPORT(LoadScene)
+{
+	// box2d.LoadScene(world, json) creates a RUBE (b2dJson) scene in world; json is a string, or a Buffer
+	// of json or of a binary scene from CompileScene;
+	// returns { bodies (Int32Array of body ids in scene order), names, joints, velocityIterations, positionIterations, stepsPerSecond }
+	WrapWorld* wrap = WrapWorld::Unwrap(info[0]);
+	if (!wrap)
+	{
+		return Nan::ThrowTypeError("world must be a b2World");
+	}
+	if (wrap->Peek()->IsLocked())
+	{
+		return Nan::ThrowError("scene cannot load during a step");
+	}
+	Scene scene;
+	bool ok = false;
+	if (info[1]->IsString())
+	{
+		Nan::Utf8String json(info[1]);
+		ok = ParseScene(*json, json.length(), scene);
+	}
+	else
+	{
+		Nan::TypedArrayContents<char> data(info[1]);
+		ok = ReadScene(*data, data.length(), scene);
+	}
+	if (!ok)
+	{
+		return Nan::ThrowError(scene.error.c_str());
+	}
+	info.GetReturnValue().Set(wrap->InstantiateScene(v8::Local<v8::Object>::Cast(info[0]), scene));
+}
+
+NANX_EXPORT(LoadSceneAsync)
+{
+	// box2d.LoadSceneAsync(world, json, callback(err, map)) parses json or reads a binary scene on the thread pool,
+	// then creates the scene on this thread like LoadScene
+	WrapWorld* wrap = WrapWorld::Unwrap(info[0]);
+	if (!wrap)
+	{
+		return Nan::ThrowTypeError("world must be a b2World");
+	}
+	if (!info[2]->IsFunction())
+	{
+		return Nan::ThrowTypeError("callback must be a function");
+	}
+	v8::Local<v8::Object> h_world = v8::Local<v8::Object>::Cast(info[0]);
+	Nan::Callback* callback = new Nan::Callback(v8::Local<v8::Function>::Cast(info[2]));
+	LoadSceneWorker* worker = NULL;
+	if (info[1]->IsString())
+	{
+		Nan::Utf8String json(info[1]);
+		worker = new LoadSceneWorker(callback, h_world, *json, json.length());
+	}
+	else
+	{
+		Nan::TypedArrayContents<char> json(info[1]);
+		worker = new LoadSceneWorker(callback, h_world, *json, json.length());
+	}
+	Nan::AsyncQueueWorker(worker);
+}
+
+NANX_EXPORT(CompileScene)
+{
+	// box2d.CompileScene(json) converts a RUBE (b2dJson) scene to the binary scene format as a Buffer
+	Scene scene;
+	bool ok = false;
+	if (info[0]->IsString())
+	{
+		Nan::Utf8String json(info[0]);
+		ok = ParseScene(*json, json.length(), scene);
+	}
+	else
+	{
+		Nan::TypedArrayContents<char> json(info[0]);
+		ok = ParseScene(*json, json.length(), scene);
+	}
+	if (!ok)
+	{
+		return Nan::ThrowError(scene.error.c_str());
+	}
+	std::vector<uint8> data;
+	SceneFileWriter writer;
+	writer.Write(scene, data);
+	info.GetReturnValue().Set(Nan::CopyBuffer(reinterpret_cast<const char*>(data.data()), static_cast<uint32_t>(data.size())).ToLocalChecked());
+}
+
+NANX_EXPORT(LoadSceneFile)
+{
+	// box2d.LoadSceneFile(world, path) maps a binary scene (or json) file and creates it like LoadScene
+	WrapWorld* wrap = WrapWorld::Unwrap(info[0]);
+	if (!wrap)
+	{
+		return Nan::ThrowTypeError("world must be a b2World");
+	}
+	if (wrap->Peek()->IsLocked())
+	{
+		return Nan::ThrowError("scene cannot load during a step");
+	}
+	Nan::Utf8String path(info[1]);
+	Scene scene;
+	{
+		MappedFile file;
+		if (!*path || !file.Open(*path))
+		{
+			return Nan::ThrowError("scene file cannot be opened");
+		}
+		if (!ReadScene(file.GetData(), file.GetSize(), scene))
+		{
+			return Nan::ThrowError(scene.error.c_str());
+		}
+	}
+	info.GetReturnValue().Set(wrap->InstantiateScene(v8::Local<v8::Object>::Cast(info[0]), scene));
+}
+
+////
+
+//// simd
+
+// set by binding.gyp (box2d_simd): 0 scalar, 1 sse2, 2 avx2 + fma
+#ifndef NODE_BOX2D_SIMD
+#define NODE_BOX2D_SIMD 0
+#endif
+
+static const char* g_simd_names[] = { "none", "sse2", "avx2" }; // the cpu check is in node-box2d-cpu.cc
+
 ////
 
+//// determinism
+
+// set by binding.gyp (box2d_deterministic): strict floating point, no fma contraction
+#ifndef NODE_BOX2D_DETERMINISTIC
+#define NODE_BOX2D_DETERMINISTIC 0
+#endif
+
+// set by binding.gyp where it can link the engine's libm calls to the functions below (linux only);
+// elsewhere the results still depend on the platform's sinf, cosf and atan2f
+#ifndef NODE_BOX2D_DETERMINISTIC_WRAP
+#define NODE_BOX2D_DETERMINISTIC_WRAP 0
+#endif
+
+#if NODE_BOX2D_DETERMINISTIC && NODE_BOX2D_DETERMINISTIC_WRAP
+
+static float32 DeterministicSin(float32 angle, int32 quadrant_offset)
+{
+	// libm sinf/cosf differ between libc versions; this only uses basic double operations,
+	// which round the same everywhere once contraction is off
+	double x = angle;
+	if (x != x) { return angle - angle; } // nan
+	if (fabs(x) > 1.0e6) { x = fmod(x, 6.28318530717958647692); } // inf becomes nan here too
+	double k = floor(x * 0.63661977236758134308 + 0.5); // nearest multiple of pi/2
+	double r = (x - k * 1.57079632673412561417e+00) - k * 6.07710050650619224932e-11; // pi/2 split in two
+	double r2 = r * r;
+	double sin_r = r + r * r2 * (-1.0 / 6.0 + r2 * (1.0 / 120.0 + r2 * (-1.0 / 5040.0 + r2 * (1.0 / 362880.0 + r2 * (-1.0 / 39916800.0 + r2 * (1.0 / 6227020800.0))))));
+	double cos_r = 1.0 + r2 * (-1.0 / 2.0 + r2 * (1.0 / 24.0 + r2 * (-1.0 / 720.0 + r2 * (1.0 / 40320.0 + r2 * (-1.0 / 3628800.0 + r2 * (1.0 / 479001600.0 + r2 * (-1.0 / 87178291200.0)))))));
+	switch ((static_cast<int32>(k) + quadrant_offset) & 3)
+	{
+	case 0: return static_cast<float32>(sin_r);
+	case 1: return static_cast<float32>(cos_r);
+	case 2: return static_cast<float32>(-sin_r);
+	default: return static_cast<float32>(-cos_r);
+	}
+}
+
+static double DeterministicAtan(double t)
+{
+	// t in [0, 1]; atan(t) = pi/6 + atan((sqrt(3) t - 1) / (sqrt(3) + t)) brings it under tan(pi/12)
+	double offset = 0.0;
+	if (t > 0.26794919243112270647)
+	{
+		t = (1.73205080756887729353 * t - 1.0) / (1.73205080756887729353 + t);
+		offset = 0.52359877559829887308;
+	}
+	double t2 = t * t;
+	return offset + t * (1.0 + t2 * (-1.0 / 3.0 + t2 * (1.0 / 5.0 + t2 * (-1.0 / 7.0 + t2 * (1.0 / 9.0 + t2 * (-1.0 / 11.0 + t2 * (1.0 / 13.0 + t2 * (-1.0 / 15.0 + t2 * (1.0 / 17.0 + t2 * (-1.0 / 19.0 + t2 * (1.0 / 21.0 + t2 * (-1.0 / 23.0))))))))))));
+}
+
+static float32 DeterministicAtan2(float32 y, float32 x)
+{
+	// same quadrants, signed zeros and infinities as atan2f
+	if ((y != y) || (x != x)) { return y + x; } // nan
+	const double pi = 3.14159265358979323846;
+	double ax = fabs(static_cast<double>(x));
+	double ay = fabs(static_cast<double>(y));
+	double a;
+	if (ay == 0.0) { a = 0.0; }
+	else if (ax == ay) { a = 0.25 * pi; } // both infinite too
+	else if (ay < ax) { a = DeterministicAtan(ay / ax); }
+	else { a = 0.5 * pi - DeterministicAtan(ax / ay); }
+	if ((x < 0.0f) || ((x == 0.0f) && (1.0f / x < 0.0f))) { a = pi - a; }
+	return static_cast<float32>(((y < 0.0f) || ((y == 0.0f) && (1.0f / y < 0.0f)))?(-a):(a));
+}
+
+// binding.gyp links the addon with --wrap=sinf,cosf,atan2f, so the engine's calls (b2Rot::Set, b2Rot::GetAngle) land here
+extern "C" float __wrap_sinf(float x) { return DeterministicSin(x, 0); }
+extern "C" float __wrap_cosf(float x) { return DeterministicSin(x, 1); }
+extern "C" float __wrap_atan2f(float y, float x) { return DeterministicAtan2(y, x); }
+
+#endif
+
 NAN_MODULE_INIT(init)
 {
+	ModuleExports().Reset(target);
+
 	NANX_CONSTANT(target, b2_maxFloat);
 	NANX_CONSTANT(target, b2_epsilon);
 	NANX_CONSTANT(target, b2_pi);
@@ -8804,12 +15125,25 @@ NAN_MODULE_INIT(init)
 	NANX_CONSTANT(target, b2_linearSleepTolerance);
 	NANX_CONSTANT(target, b2_angularSleepTolerance);
 
+	#if NODE_BOX2D_TRACK_ALLOC
+	b2SetAllocFreeCallbacks(TrackedAlloc, TrackedFree, NULL);
+	#endif
+
+	ContactRegisters::Initialize();
+
 	v8::Local<v8::Object> version = Nan::New<v8::Object>();
 	Nan::Set(target, NANX_SYMBOL("b2_version"), version);
 	version->Set(NANX_SYMBOL("major"), Nan::New(b2_version.major));
 	version->Set(NANX_SYMBOL("minor"), Nan::New(b2_version.minor));
 	version->Set(NANX_SYMBOL("revision"), Nan::New(b2_version.revision));
 
+	// node-box2d-cpu.cc has already refused to load where the build's instruction set would fault
+	v8::Local<v8::Object> simd = Nan::New<v8::Object>();
+	Nan::Set(target, NANX_SYMBOL("b2_simd"), simd);
+	simd->Set(NANX_SYMBOL("build"), NANX_STRING(g_simd_names[NODE_BOX2D_SIMD]));
+	simd->Set(NANX_SYMBOL("cpu"), NANX_STRING(g_simd_names[DetectSimdLevel()]));
+	Nan::Set(target, NANX_SYMBOL("b2_deterministic"), Nan::New<v8::Boolean>((NODE_BOX2D_DETERMINISTIC != 0) && (NODE_BOX2D_DETERMINISTIC_WRAP != 0)));
+
 	v8::Local<v8::Object> WrapShapeType = Nan::New<v8::Object>();
 	Nan::Set(target, NANX_SYMBOL("b2ShapeType"), WrapShapeType);
 	NANX_CONSTANT_VALUE(WrapShapeType, e_unknownShape, -1);
@@ -8962,6 +15296,7 @@ NAN_MODULE_INIT(init)
 	WrapParticleSystemDef::Init(target);
 	WrapParticleSystem::Init(target);
 	#endif
+	WrapPrefab::Init(target);
 	WrapWorld::Init(target);
 
 	NANX_EXPORT_APPLY(target, b2Distance);
@@ -8979,6 +15314,11 @@ NAN_MODULE_INIT(init)
 	NANX_EXPORT_APPLY(target, b2TestOverlap_AABB);
 	NANX_EXPORT_APPLY(target, b2TestOverlap_Shape);
 
+	NANX_EXPORT_APPLY(target, LoadScene);
+	NANX_EXPORT_APPLY(target, LoadSceneAsync);
+	NANX_EXPORT_APPLY(target, LoadSceneFile);
+	NANX_EXPORT_APPLY(target, CompileScene);
+
 	#if B2_ENABLE_PARTICLE
 	NANX_EXPORT_APPLY(target, b2CalculateParticleIterations);
 	#endif
@@ -8987,5 +15327,3 @@ NAN_MODULE_INIT(init)
 ////
 
 } // namespace node_box2d
-
-NODE_MODULE(node_box2d, node_box2d::init);
@@ -33,6 +33,8 @@ namespace node_box2d {
 
 NAN_MODULE_INIT(init);
 
+int DetectSimdLevel(); // node-box2d-cpu.cc: 0 scalar, 1 sse2, 2 avx2 + fma
+
 } // namespace node_box2d
 
 #endif // _NODE_BOX2D_H_